@@ -0,0 +1,1050 @@
+#include "arch/aarch64/aarch64_codegen.h"
+#include "jit.h"    // JIT_MAX_CALL_DEPTH, JitExitReason (hata nedenleri)
+#include "isel.h"   // Ağaç örüntülü komut seçimi
+#include "profile_format.h" // BSM_PROFILE_DEFAULT_PATH
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // fprintf, snprintf
+#include <string.h> // memset, strlen
+#include <stddef.h> // offsetof
+
+#define AARCH64_STATE AARCH64_X28       // Çalışma zamanı durumunun adresi
+#define AARCH64_STACK_LIMIT AARCH64_X29 // CALL, SP bu adrese inerse taşar
+#define AARCH64_SCRATCH AARCH64_X16     // İkinci kaynak için sabitler, atlama tablosu
+#define AARCH64_SCRATCH2 AARCH64_X17    // Kodlanamayan ADD/SUB sabitleri, tablo adresi
+#define AARCH64_CALL_FRAME_SIZE 16      // CALL başına yığın (X30; SP 16'ya hizalı kalmalı)
+
+// Bessambly kaydedicilerine atanan makine kaydedicileri (tercih sırasıyla). X19-X27 C
+// çağrılarında korunur; X9-X15 sistem çağrısında korunur, C çağrısında .bss'e saklanır.
+static const Aarch64Register aarch64_allocatable[IR_NUM_REGISTERS] = {
+    AARCH64_X19, AARCH64_X20, AARCH64_X21, AARCH64_X22, AARCH64_X23, AARCH64_X24, AARCH64_X25, AARCH64_X26,
+    AARCH64_X27, AARCH64_X9,  AARCH64_X10, AARCH64_X11, AARCH64_X12, AARCH64_X13, AARCH64_X14, AARCH64_X15,
+};
+
+#define AARCH64_LINUX_SYS_WRITE 64
+#define AARCH64_LINUX_SYS_EXIT_GROUP 94
+#define AARCH64_BESSAMBLY_SYS_EXIT 60       // Bessambly (Linux x86-64) numaraları
+#define AARCH64_BESSAMBLY_SYS_EXIT_GROUP 231
+
+// flags_read bitleri: bir bayrak değerini okuyan koşul türleri
+#define AARCH64_FLAGS_READ_EQUALITY 0x1 // EQ/NE: sadece sıfır bayrağı
+#define AARCH64_FLAGS_READ_ORDER 0x2    // LT/GT/LE/GE: işaret ve taşma bayrakları da
+
+// Koşul indeksleri IrCondition sırasıyladır (EQ, NE, LT, GT, LE, GE)
+static const Aarch64Condition aarch64_conditions[] = {AARCH64_CC_EQ, AARCH64_CC_NE, AARCH64_CC_LT,
+                                                      AARCH64_CC_GT, AARCH64_CC_LE, AARCH64_CC_GE};
+static const IrCondition aarch64_inverse_condition[] = {IR_COND_NE, IR_COND_EQ, IR_COND_GE,
+                                                        IR_COND_LE, IR_COND_GT, IR_COND_LT};
+
+// --- Çalışma Zamanı Durumu (.bss) ---
+typedef struct {
+    int64_t registers[IR_NUM_REGISTERS]; // C çağrıları boyunca X9-X15'teki kaydediciler
+    uint64_t* counters;                 // PROFCNT sayaçları (__bsm_prof_thread_init)
+    int64_t print_args[AARCH64_MAX_PRINT_ARGS];
+} Aarch64NativeState;
+
+// Sembol başvurularının numaraları (bkz. aarch64_adr_symbol)
+enum { AARCH64_SYMBOL_STATE = 1, AARCH64_SYMBOL_RODATA = 2 };
+
+#define AARCH64_STATE_SYMBOL "__bsm_state"
+#define AARCH64_RODATA_SYMBOL "__bsm_rodata"
+#define AARCH64_ENTRY_SYMBOL "_start"
+#define AARCH64_INSTRUMENTED_ENTRY_SYMBOL "main" // C kütüphanesiyle bağlanır (çalışma zamanı atexit kullanır)
+#define AARCH64_STATE_OFFSET(field) ((uint32_t)offsetof(Aarch64NativeState, field))
+
+// --- Komut Seçim Kalıpları (bkz. isel.h) ---
+enum {
+    AARCH64_RULE_DEFAULT = ISEL_RULE_DEFAULT,
+    AARCH64_RULE_THREE_ADDRESS,     // Katılan MOV'un kaynağı ilk kaynak olur: add/sub/mul rd, rn, rm
+    AARCH64_RULE_SHIFT,             // x * 2^k -> lsl rd, rn, #k
+    AARCH64_RULE_SHIFTED_OPERAND,   // a +/- b * 2^k -> add/sub rd, ra, rb, lsl #k
+    AARCH64_RULE_MULTIPLY_ADD,      // a +/- b * c -> madd/msub
+};
+
+static int aarch64_is_power_of_two(int64_t value) { return value > 0 && (value & (value - 1)) == 0; }
+
+static uint32_t aarch64_log2(int64_t value) {
+    uint32_t shift = 0;
+    while (((uint64_t)1 << shift) < (uint64_t)value) shift++;
+    return shift;
+}
+
+static int aarch64_shift_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    (void)target;
+    (void)root;
+    return aarch64_is_power_of_two(leaves[1].imm);
+}
+
+static int aarch64_shifted_operand_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    (void)target;
+    (void)root;
+    return aarch64_is_power_of_two(leaves[2].imm);
+}
+
+// Maliyet: komut sayısı; mul/madd gecikmesi için 3, sabitle çarpmada sabitin yüklenmesi için +1
+static const IselPattern aarch64_patterns[] = {
+    {AARCH64_RULE_DEFAULT, "MOV(reg)", 1, NULL},
+    {AARCH64_RULE_DEFAULT, "MOV(imm)", 1, NULL},
+    {AARCH64_RULE_DEFAULT, "ADD(reg, reg)", 1, NULL},
+    {AARCH64_RULE_DEFAULT, "ADD(reg, imm)", 1, NULL},
+    {AARCH64_RULE_DEFAULT, "SUB(reg, reg)", 1, NULL},
+    {AARCH64_RULE_DEFAULT, "SUB(reg, imm)", 1, NULL},
+    {AARCH64_RULE_DEFAULT, "MUL(reg, reg)", 3, NULL},
+    {AARCH64_RULE_DEFAULT, "MUL(reg, imm)", 4, NULL},
+    {AARCH64_RULE_THREE_ADDRESS, "ADD(MOV(reg), reg)", 1, NULL},
+    {AARCH64_RULE_THREE_ADDRESS, "ADD(MOV(reg), imm)", 1, NULL},
+    {AARCH64_RULE_THREE_ADDRESS, "SUB(MOV(reg), reg)", 1, NULL},
+    {AARCH64_RULE_THREE_ADDRESS, "SUB(MOV(reg), imm)", 1, NULL},
+    {AARCH64_RULE_THREE_ADDRESS, "MUL(MOV(reg), reg)", 3, NULL},
+    {AARCH64_RULE_THREE_ADDRESS, "MUL(MOV(reg), imm)", 4, NULL},
+    {AARCH64_RULE_SHIFT, "MUL(reg, imm)", 1, aarch64_shift_applies},
+    {AARCH64_RULE_SHIFT, "MUL(MOV(reg), imm)", 1, aarch64_shift_applies},
+    {AARCH64_RULE_SHIFTED_OPERAND, "ADD(reg, MUL(reg, imm))", 1, aarch64_shifted_operand_applies},
+    {AARCH64_RULE_SHIFTED_OPERAND, "ADD(reg, MUL(MOV(reg), imm))", 1, aarch64_shifted_operand_applies},
+    {AARCH64_RULE_SHIFTED_OPERAND, "SUB(reg, MUL(reg, imm))", 1, aarch64_shifted_operand_applies},
+    {AARCH64_RULE_SHIFTED_OPERAND, "SUB(reg, MUL(MOV(reg), imm))", 1, aarch64_shifted_operand_applies},
+    {AARCH64_RULE_MULTIPLY_ADD, "ADD(reg, MUL(reg, reg))", 3, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "ADD(reg, MUL(MOV(reg), reg))", 3, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "ADD(reg, MUL(reg, imm))", 4, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "ADD(reg, MUL(MOV(reg), imm))", 4, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "SUB(reg, MUL(reg, reg))", 3, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "SUB(reg, MUL(MOV(reg), reg))", 3, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "SUB(reg, MUL(reg, imm))", 4, NULL},
+    {AARCH64_RULE_MULTIPLY_ADD, "SUB(reg, MUL(MOV(reg), imm))", 4, NULL},
+};
+
+// --- Üretici Durumu ---
+
+typedef struct {
+    size_t position;        // Dal komutunun konumu
+    uint32_t block;         // Hedef blok
+    int relaxable;          // 1 ise b.cond: erişim yetmezse ters b.cond + b çiftine uzatılır
+} Aarch64Fixup;
+
+typedef struct {
+    size_t position;        // Hata dalının konumu
+    int32_t reason;         // JitExitReason
+    int32_t line;
+} Aarch64ColdStub;
+
+typedef struct {
+    size_t position;        // Tablo adresini yükleyen adrp'nin konumu (ardından add gelir)
+    uint32_t table;         // IrJumpTable indeksi
+} Aarch64TableRef;
+
+typedef struct {
+    size_t position;        // bl'nin konumu
+    const char* symbol;     // Çalışma zamanı fonksiyonu; NULL ise koddaki print yordamı
+} Aarch64RuntimeCall;
+
+typedef struct {
+    const IrFunction* fn;
+    Aarch64Buffer* out;
+    ObjectFile* obj;
+    Aarch64Register registers[IR_NUM_REGISTERS]; // Bessambly kaydedicilerinin makine kaydedicileri
+    uint8_t* flags_read;        // Sanal kaydedici başına: bayrak değerini okuyan koşullar (AARCH64_FLAGS_READ_*)
+    IselMatcher matcher;        // aarch64_patterns'ın derlenmiş hali
+    IselSelection selection;    // Komut başına seçilen kalıplar (geçişler boyunca sabit)
+    size_t* block_offsets;
+    Aarch64Fixup* fixups;
+    size_t num_fixups;
+    size_t fixup_capacity;
+    uint8_t* relaxed;           // Düzeltme sırası başına: 1 ise koşullu dal uzun biçimde yazılır
+    size_t relaxed_capacity;
+    Aarch64ColdStub* stubs;
+    size_t num_stubs;
+    size_t stub_capacity;
+    Aarch64TableRef* tables;
+    size_t num_tables;
+    size_t table_capacity;
+    Aarch64RuntimeCall* runtime_calls;
+    size_t num_runtime_calls;
+    size_t runtime_call_capacity;
+    size_t leave;               // Çıkış kodunun konumu
+    int out_of_memory;
+
+    int rodata;                 // .rodata bölümü (mesajlar; atlama tabloları sonradan eklenir)
+    int instrumented;           // Program PROFCNT/PROFDUMP içeriyorsa 1
+    uint64_t profile_checksum;
+    uint64_t num_counters;
+    uint64_t profile_path;      // Yolun .rodata'daki konumu
+} Aarch64Codegen;
+
+static int aarch64_grow(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (!grown) return 0;
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+static void aarch64_add_fixup(Aarch64Codegen* cg, size_t position, uint32_t block, int relaxable) {
+    if (!aarch64_grow((void**)&cg->fixups, &cg->fixup_capacity, cg->num_fixups + 1, sizeof(Aarch64Fixup))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->fixups[cg->num_fixups].position = position;
+    cg->fixups[cg->num_fixups].block = block;
+    cg->fixups[cg->num_fixups].relaxable = relaxable;
+    cg->num_fixups++;
+}
+
+/**
+ * @brief Düzeltmeyi sonraki geçişlerde uzun biçimde yazılacak olarak işaretler.
+ */
+static void aarch64_relax(Aarch64Codegen* cg, size_t fixup) {
+    size_t old_capacity = cg->relaxed_capacity;
+    if (!aarch64_grow((void**)&cg->relaxed, &cg->relaxed_capacity, fixup + 1, 1)) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    memset(cg->relaxed + old_capacity, 0, cg->relaxed_capacity - old_capacity);
+    cg->relaxed[fixup] = 1;
+}
+
+/**
+ * @brief Bloğa koşullu dal: b.cond (±1 MB). Önceki bir geçişte erişimi yetmediyse veya hedef geride
+ * ve uzaksa ters koşullu b.cond, hedefe giden b'nin (±128 MB) üzerinden atlar.
+ */
+static void aarch64_emit_branch(Aarch64Codegen* cg, Aarch64Condition cond, uint32_t block) {
+    Aarch64Buffer* out = cg->out;
+    size_t target = cg->block_offsets[block];
+    int is_long = cg->num_fixups < cg->relaxed_capacity && cg->relaxed[cg->num_fixups];
+    if (target != SIZE_MAX && (int64_t)target - (int64_t)out->size < -AARCH64_COND_BRANCH_RANGE) is_long = 1;
+    if (!is_long) {
+        aarch64_add_fixup(cg, aarch64_b_cond(out, cond), block, 1);
+        return;
+    }
+    size_t skip = aarch64_b_cond(out, AARCH64_INVERSE(cond));
+    aarch64_add_fixup(cg, aarch64_b(out), block, 0);
+    aarch64_patch_branch(out, skip, out->size);
+}
+
+static void aarch64_add_stub(Aarch64Codegen* cg, size_t position, JitExitReason reason, int32_t line) {
+    if (!aarch64_grow((void**)&cg->stubs, &cg->stub_capacity, cg->num_stubs + 1, sizeof(Aarch64ColdStub))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->stubs[cg->num_stubs].position = position;
+    cg->stubs[cg->num_stubs].reason = reason;
+    cg->stubs[cg->num_stubs].line = line;
+    cg->num_stubs++;
+}
+
+static void aarch64_add_table_ref(Aarch64Codegen* cg, size_t position, uint32_t table) {
+    if (!aarch64_grow((void**)&cg->tables, &cg->table_capacity, cg->num_tables + 1, sizeof(Aarch64TableRef))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->tables[cg->num_tables].position = position;
+    cg->tables[cg->num_tables].table = table;
+    cg->num_tables++;
+}
+
+static void aarch64_add_runtime_call(Aarch64Codegen* cg, size_t position, const char* symbol) {
+    if (!aarch64_grow((void**)&cg->runtime_calls, &cg->runtime_call_capacity, cg->num_runtime_calls + 1,
+                      sizeof(Aarch64RuntimeCall))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->runtime_calls[cg->num_runtime_calls].position = position;
+    cg->runtime_calls[cg->num_runtime_calls].symbol = symbol;
+    cg->num_runtime_calls++;
+}
+
+// --- Kaydediciler ---
+
+/**
+ * @brief Bessambly kaydedicilerini kullanım sıklığına göre sıralayıp makine kaydedicilerine atar:
+ * en sık kullanılanlar C çağrılarında korunan X19-X27'yi alır.
+ */
+static void aarch64_assign_registers(Aarch64Codegen* cg) {
+    const IrFunction* fn = cg->fn;
+    uint64_t uses[IR_NUM_REGISTERS] = {0};
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        uint16_t vregs[5];
+        size_t count = ir_instr_uses(&fn->instrs[i], vregs);
+        count += ir_instr_defs(&fn->instrs[i], vregs + count);
+        for (size_t k = 0; k < count; k++) {
+            int origin = vregs[k] < fn->num_vregs ? fn->vregs[vregs[k]].origin : -1;
+            if (origin >= 0 && origin < IR_NUM_REGISTERS) uses[origin]++;
+        }
+    }
+    int assigned[IR_NUM_REGISTERS] = {0};
+    for (int slot = 0; slot < IR_NUM_REGISTERS; slot++) {
+        int best = -1;
+        for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+            if (!assigned[r] && (best < 0 || uses[r] > uses[best])) best = r;
+        }
+        assigned[best] = 1;
+        cg->registers[best] = aarch64_allocatable[slot];
+    }
+}
+
+/**
+ * @brief Sanal kaydedicinin makine kaydedicisini döndürür (kökeni olan mimari kaydedicininki).
+ * @return Başarılıysa 1; kökeni yoksa 0 (stderr'e açıklama yazılır).
+ */
+static int aarch64_register(Aarch64Codegen* cg, uint16_t vreg, Aarch64Register* reg) {
+    int origin = vreg < cg->fn->num_vregs ? cg->fn->vregs[vreg].origin : -1;
+    if (origin < 0 || origin >= IR_NUM_REGISTERS) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi: v%u bir mimari kaydediciye eşlenemiyor.\n", vreg);
+        return 0;
+    }
+    *reg = cg->registers[origin];
+    return 1;
+}
+
+/**
+ * @brief C çağrısında bozulan (X9-X15) Bessambly kaydedicilerini .bss'e yazar (load = 0) veya
+ * oradan geri okur (load = 1).
+ */
+static void aarch64_sync_caller_saved(Aarch64Codegen* cg, int load) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        Aarch64Register reg = cg->registers[r];
+        if (reg > AARCH64_X18) continue;
+        if (load) {
+            aarch64_ldr(cg->out, reg, AARCH64_STATE, AARCH64_STATE_OFFSET(registers[r]));
+        } else {
+            aarch64_str(cg->out, reg, AARCH64_STATE, AARCH64_STATE_OFFSET(registers[r]));
+        }
+    }
+}
+
+// --- Sabitler ---
+
+/**
+ * @brief value ADD/SUB'un 12 bitlik sabit alanına (gerekirse 12 bit kaydırılmış) sığıyorsa alanı yazar.
+ */
+static int aarch64_arith_immediate(uint64_t value, uint32_t* imm12, int* lsl12) {
+    if (value < 4096) {
+        *imm12 = (uint32_t)value;
+        *lsl12 = 0;
+        return 1;
+    }
+    if ((value & 0xfff) == 0 && value < (1u << 24)) {
+        *imm12 = (uint32_t)(value >> 12);
+        *lsl12 = 1;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief rd = rn + value. Sabit alana sığmazsa (eksi değerler için sub) X17'ye yüklenir.
+ * set_flags ise bayrak kuran biçimler (adds/subs) yazılır.
+ */
+static void aarch64_emit_add_constant(Aarch64Codegen* cg, Aarch64Register rd, Aarch64Register rn, int64_t value,
+                                      int set_flags) {
+    uint32_t imm12;
+    int lsl12;
+    if (aarch64_arith_immediate((uint64_t)value, &imm12, &lsl12)) {
+        (set_flags ? aarch64_adds_imm : aarch64_add_imm)(cg->out, rd, rn, imm12, lsl12);
+    } else if (value != INT64_MIN && aarch64_arith_immediate((uint64_t)-value, &imm12, &lsl12)) {
+        (set_flags ? aarch64_subs_imm : aarch64_sub_imm)(cg->out, rd, rn, imm12, lsl12);
+    } else {
+        aarch64_mov_imm(cg->out, AARCH64_SCRATCH2, value);
+        (set_flags ? aarch64_adds : aarch64_add)(cg->out, rd, rn, AARCH64_SCRATCH2);
+    }
+}
+
+/**
+ * @brief "b" kaynağını kaydediciye getirir: sabitler X16'ya yüklenir.
+ */
+static int aarch64_second_source(Aarch64Codegen* cg, const IrInstr* instr, Aarch64Register* source) {
+    if (!(instr->attrs & IR_ATTR_IMM)) return aarch64_register(cg, instr->u.op.src2, source);
+    aarch64_mov_imm(cg->out, AARCH64_SCRATCH, ir_instr_immediate(cg->fn, instr));
+    *source = AARCH64_SCRATCH;
+    return 1;
+}
+
+/**
+ * @brief Kalıp yaprağını kaydediciye getirir: sabitler scratch'e yüklenir.
+ */
+static int aarch64_leaf_register(Aarch64Codegen* cg, const IselOperand* leaf, Aarch64Register scratch,
+                                 Aarch64Register* reg) {
+    if (!leaf->is_immediate) return aarch64_register(cg, leaf->vreg, reg);
+    aarch64_mov_imm(cg->out, scratch, leaf->imm);
+    *reg = scratch;
+    return 1;
+}
+
+/**
+ * @brief Komut için seçilen kuralı döndürür; varsayılan çeviri dışındaki kurallar için yaprakları bağlar.
+ */
+static int aarch64_selected_rule(Aarch64Codegen* cg, const IrInstr* instr, IselOperand* leaves) {
+    size_t index = (size_t)(instr - cg->fn->instrs);
+    int rule = isel_rule(&cg->selection, index);
+    if (rule != AARCH64_RULE_DEFAULT && isel_leaves(&cg->selection, index, leaves) == 0) return AARCH64_RULE_DEFAULT;
+    return rule;
+}
+
+// --- Komutlar ---
+
+/**
+ * @brief Çalışma zamanı fonksiyonunu veya print yordamını (symbol NULL) çağırır. X30, CALL'un
+ * dönüş adresini tutabileceği için yığında saklanır; C fonksiyonları için X9-X15 .bss'e yazılır
+ * (print yordamı sadece X0-X8, X16 ve X17'yi kullanır).
+ */
+static void aarch64_emit_runtime_call(Aarch64Codegen* cg, const char* symbol) {
+    Aarch64Buffer* out = cg->out;
+    if (symbol) aarch64_sync_caller_saved(cg, 0);
+    aarch64_str_pre(out, AARCH64_X30, AARCH64_SP, -AARCH64_CALL_FRAME_SIZE);
+    aarch64_add_runtime_call(cg, aarch64_bl(out), symbol);
+    aarch64_ldr_post(out, AARCH64_X30, AARCH64_SP, AARCH64_CALL_FRAME_SIZE);
+    if (symbol) aarch64_sync_caller_saved(cg, 1);
+}
+
+/**
+ * @brief print çağrısı: argümanlar .bss'e kopyalanır ve print yordamı argüman sayısıyla (X0) çağrılır.
+ */
+static int aarch64_emit_print_call(Aarch64Codegen* cg, const IrSyscall* syscall) {
+    if (syscall->num_args > AARCH64_MAX_PRINT_ARGS) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi: print çağrısı en fazla %d argüman alabilir.\n",
+                AARCH64_MAX_PRINT_ARGS);
+        return 0;
+    }
+    for (uint32_t a = 0; a < syscall->num_args; a++) {
+        int reg = cg->fn->pool[syscall->first_arg + a] & 0x0f;
+        aarch64_str(cg->out, cg->registers[reg], AARCH64_STATE, AARCH64_STATE_OFFSET(print_args[a]));
+    }
+    aarch64_movz(cg->out, AARCH64_X0, (uint16_t)syscall->num_args, 0);
+    aarch64_emit_runtime_call(cg, NULL);
+    return 1;
+}
+
+/**
+ * @brief SYSCALL'u Linux AArch64 sistem çağrısı ABI'sine indirger (bkz. aarch64_codegen.h).
+ * Argüman kaydedicileri (X0-X5, X8) Bessambly kaydedicilerine atanmadığı için sıra önemsizdir.
+ */
+static int aarch64_emit_linux_syscall(Aarch64Codegen* cg, const IrInstr* instr) {
+    Aarch64Buffer* out = cg->out;
+    const IrSyscall* syscall = &cg->fn->syscalls[instr->u.op.imm];
+    if (syscall->number == AARCH64_HYPERCALL_PRINT) return aarch64_emit_print_call(cg, syscall);
+    if (syscall->num_args > AARCH64_LINUX_MAX_SYSCALL_ARGS) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi: Linux sistem çağrısı en fazla %d argüman alabilir "
+                        "(%lld numaralı çağrıda %u).\n",
+                AARCH64_LINUX_MAX_SYSCALL_ARGS, (long long)syscall->number, syscall->num_args);
+        return 0;
+    }
+    int64_t number = target_linux_syscall_number(cg->obj->arch, syscall->number);
+    if (number < 0) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi: %lld numaralı sistem çağrısının AArch64 Linux karşılığı "
+                        "bilinmiyor.\n",
+                (long long)syscall->number);
+        return 0;
+    }
+    int is_exit = syscall->number == AARCH64_BESSAMBLY_SYS_EXIT || syscall->number == AARCH64_BESSAMBLY_SYS_EXIT_GROUP;
+    for (uint32_t a = 0; a < syscall->num_args; a++) {
+        int reg = cg->fn->pool[syscall->first_arg + a] & 0x0f;
+        aarch64_mov(out, (Aarch64Register)(AARCH64_X0 + a), cg->registers[reg]);
+    }
+    if (is_exit && syscall->num_args == 0) aarch64_mov(out, AARCH64_X0, cg->registers[0]); // BVM ile aynı
+    aarch64_mov_imm(out, AARCH64_X8, number);
+    aarch64_svc(out, 0);
+    if (!is_exit) aarch64_mov(out, cg->registers[0], AARCH64_X0); // Dönüş değeri R0'a
+    return 1;
+}
+
+static int aarch64_emit_jump_table(Aarch64Codegen* cg, const IrInstr* instr) {
+    Aarch64Buffer* out = cg->out;
+    const IrJumpTable* table = &cg->fn->jump_tables[instr->u.op.imm];
+    Aarch64Register index;
+    if (!aarch64_register(cg, instr->u.op.src1, &index)) return 0;
+    if (table->num_targets > INT32_MAX) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi: atlama tablosu çok büyük (%u giriş).\n", table->num_targets);
+        return 0;
+    }
+    if (table->num_targets == 0) {
+        aarch64_add_fixup(cg, aarch64_b(out), table->default_block, 0);
+        return 1;
+    }
+    if (table->min != 0) {
+        aarch64_emit_add_constant(cg, AARCH64_SCRATCH, index, (int64_t)(0 - (uint64_t)table->min), 0);
+        index = AARCH64_SCRATCH;
+    }
+    // İşaretsiz karşılaştırma aralığın iki yanını birden denetler
+    if (table->num_targets < 4096) {
+        aarch64_cmp_imm(out, index, table->num_targets);
+    } else {
+        aarch64_mov_imm(out, AARCH64_SCRATCH2, table->num_targets);
+        aarch64_cmp(out, index, AARCH64_SCRATCH2);
+    }
+    aarch64_emit_branch(cg, AARCH64_CC_HS, table->default_block);
+    aarch64_add_table_ref(cg, out->size, (uint32_t)instr->u.op.imm);
+    aarch64_adrp(out, AARCH64_SCRATCH2);
+    aarch64_add_imm(out, AARCH64_SCRATCH2, AARCH64_SCRATCH2, 0, 0);
+    aarch64_ldrsw_index(out, AARCH64_SCRATCH, AARCH64_SCRATCH2, index);
+    aarch64_add(out, AARCH64_SCRATCH, AARCH64_SCRATCH2, AARCH64_SCRATCH);
+    aarch64_br(out, AARCH64_SCRATCH);
+    return 1;
+}
+
+/**
+ * @brief Bir IR komutunu makine koduna çevirir.
+ * @param next Yerleşimde bir sonraki blok (yoksa IR_NO_BLOCK); ona giden atlamalar atlanır.
+ */
+static int aarch64_emit_instruction(Aarch64Codegen* cg, const IrInstr* instr, int32_t line, uint32_t next) {
+    Aarch64Buffer* out = cg->out;
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    Aarch64Register dst, first, source;
+    switch (opcode) {
+        case IR_OP_MOV:
+            if (!aarch64_register(cg, instr->dst, &dst)) return 0;
+            if (instr->attrs & IR_ATTR_IMM) {
+                aarch64_mov_imm(out, dst, ir_instr_immediate(cg->fn, instr));
+                return 1;
+            }
+            if (!aarch64_register(cg, instr->u.op.src2, &source)) return 0;
+            if (source != dst) aarch64_mov(out, dst, source);
+            return 1;
+        case IR_OP_ADD:
+        case IR_OP_SUB: {
+            IselOperand leaves[ISEL_MAX_LEAVES];
+            int rule = aarch64_selected_rule(cg, instr, leaves);
+            // Bayraklar (sonuç, 0) karşılaştırmasıdır. adds/subs sıfır bayrağını doğru kurar ama taşma
+            // bayrağı farklıdır: sadece eşitlik okuyucuları varsa adds/subs, aksi halde cmp #0 yazılır.
+            uint8_t readers = instr->flags != IR_NO_VREG && !(instr->attrs & IR_ATTR_FLAGS_CLOBBER)
+                                  ? cg->flags_read[instr->flags] : 0;
+            int set_flags = readers == AARCH64_FLAGS_READ_EQUALITY;
+            if (rule == AARCH64_RULE_SHIFTED_OPERAND || rule == AARCH64_RULE_MULTIPLY_ADD) {
+                // leaves: a, b, çarpan (a +/- b * çarpan)
+                if (!aarch64_register(cg, instr->dst, &dst) || !aarch64_register(cg, leaves[0].vreg, &first) ||
+                    !aarch64_register(cg, leaves[1].vreg, &source)) {
+                    return 0;
+                }
+                if (rule == AARCH64_RULE_SHIFTED_OPERAND) {
+                    uint32_t shift = aarch64_log2(leaves[2].imm);
+                    if (opcode == IR_OP_ADD) {
+                        (set_flags ? aarch64_adds_lsl : aarch64_add_lsl)(out, dst, first, source, shift);
+                    } else {
+                        (set_flags ? aarch64_subs_lsl : aarch64_sub_lsl)(out, dst, first, source, shift);
+                    }
+                } else {
+                    set_flags = 0; // madd/msub'ın bayrak kuran biçimi yok
+                    Aarch64Register factor;
+                    if (!aarch64_leaf_register(cg, &leaves[2], AARCH64_SCRATCH, &factor)) return 0;
+                    if (opcode == IR_OP_ADD) {
+                        aarch64_madd(out, dst, source, factor, first);
+                    } else {
+                        aarch64_msub(out, dst, source, factor, first);
+                    }
+                }
+            } else {
+                uint16_t src1 = rule == AARCH64_RULE_THREE_ADDRESS ? leaves[0].vreg : instr->u.op.src1;
+                if (!aarch64_register(cg, instr->dst, &dst) || !aarch64_register(cg, src1, &first)) return 0;
+                if (instr->attrs & IR_ATTR_IMM) {
+                    int64_t value = ir_instr_immediate(cg->fn, instr);
+                    aarch64_emit_add_constant(cg, dst, first,
+                                              opcode == IR_OP_ADD ? value : (int64_t)(0 - (uint64_t)value), set_flags);
+                } else {
+                    if (!aarch64_register(cg, instr->u.op.src2, &source)) return 0;
+                    if (opcode == IR_OP_ADD) {
+                        (set_flags ? aarch64_adds : aarch64_add)(out, dst, first, source);
+                    } else {
+                        (set_flags ? aarch64_subs : aarch64_sub)(out, dst, first, source);
+                    }
+                }
+            }
+            if (readers && !set_flags) aarch64_cmp_imm(out, dst, 0);
+            return 1;
+        }
+        case IR_OP_CMP:
+            if (!aarch64_register(cg, instr->u.op.src1, &first)) return 0;
+            if (instr->attrs & IR_ATTR_IMM) {
+                int64_t value = ir_instr_immediate(cg->fn, instr);
+                if (value >= 0 && value < 4096) {
+                    aarch64_cmp_imm(out, first, (uint32_t)value);
+                    return 1;
+                }
+                if (value < 0 && value > -4096) {
+                    aarch64_cmn_imm(out, first, (uint32_t)-value);
+                    return 1;
+                }
+            }
+            if (!aarch64_second_source(cg, instr, &source)) return 0;
+            aarch64_cmp(out, first, source);
+            return 1;
+        case IR_OP_MUL: {
+            IselOperand leaves[ISEL_MAX_LEAVES];
+            int rule = aarch64_selected_rule(cg, instr, leaves);
+            uint16_t src1 = rule == AARCH64_RULE_DEFAULT ? instr->u.op.src1 : leaves[0].vreg;
+            if (!aarch64_register(cg, instr->dst, &dst) || !aarch64_register(cg, src1, &first)) return 0;
+            if (rule == AARCH64_RULE_SHIFT) {
+                aarch64_lsl_imm(out, dst, first, aarch64_log2(leaves[1].imm));
+                return 1;
+            }
+            if (!aarch64_second_source(cg, instr, &source)) return 0;
+            aarch64_mul(out, dst, first, source);
+            return 1;
+        }
+        case IR_OP_SEL:
+            if (!aarch64_register(cg, instr->dst, &dst) || !aarch64_register(cg, instr->u.op.src1, &first) ||
+                !aarch64_second_source(cg, instr, &source)) {
+                return 0;
+            }
+            aarch64_csel(out, dst, source, first, aarch64_conditions[instr->cond]);
+            return 1;
+        case IR_OP_DIV:
+            if (!aarch64_register(cg, instr->dst, &dst) || !aarch64_register(cg, instr->u.op.src1, &first)) return 0;
+            if ((instr->attrs & IR_ATTR_IMM) && ir_instr_immediate(cg->fn, instr) == 0) {
+                aarch64_add_stub(cg, aarch64_b(out), JIT_EXIT_DIVIDE_BY_ZERO, line);
+                return 1;
+            }
+            if (!aarch64_second_source(cg, instr, &source)) return 0;
+            if (!(instr->attrs & IR_ATTR_IMM)) aarch64_add_stub(cg, aarch64_cbz(out, source), JIT_EXIT_DIVIDE_BY_ZERO, line);
+            aarch64_sdiv(out, dst, first, source);
+            return 1;
+        case IR_OP_CALL:
+            aarch64_mov_sp(out, AARCH64_SCRATCH, AARCH64_SP);
+            aarch64_cmp(out, AARCH64_SCRATCH, AARCH64_STACK_LIMIT);
+            aarch64_add_stub(cg, aarch64_b_cond(out, AARCH64_CC_LS), JIT_EXIT_CALL_OVERFLOW, line);
+            aarch64_str_pre(out, AARCH64_X30, AARCH64_SP, -AARCH64_CALL_FRAME_SIZE);
+            aarch64_add_fixup(cg, aarch64_bl(out), instr->u.br.taken, 0);
+            aarch64_ldr_post(out, AARCH64_X30, AARCH64_SP, AARCH64_CALL_FRAME_SIZE);
+            return 1;
+        case IR_OP_SYSCALL:
+            return aarch64_emit_linux_syscall(cg, instr);
+        case IR_OP_PROFDUMP:
+            aarch64_emit_runtime_call(cg, "__bsm_prof_dump");
+            return 1;
+        case IR_OP_PROFCNT: {
+            int64_t counter = ir_instr_immediate(cg->fn, instr);
+            if (counter < 0 || counter > INT32_MAX / 8) {
+                fprintf(stderr, "Hata: aarch64 kod üretimi: geçersiz sayaç indeksi %lld.\n", (long long)counter);
+                return 0;
+            }
+            // Bayraklar korunmalı: add/ldr/str bayrak değiştirmez
+            uint32_t offset = (uint32_t)counter * 8;
+            aarch64_ldr(out, AARCH64_SCRATCH, AARCH64_STATE, AARCH64_STATE_OFFSET(counters));
+            if (offset > 32760) {
+                aarch64_mov_imm(out, AARCH64_SCRATCH2, offset);
+                aarch64_add(out, AARCH64_SCRATCH, AARCH64_SCRATCH, AARCH64_SCRATCH2);
+                offset = 0;
+            }
+            aarch64_ldr(out, AARCH64_SCRATCH2, AARCH64_SCRATCH, offset);
+            aarch64_add_imm(out, AARCH64_SCRATCH2, AARCH64_SCRATCH2, 1, 0);
+            aarch64_str(out, AARCH64_SCRATCH2, AARCH64_SCRATCH, offset);
+            return 1;
+        }
+        case IR_OP_JMP:
+            if (instr->u.br.taken != next) aarch64_add_fixup(cg, aarch64_b(out), instr->u.br.taken, 0);
+            return 1;
+        case IR_OP_BR: {
+            IrCondition cond = (IrCondition)instr->cond;
+            uint32_t taken = instr->u.br.taken;
+            uint32_t fallthrough = instr->u.br.fallthrough;
+            if (taken == next && fallthrough != next) {
+                // Koşulu tersine çevirerek ek b'den kaçın
+                cond = aarch64_inverse_condition[cond];
+                taken = fallthrough;
+                fallthrough = next;
+            }
+            aarch64_emit_branch(cg, aarch64_conditions[cond], taken);
+            if (fallthrough != next) aarch64_add_fixup(cg, aarch64_b(out), fallthrough, 0);
+            return 1;
+        }
+        case IR_OP_JTAB:
+            return aarch64_emit_jump_table(cg, instr);
+        case IR_OP_RET:
+            aarch64_ret(out);
+            return 1;
+        case IR_OP_END:
+            aarch64_patch_branch(out, aarch64_b(out), cg->leave);
+            return 1;
+        default:
+            fprintf(stderr, "Hata: aarch64 kod üretimi: desteklenmeyen IR komutu '%s'.\n", ir_opcode_to_string(opcode));
+            return 0;
+    }
+}
+
+// --- Giriş, Hatalar ve print Yordamı ---
+
+/**
+ * @brief Giriş (_start veya main): durum adresini, çağrı derinliği sınırını ve PGO çalışma
+ * zamanını kurar, Bessambly kaydedicilerini sıfırlar ve gövdeyi çağırır. Çıkış exit_group(0)'dır.
+ * @return Gövdeyi çağıran bl'nin konumu.
+ */
+static size_t aarch64_emit_entry(Aarch64Codegen* cg) {
+    Aarch64Buffer* out = cg->out;
+    aarch64_adr_symbol(out, AARCH64_STATE, AARCH64_SYMBOL_STATE, 0);
+    // Gövde girişteki bl ile başlar (yığına bir şey itilmez); her CALL 16 bayt iner.
+    // Sınır 4096'nın katıdır, sabit alanına 12 bit kaydırılmış sığar.
+    aarch64_sub_imm(out, AARCH64_STACK_LIMIT, AARCH64_SP, (AARCH64_CALL_FRAME_SIZE * JIT_MAX_CALL_DEPTH) >> 12, 1);
+    if (cg->instrumented) {
+        aarch64_mov_imm(out, AARCH64_X0, (int64_t)cg->profile_checksum);
+        aarch64_mov_imm(out, AARCH64_X1, (int64_t)cg->num_counters);
+        aarch64_adr_symbol(out, AARCH64_X2, AARCH64_SYMBOL_RODATA, (int64_t)cg->profile_path);
+        aarch64_add_runtime_call(cg, aarch64_bl(out), "__bsm_prof_init");
+        aarch64_add_runtime_call(cg, aarch64_bl(out), "__bsm_prof_thread_init");
+        aarch64_str(out, AARCH64_X0, AARCH64_STATE, AARCH64_STATE_OFFSET(counters));
+    }
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) aarch64_movz(out, cg->registers[r], 0, 0);
+    size_t body_call = aarch64_bl(out);
+
+    // Çıkış: gövdeden dönüş ve END
+    cg->leave = out->size;
+    if (cg->instrumented) aarch64_emit_runtime_call(cg, "__bsm_prof_dump");
+    aarch64_movz(out, AARCH64_X0, 0, 0);
+    aarch64_movz(out, AARCH64_X8, AARCH64_LINUX_SYS_EXIT_GROUP, 0);
+    aarch64_svc(out, 0);
+    return body_call;
+}
+
+/**
+ * @brief Soğuk hata kodları: her biri satır numaralı mesajını (.rodata) X1/X2'ye yükleyip mesajı
+ * stderr'e yazan ve 1 koduyla çıkan ortak koda atlar.
+ * @return Başarılıysa 1; dal erişimi aşılırsa veya bellek hatasında 0.
+ */
+static int aarch64_emit_stubs(Aarch64Codegen* cg) {
+    Aarch64Buffer* out = cg->out;
+    if (cg->num_stubs == 0) return 1;
+    size_t error_exit = out->size;
+    aarch64_movz(out, AARCH64_X0, 2, 0);
+    aarch64_movz(out, AARCH64_X8, AARCH64_LINUX_SYS_WRITE, 0);
+    aarch64_svc(out, 0);
+    aarch64_movz(out, AARCH64_X0, 1, 0);
+    aarch64_movz(out, AARCH64_X8, AARCH64_LINUX_SYS_EXIT_GROUP, 0);
+    aarch64_svc(out, 0);
+    for (size_t s = 0; s < cg->num_stubs; s++) {
+        char message[128];
+        int length;
+        if (cg->stubs[s].reason == JIT_EXIT_DIVIDE_BY_ZERO) {
+            length = snprintf(message, sizeof(message), "Hata: satır %d: sıfıra bölme.\n", cg->stubs[s].line);
+        } else {
+            length = snprintf(message, sizeof(message), "Hata: satır %d: çağrı yığını taştı (derinlik %d).\n",
+                              cg->stubs[s].line, JIT_MAX_CALL_DEPTH);
+        }
+        size_t offset = cg->obj->sections[cg->rodata].size;
+        if (!object_file_append(cg->obj, cg->rodata, message, (size_t)length)) return 0;
+        if (!aarch64_patch_branch(out, cg->stubs[s].position, out->size)) {
+            fprintf(stderr, "Hata: aarch64 kod üretimi: satır %d: hata dalı erişim dışında (kod çok büyük).\n",
+                    cg->stubs[s].line);
+            return 0;
+        }
+        aarch64_adr_symbol(out, AARCH64_X1, AARCH64_SYMBOL_RODATA, (int64_t)offset);
+        aarch64_movz(out, AARCH64_X2, (uint16_t)length, 0);
+        aarch64_patch_branch(out, aarch64_b(out), error_exit);
+    }
+    return 1;
+}
+
+/**
+ * @brief print yordamı. X0 argüman sayısıdır, argümanlar .bss'tedir. Sayılar ondalık olarak,
+ * boşlukla ayrılıp satır sonuyla tek bir write çağrısıyla stdout'a yazılır; metin yığındaki
+ * tamponun sonundan başına doğru (son argümandan ilkine) üretilir. Sadece X0-X8 kullanılır.
+ * @return Yordamın konumu.
+ */
+static size_t aarch64_emit_print_routine(Aarch64Codegen* cg) {
+    Aarch64Buffer* out = cg->out;
+    // Argüman başına en fazla 20 basamak, işaret ve ayırıcı; sonda satır sonu (16'nın katı)
+    const uint32_t buffer_size = 384;
+    size_t start = out->size;
+    aarch64_sub_imm(out, AARCH64_SP, AARCH64_SP, buffer_size, 0);
+    aarch64_add_imm(out, AARCH64_X1, AARCH64_SP, buffer_size, 0); // Tamponun sonu
+    aarch64_sub_imm(out, AARCH64_X2, AARCH64_X1, 1, 0);           // Yazma konumu
+    aarch64_movz(out, AARCH64_X3, 10, 0);
+    aarch64_strb(out, AARCH64_X3, AARCH64_X2, 0);                 // '\n'
+    aarch64_add_imm(out, AARCH64_X4, AARCH64_STATE, AARCH64_STATE_OFFSET(print_args), 0);
+    size_t no_args = aarch64_cbz(out, AARCH64_X0);
+
+    size_t next_argument = out->size;
+    aarch64_sub_imm(out, AARCH64_X0, AARCH64_X0, 1, 0);
+    aarch64_ldr_index(out, AARCH64_X5, AARCH64_X4, AARCH64_X0);
+    aarch64_mov(out, AARCH64_X6, AARCH64_X5);
+    aarch64_cmp_imm(out, AARCH64_X5, 0);
+    size_t positive = aarch64_b_cond(out, AARCH64_CC_GE);
+    aarch64_neg(out, AARCH64_X5, AARCH64_X5); // INT64_MIN işaretsiz bölmede doğru kalır
+    aarch64_patch_branch(out, positive, out->size);
+    size_t next_digit = out->size;
+    aarch64_udiv(out, AARCH64_X7, AARCH64_X5, AARCH64_X3);
+    aarch64_msub(out, AARCH64_X8, AARCH64_X7, AARCH64_X3, AARCH64_X5); // Kalan
+    aarch64_add_imm(out, AARCH64_X8, AARCH64_X8, '0', 0);
+    aarch64_strb_pre(out, AARCH64_X8, AARCH64_X2, -1);
+    aarch64_mov(out, AARCH64_X5, AARCH64_X7);
+    aarch64_patch_branch(out, aarch64_cbnz(out, AARCH64_X5), next_digit);
+    aarch64_cmp_imm(out, AARCH64_X6, 0);
+    size_t no_sign = aarch64_b_cond(out, AARCH64_CC_GE);
+    aarch64_movz(out, AARCH64_X8, '-', 0);
+    aarch64_strb_pre(out, AARCH64_X8, AARCH64_X2, -1);
+    aarch64_patch_branch(out, no_sign, out->size);
+    size_t done = aarch64_cbz(out, AARCH64_X0);
+    aarch64_movz(out, AARCH64_X8, ' ', 0);
+    aarch64_strb_pre(out, AARCH64_X8, AARCH64_X2, -1);
+    aarch64_patch_branch(out, aarch64_b(out), next_argument);
+
+    aarch64_patch_branch(out, no_args, out->size);
+    aarch64_patch_branch(out, done, out->size);
+    aarch64_sub(out, AARCH64_X3, AARCH64_X1, AARCH64_X2);
+    aarch64_mov(out, AARCH64_X1, AARCH64_X2);
+    aarch64_mov(out, AARCH64_X2, AARCH64_X3);
+    aarch64_movz(out, AARCH64_X0, 1, 0);
+    aarch64_movz(out, AARCH64_X8, AARCH64_LINUX_SYS_WRITE, 0);
+    aarch64_svc(out, 0);
+    aarch64_add_imm(out, AARCH64_SP, AARCH64_SP, buffer_size, 0);
+    aarch64_ret(out);
+    return start;
+}
+
+static void aarch64_codegen_free(Aarch64Codegen* cg) {
+    free(cg->flags_read);
+    isel_selection_free(&cg->selection);
+    isel_matcher_free(&cg->matcher);
+    free(cg->block_offsets);
+    free(cg->fixups);
+    free(cg->relaxed);
+    free(cg->stubs);
+    free(cg->tables);
+    free(cg->runtime_calls);
+}
+
+/**
+ * @brief Tek üretim geçişi: giriş, bloklar (yerleşim sırasıyla), soğuk kodlar, print yordamı ve
+ * dal düzeltmeleri.
+ * @param relaxed Erişimi yetmeyen bir b.cond uzun biçime çevrildiyse 1 yapılır (geçiş tekrarlanır).
+ */
+static int aarch64_generate_pass(Aarch64Codegen* cg, int* relaxed) {
+    const IrFunction* fn = cg->fn;
+    Aarch64Buffer* out = cg->out;
+    int ok = 1;
+    *relaxed = 0;
+    for (size_t i = 0; i < fn->num_blocks; i++) cg->block_offsets[i] = SIZE_MAX;
+
+    size_t body_call = aarch64_emit_entry(cg);
+    if (fn->num_layout > 0) {
+        aarch64_add_fixup(cg, body_call, fn->layout[0], 0);
+    } else {
+        aarch64_patch_branch(out, body_call, cg->leave);
+    }
+
+    for (size_t l = 0; l < fn->num_layout && ok; l++) {
+        uint32_t b = fn->layout[l];
+        uint32_t next = l + 1 < fn->num_layout ? fn->layout[l + 1] : IR_NO_BLOCK;
+        const IrBlock* block = &fn->blocks[b];
+        cg->block_offsets[b] = out->size;
+        for (uint32_t k = 0; k < block->num_instrs && ok; k++) {
+            size_t index = block->first + k;
+            if (cg->selection.folded[index]) continue; // Kullanıldığı komutun kalıbında yazılır
+            ok = aarch64_emit_instruction(cg, &fn->instrs[index], fn->locations ? fn->locations[index].line : 0, next);
+        }
+    }
+    if (ok) ok = aarch64_emit_stubs(cg);
+
+    // print yordamı sadece kullanılıyorsa yazılır
+    size_t print_routine = SIZE_MAX;
+    for (size_t c = 0; c < cg->num_runtime_calls && ok; c++) {
+        if (cg->runtime_calls[c].symbol) continue;
+        if (print_routine == SIZE_MAX) print_routine = aarch64_emit_print_routine(cg);
+        aarch64_patch_branch(out, cg->runtime_calls[c].position, print_routine);
+    }
+
+    for (size_t f = 0; f < cg->num_fixups && ok; f++) {
+        uint32_t target = cg->fixups[f].block;
+        if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+            fprintf(stderr, "Hata: aarch64 kod üretimi: yerleşimde olmayan bloğa dal (b%u).\n", target);
+            ok = 0;
+        } else if (aarch64_patch_branch(out, cg->fixups[f].position, cg->block_offsets[target])) {
+            continue;
+        } else if (cg->fixups[f].relaxable) {
+            aarch64_relax(cg, f);
+            *relaxed = 1;
+        } else {
+            fprintf(stderr, "Hata: aarch64 kod üretimi: b%u bloğuna dal erişim dışında (kod çok büyük).\n", target);
+            ok = 0;
+        }
+    }
+    if (ok && (out->failed || cg->out_of_memory)) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * @brief Kod üretimi. Koşullu dallar önce kısa (b.cond) biçimde yazılır; erişimi yetmeyenler
+ * uzatılıp kod baştan üretilir, ta ki hiçbir dal uzamayana dek.
+ */
+static int aarch64_generate(Aarch64Codegen* cg) {
+    const IrFunction* fn = cg->fn;
+    Aarch64Buffer* out = cg->out;
+    cg->flags_read = (uint8_t*)calloc(fn->num_vregs + 1, 1);
+    cg->block_offsets = (size_t*)malloc(sizeof(size_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    if (!cg->flags_read || !cg->block_offsets) {
+        fprintf(stderr, "Hata: aarch64 kod üretimi için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+
+    // ADD/SUB bayrakları okuyucularına göre yazılır; mimari bayrak değeri bloklar arasında
+    // taşındığı için okuyucuları bilinmez (sıralama okuyucusu var kabul edilir)
+    cg->flags_read[IR_VREG_FLAGS] = AARCH64_FLAGS_READ_ORDER;
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if ((instr->opcode == IR_OP_BR || instr->opcode == IR_OP_SEL) && instr->flags < fn->num_vregs) {
+            cg->flags_read[instr->flags] |= instr->cond == IR_COND_EQ || instr->cond == IR_COND_NE
+                                                ? AARCH64_FLAGS_READ_EQUALITY : AARCH64_FLAGS_READ_ORDER;
+        }
+    }
+    aarch64_assign_registers(cg);
+    if (!isel_compile(&cg->matcher, aarch64_patterns, sizeof(aarch64_patterns) / sizeof(aarch64_patterns[0]),
+                      "aarch64") ||
+        !isel_select(&cg->matcher, fn, cg, &cg->selection)) {
+        return 0;
+    }
+
+    size_t rodata_size = cg->obj->sections[cg->rodata].size;
+    int relaxed;
+    int ok = aarch64_generate_pass(cg, &relaxed);
+    while (ok && relaxed) {
+        // Önceki geçişin çıktısı atılır; hata mesajları .rodata'ya yeniden eklenir
+        out->size = 0;
+        out->num_symbol_refs = 0;
+        cg->num_fixups = cg->num_stubs = cg->num_tables = cg->num_runtime_calls = 0;
+        cg->obj->sections[cg->rodata].size = rodata_size;
+        ok = aarch64_generate_pass(cg, &relaxed);
+    }
+    return ok;
+}
+
+/**
+ * @brief Atlama tablolarını .rodata'ya REL32 girişlerle yazar. Hedef bloklar için yerel semboller
+ * tanımlanır; tablo adresini yükleyen adrp + add tablo sembolüne bağlanır.
+ */
+static int aarch64_emit_object_tables(Aarch64Codegen* cg, int text) {
+    const IrFunction* fn = cg->fn;
+    ObjectFile* obj = cg->obj;
+    for (size_t t = 0; t < cg->num_tables; t++) {
+        const IrJumpTable* table = &fn->jump_tables[cg->tables[t].table];
+        char (*names)[32] = (char(*)[32])malloc(sizeof(*names) * (table->num_targets ? table->num_targets : 1));
+        const char** targets = (const char**)malloc(sizeof(char*) * (table->num_targets ? table->num_targets : 1));
+        int ok = names && targets;
+        if (!ok) fprintf(stderr, "Hata: aarch64 kod üretimi için bellek tahsis edilemedi.\n");
+        for (uint32_t e = 0; e < table->num_targets && ok; e++) {
+            uint32_t target = fn->pool[table->first_target + e];
+            if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+                fprintf(stderr, "Hata: aarch64 kod üretimi: atlama tablosu yerleşimde olmayan bloğu gösteriyor (b%u).\n",
+                        target);
+                ok = 0;
+                break;
+            }
+            snprintf(names[e], sizeof(names[e]), "__bsm_b%u", target);
+            targets[e] = names[e];
+            int symbol = object_file_symbol(obj, names[e]);
+            if (symbol < 0) {
+                ok = 0;
+            } else if (!obj->symbols[symbol].declared) {
+                ok = object_file_define_symbol(obj, names[e], text, cg->block_offsets[target], OBJ_SYMBOL_LOCAL,
+                                               OBJ_SYMBOL_NOTYPE) >= 0;
+            }
+        }
+        char table_name[32];
+        snprintf(table_name, sizeof(table_name), "__bsm_jtab%zu", t);
+        ok = ok && object_file_emit_jump_table(obj, table_name, targets, table->num_targets, JUMP_TABLE_REL32) &&
+             object_file_add_relocation(obj, text, cg->tables[t].position, table_name, RELOC_AARCH64_ADR_PAGE21, 0) &&
+             object_file_add_relocation(obj, text, cg->tables[t].position + 4, table_name, RELOC_AARCH64_ADD_LO12, 0);
+        free(names);
+        free(targets);
+        if (!ok) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Bessambly etiketlerini bloklarının son yerleşimdeki konumlarında yerel semboller olarak
+ * tanımlar; derleyicinin sembol tablosu gerçek adresleri buradan alır. Nesne dosyasında zaten
+ * bulunan adlar (giriş noktası, çalışma zamanı sembolleri) atlanır.
+ */
+static int aarch64_define_labels(Aarch64Codegen* cg, int text) {
+    const IrFunction* fn = cg->fn;
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        if (cg->block_offsets[b] == SIZE_MAX) continue;
+        for (uint32_t k = 0; k < block->num_labels; k++) {
+            const char* name = ir_label_name(fn, &fn->labels[block->first_label + k]);
+            if (object_file_find_symbol(cg->obj, name) >= 0) continue;
+            if (object_file_define_symbol(cg->obj, name, text, cg->block_offsets[b], OBJ_SYMBOL_LOCAL,
+                                          OBJ_SYMBOL_NOTYPE) < 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int aarch64_generate_object(const IrFunction* fn, ObjectFile* obj, const ObjectCodegenOptions* options,
+                            ObjectCodegenStats* stats) {
+    Aarch64Buffer out = {0};
+    Aarch64Codegen cg;
+    memset(&cg, 0, sizeof(cg));
+    cg.fn = fn;
+    cg.out = &out;
+    cg.obj = obj;
+
+    int text = object_file_add_section(obj, ".text", OBJ_SECTION_TEXT, 16);
+    cg.rodata = object_file_add_section(obj, ".rodata", OBJ_SECTION_RODATA, 8);
+    int bss = object_file_add_section(obj, ".bss", OBJ_SECTION_BSS, 16);
+    int ok = text >= 0 && cg.rodata >= 0 && bss >= 0 &&
+             object_file_define_symbol(obj, AARCH64_RODATA_SYMBOL, cg.rodata, 0, OBJ_SYMBOL_LOCAL,
+                                       OBJ_SYMBOL_OBJECT) >= 0;
+
+    // PGO: sayaç sayısı seçeneklerden veya IR'deki en büyük sayaçtan
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode == IR_OP_PROFDUMP) cg.instrumented = 1;
+        if (instr->opcode != IR_OP_PROFCNT) continue;
+        cg.instrumented = 1;
+        int64_t counter = ir_instr_immediate(fn, instr);
+        if (counter >= 0 && (uint64_t)counter + 1 > cg.num_counters) cg.num_counters = (uint64_t)counter + 1;
+    }
+    if (ok && cg.instrumented) {
+        const char* path = options && options->profile_path ? options->profile_path : BSM_PROFILE_DEFAULT_PATH;
+        if (options && options->profile_num_counters > cg.num_counters) cg.num_counters = options->profile_num_counters;
+        cg.profile_checksum = options ? options->profile_checksum : 0;
+        cg.profile_path = obj->sections[cg.rodata].size;
+        ok = object_file_append(obj, cg.rodata, path, strlen(path) + 1);
+    }
+
+    ok = ok && aarch64_generate(&cg);
+
+    int entry = -1, state = -1;
+    if (ok) {
+        ok = object_file_append(obj, text, out.data, out.size);
+        const char* entry_name = cg.instrumented ? AARCH64_INSTRUMENTED_ENTRY_SYMBOL : AARCH64_ENTRY_SYMBOL;
+        entry = ok ? object_file_define_symbol(obj, entry_name, text, 0, OBJ_SYMBOL_GLOBAL, OBJ_SYMBOL_FUNCTION)
+                   : -1;
+        state = ok ? object_file_define_symbol(obj, AARCH64_STATE_SYMBOL, bss, 0, OBJ_SYMBOL_LOCAL,
+                                               OBJ_SYMBOL_OBJECT) : -1;
+        ok = entry >= 0 && state >= 0 && object_file_append(obj, bss, NULL, sizeof(Aarch64NativeState));
+    }
+    if (ok) {
+        obj->symbols[entry].size = out.size;
+        obj->symbols[state].size = sizeof(Aarch64NativeState);
+    }
+    for (size_t r = 0; r < out.num_symbol_refs && ok; r++) {
+        const Aarch64SymbolRef* ref = &out.symbol_refs[r];
+        const char* name = ref->symbol == AARCH64_SYMBOL_STATE ? AARCH64_STATE_SYMBOL : AARCH64_RODATA_SYMBOL;
+        RelocationKind kind = ref->kind == AARCH64_REF_PAGE21 ? RELOC_AARCH64_ADR_PAGE21 : RELOC_AARCH64_ADD_LO12;
+        ok = object_file_add_relocation(obj, text, ref->position, name, kind, ref->addend);
+    }
+    for (size_t c = 0; c < cg.num_runtime_calls && ok; c++) {
+        const char* symbol = cg.runtime_calls[c].symbol;
+        if (!symbol) continue; // print yordamı kodun içindedir
+        ok = object_file_define_symbol(obj, symbol, OBJ_SECTION_UNDEFINED, 0, OBJ_SYMBOL_GLOBAL,
+                                       OBJ_SYMBOL_FUNCTION) >= 0 &&
+             object_file_add_relocation(obj, text, cg.runtime_calls[c].position, symbol, RELOC_AARCH64_CALL26, 0);
+    }
+    ok = ok && aarch64_emit_object_tables(&cg, text);
+    ok = ok && aarch64_define_labels(&cg, text);
+
+    if (ok && stats) {
+        stats->code_size = out.size;
+        stats->num_machine_registers = IR_NUM_REGISTERS;
+        stats->num_relocations = obj->num_relocations;
+        stats->num_folded_instrs = cg.selection.num_folded;
+        stats->num_scheduled_regions = 0;
+    }
+    aarch64_codegen_free(&cg);
+    aarch64_buffer_free(&out);
+    return ok;
+}
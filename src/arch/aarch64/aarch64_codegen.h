@@ -0,0 +1,62 @@
+#ifndef AARCH64_CODEGEN_H
+#define AARCH64_CODEGEN_H
+
+#include "ir_generator.h" // IrFunction (kod üretiminin girdisi)
+#include "arch/aarch64/aarch64_encoder.h" // Aarch64Buffer
+#include "object_file_writer.h" // ObjectFile, ObjectCodegenOptions
+
+// --- AArch64 Kod Üretimi (Linux nesne dosyası) ---
+// IR, ARMv8-A/ARMv9-A (A64) makine koduna çevrilip bağlanıp doğrudan çalıştırılacak bir ELF nesne
+// dosyasına yazılır. 31 genel amaçlı kaydedici olduğu için R0-R15'in tamamı sabit makine
+// kaydedicilerindedir, bellekte kaydedici yoktur:
+//  - X19-X27 (çağrılanın koruduğu) ve X9-X15: R0-R15, en sık kullanılanlar önce X19-X27'ye.
+//  - X28: .bss'teki çalışma zamanı durumunun adresi; X29: çağrı derinliği sınırı (yığın adresi).
+//  - X16, X17: geçici (büyük sabitler, atlama tablosu, sayaçlar); X0-X8: sistem çağrısı ve print.
+// Komutlar 3 adreslidir (kaynak ve hedef ayrı kaydediciler olabilir). Sabitler movz/movn + movk
+// ile yüklenir; ADD/SUB/CMP'de 12 bitlik (gerekirse 12 bit kaydırılmış) sabit alanı kullanılır.
+// MUL "mul" (madd), DIV "sdiv"dir; sdiv sıfıra bölmede tuzak üretmediği için bölen önce "cbz"
+// ile denetlenir (INT64_MIN / -1 donanımda zaten sarmalıdır). SELcc "csel"dir.
+//
+// Bayraklar NZCV'de taşınır: CMP doğrudan "cmp"dir; bayrak kuran ADD/SUB'un sonucu okunuyorsa
+// ardından "cmp xd, #0" yazılır (Bessambly'de bayraklar (sonuç, 0) karşılaştırmasıdır). MOV,
+// SELcc ve PROFCNT bayrak değiştirmeyen komutlarla üretilir.
+//
+// CALL "bl"dir: dönüş adresi X30'dadır; CALL önce kendi X30'unu yığına (16 bayt, SP hizalı kalır)
+// saklar, dönüşte geri yükler. RET "ret"tir; böylece işlemcinin dönüş adresi tahmini çalışır.
+// Çağrı derinliği SP'nin X29 ile karşılaştırılmasıyla denetlenir.
+//
+// SYSCALL, Linux sistem çağrısı ABI'sine indirgenir: Bessambly numarası (Linux x86-64, BVM ile
+// aynı) target_linux_syscall_number ile AArch64 numarasına çevrilip X8'e, argümanlar X0-X5'e
+// yüklenir ve "svc #0" çalıştırılır; dönüş değeri R0'a yazılır. Çekirdek diğer kaydedicileri
+// korur. Argümansız exit/exit_group R0'ı çıkış kodu olarak kullanır. print çağrısı
+// (AARCH64_HYPERCALL_PRINT) koda gömülü bir yordamla stdout'a yazılır.
+//
+// Giriş noktası "_start"tır (örn: ld program.o); en dıştaki RET ve END 0 koduyla exit_group
+// çağırır. Yürütme hataları stderr'e satır numaralı bir mesaj yazıp 1 koduyla çıkar. Sembol
+// adresleri adrp + add ile yüklenir; atlama tabloları .rodata'dadır (REL32). PGO ile enstrümante
+// programlarda giriş noktası "main"dir (örn: cc program.o bsm_profile_rt.c).
+//
+// Bloklar arası koşullu dallar önce b.cond (±1 MB) olarak yazılır; erişimi yetmeyenler ters
+// koşullu b.cond + b (±128 MB) çiftine uzatılıp kod baştan üretilir. Diğer dallar ±128 MB erişir;
+// erişimi aşan kod hata ile reddedilir. Bessambly etiketleri .text'te bloklarının son
+// konumlarında yerel semboller olarak tanımlanır.
+
+#define AARCH64_LINUX_MAX_SYSCALL_ARGS 6
+#define AARCH64_MAX_PRINT_ARGS 16
+#define AARCH64_HYPERCALL_PRINT 0x1000  // BVM ile aynı numara
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief IR'yı Linux AArch64 için makine koduna çevirip nesne dosyasına yazar (.text, .rodata,
+ * .bss ve "_start" ya da enstrümante programlarda "main" sembolü).
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param obj Boş, ARCH_ARMV8 veya ARCH_ARMV9 için oluşturulmuş nesne dosyası.
+ * @param options Enstrümantasyon bilgileri (NULL olabilir).
+ * @param stats Boş değilse istatistikler yazılır.
+ * @return Başarılıysa 1, aksi takdirde 0 (stderr'e açıklama yazılır).
+ */
+int aarch64_generate_object(const IrFunction* fn, ObjectFile* obj, const ObjectCodegenOptions* options,
+                            ObjectCodegenStats* stats);
+
+#endif // AARCH64_CODEGEN_H
@@ -0,0 +1,330 @@
+#include "arch/aarch64/aarch64_encoder.h"
+#include <stdlib.h> // realloc, free
+
+// --- Tampon ---
+
+void aarch64_emit(Aarch64Buffer* buffer, uint32_t word) {
+    if (buffer->failed) return;
+    if (buffer->size + 4 > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity * 2 : 256;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, new_capacity);
+        if (!data) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = new_capacity;
+    }
+    for (int i = 0; i < 4; i++) buffer->data[buffer->size + i] = (uint8_t)(word >> (8 * i));
+    buffer->size += 4;
+}
+
+void aarch64_buffer_free(Aarch64Buffer* buffer) {
+    free(buffer->data);
+    free(buffer->symbol_refs);
+    buffer->data = NULL;
+    buffer->symbol_refs = NULL;
+    buffer->size = buffer->capacity = 0;
+    buffer->num_symbol_refs = buffer->symbol_ref_capacity = 0;
+}
+
+static void aarch64_add_symbol_ref(Aarch64Buffer* buffer, Aarch64SymbolRefKind kind, uint8_t symbol, int64_t addend) {
+    if (buffer->failed) return;
+    if (buffer->num_symbol_refs >= buffer->symbol_ref_capacity) {
+        size_t new_capacity = buffer->symbol_ref_capacity ? buffer->symbol_ref_capacity * 2 : 32;
+        Aarch64SymbolRef* refs =
+            (Aarch64SymbolRef*)realloc(buffer->symbol_refs, sizeof(Aarch64SymbolRef) * new_capacity);
+        if (!refs) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->symbol_refs = refs;
+        buffer->symbol_ref_capacity = new_capacity;
+    }
+    Aarch64SymbolRef* ref = &buffer->symbol_refs[buffer->num_symbol_refs++];
+    ref->position = buffer->size;
+    ref->addend = addend;
+    ref->symbol = symbol;
+    ref->kind = (uint8_t)kind;
+}
+
+static uint32_t aarch64_read(const Aarch64Buffer* buffer, size_t position) {
+    uint32_t word = 0;
+    for (int i = 0; i < 4; i++) word |= (uint32_t)buffer->data[position + i] << (8 * i);
+    return word;
+}
+
+int aarch64_patch_branch(Aarch64Buffer* buffer, size_t position, size_t target) {
+    if (buffer->failed || position + 4 > buffer->size) return 1;
+    int64_t delta = ((int64_t)target - (int64_t)position) / 4;
+    uint32_t word = aarch64_read(buffer, position);
+    if ((word & 0x7c000000u) == 0x14000000u) {
+        // B, BL: imm26
+        if (delta < -(1 << 25) || delta >= (1 << 25)) return 0;
+        word = (word & 0xfc000000u) | ((uint32_t)delta & 0x03ffffffu);
+    } else {
+        // B.cond, CBZ, CBNZ: imm19 (5. bitten başlar)
+        if (delta < -(1 << 18) || delta >= (1 << 18)) return 0;
+        word = (word & 0xff00001fu) | (((uint32_t)delta & 0x7ffffu) << 5);
+    }
+    for (int i = 0; i < 4; i++) buffer->data[position + i] = (uint8_t)(word >> (8 * i));
+    return 1;
+}
+
+void aarch64_adrp(Aarch64Buffer* buffer, Aarch64Register rd) {
+    aarch64_emit(buffer, 0x90000000u | rd);
+}
+
+void aarch64_adr_symbol(Aarch64Buffer* buffer, Aarch64Register rd, uint8_t symbol, int64_t offset) {
+    aarch64_add_symbol_ref(buffer, AARCH64_REF_PAGE21, symbol, offset);
+    aarch64_adrp(buffer, rd);
+    aarch64_add_symbol_ref(buffer, AARCH64_REF_ADD_LO12, symbol, offset);
+    aarch64_add_imm(buffer, rd, rd, 0, 0);
+}
+
+// --- Sabitler ve Taşımalar ---
+
+void aarch64_movz(Aarch64Buffer* buffer, Aarch64Register rd, uint16_t imm, int shift) {
+    aarch64_emit(buffer, 0xd2800000u | (uint32_t)(shift / 16) << 21 | (uint32_t)imm << 5 | rd);
+}
+
+void aarch64_movn(Aarch64Buffer* buffer, Aarch64Register rd, uint16_t imm, int shift) {
+    aarch64_emit(buffer, 0x92800000u | (uint32_t)(shift / 16) << 21 | (uint32_t)imm << 5 | rd);
+}
+
+void aarch64_movk(Aarch64Buffer* buffer, Aarch64Register rd, uint16_t imm, int shift) {
+    aarch64_emit(buffer, 0xf2800000u | (uint32_t)(shift / 16) << 21 | (uint32_t)imm << 5 | rd);
+}
+
+void aarch64_mov_imm(Aarch64Buffer* buffer, Aarch64Register rd, int64_t imm) {
+    uint64_t value = (uint64_t)imm;
+    int zero_chunks = 0, ones_chunks = 0;
+    for (int shift = 0; shift < 64; shift += 16) {
+        uint16_t chunk = (uint16_t)(value >> shift);
+        zero_chunks += chunk == 0;
+        ones_chunks += chunk == 0xffff;
+    }
+    // movn ile başlanırsa 0xffff parçaları, movz ile başlanırsa sıfır parçaları hazırdır
+    int inverted = ones_chunks > zero_chunks;
+    uint16_t skip = inverted ? 0xffff : 0;
+    int first = 1;
+    for (int shift = 0; shift < 64; shift += 16) {
+        uint16_t chunk = (uint16_t)(value >> shift);
+        if (chunk == skip) continue;
+        if (!first) {
+            aarch64_movk(buffer, rd, chunk, shift);
+        } else if (inverted) {
+            aarch64_movn(buffer, rd, (uint16_t)~chunk, shift);
+        } else {
+            aarch64_movz(buffer, rd, chunk, shift);
+        }
+        first = 0;
+    }
+    if (first) {
+        // Tüm parçalar atlandı: 0 veya -1
+        if (inverted) {
+            aarch64_movn(buffer, rd, 0, 0);
+        } else {
+            aarch64_movz(buffer, rd, 0, 0);
+        }
+    }
+}
+
+void aarch64_mov(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rm) {
+    aarch64_emit(buffer, 0xaa0003e0u | (uint32_t)rm << 16 | rd);
+}
+
+void aarch64_mov_sp(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn) {
+    aarch64_add_imm(buffer, rd, rn, 0, 0);
+}
+
+// --- Aritmetik ---
+
+static void aarch64_add_sub_imm(Aarch64Buffer* buffer, uint32_t opcode, Aarch64Register rd, Aarch64Register rn,
+                                uint32_t imm12, int lsl12) {
+    aarch64_emit(buffer, opcode | (lsl12 ? 1u << 22 : 0) | (imm12 & 0xfff) << 10 | (uint32_t)rn << 5 | rd);
+}
+
+void aarch64_add_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12) {
+    aarch64_add_sub_imm(buffer, 0x91000000u, rd, rn, imm12, lsl12);
+}
+
+void aarch64_sub_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12) {
+    aarch64_add_sub_imm(buffer, 0xd1000000u, rd, rn, imm12, lsl12);
+}
+
+void aarch64_adds_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12) {
+    aarch64_add_sub_imm(buffer, 0xb1000000u, rd, rn, imm12, lsl12);
+}
+
+void aarch64_subs_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12) {
+    aarch64_add_sub_imm(buffer, 0xf1000000u, rd, rn, imm12, lsl12);
+}
+
+void aarch64_cmp_imm(Aarch64Buffer* buffer, Aarch64Register rn, uint32_t imm12) {
+    aarch64_add_sub_imm(buffer, 0xf1000000u, AARCH64_XZR, rn, imm12, 0);
+}
+
+void aarch64_cmn_imm(Aarch64Buffer* buffer, Aarch64Register rn, uint32_t imm12) {
+    aarch64_add_sub_imm(buffer, 0xb1000000u, AARCH64_XZR, rn, imm12, 0);
+}
+
+static void aarch64_three(Aarch64Buffer* buffer, uint32_t opcode, Aarch64Register rd, Aarch64Register rn,
+                          Aarch64Register rm) {
+    aarch64_emit(buffer, opcode | (uint32_t)rm << 16 | (uint32_t)rn << 5 | rd);
+}
+
+void aarch64_add(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0x8b000000u, rd, rn, rm);
+}
+
+void aarch64_sub(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0xcb000000u, rd, rn, rm);
+}
+
+void aarch64_adds(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0xab000000u, rd, rn, rm);
+}
+
+void aarch64_subs(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0xeb000000u, rd, rn, rm);
+}
+
+void aarch64_add_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                     uint32_t shift) {
+    aarch64_three(buffer, 0x8b000000u | (shift & 63) << 10, rd, rn, rm);
+}
+
+void aarch64_sub_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                     uint32_t shift) {
+    aarch64_three(buffer, 0xcb000000u | (shift & 63) << 10, rd, rn, rm);
+}
+
+void aarch64_adds_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                      uint32_t shift) {
+    aarch64_three(buffer, 0xab000000u | (shift & 63) << 10, rd, rn, rm);
+}
+
+void aarch64_subs_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                      uint32_t shift) {
+    aarch64_three(buffer, 0xeb000000u | (shift & 63) << 10, rd, rn, rm);
+}
+
+void aarch64_lsl_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t shift) {
+    // ubfm rd, rn, #(-shift mod 64), #(63 - shift)
+    shift &= 63;
+    aarch64_emit(buffer, 0xd3400000u | ((64 - shift) & 63) << 16 | (63 - shift) << 10 | (uint32_t)rn << 5 | rd);
+}
+
+void aarch64_cmp(Aarch64Buffer* buffer, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0xeb000000u, AARCH64_XZR, rn, rm);
+}
+
+void aarch64_neg(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rm) {
+    aarch64_three(buffer, 0xcb000000u, rd, AARCH64_XZR, rm);
+}
+
+void aarch64_madd(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                  Aarch64Register ra) {
+    aarch64_three(buffer, 0x9b000000u | (uint32_t)ra << 10, rd, rn, rm);
+}
+
+void aarch64_msub(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                  Aarch64Register ra) {
+    aarch64_three(buffer, 0x9b008000u | (uint32_t)ra << 10, rd, rn, rm);
+}
+
+void aarch64_mul(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_madd(buffer, rd, rn, rm, AARCH64_XZR);
+}
+
+void aarch64_sdiv(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0x9ac00c00u, rd, rn, rm);
+}
+
+void aarch64_udiv(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0x9ac00800u, rd, rn, rm);
+}
+
+void aarch64_csel(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                  Aarch64Condition cond) {
+    aarch64_three(buffer, 0x9a800000u | (uint32_t)cond << 12, rd, rn, rm);
+}
+
+// --- Yükleme ve Saklama ---
+
+void aarch64_ldr(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, uint32_t offset) {
+    aarch64_emit(buffer, 0xf9400000u | (offset / 8) << 10 | (uint32_t)rn << 5 | rt);
+}
+
+void aarch64_str(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, uint32_t offset) {
+    aarch64_emit(buffer, 0xf9000000u | (offset / 8) << 10 | (uint32_t)rn << 5 | rt);
+}
+
+void aarch64_ldr_index(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0xf8607800u, rt, rn, rm);
+}
+
+void aarch64_ldrsw_index(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, Aarch64Register rm) {
+    aarch64_three(buffer, 0xb8a07800u, rt, rn, rm);
+}
+
+void aarch64_str_pre(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, int32_t offset) {
+    aarch64_emit(buffer, 0xf8000c00u | ((uint32_t)offset & 0x1ff) << 12 | (uint32_t)rn << 5 | rt);
+}
+
+void aarch64_ldr_post(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, int32_t offset) {
+    aarch64_emit(buffer, 0xf8400400u | ((uint32_t)offset & 0x1ff) << 12 | (uint32_t)rn << 5 | rt);
+}
+
+void aarch64_strb(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, uint32_t offset) {
+    aarch64_emit(buffer, 0x39000000u | (offset & 0xfff) << 10 | (uint32_t)rn << 5 | rt);
+}
+
+void aarch64_strb_pre(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, int32_t offset) {
+    aarch64_emit(buffer, 0x38000c00u | ((uint32_t)offset & 0x1ff) << 12 | (uint32_t)rn << 5 | rt);
+}
+
+// --- Dallar ---
+
+size_t aarch64_b(Aarch64Buffer* buffer) {
+    size_t position = buffer->size;
+    aarch64_emit(buffer, 0x14000000u);
+    return position;
+}
+
+size_t aarch64_bl(Aarch64Buffer* buffer) {
+    size_t position = buffer->size;
+    aarch64_emit(buffer, 0x94000000u);
+    return position;
+}
+
+size_t aarch64_b_cond(Aarch64Buffer* buffer, Aarch64Condition cond) {
+    size_t position = buffer->size;
+    aarch64_emit(buffer, 0x54000000u | cond);
+    return position;
+}
+
+size_t aarch64_cbz(Aarch64Buffer* buffer, Aarch64Register rt) {
+    size_t position = buffer->size;
+    aarch64_emit(buffer, 0xb4000000u | rt);
+    return position;
+}
+
+size_t aarch64_cbnz(Aarch64Buffer* buffer, Aarch64Register rt) {
+    size_t position = buffer->size;
+    aarch64_emit(buffer, 0xb5000000u | rt);
+    return position;
+}
+
+void aarch64_br(Aarch64Buffer* buffer, Aarch64Register rn) {
+    aarch64_emit(buffer, 0xd61f0000u | (uint32_t)rn << 5);
+}
+
+void aarch64_ret(Aarch64Buffer* buffer) {
+    aarch64_emit(buffer, 0xd65f03c0u);
+}
+
+void aarch64_svc(Aarch64Buffer* buffer, uint16_t imm) {
+    aarch64_emit(buffer, 0xd4000001u | (uint32_t)imm << 5);
+}
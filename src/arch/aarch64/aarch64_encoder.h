@@ -0,0 +1,170 @@
+#ifndef AARCH64_ENCODER_H
+#define AARCH64_ENCODER_H
+
+#include <stdint.h> // uint8_t, uint32_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- AArch64 (A64) Komut Kodlayıcı ---
+// Kod üreticilerin kullandığı küçük bir kodlayıcı: sadece 64-bit tamsayı komutlarının ihtiyaç
+// duyulan biçimleri vardır. Her komut 4 baytlık bir sözcüktür (küçük-sonlu). Bellek hatası
+// tamponun 'failed' alanına yazılır ve sonraki eklemeler yok sayılır (üretim sonunda bir kez
+// denetlenir). Dallar hedefi henüz bilinmeden yazılabilir: dal fonksiyonları komutun konumunu
+// döndürür, hedef belli olunca aarch64_patch_branch uzaklık alanını komutun türüne göre doldurur.
+// Sembol adresleri (aarch64_adr_symbol) adrp + add çiftiyle yüklenir; alanlar sıfır bırakılıp
+// tampona başvuru kayıtları eklenir (nesne dosyasında yeniden konumlandırmaya çevrilir).
+
+// --- Kaydediciler ---
+// 31 numarası komuta göre ya yığın göstericisi (SP) ya da sıfır kaydedicisidir (XZR).
+typedef enum {
+    AARCH64_X0, AARCH64_X1, AARCH64_X2, AARCH64_X3, AARCH64_X4, AARCH64_X5, AARCH64_X6, AARCH64_X7,
+    AARCH64_X8, AARCH64_X9, AARCH64_X10, AARCH64_X11, AARCH64_X12, AARCH64_X13, AARCH64_X14, AARCH64_X15,
+    AARCH64_X16, AARCH64_X17, AARCH64_X18, AARCH64_X19, AARCH64_X20, AARCH64_X21, AARCH64_X22, AARCH64_X23,
+    AARCH64_X24, AARCH64_X25, AARCH64_X26, AARCH64_X27, AARCH64_X28, AARCH64_X29, AARCH64_X30,
+    AARCH64_SP = 31,    // ADD/SUB (sabit), yükleme/saklama tabanı
+    AARCH64_XZR = 31    // Diğer komutlar
+} Aarch64Register;
+
+// --- Koşul Kodları (B.cond, CSEL) ---
+typedef enum {
+    AARCH64_CC_EQ = 0x0,
+    AARCH64_CC_NE = 0x1,
+    AARCH64_CC_HS = 0x2,    // İşaretsiz büyük veya eşit
+    AARCH64_CC_LO = 0x3,    // İşaretsiz küçük
+    AARCH64_CC_HI = 0x8,    // İşaretsiz büyük
+    AARCH64_CC_LS = 0x9,    // İşaretsiz küçük veya eşit
+    AARCH64_CC_GE = 0xa,
+    AARCH64_CC_LT = 0xb,
+    AARCH64_CC_GT = 0xc,
+    AARCH64_CC_LE = 0xd
+} Aarch64Condition;
+
+// Koşulun tersi: çiftler son bitle ayrılır (EQ/NE, HS/LO, GE/LT, ...)
+#define AARCH64_INVERSE(cond) ((Aarch64Condition)((cond) ^ 1))
+
+// Dal biçimlerinin erişimi (bayt): uzaklık [-erişim, erişim) aralığında olmalıdır
+#define AARCH64_COND_BRANCH_RANGE (1 << 20)     // b.cond, cbz, cbnz
+#define AARCH64_BRANCH_RANGE (1 << 27)          // b, bl
+
+// --- Sembol Başvurusu Türleri ---
+typedef enum {
+    AARCH64_REF_PAGE21,     // adrp: Page(S + A) - Page(P)
+    AARCH64_REF_ADD_LO12    // add: (S + A) & 0xfff
+} Aarch64SymbolRefKind;
+
+typedef struct {
+    size_t position;        // Komutun konumu (P)
+    int64_t addend;         // Sembol içindeki konum (A)
+    uint8_t symbol;         // Numarayı kod üretici belirler (0 kullanılmaz)
+    uint8_t kind;           // Aarch64SymbolRefKind
+} Aarch64SymbolRef;
+
+// --- Kod Tamponu ---
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int failed;             // Bellek hatası oluştuysa 1
+    Aarch64SymbolRef* symbol_refs;
+    size_t num_symbol_refs;
+    size_t symbol_ref_capacity;
+} Aarch64Buffer;
+
+// --- Fonksiyon Prototipleri: Tampon ---
+
+/**
+ * @brief Tampona bir komut sözcüğü ekler.
+ */
+void aarch64_emit(Aarch64Buffer* buffer, uint32_t word);
+
+/**
+ * @brief Tamponun kod ve sembol başvurusu dizilerini serbest bırakır.
+ */
+void aarch64_buffer_free(Aarch64Buffer* buffer);
+
+/**
+ * @brief 'position' konumundaki dalın (B, BL, B.cond, CBZ, CBNZ) hedefini 'target' yapar.
+ * @return Uzaklık komutun menziline sığıyorsa 1 (B/BL: ±128 MB, diğerleri: ±1 MB), aksi takdirde 0.
+ */
+int aarch64_patch_branch(Aarch64Buffer* buffer, size_t position, size_t target);
+
+/**
+ * @brief Bir sembolün içindeki 'offset' konumunun adresini adrp + add ile kaydediciye yükler.
+ */
+void aarch64_adr_symbol(Aarch64Buffer* buffer, Aarch64Register rd, uint8_t symbol, int64_t offset);
+
+/**
+ * @brief Sayfa alanı sıfır bir adrp yazar (alanı çağıran yeniden konumlandırmayla doldurtur).
+ */
+void aarch64_adrp(Aarch64Buffer* buffer, Aarch64Register rd);
+
+// --- Fonksiyon Prototipleri: Komutlar (64 bit) ---
+
+/**
+ * @brief Sabiti bayrakları değiştirmeden kaydediciye yükler: movz veya movn ile başlayıp sıfır
+ * (movn için 0xffff) olmayan her 16 bitlik parça için bir movk ekler (1-4 komut).
+ */
+void aarch64_mov_imm(Aarch64Buffer* buffer, Aarch64Register rd, int64_t imm);
+void aarch64_movz(Aarch64Buffer* buffer, Aarch64Register rd, uint16_t imm, int shift);  // shift: 0, 16, 32, 48
+void aarch64_movn(Aarch64Buffer* buffer, Aarch64Register rd, uint16_t imm, int shift);
+void aarch64_movk(Aarch64Buffer* buffer, Aarch64Register rd, uint16_t imm, int shift);
+void aarch64_mov(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rm);       // orr rd, xzr, rm
+void aarch64_mov_sp(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn);    // add rd, rn, #0 (SP dahil)
+
+// Sabitli ADD/SUB: imm12 0..4095, lsl12 ise sabit 12 bit sola kaydırılır. rd/rn 31 ise SP'dir;
+// bayrak kuran biçimlerde (adds/subs, cmp/cmn) rd 31 XZR'dir.
+void aarch64_add_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12);
+void aarch64_sub_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12);
+void aarch64_adds_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12);
+void aarch64_subs_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t imm12, int lsl12);
+void aarch64_cmp_imm(Aarch64Buffer* buffer, Aarch64Register rn, uint32_t imm12);       // subs xzr, rn, #imm
+void aarch64_cmn_imm(Aarch64Buffer* buffer, Aarch64Register rn, uint32_t imm12);       // adds xzr, rn, #imm
+
+// Kaydedicili ADD/SUB (31 XZR'dir)
+void aarch64_add(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_sub(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_adds(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_subs(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_cmp(Aarch64Buffer* buffer, Aarch64Register rn, Aarch64Register rm);       // subs xzr, rn, rm
+void aarch64_neg(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rm);       // sub rd, xzr, rm
+void aarch64_add_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                     uint32_t shift); // add rd, rn, rm, lsl #shift
+void aarch64_sub_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                     uint32_t shift); // sub rd, rn, rm, lsl #shift
+void aarch64_adds_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                      uint32_t shift); // adds rd, rn, rm, lsl #shift
+void aarch64_subs_lsl(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                      uint32_t shift); // subs rd, rn, rm, lsl #shift
+void aarch64_lsl_imm(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, uint32_t shift); // ubfm
+
+void aarch64_madd(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                  Aarch64Register ra); // rd = ra + rn * rm
+void aarch64_msub(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                  Aarch64Register ra); // rd = ra - rn * rm
+void aarch64_mul(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_sdiv(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_udiv(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm);
+void aarch64_csel(Aarch64Buffer* buffer, Aarch64Register rd, Aarch64Register rn, Aarch64Register rm,
+                  Aarch64Condition cond); // rd = cond ? rn : rm
+
+// Yükleme/saklama. offset 8'in katı ve 0..32760 olmalı (strb: 0..4095); index biçimleri
+// [rn, rm, lsl #3] (ldr) ve [rn, rm, lsl #2] (ldrsw), pre/post biçimleri -256..255 alır.
+void aarch64_ldr(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, uint32_t offset);
+void aarch64_str(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, uint32_t offset);
+void aarch64_ldr_index(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, Aarch64Register rm);
+void aarch64_ldrsw_index(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, Aarch64Register rm);
+void aarch64_str_pre(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, int32_t offset);  // str rt, [rn, #o]!
+void aarch64_ldr_post(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, int32_t offset); // ldr rt, [rn], #o
+void aarch64_strb(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, uint32_t offset);
+void aarch64_strb_pre(Aarch64Buffer* buffer, Aarch64Register rt, Aarch64Register rn, int32_t offset);
+
+// Dallar: hedefi sonradan yazılacak komutların konumunu döndürür (bkz. aarch64_patch_branch)
+size_t aarch64_b(Aarch64Buffer* buffer);
+size_t aarch64_bl(Aarch64Buffer* buffer);
+size_t aarch64_b_cond(Aarch64Buffer* buffer, Aarch64Condition cond);
+size_t aarch64_cbz(Aarch64Buffer* buffer, Aarch64Register rt);
+size_t aarch64_cbnz(Aarch64Buffer* buffer, Aarch64Register rt);
+void aarch64_br(Aarch64Buffer* buffer, Aarch64Register rn);
+void aarch64_ret(Aarch64Buffer* buffer); // ret x30
+void aarch64_svc(Aarch64Buffer* buffer, uint16_t imm);
+
+#endif // AARCH64_ENCODER_H
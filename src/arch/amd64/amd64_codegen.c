@@ -0,0 +1,1366 @@
+#include "arch/amd64/amd64_codegen.h"
+#include "jit.h"    // JitContext alan uzaklıkları, JitExitReason
+#include "isel.h"   // Ağaç örüntülü komut seçimi
+#include "profile_format.h" // BSM_PROFILE_DEFAULT_PATH
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // fprintf
+#include <string.h> // memset
+#include <stddef.h> // offsetof
+
+#define AMD64_CONTEXT AMD64_R15
+#define AMD64_NUM_ALLOCATABLE 11
+#define AMD64_NUM_NATIVE_ALLOCATABLE 13
+
+// Bessambly kaydedicilerine atanabilen makine kaydedicileri (tercih sırasıyla)
+static const Amd64Register amd64_allocatable[AMD64_NUM_ALLOCATABLE] = {
+    AMD64_RBX, AMD64_R12, AMD64_R13, AMD64_R14, AMD64_RBP, AMD64_RSI,
+    AMD64_RDI, AMD64_R8,  AMD64_R9,  AMD64_R10, AMD64_RCX,
+};
+
+// Nesne dosyasında bağlam kaydedicisi yoktur; sistem çağrısının bozmadığı kaydediciler önce gelir
+static const Amd64Register amd64_native_allocatable[AMD64_NUM_NATIVE_ALLOCATABLE] = {
+    AMD64_RBX, AMD64_R12, AMD64_R13, AMD64_R14, AMD64_R15, AMD64_RBP, AMD64_R8,
+    AMD64_R9,  AMD64_R10, AMD64_RSI, AMD64_RDI, AMD64_RDX, AMD64_RCX,
+};
+
+// Linux x86-64 sistem çağrısı argüman kaydedicileri
+static const Amd64Register amd64_linux_syscall_args[AMD64_LINUX_MAX_SYSCALL_ARGS] = {
+    AMD64_RDI, AMD64_RSI, AMD64_RDX, AMD64_R10, AMD64_R8, AMD64_R9,
+};
+
+// System V'de çağıranın koruması gereken kaydediciler (C çalışma zamanı ve print yordamı bozar)
+#define AMD64_CALLER_SAVED_MASK                                                                          \
+    ((1u << AMD64_RAX) | (1u << AMD64_RCX) | (1u << AMD64_RDX) | (1u << AMD64_RSI) | (1u << AMD64_RDI) | \
+     (1u << AMD64_R8) | (1u << AMD64_R9) | (1u << AMD64_R10) | (1u << AMD64_R11))
+
+#define AMD64_LINUX_SYS_WRITE 1
+#define AMD64_LINUX_SYS_EXIT 60
+#define AMD64_LINUX_SYS_EXIT_GROUP 231
+
+// Girişte saklanan (System V'de çağrılanın koruması gereken) kaydediciler
+static const Amd64Register amd64_callee_saved[6] = {
+    AMD64_RBX, AMD64_RBP, AMD64_R12, AMD64_R13, AMD64_R14, AMD64_R15,
+};
+
+// flags_read bitleri: bir bayrak değerini okuyan koşul türleri
+#define AMD64_FLAGS_READ_EQUALITY 0x1 // EQ/NE: sadece sıfır bayrağı
+#define AMD64_FLAGS_READ_ORDER 0x2    // LT/GT/LE/GE: işaret ve taşma bayrakları da
+
+// Koşul indeksleri IrCondition sırasıyladır (EQ, NE, LT, GT, LE, GE)
+static const Amd64Condition amd64_conditions[] = {AMD64_CC_E, AMD64_CC_NE, AMD64_CC_L,
+                                                  AMD64_CC_G, AMD64_CC_LE, AMD64_CC_GE};
+static const IrCondition amd64_inverse_condition[] = {IR_COND_NE, IR_COND_EQ, IR_COND_GE,
+                                                      IR_COND_LE, IR_COND_GT, IR_COND_LT};
+
+#define AMD64_CONTEXT_FIELD(field) amd64_mem(AMD64_CONTEXT, (int32_t)offsetof(JitContext, field))
+
+// --- Nesne Dosyasının Çalışma Zamanı Durumu (.bss) ---
+typedef struct {
+    int64_t registers[IR_NUM_REGISTERS]; // Makine kaydedicisi almayanlar; diğerleri çağrılarda saklanır
+    uint64_t stack_limit;               // CALL bu adresin altına inemez (JIT_MAX_CALL_DEPTH)
+    uint64_t* counters;                 // PROFCNT sayaçları (__bsm_prof_thread_init)
+    int64_t print_args[AMD64_MAX_PRINT_ARGS];
+} Amd64NativeState;
+
+// Sembol göreli operandların numaraları (bkz. amd64_symbol)
+enum { AMD64_SYMBOL_STATE = 1, AMD64_SYMBOL_RODATA = 2 };
+
+#define AMD64_STATE_SYMBOL "__bsm_state"
+#define AMD64_RODATA_SYMBOL "__bsm_rodata"
+#define AMD64_ENTRY_SYMBOL "_start"
+#define AMD64_INSTRUMENTED_ENTRY_SYMBOL "main" // C kütüphanesiyle bağlanır (çalışma zamanı atexit kullanır)
+#define AMD64_STATE_FIELD(field) amd64_symbol(AMD64_SYMBOL_STATE, (int32_t)offsetof(Amd64NativeState, field))
+
+// --- Üretici Durumu ---
+
+typedef struct {
+    size_t position;        // rel8 veya rel32 alanının konumu
+    uint32_t block;         // Hedef blok
+    int is_short;           // 1 ise rel8 (jmp/jcc kısa biçimi)
+} Amd64Fixup;
+
+typedef struct {
+    size_t position;        // Hata dalının rel32 alanı
+    int32_t reason;         // JitExitReason
+    int32_t line;
+} Amd64ColdStub;
+
+typedef struct {
+    size_t position;        // Tablo adresini yükleyen lea'nın rel32 alanı
+    uint32_t table;         // IrJumpTable indeksi
+} Amd64TableRef;
+
+typedef struct {
+    size_t position;        // call'un rel32 alanı
+    const char* symbol;     // Çalışma zamanı fonksiyonu; NULL ise koddaki print yordamı
+} Amd64RuntimeCall;
+
+typedef struct {
+    const IrFunction* fn;
+    Amd64Buffer* out;
+    Amd64Operand locations[IR_NUM_REGISTERS]; // Bessambly kaydedicilerinin yeri
+    uint8_t* flags_read;        // Sanal kaydedici başına: bayrak değerini okuyan koşullar (AMD64_FLAGS_READ_*)
+    IselMatcher matcher;        // amd64_patterns'ın derlenmiş hali
+    IselSelection selection;    // Komut başına seçilen kalıplar (geçişler boyunca sabit)
+    size_t* block_offsets;
+    Amd64Fixup* fixups;
+    size_t num_fixups;
+    size_t fixup_capacity;
+    uint8_t* relaxed;           // Düzeltme sırası başına: 1 ise dal rel32 biçiminde yazılır
+    size_t relaxed_capacity;
+    Amd64ColdStub* stubs;
+    size_t num_stubs;
+    size_t stub_capacity;
+    Amd64TableRef* tables;
+    size_t num_tables;
+    size_t table_capacity;
+    uint32_t* call_returns;     // CALL dönüş konumları (yerleşim sırasıyla)
+    size_t num_calls;
+    size_t call_capacity;
+    size_t leave;               // Çıkış kodunun konumu
+    size_t osr_entry;
+    int out_of_memory;
+
+    // Nesne dosyası çıktısı (süreç içi yürütmede obj NULL'dır)
+    ObjectFile* obj;
+    int rodata;                 // .rodata bölümü (mesajlar; atlama tabloları sonradan eklenir)
+    int instrumented;           // Program PROFCNT/PROFDUMP içeriyorsa 1
+    uint64_t profile_checksum;
+    uint64_t num_counters;
+    uint64_t profile_path;      // Yolun .rodata'daki konumu
+    Amd64RuntimeCall* runtime_calls;
+    size_t num_runtime_calls;
+    size_t runtime_call_capacity;
+} Amd64Codegen;
+
+static int amd64_grow(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (!grown) return 0;
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+static void amd64_add_fixup(Amd64Codegen* cg, size_t position, uint32_t block, int is_short) {
+    if (!amd64_grow((void**)&cg->fixups, &cg->fixup_capacity, cg->num_fixups + 1, sizeof(Amd64Fixup))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->fixups[cg->num_fixups].position = position;
+    cg->fixups[cg->num_fixups].block = block;
+    cg->fixups[cg->num_fixups].is_short = is_short;
+    cg->num_fixups++;
+}
+
+/**
+ * @brief Düzeltmeyi sonraki geçişlerde uzun (rel32) biçimde yazılacak olarak işaretler.
+ */
+static void amd64_relax(Amd64Codegen* cg, size_t fixup) {
+    size_t old_capacity = cg->relaxed_capacity;
+    if (!amd64_grow((void**)&cg->relaxed, &cg->relaxed_capacity, fixup + 1, 1)) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    memset(cg->relaxed + old_capacity, 0, cg->relaxed_capacity - old_capacity);
+    cg->relaxed[fixup] = 1;
+}
+
+/**
+ * @brief Sıradaki blok dalının kısa (rel8) biçimde yazılıp yazılamayacağı. Önceki geçişlerde
+ * erişimi yetmeyen dallar uzun kalır; hedefi önceden yerleştirilmiş geri dallarda uzaklık
+ * zaten bellidir.
+ */
+static int amd64_branch_is_short(Amd64Codegen* cg, uint32_t block, size_t short_size) {
+    if (cg->num_fixups < cg->relaxed_capacity && cg->relaxed[cg->num_fixups]) return 0;
+    size_t target = cg->block_offsets[block];
+    if (target == SIZE_MAX) return 1;
+    return (int64_t)target - (int64_t)(cg->out->size + short_size) >= INT8_MIN;
+}
+
+/**
+ * @brief Bloğa koşulsuz atlama (jmp rel8 veya rel32).
+ */
+static void amd64_emit_jump(Amd64Codegen* cg, uint32_t block) {
+    if (amd64_branch_is_short(cg, block, 2)) {
+        amd64_add_fixup(cg, amd64_jmp8(cg->out), block, 1);
+    } else {
+        amd64_add_fixup(cg, amd64_jmp(cg->out), block, 0);
+    }
+}
+
+/**
+ * @brief Bloğa koşullu dal (jcc rel8 veya rel32).
+ */
+static void amd64_emit_branch(Amd64Codegen* cg, Amd64Condition cc, uint32_t block) {
+    if (amd64_branch_is_short(cg, block, 2)) {
+        amd64_add_fixup(cg, amd64_jcc8(cg->out, cc), block, 1);
+    } else {
+        amd64_add_fixup(cg, amd64_jcc(cg->out, cc), block, 0);
+    }
+}
+
+static void amd64_add_stub(Amd64Codegen* cg, size_t position, JitExitReason reason, int32_t line) {
+    if (!amd64_grow((void**)&cg->stubs, &cg->stub_capacity, cg->num_stubs + 1, sizeof(Amd64ColdStub))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->stubs[cg->num_stubs].position = position;
+    cg->stubs[cg->num_stubs].reason = reason;
+    cg->stubs[cg->num_stubs].line = line;
+    cg->num_stubs++;
+}
+
+static void amd64_add_table_ref(Amd64Codegen* cg, size_t position, uint32_t table) {
+    if (!amd64_grow((void**)&cg->tables, &cg->table_capacity, cg->num_tables + 1, sizeof(Amd64TableRef))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->tables[cg->num_tables].position = position;
+    cg->tables[cg->num_tables].table = table;
+    cg->num_tables++;
+}
+
+static void amd64_add_runtime_call(Amd64Codegen* cg, size_t position, const char* symbol) {
+    if (!amd64_grow((void**)&cg->runtime_calls, &cg->runtime_call_capacity, cg->num_runtime_calls + 1,
+                    sizeof(Amd64RuntimeCall))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->runtime_calls[cg->num_runtime_calls].position = position;
+    cg->runtime_calls[cg->num_runtime_calls].symbol = symbol;
+    cg->num_runtime_calls++;
+}
+
+static void amd64_add_call_return(Amd64Codegen* cg, size_t position) {
+    if (!amd64_grow((void**)&cg->call_returns, &cg->call_capacity, cg->num_calls + 1, sizeof(uint32_t))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->call_returns[cg->num_calls++] = (uint32_t)position;
+}
+
+// --- Kaydedici Yerleri ---
+
+/**
+ * @brief En sık kullanılan Bessambly kaydedicilerine makine kaydedicisi atar; diğerleri
+ * bağlamdaki (nesne dosyasında .bss'teki) registers dizisinde kalır.
+ */
+static void amd64_assign_registers(Amd64Codegen* cg) {
+    const IrFunction* fn = cg->fn;
+    uint64_t uses[IR_NUM_REGISTERS] = {0};
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        uint16_t vregs[5];
+        size_t count = ir_instr_uses(&fn->instrs[i], vregs);
+        count += ir_instr_defs(&fn->instrs[i], vregs + count);
+        for (size_t k = 0; k < count; k++) {
+            int origin = vregs[k] < fn->num_vregs ? fn->vregs[vregs[k]].origin : -1;
+            if (origin >= 0 && origin < IR_NUM_REGISTERS) uses[origin]++;
+        }
+    }
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        cg->locations[r] = cg->obj ? AMD64_STATE_FIELD(registers[r]) : AMD64_CONTEXT_FIELD(registers[r]);
+    }
+    const Amd64Register* allocatable = cg->obj ? amd64_native_allocatable : amd64_allocatable;
+    int num_allocatable = cg->obj ? AMD64_NUM_NATIVE_ALLOCATABLE : AMD64_NUM_ALLOCATABLE;
+    for (int slot = 0; slot < num_allocatable; slot++) {
+        int best = -1;
+        for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+            if (cg->locations[r].is_memory && uses[r] > 0 && (best < 0 || uses[r] > uses[best])) best = r;
+        }
+        if (best < 0) break;
+        cg->locations[best] = amd64_reg(allocatable[slot]);
+    }
+}
+
+/**
+ * @brief Verilen makine kaydedicisini tutan Bessambly kaydedicisini döndürür (yoksa -1).
+ */
+static int amd64_register_owner(const Amd64Codegen* cg, Amd64Register reg) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (!cg->locations[r].is_memory && cg->locations[r].reg == reg) return r;
+    }
+    return -1;
+}
+
+/**
+ * @brief Makine kaydedicisi 'mask' içinde olan Bessambly kaydedicilerini .bss'teki yerlerine yazar
+ * (load = 0) veya oradan geri okur (load = 1). Nesne dosyasında çağrıların etrafında kullanılır.
+ */
+static void amd64_sync_registers(Amd64Codegen* cg, uint32_t mask, int load) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        Amd64Operand location = cg->locations[r];
+        if (location.is_memory || !(mask & (1u << location.reg))) continue;
+        if (load) {
+            amd64_mov(cg->out, location, AMD64_STATE_FIELD(registers[r]));
+        } else {
+            amd64_mov(cg->out, AMD64_STATE_FIELD(registers[r]), location);
+        }
+    }
+}
+
+static void amd64_store_registers(Amd64Codegen* cg) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (!cg->locations[r].is_memory) amd64_mov(cg->out, AMD64_CONTEXT_FIELD(registers[r]), cg->locations[r]);
+    }
+}
+
+static void amd64_load_registers(Amd64Codegen* cg) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (!cg->locations[r].is_memory) amd64_mov(cg->out, cg->locations[r], AMD64_CONTEXT_FIELD(registers[r]));
+    }
+}
+
+/**
+ * @brief Sanal kaydedicinin yerini döndürür (kökeni olan mimari kaydedicinin yeri).
+ * @return Başarılıysa 1; kökeni yoksa 0 (stderr'e açıklama yazılır).
+ */
+static int amd64_location(Amd64Codegen* cg, uint16_t vreg, Amd64Operand* location) {
+    int origin = vreg < cg->fn->num_vregs ? cg->fn->vregs[vreg].origin : -1;
+    if (origin < 0 || origin >= IR_NUM_REGISTERS) {
+        fprintf(stderr, "Hata: amd64 kod üretimi: v%u bir mimari kaydediciye eşlenemiyor.\n", vreg);
+        return 0;
+    }
+    *location = cg->locations[origin];
+    return 1;
+}
+
+static int amd64_same_location(Amd64Operand a, Amd64Operand b) {
+    return a.is_memory == b.is_memory && (a.is_memory ? a.disp == b.disp : a.reg == b.reg);
+}
+
+static int amd64_fits_int32(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+static void amd64_move(Amd64Codegen* cg, Amd64Operand dst, Amd64Operand src) {
+    if (amd64_same_location(dst, src)) return;
+    if (dst.is_memory && src.is_memory) {
+        amd64_mov(cg->out, amd64_reg(AMD64_RAX), src);
+        src = amd64_reg(AMD64_RAX);
+    }
+    amd64_mov(cg->out, dst, src);
+}
+
+// Sabit yükleme bayrakları değiştirmez (xor kullanılmaz): MOV ve SELcc bayrakları korur
+static void amd64_move_immediate(Amd64Codegen* cg, Amd64Operand dst, int64_t imm) {
+    if (!dst.is_memory) {
+        amd64_mov_imm(cg->out, (Amd64Register)dst.reg, imm);
+    } else if (amd64_fits_int32(imm)) {
+        amd64_mov_imm32(cg->out, dst, (int32_t)imm);
+    } else {
+        amd64_mov_imm(cg->out, AMD64_R11, imm);
+        amd64_mov(cg->out, dst, amd64_reg(AMD64_R11));
+    }
+}
+
+/**
+ * @brief "b" kaynağını hazırlar: kaydedici yeri veya 32 bite sığan bir sabit
+ * (*is_immediate = 1). Sığmayan sabitler R11'e yüklenir.
+ */
+static int amd64_second_source(Amd64Codegen* cg, const IrInstr* instr, Amd64Operand* source, int* is_immediate,
+                               int32_t* imm) {
+    *is_immediate = 0;
+    if (!(instr->attrs & IR_ATTR_IMM)) return amd64_location(cg, instr->u.op.src2, source);
+    int64_t value = ir_instr_immediate(cg->fn, instr);
+    if (amd64_fits_int32(value)) {
+        *is_immediate = 1;
+        *imm = (int32_t)value;
+        return 1;
+    }
+    amd64_mov_imm(cg->out, AMD64_R11, value);
+    *source = amd64_reg(AMD64_R11);
+    return 1;
+}
+
+/**
+ * @brief 2 adresli işlemler için hedefin yerini döndürür (hedef ve ilk kaynak aynı kaydedici olmalı).
+ */
+static int amd64_two_address_destination(Amd64Codegen* cg, const IrInstr* instr, Amd64Operand* dst) {
+    Amd64Operand first;
+    if (!amd64_location(cg, instr->dst, dst) || !amd64_location(cg, instr->u.op.src1, &first)) return 0;
+    if (!amd64_same_location(*dst, first)) {
+        fprintf(stderr, "Hata: amd64 kod üretimi: '%s' 2 adresli biçime eşlenemiyor (v%u <- v%u).\n",
+                ir_opcode_to_string((IrOpcode)instr->opcode), instr->dst, instr->u.op.src1);
+        return 0;
+    }
+    return 1;
+}
+
+// --- Komut Seçim Kalıpları (bkz. isel.h) ---
+enum {
+    AMD64_RULE_DEFAULT = ISEL_RULE_DEFAULT,
+    AMD64_RULE_LEA,         // a + b, a +/- sabit -> lea rd, [a + b] / [a + sabit] (MOV katılır)
+    AMD64_RULE_LEA_INDEX,   // a + b * 1/2/4/8 -> lea rd, [a + b * ölçek]
+    AMD64_RULE_SCALE,       // x * 2/3/5/9 -> lea rd, [x + x * (k - 1)]
+    AMD64_RULE_SHIFT,       // x * 2^k -> shl rd, k
+    AMD64_RULE_MULTIPLY,    // MOV + MUL sabit -> imul rd, x, sabit
+};
+
+static int amd64_in_register(const Amd64Codegen* cg, uint16_t vreg) {
+    int origin = vreg < cg->fn->num_vregs ? cg->fn->vregs[vreg].origin : -1;
+    return origin >= 0 && origin < IR_NUM_REGISTERS && !cg->locations[origin].is_memory;
+}
+
+static int amd64_is_power_of_two(int64_t value) { return value > 0 && (value & (value - 1)) == 0; }
+
+static uint8_t amd64_log2(int64_t value) {
+    uint8_t shift = 0;
+    while (((uint64_t)1 << shift) < (uint64_t)value) shift++;
+    return shift;
+}
+
+// lea'nın hedefi ve adres kaydedicileri makine kaydedicisi olmalı; sabit 32 bitlik uzaklığa sığmalı
+static int amd64_lea_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    const Amd64Codegen* cg = (const Amd64Codegen*)target;
+    if (!amd64_in_register(cg, root->dst) || !amd64_in_register(cg, leaves[0].vreg)) return 0;
+    if (!leaves[1].is_immediate) return amd64_in_register(cg, leaves[1].vreg);
+    int64_t value = root->opcode == IR_OP_SUB ? (int64_t)(0 - (uint64_t)leaves[1].imm) : leaves[1].imm;
+    return leaves[1].imm != INT64_MIN && amd64_fits_int32(value);
+}
+
+static int amd64_lea_index_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    const Amd64Codegen* cg = (const Amd64Codegen*)target;
+    int64_t scale = leaves[2].imm;
+    return amd64_in_register(cg, root->dst) && amd64_in_register(cg, leaves[0].vreg) &&
+           amd64_in_register(cg, leaves[1].vreg) && (scale == 1 || scale == 2 || scale == 4 || scale == 8);
+}
+
+static int amd64_scale_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    const Amd64Codegen* cg = (const Amd64Codegen*)target;
+    int64_t factor = leaves[1].imm;
+    return amd64_in_register(cg, root->dst) && amd64_in_register(cg, leaves[0].vreg) &&
+           (factor == 2 || factor == 3 || factor == 5 || factor == 9);
+}
+
+static int amd64_shift_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    (void)target;
+    (void)root;
+    return amd64_is_power_of_two(leaves[1].imm);
+}
+
+static int amd64_multiply_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    return amd64_in_register((const Amd64Codegen*)target, root->dst) && amd64_fits_int32(leaves[1].imm);
+}
+
+// Maliyet: komut sayısı; imul gecikmesi için 3
+static const IselPattern amd64_patterns[] = {
+    {AMD64_RULE_DEFAULT, "MOV(reg)", 1, NULL},
+    {AMD64_RULE_DEFAULT, "MOV(imm)", 1, NULL},
+    {AMD64_RULE_DEFAULT, "ADD(reg, reg)", 1, NULL},
+    {AMD64_RULE_DEFAULT, "ADD(reg, imm)", 1, NULL},
+    {AMD64_RULE_DEFAULT, "SUB(reg, reg)", 1, NULL},
+    {AMD64_RULE_DEFAULT, "SUB(reg, imm)", 1, NULL},
+    {AMD64_RULE_DEFAULT, "MUL(reg, reg)", 3, NULL},
+    {AMD64_RULE_DEFAULT, "MUL(reg, imm)", 3, NULL},
+    {AMD64_RULE_LEA, "ADD(MOV(reg), reg)", 1, amd64_lea_applies},
+    {AMD64_RULE_LEA, "ADD(MOV(reg), imm)", 1, amd64_lea_applies},
+    {AMD64_RULE_LEA, "SUB(MOV(reg), imm)", 1, amd64_lea_applies},
+    {AMD64_RULE_LEA_INDEX, "ADD(reg, MUL(reg, imm))", 1, amd64_lea_index_applies},
+    {AMD64_RULE_LEA_INDEX, "ADD(reg, MUL(MOV(reg), imm))", 1, amd64_lea_index_applies},
+    {AMD64_RULE_LEA_INDEX, "ADD(MOV(reg), MUL(reg, imm))", 1, amd64_lea_index_applies},
+    {AMD64_RULE_LEA_INDEX, "ADD(MOV(reg), MUL(MOV(reg), imm))", 1, amd64_lea_index_applies},
+    {AMD64_RULE_SCALE, "MUL(reg, imm)", 1, amd64_scale_applies},
+    {AMD64_RULE_SCALE, "MUL(MOV(reg), imm)", 1, amd64_scale_applies},
+    {AMD64_RULE_SHIFT, "MUL(reg, imm)", 1, amd64_shift_applies},
+    {AMD64_RULE_SHIFT, "MUL(MOV(reg), imm)", 2, amd64_shift_applies},
+    {AMD64_RULE_MULTIPLY, "MUL(MOV(reg), imm)", 3, amd64_multiply_applies},
+};
+
+/**
+ * @brief Komut için seçilen kuralı döndürür; varsayılan çeviri dışındaki kurallar için yaprakları bağlar.
+ */
+static int amd64_selected_rule(Amd64Codegen* cg, const IrInstr* instr, IselOperand* leaves) {
+    size_t index = (size_t)(instr - cg->fn->instrs);
+    int rule = isel_rule(&cg->selection, index);
+    if (rule != AMD64_RULE_DEFAULT && isel_leaves(&cg->selection, index, leaves) == 0) return AMD64_RULE_DEFAULT;
+    return rule;
+}
+
+/**
+ * @brief ADD/SUB kalıplarını lea ile yazar: a + b, a +/- sabit veya a + b * ölçek (bayraklar değişmez).
+ */
+static int amd64_emit_lea(Amd64Codegen* cg, const IrInstr* instr, int rule, const IselOperand* leaves,
+                          Amd64Operand* dst) {
+    Amd64Operand base, index;
+    if (!amd64_location(cg, instr->dst, dst) || !amd64_location(cg, leaves[0].vreg, &base)) return 0;
+    Amd64Operand address;
+    if (rule == AMD64_RULE_LEA_INDEX) {
+        if (!amd64_location(cg, leaves[1].vreg, &index)) return 0;
+        address = amd64_mem_index((Amd64Register)base.reg, (Amd64Register)index.reg, (uint8_t)leaves[2].imm, 0);
+    } else if (leaves[1].is_immediate) {
+        int64_t value = instr->opcode == IR_OP_SUB ? (int64_t)(0 - (uint64_t)leaves[1].imm) : leaves[1].imm;
+        address = amd64_mem((Amd64Register)base.reg, (int32_t)value);
+    } else {
+        if (!amd64_location(cg, leaves[1].vreg, &index)) return 0;
+        address = amd64_mem_index((Amd64Register)base.reg, (Amd64Register)index.reg, 1, 0);
+    }
+    amd64_lea(cg->out, (Amd64Register)dst->reg, address);
+    return 1;
+}
+
+/**
+ * @brief MUL kalıpları: lea ile 2/3/5/9 katı, sola kaydırma veya 3 işlenenli imul.
+ */
+static int amd64_emit_multiply(Amd64Codegen* cg, const IrInstr* instr, int rule, const IselOperand* leaves) {
+    Amd64Operand dst, source;
+    if (!amd64_location(cg, instr->dst, &dst) || !amd64_location(cg, leaves[0].vreg, &source)) return 0;
+    int64_t factor = leaves[1].imm;
+    switch (rule) {
+        case AMD64_RULE_SCALE:
+            amd64_lea(cg->out, (Amd64Register)dst.reg,
+                      amd64_mem_index((Amd64Register)source.reg, (Amd64Register)source.reg, (uint8_t)(factor - 1), 0));
+            return 1;
+        case AMD64_RULE_SHIFT:
+            amd64_move(cg, dst, source);
+            amd64_shl_imm(cg->out, dst, amd64_log2(factor));
+            return 1;
+        default: // AMD64_RULE_MULTIPLY
+            amd64_imul_imm(cg->out, (Amd64Register)dst.reg, source, (int32_t)factor);
+            return 1;
+    }
+}
+
+// --- Komutlar ---
+
+/**
+ * @brief Sistem çağrısı veya PROFDUMP: kaydediciler bağlama yazılır, yığın hizalanarak konak
+ * trampolini çağrılır, kaydediciler geri okunur; trampolin sıfırdan farklı dönerse çıkılır.
+ */
+static void amd64_emit_host_call(Amd64Codegen* cg, uint32_t site) {
+    Amd64Buffer* out = cg->out;
+    amd64_store_registers(cg);
+    amd64_mov(out, amd64_reg(AMD64_RDI), amd64_reg(AMD64_CONTEXT));
+    amd64_mov_imm(out, AMD64_RSI, site);
+    // Çağrı derinliğine göre yığın 16'ya hizalı olmayabilir; eski değer hizalı yığına saklanır
+    amd64_mov(out, amd64_reg(AMD64_RAX), amd64_reg(AMD64_RSP));
+    amd64_alu_imm(out, AMD64_ALU_AND, amd64_reg(AMD64_RSP), -16);
+    amd64_push(out, AMD64_RAX);
+    amd64_push(out, AMD64_RAX);
+    amd64_call_indirect(out, AMD64_CONTEXT_FIELD(host_call));
+    amd64_pop(out, AMD64_RSP);
+    amd64_load_registers(cg);
+    amd64_test32(out, AMD64_RAX, AMD64_RAX);
+    amd64_patch_rel32(out, amd64_jcc(out, AMD64_CC_NE), cg->leave);
+}
+
+/**
+ * @brief Nesne dosyası: C çalışma zamanı fonksiyonunu çağırır. Çağıranın koruması gereken
+ * kaydediciler .bss'e yazılır ve yığın System V için 16'ya hizalanır.
+ */
+static void amd64_emit_runtime_call(Amd64Codegen* cg, const char* symbol) {
+    Amd64Buffer* out = cg->out;
+    amd64_sync_registers(cg, AMD64_CALLER_SAVED_MASK, 0);
+    amd64_mov(out, amd64_reg(AMD64_RAX), amd64_reg(AMD64_RSP));
+    amd64_alu_imm(out, AMD64_ALU_AND, amd64_reg(AMD64_RSP), -16);
+    amd64_push(out, AMD64_RAX);
+    amd64_push(out, AMD64_RAX);
+    amd64_add_runtime_call(cg, amd64_call(out), symbol);
+    amd64_pop(out, AMD64_RSP);
+    amd64_sync_registers(cg, AMD64_CALLER_SAVED_MASK, 1);
+}
+
+/**
+ * @brief Nesne dosyası: print çağrısı. Argümanlar .bss'e kopyalanır ve koddaki print yordamı
+ * (amd64_emit_print_routine) argüman sayısıyla (RDI) çağrılır.
+ */
+static int amd64_emit_print_call(Amd64Codegen* cg, const IrSyscall* syscall) {
+    Amd64Buffer* out = cg->out;
+    if (syscall->num_args > AMD64_MAX_PRINT_ARGS) {
+        fprintf(stderr, "Hata: amd64 kod üretimi: print çağrısı en fazla %d argüman alabilir.\n", AMD64_MAX_PRINT_ARGS);
+        return 0;
+    }
+    for (uint32_t a = 0; a < syscall->num_args; a++) {
+        int reg = cg->fn->pool[syscall->first_arg + a] & 0x0f;
+        amd64_move(cg, AMD64_STATE_FIELD(print_args[a]), cg->locations[reg]);
+    }
+    amd64_sync_registers(cg, AMD64_CALLER_SAVED_MASK, 0);
+    amd64_mov_imm(out, AMD64_RDI, syscall->num_args);
+    amd64_add_runtime_call(cg, amd64_call(out), NULL);
+    amd64_sync_registers(cg, AMD64_CALLER_SAVED_MASK, 1);
+    return 1;
+}
+
+/**
+ * @brief Nesne dosyası: SYSCALL'u Linux sistem çağrısı ABI'sine indirger (bkz. amd64_codegen.h).
+ * Argüman kaydedicileri üzerine yazılacağı için kaynaklar, bozulan kaydedicilerin .bss'teki
+ * kopyalarından okunur; böylece argümanların sırası önemli değildir.
+ */
+static int amd64_emit_linux_syscall(Amd64Codegen* cg, const IrInstr* instr) {
+    Amd64Buffer* out = cg->out;
+    const IrSyscall* syscall = &cg->fn->syscalls[instr->u.op.imm];
+    if (syscall->number == AMD64_HYPERCALL_PRINT) return amd64_emit_print_call(cg, syscall);
+    if (syscall->num_args > AMD64_LINUX_MAX_SYSCALL_ARGS) {
+        fprintf(stderr, "Hata: amd64 kod üretimi: Linux sistem çağrısı en fazla %d argüman alabilir "
+                        "(%lld numaralı çağrıda %u).\n",
+                AMD64_LINUX_MAX_SYSCALL_ARGS, (long long)syscall->number, syscall->num_args);
+        return 0;
+    }
+    int args[AMD64_LINUX_MAX_SYSCALL_ARGS];
+    uint32_t num_args = syscall->num_args;
+    for (uint32_t a = 0; a < num_args; a++) args[a] = cg->fn->pool[syscall->first_arg + a] & 0x0f;
+    int is_exit = syscall->number == AMD64_LINUX_SYS_EXIT || syscall->number == AMD64_LINUX_SYS_EXIT_GROUP;
+    if (is_exit && num_args == 0) {
+        args[0] = 0; // Argümansız çıkış R0'ı kullanır (BVM ile aynı)
+        num_args = 1;
+    }
+
+    uint32_t clobbered = (1u << AMD64_RAX) | (1u << AMD64_RCX) | (1u << AMD64_R11);
+    for (uint32_t a = 0; a < num_args; a++) clobbered |= 1u << amd64_linux_syscall_args[a];
+    amd64_sync_registers(cg, clobbered, 0);
+    for (uint32_t a = 0; a < num_args; a++) {
+        Amd64Operand source = cg->locations[args[a]];
+        if (!source.is_memory && (clobbered & (1u << source.reg))) source = AMD64_STATE_FIELD(registers[args[a]]);
+        amd64_mov(out, amd64_reg(amd64_linux_syscall_args[a]), source);
+    }
+    amd64_mov_imm(out, AMD64_RAX, syscall->number);
+    amd64_syscall(out);
+    if (is_exit) return 1;
+    amd64_sync_registers(cg, clobbered, 1);
+    amd64_move(cg, cg->locations[0], amd64_reg(AMD64_RAX)); // Dönüş değeri R0'a
+    return 1;
+}
+
+static int amd64_emit_division(Amd64Codegen* cg, const IrInstr* instr, int32_t line) {
+    Amd64Buffer* out = cg->out;
+    Amd64Operand dst, source;
+    int is_immediate;
+    int32_t imm = 0;
+    if (!amd64_two_address_destination(cg, instr, &dst) || !amd64_second_source(cg, instr, &source, &is_immediate, &imm)) {
+        return 0;
+    }
+    if (is_immediate && imm == 0) {
+        amd64_add_stub(cg, amd64_jmp(out), JIT_EXIT_DIVIDE_BY_ZERO, line);
+        return 1;
+    }
+    if (is_immediate && imm == -1) {
+        amd64_neg(out, dst); // INT64_MIN / -1 sarmalıdır (idiv burada tuzak üretirdi)
+        return 1;
+    }
+    size_t not_minus_one = 0, done = 0;
+    if (is_immediate) {
+        amd64_mov_imm(out, AMD64_R11, imm);
+    } else {
+        if (!(source.is_memory == 0 && source.reg == AMD64_R11)) amd64_mov(out, amd64_reg(AMD64_R11), source);
+        amd64_test(out, amd64_reg(AMD64_R11), AMD64_R11);
+        amd64_add_stub(cg, amd64_jcc(out, AMD64_CC_E), JIT_EXIT_DIVIDE_BY_ZERO, line);
+        amd64_alu_imm(out, AMD64_ALU_CMP, amd64_reg(AMD64_R11), -1);
+        // Yerel dallar kısa: atladıkları komutlar birkaç bayttır
+        not_minus_one = amd64_jcc8(out, AMD64_CC_NE);
+        amd64_neg(out, dst);
+        done = amd64_jmp8(out);
+        amd64_patch_rel8(out, not_minus_one, out->size);
+    }
+    // Nesne dosyasında RDX bir Bessambly kaydedicisini tutabilir; hedef o değilse korunur
+    int save_rdx = amd64_register_owner(cg, AMD64_RDX) >= 0 && !(!dst.is_memory && dst.reg == AMD64_RDX);
+    if (save_rdx) amd64_push(out, AMD64_RDX);
+    amd64_move(cg, amd64_reg(AMD64_RAX), dst);
+    amd64_cqo(out);
+    amd64_idiv(out, amd64_reg(AMD64_R11));
+    if (save_rdx) amd64_pop(out, AMD64_RDX);
+    amd64_move(cg, dst, amd64_reg(AMD64_RAX));
+    if (!is_immediate) amd64_patch_rel8(out, done, out->size);
+    return 1;
+}
+
+static int amd64_emit_jump_table(Amd64Codegen* cg, const IrInstr* instr) {
+    Amd64Buffer* out = cg->out;
+    const IrJumpTable* table = &cg->fn->jump_tables[instr->u.op.imm];
+    Amd64Operand index;
+    if (!amd64_location(cg, instr->u.op.src1, &index)) return 0;
+    if (table->num_targets > INT32_MAX) {
+        fprintf(stderr, "Hata: amd64 kod üretimi: atlama tablosu çok büyük (%u giriş).\n", table->num_targets);
+        return 0;
+    }
+    if (table->num_targets == 0) {
+        amd64_emit_jump(cg, table->default_block);
+        return 1;
+    }
+    amd64_move(cg, amd64_reg(AMD64_RAX), index);
+    if (amd64_fits_int32(table->min)) {
+        if (table->min != 0) amd64_alu_imm(out, AMD64_ALU_SUB, amd64_reg(AMD64_RAX), (int32_t)table->min);
+    } else {
+        amd64_mov_imm(out, AMD64_R11, table->min);
+        amd64_alu(out, AMD64_ALU_SUB, amd64_reg(AMD64_RAX), amd64_reg(AMD64_R11));
+    }
+    // İşaretsiz karşılaştırma aralığın iki yanını birden denetler
+    amd64_alu_imm(out, AMD64_ALU_CMP, amd64_reg(AMD64_RAX), (int32_t)table->num_targets);
+    amd64_emit_branch(cg, AMD64_CC_AE, table->default_block);
+    amd64_lea(out, AMD64_R11, amd64_rip(0));
+    amd64_add_table_ref(cg, out->size - 4, (uint32_t)instr->u.op.imm);
+    amd64_movsxd(out, AMD64_RAX, amd64_mem_index(AMD64_R11, AMD64_RAX, 4, 0));
+    amd64_alu(out, AMD64_ALU_ADD, amd64_reg(AMD64_RAX), amd64_reg(AMD64_R11));
+    amd64_jmp_indirect(out, amd64_reg(AMD64_RAX));
+    return 1;
+}
+
+/**
+ * @brief Bir IR komutunu makine koduna çevirir.
+ * @param next Yerleşimde bir sonraki blok (yoksa IR_NO_BLOCK); ona giden atlamalar atlanır.
+ */
+static int amd64_emit_instruction(Amd64Codegen* cg, const IrInstr* instr, int32_t line, uint32_t next) {
+    Amd64Buffer* out = cg->out;
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    Amd64Operand dst, source;
+    int is_immediate;
+    int32_t imm = 0;
+    switch (opcode) {
+        case IR_OP_MOV:
+            if (!amd64_location(cg, instr->dst, &dst)) return 0;
+            if (instr->attrs & IR_ATTR_IMM) {
+                amd64_move_immediate(cg, dst, ir_instr_immediate(cg->fn, instr));
+                return 1;
+            }
+            if (!amd64_location(cg, instr->u.op.src2, &source)) return 0;
+            amd64_move(cg, dst, source);
+            return 1;
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_CMP: {
+            IselOperand leaves[ISEL_MAX_LEAVES];
+            int rule = amd64_selected_rule(cg, instr, leaves);
+            Amd64AluOp op = opcode == IR_OP_ADD ? AMD64_ALU_ADD : opcode == IR_OP_SUB ? AMD64_ALU_SUB : AMD64_ALU_CMP;
+            if (rule == AMD64_RULE_LEA || rule == AMD64_RULE_LEA_INDEX) {
+                if (!amd64_emit_lea(cg, instr, rule, leaves, &dst)) return 0;
+            } else {
+                int ok = opcode == IR_OP_CMP ? amd64_location(cg, instr->u.op.src1, &dst)
+                                             : amd64_two_address_destination(cg, instr, &dst);
+                if (!ok || !amd64_second_source(cg, instr, &source, &is_immediate, &imm)) return 0;
+                if (is_immediate) {
+                    amd64_alu_imm(out, op, dst, imm);
+                } else {
+                    if (dst.is_memory && source.is_memory) {
+                        amd64_mov(out, amd64_reg(AMD64_RAX), source);
+                        source = amd64_reg(AMD64_RAX);
+                    }
+                    amd64_alu(out, op, dst, source);
+                }
+            }
+            // Bayraklar (sonuç, 0) karşılaştırmasıdır. add/sub sıfır bayrağını doğru kurar ama taşma
+            // bayrağı farklıdır; lea bayrak kurmaz. Eşitlik okuyucuları için test gerekmez.
+            uint8_t readers = opcode != IR_OP_CMP && instr->flags != IR_NO_VREG &&
+                                      !(instr->attrs & IR_ATTR_FLAGS_CLOBBER)
+                                  ? cg->flags_read[instr->flags] : 0;
+            int lea = rule == AMD64_RULE_LEA || rule == AMD64_RULE_LEA_INDEX;
+            if ((readers & AMD64_FLAGS_READ_ORDER) || (readers && lea)) {
+                if (dst.is_memory) {
+                    amd64_alu_imm(out, AMD64_ALU_CMP, dst, 0);
+                } else {
+                    amd64_test(out, dst, (Amd64Register)dst.reg);
+                }
+            }
+            return 1;
+        }
+        case IR_OP_MUL:
+        case IR_OP_SEL: {
+            IselOperand leaves[ISEL_MAX_LEAVES];
+            int rule = amd64_selected_rule(cg, instr, leaves);
+            if (rule != AMD64_RULE_DEFAULT) return amd64_emit_multiply(cg, instr, rule, leaves);
+            if (!amd64_two_address_destination(cg, instr, &dst)) return 0;
+            // Hedef kaydedici olmalı: bellekteki kaydediciler RAX üzerinden işlenir
+            Amd64Register target = dst.is_memory ? AMD64_RAX : (Amd64Register)dst.reg;
+            if (dst.is_memory) amd64_mov(out, amd64_reg(AMD64_RAX), dst);
+            if (!amd64_second_source(cg, instr, &source, &is_immediate, &imm)) return 0;
+            if (opcode == IR_OP_MUL) {
+                if (is_immediate) {
+                    amd64_imul_imm(out, target, amd64_reg(target), imm);
+                } else {
+                    amd64_imul(out, target, source);
+                }
+            } else {
+                if (is_immediate) {
+                    amd64_mov_imm(out, AMD64_R11, imm);
+                    source = amd64_reg(AMD64_R11);
+                }
+                amd64_cmov(out, amd64_conditions[instr->cond], target, source);
+            }
+            if (dst.is_memory) amd64_mov(out, dst, amd64_reg(AMD64_RAX));
+            return 1;
+        }
+        case IR_OP_DIV:
+            return amd64_emit_division(cg, instr, line);
+        case IR_OP_CALL:
+            amd64_alu(out, AMD64_ALU_CMP, amd64_reg(AMD64_RSP),
+                      cg->obj ? AMD64_STATE_FIELD(stack_limit) : AMD64_CONTEXT_FIELD(stack_limit));
+            amd64_add_stub(cg, amd64_jcc(out, AMD64_CC_BE), JIT_EXIT_CALL_OVERFLOW, line);
+            amd64_add_fixup(cg, amd64_call(out), instr->u.br.taken, 0);
+            amd64_add_call_return(cg, out->size);
+            return 1;
+        case IR_OP_SYSCALL:
+            if (cg->obj) return amd64_emit_linux_syscall(cg, instr);
+            amd64_emit_host_call(cg, (uint32_t)instr->u.op.imm);
+            return 1;
+        case IR_OP_PROFDUMP:
+            if (cg->obj) {
+                amd64_emit_runtime_call(cg, "__bsm_prof_dump");
+            } else {
+                amd64_emit_host_call(cg, JIT_HOST_PROFILE_DUMP);
+            }
+            return 1;
+        case IR_OP_PROFCNT: {
+            int64_t counter = ir_instr_immediate(cg->fn, instr);
+            if (counter < 0 || counter > INT32_MAX / 8) {
+                fprintf(stderr, "Hata: amd64 kod üretimi: geçersiz sayaç indeksi %lld.\n", (long long)counter);
+                return 0;
+            }
+            // lea bayrakları değiştirmez; PROFCNT bayrakları korumalı
+            Amd64Operand slot = amd64_mem(AMD64_R11, (int32_t)(counter * 8));
+            amd64_mov(out, amd64_reg(AMD64_R11), cg->obj ? AMD64_STATE_FIELD(counters) : AMD64_CONTEXT_FIELD(counters));
+            amd64_mov(out, amd64_reg(AMD64_RAX), slot);
+            amd64_lea(out, AMD64_RAX, amd64_mem(AMD64_RAX, 1));
+            amd64_mov(out, slot, amd64_reg(AMD64_RAX));
+            return 1;
+        }
+        case IR_OP_JMP:
+            if (instr->u.br.taken != next) amd64_emit_jump(cg, instr->u.br.taken);
+            return 1;
+        case IR_OP_BR: {
+            IrCondition cond = (IrCondition)instr->cond;
+            uint32_t taken = instr->u.br.taken;
+            uint32_t fallthrough = instr->u.br.fallthrough;
+            if (taken == next && fallthrough != next) {
+                // Koşulu tersine çevirerek ek jmp'den kaçın
+                cond = amd64_inverse_condition[cond];
+                taken = fallthrough;
+                fallthrough = next;
+            }
+            amd64_emit_branch(cg, amd64_conditions[cond], taken);
+            if (fallthrough != next) amd64_emit_jump(cg, fallthrough);
+            return 1;
+        }
+        case IR_OP_JTAB:
+            return amd64_emit_jump_table(cg, instr);
+        case IR_OP_RET:
+            amd64_ret(out);
+            return 1;
+        case IR_OP_END:
+            // Çıkış kodu gövdeden öncedir; uzaklık bellidir
+            if ((int64_t)cg->leave - (int64_t)(out->size + 2) >= INT8_MIN) {
+                amd64_patch_rel8(out, amd64_jmp8(out), cg->leave);
+            } else {
+                amd64_patch_rel32(out, amd64_jmp(out), cg->leave);
+            }
+            return 1;
+        default:
+            fprintf(stderr, "Hata: amd64 kod üretimi: desteklenmeyen IR komutu '%s'.\n", ir_opcode_to_string(opcode));
+            return 0;
+    }
+}
+
+// --- Giriş ve Çıkış ---
+
+static void amd64_emit_entry_frame(Amd64Codegen* cg) {
+    Amd64Buffer* out = cg->out;
+    for (int i = 0; i < 6; i++) amd64_push(out, amd64_callee_saved[i]);
+    amd64_mov(out, amd64_reg(AMD64_CONTEXT), amd64_reg(AMD64_RDI));
+    amd64_mov(out, AMD64_CONTEXT_FIELD(entry_sp), amd64_reg(AMD64_RSP));
+    // Gövde girişteki call'un dönüş adresiyle başlar; her CALL 8 bayt daha iner
+    amd64_lea(out, AMD64_RAX, amd64_mem(AMD64_RSP, -8 - 8 * JIT_MAX_CALL_DEPTH));
+    amd64_mov(out, AMD64_CONTEXT_FIELD(stack_limit), amd64_reg(AMD64_RAX));
+}
+
+/**
+ * @brief OSR girişi: yığını normal girişteki gibi kurar, BVM çerçevelerinin dönüş adreslerini
+ * iter, kaydedicileri ve bayrakları yükleyip osr_target'a atlar.
+ */
+static void amd64_emit_osr_entry(Amd64Codegen* cg) {
+    Amd64Buffer* out = cg->out;
+    cg->osr_entry = out->size;
+    amd64_emit_entry_frame(cg);
+    // En dıştaki RET çıkışa döner
+    amd64_lea(out, AMD64_RAX, amd64_rip(0));
+    amd64_patch_rel32(out, out->size - 4, cg->leave);
+    amd64_push(out, AMD64_RAX);
+    amd64_mov(out, amd64_reg(AMD64_RDX), AMD64_CONTEXT_FIELD(osr_num_frames));
+    amd64_mov(out, amd64_reg(AMD64_R11), AMD64_CONTEXT_FIELD(osr_frames));
+    amd64_test(out, amd64_reg(AMD64_RDX), AMD64_RDX);
+    size_t no_frames = amd64_jcc(out, AMD64_CC_E);
+    size_t loop = out->size;
+    amd64_mov(out, amd64_reg(AMD64_RAX), amd64_mem(AMD64_R11, 0));
+    amd64_push(out, AMD64_RAX);
+    amd64_alu_imm(out, AMD64_ALU_ADD, amd64_reg(AMD64_R11), 8);
+    amd64_alu_imm(out, AMD64_ALU_SUB, amd64_reg(AMD64_RDX), 1);
+    amd64_patch_rel32(out, amd64_jcc(out, AMD64_CC_NE), loop);
+    amd64_patch_rel32(out, no_frames, out->size);
+    amd64_load_registers(cg);
+    amd64_mov(out, amd64_reg(AMD64_RAX), AMD64_CONTEXT_FIELD(osr_flags[0]));
+    amd64_alu(out, AMD64_ALU_CMP, amd64_reg(AMD64_RAX), AMD64_CONTEXT_FIELD(osr_flags[1]));
+    amd64_jmp_indirect(out, AMD64_CONTEXT_FIELD(osr_target));
+}
+
+static void amd64_emit_prologue(Amd64Codegen* cg, size_t* body_call) {
+    Amd64Buffer* out = cg->out;
+    amd64_emit_entry_frame(cg);
+    amd64_load_registers(cg);
+    *body_call = amd64_call(out);
+
+    // Çıkış: gövdeden dönüş, END, exit sistem çağrısı ve hatalar buraya gelir
+    cg->leave = out->size;
+    amd64_mov(out, amd64_reg(AMD64_RSP), AMD64_CONTEXT_FIELD(entry_sp));
+    amd64_store_registers(cg);
+    for (int i = 5; i >= 0; i--) amd64_pop(out, amd64_callee_saved[i]);
+    amd64_ret(out);
+
+    amd64_emit_osr_entry(cg);
+}
+
+/**
+ * @brief Nesne dosyası girişi (_start veya main): çağrı derinliği sınırını ve PGO çalışma zamanını
+ * kurar, makine kaydedicilerini sıfırlar ve gövdeyi çağırır. Çıkış exit_group(0)'dır.
+ */
+static void amd64_emit_native_entry(Amd64Codegen* cg, size_t* body_call) {
+    Amd64Buffer* out = cg->out;
+    // Girişe geri dönülmez; yığın C çağrıları için hizalanır (main'e hizasız girilir)
+    amd64_alu_imm(out, AMD64_ALU_AND, amd64_reg(AMD64_RSP), -16);
+    amd64_lea(out, AMD64_RAX, amd64_mem(AMD64_RSP, -8 - 8 * JIT_MAX_CALL_DEPTH));
+    amd64_mov(out, AMD64_STATE_FIELD(stack_limit), amd64_reg(AMD64_RAX));
+    if (cg->instrumented) {
+        amd64_mov_imm(out, AMD64_RDI, (int64_t)cg->profile_checksum);
+        amd64_mov_imm(out, AMD64_RSI, (int64_t)cg->num_counters);
+        amd64_lea(out, AMD64_RDX, amd64_symbol(AMD64_SYMBOL_RODATA, (int32_t)cg->profile_path));
+        amd64_add_runtime_call(cg, amd64_call(out), "__bsm_prof_init");
+        amd64_add_runtime_call(cg, amd64_call(out), "__bsm_prof_thread_init");
+        amd64_mov(out, AMD64_STATE_FIELD(counters), amd64_reg(AMD64_RAX));
+    }
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (!cg->locations[r].is_memory) amd64_mov_imm(out, (Amd64Register)cg->locations[r].reg, 0);
+    }
+    *body_call = amd64_call(out);
+
+    // Çıkış: gövdeden dönüş ve END
+    cg->leave = out->size;
+    if (cg->instrumented) amd64_emit_runtime_call(cg, "__bsm_prof_dump");
+    amd64_mov_imm(out, AMD64_RDI, 0);
+    amd64_mov_imm(out, AMD64_RAX, AMD64_LINUX_SYS_EXIT_GROUP);
+    amd64_syscall(out);
+}
+
+/**
+ * @brief Nesne dosyası: soğuk hata kodları. Her biri satır numaralı mesajını (.rodata) RSI/RDX'e
+ * yükleyip mesajı stderr'e yazan ve 1 koduyla çıkan ortak koda atlar.
+ */
+static int amd64_emit_native_stubs(Amd64Codegen* cg) {
+    Amd64Buffer* out = cg->out;
+    if (cg->num_stubs == 0) return 1;
+    size_t error_exit = out->size;
+    amd64_mov_imm(out, AMD64_RDI, 2);
+    amd64_mov_imm(out, AMD64_RAX, AMD64_LINUX_SYS_WRITE);
+    amd64_syscall(out);
+    amd64_mov_imm(out, AMD64_RDI, 1);
+    amd64_mov_imm(out, AMD64_RAX, AMD64_LINUX_SYS_EXIT_GROUP);
+    amd64_syscall(out);
+    for (size_t s = 0; s < cg->num_stubs; s++) {
+        char message[128];
+        int length;
+        if (cg->stubs[s].reason == JIT_EXIT_DIVIDE_BY_ZERO) {
+            length = snprintf(message, sizeof(message), "Hata: satır %d: sıfıra bölme.\n", cg->stubs[s].line);
+        } else {
+            length = snprintf(message, sizeof(message), "Hata: satır %d: çağrı yığını taştı (derinlik %d).\n",
+                              cg->stubs[s].line, JIT_MAX_CALL_DEPTH);
+        }
+        size_t offset = cg->obj->sections[cg->rodata].size;
+        if (!object_file_append(cg->obj, cg->rodata, message, (size_t)length)) return 0;
+        amd64_patch_rel32(out, cg->stubs[s].position, out->size);
+        amd64_lea(out, AMD64_RSI, amd64_symbol(AMD64_SYMBOL_RODATA, (int32_t)offset));
+        amd64_mov_imm(out, AMD64_RDX, length);
+        amd64_patch_rel32(out, amd64_jmp(out), error_exit);
+    }
+    return 1;
+}
+
+/**
+ * @brief Nesne dosyası: print yordamı. RDI argüman sayısıdır, argümanlar .bss'tedir. Sayılar
+ * ondalık olarak, boşlukla ayrılıp satır sonuyla tek bir write çağrısıyla stdout'a yazılır; metin
+ * yığındaki tamponun sonundan başına doğru (son argümandan ilkine) üretilir.
+ * @return Yordamın konumu.
+ */
+static size_t amd64_emit_print_routine(Amd64Codegen* cg) {
+    Amd64Buffer* out = cg->out;
+    // Argüman başına en fazla 20 basamak, işaret ve ayırıcı; sonda satır sonu
+    const int32_t buffer_size = 384;
+    size_t start = out->size;
+    amd64_alu_imm(out, AMD64_ALU_SUB, amd64_reg(AMD64_RSP), buffer_size);
+    amd64_lea(out, AMD64_R9, amd64_mem(AMD64_RSP, buffer_size)); // Tamponun sonu
+    amd64_lea(out, AMD64_R10, amd64_mem(AMD64_R9, -1));          // Yazma konumu
+    amd64_mov_store8_imm(out, amd64_mem(AMD64_R10, 0), '\n');
+    amd64_mov(out, amd64_reg(AMD64_RCX), amd64_reg(AMD64_RDI));
+    amd64_lea(out, AMD64_R8, AMD64_STATE_FIELD(print_args));
+    amd64_mov_imm(out, AMD64_R11, 10);
+    amd64_test(out, amd64_reg(AMD64_RCX), AMD64_RCX);
+    size_t no_args = amd64_jcc(out, AMD64_CC_E);
+
+    size_t next_argument = out->size;
+    amd64_mov(out, amd64_reg(AMD64_RAX), amd64_mem_index(AMD64_R8, AMD64_RCX, 8, -8));
+    amd64_mov(out, amd64_reg(AMD64_RSI), amd64_reg(AMD64_RAX));
+    amd64_test(out, amd64_reg(AMD64_RAX), AMD64_RAX);
+    size_t positive = amd64_jcc8(out, AMD64_CC_GE);
+    amd64_neg(out, amd64_reg(AMD64_RAX)); // INT64_MIN işaretsiz bölmede doğru kalır
+    amd64_patch_rel8(out, positive, out->size);
+    size_t next_digit = out->size;
+    amd64_mov_imm(out, AMD64_RDX, 0);
+    amd64_div(out, amd64_reg(AMD64_R11));
+    amd64_alu_imm(out, AMD64_ALU_ADD, amd64_reg(AMD64_RDX), '0');
+    amd64_lea(out, AMD64_R10, amd64_mem(AMD64_R10, -1));
+    amd64_mov_store8(out, amd64_mem(AMD64_R10, 0), AMD64_RDX);
+    amd64_test(out, amd64_reg(AMD64_RAX), AMD64_RAX);
+    amd64_patch_rel8(out, amd64_jcc8(out, AMD64_CC_NE), next_digit);
+    amd64_test(out, amd64_reg(AMD64_RSI), AMD64_RSI);
+    size_t no_sign = amd64_jcc8(out, AMD64_CC_GE);
+    amd64_lea(out, AMD64_R10, amd64_mem(AMD64_R10, -1));
+    amd64_mov_store8_imm(out, amd64_mem(AMD64_R10, 0), '-');
+    amd64_patch_rel8(out, no_sign, out->size);
+    amd64_alu_imm(out, AMD64_ALU_SUB, amd64_reg(AMD64_RCX), 1);
+    size_t done = amd64_jcc(out, AMD64_CC_E);
+    amd64_lea(out, AMD64_R10, amd64_mem(AMD64_R10, -1));
+    amd64_mov_store8_imm(out, amd64_mem(AMD64_R10, 0), ' ');
+    amd64_patch_rel32(out, amd64_jmp(out), next_argument);
+
+    amd64_patch_rel32(out, no_args, out->size);
+    amd64_patch_rel32(out, done, out->size);
+    amd64_mov_imm(out, AMD64_RAX, AMD64_LINUX_SYS_WRITE);
+    amd64_mov_imm(out, AMD64_RDI, 1);
+    amd64_mov(out, amd64_reg(AMD64_RSI), amd64_reg(AMD64_R10));
+    amd64_mov(out, amd64_reg(AMD64_RDX), amd64_reg(AMD64_R9));
+    amd64_alu(out, AMD64_ALU_SUB, amd64_reg(AMD64_RDX), amd64_reg(AMD64_R10));
+    amd64_syscall(out);
+    amd64_alu_imm(out, AMD64_ALU_ADD, amd64_reg(AMD64_RSP), buffer_size);
+    amd64_ret(out);
+    return start;
+}
+
+static void amd64_codegen_free(Amd64Codegen* cg) {
+    free(cg->flags_read);
+    isel_selection_free(&cg->selection);
+    isel_matcher_free(&cg->matcher);
+    free(cg->block_offsets);
+    free(cg->fixups);
+    free(cg->relaxed);
+    free(cg->stubs);
+    free(cg->tables);
+    free(cg->call_returns);
+    free(cg->runtime_calls);
+}
+
+/**
+ * @brief Tek üretim geçişi: giriş, bloklar (yerleşim sırasıyla), soğuk kodlar ve dal düzeltmeleri.
+ * Atlama tabloları süreç içi yürütmede kodun sonuna yazılır; nesne dosyasında
+ * amd64_generate_object onları .rodata'ya ekler.
+ * @param relaxed Erişimi yetmeyen bir rel8 dal uzun biçime çevrildiyse 1 yapılır (geçiş tekrarlanır).
+ */
+static int amd64_generate_pass(Amd64Codegen* cg, int* relaxed) {
+    const IrFunction* fn = cg->fn;
+    Amd64Buffer* out = cg->out;
+    int ok = 1;
+    *relaxed = 0;
+    for (size_t i = 0; i < fn->num_blocks; i++) cg->block_offsets[i] = SIZE_MAX;
+
+    size_t body_call;
+    if (cg->obj) {
+        amd64_emit_native_entry(cg, &body_call);
+    } else {
+        amd64_emit_prologue(cg, &body_call);
+    }
+    if (fn->num_layout > 0) {
+        amd64_add_fixup(cg, body_call, fn->layout[0], 0);
+    } else {
+        amd64_patch_rel32(out, body_call, cg->leave);
+    }
+
+    // Bloklar yerleşim sırasıyla
+    for (size_t l = 0; l < fn->num_layout && ok; l++) {
+        uint32_t b = fn->layout[l];
+        uint32_t next = l + 1 < fn->num_layout ? fn->layout[l + 1] : IR_NO_BLOCK;
+        const IrBlock* block = &fn->blocks[b];
+        cg->block_offsets[b] = out->size;
+        for (uint32_t k = 0; k < block->num_instrs && ok; k++) {
+            size_t index = block->first + k;
+            if (cg->selection.folded[index]) continue; // Kullanıldığı komutun kalıbında yazılır
+            ok = amd64_emit_instruction(cg, &fn->instrs[index], fn->locations ? fn->locations[index].line : 0, next);
+        }
+    }
+
+    // Soğuk hata kodları: nedeni ve satırı bağlama yazıp çık
+    if (ok && cg->obj) ok = amd64_emit_native_stubs(cg);
+    for (size_t s = 0; s < cg->num_stubs && ok && !cg->obj; s++) {
+        amd64_patch_rel32(out, cg->stubs[s].position, out->size);
+        amd64_mov_store32(out, AMD64_CONTEXT_FIELD(exit_reason), cg->stubs[s].reason);
+        amd64_mov_store32(out, AMD64_CONTEXT_FIELD(error_line), cg->stubs[s].line);
+        amd64_patch_rel32(out, amd64_jmp(out), cg->leave);
+    }
+
+    // print yordamı sadece kullanılıyorsa yazılır
+    size_t print_routine = SIZE_MAX;
+    for (size_t c = 0; c < cg->num_runtime_calls && ok; c++) {
+        if (cg->runtime_calls[c].symbol) continue;
+        if (print_routine == SIZE_MAX) print_routine = amd64_emit_print_routine(cg);
+        amd64_patch_rel32(out, cg->runtime_calls[c].position, print_routine);
+    }
+
+    // Atlama tabloları: girişler tablo başına göre i32 uzaklıklar
+    if (ok && cg->num_tables > 0 && !cg->obj) amd64_align(out, 4, 0xcc);
+    for (size_t t = 0; t < cg->num_tables && ok && !cg->obj; t++) {
+        const IrJumpTable* table = &fn->jump_tables[cg->tables[t].table];
+        size_t start = out->size;
+        amd64_patch_rel32(out, cg->tables[t].position, start);
+        for (uint32_t e = 0; e < table->num_targets && ok; e++) {
+            uint32_t target = fn->pool[table->first_target + e];
+            if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+                ok = 0;
+                break;
+            }
+            uint8_t entry[4];
+            uint32_t value = (uint32_t)(int32_t)((int64_t)cg->block_offsets[target] - (int64_t)start);
+            for (int i = 0; i < 4; i++) entry[i] = (uint8_t)(value >> (8 * i));
+            amd64_emit_bytes(out, entry, 4);
+        }
+    }
+
+    for (size_t f = 0; f < cg->num_fixups && ok; f++) {
+        uint32_t target = cg->fixups[f].block;
+        if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+            fprintf(stderr, "Hata: amd64 kod üretimi: yerleşimde olmayan bloğa dal (b%u).\n", target);
+            ok = 0;
+            break;
+        }
+        if (!cg->fixups[f].is_short) {
+            amd64_patch_rel32(out, cg->fixups[f].position, cg->block_offsets[target]);
+        } else if (!amd64_patch_rel8(out, cg->fixups[f].position, cg->block_offsets[target])) {
+            amd64_relax(cg, f);
+            *relaxed = 1;
+        }
+    }
+    if (ok && (out->failed || cg->out_of_memory)) {
+        fprintf(stderr, "Hata: amd64 kod üretimi için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * @brief Ortak üretim. Blok dalları önce kısa (rel8) biçimde yazılır; erişimi yetmeyenler uzatılıp
+ * kod baştan üretilir. Dallar sadece uzadığı için geçişler sabit bir noktada durur.
+ */
+static int amd64_generate(Amd64Codegen* cg) {
+    const IrFunction* fn = cg->fn;
+    Amd64Buffer* out = cg->out;
+    cg->flags_read = (uint8_t*)calloc(fn->num_vregs + 1, 1);
+    cg->block_offsets = (size_t*)malloc(sizeof(size_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    if (!cg->flags_read || !cg->block_offsets) {
+        fprintf(stderr, "Hata: amd64 kod üretimi için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+
+    // ADD/SUB sonrası test okuyuculara göre yazılır; mimari bayrak değeri bloklar arasında
+    // taşındığı için okuyucuları bilinmez (sıralama okuyucusu var kabul edilir)
+    cg->flags_read[IR_VREG_FLAGS] = AMD64_FLAGS_READ_ORDER;
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if ((instr->opcode == IR_OP_BR || instr->opcode == IR_OP_SEL) && instr->flags < fn->num_vregs) {
+            cg->flags_read[instr->flags] |= instr->cond == IR_COND_EQ || instr->cond == IR_COND_NE
+                                                ? AMD64_FLAGS_READ_EQUALITY : AMD64_FLAGS_READ_ORDER;
+        }
+    }
+    amd64_assign_registers(cg);
+    if (!isel_compile(&cg->matcher, amd64_patterns, sizeof(amd64_patterns) / sizeof(amd64_patterns[0]), "amd64") ||
+        !isel_select(&cg->matcher, fn, cg, &cg->selection)) {
+        return 0;
+    }
+
+    size_t rodata_size = cg->obj ? cg->obj->sections[cg->rodata].size : 0;
+    int relaxed;
+    int ok = amd64_generate_pass(cg, &relaxed);
+    while (ok && relaxed) {
+        // Önceki geçişin çıktısı atılır; hata mesajları .rodata'ya yeniden eklenir
+        out->size = 0;
+        out->num_symbol_refs = 0;
+        cg->num_fixups = cg->num_stubs = cg->num_tables = cg->num_calls = cg->num_runtime_calls = 0;
+        if (cg->obj) cg->obj->sections[cg->rodata].size = rodata_size;
+        ok = amd64_generate_pass(cg, &relaxed);
+    }
+    if (ok && out->size > INT32_MAX) {
+        fprintf(stderr, "Hata: amd64 kod üretimi: kod boyutu 2 GB sınırını aşıyor.\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+int amd64_generate_jit(const IrFunction* fn, Amd64Buffer* out, Amd64CodeMap* map) {
+    Amd64Codegen cg;
+    memset(&cg, 0, sizeof(cg));
+    cg.fn = fn;
+    cg.out = out;
+    int ok = amd64_generate(&cg);
+
+    if (ok && map) {
+        memset(map, 0, sizeof(*map));
+        map->osr_entry = (uint32_t)cg.osr_entry;
+        map->block_offsets = (uint32_t*)malloc(sizeof(uint32_t) * (fn->num_blocks ? fn->num_blocks : 1));
+        if (!map->block_offsets) {
+            fprintf(stderr, "Hata: amd64 kod üretimi için bellek tahsis edilemedi.\n");
+            ok = 0;
+        }
+        for (size_t b = 0; b < fn->num_blocks && ok; b++) {
+            map->block_offsets[b] = cg.block_offsets[b] == SIZE_MAX ? AMD64_NO_OFFSET : (uint32_t)cg.block_offsets[b];
+        }
+        map->num_blocks = fn->num_blocks;
+        map->call_returns = cg.call_returns; // Sahiplik haritaya geçer
+        map->num_calls = cg.num_calls;
+        cg.call_returns = NULL;
+        if (!ok) amd64_code_map_free(map);
+    }
+
+    amd64_codegen_free(&cg);
+    return ok;
+}
+
+/**
+ * @brief Nesne dosyası: atlama tablolarını .rodata'ya REL32 girişlerle yazar. Hedef bloklar için
+ * yerel semboller tanımlanır; tablo adresini yükleyen lea'lar tablo sembolüne bağlanır.
+ */
+static int amd64_emit_object_tables(Amd64Codegen* cg, int text) {
+    const IrFunction* fn = cg->fn;
+    ObjectFile* obj = cg->obj;
+    for (size_t t = 0; t < cg->num_tables; t++) {
+        const IrJumpTable* table = &fn->jump_tables[cg->tables[t].table];
+        char (*names)[32] = (char(*)[32])malloc(sizeof(*names) * (table->num_targets ? table->num_targets : 1));
+        const char** targets = (const char**)malloc(sizeof(char*) * (table->num_targets ? table->num_targets : 1));
+        int ok = names && targets;
+        if (!ok) fprintf(stderr, "Hata: amd64 kod üretimi için bellek tahsis edilemedi.\n");
+        for (uint32_t e = 0; e < table->num_targets && ok; e++) {
+            uint32_t target = fn->pool[table->first_target + e];
+            if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+                fprintf(stderr, "Hata: amd64 kod üretimi: atlama tablosu yerleşimde olmayan bloğu gösteriyor (b%u).\n",
+                        target);
+                ok = 0;
+                break;
+            }
+            snprintf(names[e], sizeof(names[e]), "__bsm_b%u", target);
+            targets[e] = names[e];
+            int symbol = object_file_symbol(obj, names[e]);
+            if (symbol < 0) {
+                ok = 0;
+            } else if (!obj->symbols[symbol].declared) {
+                ok = object_file_define_symbol(obj, names[e], text, cg->block_offsets[target], OBJ_SYMBOL_LOCAL,
+                                               OBJ_SYMBOL_NOTYPE) >= 0;
+            }
+        }
+        char table_name[32];
+        snprintf(table_name, sizeof(table_name), "__bsm_jtab%zu", t);
+        ok = ok && object_file_emit_jump_table(obj, table_name, targets, table->num_targets, JUMP_TABLE_REL32) &&
+             object_file_add_relocation(obj, text, cg->tables[t].position, table_name, RELOC_PC32, -4);
+        free(names);
+        free(targets);
+        if (!ok) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Bessambly etiketlerini bloklarının son yerleşimdeki konumlarında yerel semboller olarak
+ * tanımlar; derleyicinin sembol tablosu gerçek adresleri buradan alır. Nesne dosyasında zaten
+ * bulunan adlar (giriş noktası, çalışma zamanı sembolleri) atlanır.
+ */
+static int amd64_define_labels(Amd64Codegen* cg, int text) {
+    const IrFunction* fn = cg->fn;
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        if (cg->block_offsets[b] == SIZE_MAX) continue;
+        for (uint32_t k = 0; k < block->num_labels; k++) {
+            const char* name = ir_label_name(fn, &fn->labels[block->first_label + k]);
+            if (object_file_find_symbol(cg->obj, name) >= 0) continue;
+            if (object_file_define_symbol(cg->obj, name, text, cg->block_offsets[b], OBJ_SYMBOL_LOCAL,
+                                          OBJ_SYMBOL_NOTYPE) < 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int amd64_generate_object(const IrFunction* fn, ObjectFile* obj, const ObjectCodegenOptions* options,
+                          ObjectCodegenStats* stats) {
+    Amd64Buffer out = {0};
+    Amd64Codegen cg;
+    memset(&cg, 0, sizeof(cg));
+    cg.fn = fn;
+    cg.out = &out;
+    cg.obj = obj;
+
+    int text = object_file_add_section(obj, ".text", OBJ_SECTION_TEXT, 16);
+    cg.rodata = object_file_add_section(obj, ".rodata", OBJ_SECTION_RODATA, 8);
+    int bss = object_file_add_section(obj, ".bss", OBJ_SECTION_BSS, 8);
+    int ok = text >= 0 && cg.rodata >= 0 && bss >= 0 &&
+             object_file_define_symbol(obj, AMD64_RODATA_SYMBOL, cg.rodata, 0, OBJ_SYMBOL_LOCAL,
+                                       OBJ_SYMBOL_OBJECT) >= 0;
+
+    // PGO: sayaç sayısı seçeneklerden veya IR'deki en büyük sayaçtan
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode == IR_OP_PROFDUMP) cg.instrumented = 1;
+        if (instr->opcode != IR_OP_PROFCNT) continue;
+        cg.instrumented = 1;
+        int64_t counter = ir_instr_immediate(fn, instr);
+        if (counter >= 0 && (uint64_t)counter + 1 > cg.num_counters) cg.num_counters = (uint64_t)counter + 1;
+    }
+    if (ok && cg.instrumented) {
+        const char* path = options && options->profile_path ? options->profile_path : BSM_PROFILE_DEFAULT_PATH;
+        if (options && options->profile_num_counters > cg.num_counters) cg.num_counters = options->profile_num_counters;
+        cg.profile_checksum = options ? options->profile_checksum : 0;
+        cg.profile_path = obj->sections[cg.rodata].size;
+        ok = object_file_append(obj, cg.rodata, path, strlen(path) + 1);
+    }
+
+    ok = ok && amd64_generate(&cg);
+
+    // .text, .bss ve semboller; rip göreli başvurular PC32 yeniden konumlandırmasına çevrilir
+    int entry = -1, state = -1;
+    if (ok) {
+        ok = object_file_append(obj, text, out.data, out.size);
+        const char* entry_name = cg.instrumented ? AMD64_INSTRUMENTED_ENTRY_SYMBOL : AMD64_ENTRY_SYMBOL;
+        entry = ok ? object_file_define_symbol(obj, entry_name, text, 0, OBJ_SYMBOL_GLOBAL, OBJ_SYMBOL_FUNCTION)
+                   : -1;
+        state = ok ? object_file_define_symbol(obj, AMD64_STATE_SYMBOL, bss, 0, OBJ_SYMBOL_LOCAL,
+                                               OBJ_SYMBOL_OBJECT) : -1;
+        ok = entry >= 0 && state >= 0 && object_file_append(obj, bss, NULL, sizeof(Amd64NativeState));
+    }
+    if (ok) {
+        obj->symbols[entry].size = out.size;
+        obj->symbols[state].size = sizeof(Amd64NativeState);
+    }
+    for (size_t r = 0; r < out.num_symbol_refs && ok; r++) {
+        const Amd64SymbolRef* ref = &out.symbol_refs[r];
+        const char* name = ref->symbol == AMD64_SYMBOL_STATE ? AMD64_STATE_SYMBOL : AMD64_RODATA_SYMBOL;
+        ok = object_file_add_relocation(obj, text, ref->position, name, RELOC_PC32, ref->addend);
+    }
+    for (size_t c = 0; c < cg.num_runtime_calls && ok; c++) {
+        const char* symbol = cg.runtime_calls[c].symbol;
+        if (!symbol) continue; // print yordamı kodun içindedir
+        ok = object_file_define_symbol(obj, symbol, OBJ_SECTION_UNDEFINED, 0, OBJ_SYMBOL_GLOBAL,
+                                       OBJ_SYMBOL_FUNCTION) >= 0 &&
+             object_file_add_relocation(obj, text, cg.runtime_calls[c].position, symbol, RELOC_PC32, -4);
+    }
+    ok = ok && amd64_emit_object_tables(&cg, text);
+    ok = ok && amd64_define_labels(&cg, text);
+
+    if (ok && stats) {
+        stats->code_size = out.size;
+        stats->num_machine_registers = 0;
+        for (int r = 0; r < IR_NUM_REGISTERS; r++) stats->num_machine_registers += !cg.locations[r].is_memory;
+        stats->num_relocations = obj->num_relocations;
+        stats->num_folded_instrs = cg.selection.num_folded;
+        stats->num_scheduled_regions = 0;
+    }
+    amd64_codegen_free(&cg);
+    amd64_buffer_free(&out);
+    return ok;
+}
+
+void amd64_code_map_free(Amd64CodeMap* map) {
+    if (!map) return;
+    free(map->block_offsets);
+    free(map->call_returns);
+    map->block_offsets = NULL;
+    map->call_returns = NULL;
+}
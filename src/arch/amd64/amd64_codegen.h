@@ -0,0 +1,98 @@
+#ifndef AMD64_CODEGEN_H
+#define AMD64_CODEGEN_H
+
+#include "ir_generator.h" // IrFunction (kod üretiminin girdisi)
+#include "arch/amd64/amd64_encoder.h" // Amd64Buffer
+#include "object_file_writer.h" // ObjectFile (nesne dosyası çıktısı)
+
+// --- amd64 Kod Üretimi (süreç içi yürütme) ---
+// IR doğrudan x86-64 makine koduna çevrilir. Kaydediciler:
+//  - R15 JitContext'i gösterir (bkz. jit.h); RAX, RDX ve R11 geçici kaydedicilerdir
+//    (bölme RDX:RAX kullanır, 32 bite sığmayan sabitler R11'e yüklenir).
+//  - Kalan 11 makine kaydedicisi, programda en sık kullanılan Bessambly kaydedicilerine
+//    atanır; diğerleri bağlamdaki registers dizisinde bellek operandı olarak kullanılır.
+// Kaynaklar AST'deki 2 adresli biçimdedir; sanal kaydediciler kökenlerine eşlenir (VBSM ile aynı).
+//
+// Bayraklar makinenin bayraklarında taşınır: CMP doğrudan "cmp"dir; bayrak kuran ADD/SUB'un
+// sonucu okunuyorsa ardından "test" yazılır (Bessambly'de bayraklar (sonuç, 0) karşılaştırmasıdır,
+// taşma bayrağı hesaba katılmaz). Bayrakları koruması gereken komutlar (MOV, SELcc, PROFCNT)
+// bayrak değiştirmeyen makine komutlarıyla üretilir.
+//
+// CALL/RET makinenin call/ret komutlarıdır; en dıştaki RET girişe döner. Çağrı derinliği yığın
+// göstericisinin bağlamdaki sınırla karşılaştırılmasıyla denetlenir.
+//
+// Yerinde geçiş (OSR) girişi, yürütmeye herhangi bir bloktan başlar: BVM'nin çağrı yığınındaki
+// her çerçeve için ilgili CALL'un makine kodundaki dönüş adresi yığına itilir, bayraklar
+// "cmp" ile yeniden kurulur ve bloğa atlanır (bkz. JitContext.osr_*).
+//
+// Kod düzeni: giriş, çıkış, OSR girişi, bloklar (yerleşim sırasıyla), soğuk hata kodları, atlama
+// tabloları (4 bayta hizalı, girişler tablo başına göre i32). Kod konumdan bağımsızdır.
+// Bloklar arası dallar önce rel8 (±128 bayt) biçiminde yazılır; erişimi yetmeyenler rel32'ye
+// uzatılıp kod baştan üretilir (dallar sadece uzadığı için birkaç geçişte sabitlenir).
+//
+// --- amd64 Kod Üretimi (Linux nesne dosyası) ---
+// Aynı çeviri, bağlanıp doğrudan çalıştırılacak bir ELF nesne dosyasına yazılır. Bağlam
+// kaydedicisi yoktur: yığın göstericisi (RSP) CALL/RET için ayrılır, RAX ve R11 geçicidir;
+// kalan 13 makine kaydedicisi (RDX dahil; bölme sırasında saklanır) en sık kullanılan Bessambly
+// kaydedicilerine atanır. Geri kalan 3 kaydedici ve çalışma zamanı durumu (çağrı derinliği
+// sınırı, PGO sayaç dizisi, print argümanları) .bss'tedir ve rip göreli adreslenir.
+// Sabitler her zaman en kısa kodlamayla yazılır (imm8, imm32 veya movabs).
+//
+// SYSCALL, Linux sistem çağrısı ABI'sine indirgenir: numara RAX'e, argümanlar sırasıyla RDI, RSI,
+// RDX, R10, R8, R9'a yüklenir (en fazla 6) ve "syscall" çalıştırılır; dönüş değeri R0'a yazılır.
+// Çekirdeğin bozduğu (RCX, R11) ve argüman için kullanılan makine kaydedicileri çağrı boyunca
+// .bss'te saklanır. Argümansız exit/exit_group, BVM'deki gibi R0'ı çıkış kodu olarak kullanır.
+// BVM'nin print çağrısı (AMD64_HYPERCALL_PRINT) koda gömülü küçük bir yordamla stdout'a yazılır.
+//
+// Giriş noktası "_start"tır ve program bağımsızdır (örn: ld program.o): yığın sınırı kurulur,
+// gövde çağrılır; en dıştaki RET ve END 0 koduyla exit_group çağırır. Yürütme hataları (sıfıra
+// bölme, çağrı yığını taşması) stderr'e satır numaralı bir mesaj yazıp 1 koduyla çıkar. Atlama
+// tabloları .rodata'dadır (REL32). PGO ile enstrümante programlarda giriş noktası "main"dir;
+// runtime/bsm_profile_rt.c ve C kütüphanesiyle bağlanır (örn: cc program.o bsm_profile_rt.c).
+// Bessambly etiketleri .text'te bloklarının son konumlarında yerel semboller olarak tanımlanır.
+
+#define AMD64_NO_OFFSET 0xFFFFFFFFu
+
+#define AMD64_LINUX_MAX_SYSCALL_ARGS 6
+#define AMD64_MAX_PRINT_ARGS 16
+#define AMD64_HYPERCALL_PRINT 0x1000    // BVM ile aynı numara
+
+// --- Üretilen Kodun Haritası (OSR için) ---
+typedef struct {
+    uint32_t osr_entry;         // OSR girişinin konumu
+    uint32_t* block_offsets;    // Blok başına konum (yerleşimde değilse AMD64_NO_OFFSET)
+    size_t num_blocks;
+    uint32_t* call_returns;     // CALL komutlarının dönüş konumları (yerleşim sırasıyla)
+    size_t num_calls;
+} Amd64CodeMap;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief IR'yı süreç içi yürütme için makine koduna çevirir. Konum 0 giriş noktasıdır ve
+ * C'den "void giris(JitContext* ctx)" olarak çağrılır (System V çağrı kuralı).
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param out Kodun ekleneceği boş tampon (başarısızlıkta da çağıran serbest bırakır).
+ * @param map Boş değilse kodun haritası yazılır (dizileri çağıran amd64_code_map_free ile bırakır).
+ * @return Başarılıysa 1, aksi takdirde 0 (stderr'e açıklama yazılır).
+ */
+int amd64_generate_jit(const IrFunction* fn, Amd64Buffer* out, Amd64CodeMap* map);
+
+/**
+ * @brief IR'yı Linux x86-64 için makine koduna çevirip nesne dosyasına yazar (.text, .rodata,
+ * .bss ve "_start" ya da enstrümante programlarda "main" sembolü).
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param obj Boş, ARCH_AMD64 için oluşturulmuş nesne dosyası.
+ * @param options Enstrümantasyon bilgileri (NULL olabilir).
+ * @param stats Boş değilse istatistikler yazılır.
+ * @return Başarılıysa 1, aksi takdirde 0 (stderr'e açıklama yazılır).
+ */
+int amd64_generate_object(const IrFunction* fn, ObjectFile* obj, const ObjectCodegenOptions* options,
+                          ObjectCodegenStats* stats);
+
+/**
+ * @brief Kod haritasının dizilerini serbest bırakır.
+ */
+void amd64_code_map_free(Amd64CodeMap* map);
+
+#endif // AMD64_CODEGEN_H
@@ -0,0 +1,354 @@
+#include "arch/amd64/amd64_encoder.h"
+#include <stdlib.h> // realloc, free
+#include <string.h> // memcpy, memset
+
+// --- Tampon ---
+
+void amd64_emit_bytes(Amd64Buffer* buffer, const void* bytes, size_t size) {
+    if (buffer->failed || size == 0) return;
+    if (buffer->size + size > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity : 256;
+        while (new_capacity < buffer->size + size) new_capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, new_capacity);
+        if (!data) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = new_capacity;
+    }
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+}
+
+void amd64_buffer_free(Amd64Buffer* buffer) {
+    free(buffer->data);
+    free(buffer->symbol_refs);
+    buffer->data = NULL;
+    buffer->symbol_refs = NULL;
+    buffer->size = buffer->capacity = 0;
+    buffer->num_symbol_refs = buffer->symbol_ref_capacity = 0;
+}
+
+static void amd64_add_symbol_ref(Amd64Buffer* buffer, size_t position, int64_t addend, uint8_t symbol) {
+    if (buffer->failed) return;
+    if (buffer->num_symbol_refs >= buffer->symbol_ref_capacity) {
+        size_t new_capacity = buffer->symbol_ref_capacity ? buffer->symbol_ref_capacity * 2 : 32;
+        Amd64SymbolRef* refs = (Amd64SymbolRef*)realloc(buffer->symbol_refs, sizeof(Amd64SymbolRef) * new_capacity);
+        if (!refs) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->symbol_refs = refs;
+        buffer->symbol_ref_capacity = new_capacity;
+    }
+    Amd64SymbolRef* ref = &buffer->symbol_refs[buffer->num_symbol_refs++];
+    ref->position = position;
+    ref->addend = addend;
+    ref->symbol = symbol;
+}
+
+static void amd64_byte(Amd64Buffer* buffer, uint8_t value) {
+    amd64_emit_bytes(buffer, &value, 1);
+}
+
+static void amd64_u32(Amd64Buffer* buffer, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    amd64_emit_bytes(buffer, bytes, 4);
+}
+
+void amd64_align(Amd64Buffer* buffer, size_t alignment, uint8_t fill) {
+    while (buffer->size % alignment != 0 && !buffer->failed) amd64_byte(buffer, fill);
+}
+
+void amd64_patch_u32(Amd64Buffer* buffer, size_t position, uint32_t value) {
+    if (buffer->failed || position + 4 > buffer->size) return;
+    for (int i = 0; i < 4; i++) buffer->data[position + i] = (uint8_t)(value >> (8 * i));
+}
+
+void amd64_patch_rel32(Amd64Buffer* buffer, size_t position, size_t target) {
+    amd64_patch_u32(buffer, position, (uint32_t)(int32_t)((int64_t)target - (int64_t)(position + 4)));
+}
+
+int amd64_patch_rel8(Amd64Buffer* buffer, size_t position, size_t target) {
+    int64_t distance = (int64_t)target - (int64_t)(position + 1);
+    if (distance < INT8_MIN || distance > INT8_MAX) return 0;
+    if (!buffer->failed && position < buffer->size) buffer->data[position] = (uint8_t)(int8_t)distance;
+    return 1;
+}
+
+// --- Operandlar ---
+
+Amd64Operand amd64_reg(Amd64Register reg) {
+    Amd64Operand operand;
+    memset(&operand, 0, sizeof(operand));
+    operand.reg = (uint8_t)reg;
+    operand.index = AMD64_NO_REGISTER;
+    return operand;
+}
+
+Amd64Operand amd64_mem(Amd64Register base, int32_t disp) {
+    return amd64_mem_index(base, AMD64_NO_REGISTER, 1, disp);
+}
+
+Amd64Operand amd64_mem_index(Amd64Register base, Amd64Register index, uint8_t scale, int32_t disp) {
+    Amd64Operand operand;
+    memset(&operand, 0, sizeof(operand));
+    operand.is_memory = 1;
+    operand.base = (uint8_t)base;
+    operand.index = (uint8_t)index;
+    operand.scale = scale;
+    operand.disp = disp;
+    return operand;
+}
+
+Amd64Operand amd64_rip(int32_t disp) {
+    Amd64Operand operand = amd64_mem(AMD64_NO_REGISTER, disp);
+    operand.rip_relative = 1;
+    return operand;
+}
+
+Amd64Operand amd64_symbol(uint8_t symbol, int32_t offset) {
+    Amd64Operand operand = amd64_rip(offset);
+    operand.symbol = symbol;
+    return operand;
+}
+
+/**
+ * @brief [REX] işlem kodu ModRM [SIB] [uzaklık] yazar.
+ * @param wide REX.W (64-bit işlem boyutu).
+ * @param reg ModRM reg alanı (kaydedici veya /digit).
+ * @param rm Kaydedici veya bellek operandı.
+ * @param imm_size Komutun sonundaki sabitin boyutu (sembol başvurusunun ek değeri için).
+ */
+static void amd64_emit_rm(Amd64Buffer* buffer, int wide, const uint8_t* opcode, size_t opcode_size, int reg,
+                          Amd64Operand rm, size_t imm_size) {
+    uint8_t rex = (uint8_t)(0x40 | (wide ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0));
+    if (!rm.is_memory) {
+        if (rm.reg & 8) rex |= 0x01;
+    } else if (!rm.rip_relative) {
+        if (rm.index != AMD64_NO_REGISTER && (rm.index & 8)) rex |= 0x02;
+        if (rm.base & 8) rex |= 0x01;
+    }
+    if (rex != 0x40) amd64_byte(buffer, rex);
+    amd64_emit_bytes(buffer, opcode, opcode_size);
+
+    if (!rm.is_memory) {
+        amd64_byte(buffer, (uint8_t)(0xc0 | (reg & 7) << 3 | (rm.reg & 7)));
+        return;
+    }
+    if (rm.rip_relative) {
+        amd64_byte(buffer, (uint8_t)((reg & 7) << 3 | 5));
+        if (rm.symbol) {
+            // Uzaklık komutun sonuna göredir; sonrasında gelen sabit de hesaba katılır
+            amd64_add_symbol_ref(buffer, buffer->size, (int64_t)rm.disp - 4 - (int64_t)imm_size, rm.symbol);
+            amd64_u32(buffer, 0);
+        } else {
+            amd64_u32(buffer, (uint32_t)rm.disp);
+        }
+        return;
+    }
+    // rbp/r13 tabanı uzaklıksız kodlanamaz; rsp/r12 tabanı SIB gerektirir
+    int mod = rm.disp == 0 && (rm.base & 7) != 5 ? 0 : rm.disp >= -128 && rm.disp <= 127 ? 1 : 2;
+    int need_sib = rm.index != AMD64_NO_REGISTER || (rm.base & 7) == 4;
+    amd64_byte(buffer, (uint8_t)(mod << 6 | (reg & 7) << 3 | (need_sib ? 4 : (rm.base & 7))));
+    if (need_sib) {
+        int scale_bits = rm.scale == 8 ? 3 : rm.scale == 4 ? 2 : rm.scale == 2 ? 1 : 0;
+        int index = rm.index != AMD64_NO_REGISTER ? (rm.index & 7) : 4;
+        amd64_byte(buffer, (uint8_t)(scale_bits << 6 | index << 3 | (rm.base & 7)));
+    }
+    if (mod == 1) amd64_byte(buffer, (uint8_t)(int8_t)rm.disp);
+    if (mod == 2) amd64_u32(buffer, (uint32_t)rm.disp);
+}
+
+static void amd64_emit_op(Amd64Buffer* buffer, int wide, uint8_t opcode, int reg, Amd64Operand rm,
+                          size_t imm_size) {
+    amd64_emit_rm(buffer, wide, &opcode, 1, reg, rm, imm_size);
+}
+
+static int amd64_fits_int8(int64_t value) {
+    return value >= -128 && value <= 127;
+}
+
+// --- Komutlar ---
+
+void amd64_mov(Amd64Buffer* buffer, Amd64Operand dst, Amd64Operand src) {
+    if (!dst.is_memory) {
+        amd64_emit_op(buffer, 1, 0x8b, dst.reg, src, 0);
+    } else {
+        amd64_emit_op(buffer, 1, 0x89, src.reg, dst, 0);
+    }
+}
+
+void amd64_mov_imm(Amd64Buffer* buffer, Amd64Register dst, int64_t imm) {
+    if (imm >= 0 && imm <= (int64_t)UINT32_MAX) {
+        // mov r32, imm32 üst yarıyı sıfırlar
+        if (dst & 8) amd64_byte(buffer, 0x41);
+        amd64_byte(buffer, (uint8_t)(0xb8 + (dst & 7)));
+        amd64_u32(buffer, (uint32_t)imm);
+    } else if (imm >= INT32_MIN && imm <= INT32_MAX) {
+        amd64_mov_imm32(buffer, amd64_reg(dst), (int32_t)imm);
+    } else {
+        amd64_byte(buffer, (uint8_t)(0x48 | ((dst & 8) ? 0x01 : 0)));
+        amd64_byte(buffer, (uint8_t)(0xb8 + (dst & 7)));
+        amd64_u32(buffer, (uint32_t)(uint64_t)imm);
+        amd64_u32(buffer, (uint32_t)((uint64_t)imm >> 32));
+    }
+}
+
+void amd64_mov_imm32(Amd64Buffer* buffer, Amd64Operand dst, int32_t imm) {
+    amd64_emit_op(buffer, 1, 0xc7, 0, dst, 4);
+    amd64_u32(buffer, (uint32_t)imm);
+}
+
+void amd64_mov_store32(Amd64Buffer* buffer, Amd64Operand dst, int32_t imm) {
+    amd64_emit_op(buffer, 0, 0xc7, 0, dst, 4);
+    amd64_u32(buffer, (uint32_t)imm);
+}
+
+void amd64_mov_store8(Amd64Buffer* buffer, Amd64Operand dst, Amd64Register src) {
+    amd64_emit_op(buffer, 0, 0x88, src, dst, 0);
+}
+
+void amd64_mov_store8_imm(Amd64Buffer* buffer, Amd64Operand dst, uint8_t imm) {
+    amd64_emit_op(buffer, 0, 0xc6, 0, dst, 1);
+    amd64_byte(buffer, imm);
+}
+
+void amd64_alu(Amd64Buffer* buffer, Amd64AluOp op, Amd64Operand dst, Amd64Operand src) {
+    if (!src.is_memory) {
+        amd64_emit_op(buffer, 1, (uint8_t)(op << 3 | 0x01), src.reg, dst, 0);
+    } else {
+        amd64_emit_op(buffer, 1, (uint8_t)(op << 3 | 0x03), dst.reg, src, 0);
+    }
+}
+
+void amd64_alu_imm(Amd64Buffer* buffer, Amd64AluOp op, Amd64Operand dst, int32_t imm) {
+    if (amd64_fits_int8(imm)) {
+        amd64_emit_op(buffer, 1, 0x83, op, dst, 1);
+        amd64_byte(buffer, (uint8_t)(int8_t)imm);
+    } else {
+        amd64_emit_op(buffer, 1, 0x81, op, dst, 4);
+        amd64_u32(buffer, (uint32_t)imm);
+    }
+}
+
+void amd64_test(Amd64Buffer* buffer, Amd64Operand dst, Amd64Register src) {
+    amd64_emit_op(buffer, 1, 0x85, src, dst, 0);
+}
+
+void amd64_test32(Amd64Buffer* buffer, Amd64Register dst, Amd64Register src) {
+    amd64_emit_op(buffer, 0, 0x85, src, amd64_reg(dst), 0);
+}
+
+void amd64_imul(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src) {
+    static const uint8_t opcode[2] = {0x0f, 0xaf};
+    amd64_emit_rm(buffer, 1, opcode, 2, dst, src, 0);
+}
+
+void amd64_imul_imm(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src, int32_t imm) {
+    if (amd64_fits_int8(imm)) {
+        amd64_emit_op(buffer, 1, 0x6b, dst, src, 1);
+        amd64_byte(buffer, (uint8_t)(int8_t)imm);
+    } else {
+        amd64_emit_op(buffer, 1, 0x69, dst, src, 4);
+        amd64_u32(buffer, (uint32_t)imm);
+    }
+}
+
+void amd64_cqo(Amd64Buffer* buffer) {
+    static const uint8_t bytes[2] = {0x48, 0x99};
+    amd64_emit_bytes(buffer, bytes, 2);
+}
+
+void amd64_idiv(Amd64Buffer* buffer, Amd64Operand src) {
+    amd64_emit_op(buffer, 1, 0xf7, 7, src, 0);
+}
+
+void amd64_div(Amd64Buffer* buffer, Amd64Operand src) {
+    amd64_emit_op(buffer, 1, 0xf7, 6, src, 0);
+}
+
+void amd64_neg(Amd64Buffer* buffer, Amd64Operand dst) {
+    amd64_emit_op(buffer, 1, 0xf7, 3, dst, 0);
+}
+
+void amd64_shl_imm(Amd64Buffer* buffer, Amd64Operand dst, uint8_t shift) {
+    if (shift == 1) {
+        amd64_emit_op(buffer, 1, 0xd1, 4, dst, 0);
+        return;
+    }
+    amd64_emit_op(buffer, 1, 0xc1, 4, dst, 1);
+    amd64_byte(buffer, shift);
+}
+
+void amd64_cmov(Amd64Buffer* buffer, Amd64Condition cc, Amd64Register dst, Amd64Operand src) {
+    uint8_t opcode[2] = {0x0f, (uint8_t)(0x40 | cc)};
+    amd64_emit_rm(buffer, 1, opcode, 2, dst, src, 0);
+}
+
+void amd64_lea(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src) {
+    amd64_emit_op(buffer, 1, 0x8d, dst, src, 0);
+}
+
+void amd64_movsxd(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src) {
+    amd64_emit_op(buffer, 1, 0x63, dst, src, 0);
+}
+
+void amd64_push(Amd64Buffer* buffer, Amd64Register reg) {
+    if (reg & 8) amd64_byte(buffer, 0x41);
+    amd64_byte(buffer, (uint8_t)(0x50 + (reg & 7)));
+}
+
+void amd64_pop(Amd64Buffer* buffer, Amd64Register reg) {
+    if (reg & 8) amd64_byte(buffer, 0x41);
+    amd64_byte(buffer, (uint8_t)(0x58 + (reg & 7)));
+}
+
+void amd64_ret(Amd64Buffer* buffer) {
+    amd64_byte(buffer, 0xc3);
+}
+
+void amd64_syscall(Amd64Buffer* buffer) {
+    static const uint8_t bytes[2] = {0x0f, 0x05};
+    amd64_emit_bytes(buffer, bytes, 2);
+}
+
+size_t amd64_jmp(Amd64Buffer* buffer) {
+    amd64_byte(buffer, 0xe9);
+    amd64_u32(buffer, 0);
+    return buffer->size - 4;
+}
+
+size_t amd64_jcc(Amd64Buffer* buffer, Amd64Condition cc) {
+    amd64_byte(buffer, 0x0f);
+    amd64_byte(buffer, (uint8_t)(0x80 | cc));
+    amd64_u32(buffer, 0);
+    return buffer->size - 4;
+}
+
+size_t amd64_jmp8(Amd64Buffer* buffer) {
+    amd64_byte(buffer, 0xeb);
+    amd64_byte(buffer, 0);
+    return buffer->size - 1;
+}
+
+size_t amd64_jcc8(Amd64Buffer* buffer, Amd64Condition cc) {
+    amd64_byte(buffer, (uint8_t)(0x70 | cc));
+    amd64_byte(buffer, 0);
+    return buffer->size - 1;
+}
+
+size_t amd64_call(Amd64Buffer* buffer) {
+    amd64_byte(buffer, 0xe8);
+    amd64_u32(buffer, 0);
+    return buffer->size - 4;
+}
+
+void amd64_jmp_indirect(Amd64Buffer* buffer, Amd64Operand target) {
+    amd64_emit_op(buffer, 0, 0xff, 4, target, 0);
+}
+
+void amd64_call_indirect(Amd64Buffer* buffer, Amd64Operand target) {
+    amd64_emit_op(buffer, 0, 0xff, 2, target, 0);
+}
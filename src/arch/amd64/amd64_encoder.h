@@ -0,0 +1,176 @@
+#ifndef AMD64_ENCODER_H
+#define AMD64_ENCODER_H
+
+#include <stdint.h> // uint8_t, int32_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- x86-64 Komut Kodlayıcı ---
+// Kod üreticilerin kullandığı küçük bir kodlayıcı: sadece 64-bit tamsayı komutlarının ihtiyaç
+// duyulan biçimleri vardır. Her fonksiyon komutu tampona ekler; bellek hatası tamponun 'failed'
+// alanına yazılır ve sonraki eklemeler yok sayılır (üretim sonunda bir kez denetlenir).
+// Dallar rel32 ile kodlanır; hedefi henüz bilinmeyen dalların uzaklık alanının konumu döndürülür
+// ve hedef belli olunca amd64_patch_rel32 ile yazılır.
+// Sembol göreli operandlar (amd64_symbol) rip göreli kodlanır; uzaklık alanı sıfır bırakılıp
+// tampona bir başvuru kaydı eklenir (nesne dosyasında PC32 yeniden konumlandırmasına çevrilir).
+
+// --- Kaydediciler (kodlamadaki numaralarıyla) ---
+typedef enum {
+    AMD64_RAX, AMD64_RCX, AMD64_RDX, AMD64_RBX, AMD64_RSP, AMD64_RBP, AMD64_RSI, AMD64_RDI,
+    AMD64_R8, AMD64_R9, AMD64_R10, AMD64_R11, AMD64_R12, AMD64_R13, AMD64_R14, AMD64_R15,
+    AMD64_NO_REGISTER = 0xff
+} Amd64Register;
+
+// --- Koşul Kodları (Jcc/CMOVcc/SETcc'nin alt 4 biti) ---
+typedef enum {
+    AMD64_CC_B = 0x2,       // İşaretsiz küçük
+    AMD64_CC_AE = 0x3,      // İşaretsiz büyük veya eşit
+    AMD64_CC_E = 0x4,
+    AMD64_CC_NE = 0x5,
+    AMD64_CC_BE = 0x6,      // İşaretsiz küçük veya eşit
+    AMD64_CC_A = 0x7,       // İşaretsiz büyük
+    AMD64_CC_L = 0xc,       // İşaretli küçük
+    AMD64_CC_GE = 0xd,
+    AMD64_CC_LE = 0xe,
+    AMD64_CC_G = 0xf
+} Amd64Condition;
+
+// --- Aritmetik İşlemler (ModRM reg alanındaki /digit değerleri) ---
+typedef enum {
+    AMD64_ALU_ADD = 0,
+    AMD64_ALU_OR = 1,
+    AMD64_ALU_AND = 4,
+    AMD64_ALU_SUB = 5,
+    AMD64_ALU_XOR = 6,
+    AMD64_ALU_CMP = 7
+} Amd64AluOp;
+
+// --- Operand: kaydedici veya bellek ([taban + indeks*ölçek + uzaklık] ya da [rip + uzaklık]) ---
+typedef struct {
+    uint8_t is_memory;
+    uint8_t reg;            // Kaydedici operandı
+    uint8_t base;           // Bellek: taban kaydedici (rip göreliyse kullanılmaz)
+    uint8_t index;          // Bellek: indeks kaydedici veya AMD64_NO_REGISTER
+    uint8_t scale;          // Bellek: 1, 2, 4 veya 8
+    uint8_t rip_relative;   // Bellek: uzaklık komutun sonuna göre
+    uint8_t symbol;         // Bellek: rip göreli sembol başvurusu (0: yok; numarayı kod üretici belirler)
+    int32_t disp;           // Sembol başvurusunda sembol içindeki konum
+} Amd64Operand;
+
+// --- Sembol Başvurusu (rip göreli uzaklık alanı; bağlama zamanında S + A - P) ---
+typedef struct {
+    size_t position;        // Uzaklık alanının konumu (P)
+    int64_t addend;         // Sembol içindeki konum - (komut sonu - P)
+    uint8_t symbol;
+} Amd64SymbolRef;
+
+// --- Kod Tamponu ---
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int failed;             // Bellek hatası oluştuysa 1
+    Amd64SymbolRef* symbol_refs;
+    size_t num_symbol_refs;
+    size_t symbol_ref_capacity;
+} Amd64Buffer;
+
+// --- Fonksiyon Prototipleri: Operandlar ---
+
+Amd64Operand amd64_reg(Amd64Register reg);
+Amd64Operand amd64_mem(Amd64Register base, int32_t disp);
+Amd64Operand amd64_mem_index(Amd64Register base, Amd64Register index, uint8_t scale, int32_t disp);
+
+/**
+ * @brief Komutun sonuna göre rip göreli bellek operandı. Uzaklık sonradan yazılacaksa 0 verilir;
+ * komut yazıldıktan hemen sonra uzaklık alanı buffer->size - 4 konumundadır (sabit içermeyen komutlar).
+ */
+Amd64Operand amd64_rip(int32_t disp);
+
+/**
+ * @brief Bir sembolün içindeki 'offset' konumunu gösteren rip göreli bellek operandı
+ * (bkz. Amd64SymbolRef). symbol sıfırdan farklı olmalıdır.
+ */
+Amd64Operand amd64_symbol(uint8_t symbol, int32_t offset);
+
+// --- Fonksiyon Prototipleri: Tampon ---
+
+/**
+ * @brief Tampona ham bayt ekler.
+ */
+void amd64_emit_bytes(Amd64Buffer* buffer, const void* bytes, size_t size);
+
+/**
+ * @brief Tamponun kod ve sembol başvurusu dizilerini serbest bırakır.
+ */
+void amd64_buffer_free(Amd64Buffer* buffer);
+
+/**
+ * @brief Tamponu verilen hizaya kadar 'fill' baytıyla doldurur (kod içinde int3 = 0xCC).
+ */
+void amd64_align(Amd64Buffer* buffer, size_t alignment, uint8_t fill);
+
+/**
+ * @brief 'position' konumundaki rel32 alanını 'target' konumunu gösterecek şekilde yazar
+ * (uzaklık alanın sonuna göredir).
+ */
+void amd64_patch_rel32(Amd64Buffer* buffer, size_t position, size_t target);
+
+/**
+ * @brief 'position' konumundaki rel8 alanını 'target' konumunu gösterecek şekilde yazar.
+ * @return Uzaklık -128..127 aralığındaysa 1, aksi takdirde 0 (alan değiştirilmez).
+ */
+int amd64_patch_rel8(Amd64Buffer* buffer, size_t position, size_t target);
+
+/**
+ * @brief Tampondaki bir konuma 32 bitlik küçük-sonlu değer yazar.
+ */
+void amd64_patch_u32(Amd64Buffer* buffer, size_t position, uint32_t value);
+
+// --- Fonksiyon Prototipleri: Komutlar (aksi belirtilmedikçe 64 bit) ---
+
+void amd64_mov(Amd64Buffer* buffer, Amd64Operand dst, Amd64Operand src);    // En az biri kaydedici
+/**
+ * @brief Kaydediciye sabit yükler; bayrakları değiştirmeyen en kısa biçimi seçer
+ * (mov r32, imm32 / mov r64, simm32 / movabs).
+ */
+void amd64_mov_imm(Amd64Buffer* buffer, Amd64Register dst, int64_t imm);
+void amd64_mov_imm32(Amd64Buffer* buffer, Amd64Operand dst, int32_t imm);   // İşaret genişletilir
+void amd64_mov_store32(Amd64Buffer* buffer, Amd64Operand dst, int32_t imm); // 32 bitlik bellek yazımı
+void amd64_mov_store8(Amd64Buffer* buffer, Amd64Operand dst, Amd64Register src); // Alt bayt (src: RAX-RBX, R8-R15)
+void amd64_mov_store8_imm(Amd64Buffer* buffer, Amd64Operand dst, uint8_t imm);
+void amd64_alu(Amd64Buffer* buffer, Amd64AluOp op, Amd64Operand dst, Amd64Operand src); // En az biri kaydedici
+void amd64_alu_imm(Amd64Buffer* buffer, Amd64AluOp op, Amd64Operand dst, int32_t imm);
+void amd64_test(Amd64Buffer* buffer, Amd64Operand dst, Amd64Register src);
+void amd64_test32(Amd64Buffer* buffer, Amd64Register dst, Amd64Register src);
+void amd64_imul(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src);
+void amd64_imul_imm(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src, int32_t imm);
+void amd64_cqo(Amd64Buffer* buffer);
+void amd64_idiv(Amd64Buffer* buffer, Amd64Operand src);
+void amd64_div(Amd64Buffer* buffer, Amd64Operand src);                      // İşaretsiz RDX:RAX / src
+void amd64_neg(Amd64Buffer* buffer, Amd64Operand dst);
+void amd64_shl_imm(Amd64Buffer* buffer, Amd64Operand dst, uint8_t shift);
+void amd64_cmov(Amd64Buffer* buffer, Amd64Condition cc, Amd64Register dst, Amd64Operand src);
+void amd64_lea(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src);
+void amd64_movsxd(Amd64Buffer* buffer, Amd64Register dst, Amd64Operand src); // 32 -> 64 işaret genişletme
+void amd64_push(Amd64Buffer* buffer, Amd64Register reg);
+void amd64_pop(Amd64Buffer* buffer, Amd64Register reg);
+void amd64_ret(Amd64Buffer* buffer);
+void amd64_syscall(Amd64Buffer* buffer);                                    // RCX ve R11 bozulur
+
+/**
+ * @brief rel32 dallar; uzaklık alanının konumunu döndürür (amd64_patch_rel32 ile yazılır).
+ */
+size_t amd64_jmp(Amd64Buffer* buffer);
+size_t amd64_jcc(Amd64Buffer* buffer, Amd64Condition cc);
+size_t amd64_call(Amd64Buffer* buffer);
+
+/**
+ * @brief rel8 (kısa) dallar: 2 bayt; uzaklık alanının konumunu döndürür (amd64_patch_rel8 ile yazılır).
+ */
+size_t amd64_jmp8(Amd64Buffer* buffer);
+size_t amd64_jcc8(Amd64Buffer* buffer, Amd64Condition cc);
+
+void amd64_jmp_indirect(Amd64Buffer* buffer, Amd64Operand target);
+void amd64_call_indirect(Amd64Buffer* buffer, Amd64Operand target);
+
+#endif // AMD64_ENCODER_H
@@ -0,0 +1,1597 @@
+#include "arch/riscv/riscv_codegen.h"
+#include "jit.h"    // JIT_MAX_CALL_DEPTH, JitExitReason (hata nedenleri)
+#include "isel.h"   // Ağaç örüntülü komut seçimi
+#include "profile_format.h" // BSM_PROFILE_DEFAULT_PATH
+#include "regalloc.h" // Doğrusal taramalı kaydedici ataması
+#include "sched.h"  // Liste komut zamanlayıcısı
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // fprintf, snprintf
+#include <string.h> // memset, strlen
+#include <stddef.h> // offsetof
+
+#define RISCV_SCRATCH RISCV_T0              // Birinci kaynak, bellekteki hedef
+#define RISCV_SCRATCH2 RISCV_T1             // İkinci kaynak, büyük sabitler
+#define RISCV_CALL_FRAME_SIZE 16            // CALL başına yığın (ra; SP 16'ya hizalı kalmalı)
+
+// Bessambly kaydedicilerine atanan makine kaydedicileri (tercih sırasıyla): önce sıkıştırılmış
+// komutların adreslediği x8-x15, RV64I'de ardından C çağrılarında korunan x18-x25
+static const RiscvRegister riscv_allocatable[IR_NUM_REGISTERS] = {
+    RISCV_X8,  RISCV_X9,  RISCV_X10, RISCV_X11, RISCV_X12, RISCV_X13, RISCV_X14, RISCV_X15,
+    RISCV_X18, RISCV_X19, RISCV_X20, RISCV_X21, RISCV_X22, RISCV_X23, RISCV_X24, RISCV_X25,
+};
+#define RISCV_EMBEDDED_ALLOCATABLE 8        // RV64E: sadece x8-x15
+
+#define RISCV_LINUX_SYS_WRITE 64
+#define RISCV_LINUX_SYS_EXIT_GROUP 94
+#define RISCV_BESSAMBLY_SYS_EXIT 60         // Bessambly (Linux x86-64) numaraları
+#define RISCV_BESSAMBLY_SYS_EXIT_GROUP 231
+
+// ELF e_flags
+#define RISCV_EF_RVC 0x1
+#define RISCV_EF_FLOAT_ABI_DOUBLE 0x4       // Kod kayan nokta kullanmaz; lp64d C kütüphanesiyle bağlanabilsin
+#define RISCV_EF_RVE 0x8
+
+// IrCondition sırasıyla (EQ, NE, LT, GT, LE, GE) dal türü; 'swap' ise işlenenler yer değiştirir
+typedef struct {
+    RiscvBranchCondition cond;
+    int swap;
+} RiscvConditionMapping;
+
+static const RiscvConditionMapping riscv_conditions[] = {
+    {RISCV_BEQ, 0}, {RISCV_BNE, 0}, {RISCV_BLT, 0}, {RISCV_BLT, 1}, {RISCV_BGE, 1}, {RISCV_BGE, 0},
+};
+
+// Dal türünün tersi: beq/bne, blt/bge ve bltu/bgeu çiftleri funct3'te son bitle ayrılır
+#define RISCV_INVERSE(cond) ((RiscvBranchCondition)((cond) ^ 1))
+
+// --- Çalışma Zamanı Durumu (.bss) ---
+typedef struct {
+    int64_t registers[IR_NUM_REGISTERS]; // Bellekteki (RV64E) ve çağrılarda saklanan kaydediciler
+    int64_t flags[2];                   // RV64E: son karşılaştırmanın iki tarafı
+    uint64_t stack_limit;               // RV64E: CALL, SP bu adrese inerse taşar
+    uint64_t* counters;                 // PROFCNT sayaçları (__bsm_prof_thread_init)
+    int64_t print_args[RISCV_MAX_PRINT_ARGS];
+} RiscvNativeState;
+
+// Sembol başvurularının numaraları (bkz. riscv_la)
+enum { RISCV_SYMBOL_STATE = 1, RISCV_SYMBOL_RODATA = 2 };
+
+#define RISCV_STATE_SYMBOL "__bsm_state"
+#define RISCV_RODATA_SYMBOL "__bsm_rodata"
+#define RISCV_ENTRY_SYMBOL "_start"
+#define RISCV_INSTRUMENTED_ENTRY_SYMBOL "main" // C kütüphanesiyle bağlanır (çalışma zamanı atexit kullanır)
+#define RISCV_STATE_OFFSET(field) ((int32_t)offsetof(RiscvNativeState, field))
+
+// --- Komut Seçim Kalıpları (bkz. isel.h) ---
+enum {
+    RISCV_RULE_DEFAULT = ISEL_RULE_DEFAULT,
+    RISCV_RULE_THREE_ADDRESS,   // Katılan MOV'un kaynağı ilk kaynak olur: add/sub/mul rd, rs1, rs2
+    RISCV_RULE_SHIFT,           // x * 2^k -> slli rd, rs1, k
+};
+
+static int riscv_is_power_of_two(int64_t value) { return value > 0 && (value & (value - 1)) == 0; }
+
+static uint32_t riscv_log2(int64_t value) {
+    uint32_t shift = 0;
+    while (((uint64_t)1 << shift) < (uint64_t)value) shift++;
+    return shift;
+}
+
+static int riscv_shift_applies(void* target, const IrInstr* root, const IselOperand* leaves) {
+    (void)target;
+    (void)root;
+    return riscv_is_power_of_two(leaves[1].imm);
+}
+
+// Maliyet: komut sayısı; mul gecikmesi için 3, sabitle çarpmada sabitin yüklenmesi için +1
+static const IselPattern riscv_patterns[] = {
+    {RISCV_RULE_DEFAULT, "MOV(reg)", 1, NULL},
+    {RISCV_RULE_DEFAULT, "MOV(imm)", 1, NULL},
+    {RISCV_RULE_DEFAULT, "ADD(reg, reg)", 1, NULL},
+    {RISCV_RULE_DEFAULT, "ADD(reg, imm)", 1, NULL},
+    {RISCV_RULE_DEFAULT, "SUB(reg, reg)", 1, NULL},
+    {RISCV_RULE_DEFAULT, "SUB(reg, imm)", 1, NULL},
+    {RISCV_RULE_DEFAULT, "MUL(reg, reg)", 3, NULL},
+    {RISCV_RULE_DEFAULT, "MUL(reg, imm)", 4, NULL},
+    {RISCV_RULE_THREE_ADDRESS, "ADD(MOV(reg), reg)", 1, NULL},
+    {RISCV_RULE_THREE_ADDRESS, "ADD(MOV(reg), imm)", 1, NULL},
+    {RISCV_RULE_THREE_ADDRESS, "SUB(MOV(reg), reg)", 1, NULL},
+    {RISCV_RULE_THREE_ADDRESS, "SUB(MOV(reg), imm)", 1, NULL},
+    {RISCV_RULE_THREE_ADDRESS, "MUL(MOV(reg), reg)", 3, NULL},
+    {RISCV_RULE_THREE_ADDRESS, "MUL(MOV(reg), imm)", 4, NULL},
+    {RISCV_RULE_SHIFT, "MUL(reg, imm)", 1, riscv_shift_applies},
+    {RISCV_RULE_SHIFT, "MUL(MOV(reg), imm)", 1, riscv_shift_applies},
+};
+
+// --- Üretici Durumu ---
+
+// Blok dallarının biçimleri (kısadan uzuna)
+typedef enum {
+    RISCV_FORM_COMPRESSED,  // c.j, c.beqz, c.bnez
+    RISCV_FORM_NORMAL,      // jal, B türü dallar
+    RISCV_FORM_LONG         // Ters koşullu dal + jal
+} RiscvBranchForm;
+
+typedef struct {
+    size_t position;        // Dal komutunun konumu
+    uint32_t block;         // Hedef blok
+    uint8_t form;           // RiscvBranchForm
+    uint8_t max_form;       // Erişimi yetmezse uzatılabileceği en uzun biçim
+} RiscvFixup;
+
+typedef struct {
+    size_t position;        // Hata dalının (jal) konumu
+    int32_t reason;         // JitExitReason
+    int32_t line;
+} RiscvColdStub;
+
+typedef struct {
+    size_t position;        // Tablo adresini yükleyen auipc'nin konumu (ardından addi gelir)
+    uint32_t table;         // IrJumpTable indeksi
+} RiscvTableRef;
+
+typedef struct {
+    size_t position;        // Çağrının (auipc veya jal) konumu
+    const char* symbol;     // Çalışma zamanı fonksiyonu; NULL ise koddaki print yordamı
+} RiscvRuntimeCall;
+
+typedef struct {
+    const IrFunction* fn;
+    RiscvBuffer* out;
+    ObjectFile* obj;
+    int embedded;               // RV64E: x0-x15
+    RiscvRegister registers[IR_NUM_REGISTERS]; // Ev: makine kaydedicisi veya RISCV_X0 (bellekte)
+    RiscvRegister locations[IR_NUM_REGISTERS]; // Yazılan komutta: ev veya blok içi parçanın kaydedicisi
+    uint32_t active_pieces[IR_NUM_REGISTERS];  // Kaydedici başına açık parça (yoksa UINT32_MAX)
+    size_t num_machine_registers;
+    RiscvRegister state;        // Durum adresi (x26 veya x7)
+    RiscvRegister stack_limit;  // x27 veya RISCV_X0 (.bss'te)
+    RiscvRegister flag_registers[2]; // x28/x29 veya RISCV_X0 (.bss'te)
+    RiscvRegister syscall_number; // a7 veya t0
+    uint32_t* flag_def;         // Bayrak değeri başına: tanımlayan komutun indeksi
+    uint8_t* fused;             // Bayrak değeri başına: 1 ise yazılmaz, okuyan kaydedicileri karşılaştırır
+    IselMatcher matcher;        // riscv_patterns'ın derlenmiş hali
+    IselSelection selection;    // Komut başına seçilen kalıplar (geçişler boyunca sabit)
+    RegAllocation allocation;   // Evler, blok içi parçalar ve yeniden üretilen sabitler
+    size_t* block_offsets;
+    RiscvFixup* fixups;
+    size_t num_fixups;
+    size_t fixup_capacity;
+    uint8_t* relaxed;           // Düzeltme sırası başına: önceki geçişlerde gereken en kısa biçim
+    size_t relaxed_capacity;
+    RiscvColdStub* stubs;
+    size_t num_stubs;
+    size_t stub_capacity;
+    RiscvTableRef* tables;
+    size_t num_tables;
+    size_t table_capacity;
+    RiscvRuntimeCall* runtime_calls;
+    size_t num_runtime_calls;
+    size_t runtime_call_capacity;
+    size_t leave;               // Çıkış kodunun konumu
+    size_t blocks_end;          // Blokların kodunun sonu (soğuk kodlar ve print yordamı ardından gelir)
+    SchedStats schedule;        // Makine kodu zamanlamasının yeniden sıraladığı bölgeler
+    int out_of_memory;
+
+    int rodata;                 // .rodata bölümü (mesajlar; atlama tabloları sonradan eklenir)
+    int instrumented;           // Program PROFCNT/PROFDUMP içeriyorsa 1
+    uint64_t profile_checksum;
+    uint64_t num_counters;
+    uint64_t profile_path;      // Yolun .rodata'daki konumu
+} RiscvCodegen;
+
+static int riscv_grow(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (!grown) return 0;
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+static void riscv_add_fixup(RiscvCodegen* cg, size_t position, uint32_t block, RiscvBranchForm form,
+                            RiscvBranchForm max_form) {
+    if (!riscv_grow((void**)&cg->fixups, &cg->fixup_capacity, cg->num_fixups + 1, sizeof(RiscvFixup))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->fixups[cg->num_fixups].position = position;
+    cg->fixups[cg->num_fixups].block = block;
+    cg->fixups[cg->num_fixups].form = (uint8_t)form;
+    cg->fixups[cg->num_fixups].max_form = (uint8_t)max_form;
+    cg->num_fixups++;
+}
+
+/**
+ * @brief Düzeltmenin sonraki geçişlerde en az 'form' biçiminde yazılmasını sağlar.
+ */
+static void riscv_relax(RiscvCodegen* cg, size_t fixup, RiscvBranchForm form) {
+    size_t old_capacity = cg->relaxed_capacity;
+    if (!riscv_grow((void**)&cg->relaxed, &cg->relaxed_capacity, fixup + 1, 1)) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    memset(cg->relaxed + old_capacity, 0, cg->relaxed_capacity - old_capacity);
+    cg->relaxed[fixup] = (uint8_t)form;
+}
+
+/**
+ * @brief Sıradaki blok dalının biçimi: önceki geçişlerin gerektirdiği ve 'shortest'tan kısa olmayan
+ * en kısa biçim. Hedefi önceden yerleştirilmiş geri dallarda uzaklık zaten bellidir.
+ */
+static RiscvBranchForm riscv_branch_form(RiscvCodegen* cg, uint32_t block, RiscvBranchForm shortest,
+                                         int64_t compressed_range, int64_t normal_range) {
+    RiscvBranchForm form = shortest;
+    if (cg->num_fixups < cg->relaxed_capacity && cg->relaxed[cg->num_fixups] > form) {
+        form = (RiscvBranchForm)cg->relaxed[cg->num_fixups];
+    }
+    size_t target = cg->block_offsets[block];
+    if (target != SIZE_MAX) {
+        int64_t distance = (int64_t)target - (int64_t)cg->out->size;
+        if (form == RISCV_FORM_COMPRESSED && distance < -compressed_range) form = RISCV_FORM_NORMAL;
+        if (form == RISCV_FORM_NORMAL && distance < -normal_range) form = RISCV_FORM_LONG;
+    }
+    return form;
+}
+
+static void riscv_add_stub(RiscvCodegen* cg, size_t position, JitExitReason reason, int32_t line) {
+    if (!riscv_grow((void**)&cg->stubs, &cg->stub_capacity, cg->num_stubs + 1, sizeof(RiscvColdStub))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->stubs[cg->num_stubs].position = position;
+    cg->stubs[cg->num_stubs].reason = reason;
+    cg->stubs[cg->num_stubs].line = line;
+    cg->num_stubs++;
+}
+
+static void riscv_add_table_ref(RiscvCodegen* cg, size_t position, uint32_t table) {
+    if (!riscv_grow((void**)&cg->tables, &cg->table_capacity, cg->num_tables + 1, sizeof(RiscvTableRef))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->tables[cg->num_tables].position = position;
+    cg->tables[cg->num_tables].table = table;
+    cg->num_tables++;
+}
+
+static void riscv_add_runtime_call(RiscvCodegen* cg, size_t position, const char* symbol) {
+    if (!riscv_grow((void**)&cg->runtime_calls, &cg->runtime_call_capacity, cg->num_runtime_calls + 1,
+                    sizeof(RiscvRuntimeCall))) {
+        cg->out_of_memory = 1;
+        return;
+    }
+    cg->runtime_calls[cg->num_runtime_calls].position = position;
+    cg->runtime_calls[cg->num_runtime_calls].symbol = symbol;
+    cg->num_runtime_calls++;
+}
+
+// --- Kaydediciler ---
+
+/**
+ * @brief Komutun makine kodunun IR kullanımları dışında okuduğu kaydediciler: kalıba katılan
+ * komutların yaprakları köke kadar, birleştirilmiş bayrakların karşılaştırdığı kaydediciler
+ * okuyan dal/seçime kadar canlı kalmalıdır.
+ */
+static uint32_t riscv_implicit_reads(void* target, size_t index) {
+    RiscvCodegen* cg = (RiscvCodegen*)target;
+    const IrFunction* fn = cg->fn;
+    const IrInstr* instr = &fn->instrs[index];
+    uint32_t reads = 0;
+    uint16_t vregs[ISEL_MAX_LEAVES + 2];
+    size_t count = 0;
+    IselOperand leaves[ISEL_MAX_LEAVES];
+    size_t num_leaves = isel_leaves(&cg->selection, index, leaves);
+    for (size_t k = 0; k < num_leaves; k++) {
+        if (!leaves[k].is_immediate) vregs[count++] = leaves[k].vreg;
+    }
+    if ((instr->opcode == IR_OP_BR || instr->opcode == IR_OP_SEL) && instr->flags >= IR_FIRST_VIRTUAL &&
+        instr->flags < fn->num_vregs && cg->fused[instr->flags]) {
+        const IrInstr* def = &fn->instrs[cg->flag_def[instr->flags]];
+        if (def->opcode == IR_OP_CMP) {
+            vregs[count++] = def->u.op.src1;
+            if (!(def->attrs & IR_ATTR_IMM)) vregs[count++] = def->u.op.src2;
+        } else {
+            vregs[count++] = def->dst;
+        }
+    }
+    for (size_t k = 0; k < count; k++) {
+        int origin = vregs[k] < fn->num_vregs ? fn->vregs[vregs[k]].origin : -1;
+        if (origin >= 0 && origin < IR_NUM_REGISTERS) reads |= 1u << origin;
+    }
+    return reads;
+}
+
+/**
+ * @brief Bessambly kaydedicilerine doğrusal taramayla ev atar (bkz. regalloc.h). Havuz, RV64E'de
+ * x8-x15, RV64I'de riscv_allocatable'ın tamamıdır; ağırlığı yüksek evler sıkıştırılmış komutların
+ * adreslediği x8-x15'i alır. Bayrak çözümlemesinden ve komut seçiminden sonra çağrılır.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int riscv_allocate_registers(RiscvCodegen* cg) {
+    RegAllocTarget target = {cg->embedded ? RISCV_EMBEDDED_ALLOCATABLE : IR_NUM_REGISTERS, cg, riscv_implicit_reads};
+    if (!regalloc_run(cg->fn, &target, &cg->allocation)) return 0;
+    cg->num_machine_registers = 0;
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        int home = cg->allocation.homes[r];
+        cg->registers[r] = home != REGALLOC_MEMORY ? riscv_allocatable[home] : RISCV_X0;
+        cg->num_machine_registers += home != REGALLOC_MEMORY;
+    }
+    return 1;
+}
+
+/**
+ * @brief Sanal kaydedicinin kökeni olan Bessambly kaydedicisini döndürür.
+ * @return Başarılıysa 1; kökeni yoksa 0 (stderr'e açıklama yazılır).
+ */
+static int riscv_origin(RiscvCodegen* cg, uint16_t vreg, int* origin) {
+    *origin = vreg < cg->fn->num_vregs ? cg->fn->vregs[vreg].origin : -1;
+    if (*origin < 0 || *origin >= IR_NUM_REGISTERS) {
+        fprintf(stderr, "Hata: riscv kod üretimi: v%u bir mimari kaydediciye eşlenemiyor.\n", vreg);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Bessambly kaydedicisinin değerini taşıyan makine kaydedicisi: bellekteyse 'scratch'e yüklenir.
+ */
+static RiscvRegister riscv_load(RiscvCodegen* cg, int origin, RiscvRegister scratch) {
+    RiscvRegister reg = cg->locations[origin];
+    if (reg != RISCV_X0) return reg;
+    riscv_ld(cg->out, scratch, cg->state, RISCV_STATE_OFFSET(registers[origin]));
+    return scratch;
+}
+
+/**
+ * @brief Bessambly kaydedicisine yazılacak değerin hedefi: bellekteyse 'scratch' (ardından riscv_store).
+ */
+static RiscvRegister riscv_target(RiscvCodegen* cg, int origin, RiscvRegister scratch) {
+    return cg->locations[origin] != RISCV_X0 ? cg->locations[origin] : scratch;
+}
+
+static void riscv_store(RiscvCodegen* cg, int origin, RiscvRegister value) {
+    if (cg->locations[origin] == RISCV_X0) {
+        riscv_sd(cg->out, value, cg->state, RISCV_STATE_OFFSET(registers[origin]));
+    }
+}
+
+/**
+ * @brief Değer yeniden üretiliyorsa tanımlayan MOV'un sabiti (yoksa 0 döner).
+ */
+static int riscv_rematerialized(RiscvCodegen* cg, uint16_t vreg, int64_t* value) {
+    if (vreg >= cg->fn->num_vregs || cg->allocation.remat[vreg] == REGALLOC_NO_REMAT) return 0;
+    *value = ir_instr_immediate(cg->fn, &cg->fn->instrs[cg->allocation.remat[vreg]]);
+    return 1;
+}
+
+/**
+ * @brief Değeri taşıyan makine kaydedicisi: bellektekiler yüklenir, yeniden üretilen sabitler
+ * 'scratch'e yazılır (0 sabiti x0'dır).
+ */
+static int riscv_source(RiscvCodegen* cg, uint16_t vreg, RiscvRegister scratch, RiscvRegister* reg) {
+    int origin;
+    int64_t value;
+    if (riscv_rematerialized(cg, vreg, &value)) {
+        *reg = value == 0 ? RISCV_X0 : scratch;
+        if (value != 0) riscv_li(cg->out, scratch, value);
+        return 1;
+    }
+    if (!riscv_origin(cg, vreg, &origin)) return 0;
+    *reg = riscv_load(cg, origin, scratch);
+    return 1;
+}
+
+/**
+ * @brief Komutun ilk kaynağı: kalıba katılan MOV'un kaynağı veya komutun kendi ilk kaynağı.
+ */
+static uint16_t riscv_first_source(RiscvCodegen* cg, const IrInstr* instr, int* rule, IselOperand* leaves) {
+    size_t index = (size_t)(instr - cg->fn->instrs);
+    *rule = isel_rule(&cg->selection, index);
+    if (*rule == RISCV_RULE_DEFAULT || isel_leaves(&cg->selection, index, leaves) == 0) {
+        *rule = RISCV_RULE_DEFAULT;
+        return instr->u.op.src1;
+    }
+    return leaves[0].vreg;
+}
+
+/**
+ * @brief "b" kaynağını kaydediciye getirir: 0 sabiti x0'dır, diğer sabitler 'scratch'e yüklenir.
+ */
+static int riscv_second_source(RiscvCodegen* cg, const IrInstr* instr, RiscvRegister scratch, RiscvRegister* source) {
+    if (!(instr->attrs & IR_ATTR_IMM)) return riscv_source(cg, instr->u.op.src2, scratch, source);
+    int64_t value = ir_instr_immediate(cg->fn, instr);
+    if (value == 0) {
+        *source = RISCV_X0;
+        return 1;
+    }
+    riscv_li(cg->out, scratch, value);
+    *source = scratch;
+    return 1;
+}
+
+/**
+ * @brief dst = b (sabit veya kaydedici); kaynak ve hedef bellekte olabilir.
+ */
+static int riscv_emit_move(RiscvCodegen* cg, int dst_origin, const IrInstr* instr) {
+    RiscvRegister dst = riscv_target(cg, dst_origin, RISCV_SCRATCH);
+    if (instr->attrs & IR_ATTR_IMM) {
+        int64_t value = ir_instr_immediate(cg->fn, instr);
+        if (value == 0 && dst == RISCV_SCRATCH) {
+            riscv_store(cg, dst_origin, RISCV_X0);
+            return 1;
+        }
+        riscv_li(cg->out, dst, value);
+    } else {
+        int src_origin;
+        int64_t value;
+        RiscvRegister source;
+        if (!riscv_origin(cg, instr->u.op.src2, &src_origin)) return 0;
+        if (src_origin == dst_origin && !riscv_rematerialized(cg, instr->u.op.src2, &value)) return 1;
+        if (!riscv_source(cg, instr->u.op.src2, dst, &source)) return 0;
+        if (dst == RISCV_SCRATCH) {
+            riscv_store(cg, dst_origin, source);
+            return 1;
+        }
+        riscv_mv(cg->out, dst, source);
+    }
+    riscv_store(cg, dst_origin, dst);
+    return 1;
+}
+
+/**
+ * @brief C çağrısında bozulan (a0-a5) Bessambly kaydedicilerini .bss'e yazar (load = 0) veya
+ * oradan geri okur (load = 1).
+ */
+static void riscv_sync_caller_saved(RiscvCodegen* cg, int load) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        RiscvRegister reg = cg->registers[r];
+        if (reg < RISCV_A0 || reg > RISCV_A5) continue;
+        if (load) {
+            riscv_ld(cg->out, reg, cg->state, RISCV_STATE_OFFSET(registers[r]));
+        } else {
+            riscv_sd(cg->out, reg, cg->state, RISCV_STATE_OFFSET(registers[r]));
+        }
+    }
+}
+
+// --- Sabitler ---
+
+static int riscv_fits_immediate(int64_t value) {
+    return value >= -2048 && value < 2048;
+}
+
+/**
+ * @brief rd = rn + value. 12 bitlik sabit alanına sığmazsa t1'e yüklenir.
+ */
+static void riscv_emit_add_constant(RiscvCodegen* cg, RiscvRegister rd, RiscvRegister rn, int64_t value) {
+    if (riscv_fits_immediate(value)) {
+        riscv_addi(cg->out, rd, rn, (int32_t)value);
+    } else {
+        riscv_li(cg->out, RISCV_SCRATCH2, value);
+        riscv_add(cg->out, rd, rn, RISCV_SCRATCH2);
+    }
+}
+
+// --- Dallar ---
+
+/**
+ * @brief Yerel (kısa) koşullu dal: biri x0 olan ve diğeri x8-x15'te bulunan eşitlik karşılaştırmaları
+ * c.beqz/c.bnez olur. Hedef yakın olmalıdır (riscv_patch_branch ile yazılır).
+ * @return Dalın konumu.
+ */
+static size_t riscv_emit_short_branch(RiscvCodegen* cg, RiscvBranchCondition cond, RiscvRegister rs1,
+                                      RiscvRegister rs2) {
+    if (cg->out->compressed && (cond == RISCV_BEQ || cond == RISCV_BNE)) {
+        RiscvRegister tested = rs2 == RISCV_X0 ? rs1 : rs1 == RISCV_X0 ? rs2 : RISCV_X0;
+        if (RISCV_IS_COMPRESSIBLE_REGISTER(tested)) {
+            return cond == RISCV_BEQ ? riscv_c_beqz(cg->out, tested) : riscv_c_bnez(cg->out, tested);
+        }
+    }
+    return riscv_branch(cg->out, cond, rs1, rs2);
+}
+
+static int riscv_short_branch_is_compressed(RiscvCodegen* cg, RiscvBranchCondition cond, RiscvRegister rs1,
+                                            RiscvRegister rs2) {
+    if (!cg->out->compressed || (cond != RISCV_BEQ && cond != RISCV_BNE)) return 0;
+    return (rs2 == RISCV_X0 && RISCV_IS_COMPRESSIBLE_REGISTER(rs1)) ||
+           (rs1 == RISCV_X0 && RISCV_IS_COMPRESSIBLE_REGISTER(rs2));
+}
+
+/**
+ * @brief Bloğa koşulsuz atlama: c.j (±2 KB) veya jal (±1 MB).
+ */
+static void riscv_emit_jump(RiscvCodegen* cg, uint32_t block) {
+    RiscvBranchForm shortest = cg->out->compressed ? RISCV_FORM_COMPRESSED : RISCV_FORM_NORMAL;
+    RiscvBranchForm form = riscv_branch_form(cg, block, shortest, RISCV_C_JUMP_RANGE, RISCV_JUMP_RANGE);
+    if (form == RISCV_FORM_COMPRESSED) {
+        riscv_add_fixup(cg, riscv_c_j(cg->out), block, form, RISCV_FORM_NORMAL);
+    } else {
+        riscv_add_fixup(cg, riscv_jal(cg->out, RISCV_X0), block, RISCV_FORM_NORMAL, RISCV_FORM_NORMAL);
+    }
+}
+
+/**
+ * @brief Bloğa koşullu dal: c.beqz/c.bnez (±256 B), B türü dal (±4 KB) veya ters koşullu dalın
+ * üzerinden atladığı jal (±1 MB).
+ */
+static void riscv_emit_branch(RiscvCodegen* cg, RiscvBranchCondition cond, RiscvRegister rs1, RiscvRegister rs2,
+                              uint32_t block) {
+    RiscvBuffer* out = cg->out;
+    RiscvBranchForm shortest = riscv_short_branch_is_compressed(cg, cond, rs1, rs2) ? RISCV_FORM_COMPRESSED
+                                                                                    : RISCV_FORM_NORMAL;
+    RiscvBranchForm form = riscv_branch_form(cg, block, shortest, RISCV_C_BRANCH_RANGE, RISCV_BRANCH_RANGE);
+    if (form == RISCV_FORM_COMPRESSED) {
+        riscv_add_fixup(cg, riscv_emit_short_branch(cg, cond, rs1, rs2), block, form, RISCV_FORM_LONG);
+    } else if (form == RISCV_FORM_NORMAL) {
+        riscv_add_fixup(cg, riscv_branch(out, cond, rs1, rs2), block, form, RISCV_FORM_LONG);
+    } else {
+        size_t skip = riscv_emit_short_branch(cg, RISCV_INVERSE(cond), rs1, rs2);
+        riscv_add_fixup(cg, riscv_jal(out, RISCV_X0), block, form, RISCV_FORM_LONG);
+        riscv_patch_branch(out, skip, out->size);
+    }
+}
+
+/**
+ * @brief Yerel ileri atlama (SELcc'nin kolları arasında).
+ */
+static size_t riscv_emit_short_jump(RiscvCodegen* cg) {
+    return cg->out->compressed ? riscv_c_j(cg->out) : riscv_jal(cg->out, RISCV_X0);
+}
+
+// --- Bayraklar ---
+
+/**
+ * @brief Bayrak değerlerinin nasıl taşınacağını belirler. Blok yerel bir değer okunana kadar
+ * karşılaştırılan Bessambly kaydedicileri yeniden yazılmıyorsa "birleştirilir": tanımlayan komut
+ * değeri yazmaz, okuyan dal/seçim kaydedicileri doğrudan karşılaştırır.
+ */
+static void riscv_analyze_flags(RiscvCodegen* cg) {
+    const IrFunction* fn = cg->fn;
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        size_t end = (size_t)block->first + block->num_instrs;
+        for (size_t i = block->first; i < end; i++) {
+            const IrInstr* instr = &fn->instrs[i];
+            uint16_t flags = instr->flags;
+            int defines = instr->opcode == IR_OP_CMP ||
+                          ((instr->opcode == IR_OP_ADD || instr->opcode == IR_OP_SUB) &&
+                           !(instr->attrs & IR_ATTR_FLAGS_CLOBBER));
+            if (!defines || flags < IR_FIRST_VIRTUAL || flags >= fn->num_vregs) continue;
+            cg->flag_def[flags] = (uint32_t)i;
+
+            // Karşılaştırılan kaydedicilerin kökenleri (ADD/SUB: sonuç ile 0)
+            int compared[2] = {-1, -1};
+            uint16_t first = instr->opcode == IR_OP_CMP ? instr->u.op.src1 : instr->dst;
+            if (first < fn->num_vregs) compared[0] = fn->vregs[first].origin;
+            if (instr->opcode == IR_OP_CMP && !(instr->attrs & IR_ATTR_IMM) && instr->u.op.src2 < fn->num_vregs) {
+                compared[1] = fn->vregs[instr->u.op.src2].origin;
+            }
+            size_t last_reader = i;
+            for (size_t j = i + 1; j < end; j++) {
+                const IrInstr* reader = &fn->instrs[j];
+                if ((reader->opcode == IR_OP_BR || reader->opcode == IR_OP_SEL) && reader->flags == flags) {
+                    last_reader = j;
+                }
+            }
+            int fusable = 1;
+            for (size_t j = i + 1; j < last_reader && fusable; j++) {
+                const IrInstr* other = &fn->instrs[j];
+                if (other->opcode == IR_OP_CALL || other->opcode == IR_OP_SYSCALL) fusable = 0;
+                if (other->dst < fn->num_vregs) {
+                    int origin = fn->vregs[other->dst].origin;
+                    if (origin == compared[0] || origin == compared[1]) fusable = 0;
+                }
+            }
+            cg->fused[flags] = (uint8_t)fusable;
+        }
+    }
+}
+
+/**
+ * @brief Bayrak değerini (karşılaştırmanın iki tarafı) x28/x29'a veya .bss'e yazar.
+ */
+static int riscv_emit_flags(RiscvCodegen* cg, const IrInstr* instr) {
+    RiscvBuffer* out = cg->out;
+    RiscvRegister a, b = RISCV_X0;
+    if (instr->opcode == IR_OP_CMP) {
+        if (!riscv_source(cg, instr->u.op.src1, RISCV_SCRATCH, &a) ||
+            !riscv_second_source(cg, instr, RISCV_SCRATCH2, &b)) {
+            return 0;
+        }
+    } else if (!riscv_source(cg, instr->dst, RISCV_SCRATCH, &a)) {
+        return 0;
+    }
+    if (cg->flag_registers[0] != RISCV_X0) {
+        riscv_mv(out, cg->flag_registers[0], a);
+        riscv_mv(out, cg->flag_registers[1], b);
+    } else {
+        riscv_sd(out, a, cg->state, RISCV_STATE_OFFSET(flags[0]));
+        riscv_sd(out, b, cg->state, RISCV_STATE_OFFSET(flags[1]));
+    }
+    return 1;
+}
+
+/**
+ * @brief Bayrak değeri okuyan komut için karşılaştırılacak iki kaydediciyi hazırlar (birleştirilmiş
+ * değerlerde tanımlayan komutun kaynakları; bellektekiler ve sabitler t0/t1'e yüklenir).
+ */
+static int riscv_flag_operands(RiscvCodegen* cg, uint16_t flags, RiscvRegister* a, RiscvRegister* b) {
+    if (flags >= IR_FIRST_VIRTUAL && flags < cg->fn->num_vregs && cg->fused[flags]) {
+        const IrInstr* def = &cg->fn->instrs[cg->flag_def[flags]];
+        if (def->opcode == IR_OP_CMP) {
+            return riscv_source(cg, def->u.op.src1, RISCV_SCRATCH, a) &&
+                   riscv_second_source(cg, def, RISCV_SCRATCH2, b);
+        }
+        *b = RISCV_X0;
+        return riscv_source(cg, def->dst, RISCV_SCRATCH, a);
+    }
+    if (cg->flag_registers[0] != RISCV_X0) {
+        *a = cg->flag_registers[0];
+        *b = cg->flag_registers[1];
+    } else {
+        riscv_ld(cg->out, RISCV_SCRATCH, cg->state, RISCV_STATE_OFFSET(flags[0]));
+        riscv_ld(cg->out, RISCV_SCRATCH2, cg->state, RISCV_STATE_OFFSET(flags[1]));
+        *a = RISCV_SCRATCH;
+        *b = RISCV_SCRATCH2;
+    }
+    return 1;
+}
+
+/**
+ * @brief Bayrak tanımı yazılmalı mı? Mimari bayrak değeri (bloklar arasında taşınır) ve
+ * birleştirilemeyen blok yerel değerler yazılır.
+ */
+static int riscv_flags_materialized(RiscvCodegen* cg, const IrInstr* instr) {
+    if (instr->flags == IR_NO_VREG || (instr->attrs & IR_ATTR_FLAGS_CLOBBER)) return 0;
+    if (instr->flags < IR_FIRST_VIRTUAL || instr->flags >= cg->fn->num_vregs) return 1;
+    return !cg->fused[instr->flags];
+}
+
+// --- Komutlar ---
+
+/**
+ * @brief Çalışma zamanı fonksiyonunu veya print yordamını (symbol NULL) çağırır. ra, CALL'un
+ * dönüş adresini tutabileceği için yığında saklanır; C fonksiyonları için a0-a5 .bss'e yazılır
+ * (print yordamı kullandığı kaydedicileri kendisi saklar). RV64E'de durum adresi (t2) C
+ * çağrısında bozulduğu için yeniden yüklenir.
+ */
+static void riscv_emit_runtime_call(RiscvCodegen* cg, const char* symbol) {
+    RiscvBuffer* out = cg->out;
+    if (symbol) riscv_sync_caller_saved(cg, 0);
+    riscv_addi(out, RISCV_SP, RISCV_SP, -RISCV_CALL_FRAME_SIZE);
+    riscv_sd(out, RISCV_RA, RISCV_SP, 0);
+    riscv_add_runtime_call(cg, symbol ? riscv_call(out) : riscv_jal(out, RISCV_RA), symbol);
+    riscv_ld(out, RISCV_RA, RISCV_SP, 0);
+    riscv_addi(out, RISCV_SP, RISCV_SP, RISCV_CALL_FRAME_SIZE);
+    if (!symbol) return;
+    if (cg->embedded) riscv_la(out, cg->state, RISCV_SYMBOL_STATE, 0);
+    riscv_sync_caller_saved(cg, 1);
+}
+
+/**
+ * @brief print çağrısı: argümanlar .bss'e kopyalanır ve print yordamı argüman sayısıyla (t0) çağrılır.
+ */
+static int riscv_emit_print_call(RiscvCodegen* cg, const IrSyscall* syscall) {
+    if (syscall->num_args > RISCV_MAX_PRINT_ARGS) {
+        fprintf(stderr, "Hata: riscv kod üretimi: print çağrısı en fazla %d argüman alabilir.\n", RISCV_MAX_PRINT_ARGS);
+        return 0;
+    }
+    for (uint32_t a = 0; a < syscall->num_args; a++) {
+        int reg = cg->fn->pool[syscall->first_arg + a] & 0x0f;
+        riscv_sd(cg->out, riscv_load(cg, reg, RISCV_SCRATCH), cg->state, RISCV_STATE_OFFSET(print_args[a]));
+    }
+    riscv_li(cg->out, RISCV_T0, syscall->num_args);
+    riscv_emit_runtime_call(cg, NULL);
+    return 1;
+}
+
+/**
+ * @brief SYSCALL'u Linux RISC-V sistem çağrısı ABI'sine indirger (bkz. riscv_codegen.h). Argüman
+ * kaydedicilerine (a0-a5) atanmış Bessambly kaydedicileri önce .bss'e yazılır; argümanlar bu
+ * kopyalardan okunduğu için atamaların sırası önemsizdir.
+ */
+static int riscv_emit_linux_syscall(RiscvCodegen* cg, const IrInstr* instr) {
+    RiscvBuffer* out = cg->out;
+    const IrSyscall* syscall = &cg->fn->syscalls[instr->u.op.imm];
+    if (syscall->number == RISCV_HYPERCALL_PRINT) return riscv_emit_print_call(cg, syscall);
+    if (syscall->num_args > RISCV_LINUX_MAX_SYSCALL_ARGS) {
+        fprintf(stderr, "Hata: riscv kod üretimi: Linux sistem çağrısı en fazla %d argüman alabilir "
+                        "(%lld numaralı çağrıda %u).\n",
+                RISCV_LINUX_MAX_SYSCALL_ARGS, (long long)syscall->number, syscall->num_args);
+        return 0;
+    }
+    int64_t number = target_linux_syscall_number(cg->obj->arch, syscall->number);
+    if (number < 0) {
+        fprintf(stderr, "Hata: riscv kod üretimi: %lld numaralı sistem çağrısının RISC-V Linux karşılığı "
+                        "bilinmiyor.\n",
+                (long long)syscall->number);
+        return 0;
+    }
+    int is_exit = syscall->number == RISCV_BESSAMBLY_SYS_EXIT || syscall->number == RISCV_BESSAMBLY_SYS_EXIT_GROUP;
+    uint32_t num_args = syscall->num_args;
+    int arguments[RISCV_LINUX_MAX_SYSCALL_ARGS] = {0}; // Argsız exit/exit_group R0'ı kullanır (BVM ile aynı)
+    for (uint32_t a = 0; a < num_args; a++) arguments[a] = cg->fn->pool[syscall->first_arg + a] & 0x0f;
+    if (num_args == 0 && is_exit) num_args = 1;
+
+    // a0 dönüş değerini de taşıdığı için en az a0 bozulur
+    RiscvRegister clobbered_end = (RiscvRegister)(RISCV_A0 + (num_args ? num_args : 1));
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        RiscvRegister reg = cg->registers[r];
+        if (reg >= RISCV_A0 && reg < clobbered_end) riscv_sd(out, reg, cg->state, RISCV_STATE_OFFSET(registers[r]));
+    }
+    for (uint32_t a = 0; a < num_args; a++) {
+        RiscvRegister reg = cg->registers[arguments[a]];
+        RiscvRegister argument = (RiscvRegister)(RISCV_A0 + a);
+        if (reg == RISCV_X0 || (reg >= RISCV_A0 && reg < clobbered_end)) {
+            riscv_ld(out, argument, cg->state, RISCV_STATE_OFFSET(registers[arguments[a]]));
+        } else {
+            riscv_mv(out, argument, reg);
+        }
+    }
+    riscv_li(out, cg->syscall_number, number);
+    riscv_ecall(out);
+    if (is_exit) return 1;
+
+    // Dönüş değeri R0'a; diğer bozulan kaydediciler .bss'ten geri okunur
+    riscv_mv(out, RISCV_SCRATCH2, RISCV_A0);
+    for (int r = 1; r < IR_NUM_REGISTERS; r++) {
+        RiscvRegister reg = cg->registers[r];
+        if (reg >= RISCV_A0 && reg < clobbered_end) riscv_ld(out, reg, cg->state, RISCV_STATE_OFFSET(registers[r]));
+    }
+    RiscvRegister result = riscv_target(cg, 0, RISCV_SCRATCH2);
+    riscv_mv(out, result, RISCV_SCRATCH2);
+    riscv_store(cg, 0, result);
+    return 1;
+}
+
+static int riscv_emit_jump_table(RiscvCodegen* cg, const IrInstr* instr) {
+    RiscvBuffer* out = cg->out;
+    const IrJumpTable* table = &cg->fn->jump_tables[instr->u.op.imm];
+    RiscvRegister index;
+    if (!riscv_source(cg, instr->u.op.src1, RISCV_SCRATCH, &index)) return 0;
+    if (table->num_targets > INT32_MAX) {
+        fprintf(stderr, "Hata: riscv kod üretimi: atlama tablosu çok büyük (%u giriş).\n", table->num_targets);
+        return 0;
+    }
+    if (table->num_targets == 0) {
+        riscv_emit_jump(cg, table->default_block);
+        return 1;
+    }
+    if (table->min != 0) {
+        riscv_emit_add_constant(cg, RISCV_SCRATCH, index, (int64_t)(0 - (uint64_t)table->min));
+        index = RISCV_SCRATCH;
+    }
+    // İşaretsiz karşılaştırma aralığın iki yanını birden denetler
+    riscv_li(out, RISCV_SCRATCH2, table->num_targets);
+    riscv_emit_branch(cg, RISCV_BGEU, index, RISCV_SCRATCH2, table->default_block);
+    riscv_add_table_ref(cg, out->size, (uint32_t)instr->u.op.imm);
+    riscv_la(out, RISCV_SCRATCH2, 0, 0); // Yeniden konumlandırmalar tablo sembolüne (riscv_emit_object_tables)
+    riscv_slli(out, RISCV_SCRATCH, index, 2);
+    riscv_add(out, RISCV_SCRATCH, RISCV_SCRATCH, RISCV_SCRATCH2);
+    riscv_lw(out, RISCV_SCRATCH, RISCV_SCRATCH, 0);
+    riscv_add(out, RISCV_SCRATCH, RISCV_SCRATCH, RISCV_SCRATCH2);
+    riscv_jalr(out, RISCV_X0, RISCV_SCRATCH, 0);
+    return 1;
+}
+
+/**
+ * @brief SELcc: dst = koşul ? b : src1. Hedef src1 ile aynı kaydediciyse tek kollu bir daldır.
+ */
+static int riscv_emit_select(RiscvCodegen* cg, const IrInstr* instr) {
+    RiscvRegister a, b;
+    int dst_origin, src_origin;
+    if (!riscv_origin(cg, instr->dst, &dst_origin) || !riscv_origin(cg, instr->u.op.src1, &src_origin) ||
+        !riscv_flag_operands(cg, instr->flags, &a, &b)) {
+        return 0;
+    }
+    RiscvConditionMapping mapping = riscv_conditions[instr->cond];
+    RiscvRegister rs1 = mapping.swap ? b : a;
+    RiscvRegister rs2 = mapping.swap ? a : b;
+    if (dst_origin == src_origin) {
+        size_t skip = riscv_emit_short_branch(cg, RISCV_INVERSE(mapping.cond), rs1, rs2);
+        if (!riscv_emit_move(cg, dst_origin, instr)) return 0;
+        riscv_patch_branch(cg->out, skip, cg->out->size);
+        return 1;
+    }
+    size_t taken = riscv_emit_short_branch(cg, mapping.cond, rs1, rs2);
+    IrInstr keep = *instr; // dst = src1
+    keep.attrs &= (uint8_t)~IR_ATTR_IMM;
+    keep.u.op.src2 = instr->u.op.src1;
+    if (!riscv_emit_move(cg, dst_origin, &keep)) return 0;
+    size_t done = riscv_emit_short_jump(cg);
+    riscv_patch_branch(cg->out, taken, cg->out->size);
+    if (!riscv_emit_move(cg, dst_origin, instr)) return 0;
+    riscv_patch_branch(cg->out, done, cg->out->size);
+    return 1;
+}
+
+/**
+ * @brief Bir IR komutunu makine koduna çevirir.
+ * @param next Yerleşimde bir sonraki blok (yoksa IR_NO_BLOCK); ona giden atlamalar atlanır.
+ */
+static int riscv_emit_instruction(RiscvCodegen* cg, const IrInstr* instr, int32_t line, uint32_t next) {
+    RiscvBuffer* out = cg->out;
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    RiscvRegister dst, first, source;
+    int dst_origin;
+    switch (opcode) {
+        case IR_OP_MOV: {
+            int64_t value;
+            if (riscv_rematerialized(cg, instr->dst, &value)) return 1; // Okunduğu yerde yüklenir
+            return riscv_origin(cg, instr->dst, &dst_origin) && riscv_emit_move(cg, dst_origin, instr);
+        }
+        case IR_OP_ADD:
+        case IR_OP_SUB: {
+            IselOperand leaves[ISEL_MAX_LEAVES];
+            int rule;
+            uint16_t src1 = riscv_first_source(cg, instr, &rule, leaves);
+            if (!riscv_origin(cg, instr->dst, &dst_origin) || !riscv_source(cg, src1, RISCV_SCRATCH, &first)) {
+                return 0;
+            }
+            dst = riscv_target(cg, dst_origin, RISCV_SCRATCH);
+            if (instr->attrs & IR_ATTR_IMM) {
+                int64_t value = ir_instr_immediate(cg->fn, instr);
+                riscv_emit_add_constant(cg, dst, first, opcode == IR_OP_ADD ? value : (int64_t)(0 - (uint64_t)value));
+            } else {
+                if (!riscv_source(cg, instr->u.op.src2, RISCV_SCRATCH2, &source)) return 0;
+                if (opcode == IR_OP_ADD) {
+                    riscv_add(out, dst, first, source);
+                } else {
+                    riscv_sub(out, dst, first, source);
+                }
+            }
+            riscv_store(cg, dst_origin, dst);
+            // Bayraklar (sonuç, 0) karşılaştırmasıdır
+            return !riscv_flags_materialized(cg, instr) || riscv_emit_flags(cg, instr);
+        }
+        case IR_OP_CMP:
+            return !riscv_flags_materialized(cg, instr) || riscv_emit_flags(cg, instr);
+        case IR_OP_MUL:
+        case IR_OP_DIV: {
+            IselOperand leaves[ISEL_MAX_LEAVES];
+            int rule;
+            uint16_t src1 = riscv_first_source(cg, instr, &rule, leaves);
+            if (!riscv_origin(cg, instr->dst, &dst_origin) || !riscv_source(cg, src1, RISCV_SCRATCH, &first)) {
+                return 0;
+            }
+            if (rule == RISCV_RULE_SHIFT) {
+                dst = riscv_target(cg, dst_origin, RISCV_SCRATCH);
+                riscv_slli(out, dst, first, riscv_log2(leaves[1].imm));
+                riscv_store(cg, dst_origin, dst);
+                return 1;
+            }
+            if (opcode == IR_OP_DIV && (instr->attrs & IR_ATTR_IMM) && ir_instr_immediate(cg->fn, instr) == 0) {
+                riscv_add_stub(cg, riscv_jal(out, RISCV_X0), JIT_EXIT_DIVIDE_BY_ZERO, line);
+                return 1;
+            }
+            if (!riscv_second_source(cg, instr, RISCV_SCRATCH2, &source)) return 0;
+            dst = riscv_target(cg, dst_origin, RISCV_SCRATCH);
+            if (opcode == IR_OP_MUL) {
+                riscv_mul(out, dst, first, source);
+            } else {
+                if (!(instr->attrs & IR_ATTR_IMM)) {
+                    size_t skip = riscv_emit_short_branch(cg, RISCV_BNE, source, RISCV_X0);
+                    riscv_add_stub(cg, riscv_jal(out, RISCV_X0), JIT_EXIT_DIVIDE_BY_ZERO, line);
+                    riscv_patch_branch(out, skip, out->size);
+                }
+                riscv_div(out, dst, first, source);
+            }
+            riscv_store(cg, dst_origin, dst);
+            return 1;
+        }
+        case IR_OP_SEL:
+            return riscv_emit_select(cg, instr);
+        case IR_OP_CALL: {
+            RiscvRegister limit = cg->stack_limit;
+            if (limit == RISCV_X0) {
+                riscv_ld(out, RISCV_SCRATCH, cg->state, RISCV_STATE_OFFSET(stack_limit));
+                limit = RISCV_SCRATCH;
+            }
+            size_t skip = riscv_branch(out, RISCV_BLTU, limit, RISCV_SP);
+            riscv_add_stub(cg, riscv_jal(out, RISCV_X0), JIT_EXIT_CALL_OVERFLOW, line);
+            riscv_patch_branch(out, skip, out->size);
+            riscv_addi(out, RISCV_SP, RISCV_SP, -RISCV_CALL_FRAME_SIZE);
+            riscv_sd(out, RISCV_RA, RISCV_SP, 0);
+            riscv_add_fixup(cg, riscv_jal(out, RISCV_RA), instr->u.br.taken, RISCV_FORM_NORMAL, RISCV_FORM_NORMAL);
+            riscv_ld(out, RISCV_RA, RISCV_SP, 0);
+            riscv_addi(out, RISCV_SP, RISCV_SP, RISCV_CALL_FRAME_SIZE);
+            return 1;
+        }
+        case IR_OP_SYSCALL:
+            return riscv_emit_linux_syscall(cg, instr);
+        case IR_OP_PROFDUMP:
+            riscv_emit_runtime_call(cg, "__bsm_prof_dump");
+            return 1;
+        case IR_OP_PROFCNT: {
+            int64_t counter = ir_instr_immediate(cg->fn, instr);
+            if (counter < 0 || counter > INT32_MAX / 8) {
+                fprintf(stderr, "Hata: riscv kod üretimi: geçersiz sayaç indeksi %lld.\n", (long long)counter);
+                return 0;
+            }
+            // Bayraklar korunmalı: sadece t0/t1 kullanılır
+            int32_t offset = (int32_t)counter * 8;
+            riscv_ld(out, RISCV_SCRATCH, cg->state, RISCV_STATE_OFFSET(counters));
+            if (!riscv_fits_immediate(offset)) {
+                riscv_emit_add_constant(cg, RISCV_SCRATCH, RISCV_SCRATCH, offset);
+                offset = 0;
+            }
+            riscv_ld(out, RISCV_SCRATCH2, RISCV_SCRATCH, offset);
+            riscv_addi(out, RISCV_SCRATCH2, RISCV_SCRATCH2, 1);
+            riscv_sd(out, RISCV_SCRATCH2, RISCV_SCRATCH, offset);
+            return 1;
+        }
+        case IR_OP_JMP:
+            if (instr->u.br.taken != next) riscv_emit_jump(cg, instr->u.br.taken);
+            return 1;
+        case IR_OP_BR: {
+            RiscvRegister a, b;
+            if (!riscv_flag_operands(cg, instr->flags, &a, &b)) return 0;
+            RiscvConditionMapping mapping = riscv_conditions[instr->cond];
+            RiscvBranchCondition cond = mapping.cond;
+            uint32_t taken = instr->u.br.taken;
+            uint32_t fallthrough = instr->u.br.fallthrough;
+            if (taken == next && fallthrough != next) {
+                // Koşulu tersine çevirerek ek atlamadan kaçın
+                cond = RISCV_INVERSE(cond);
+                taken = fallthrough;
+                fallthrough = next;
+            }
+            riscv_emit_branch(cg, cond, mapping.swap ? b : a, mapping.swap ? a : b, taken);
+            if (fallthrough != next) riscv_emit_jump(cg, fallthrough);
+            return 1;
+        }
+        case IR_OP_JTAB:
+            return riscv_emit_jump_table(cg, instr);
+        case IR_OP_RET:
+            riscv_ret(out);
+            return 1;
+        case IR_OP_END: {
+            size_t distance = out->size - cg->leave;
+            size_t jump = cg->out->compressed && distance <= RISCV_C_JUMP_RANGE ? riscv_c_j(out)
+                                                                                 : riscv_jal(out, RISCV_X0);
+            if (!riscv_patch_branch(out, jump, cg->leave)) {
+                fprintf(stderr, "Hata: riscv kod üretimi: satır %d: çıkışa dal erişim dışında (kod çok büyük).\n",
+                        line);
+                return 0;
+            }
+            return 1;
+        }
+        default:
+            fprintf(stderr, "Hata: riscv kod üretimi: desteklenmeyen IR komutu '%s'.\n", ir_opcode_to_string(opcode));
+            return 0;
+    }
+}
+
+// --- Giriş, Hatalar ve print Yordamı ---
+
+/**
+ * @brief Giriş (_start veya main): durum adresini, çağrı derinliği sınırını ve PGO çalışma
+ * zamanını kurar, Bessambly kaydedicilerini ve bayrakları sıfırlar ve gövdeyi çağırır. Çıkış
+ * exit_group(0)'dır.
+ * @return Gövdeyi çağıran jal'in konumu.
+ */
+static size_t riscv_emit_entry(RiscvCodegen* cg) {
+    RiscvBuffer* out = cg->out;
+    riscv_la(out, cg->state, RISCV_SYMBOL_STATE, 0);
+    // Gövde girişteki jal ile başlar (yığına bir şey itilmez); her CALL 16 bayt iner
+    riscv_li(out, RISCV_SCRATCH, (int64_t)RISCV_CALL_FRAME_SIZE * JIT_MAX_CALL_DEPTH);
+    if (cg->stack_limit != RISCV_X0) {
+        riscv_sub(out, cg->stack_limit, RISCV_SP, RISCV_SCRATCH);
+    } else {
+        riscv_sub(out, RISCV_SCRATCH, RISCV_SP, RISCV_SCRATCH);
+        riscv_sd(out, RISCV_SCRATCH, cg->state, RISCV_STATE_OFFSET(stack_limit));
+    }
+    if (cg->instrumented) {
+        riscv_li(out, RISCV_A0, (int64_t)cg->profile_checksum);
+        riscv_li(out, RISCV_A1, (int64_t)cg->num_counters);
+        riscv_la(out, RISCV_A2, RISCV_SYMBOL_RODATA, (int64_t)cg->profile_path);
+        riscv_add_runtime_call(cg, riscv_call(out), "__bsm_prof_init");
+        riscv_add_runtime_call(cg, riscv_call(out), "__bsm_prof_thread_init");
+        if (cg->embedded) riscv_la(out, cg->state, RISCV_SYMBOL_STATE, 0);
+        riscv_sd(out, RISCV_A0, cg->state, RISCV_STATE_OFFSET(counters));
+    }
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (cg->registers[r] != RISCV_X0) riscv_li(out, cg->registers[r], 0);
+    }
+    for (int f = 0; f < 2; f++) {
+        if (cg->flag_registers[f] != RISCV_X0) riscv_li(out, cg->flag_registers[f], 0);
+    }
+    size_t body_call = riscv_jal(out, RISCV_RA);
+
+    // Çıkış: gövdeden dönüş ve END
+    cg->leave = out->size;
+    if (cg->instrumented) riscv_emit_runtime_call(cg, "__bsm_prof_dump");
+    riscv_li(out, RISCV_A0, 0);
+    riscv_li(out, cg->syscall_number, RISCV_LINUX_SYS_EXIT_GROUP);
+    riscv_ecall(out);
+    return body_call;
+}
+
+/**
+ * @brief Soğuk hata kodları: her biri satır numaralı mesajını (.rodata) a1/a2'ye yükleyip mesajı
+ * stderr'e yazan ve 1 koduyla çıkan ortak koda atlar.
+ * @return Başarılıysa 1; dal erişimi aşılırsa veya bellek hatasında 0.
+ */
+static int riscv_emit_stubs(RiscvCodegen* cg) {
+    RiscvBuffer* out = cg->out;
+    if (cg->num_stubs == 0) return 1;
+    size_t error_exit = out->size;
+    riscv_li(out, RISCV_A0, 2);
+    riscv_li(out, cg->syscall_number, RISCV_LINUX_SYS_WRITE);
+    riscv_ecall(out);
+    riscv_li(out, RISCV_A0, 1);
+    riscv_li(out, cg->syscall_number, RISCV_LINUX_SYS_EXIT_GROUP);
+    riscv_ecall(out);
+    for (size_t s = 0; s < cg->num_stubs; s++) {
+        char message[128];
+        int length;
+        if (cg->stubs[s].reason == JIT_EXIT_DIVIDE_BY_ZERO) {
+            length = snprintf(message, sizeof(message), "Hata: satır %d: sıfıra bölme.\n", cg->stubs[s].line);
+        } else {
+            length = snprintf(message, sizeof(message), "Hata: satır %d: çağrı yığını taştı (derinlik %d).\n",
+                              cg->stubs[s].line, JIT_MAX_CALL_DEPTH);
+        }
+        size_t offset = cg->obj->sections[cg->rodata].size;
+        if (!object_file_append(cg->obj, cg->rodata, message, (size_t)length)) return 0;
+        if (!riscv_patch_branch(out, cg->stubs[s].position, out->size)) {
+            fprintf(stderr, "Hata: riscv kod üretimi: satır %d: hata dalı erişim dışında (kod çok büyük).\n",
+                    cg->stubs[s].line);
+            return 0;
+        }
+        riscv_la(out, RISCV_A1, RISCV_SYMBOL_RODATA, (int64_t)offset);
+        riscv_li(out, RISCV_A2, length);
+        size_t distance = out->size - error_exit;
+        riscv_patch_branch(out, out->compressed && distance <= RISCV_C_JUMP_RANGE ? riscv_c_j(out)
+                                                                                  : riscv_jal(out, RISCV_X0),
+                           error_exit);
+    }
+    return 1;
+}
+
+/**
+ * @brief print yordamı. t0 argüman sayısıdır, argümanlar .bss'tedir. Sayılar ondalık olarak,
+ * boşlukla ayrılıp satır sonuyla tek bir write çağrısıyla stdout'a yazılır; metin yığındaki
+ * tamponun sonundan başına doğru (son argümandan ilkine) üretilir. x8-x15 yığında saklanıp
+ * kullanılır (sıkıştırılmış komutlar); bunların dışında sadece t0 bozulur.
+ * @return Yordamın konumu.
+ */
+static size_t riscv_emit_print_routine(RiscvCodegen* cg) {
+    RiscvBuffer* out = cg->out;
+    // Argüman başına en fazla 20 basamak, işaret ve ayırıcı; sonda satır sonu. Ardından x8-x15.
+    const int32_t buffer_size = 384;
+    const int32_t frame_size = buffer_size + 8 * 8;
+    size_t start = out->size;
+    riscv_addi(out, RISCV_SP, RISCV_SP, -frame_size);
+    for (int r = 0; r < 8; r++) riscv_sd(out, (RiscvRegister)(RISCV_X8 + r), RISCV_SP, buffer_size + 8 * r);
+    const RiscvRegister end = RISCV_X8, cursor = RISCV_X9, ten = RISCV_X10, args = RISCV_X11;
+    const RiscvRegister value = RISCV_X12, original = RISCV_X13, digit = RISCV_X15;
+    riscv_addi(out, end, RISCV_SP, buffer_size);            // Tamponun sonu
+    riscv_addi(out, cursor, end, -1);                       // Yazma konumu
+    riscv_li(out, ten, 10);
+    riscv_sb(out, ten, cursor, 0);                          // '\n'
+    riscv_addi(out, args, cg->state, RISCV_STATE_OFFSET(print_args));
+    size_t no_args = riscv_branch(out, RISCV_BEQ, RISCV_T0, RISCV_X0);
+
+    size_t next_argument = out->size;
+    riscv_addi(out, RISCV_T0, RISCV_T0, -1);
+    riscv_slli(out, value, RISCV_T0, 3);
+    riscv_add(out, value, value, args);
+    riscv_ld(out, value, value, 0);
+    riscv_mv(out, original, value);
+    size_t positive = riscv_branch(out, RISCV_BGE, value, RISCV_X0);
+    riscv_sub(out, value, RISCV_X0, value); // INT64_MIN işaretsiz bölmede doğru kalır
+    riscv_patch_branch(out, positive, out->size);
+    size_t next_digit = out->size;
+    riscv_remu(out, digit, value, ten);
+    riscv_divu(out, value, value, ten);
+    riscv_addi(out, digit, digit, '0');
+    riscv_addi(out, cursor, cursor, -1);
+    riscv_sb(out, digit, cursor, 0);
+    riscv_patch_branch(out, riscv_emit_short_branch(cg, RISCV_BNE, value, RISCV_X0), next_digit);
+    size_t no_sign = riscv_branch(out, RISCV_BGE, original, RISCV_X0);
+    riscv_li(out, digit, '-');
+    riscv_addi(out, cursor, cursor, -1);
+    riscv_sb(out, digit, cursor, 0);
+    riscv_patch_branch(out, no_sign, out->size);
+    size_t done = riscv_branch(out, RISCV_BEQ, RISCV_T0, RISCV_X0);
+    riscv_li(out, digit, ' ');
+    riscv_addi(out, cursor, cursor, -1);
+    riscv_sb(out, digit, cursor, 0);
+    riscv_patch_branch(out, riscv_emit_short_jump(cg), next_argument);
+
+    riscv_patch_branch(out, no_args, out->size);
+    riscv_patch_branch(out, done, out->size);
+    riscv_sub(out, RISCV_A2, end, cursor);
+    riscv_mv(out, RISCV_A1, cursor);
+    riscv_li(out, RISCV_A0, 1);
+    riscv_li(out, cg->syscall_number, RISCV_LINUX_SYS_WRITE);
+    riscv_ecall(out);
+    for (int r = 0; r < 8; r++) riscv_ld(out, (RiscvRegister)(RISCV_X8 + r), RISCV_SP, buffer_size + 8 * r);
+    riscv_addi(out, RISCV_SP, RISCV_SP, frame_size);
+    riscv_ret(out);
+    return start;
+}
+
+/**
+ * @brief Komuttan önce başlayan parçaların değerlerini yuvalarından parçanın kaydedicisine yükler.
+ * @return Bloğun başlamamış ilk parçası.
+ */
+static uint32_t riscv_open_pieces(RiscvCodegen* cg, uint32_t block, uint32_t piece, size_t index) {
+    for (; piece < cg->allocation.block_pieces[block + 1] && cg->allocation.pieces[piece].first == index; piece++) {
+        const RegAllocPiece* open = &cg->allocation.pieces[piece];
+        RiscvRegister reg = riscv_allocatable[open->reg];
+        if (open->load) riscv_ld(cg->out, reg, cg->state, RISCV_STATE_OFFSET(registers[open->origin]));
+        cg->locations[open->origin] = reg;
+        cg->active_pieces[open->origin] = piece;
+    }
+    return piece;
+}
+
+/**
+ * @brief Komutla biten parçaları kapatır: değiştirilen ve hâlâ canlı değerler yuvalarına yazılır.
+ */
+static void riscv_close_pieces(RiscvCodegen* cg, size_t index) {
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (cg->active_pieces[r] == UINT32_MAX) continue;
+        const RegAllocPiece* piece = &cg->allocation.pieces[cg->active_pieces[r]];
+        if (piece->last != index) continue;
+        if (piece->store) riscv_sd(cg->out, cg->locations[r], cg->state, RISCV_STATE_OFFSET(registers[r]));
+        cg->locations[r] = cg->registers[r];
+        cg->active_pieces[r] = UINT32_MAX;
+    }
+}
+
+static void riscv_codegen_free(RiscvCodegen* cg) {
+    free(cg->flag_def);
+    free(cg->fused);
+    isel_selection_free(&cg->selection);
+    isel_matcher_free(&cg->matcher);
+    regalloc_free(&cg->allocation);
+    free(cg->block_offsets);
+    free(cg->fixups);
+    free(cg->relaxed);
+    free(cg->stubs);
+    free(cg->tables);
+    free(cg->runtime_calls);
+}
+
+/**
+ * @brief Tek üretim geçişi: giriş, bloklar (yerleşim sırasıyla), soğuk kodlar, print yordamı ve
+ * dal düzeltmeleri.
+ * @param relaxed Erişimi yetmeyen bir dal sonraki biçimine uzatıldıysa 1 yapılır (geçiş tekrarlanır).
+ */
+static int riscv_generate_pass(RiscvCodegen* cg, int* relaxed) {
+    const IrFunction* fn = cg->fn;
+    RiscvBuffer* out = cg->out;
+    int ok = 1;
+    *relaxed = 0;
+    for (size_t i = 0; i < fn->num_blocks; i++) cg->block_offsets[i] = SIZE_MAX;
+
+    size_t body_call = riscv_emit_entry(cg);
+    if (fn->num_layout > 0) {
+        riscv_add_fixup(cg, body_call, fn->layout[0], RISCV_FORM_NORMAL, RISCV_FORM_NORMAL);
+    } else {
+        riscv_patch_branch(out, body_call, cg->leave);
+    }
+
+    for (size_t l = 0; l < fn->num_layout && ok; l++) {
+        uint32_t b = fn->layout[l];
+        uint32_t next = l + 1 < fn->num_layout ? fn->layout[l + 1] : IR_NO_BLOCK;
+        const IrBlock* block = &fn->blocks[b];
+        cg->block_offsets[b] = out->size;
+        uint32_t piece = cg->allocation.block_pieces[b];
+        memcpy(cg->locations, cg->registers, sizeof(cg->locations));
+        for (int r = 0; r < IR_NUM_REGISTERS; r++) cg->active_pieces[r] = UINT32_MAX;
+        for (uint32_t k = 0; k < block->num_instrs && ok; k++) {
+            size_t index = block->first + k;
+            piece = riscv_open_pieces(cg, b, piece, index);
+            // Kalıba katılan komut kullanıldığı komutun kalıbında yazılır
+            if (!cg->selection.folded[index]) {
+                ok = riscv_emit_instruction(cg, &fn->instrs[index], fn->locations ? fn->locations[index].line : 0,
+                                            next);
+            }
+            riscv_close_pieces(cg, index);
+        }
+    }
+    cg->blocks_end = out->size;
+    if (ok) ok = riscv_emit_stubs(cg);
+
+    // print yordamı sadece kullanılıyorsa yazılır
+    size_t print_routine = SIZE_MAX;
+    for (size_t c = 0; c < cg->num_runtime_calls && ok; c++) {
+        if (cg->runtime_calls[c].symbol) continue;
+        if (print_routine == SIZE_MAX) print_routine = riscv_emit_print_routine(cg);
+        if (!riscv_patch_branch(out, cg->runtime_calls[c].position, print_routine)) {
+            fprintf(stderr, "Hata: riscv kod üretimi: print yordamına dal erişim dışında (kod çok büyük).\n");
+            ok = 0;
+        }
+    }
+
+    for (size_t f = 0; f < cg->num_fixups && ok; f++) {
+        const RiscvFixup* fixup = &cg->fixups[f];
+        uint32_t target = fixup->block;
+        if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+            fprintf(stderr, "Hata: riscv kod üretimi: yerleşimde olmayan bloğa dal (b%u).\n", target);
+            ok = 0;
+        } else if (riscv_patch_branch(out, fixup->position, cg->block_offsets[target])) {
+            continue;
+        } else if (fixup->form < fixup->max_form) {
+            riscv_relax(cg, f, (RiscvBranchForm)(fixup->form + 1));
+            *relaxed = 1;
+        } else {
+            fprintf(stderr, "Hata: riscv kod üretimi: b%u bloğuna dal erişim dışında (kod çok büyük).\n", target);
+            ok = 0;
+        }
+    }
+    if (ok && (out->failed || cg->out_of_memory)) {
+        fprintf(stderr, "Hata: riscv kod üretimi için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+// --- Makine Kodu Zamanlaması ---
+
+static TargetOpClass riscv_op_class(RiscvInstrKind kind) {
+    switch (kind) {
+        case RISCV_KIND_MUL:
+            return TARGET_OP_MUL;
+        case RISCV_KIND_DIV:
+            return TARGET_OP_DIV;
+        case RISCV_KIND_LOAD:
+            return TARGET_OP_LOAD;
+        case RISCV_KIND_STORE:
+            return TARGET_OP_STORE;
+        default:
+            return TARGET_OP_ALU;
+    }
+}
+
+/**
+ * @brief İki bellek erişiminin aynı baytlara dokunup dokunamayacağı: aynı taban kaydedicisi arada
+ * değişmediyse uzaklık aralıkları karşılaştırılır, aksi takdirde çakıştıkları varsayılır.
+ * @param written Aradaki komutların (ve önceki erişimin) yazdığı kaydediciler.
+ */
+static int riscv_may_alias(const RiscvDecodedInstr* a, const RiscvDecodedInstr* b, uint32_t written) {
+    if (a->mem_base != b->mem_base || (written & (1u << a->mem_base))) return 1;
+    return a->mem_offset < b->mem_offset + b->mem_width && b->mem_offset < a->mem_offset + a->mem_width;
+}
+
+/**
+ * @brief Bir bölgenin bağımlılık grafiğini kurar; daha kısa bir sıra bulunursa komutların baytlarını
+ * yeni sırayla yeniden yazar (bölgenin toplam boyutu değişmez).
+ * @param bytes En az 4 * count baytlık çalışma alanı.
+ */
+static void riscv_schedule_region(RiscvCodegen* cg, SchedGraph* graph, const RiscvDecodedInstr* decoded,
+                                  size_t position, size_t count, uint32_t* order, uint8_t* bytes) {
+    sched_graph_clear(graph);
+    for (size_t k = 0; k < count; k++) sched_add_node(graph, riscv_op_class((RiscvInstrKind)decoded[k].kind));
+
+    for (size_t i = 1; i < count; i++) {
+        const RiscvDecodedInstr* instr = &decoded[i];
+        int is_memory = instr->kind == RISCV_KIND_LOAD || instr->kind == RISCV_KIND_STORE;
+        uint32_t raw = instr->reads, waw = instr->writes, war = instr->writes, written = 0;
+        for (size_t j = i; j > 0; j--) {
+            const RiscvDecodedInstr* earlier = &decoded[j - 1];
+            written |= earlier->writes;
+            if (raw & earlier->writes) sched_add_edge(graph, (uint32_t)(j - 1), (uint32_t)i, SCHED_DEP_DATA);
+            if ((waw & earlier->writes) || (war & earlier->reads)) {
+                sched_add_edge(graph, (uint32_t)(j - 1), (uint32_t)i, SCHED_DEP_ORDER);
+            }
+            raw &= ~earlier->writes;
+            waw &= ~earlier->writes;
+            war &= ~earlier->writes;
+            // Yüklemeler kendi aralarında serbesttir; saklamalar çakışabilecek erişimlerle sırayı korur
+            if (is_memory && (earlier->kind == RISCV_KIND_STORE || (instr->kind == RISCV_KIND_STORE &&
+                                                                     earlier->kind == RISCV_KIND_LOAD)) &&
+                riscv_may_alias(instr, earlier, written)) {
+                sched_add_edge(graph, (uint32_t)(j - 1), (uint32_t)i,
+                               instr->kind == RISCV_KIND_LOAD ? SCHED_DEP_DATA : SCHED_DEP_ORDER);
+            }
+        }
+    }
+    if (!sched_schedule(graph, order, &cg->schedule)) return;
+
+    size_t offsets[SCHED_MAX_REGION];
+    size_t offset = 0;
+    for (size_t k = 0; k < count; k++) {
+        offsets[k] = offset;
+        offset += decoded[k].size;
+    }
+    uint8_t* code = cg->out->data + position;
+    size_t size = 0;
+    for (size_t k = 0; k < count; k++) {
+        memcpy(bytes + size, code + offsets[order[k]], decoded[order[k]].size);
+        size += decoded[order[k]].size;
+    }
+    memcpy(code, bytes, size);
+}
+
+/**
+ * @brief Kaydedici atamasından sonra blokların makine kodunu hedefin ardışık düzen modeline göre
+ * sıralar (bkz. sched.h): örn. bir parçanın yuvasından yüklenmesi önceki bağımsız komutların önüne
+ * alınarak yükleme gecikmesi gizlenir. Bölgeler bir bloğun içinde yeri değişebilen ardışık
+ * komutlardır; dallar, auipc çiftleri, çağrılar ve ecall bölgeleri böler, blok içi dal hedefleri
+ * yeni bir bölge başlatır. Böylece düzeltmelerin, soğuk kodların ve sembol başvurularının
+ * gösterdiği konumlar değişmez.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int riscv_schedule_code(RiscvCodegen* cg) {
+    const IrFunction* fn = cg->fn;
+    const TargetPipelineModel* model = target_cost_model(cg->obj->arch)->pipeline;
+    if (!model->in_order || fn->num_layout == 0) return 1; // Sıra dışı çekirdekler kendileri sıralar
+
+    size_t longest = 0;
+    for (size_t l = 0; l < fn->num_layout; l++) {
+        size_t start = cg->block_offsets[fn->layout[l]];
+        size_t end = l + 1 < fn->num_layout ? cg->block_offsets[fn->layout[l + 1]] : cg->blocks_end;
+        if (end - start > longest) longest = end - start;
+    }
+    size_t capacity = longest / 2 + 1;
+    RiscvDecodedInstr* decoded = (RiscvDecodedInstr*)malloc(sizeof(RiscvDecodedInstr) * capacity);
+    size_t* positions = (size_t*)malloc(sizeof(size_t) * capacity);
+    uint8_t* starts = (uint8_t*)malloc(capacity);
+    uint32_t* order = (uint32_t*)malloc(sizeof(uint32_t) * SCHED_MAX_REGION);
+    uint8_t* bytes = (uint8_t*)malloc(4 * SCHED_MAX_REGION);
+    SchedGraph graph;
+    sched_graph_init(&graph, model);
+    int ok = decoded && positions && starts && order && bytes;
+
+    for (size_t l = 0; l < fn->num_layout && ok; l++) {
+        size_t start = cg->block_offsets[fn->layout[l]];
+        size_t end = l + 1 < fn->num_layout ? cg->block_offsets[fn->layout[l + 1]] : cg->blocks_end;
+        size_t n = 0;
+        for (size_t position = start; position < end; n++) {
+            size_t size = riscv_decode(cg->out->data + position, end - position, &decoded[n]);
+            if (size == 0) break;
+            positions[n] = position;
+            starts[n] = 0;
+            position += size;
+        }
+        // Blok içi dalların hedefleri bölge başlangıcıdır
+        for (size_t k = 0; k < n; k++) {
+            if (decoded[k].kind != RISCV_KIND_BRANCH) continue;
+            int64_t target = (int64_t)positions[k] + decoded[k].branch_offset;
+            if (target < (int64_t)start || target >= (int64_t)end) continue;
+            size_t low = 0, high = n;
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if ((int64_t)positions[mid] < target) low = mid + 1; else high = mid;
+            }
+            if (low < n) starts[low] = 1;
+        }
+        size_t k = 0;
+        while (k < n && ok) {
+            size_t count = 0;
+            // Yeri değişebilen komutlar: ALU, MUL, DIV, LOAD, STORE
+            while (k + count < n && count < SCHED_MAX_REGION && decoded[k + count].kind <= RISCV_KIND_STORE &&
+                   !(k + count > 0 && decoded[k + count - 1].pairs_with_next) && (count == 0 || !starts[k + count])) {
+                count++;
+            }
+            if (count >= 2) riscv_schedule_region(cg, &graph, &decoded[k], positions[k], count, order, bytes);
+            ok = !graph.out_of_memory;
+            k += count ? count : 1;
+        }
+    }
+    if (!ok) fprintf(stderr, "Hata: riscv kod üretimi için bellek tahsis edilemedi.\n");
+
+    sched_graph_free(&graph);
+    free(decoded);
+    free(positions);
+    free(starts);
+    free(order);
+    free(bytes);
+    return ok;
+}
+
+/**
+ * @brief Kod üretimi. Blok dalları önce en kısa biçimlerinde yazılır; erişimi yetmeyenler bir
+ * sonraki biçime uzatılıp kod baştan üretilir, ta ki hiçbir dal uzamayana dek. Biçimler sadece
+ * uzadığı için döngü sonlanır.
+ */
+static int riscv_generate(RiscvCodegen* cg) {
+    const IrFunction* fn = cg->fn;
+    RiscvBuffer* out = cg->out;
+    cg->flag_def = (uint32_t*)calloc(fn->num_vregs + 1, sizeof(uint32_t));
+    cg->fused = (uint8_t*)calloc(fn->num_vregs + 1, 1);
+    cg->block_offsets = (size_t*)malloc(sizeof(size_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    if (!cg->flag_def || !cg->fused || !cg->block_offsets) {
+        fprintf(stderr, "Hata: riscv kod üretimi için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    riscv_analyze_flags(cg);
+    if (!isel_compile(&cg->matcher, riscv_patterns, sizeof(riscv_patterns) / sizeof(riscv_patterns[0]), "riscv") ||
+        !isel_select(&cg->matcher, fn, cg, &cg->selection) || !riscv_allocate_registers(cg)) {
+        return 0;
+    }
+
+    size_t rodata_size = cg->obj->sections[cg->rodata].size;
+    int relaxed;
+    int ok = riscv_generate_pass(cg, &relaxed);
+    while (ok && relaxed) {
+        // Önceki geçişin çıktısı atılır; hata mesajları .rodata'ya yeniden eklenir
+        out->size = 0;
+        out->num_symbol_refs = 0;
+        cg->num_fixups = cg->num_stubs = cg->num_tables = cg->num_runtime_calls = 0;
+        cg->obj->sections[cg->rodata].size = rodata_size;
+        ok = riscv_generate_pass(cg, &relaxed);
+    }
+    return ok && riscv_schedule_code(cg);
+}
+
+/**
+ * @brief auipc'ye PCREL_HI20, ardından gelen addi'ye PCREL_LO12_I yeniden konumlandırması ekler.
+ * LO12 kaydı sembolün kendisini değil auipc'nin adresini gösteren yerel bir etiketi hedef alır.
+ */
+static int riscv_add_pcrel_relocations(RiscvCodegen* cg, int text, size_t auipc, const char* symbol, int64_t addend) {
+    char label[32];
+    snprintf(label, sizeof(label), "__bsm_pcrel%zx", auipc);
+    return object_file_define_symbol(cg->obj, label, text, auipc, OBJ_SYMBOL_LOCAL, OBJ_SYMBOL_NOTYPE) >= 0 &&
+           object_file_add_relocation(cg->obj, text, auipc, symbol, RELOC_RISCV_PCREL_HI20, addend) &&
+           object_file_add_relocation(cg->obj, text, auipc + 4, label, RELOC_RISCV_PCREL_LO12_I, 0);
+}
+
+/**
+ * @brief Atlama tablolarını .rodata'ya REL32 girişlerle yazar. Hedef bloklar için yerel semboller
+ * tanımlanır; tablo adresini yükleyen auipc + addi tablo sembolüne bağlanır.
+ */
+static int riscv_emit_object_tables(RiscvCodegen* cg, int text) {
+    const IrFunction* fn = cg->fn;
+    ObjectFile* obj = cg->obj;
+    for (size_t t = 0; t < cg->num_tables; t++) {
+        const IrJumpTable* table = &fn->jump_tables[cg->tables[t].table];
+        char (*names)[32] = (char(*)[32])malloc(sizeof(*names) * (table->num_targets ? table->num_targets : 1));
+        const char** targets = (const char**)malloc(sizeof(char*) * (table->num_targets ? table->num_targets : 1));
+        int ok = names && targets;
+        if (!ok) fprintf(stderr, "Hata: riscv kod üretimi için bellek tahsis edilemedi.\n");
+        for (uint32_t e = 0; e < table->num_targets && ok; e++) {
+            uint32_t target = fn->pool[table->first_target + e];
+            if (target >= fn->num_blocks || cg->block_offsets[target] == SIZE_MAX) {
+                fprintf(stderr, "Hata: riscv kod üretimi: atlama tablosu yerleşimde olmayan bloğu gösteriyor (b%u).\n",
+                        target);
+                ok = 0;
+                break;
+            }
+            snprintf(names[e], sizeof(names[e]), "__bsm_b%u", target);
+            targets[e] = names[e];
+            int symbol = object_file_symbol(obj, names[e]);
+            if (symbol < 0) {
+                ok = 0;
+            } else if (!obj->symbols[symbol].declared) {
+                ok = object_file_define_symbol(obj, names[e], text, cg->block_offsets[target], OBJ_SYMBOL_LOCAL,
+                                               OBJ_SYMBOL_NOTYPE) >= 0;
+            }
+        }
+        char table_name[32];
+        snprintf(table_name, sizeof(table_name), "__bsm_jtab%zu", t);
+        ok = ok && object_file_emit_jump_table(obj, table_name, targets, table->num_targets, JUMP_TABLE_REL32) &&
+             riscv_add_pcrel_relocations(cg, text, cg->tables[t].position, table_name, 0);
+        free(names);
+        free(targets);
+        if (!ok) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Bessambly etiketlerini bloklarının son yerleşimdeki konumlarında yerel semboller olarak
+ * tanımlar; derleyicinin sembol tablosu gerçek adresleri buradan alır. Nesne dosyasında zaten
+ * bulunan adlar (giriş noktası, çalışma zamanı sembolleri) atlanır.
+ */
+static int riscv_define_labels(RiscvCodegen* cg, int text) {
+    const IrFunction* fn = cg->fn;
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        if (cg->block_offsets[b] == SIZE_MAX) continue;
+        for (uint32_t k = 0; k < block->num_labels; k++) {
+            const char* name = ir_label_name(fn, &fn->labels[block->first_label + k]);
+            if (object_file_find_symbol(cg->obj, name) >= 0) continue;
+            if (object_file_define_symbol(cg->obj, name, text, cg->block_offsets[b], OBJ_SYMBOL_LOCAL,
+                                          OBJ_SYMBOL_NOTYPE) < 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int riscv_generate_object(const IrFunction* fn, ObjectFile* obj, const ObjectCodegenOptions* options,
+                          ObjectCodegenStats* stats) {
+    if (obj->arch != ARCH_RV64I && obj->arch != ARCH_RV64E) {
+        fprintf(stderr, "Hata: riscv kod üretimi: '%s' desteklenmiyor; 64 bitlik Bessambly kaydedicileri için "
+                        "RV64I veya RV64E gerekir.\n",
+                target_arch_to_string(obj->arch));
+        return 0;
+    }
+    RiscvBuffer out = {0};
+    out.compressed = 1;
+    RiscvCodegen cg;
+    memset(&cg, 0, sizeof(cg));
+    cg.fn = fn;
+    cg.out = &out;
+    cg.obj = obj;
+    cg.embedded = obj->arch == ARCH_RV64E;
+    if (cg.embedded) {
+        cg.state = RISCV_T2;
+        cg.stack_limit = RISCV_X0;
+        cg.flag_registers[0] = cg.flag_registers[1] = RISCV_X0;
+        cg.syscall_number = RISCV_T0; // RVE'de a7 yoktur
+    } else {
+        cg.state = RISCV_X26;
+        cg.stack_limit = RISCV_X27;
+        cg.flag_registers[0] = RISCV_X28;
+        cg.flag_registers[1] = RISCV_X29;
+        cg.syscall_number = RISCV_A7;
+    }
+    obj->flags = RISCV_EF_RVC | (cg.embedded ? RISCV_EF_RVE : RISCV_EF_FLOAT_ABI_DOUBLE);
+
+    int text = object_file_add_section(obj, ".text", OBJ_SECTION_TEXT, 4);
+    cg.rodata = object_file_add_section(obj, ".rodata", OBJ_SECTION_RODATA, 8);
+    int bss = object_file_add_section(obj, ".bss", OBJ_SECTION_BSS, 16);
+    int ok = text >= 0 && cg.rodata >= 0 && bss >= 0 &&
+             object_file_define_symbol(obj, RISCV_RODATA_SYMBOL, cg.rodata, 0, OBJ_SYMBOL_LOCAL,
+                                       OBJ_SYMBOL_OBJECT) >= 0;
+
+    // PGO: sayaç sayısı seçeneklerden veya IR'deki en büyük sayaçtan
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode == IR_OP_PROFDUMP) cg.instrumented = 1;
+        if (instr->opcode != IR_OP_PROFCNT) continue;
+        cg.instrumented = 1;
+        int64_t counter = ir_instr_immediate(fn, instr);
+        if (counter >= 0 && (uint64_t)counter + 1 > cg.num_counters) cg.num_counters = (uint64_t)counter + 1;
+    }
+    if (ok && cg.instrumented) {
+        const char* path = options && options->profile_path ? options->profile_path : BSM_PROFILE_DEFAULT_PATH;
+        if (options && options->profile_num_counters > cg.num_counters) cg.num_counters = options->profile_num_counters;
+        cg.profile_checksum = options ? options->profile_checksum : 0;
+        cg.profile_path = obj->sections[cg.rodata].size;
+        ok = object_file_append(obj, cg.rodata, path, strlen(path) + 1);
+    }
+
+    ok = ok && riscv_generate(&cg);
+
+    int entry = -1, state = -1;
+    if (ok) {
+        ok = object_file_append(obj, text, out.data, out.size);
+        const char* entry_name = cg.instrumented ? RISCV_INSTRUMENTED_ENTRY_SYMBOL : RISCV_ENTRY_SYMBOL;
+        entry = ok ? object_file_define_symbol(obj, entry_name, text, 0, OBJ_SYMBOL_GLOBAL, OBJ_SYMBOL_FUNCTION)
+                   : -1;
+        state = ok ? object_file_define_symbol(obj, RISCV_STATE_SYMBOL, bss, 0, OBJ_SYMBOL_LOCAL,
+                                               OBJ_SYMBOL_OBJECT) : -1;
+        ok = entry >= 0 && state >= 0 && object_file_append(obj, bss, NULL, sizeof(RiscvNativeState));
+    }
+    if (ok) {
+        obj->symbols[entry].size = out.size;
+        obj->symbols[state].size = sizeof(RiscvNativeState);
+    }
+    for (size_t r = 0; r < out.num_symbol_refs && ok; r++) {
+        const RiscvSymbolRef* ref = &out.symbol_refs[r];
+        if (ref->kind != RISCV_REF_PCREL_HI20) continue; // LO12 eşi HI20 ile birlikte eklenir
+        const char* name = ref->symbol == RISCV_SYMBOL_STATE ? RISCV_STATE_SYMBOL : RISCV_RODATA_SYMBOL;
+        ok = riscv_add_pcrel_relocations(&cg, text, ref->position, name, ref->addend);
+    }
+    for (size_t c = 0; c < cg.num_runtime_calls && ok; c++) {
+        const char* symbol = cg.runtime_calls[c].symbol;
+        if (!symbol) continue; // print yordamı kodun içindedir
+        ok = object_file_define_symbol(obj, symbol, OBJ_SECTION_UNDEFINED, 0, OBJ_SYMBOL_GLOBAL,
+                                       OBJ_SYMBOL_FUNCTION) >= 0 &&
+             object_file_add_relocation(obj, text, cg.runtime_calls[c].position, symbol, RELOC_RISCV_CALL_PLT, 0);
+    }
+    ok = ok && riscv_emit_object_tables(&cg, text);
+    ok = ok && riscv_define_labels(&cg, text);
+
+    if (ok && stats) {
+        stats->code_size = out.size;
+        stats->num_machine_registers = cg.num_machine_registers;
+        stats->num_relocations = obj->num_relocations;
+        stats->num_folded_instrs = cg.selection.num_folded;
+        stats->num_scheduled_regions = cg.schedule.num_regions;
+    }
+    riscv_codegen_free(&cg);
+    riscv_buffer_free(&out);
+    return ok;
+}
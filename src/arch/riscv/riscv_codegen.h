@@ -0,0 +1,70 @@
+#ifndef RISCV_CODEGEN_H
+#define RISCV_CODEGEN_H
+
+#include "ir_generator.h" // IrFunction (kod üretiminin girdisi)
+#include "arch/riscv/riscv_encoder.h" // RiscvBuffer
+#include "object_file_writer.h" // ObjectFile, ObjectCodegenOptions
+
+// --- RISC-V Kod Üretimi (Linux nesne dosyası) ---
+// IR, RV64 makine koduna çevrilip bağlanıp doğrudan çalıştırılacak bir ELF nesne dosyasına
+// yazılır. Linux hedefleri M (çarpma/bölme) ve C (sıkıştırılmış komutlar) eklentilerini varsayar;
+// komutların 16 bitlik biçimleri kodlayıcıda seçilir (bkz. riscv_encoder.h). Bessambly
+// kaydedicilerinin evleri doğrusal taramayla atanır (bkz. regalloc.h); canlı aralıkları kesişmeyen
+// kaydediciler aynı makine kaydedicisini paylaşır ve sıkıştırılmış komutların çoğu sadece
+// x8-x15'i adreslediği için döngü derinliğiyle ağırlıklandırılmış en sık erişilen evler bu
+// pencereye düşer:
+//  - RV64I: x8-x15, ardından x18-x25 (R0-R15'in tamamı makine kaydedicilerinde). x26 .bss'teki
+//    çalışma zamanı durumunun adresi, x27 çağrı derinliği sınırı, x28/x29 bayraklardır.
+//  - RV64E (16 kaydedici): x8-x15; sığmayan kaydediciler .bss'te tutulur. Bunların blok içindeki
+//    erişimleri, o aralıkta boş olan bir x8-x15 kaydedicisine bölünür (tek yükleme, tek yazma);
+//    bölünemeyenler t0/t1'e yüklenir, sabitleri okundukları yerde yeniden üretilir. x7 durum
+//    adresidir, bayraklar ve çağrı derinliği sınırı .bss'tedir.
+//  - t0, t1 (ve RV64I'de t2): geçici; a0-a5, a7: sistem çağrısı (RV64E'de numara t0'dadır).
+//
+// RISC-V'de bayrak kaydedicisi yoktur; BVM'de olduğu gibi bayraklar son karşılaştırmanın iki
+// tarafıdır ve koşullu dallar (beq, blt, ...) ile seçimler bu iki değeri karşılaştırır. Bayrak
+// değeri blok yerelse ve okunana kadar karşılaştırılan kaydediciler değişmiyorsa CMP kod
+// üretmez: dal doğrudan kaydedicileri karşılaştırır (CMP + Jcc tek komut olur). Diğer bayrak
+// değerleri x28/x29'a (RV64E'de .bss'e) yazılır. SELcc kısa bir dalla üretilir.
+//
+// MUL "mul", DIV "div"dir; div sıfıra bölmede tuzak üretmediği için bölen önce denetlenir
+// (INT64_MIN / -1 donanımda zaten sarmalıdır). CALL "jal ra"dır: CALL önce kendi ra'sını yığına
+// (16 bayt, SP hizalı kalır) saklar; RET "ret"tir. Çağrı derinliği SP'nin sınırla
+// karşılaştırılmasıyla denetlenir.
+//
+// SYSCALL, Linux sistem çağrısı ABI'sine indirgenir: Bessambly numarası (Linux x86-64, BVM ile
+// aynı) target_linux_syscall_number ile RISC-V numarasına çevrilip a7'ye, argümanlar a0-a5'e
+// yüklenir ve "ecall" çalıştırılır; dönüş değeri R0'a yazılır. Argüman kaydedicilerindeki
+// Bessambly kaydedicileri çağrı boyunca .bss'te saklanır. print çağrısı
+// (RISCV_HYPERCALL_PRINT) koda gömülü bir yordamla stdout'a yazılır.
+//
+// Giriş noktası "_start"tır (örn: ld.lld program.o); en dıştaki RET ve END 0 koduyla exit_group
+// çağırır. Yürütme hataları stderr'e satır numaralı bir mesaj yazıp 1 koduyla çıkar. Sembol
+// adresleri auipc + addi ile yüklenir; atlama tabloları .rodata'dadır (REL32). PGO ile
+// enstrümante programlarda giriş noktası "main"dir (örn: cc program.o bsm_profile_rt.c).
+//
+// Bloklar arası dallar önce en kısa biçimlerinde (c.j, c.beqz/c.bnez) yazılır; erişimi
+// yetmeyenler bir sonraki biçime (jal, B türü dal, ters koşullu dal + jal) uzatılıp kod baştan
+// üretilir. ±1 MB'ı aşan kod hata ile reddedilir. Bessambly etiketleri .text'te bloklarının son
+// konumlarında yerel semboller olarak tanımlanır. RV32I ve RV32E için 64 bitlik Bessambly
+// kaydedicileri kaydedici çiftleri gerektirdiğinden nesne dosyası üretilmez.
+
+#define RISCV_LINUX_MAX_SYSCALL_ARGS 6
+#define RISCV_MAX_PRINT_ARGS 16
+#define RISCV_HYPERCALL_PRINT 0x1000  // BVM ile aynı numara
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief IR'yı Linux RISC-V (RV64I veya RV64E) için makine koduna çevirip nesne dosyasına yazar
+ * (.text, .rodata, .bss ve "_start" ya da enstrümante programlarda "main" sembolü).
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param obj Boş, ARCH_RV64I veya ARCH_RV64E için oluşturulmuş nesne dosyası.
+ * @param options Enstrümantasyon bilgileri (NULL olabilir).
+ * @param stats Boş değilse istatistikler yazılır.
+ * @return Başarılıysa 1, aksi takdirde 0 (stderr'e açıklama yazılır).
+ */
+int riscv_generate_object(const IrFunction* fn, ObjectFile* obj, const ObjectCodegenOptions* options,
+                          ObjectCodegenStats* stats);
+
+#endif // RISCV_CODEGEN_H
@@ -0,0 +1,582 @@
+#include "arch/riscv/riscv_encoder.h"
+#include <stdlib.h> // realloc, free
+#include <string.h> // memset
+
+// --- Tampon ---
+
+static void riscv_emit_bytes(RiscvBuffer* buffer, uint32_t value, size_t count) {
+    if (buffer->failed) return;
+    if (buffer->size + count > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity * 2 : 256;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, new_capacity);
+        if (!data) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = new_capacity;
+    }
+    for (size_t i = 0; i < count; i++) buffer->data[buffer->size + i] = (uint8_t)(value >> (8 * i));
+    buffer->size += count;
+}
+
+void riscv_emit32(RiscvBuffer* buffer, uint32_t word) {
+    riscv_emit_bytes(buffer, word, 4);
+}
+
+void riscv_emit16(RiscvBuffer* buffer, uint16_t half) {
+    riscv_emit_bytes(buffer, half, 2);
+}
+
+void riscv_buffer_free(RiscvBuffer* buffer) {
+    free(buffer->data);
+    free(buffer->symbol_refs);
+    buffer->data = NULL;
+    buffer->symbol_refs = NULL;
+    buffer->size = buffer->capacity = 0;
+    buffer->num_symbol_refs = buffer->symbol_ref_capacity = 0;
+}
+
+static void riscv_add_symbol_ref(RiscvBuffer* buffer, RiscvSymbolRefKind kind, uint8_t symbol, int64_t addend) {
+    if (buffer->failed) return;
+    if (buffer->num_symbol_refs >= buffer->symbol_ref_capacity) {
+        size_t new_capacity = buffer->symbol_ref_capacity ? buffer->symbol_ref_capacity * 2 : 32;
+        RiscvSymbolRef* refs = (RiscvSymbolRef*)realloc(buffer->symbol_refs, sizeof(RiscvSymbolRef) * new_capacity);
+        if (!refs) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->symbol_refs = refs;
+        buffer->symbol_ref_capacity = new_capacity;
+    }
+    RiscvSymbolRef* ref = &buffer->symbol_refs[buffer->num_symbol_refs++];
+    ref->position = buffer->size;
+    ref->addend = addend;
+    ref->symbol = symbol;
+    ref->kind = (uint8_t)kind;
+}
+
+// --- Komut Biçimleri ---
+
+static uint32_t riscv_r_type(uint32_t funct7, RiscvRegister rs2, RiscvRegister rs1, uint32_t funct3, RiscvRegister rd,
+                             uint32_t opcode) {
+    return (funct7 << 25) | ((uint32_t)rs2 << 20) | ((uint32_t)rs1 << 15) | (funct3 << 12) | ((uint32_t)rd << 7) |
+           opcode;
+}
+
+static uint32_t riscv_i_type(int32_t imm, RiscvRegister rs1, uint32_t funct3, RiscvRegister rd, uint32_t opcode) {
+    return (((uint32_t)imm & 0xfffu) << 20) | ((uint32_t)rs1 << 15) | (funct3 << 12) | ((uint32_t)rd << 7) | opcode;
+}
+
+static uint32_t riscv_s_type(int32_t imm, RiscvRegister rs2, RiscvRegister rs1, uint32_t funct3, uint32_t opcode) {
+    uint32_t u = (uint32_t)imm;
+    return (((u >> 5) & 0x7fu) << 25) | ((uint32_t)rs2 << 20) | ((uint32_t)rs1 << 15) | (funct3 << 12) |
+           ((u & 0x1fu) << 7) | opcode;
+}
+
+// Sıkıştırılmış biçimlerin 3 bitlik kaydedici alanı (x8-x15)
+static uint16_t riscv_creg(RiscvRegister reg) {
+    return (uint16_t)(reg - RISCV_X8);
+}
+
+static int riscv_fits_signed(int64_t value, int bits) {
+    return value >= -((int64_t)1 << (bits - 1)) && value < ((int64_t)1 << (bits - 1));
+}
+
+// c.addi, c.li, c.addiw, c.andi gibi CI biçimlerinin 6 bitlik sabit alanı
+static uint16_t riscv_ci_immediate(int32_t imm) {
+    uint32_t u = (uint32_t)imm;
+    return (uint16_t)((((u >> 5) & 1u) << 12) | ((u & 0x1fu) << 2));
+}
+
+static uint32_t riscv_b_offset(int32_t offset) {
+    uint32_t u = (uint32_t)offset;
+    return (((u >> 12) & 1u) << 31) | (((u >> 5) & 0x3fu) << 25) | (((u >> 1) & 0xfu) << 8) | (((u >> 11) & 1u) << 7);
+}
+
+static uint32_t riscv_j_offset(int32_t offset) {
+    uint32_t u = (uint32_t)offset;
+    return (((u >> 20) & 1u) << 31) | (((u >> 1) & 0x3ffu) << 21) | (((u >> 11) & 1u) << 20) |
+           (((u >> 12) & 0xffu) << 12);
+}
+
+static uint16_t riscv_cj_offset(int32_t offset) {
+    uint32_t u = (uint32_t)offset;
+    return (uint16_t)((((u >> 11) & 1u) << 12) | (((u >> 4) & 1u) << 11) | (((u >> 8) & 3u) << 9) |
+                      (((u >> 10) & 1u) << 8) | (((u >> 6) & 1u) << 7) | (((u >> 7) & 1u) << 6) |
+                      (((u >> 1) & 7u) << 3) | (((u >> 5) & 1u) << 2));
+}
+
+static uint16_t riscv_cb_offset(int32_t offset) {
+    uint32_t u = (uint32_t)offset;
+    return (uint16_t)((((u >> 8) & 1u) << 12) | (((u >> 3) & 3u) << 10) | (((u >> 6) & 3u) << 5) |
+                      (((u >> 1) & 3u) << 3) | (((u >> 5) & 1u) << 2));
+}
+
+// --- Dallar ---
+
+int riscv_patch_branch(RiscvBuffer* buffer, size_t position, size_t target) {
+    if (buffer->failed || position + 2 > buffer->size) return 1;
+    int64_t offset = (int64_t)target - (int64_t)position;
+    uint8_t* p = buffer->data + position;
+    if ((p[0] & 3) == 3) {
+        uint32_t word = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        if ((word & 0x7fu) == 0x6fu) {
+            // jal
+            if (!riscv_fits_signed(offset, 21)) return 0;
+            word = (word & 0xfffu) | riscv_j_offset((int32_t)offset);
+        } else {
+            // B türü
+            if (!riscv_fits_signed(offset, 13)) return 0;
+            word = (word & 0x01fff07fu) | riscv_b_offset((int32_t)offset);
+        }
+        for (int i = 0; i < 4; i++) p[i] = (uint8_t)(word >> (8 * i));
+        return 1;
+    }
+    uint16_t half = (uint16_t)(p[0] | (p[1] << 8));
+    if ((half >> 13) == 5) {
+        // c.j
+        if (!riscv_fits_signed(offset, 12)) return 0;
+        half = (uint16_t)((half & 0xe003u) | riscv_cj_offset((int32_t)offset));
+    } else {
+        // c.beqz, c.bnez
+        if (!riscv_fits_signed(offset, 9)) return 0;
+        half = (uint16_t)((half & 0xe383u) | riscv_cb_offset((int32_t)offset));
+    }
+    p[0] = (uint8_t)half;
+    p[1] = (uint8_t)(half >> 8);
+    return 1;
+}
+
+size_t riscv_branch(RiscvBuffer* buffer, RiscvBranchCondition cond, RiscvRegister rs1, RiscvRegister rs2) {
+    size_t position = buffer->size;
+    riscv_emit32(buffer, riscv_r_type(0, rs2, rs1, (uint32_t)cond, RISCV_X0, 0x63));
+    return position;
+}
+
+size_t riscv_jal(RiscvBuffer* buffer, RiscvRegister rd) {
+    size_t position = buffer->size;
+    riscv_emit32(buffer, ((uint32_t)rd << 7) | 0x6fu);
+    return position;
+}
+
+size_t riscv_c_j(RiscvBuffer* buffer) {
+    size_t position = buffer->size;
+    riscv_emit16(buffer, 0xa001);
+    return position;
+}
+
+size_t riscv_c_beqz(RiscvBuffer* buffer, RiscvRegister rs1) {
+    size_t position = buffer->size;
+    riscv_emit16(buffer, (uint16_t)(0xc001 | (riscv_creg(rs1) << 7)));
+    return position;
+}
+
+size_t riscv_c_bnez(RiscvBuffer* buffer, RiscvRegister rs1) {
+    size_t position = buffer->size;
+    riscv_emit16(buffer, (uint16_t)(0xe001 | (riscv_creg(rs1) << 7)));
+    return position;
+}
+
+void riscv_jalr(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, int32_t offset) {
+    if (buffer->compressed && offset == 0 && rs1 != RISCV_X0 && (rd == RISCV_X0 || rd == RISCV_RA)) {
+        // c.jr, c.jalr
+        riscv_emit16(buffer, (uint16_t)((rd == RISCV_RA ? 0x9002 : 0x8002) | (rs1 << 7)));
+        return;
+    }
+    riscv_emit32(buffer, riscv_i_type(offset, rs1, 0, rd, 0x67));
+}
+
+size_t riscv_call(RiscvBuffer* buffer) {
+    size_t position = buffer->size;
+    riscv_auipc(buffer, RISCV_RA, 0);
+    riscv_emit32(buffer, riscv_i_type(0, RISCV_RA, 0, RISCV_RA, 0x67)); // Sıkıştırılmaz (bağlayıcı doldurur)
+    return position;
+}
+
+void riscv_ret(RiscvBuffer* buffer) {
+    riscv_jalr(buffer, RISCV_X0, RISCV_RA, 0);
+}
+
+void riscv_ecall(RiscvBuffer* buffer) {
+    riscv_emit32(buffer, 0x00000073u);
+}
+
+void riscv_la(RiscvBuffer* buffer, RiscvRegister rd, uint8_t symbol, int64_t offset) {
+    if (symbol) riscv_add_symbol_ref(buffer, RISCV_REF_PCREL_HI20, symbol, offset);
+    riscv_auipc(buffer, rd, 0);
+    if (symbol) riscv_add_symbol_ref(buffer, RISCV_REF_PCREL_LO12_I, symbol, offset);
+    riscv_emit32(buffer, riscv_i_type(0, rd, 0, rd, 0x13)); // addi rd, rd, 0 (sıkıştırılmaz)
+}
+
+// --- Sabitler ---
+
+void riscv_lui(RiscvBuffer* buffer, RiscvRegister rd, uint32_t imm20) {
+    int32_t value = (int32_t)(imm20 << 12) >> 12; // 20 bitten işaret genişletme
+    if (buffer->compressed && rd != RISCV_X0 && rd != RISCV_SP && value != 0 && riscv_fits_signed(value, 6)) {
+        riscv_emit16(buffer, (uint16_t)(0x6001 | (rd << 7) | riscv_ci_immediate(value)));
+        return;
+    }
+    riscv_emit32(buffer, ((imm20 & 0xfffffu) << 12) | ((uint32_t)rd << 7) | 0x37u);
+}
+
+void riscv_auipc(RiscvBuffer* buffer, RiscvRegister rd, uint32_t imm20) {
+    riscv_emit32(buffer, ((imm20 & 0xfffffu) << 12) | ((uint32_t)rd << 7) | 0x17u);
+}
+
+void riscv_li(RiscvBuffer* buffer, RiscvRegister rd, int64_t imm) {
+    int64_t lo12 = (int64_t)((uint64_t)imm << 52) >> 52;
+    if (riscv_fits_signed(imm, 32)) {
+        uint32_t hi20 = (uint32_t)(((uint64_t)imm + 0x800) >> 12) & 0xfffffu;
+        if (hi20) riscv_lui(buffer, rd, hi20);
+        if (lo12 || !hi20) {
+            // lui sonrası addiw: 32 bitte sarıp işaret genişletir (örn: 0x7ffff800)
+            if (hi20) {
+                riscv_addiw(buffer, rd, rd, (int32_t)lo12);
+            } else {
+                riscv_addi(buffer, rd, RISCV_X0, (int32_t)lo12);
+            }
+        }
+        return;
+    }
+    // Üst bitler özyinelemeyle yüklenip sola kaydırılır; sondaki sıfırlar kaydırmaya katılır
+    uint64_t hi52 = ((uint64_t)imm + 0x800) >> 12;
+    int shift = 12;
+    while (!(hi52 & 1)) {
+        hi52 >>= 1;
+        shift++;
+    }
+    int width = 64 - shift;
+    int64_t upper = (int64_t)(hi52 << (64 - width)) >> (64 - width);
+    riscv_li(buffer, rd, upper);
+    riscv_slli(buffer, rd, rd, (uint32_t)shift);
+    if (lo12) riscv_addi(buffer, rd, rd, (int32_t)lo12);
+}
+
+void riscv_mv(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs) {
+    if (rd == rs) return;
+    if (buffer->compressed && rd != RISCV_X0 && rs != RISCV_X0) {
+        riscv_emit16(buffer, (uint16_t)(0x8002 | (rd << 7) | (rs << 2))); // c.mv
+        return;
+    }
+    riscv_emit32(buffer, riscv_i_type(0, rs, 0, rd, 0x13));
+}
+
+// --- Sabitli İşlemler ---
+
+void riscv_addi(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, int32_t imm) {
+    if (buffer->compressed && rd != RISCV_X0) {
+        if (imm == 0 && rs1 != RISCV_X0) {
+            riscv_mv(buffer, rd, rs1);
+            return;
+        }
+        if (rs1 == RISCV_X0 && riscv_fits_signed(imm, 6)) {
+            riscv_emit16(buffer, (uint16_t)(0x4001 | (rd << 7) | riscv_ci_immediate(imm))); // c.li
+            return;
+        }
+        if (rd == rs1 && riscv_fits_signed(imm, 6)) {
+            riscv_emit16(buffer, (uint16_t)(0x0001 | (rd << 7) | riscv_ci_immediate(imm))); // c.addi
+            return;
+        }
+        if (rd == RISCV_SP && rs1 == RISCV_SP && imm % 16 == 0 && imm >= -512 && imm < 512) {
+            uint32_t u = (uint32_t)imm;
+            riscv_emit16(buffer, (uint16_t)(0x6101 | (((u >> 9) & 1u) << 12) | (((u >> 4) & 1u) << 6) |
+                                            (((u >> 6) & 1u) << 5) | (((u >> 7) & 3u) << 3) | (((u >> 5) & 1u) << 2)));
+            return;
+        }
+        if (rs1 == RISCV_SP && RISCV_IS_COMPRESSIBLE_REGISTER(rd) && imm > 0 && imm < 1024 && imm % 4 == 0) {
+            uint32_t u = (uint32_t)imm;
+            riscv_emit16(buffer, (uint16_t)((((u >> 4) & 3u) << 11) | (((u >> 6) & 0xfu) << 7) |
+                                            (((u >> 2) & 1u) << 6) | (((u >> 3) & 1u) << 5) | (riscv_creg(rd) << 2)));
+            return;
+        }
+    }
+    riscv_emit32(buffer, riscv_i_type(imm, rs1, 0, rd, 0x13));
+}
+
+void riscv_addiw(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, int32_t imm) {
+    if (buffer->compressed && rd != RISCV_X0 && rd == rs1 && riscv_fits_signed(imm, 6)) {
+        riscv_emit16(buffer, (uint16_t)(0x2001 | (rd << 7) | riscv_ci_immediate(imm))); // c.addiw
+        return;
+    }
+    riscv_emit32(buffer, riscv_i_type(imm, rs1, 0, rd, 0x1b));
+}
+
+void riscv_slli(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, uint32_t shift) {
+    if (buffer->compressed && rd != RISCV_X0 && rd == rs1 && shift != 0) {
+        riscv_emit16(buffer, (uint16_t)(0x0002 | (rd << 7) | riscv_ci_immediate((int32_t)shift))); // c.slli
+        return;
+    }
+    riscv_emit32(buffer, riscv_i_type((int32_t)(shift & 0x3f), rs1, 1, rd, 0x13));
+}
+
+// --- Kaydedicili İşlemler ---
+
+void riscv_add(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2) {
+    if (buffer->compressed && rd != RISCV_X0) {
+        if (rs1 == RISCV_X0 && rs2 != RISCV_X0) {
+            riscv_mv(buffer, rd, rs2);
+            return;
+        }
+        // c.add rd, rs2 (rd = rd + rs2; toplama değişmeli)
+        RiscvRegister other = rd == rs1 ? rs2 : rd == rs2 ? rs1 : RISCV_X0;
+        if (other != RISCV_X0) {
+            riscv_emit16(buffer, (uint16_t)(0x9002 | (rd << 7) | (other << 2)));
+            return;
+        }
+    }
+    riscv_emit32(buffer, riscv_r_type(0, rs2, rs1, 0, rd, 0x33));
+}
+
+void riscv_sub(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2) {
+    if (buffer->compressed && rd == rs1 && RISCV_IS_COMPRESSIBLE_REGISTER(rd) && RISCV_IS_COMPRESSIBLE_REGISTER(rs2)) {
+        riscv_emit16(buffer, (uint16_t)(0x8c01 | (riscv_creg(rd) << 7) | (riscv_creg(rs2) << 2))); // c.sub
+        return;
+    }
+    riscv_emit32(buffer, riscv_r_type(0x20, rs2, rs1, 0, rd, 0x33));
+}
+
+void riscv_mul(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2) {
+    riscv_emit32(buffer, riscv_r_type(1, rs2, rs1, 0, rd, 0x33));
+}
+
+void riscv_div(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2) {
+    riscv_emit32(buffer, riscv_r_type(1, rs2, rs1, 4, rd, 0x33));
+}
+
+void riscv_divu(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2) {
+    riscv_emit32(buffer, riscv_r_type(1, rs2, rs1, 5, rd, 0x33));
+}
+
+void riscv_remu(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2) {
+    riscv_emit32(buffer, riscv_r_type(1, rs2, rs1, 7, rd, 0x33));
+}
+
+// --- Yükleme/Saklama ---
+
+void riscv_ld(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister base, int32_t offset) {
+    if (buffer->compressed && rd != RISCV_X0 && offset >= 0 && offset % 8 == 0) {
+        uint32_t u = (uint32_t)offset;
+        if (base == RISCV_SP && offset < 512) {
+            riscv_emit16(buffer, (uint16_t)(0x6002 | (((u >> 5) & 1u) << 12) | (rd << 7) | (((u >> 3) & 3u) << 5) |
+                                            (((u >> 6) & 7u) << 2))); // c.ldsp
+            return;
+        }
+        if (RISCV_IS_COMPRESSIBLE_REGISTER(rd) && RISCV_IS_COMPRESSIBLE_REGISTER(base) && offset < 256) {
+            riscv_emit16(buffer, (uint16_t)(0x6000 | (((u >> 3) & 7u) << 10) | (riscv_creg(base) << 7) |
+                                            (((u >> 6) & 3u) << 5) | (riscv_creg(rd) << 2))); // c.ld
+            return;
+        }
+    }
+    riscv_emit32(buffer, riscv_i_type(offset, base, 3, rd, 0x03));
+}
+
+void riscv_sd(RiscvBuffer* buffer, RiscvRegister rs, RiscvRegister base, int32_t offset) {
+    if (buffer->compressed && offset >= 0 && offset % 8 == 0) {
+        uint32_t u = (uint32_t)offset;
+        if (base == RISCV_SP && offset < 512) {
+            riscv_emit16(buffer, (uint16_t)(0xe002 | (((u >> 3) & 7u) << 10) | (((u >> 6) & 7u) << 7) |
+                                            (rs << 2))); // c.sdsp
+            return;
+        }
+        if (RISCV_IS_COMPRESSIBLE_REGISTER(rs) && RISCV_IS_COMPRESSIBLE_REGISTER(base) && offset < 256) {
+            riscv_emit16(buffer, (uint16_t)(0xe000 | (((u >> 3) & 7u) << 10) | (riscv_creg(base) << 7) |
+                                            (((u >> 6) & 3u) << 5) | (riscv_creg(rs) << 2))); // c.sd
+            return;
+        }
+    }
+    riscv_emit32(buffer, riscv_s_type(offset, rs, base, 3, 0x23));
+}
+
+void riscv_lw(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister base, int32_t offset) {
+    if (buffer->compressed && RISCV_IS_COMPRESSIBLE_REGISTER(rd) && RISCV_IS_COMPRESSIBLE_REGISTER(base) &&
+        offset >= 0 && offset < 128 && offset % 4 == 0) {
+        uint32_t u = (uint32_t)offset;
+        riscv_emit16(buffer, (uint16_t)(0x4000 | (((u >> 3) & 7u) << 10) | (riscv_creg(base) << 7) |
+                                        (((u >> 2) & 1u) << 6) | (((u >> 6) & 1u) << 5) | (riscv_creg(rd) << 2))); // c.lw
+        return;
+    }
+    riscv_emit32(buffer, riscv_i_type(offset, base, 2, rd, 0x03));
+}
+
+void riscv_sb(RiscvBuffer* buffer, RiscvRegister rs, RiscvRegister base, int32_t offset) {
+    riscv_emit32(buffer, riscv_s_type(offset, rs, base, 0, 0x23));
+}
+
+// --- Çözümleme ---
+
+static uint32_t riscv_bit(uint32_t reg) {
+    return reg ? 1u << reg : 0; // x0 okunan/yazılan bir değer taşımaz
+}
+
+static int32_t riscv_sign_extend(uint32_t value, int bits) {
+    uint32_t sign = 1u << (bits - 1);
+    return (int32_t)((value ^ sign) - sign);
+}
+
+static void riscv_decode_memory(RiscvDecodedInstr* decoded, RiscvInstrKind kind, uint32_t base, int32_t offset,
+                                uint8_t width) {
+    decoded->kind = (uint8_t)kind;
+    decoded->mem_base = (RiscvRegister)base;
+    decoded->mem_offset = offset;
+    decoded->mem_width = width;
+    decoded->reads |= riscv_bit(base);
+}
+
+static void riscv_decode32(uint32_t w, RiscvDecodedInstr* decoded) {
+    uint32_t rd = (w >> 7) & 31u, rs1 = (w >> 15) & 31u, rs2 = (w >> 20) & 31u, funct3 = (w >> 12) & 7u;
+    static const uint8_t load_widths[8] = {1, 2, 4, 8, 1, 2, 4, 0};
+    switch (w & 0x7fu) {
+        case 0x37: // lui
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x13: // addi, slli, andi, ...
+        case 0x1b: // addiw, slliw, ...
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->reads = riscv_bit(rs1);
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x33: // add, sub, mul, div, ...
+        case 0x3b: // addw, mulw, divw, ...
+            decoded->kind = (w >> 25) != 1u ? RISCV_KIND_ALU : funct3 < 4 ? RISCV_KIND_MUL : RISCV_KIND_DIV;
+            decoded->reads = riscv_bit(rs1) | riscv_bit(rs2);
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x03: // lb, lh, lw, ld, lbu, lhu, lwu
+            if (!load_widths[funct3]) break;
+            decoded->writes = riscv_bit(rd);
+            riscv_decode_memory(decoded, RISCV_KIND_LOAD, rs1, (int32_t)w >> 20, load_widths[funct3]);
+            break;
+        case 0x23: // sb, sh, sw, sd
+            if (funct3 > 3) break;
+            decoded->reads = riscv_bit(rs2);
+            riscv_decode_memory(decoded, RISCV_KIND_STORE, rs1, (((int32_t)w >> 25) << 5) | (int32_t)rd,
+                                (uint8_t)(1u << funct3));
+            break;
+        case 0x63: // beq, bne, ...
+            decoded->kind = RISCV_KIND_BRANCH;
+            decoded->reads = riscv_bit(rs1) | riscv_bit(rs2);
+            decoded->branch_offset = riscv_sign_extend((((w >> 31) & 1u) << 12) | (((w >> 25) & 0x3fu) << 5) |
+                                                       (((w >> 8) & 0xfu) << 1) | (((w >> 7) & 1u) << 11), 13);
+            break;
+        case 0x6f: // jal
+            decoded->kind = RISCV_KIND_BRANCH;
+            decoded->writes = riscv_bit(rd);
+            decoded->branch_offset = riscv_sign_extend((((w >> 31) & 1u) << 20) | (((w >> 21) & 0x3ffu) << 1) |
+                                                       (((w >> 20) & 1u) << 11) | (((w >> 12) & 0xffu) << 12), 21);
+            break;
+        case 0x17: // auipc: değeri komutun adresine bağlıdır
+            decoded->pairs_with_next = 1;
+            break;
+        default: // jalr, ecall, ...
+            break;
+    }
+}
+
+static void riscv_decode16(uint32_t h, RiscvDecodedInstr* decoded) {
+    uint32_t funct3 = h >> 13;
+    uint32_t rd = (h >> 7) & 31u, rs2 = (h >> 2) & 31u;
+    uint32_t rd_short = ((h >> 7) & 7u) + 8, rs2_short = ((h >> 2) & 7u) + 8;
+    switch (((h & 3u) << 3) | funct3) {
+        case 0x00: // c.addi4spn
+            if (h == 0) break;
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->reads = riscv_bit(RISCV_SP);
+            decoded->writes = riscv_bit(rs2_short);
+            break;
+        case 0x02: // c.lw
+        case 0x03: // c.ld
+        case 0x06: // c.sw
+        case 0x07: { // c.sd
+            int doubleword = funct3 & 1u;
+            uint32_t offset = (((h >> 10) & 7u) << 3) |
+                              (doubleword ? ((h >> 5) & 3u) << 6 : (((h >> 6) & 1u) << 2) | (((h >> 5) & 1u) << 6));
+            if (funct3 < 4) {
+                decoded->writes = riscv_bit(rs2_short);
+            } else {
+                decoded->reads = riscv_bit(rs2_short);
+            }
+            riscv_decode_memory(decoded, funct3 < 4 ? RISCV_KIND_LOAD : RISCV_KIND_STORE, rd_short, (int32_t)offset,
+                                doubleword ? 8 : 4);
+            break;
+        }
+        case 0x08: // c.addi
+        case 0x09: // c.addiw
+        case 0x10: // c.slli
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->reads = riscv_bit(rd);
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x0a: // c.li
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x0b: // c.addi16sp, c.lui
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->reads = rd == RISCV_SP ? riscv_bit(RISCV_SP) : 0;
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x0c: // c.srli, c.srai, c.andi, c.sub, c.xor, c.or, c.and, c.subw, c.addw
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->reads = riscv_bit(rd_short) | (((h >> 10) & 3u) == 3u ? riscv_bit(rs2_short) : 0);
+            decoded->writes = riscv_bit(rd_short);
+            break;
+        case 0x0d: // c.j
+            decoded->kind = RISCV_KIND_BRANCH;
+            decoded->branch_offset = riscv_sign_extend((((h >> 12) & 1u) << 11) | (((h >> 11) & 1u) << 4) |
+                                                       (((h >> 9) & 3u) << 8) | (((h >> 8) & 1u) << 10) |
+                                                       (((h >> 7) & 1u) << 6) | (((h >> 6) & 1u) << 7) |
+                                                       (((h >> 3) & 7u) << 1) | (((h >> 2) & 1u) << 5), 12);
+            break;
+        case 0x0e: // c.beqz
+        case 0x0f: // c.bnez
+            decoded->kind = RISCV_KIND_BRANCH;
+            decoded->reads = riscv_bit(rd_short);
+            decoded->branch_offset = riscv_sign_extend((((h >> 12) & 1u) << 8) | (((h >> 10) & 3u) << 3) |
+                                                       (((h >> 5) & 3u) << 6) | (((h >> 3) & 3u) << 1) |
+                                                       (((h >> 2) & 1u) << 5), 9);
+            break;
+        case 0x12: // c.lwsp
+        case 0x13: { // c.ldsp
+            if (rd == 0) break;
+            uint32_t offset = funct3 == 2 ? (((h >> 12) & 1u) << 5) | (((h >> 4) & 7u) << 2) | (((h >> 2) & 3u) << 6)
+                                          : (((h >> 12) & 1u) << 5) | (((h >> 5) & 3u) << 3) | (((h >> 2) & 7u) << 6);
+            decoded->writes = riscv_bit(rd);
+            riscv_decode_memory(decoded, RISCV_KIND_LOAD, RISCV_SP, (int32_t)offset, funct3 == 2 ? 4 : 8);
+            break;
+        }
+        case 0x14: // c.mv, c.add (c.jr, c.jalr, c.ebreak yerinde kalır)
+            if (rs2 == 0 || rd == 0) break;
+            decoded->kind = RISCV_KIND_ALU;
+            decoded->reads = riscv_bit(rs2) | ((h >> 12) & 1u ? riscv_bit(rd) : 0);
+            decoded->writes = riscv_bit(rd);
+            break;
+        case 0x16: // c.swsp
+        case 0x17: { // c.sdsp
+            uint32_t offset = funct3 == 6 ? (((h >> 9) & 0xfu) << 2) | (((h >> 7) & 3u) << 6)
+                                          : (((h >> 10) & 7u) << 3) | (((h >> 7) & 7u) << 6);
+            decoded->reads = riscv_bit(rs2);
+            riscv_decode_memory(decoded, RISCV_KIND_STORE, RISCV_SP, (int32_t)offset, funct3 == 6 ? 4 : 8);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+size_t riscv_decode(const uint8_t* code, size_t available, RiscvDecodedInstr* decoded) {
+    memset(decoded, 0, sizeof(*decoded));
+    decoded->kind = RISCV_KIND_FIXED;
+    if (available < 2) return 0;
+    if ((code[0] & 3) != 3) {
+        decoded->size = 2;
+        riscv_decode16((uint32_t)code[0] | ((uint32_t)code[1] << 8), decoded);
+        return 2;
+    }
+    if (available < 4) return 0;
+    decoded->size = 4;
+    riscv_decode32((uint32_t)code[0] | ((uint32_t)code[1] << 8) | ((uint32_t)code[2] << 16) | ((uint32_t)code[3] << 24),
+                   decoded);
+    return 4;
+}
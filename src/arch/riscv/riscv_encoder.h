@@ -0,0 +1,183 @@
+#ifndef RISCV_ENCODER_H
+#define RISCV_ENCODER_H
+
+#include <stdint.h> // uint8_t, uint16_t, uint32_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- RISC-V (RV64) Komut Kodlayıcı ---
+// Kod üreticilerin kullandığı küçük bir kodlayıcı: RV64I tamsayı komutlarının ve M eklentisinin
+// ihtiyaç duyulan biçimleri vardır. Tamponda C (sıkıştırılmış) eklentisi açıksa her fonksiyon
+// kaydedici ve sabit kısıtları izin verdiğinde komutun 16 bitlik biçimini seçer (örn: rd == rs1
+// ise c.add, x8-x15 tabanlı ve 8'in katı konumlu yüklemeler için c.ld); bu sayede komut seçimi
+// kod üreticiden bağımsız olarak yoğun kod üretir. Bellek hatası tamponun 'failed' alanına yazılır
+// ve sonraki eklemeler yok sayılır (üretim sonunda bir kez denetlenir).
+//
+// Dallar hedefi henüz bilinmeden yazılabilir: dal fonksiyonları komutun konumunu döndürür, hedef
+// belli olunca riscv_patch_branch uzaklık alanını komutun biçimine göre doldurur. Sıkıştırılmış
+// dalların (c.j, c.beqz, c.bnez) erişimi kısa olduğundan onları hedefi bilen kod üretici seçer.
+// Sembol adresleri (riscv_la) auipc + addi çiftiyle yüklenir; alanlar sıfır bırakılıp tampona
+// başvuru kayıtları eklenir (nesne dosyasında yeniden konumlandırmaya çevrilir).
+
+// --- Kaydediciler ---
+typedef enum {
+    RISCV_X0, RISCV_X1, RISCV_X2, RISCV_X3, RISCV_X4, RISCV_X5, RISCV_X6, RISCV_X7,
+    RISCV_X8, RISCV_X9, RISCV_X10, RISCV_X11, RISCV_X12, RISCV_X13, RISCV_X14, RISCV_X15,
+    RISCV_X16, RISCV_X17, RISCV_X18, RISCV_X19, RISCV_X20, RISCV_X21, RISCV_X22, RISCV_X23,
+    RISCV_X24, RISCV_X25, RISCV_X26, RISCV_X27, RISCV_X28, RISCV_X29, RISCV_X30, RISCV_X31,
+    // ABI adları
+    RISCV_ZERO = 0,
+    RISCV_RA = 1,
+    RISCV_SP = 2,
+    RISCV_T0 = 5, RISCV_T1 = 6, RISCV_T2 = 7,
+    RISCV_A0 = 10, RISCV_A1 = 11, RISCV_A2 = 12, RISCV_A3 = 13, RISCV_A4 = 14, RISCV_A5 = 15,
+    RISCV_A7 = 17
+} RiscvRegister;
+
+// Sıkıştırılmış komutların çoğu sadece x8-x15'i (3 bitlik kaydedici alanı) adresleyebilir
+#define RISCV_IS_COMPRESSIBLE_REGISTER(reg) ((reg) >= RISCV_X8 && (reg) <= RISCV_X15)
+
+// --- Koşullu Dal Türleri (funct3) ---
+typedef enum {
+    RISCV_BEQ = 0,
+    RISCV_BNE = 1,
+    RISCV_BLT = 4,
+    RISCV_BGE = 5,
+    RISCV_BLTU = 6,     // İşaretsiz küçük
+    RISCV_BGEU = 7      // İşaretsiz büyük veya eşit
+} RiscvBranchCondition;
+
+// Dal biçimlerinin erişimi (bayt): uzaklık [-erişim, erişim) aralığında olmalıdır
+#define RISCV_C_BRANCH_RANGE 256        // c.beqz, c.bnez
+#define RISCV_C_JUMP_RANGE 2048         // c.j
+#define RISCV_BRANCH_RANGE 4096         // beq, bne, blt, ...
+#define RISCV_JUMP_RANGE (1 << 20)      // jal
+
+// --- Sembol Başvurusu Türleri ---
+typedef enum {
+    RISCV_REF_PCREL_HI20,   // auipc: (S + A - P + 0x800) >> 12
+    RISCV_REF_PCREL_LO12_I  // addi: eşlenen auipc'nin (P - 4) uzaklığının düşük 12 biti
+} RiscvSymbolRefKind;
+
+typedef struct {
+    size_t position;        // Komutun konumu (P)
+    int64_t addend;         // Sembol içindeki konum (A; LO12 kayıtlarında HI20 ile aynı)
+    uint8_t symbol;         // Numarayı kod üretici belirler (0: kayıt eklenmez)
+    uint8_t kind;           // RiscvSymbolRefKind
+} RiscvSymbolRef;
+
+// --- Kod Tamponu ---
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int failed;             // Bellek hatası oluştuysa 1
+    int compressed;         // C eklentisi kullanılabiliyorsa 1
+    RiscvSymbolRef* symbol_refs;
+    size_t num_symbol_refs;
+    size_t symbol_ref_capacity;
+} RiscvBuffer;
+
+// --- Çözülmüş Komut (makine kodu zamanlaması için) ---
+typedef enum {
+    RISCV_KIND_ALU,         // Tamsayı işlemleri, lui, sabitli işlemler
+    RISCV_KIND_MUL,
+    RISCV_KIND_DIV,         // div, divu, rem, remu
+    RISCV_KIND_LOAD,
+    RISCV_KIND_STORE,
+    RISCV_KIND_BRANCH,      // PC göreli dal ve atlamalar (hedef: konum + branch_offset)
+    RISCV_KIND_FIXED        // Yeri değişemeyen komutlar: auipc, jalr, ecall ve tanınmayanlar
+} RiscvInstrKind;
+
+typedef struct {
+    uint8_t size;           // 2 veya 4
+    uint8_t kind;           // RiscvInstrKind
+    uint8_t pairs_with_next; // 1: sonraki komut bu komuta bitişik olmalıdır (auipc + addi/jalr)
+    uint8_t mem_width;      // Bellek erişiminin bayt genişliği (LOAD/STORE)
+    uint32_t reads;         // Okunan kaydediciler (x0 hariç bit maskesi)
+    uint32_t writes;        // Yazılan kaydediciler (x0 hariç)
+    RiscvRegister mem_base; // Bellek erişiminin taban kaydedicisi
+    int32_t mem_offset;     // Taban kaydedicisine göre uzaklık
+    int32_t branch_offset;  // Dalın hedefinin komuta göre uzaklığı (BRANCH)
+} RiscvDecodedInstr;
+
+// --- Fonksiyon Prototipleri: Tampon ---
+
+/**
+ * @brief Tampona 32 bitlik bir komut ekler.
+ */
+void riscv_emit32(RiscvBuffer* buffer, uint32_t word);
+
+/**
+ * @brief Tampona 16 bitlik (sıkıştırılmış) bir komut ekler.
+ */
+void riscv_emit16(RiscvBuffer* buffer, uint16_t half);
+
+/**
+ * @brief Tamponun kod ve sembol başvurusu dizilerini serbest bırakır.
+ */
+void riscv_buffer_free(RiscvBuffer* buffer);
+
+/**
+ * @brief 'position' konumundaki dalın (jal, B türü dallar, c.j, c.beqz, c.bnez) hedefini 'target' yapar.
+ * @return Uzaklık komutun erişimine sığıyorsa 1, aksi takdirde 0.
+ */
+int riscv_patch_branch(RiscvBuffer* buffer, size_t position, size_t target);
+
+/**
+ * @brief Bir sembolün içindeki 'offset' konumunun adresini auipc + addi ile kaydediciye yükler.
+ * symbol 0 ise başvuru kaydı eklenmez (yeniden konumlandırmayı kod üretici kendisi ekler).
+ */
+void riscv_la(RiscvBuffer* buffer, RiscvRegister rd, uint8_t symbol, int64_t offset);
+
+/**
+ * @brief Tampondaki bir komutu kodlayıcının ürettiği biçimler için çözer (RV64I, M ve C).
+ * @param code Komutun ilk baytı.
+ * @param available Komutun başından itibaren okunabilecek bayt sayısı.
+ * @param decoded Doldurulacak çözüm; tanınmayan komutlar RISCV_KIND_FIXED olur.
+ * @return Komutun boyutu; bayt yetmiyorsa 0.
+ */
+size_t riscv_decode(const uint8_t* code, size_t available, RiscvDecodedInstr* decoded);
+
+// --- Fonksiyon Prototipleri: Komutlar ---
+
+/**
+ * @brief 64 bitlik sabiti kaydediciye yükler (lui/addiw ile 32 bitlik parça, gerekirse slli + addi
+ * ile kalan bitler; sıkıştırılabilen adımlar c.li, c.lui, c.addiw, c.slli olur).
+ */
+void riscv_li(RiscvBuffer* buffer, RiscvRegister rd, int64_t imm);
+void riscv_mv(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs);
+void riscv_lui(RiscvBuffer* buffer, RiscvRegister rd, uint32_t imm20);
+void riscv_auipc(RiscvBuffer* buffer, RiscvRegister rd, uint32_t imm20);
+
+// Sabitli işlemler: imm 12 bit işaretli (-2048..2047), kaydırmalar 0..63
+void riscv_addi(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, int32_t imm);
+void riscv_addiw(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, int32_t imm);
+void riscv_slli(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, uint32_t shift);
+
+// Kaydedicili işlemler (M eklentisi: mul, div, divu, remu)
+void riscv_add(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2);
+void riscv_sub(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2);
+void riscv_mul(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2);
+void riscv_div(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2);
+void riscv_divu(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2);
+void riscv_remu(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, RiscvRegister rs2);
+
+// Yükleme/saklama: offset 12 bit işaretli
+void riscv_ld(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister base, int32_t offset);
+void riscv_sd(RiscvBuffer* buffer, RiscvRegister rs, RiscvRegister base, int32_t offset);
+void riscv_lw(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister base, int32_t offset);
+void riscv_sb(RiscvBuffer* buffer, RiscvRegister rs, RiscvRegister base, int32_t offset);
+
+// Dallar: hedefi sonradan yazılacak komutların konumunu döndürür (bkz. riscv_patch_branch).
+// riscv_c_* biçimleri sıkıştırılmıştır; C eklentisi ve kaydedici kısıtları çağırana aittir.
+size_t riscv_branch(RiscvBuffer* buffer, RiscvBranchCondition cond, RiscvRegister rs1, RiscvRegister rs2);
+size_t riscv_jal(RiscvBuffer* buffer, RiscvRegister rd);
+size_t riscv_c_j(RiscvBuffer* buffer);
+size_t riscv_c_beqz(RiscvBuffer* buffer, RiscvRegister rs1);   // rs1: x8-x15
+size_t riscv_c_bnez(RiscvBuffer* buffer, RiscvRegister rs1);   // rs1: x8-x15
+void riscv_jalr(RiscvBuffer* buffer, RiscvRegister rd, RiscvRegister rs1, int32_t offset);
+size_t riscv_call(RiscvBuffer* buffer); // auipc ra, 0 + jalr ra, 0(ra); alanları bağlayıcı doldurur
+void riscv_ret(RiscvBuffer* buffer); // jalr x0, 0(ra)
+void riscv_ecall(RiscvBuffer* buffer);
+
+#endif // RISCV_ENCODER_H
@@ -1,118 +1,208 @@
-#include "ast.h"
-#include <stdlib.h> // malloc, free
-#include <string.h> // strdup (isteğe bağlı, daha güvenli kopyalama yapılmalı)
-#include <stdio.h>  // fprintf for error messages
-
-// --- Fonksiyon Gerçeklemeleri ---
-
-AstNode* ast_node_create(AstNodeType type, int line, int column) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
-    if (!node) {
-        fprintf(stderr, "Hata: AST düğümü için bellek tahsis edilemedi (tip: %d).\n", type);
-        return NULL;
-    }
-    node->type = type;
-    node->line = line;
-    node->column = column;
-
-    // Union alanlarını başlat
-    switch (type) {
-        case AST_PROGRAM:
-            node->data.program.num_statements = 0;
-            node->data.program.statements = NULL;
-            break;
-        case AST_LABEL_DECLARATION:
-            node->data.label_decl.name = NULL;
-            break;
-        case AST_INSTRUCTION:
-            node->data.instruction.opcode = TOKEN_UNKNOWN; // Başlangıç değeri
-            node->data.instruction.num_operands = 0;
-            node->data.instruction.operands = NULL;
-            break;
-        case AST_REGISTER_OPERAND:
-        case AST_INTEGER_OPERAND:
-        case AST_IDENTIFIER_OPERAND:
-        case AST_SYSCALL_ARGUMENT:
-            // Bu tür düğümlerin verileri genellikle 'data' union'ında değil,
-            // AstOperand struct'ında depolanır ve InstructionNode içinde kullanılır.
-            // Eğer bunları ayrı AST düğümleri olarak modellediyseniz buraya ekleme yapın.
-            break;
-    }
-    return node;
-}
-
-AstOperand* ast_operand_create(OperandType type) {
-    AstOperand* operand = (AstOperand*)malloc(sizeof(AstOperand));
-    if (!operand) {
-        fprintf(stderr, "Hata: AST operand için bellek tahsis edilemedi (tip: %d).\n", type);
-        return NULL;
-    }
-    operand->type = type;
-    // Union alanlarını başlat
-    switch (type) {
-        case OP_REGISTER:
-            operand->value.reg_index = -1;
-            break;
-        case OP_INTEGER:
-        case OP_HEX_INTEGER:
-            operand->value.int_value = 0;
-            break;
-        case OP_LABEL_REF:
-            operand->value.label_name = NULL;
-            break;
-    }
-    return operand;
-}
-
-
-void ast_operand_free(AstOperand* operand) {
-    if (operand) {
-        if (operand->type == OP_LABEL_REF && operand->value.label_name) {
-            free(operand->value.label_name);
-        }
-        free(operand);
-    }
-}
-
-void ast_node_free(AstNode* node) {
-    if (!node) {
-        return;
-    }
-
-    switch (node->type) {
-        case AST_PROGRAM:
-            if (node->data.program.statements) {
-                for (size_t i = 0; i < node->data.program.num_statements; i++) {
-                    ast_node_free(node->data.program.statements[i]); // Alt düğümleri rekürsif olarak serbest bırak
-                }
-                free(node->data.program.statements);
-            }
-            break;
-        case AST_LABEL_DECLARATION:
-            if (node->data.label_decl.name) {
-                free(node->data.label_decl.name);
-            }
-            break;
-        case AST_INSTRUCTION:
-            if (node->data.instruction.operands) {
-                for (size_t i = 0; i < node->data.instruction.num_operands; i++) {
-                    ast_operand_free(&node->data.instruction.operands[i]); // Operandları serbest bırak
-                }
-                free(node->data.instruction.operands);
-            }
-            break;
-        // Operand düğümleri (eğer ayrı düğümler olarak tanımlandıysa) burada serbest bırakılmalı
-        // Şu anki modelde operandlar InstructionNode'un bir parçası olduğu için bu kısım gerekli değil.
-        case AST_REGISTER_OPERAND:
-        case AST_INTEGER_OPERAND:
-        case AST_IDENTIFIER_OPERAND:
-        case AST_SYSCALL_ARGUMENT:
-             // Bu tür düğümlerin özel serbest bırakma mantığı yoksa burası boş kalabilir
-             // veya AstOperand serbest bırakma mantığı buraya entegre edilebilir.
-             // Ancak mevcut modelde bu düğüm tipleri doğrudan AstOperand'a karşılık gelmiyor
-             // ve Instruction içinde AstOperand dizisi olarak tutuluyor.
-            break;
-    }
-
-    free(node); // Düğümün kendisini serbest bırak
-}
+#include "ast.h"
+#include <stdlib.h> // malloc, free
+#include <string.h> // strdup (isteğe bağlı, daha güvenli kopyalama yapılmalı)
+#include <stdio.h>  // fprintf for error messages
+
+// --- Fonksiyon Gerçeklemeleri ---
+
+AstNode* ast_node_create(AstNodeType type, int line, int column) {
+    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
+    if (!node) {
+        fprintf(stderr, "Hata: AST düğümü için bellek tahsis edilemedi (tip: %d).\n", type);
+        return NULL;
+    }
+    node->type = type;
+    node->line = line;
+    node->column = column;
+
+    // Union alanlarını başlat
+    switch (type) {
+        case AST_PROGRAM:
+            node->data.program.num_statements = 0;
+            node->data.program.statements = NULL;
+            break;
+        case AST_LABEL_DECLARATION:
+            node->data.label_decl.name = NULL;
+            node->data.label_decl.unroll_pragma = 0;
+            break;
+        case AST_INSTRUCTION:
+            node->data.instruction.opcode = TOKEN_UNKNOWN; // Başlangıç değeri
+            node->data.instruction.num_operands = 0;
+            node->data.instruction.operands = NULL;
+            node->data.instruction.virtual_address = 0;
+            node->data.instruction.has_profile = 0;
+            node->data.instruction.profile_count = 0;
+            node->data.instruction.profile_taken_count = 0;
+            break;
+        case AST_REGISTER_OPERAND:
+        case AST_INTEGER_OPERAND:
+        case AST_IDENTIFIER_OPERAND:
+        case AST_SYSCALL_ARGUMENT:
+            // Bu tür düğümlerin verileri genellikle 'data' union'ında değil,
+            // AstOperand struct'ında depolanır ve InstructionNode içinde kullanılır.
+            // Eğer bunları ayrı AST düğümleri olarak modellediyseniz buraya ekleme yapın.
+            break;
+    }
+    return node;
+}
+
+AstOperand* ast_operand_create(OperandType type) {
+    AstOperand* operand = (AstOperand*)malloc(sizeof(AstOperand));
+    if (!operand) {
+        fprintf(stderr, "Hata: AST operand için bellek tahsis edilemedi (tip: %d).\n", type);
+        return NULL;
+    }
+    operand->type = type;
+    // Union alanlarını başlat
+    switch (type) {
+        case OP_REGISTER:
+            operand->value.reg_index = -1;
+            break;
+        case OP_INTEGER:
+        case OP_HEX_INTEGER:
+            operand->value.int_value = 0;
+            break;
+        case OP_LABEL_REF:
+            operand->value.label_name = NULL;
+            break;
+    }
+    return operand;
+}
+
+
+void ast_operand_free(AstOperand* operand) {
+    if (operand) {
+        if (operand->type == OP_LABEL_REF && operand->value.label_name) {
+            free(operand->value.label_name);
+        }
+        free(operand);
+    }
+}
+
+void ast_node_free(AstNode* node) {
+    if (!node) {
+        return;
+    }
+
+    switch (node->type) {
+        case AST_PROGRAM:
+            if (node->data.program.statements) {
+                for (size_t i = 0; i < node->data.program.num_statements; i++) {
+                    ast_node_free(node->data.program.statements[i]); // Alt düğümleri rekürsif olarak serbest bırak
+                }
+                free(node->data.program.statements);
+            }
+            break;
+        case AST_LABEL_DECLARATION:
+            if (node->data.label_decl.name) {
+                free(node->data.label_decl.name);
+            }
+            break;
+        case AST_INSTRUCTION:
+            if (node->data.instruction.operands) {
+                // Operandlar tek bir dizi içinde tutulduğu için tek tek free edilmez,
+                // sadece sahip oldukları etiket adları serbest bırakılır.
+                for (size_t i = 0; i < node->data.instruction.num_operands; i++) {
+                    AstOperand* operand = &node->data.instruction.operands[i];
+                    if (operand->type == OP_LABEL_REF && operand->value.label_name) {
+                        free(operand->value.label_name);
+                    }
+                }
+                free(node->data.instruction.operands);
+            }
+            break;
+        // Operand düğümleri (eğer ayrı düğümler olarak tanımlandıysa) burada serbest bırakılmalı
+        // Şu anki modelde operandlar InstructionNode'un bir parçası olduğu için bu kısım gerekli değil.
+        case AST_REGISTER_OPERAND:
+        case AST_INTEGER_OPERAND:
+        case AST_IDENTIFIER_OPERAND:
+        case AST_SYSCALL_ARGUMENT:
+             // Bu tür düğümlerin özel serbest bırakma mantığı yoksa burası boş kalabilir
+             // veya AstOperand serbest bırakma mantığı buraya entegre edilebilir.
+             // Ancak mevcut modelde bu düğüm tipleri doğrudan AstOperand'a karşılık gelmiyor
+             // ve Instruction içinde AstOperand dizisi olarak tutuluyor.
+            break;
+    }
+
+    free(node); // Düğümün kendisini serbest bırak
+}
+
+AstNode* ast_instruction_create(TokenType opcode, size_t num_operands, int line, int column) {
+    AstNode* node = ast_node_create(AST_INSTRUCTION, line, column);
+    if (!node) return NULL;
+
+    node->data.instruction.opcode = opcode;
+    if (num_operands > 0) {
+        node->data.instruction.operands = (AstOperand*)calloc(num_operands, sizeof(AstOperand));
+        if (!node->data.instruction.operands) {
+            fprintf(stderr, "Hata: Komut operandları için bellek tahsis edilemedi.\n");
+            free(node);
+            return NULL;
+        }
+        // calloc sonrası türler OP_REGISTER (0) olur; etiket adı NULL olduğu için güvenle serbest bırakılabilir.
+    }
+    node->data.instruction.num_operands = num_operands;
+    return node;
+}
+
+AstNode* ast_label_declaration_create(const char* name, int line, int column) {
+    AstNode* node = ast_node_create(AST_LABEL_DECLARATION, line, column);
+    if (!node) return NULL;
+
+    node->data.label_decl.name = strdup(name);
+    if (!node->data.label_decl.name) {
+        fprintf(stderr, "Hata: Etiket adı için bellek tahsis edilemedi.\n");
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+int ast_operand_set_label(AstOperand* operand, const char* label_name) {
+    char* copy = strdup(label_name);
+    if (!copy) {
+        fprintf(stderr, "Hata: Etiket referansı için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    if (operand->type == OP_LABEL_REF && operand->value.label_name) {
+        free(operand->value.label_name);
+    }
+    operand->type = OP_LABEL_REF;
+    operand->value.label_name = copy;
+    return 1;
+}
+
+AstNode* ast_node_clone(const AstNode* node) {
+    if (!node) return NULL;
+
+    if (node->type == AST_LABEL_DECLARATION) {
+        AstNode* copy = ast_label_declaration_create(node->data.label_decl.name, node->line, node->column);
+        if (copy) copy->data.label_decl.unroll_pragma = node->data.label_decl.unroll_pragma;
+        return copy;
+    }
+    if (node->type != AST_INSTRUCTION) {
+        fprintf(stderr, "Hata: Bu AST düğüm türü kopyalanamaz (%d).\n", node->type);
+        return NULL;
+    }
+
+    const AstInstruction* source = &node->data.instruction;
+    AstNode* copy = ast_instruction_create(source->opcode, source->num_operands, node->line, node->column);
+    if (!copy) return NULL;
+
+    AstInstruction* instr = &copy->data.instruction;
+    for (size_t i = 0; i < source->num_operands; i++) {
+        if (source->operands[i].type == OP_LABEL_REF) {
+            if (!ast_operand_set_label(&instr->operands[i], source->operands[i].value.label_name)) {
+                ast_node_free(copy);
+                return NULL;
+            }
+        } else {
+            instr->operands[i] = source->operands[i];
+        }
+    }
+    instr->virtual_address = source->virtual_address;
+    instr->has_profile = source->has_profile;
+    instr->profile_count = source->profile_count;
+    instr->profile_taken_count = source->profile_taken_count;
+    return copy;
+}
@@ -0,0 +1,1122 @@
+#include "bvm.h"
+#include <stdlib.h> // malloc, calloc, realloc, free, qsort, strtoull
+#include <stdio.h>  // fprintf, printf, fopen, fgets, snprintf
+#include <string.h> // memcpy, memset, memcmp, strcmp, strncmp, strlen, strcspn
+#include <inttypes.h> // PRIu64
+
+// Hesaplanmış goto (GCC/Clang "etiket değeri" uzantısı) varsa doğrudan iş parçacıklı yürütme
+#if defined(__GNUC__) || defined(__clang__)
+#define BVM_COMPUTED_GOTO 1
+#else
+#define BVM_COMPUTED_GOTO 0
+#endif
+
+#define BVM_MAX_SYSCALL_ARGS 16
+#define BVM_MAX_COUNTERS (1u << 24)
+#define BVM_MAX_FUSED 3                 // En uzun üst-komut dizisi
+#define BVM_MAX_PROFILE_WEIGHT (1ull << 40) // Profil ağırlıkları toplanırken taşmasın diye
+#define BVM_PROFILE_LINE_MAX 256
+
+// --- Çözülmüş Komutlar ---
+// _K biçimleri çözülürken sabit havuzundan okunup _I biçimine dönüşür.
+typedef enum {
+    BVM_OP_MOV_R, BVM_OP_MOV_I,
+    BVM_OP_ADD_R, BVM_OP_ADD_I,
+    BVM_OP_SUB_R, BVM_OP_SUB_I,
+    BVM_OP_MUL_R, BVM_OP_MUL_I,
+    BVM_OP_DIV_R, BVM_OP_DIV_I,
+    BVM_OP_CMP_R, BVM_OP_CMP_I,
+    BVM_OP_SELEQ_R, BVM_OP_SELEQ_I,
+    BVM_OP_SELNE_R, BVM_OP_SELNE_I,
+    BVM_OP_SELLT_R, BVM_OP_SELLT_I,
+    BVM_OP_SELGT_R, BVM_OP_SELGT_I,
+    BVM_OP_SELLE_R, BVM_OP_SELLE_I,
+    BVM_OP_SELGE_R, BVM_OP_SELGE_I,
+    BVM_OP_JMP,
+    BVM_OP_JEQ, BVM_OP_JNE, BVM_OP_JLT, BVM_OP_JGT, BVM_OP_JLE, BVM_OP_JGE,
+    BVM_OP_CALL,
+    BVM_OP_RET,
+    BVM_OP_JTAB,
+    BVM_OP_SYSCALL,
+    BVM_OP_PROFCNT,
+    BVM_OP_PROFDUMP,
+    BVM_OP_HALT,
+    // Üst-komutlar (sıra bvm_superinstruction_patterns ile aynıdır)
+    BVM_OP_CMP_R_JEQ, BVM_OP_CMP_R_JNE, BVM_OP_CMP_R_JLT, BVM_OP_CMP_R_JGT, BVM_OP_CMP_R_JLE, BVM_OP_CMP_R_JGE,
+    BVM_OP_CMP_I_JEQ, BVM_OP_CMP_I_JNE, BVM_OP_CMP_I_JLT, BVM_OP_CMP_I_JGT, BVM_OP_CMP_I_JLE, BVM_OP_CMP_I_JGE,
+    BVM_OP_MOV_R_ADD_R, BVM_OP_MOV_R_ADD_I, BVM_OP_MOV_R_SUB_R, BVM_OP_MOV_R_SUB_I,
+    BVM_OP_MOV_R_MUL_R, BVM_OP_MOV_R_MUL_I,
+    BVM_OP_ADD_I_CMP_R_JEQ, BVM_OP_ADD_I_CMP_R_JNE, BVM_OP_ADD_I_CMP_R_JLT,
+    BVM_OP_ADD_I_CMP_R_JGT, BVM_OP_ADD_I_CMP_R_JLE, BVM_OP_ADD_I_CMP_R_JGE,
+    BVM_OP_ADD_I_CMP_I_JEQ, BVM_OP_ADD_I_CMP_I_JNE, BVM_OP_ADD_I_CMP_I_JLT,
+    BVM_OP_ADD_I_CMP_I_JGT, BVM_OP_ADD_I_CMP_I_JLE, BVM_OP_ADD_I_CMP_I_JGE,
+    BVM_OP_SUB_I_CMP_R_JEQ, BVM_OP_SUB_I_CMP_R_JNE, BVM_OP_SUB_I_CMP_R_JLT,
+    BVM_OP_SUB_I_CMP_R_JGT, BVM_OP_SUB_I_CMP_R_JLE, BVM_OP_SUB_I_CMP_R_JGE,
+    BVM_OP_SUB_I_CMP_I_JEQ, BVM_OP_SUB_I_CMP_I_JNE, BVM_OP_SUB_I_CMP_I_JLT,
+    BVM_OP_SUB_I_CMP_I_JGT, BVM_OP_SUB_I_CMP_I_JLE, BVM_OP_SUB_I_CMP_I_JGE,
+    BVM_OP_PROFILE_DISPATCH,            // Gönderim profili: kaydı say, asıl işleyiciye geç
+    BVM_OP_LOOP_HEADER,                 // Döngü sayacı: başı say, eşikte kancayı çağır, asıl işleyiciye geç
+    BVM_OP_COUNT
+} BvmOp;
+
+#define BVM_NUM_BASE_OPS (BVM_OP_HALT + 1)
+#define BVM_FIRST_SUPERINSTRUCTION BVM_OP_CMP_R_JEQ
+#define BVM_NUM_SUPERINSTRUCTIONS (BVM_OP_PROFILE_DISPATCH - BVM_FIRST_SUPERINSTRUCTION)
+
+// Gönderim profili dosyasındaki adlar
+static const char* const bvm_op_names[BVM_NUM_BASE_OPS] = {
+    "MOV_R", "MOV_I", "ADD_R", "ADD_I", "SUB_R", "SUB_I", "MUL_R", "MUL_I", "DIV_R", "DIV_I", "CMP_R", "CMP_I",
+    "SELEQ_R", "SELEQ_I", "SELNE_R", "SELNE_I", "SELLT_R", "SELLT_I",
+    "SELGT_R", "SELGT_I", "SELLE_R", "SELLE_I", "SELGE_R", "SELGE_I",
+    "JMP", "JEQ", "JNE", "JLT", "JGT", "JLE", "JGE",
+    "CALL", "RET", "JTAB", "SYSCALL", "PROFCNT", "PROFDUMP", "HALT",
+};
+
+// --- Üst-Komut Kataloğu ---
+// Her girdi birleştirilen bitişik temel komutları verir. Son komut dışındakiler akışı
+// değiştirmez; böylece birleşik işleyici sadece son komutta dallanır.
+typedef struct {
+    uint8_t ops[BVM_MAX_FUSED];
+    uint8_t length;
+} BvmPattern;
+
+#define BVM_PATTERN2(first, second) {{BVM_OP_##first, BVM_OP_##second, 0}, 2}
+#define BVM_PATTERN3(first, second, third) {{BVM_OP_##first, BVM_OP_##second, BVM_OP_##third}, 3}
+static const BvmPattern bvm_superinstruction_patterns[BVM_NUM_SUPERINSTRUCTIONS] = {
+    BVM_PATTERN2(CMP_R, JEQ), BVM_PATTERN2(CMP_R, JNE), BVM_PATTERN2(CMP_R, JLT),
+    BVM_PATTERN2(CMP_R, JGT), BVM_PATTERN2(CMP_R, JLE), BVM_PATTERN2(CMP_R, JGE),
+    BVM_PATTERN2(CMP_I, JEQ), BVM_PATTERN2(CMP_I, JNE), BVM_PATTERN2(CMP_I, JLT),
+    BVM_PATTERN2(CMP_I, JGT), BVM_PATTERN2(CMP_I, JLE), BVM_PATTERN2(CMP_I, JGE),
+    BVM_PATTERN2(MOV_R, ADD_R), BVM_PATTERN2(MOV_R, ADD_I), BVM_PATTERN2(MOV_R, SUB_R),
+    BVM_PATTERN2(MOV_R, SUB_I), BVM_PATTERN2(MOV_R, MUL_R), BVM_PATTERN2(MOV_R, MUL_I),
+    BVM_PATTERN3(ADD_I, CMP_R, JEQ), BVM_PATTERN3(ADD_I, CMP_R, JNE), BVM_PATTERN3(ADD_I, CMP_R, JLT),
+    BVM_PATTERN3(ADD_I, CMP_R, JGT), BVM_PATTERN3(ADD_I, CMP_R, JLE), BVM_PATTERN3(ADD_I, CMP_R, JGE),
+    BVM_PATTERN3(ADD_I, CMP_I, JEQ), BVM_PATTERN3(ADD_I, CMP_I, JNE), BVM_PATTERN3(ADD_I, CMP_I, JLT),
+    BVM_PATTERN3(ADD_I, CMP_I, JGT), BVM_PATTERN3(ADD_I, CMP_I, JLE), BVM_PATTERN3(ADD_I, CMP_I, JGE),
+    BVM_PATTERN3(SUB_I, CMP_R, JEQ), BVM_PATTERN3(SUB_I, CMP_R, JNE), BVM_PATTERN3(SUB_I, CMP_R, JLT),
+    BVM_PATTERN3(SUB_I, CMP_R, JGT), BVM_PATTERN3(SUB_I, CMP_R, JLE), BVM_PATTERN3(SUB_I, CMP_R, JGE),
+    BVM_PATTERN3(SUB_I, CMP_I, JEQ), BVM_PATTERN3(SUB_I, CMP_I, JNE), BVM_PATTERN3(SUB_I, CMP_I, JLT),
+    BVM_PATTERN3(SUB_I, CMP_I, JGT), BVM_PATTERN3(SUB_I, CMP_I, JLE), BVM_PATTERN3(SUB_I, CMP_I, JGE),
+};
+#undef BVM_PATTERN2
+#undef BVM_PATTERN3
+
+struct BvmSuperinstructionSet {
+    uint64_t weights[BVM_NUM_SUPERINSTRUCTIONS]; // Yürütme başına kazanılan gönderim x sıklık (0: kullanılmaz)
+};
+
+/**
+ * @brief Komut her zaman bir sonrakine mi geçer (dal, çağrı veya dönüş değil mi)?
+ */
+static int bvm_falls_through(uint8_t op) {
+    return op < BVM_OP_JMP || op == BVM_OP_SYSCALL || op == BVM_OP_PROFCNT || op == BVM_OP_PROFDUMP;
+}
+
+struct BvmInstr {
+    const void* handler;        // İşleyicinin adresi (doğrudan iş parçacıklı yürütme)
+    uint8_t op;                 // BvmOp (birleştirilmiş dizinin ilk kaydında üst-komut)
+    uint8_t base_op;            // Kaydın kendi temel işlemi
+    uint8_t a;                  // İlk kaydedici
+    uint8_t b;                  // İkinci kaydedici (_R biçimleri)
+    uint32_t aux;               // Sistem çağrısı sitesi, atlama tablosu veya sayaç indeksi
+    union {
+        int64_t imm;            // Sabit (_I biçimleri, JTAB en küçük değeri)
+        const BvmInstr* target; // Dal/çağrı hedefi
+    } u;
+};
+
+struct BvmSyscallSite {
+    int64_t number;
+    uint32_t first_arg;         // Bvm.syscall_args içindeki ilk argüman
+    uint32_t num_args;
+    BvmSyscallHandler handler;  // Çözülmüş işleyici (tanımsızsa NULL)
+    void* user;
+};
+
+struct BvmJumpTable {
+    uint32_t first_target;      // Bvm.jump_targets içinde: varsayılan, ardından hedefler
+    uint32_t num_targets;
+};
+
+// --- Bayt Kodu Okuyucu (sınır denetimli) ---
+
+typedef struct {
+    const uint8_t* cursor;
+    const uint8_t* end;
+    int failed;
+} BvmReader;
+
+static uint8_t bvm_read_byte(BvmReader* reader) {
+    if (reader->cursor >= reader->end) {
+        reader->failed = 1;
+        return 0;
+    }
+    return *reader->cursor++;
+}
+
+static uint64_t bvm_read_uleb(BvmReader* reader) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = bvm_read_byte(reader);
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    reader->failed = 1;
+    return 0;
+}
+
+static int64_t bvm_read_sleb(BvmReader* reader) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = bvm_read_byte(reader);
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            if (shift + 7 < 64 && (byte & 0x40)) value |= ~(uint64_t)0 << (shift + 7);
+            return (int64_t)value;
+        }
+    }
+    reader->failed = 1;
+    return 0;
+}
+
+static int32_t bvm_read_i32(BvmReader* reader) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)bvm_read_byte(reader) << (8 * i);
+    return (int32_t)value;
+}
+
+// --- Çözme (pre-decode) ---
+
+static int bvm_grow(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (!grown) return 0;
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+typedef struct {
+    Bvm* vm;
+    int64_t* branch_offsets;    // Komut başına dal hedefinin kod konumu (dal değilse -1)
+    int64_t* table_offsets;     // Atlama tablosu hedeflerinin kod konumları
+    size_t num_table_offsets;
+    size_t table_offset_capacity;
+    size_t site_capacity;
+    size_t arg_capacity;
+    size_t num_args;
+    size_t table_capacity;
+} BvmDecoder;
+
+/**
+ * @brief Bir .vbsm komutunu çözer. Dal hedefleri kod konumu olarak kaydedilir.
+ * @return Başarılıysa 1, bozuk komutta 0.
+ */
+static int bvm_decode_instruction(BvmDecoder* decoder, BvmReader* reader, BvmInstr* instr, size_t index) {
+    Bvm* vm = decoder->vm;
+    const VbsmModule* module = vm->module;
+    const uint8_t* end_of_instr;
+    uint8_t opcode = bvm_read_byte(reader);
+    memset(instr, 0, sizeof(BvmInstr));
+    decoder->branch_offsets[index] = -1;
+
+    if (opcode >= VBSM_OP_MOV_R && opcode <= VBSM_OP_SELGE_K) {
+        int operation = (opcode - VBSM_OP_MOV_R) / 3;
+        int form = (opcode - VBSM_OP_MOV_R) % 3;
+        uint8_t registers = bvm_read_byte(reader);
+        instr->op = (uint8_t)(BVM_OP_MOV_R + 2 * operation + (form != 0));
+        instr->a = registers >> 4;
+        instr->b = registers & 0x0f;
+        if (form == 1) {
+            instr->u.imm = bvm_read_sleb(reader);
+        } else if (form == 2) {
+            uint64_t constant = bvm_read_uleb(reader);
+            if (constant >= module->num_constants) return 0;
+            instr->u.imm = module->constants[constant];
+        }
+        return !reader->failed;
+    }
+
+    switch (opcode) {
+        case VBSM_OP_HALT:
+            instr->op = BVM_OP_HALT;
+            return 1;
+        case VBSM_OP_RET:
+            instr->op = BVM_OP_RET;
+            return 1;
+        case VBSM_OP_PROFDUMP:
+            instr->op = BVM_OP_PROFDUMP;
+            return 1;
+        case VBSM_OP_JMP:
+        case VBSM_OP_JEQ:
+        case VBSM_OP_JNE:
+        case VBSM_OP_JLT:
+        case VBSM_OP_JGT:
+        case VBSM_OP_JLE:
+        case VBSM_OP_JGE:
+        case VBSM_OP_CALL: {
+            int64_t offset = bvm_read_sleb(reader);
+            instr->op = (uint8_t)(opcode == VBSM_OP_CALL ? BVM_OP_CALL : BVM_OP_JMP + (opcode - VBSM_OP_JMP));
+            decoder->branch_offsets[index] = (int64_t)(reader->cursor - module->code) + offset;
+            return !reader->failed;
+        }
+        case VBSM_OP_JTAB: {
+            instr->op = BVM_OP_JTAB;
+            instr->a = bvm_read_byte(reader) >> 4;
+            instr->u.imm = bvm_read_sleb(reader);
+            uint64_t num_targets = bvm_read_uleb(reader);
+            if (reader->failed || num_targets >= (uint64_t)(reader->end - reader->cursor) / 4) return 0;
+            end_of_instr = reader->cursor + 4 * (num_targets + 1);
+            if (!bvm_grow((void**)&vm->jump_tables, &decoder->table_capacity, vm->num_jump_tables + 1,
+                          sizeof(BvmJumpTable)) ||
+                !bvm_grow((void**)&decoder->table_offsets, &decoder->table_offset_capacity,
+                          decoder->num_table_offsets + num_targets + 1, sizeof(int64_t))) {
+                return 0;
+            }
+            instr->aux = (uint32_t)vm->num_jump_tables;
+            BvmJumpTable* table = &vm->jump_tables[vm->num_jump_tables++];
+            table->first_target = (uint32_t)decoder->num_table_offsets;
+            table->num_targets = (uint32_t)num_targets;
+            for (uint64_t t = 0; t <= num_targets; t++) {
+                int32_t offset = bvm_read_i32(reader);
+                decoder->table_offsets[decoder->num_table_offsets++] = (int64_t)(end_of_instr - module->code) + offset;
+            }
+            return !reader->failed;
+        }
+        case VBSM_OP_SYSCALL: {
+            instr->op = BVM_OP_SYSCALL;
+            int64_t number = bvm_read_sleb(reader);
+            uint64_t num_args = bvm_read_uleb(reader);
+            if (reader->failed || num_args > BVM_MAX_SYSCALL_ARGS) return 0;
+            if (!bvm_grow((void**)&vm->syscall_sites, &decoder->site_capacity, vm->num_syscall_sites + 1,
+                          sizeof(BvmSyscallSite)) ||
+                !bvm_grow((void**)&vm->syscall_args, &decoder->arg_capacity, decoder->num_args + num_args + 1, 1)) {
+                return 0;
+            }
+            instr->aux = (uint32_t)vm->num_syscall_sites;
+            BvmSyscallSite* site = &vm->syscall_sites[vm->num_syscall_sites++];
+            memset(site, 0, sizeof(BvmSyscallSite));
+            site->number = number;
+            site->first_arg = (uint32_t)decoder->num_args;
+            site->num_args = (uint32_t)num_args;
+            for (uint64_t a = 0; a < num_args; a += 2) {
+                uint8_t registers = bvm_read_byte(reader);
+                vm->syscall_args[decoder->num_args++] = registers >> 4;
+                if (a + 1 < num_args) vm->syscall_args[decoder->num_args++] = registers & 0x0f;
+            }
+            return !reader->failed;
+        }
+        case VBSM_OP_PROFCNT: {
+            uint64_t counter = bvm_read_uleb(reader);
+            if (reader->failed || counter >= BVM_MAX_COUNTERS) return 0;
+            instr->op = BVM_OP_PROFCNT;
+            instr->aux = (uint32_t)counter;
+            if (counter >= vm->num_counters) vm->num_counters = (size_t)counter + 1;
+            return 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Modülün kodunu çözer ve dal hedeflerini komut pointer'larına bağlar.
+ * @return Başarılıysa 1, aksi takdirde 0 (stderr'e açıklama yazılır).
+ */
+static int bvm_decode(Bvm* vm) {
+    const VbsmModule* module = vm->module;
+    size_t capacity = module->code_size + 1;
+    BvmDecoder decoder;
+    memset(&decoder, 0, sizeof(decoder));
+    decoder.vm = vm;
+    decoder.branch_offsets = (int64_t*)malloc(sizeof(int64_t) * capacity);
+    int32_t* index_of_offset = (int32_t*)malloc(sizeof(int32_t) * capacity);
+    vm->code = (BvmInstr*)malloc(sizeof(BvmInstr) * capacity);
+    vm->code_offsets = (uint32_t*)malloc(sizeof(uint32_t) * capacity);
+    if (!decoder.branch_offsets || !index_of_offset || !vm->code || !vm->code_offsets) {
+        fprintf(stderr, "Hata: BVM: bayt kodu çözümü için bellek tahsis edilemedi.\n");
+        free(decoder.branch_offsets);
+        free(index_of_offset);
+        return 0;
+    }
+    for (size_t i = 0; i < capacity; i++) index_of_offset[i] = -1;
+
+    BvmReader reader = {module->code, module->code + module->code_size, 0};
+    size_t count = 0;
+    int ok = 1;
+    while (reader.cursor < reader.end) {
+        uint32_t offset = (uint32_t)(reader.cursor - module->code);
+        index_of_offset[offset] = (int32_t)count;
+        vm->code_offsets[count] = offset;
+        if (!bvm_decode_instruction(&decoder, &reader, &vm->code[count], count)) {
+            fprintf(stderr, "Hata: BVM: %u konumunda geçersiz veya kesik komut.\n", offset);
+            ok = 0;
+            break;
+        }
+        count++;
+    }
+    // Kodun sonu: dallar buraya da gidebilir, program biter
+    if (ok) {
+        index_of_offset[module->code_size] = (int32_t)count;
+        vm->code_offsets[count] = (uint32_t)module->code_size;
+        memset(&vm->code[count], 0, sizeof(BvmInstr));
+        vm->code[count].op = BVM_OP_HALT;
+        decoder.branch_offsets[count] = -1;
+        vm->code_length = count + 1;
+    }
+
+    // Dal hedeflerini bağla; hedef bir komutun başı olmalı. Hedefler ve dönüş adresleri
+    // üst-komutların içinde kalamayacakları için işaretlenir.
+    vm->branch_targets = (uint8_t*)calloc(capacity, 1);
+    if (ok && !vm->branch_targets) {
+        fprintf(stderr, "Hata: BVM: bayt kodu çözümü için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+    if (ok) vm->branch_targets[0] = 1;
+    for (size_t i = 0; i < count && ok; i++) {
+        vm->code[i].base_op = vm->code[i].op;
+        if (vm->code[i].op == BVM_OP_CALL) vm->branch_targets[i + 1] = 1;
+        int64_t target = decoder.branch_offsets[i];
+        if (target == -1) continue;
+        if (target < 0 || (uint64_t)target > module->code_size || index_of_offset[target] < 0) {
+            fprintf(stderr, "Hata: BVM: %u konumundaki dal bir komutun başına gitmiyor.\n", vm->code_offsets[i]);
+            ok = 0;
+            break;
+        }
+        vm->code[i].u.target = &vm->code[index_of_offset[target]];
+        vm->branch_targets[index_of_offset[target]] = 1;
+    }
+    if (ok) vm->code[count].base_op = BVM_OP_HALT;
+    if (ok && decoder.num_table_offsets > 0) {
+        vm->jump_targets = (const BvmInstr**)malloc(sizeof(BvmInstr*) * decoder.num_table_offsets);
+        ok = vm->jump_targets != NULL;
+        for (size_t t = 0; t < decoder.num_table_offsets && ok; t++) {
+            int64_t target = decoder.table_offsets[t];
+            if (target < 0 || (uint64_t)target > module->code_size || index_of_offset[target] < 0) {
+                fprintf(stderr, "Hata: BVM: atlama tablosu hedefi bir komutun başına gitmiyor.\n");
+                ok = 0;
+                break;
+            }
+            vm->jump_targets[t] = &vm->code[index_of_offset[target]];
+            vm->branch_targets[index_of_offset[target]] = 1;
+        }
+    }
+    if (ok && vm->num_counters > 0) {
+        vm->counters = (uint64_t*)calloc(vm->num_counters, sizeof(uint64_t));
+        ok = vm->counters != NULL;
+    }
+    vm->call_stack = (const BvmInstr**)malloc(sizeof(BvmInstr*) * BVM_MAX_CALL_DEPTH);
+    if (ok && !vm->call_stack) {
+        fprintf(stderr, "Hata: BVM: çağrı yığını için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+
+    free(decoder.branch_offsets);
+    free(decoder.table_offsets);
+    free(index_of_offset);
+    return ok;
+}
+
+// --- Üst-Komut Birleştirme ---
+
+/**
+ * @brief Üst-komut kalıbı i. kayıttan başlayan dizinin üzerine oturuyor mu? İlk kayıt dışında
+ * hiçbir kayıt bir dalın hedefi olamaz (içine atlanan dizi yarım yürütülürdü).
+ */
+static int bvm_pattern_matches(const Bvm* vm, size_t i, size_t end, const BvmPattern* pattern) {
+    if (i + pattern->length > end) return 0;
+    for (size_t k = 0; k < pattern->length; k++) {
+        if (vm->code[i + k].base_op != pattern->ops[k]) return 0;
+        if (k > 0 && vm->branch_targets[i + k]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Üst-komutları seçer ve dizilerin ilk kayıtlarına yazar. Örtüşen kalıplar arasında
+ * seçim dinamik programlamayla yapılır: kod boyunca kazanılan toplam ağırlık (kalıp başına
+ * kümedeki ağırlık; küme yoksa kalıbın kazandırdığı gönderim sayısı) en büyüklenir. Böylece
+ * "MOV+ADD" gibi bir çift, arkasındaki daha değerli bir "ADD+CMP+Jcc" üçlüsünü bozmaz.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int bvm_fuse(Bvm* vm, const BvmSuperinstructionSet* set) {
+    size_t end = vm->code_length - 1; // Sondaki HALT kaydı birleştirilmez
+    uint64_t* best = (uint64_t*)calloc(end + 1, sizeof(uint64_t));
+    int* choice = (int*)malloc(sizeof(int) * (end + 1));
+    if (!best || !choice) {
+        fprintf(stderr, "Hata: BVM: üst-komut seçimi için bellek tahsis edilemedi.\n");
+        free(best);
+        free(choice);
+        return 0;
+    }
+    for (size_t i = end; i-- > 0;) {
+        best[i] = best[i + 1];
+        choice[i] = -1;
+        for (int p = 0; p < BVM_NUM_SUPERINSTRUCTIONS; p++) {
+            const BvmPattern* pattern = &bvm_superinstruction_patterns[p];
+            uint64_t weight = set ? set->weights[p] : (uint64_t)(pattern->length - 1);
+            if (weight == 0 || !bvm_pattern_matches(vm, i, end, pattern)) continue;
+            if (weight + best[i + pattern->length] > best[i]) {
+                best[i] = weight + best[i + pattern->length];
+                choice[i] = p;
+            }
+        }
+    }
+    vm->num_fused = 0;
+    for (size_t i = 0; i < end;) {
+        if (choice[i] < 0) {
+            i++;
+            continue;
+        }
+        vm->code[i].op = (uint8_t)(BVM_FIRST_SUPERINSTRUCTION + choice[i]);
+        vm->num_fused++;
+        i += bvm_superinstruction_patterns[choice[i]].length;
+    }
+    free(best);
+    free(choice);
+    return 1;
+}
+
+// --- Yürütme ---
+
+/**
+ * @brief Yorumlayıcı döngüsü. 'handlers' NULL değilse yürütmeden işleyici adres tablosunu
+ * döndürür (etiket adresleri sadece bu fonksiyonun içinden alınabilir).
+ */
+static BvmStatus bvm_execute(Bvm* vm, const void* const** handlers) {
+#if BVM_COMPUTED_GOTO
+    static const void* const handler_table[BVM_OP_COUNT] = {
+        &&op_MOV_R, &&op_MOV_I, &&op_ADD_R, &&op_ADD_I, &&op_SUB_R, &&op_SUB_I,
+        &&op_MUL_R, &&op_MUL_I, &&op_DIV_R, &&op_DIV_I, &&op_CMP_R, &&op_CMP_I,
+        &&op_SELEQ_R, &&op_SELEQ_I, &&op_SELNE_R, &&op_SELNE_I, &&op_SELLT_R, &&op_SELLT_I,
+        &&op_SELGT_R, &&op_SELGT_I, &&op_SELLE_R, &&op_SELLE_I, &&op_SELGE_R, &&op_SELGE_I,
+        &&op_JMP, &&op_JEQ, &&op_JNE, &&op_JLT, &&op_JGT, &&op_JLE, &&op_JGE,
+        &&op_CALL, &&op_RET, &&op_JTAB, &&op_SYSCALL, &&op_PROFCNT, &&op_PROFDUMP, &&op_HALT,
+        &&op_CMP_R_JEQ, &&op_CMP_R_JNE, &&op_CMP_R_JLT, &&op_CMP_R_JGT, &&op_CMP_R_JLE, &&op_CMP_R_JGE,
+        &&op_CMP_I_JEQ, &&op_CMP_I_JNE, &&op_CMP_I_JLT, &&op_CMP_I_JGT, &&op_CMP_I_JLE, &&op_CMP_I_JGE,
+        &&op_MOV_R_ADD_R, &&op_MOV_R_ADD_I, &&op_MOV_R_SUB_R, &&op_MOV_R_SUB_I,
+        &&op_MOV_R_MUL_R, &&op_MOV_R_MUL_I,
+        &&op_ADD_I_CMP_R_JEQ, &&op_ADD_I_CMP_R_JNE, &&op_ADD_I_CMP_R_JLT,
+        &&op_ADD_I_CMP_R_JGT, &&op_ADD_I_CMP_R_JLE, &&op_ADD_I_CMP_R_JGE,
+        &&op_ADD_I_CMP_I_JEQ, &&op_ADD_I_CMP_I_JNE, &&op_ADD_I_CMP_I_JLT,
+        &&op_ADD_I_CMP_I_JGT, &&op_ADD_I_CMP_I_JLE, &&op_ADD_I_CMP_I_JGE,
+        &&op_SUB_I_CMP_R_JEQ, &&op_SUB_I_CMP_R_JNE, &&op_SUB_I_CMP_R_JLT,
+        &&op_SUB_I_CMP_R_JGT, &&op_SUB_I_CMP_R_JLE, &&op_SUB_I_CMP_R_JGE,
+        &&op_SUB_I_CMP_I_JEQ, &&op_SUB_I_CMP_I_JNE, &&op_SUB_I_CMP_I_JLT,
+        &&op_SUB_I_CMP_I_JGT, &&op_SUB_I_CMP_I_JLE, &&op_SUB_I_CMP_I_JGE,
+        &&op_PROFILE_DISPATCH, &&op_LOOP_HEADER,
+    };
+    if (handlers) {
+        *handlers = handler_table;
+        return BVM_STATUS_HALTED;
+    }
+#define BVM_OP(name) op_##name:
+#define BVM_DISPATCH() goto *ip->handler
+#define BVM_DISPATCH_AS(op) goto *handler_table[op]
+#else
+    if (handlers) {
+        *handlers = NULL;
+        return BVM_STATUS_HALTED;
+    }
+#define BVM_OP(name) case BVM_OP_##name:
+#define BVM_DISPATCH() goto dispatch
+#define BVM_DISPATCH_AS(op) \
+    do {                    \
+        current_op = (op);  \
+        goto dispatch_op;   \
+    } while (0)
+#endif
+
+    int64_t r[BVM_NUM_REGISTERS];   // Adresi dışarı verilmez (sistem çağrılarında vm->registers ile eşitlenir)
+    memcpy(r, vm->registers, sizeof(r));
+    int64_t flag_a = 0, flag_b = 0; // Bayraklar: son karşılaştırmanın iki tarafı
+    const BvmInstr* ip = vm->code;
+    const BvmInstr** call_stack = vm->call_stack;
+    size_t depth = 0;
+    BvmStatus status = BVM_STATUS_HALTED;
+    vm->exit_code = 0;
+
+#define BVM_ARITHMETIC(name, operator, flags)                                            \
+    BVM_OP(name##_R)                                                                     \
+    r[ip->a] = (int64_t)((uint64_t)r[ip->a] operator(uint64_t) r[ip->b]);                \
+    flags;                                                                               \
+    ip++;                                                                                \
+    BVM_DISPATCH();                                                                      \
+    BVM_OP(name##_I)                                                                     \
+    r[ip->a] = (int64_t)((uint64_t)r[ip->a] operator(uint64_t) ip->u.imm);               \
+    flags;                                                                               \
+    ip++;                                                                                \
+    BVM_DISPATCH();
+#define BVM_SET_RESULT_FLAGS (flag_a = r[ip->a], flag_b = 0)
+#define BVM_SELECT(name, condition)                                                      \
+    BVM_OP(name##_R)                                                                     \
+    if (condition) r[ip->a] = r[ip->b];                                                  \
+    ip++;                                                                                \
+    BVM_DISPATCH();                                                                      \
+    BVM_OP(name##_I)                                                                     \
+    if (condition) r[ip->a] = ip->u.imm;                                                 \
+    ip++;                                                                                \
+    BVM_DISPATCH();
+#define BVM_BRANCH(name, condition)                                                      \
+    BVM_OP(name)                                                                         \
+    ip = (condition) ? ip->u.target : ip + 1;                                            \
+    BVM_DISPATCH();
+// Üst-komutlar: operandlar dizinin sonraki kayıtlarından (ip[1], ip[2]) okunur
+#define BVM_COMPARE_BRANCH(name, operand, condition)                                     \
+    BVM_OP(name)                                                                         \
+    flag_a = r[ip->a];                                                                   \
+    flag_b = operand;                                                                    \
+    ip = (condition) ? ip[1].u.target : ip + 2;                                          \
+    BVM_DISPATCH();
+#define BVM_MOVE_ARITHMETIC(name, operator, operand, flags)                              \
+    BVM_OP(name)                                                                         \
+    r[ip->a] = r[ip->b];                                                                 \
+    r[ip[1].a] = (int64_t)((uint64_t)r[ip[1].a] operator(uint64_t)(operand));            \
+    flags;                                                                               \
+    ip += 2;                                                                             \
+    BVM_DISPATCH();
+#define BVM_SET_NEXT_RESULT_FLAGS (flag_a = r[ip[1].a], flag_b = 0)
+#define BVM_STEP_COMPARE_BRANCH(name, operator, operand, condition)                      \
+    BVM_OP(name)                                                                         \
+    r[ip->a] = (int64_t)((uint64_t)r[ip->a] operator(uint64_t) ip->u.imm);               \
+    flag_a = r[ip[1].a];                                                                 \
+    flag_b = operand;                                                                    \
+    ip = (condition) ? ip[2].u.target : ip + 3;                                          \
+    BVM_DISPATCH();
+
+#if BVM_COMPUTED_GOTO
+    BVM_DISPATCH();
+    {
+#else
+    uint8_t current_op;
+dispatch:
+    current_op = ip->op;
+dispatch_op:
+    switch ((BvmOp)current_op) {
+#endif
+        BVM_OP(MOV_R)
+        r[ip->a] = r[ip->b];
+        ip++;
+        BVM_DISPATCH();
+        BVM_OP(MOV_I)
+        r[ip->a] = ip->u.imm;
+        ip++;
+        BVM_DISPATCH();
+
+        BVM_ARITHMETIC(ADD, +, BVM_SET_RESULT_FLAGS)
+        BVM_ARITHMETIC(SUB, -, BVM_SET_RESULT_FLAGS)
+        BVM_ARITHMETIC(MUL, *, (void)0)
+
+        BVM_OP(DIV_R)
+        BVM_OP(DIV_I) {
+            int64_t divisor = ip->base_op == BVM_OP_DIV_R ? r[ip->b] : ip->u.imm;
+            if (divisor == 0) {
+                fprintf(stderr, "Hata: BVM: %u konumunda sıfıra bölme.\n", vm->code_offsets[ip - vm->code]);
+                status = BVM_STATUS_ERROR;
+                goto done;
+            }
+            // INT64_MIN / -1 taşar; sarmalı sonuç (INT64_MIN) verilir
+            r[ip->a] = divisor == -1 ? (int64_t)(0 - (uint64_t)r[ip->a]) : r[ip->a] / divisor;
+            ip++;
+            BVM_DISPATCH();
+        }
+
+        BVM_OP(CMP_R)
+        flag_a = r[ip->a];
+        flag_b = r[ip->b];
+        ip++;
+        BVM_DISPATCH();
+        BVM_OP(CMP_I)
+        flag_a = r[ip->a];
+        flag_b = ip->u.imm;
+        ip++;
+        BVM_DISPATCH();
+
+        BVM_SELECT(SELEQ, flag_a == flag_b)
+        BVM_SELECT(SELNE, flag_a != flag_b)
+        BVM_SELECT(SELLT, flag_a < flag_b)
+        BVM_SELECT(SELGT, flag_a > flag_b)
+        BVM_SELECT(SELLE, flag_a <= flag_b)
+        BVM_SELECT(SELGE, flag_a >= flag_b)
+
+        BVM_BRANCH(JMP, 1)
+        BVM_BRANCH(JEQ, flag_a == flag_b)
+        BVM_BRANCH(JNE, flag_a != flag_b)
+        BVM_BRANCH(JLT, flag_a < flag_b)
+        BVM_BRANCH(JGT, flag_a > flag_b)
+        BVM_BRANCH(JLE, flag_a <= flag_b)
+        BVM_BRANCH(JGE, flag_a >= flag_b)
+
+        BVM_OP(CALL)
+        if (depth == BVM_MAX_CALL_DEPTH) {
+            fprintf(stderr, "Hata: BVM: %u konumunda çağrı yığını taştı (derinlik %d).\n",
+                    vm->code_offsets[ip - vm->code], BVM_MAX_CALL_DEPTH);
+            status = BVM_STATUS_ERROR;
+            goto done;
+        }
+        call_stack[depth++] = ip + 1;
+        ip = ip->u.target;
+        BVM_DISPATCH();
+
+        BVM_OP(RET)
+        if (depth == 0) goto done;
+        ip = call_stack[--depth];
+        BVM_DISPATCH();
+
+        BVM_OP(JTAB) {
+            const BvmJumpTable* table = &vm->jump_tables[ip->aux];
+            uint64_t index = (uint64_t)r[ip->a] - (uint64_t)ip->u.imm;
+            ip = vm->jump_targets[table->first_target + (index < table->num_targets ? index + 1 : 0)];
+            BVM_DISPATCH();
+        }
+
+        BVM_OP(SYSCALL) {
+            const BvmSyscallSite* site = &vm->syscall_sites[ip->aux];
+            if (!site->handler) {
+                fprintf(stderr, "Hata: BVM: %u konumunda tanımsız sistem çağrısı %lld.\n",
+                        vm->code_offsets[ip - vm->code], (long long)site->number);
+                status = BVM_STATUS_ERROR;
+                goto done;
+            }
+            int64_t args[BVM_MAX_SYSCALL_ARGS];
+            for (uint32_t a = 0; a < site->num_args; a++) args[a] = r[vm->syscall_args[site->first_arg + a]];
+            memcpy(vm->registers, r, sizeof(r));
+            vm->call_depth = depth;
+            BvmSyscallResult result = site->handler(vm, args, site->num_args, site->user);
+            memcpy(r, vm->registers, sizeof(r));
+            if (result == BVM_SYSCALL_EXIT) goto done;
+            if (result == BVM_SYSCALL_ERROR) {
+                status = BVM_STATUS_ERROR;
+                goto done;
+            }
+            ip++;
+            BVM_DISPATCH();
+        }
+
+        BVM_OP(PROFCNT)
+        vm->counters[ip->aux]++;
+        ip++;
+        BVM_DISPATCH();
+
+        BVM_OP(PROFDUMP)
+        if (vm->profile_dump) vm->profile_dump(vm->counters, vm->num_counters, vm->profile_user);
+        ip++;
+        BVM_DISPATCH();
+
+        BVM_OP(HALT)
+        goto done;
+
+        BVM_COMPARE_BRANCH(CMP_R_JEQ, r[ip->b], flag_a == flag_b)
+        BVM_COMPARE_BRANCH(CMP_R_JNE, r[ip->b], flag_a != flag_b)
+        BVM_COMPARE_BRANCH(CMP_R_JLT, r[ip->b], flag_a < flag_b)
+        BVM_COMPARE_BRANCH(CMP_R_JGT, r[ip->b], flag_a > flag_b)
+        BVM_COMPARE_BRANCH(CMP_R_JLE, r[ip->b], flag_a <= flag_b)
+        BVM_COMPARE_BRANCH(CMP_R_JGE, r[ip->b], flag_a >= flag_b)
+        BVM_COMPARE_BRANCH(CMP_I_JEQ, ip->u.imm, flag_a == flag_b)
+        BVM_COMPARE_BRANCH(CMP_I_JNE, ip->u.imm, flag_a != flag_b)
+        BVM_COMPARE_BRANCH(CMP_I_JLT, ip->u.imm, flag_a < flag_b)
+        BVM_COMPARE_BRANCH(CMP_I_JGT, ip->u.imm, flag_a > flag_b)
+        BVM_COMPARE_BRANCH(CMP_I_JLE, ip->u.imm, flag_a <= flag_b)
+        BVM_COMPARE_BRANCH(CMP_I_JGE, ip->u.imm, flag_a >= flag_b)
+
+        BVM_MOVE_ARITHMETIC(MOV_R_ADD_R, +, r[ip[1].b], BVM_SET_NEXT_RESULT_FLAGS)
+        BVM_MOVE_ARITHMETIC(MOV_R_ADD_I, +, ip[1].u.imm, BVM_SET_NEXT_RESULT_FLAGS)
+        BVM_MOVE_ARITHMETIC(MOV_R_SUB_R, -, r[ip[1].b], BVM_SET_NEXT_RESULT_FLAGS)
+        BVM_MOVE_ARITHMETIC(MOV_R_SUB_I, -, ip[1].u.imm, BVM_SET_NEXT_RESULT_FLAGS)
+        BVM_MOVE_ARITHMETIC(MOV_R_MUL_R, *, r[ip[1].b], (void)0)
+        BVM_MOVE_ARITHMETIC(MOV_R_MUL_I, *, ip[1].u.imm, (void)0)
+
+        // ADD/SUB'un bayrakları hemen ardından gelen CMP tarafından ezilir
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_R_JEQ, +, r[ip[1].b], flag_a == flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_R_JNE, +, r[ip[1].b], flag_a != flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_R_JLT, +, r[ip[1].b], flag_a < flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_R_JGT, +, r[ip[1].b], flag_a > flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_R_JLE, +, r[ip[1].b], flag_a <= flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_R_JGE, +, r[ip[1].b], flag_a >= flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_I_JEQ, +, ip[1].u.imm, flag_a == flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_I_JNE, +, ip[1].u.imm, flag_a != flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_I_JLT, +, ip[1].u.imm, flag_a < flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_I_JGT, +, ip[1].u.imm, flag_a > flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_I_JLE, +, ip[1].u.imm, flag_a <= flag_b)
+        BVM_STEP_COMPARE_BRANCH(ADD_I_CMP_I_JGE, +, ip[1].u.imm, flag_a >= flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_R_JEQ, -, r[ip[1].b], flag_a == flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_R_JNE, -, r[ip[1].b], flag_a != flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_R_JLT, -, r[ip[1].b], flag_a < flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_R_JGT, -, r[ip[1].b], flag_a > flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_R_JLE, -, r[ip[1].b], flag_a <= flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_R_JGE, -, r[ip[1].b], flag_a >= flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_I_JEQ, -, ip[1].u.imm, flag_a == flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_I_JNE, -, ip[1].u.imm, flag_a != flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_I_JLT, -, ip[1].u.imm, flag_a < flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_I_JGT, -, ip[1].u.imm, flag_a > flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_I_JLE, -, ip[1].u.imm, flag_a <= flag_b)
+        BVM_STEP_COMPARE_BRANCH(SUB_I_CMP_I_JGE, -, ip[1].u.imm, flag_a >= flag_b)
+
+        BVM_OP(PROFILE_DISPATCH)
+        vm->dispatch_counts[ip - vm->code]++;
+        BVM_DISPATCH_AS(ip->base_op);
+
+        BVM_OP(LOOP_HEADER) {
+            size_t index = (size_t)(ip - vm->code);
+            if (++vm->loop_counts[index] >= vm->loop_threshold) {
+                BvmLoopAction action =
+                    vm->loop_hook(vm, vm->code_offsets[index], vm->loop_counts[index], vm->loop_user);
+                if (action == BVM_LOOP_TRANSFER) {
+                    vm->resume_offset = vm->code_offsets[index];
+                    status = BVM_STATUS_SUSPENDED;
+                    goto done;
+                }
+                if (action == BVM_LOOP_STOP_COUNTING) {
+                    // Kayıt asıl işlemine döner; bu döngü başı artık sayılmaz
+                    vm->code[index].op = vm->loop_ops[index];
+#if BVM_COMPUTED_GOTO
+                    vm->code[index].handler = handler_table[vm->loop_ops[index]];
+#endif
+                }
+            }
+            BVM_DISPATCH_AS(vm->loop_ops[index]);
+        }
+#if !BVM_COMPUTED_GOTO
+        default:
+            status = BVM_STATUS_ERROR;
+            goto done;
+#endif
+    }
+
+#undef BVM_ARITHMETIC
+#undef BVM_SET_RESULT_FLAGS
+#undef BVM_SELECT
+#undef BVM_BRANCH
+#undef BVM_COMPARE_BRANCH
+#undef BVM_MOVE_ARITHMETIC
+#undef BVM_SET_NEXT_RESULT_FLAGS
+#undef BVM_STEP_COMPARE_BRANCH
+#undef BVM_OP
+#undef BVM_DISPATCH
+#undef BVM_DISPATCH_AS
+
+done:
+    memcpy(vm->registers, r, sizeof(r));
+    vm->flags[0] = flag_a;
+    vm->flags[1] = flag_b;
+    vm->call_depth = depth;
+    return status;
+}
+
+BvmStatus bvm_run(Bvm* vm) {
+    return bvm_execute(vm, NULL);
+}
+
+// --- Sistem Çağrıları ---
+
+static BvmSyscallResult bvm_syscall_exit(Bvm* vm, const int64_t* args, size_t num_args, void* user) {
+    (void)user;
+    vm->exit_code = num_args > 0 ? args[0] : vm->registers[0];
+    return BVM_SYSCALL_EXIT;
+}
+
+static BvmSyscallResult bvm_hypercall_print(Bvm* vm, const int64_t* args, size_t num_args, void* user) {
+    (void)vm;
+    (void)user;
+    for (size_t a = 0; a < num_args; a++) printf(a ? " %lld" : "%lld", (long long)args[a]);
+    printf("\n");
+    return BVM_SYSCALL_CONTINUE;
+}
+
+int bvm_register_syscall(Bvm* vm, int64_t number, BvmSyscallHandler handler, void* user) {
+    size_t s = 0;
+    while (s < vm->num_syscalls && vm->syscalls[s].number != number) s++;
+    if (s == vm->num_syscalls) {
+        if (!bvm_grow((void**)&vm->syscalls, &vm->syscall_capacity, vm->num_syscalls + 1, sizeof(BvmSyscall))) {
+            fprintf(stderr, "Hata: BVM: sistem çağrısı tablosu için bellek tahsis edilemedi.\n");
+            return 0;
+        }
+        vm->num_syscalls++;
+    }
+    vm->syscalls[s].number = number;
+    vm->syscalls[s].handler = handler;
+    vm->syscalls[s].user = user;
+    // İşleyiciler çözülmüş sitelere doğrudan yazılır; yürütme sırasında tablo araması yapılmaz
+    for (size_t i = 0; i < vm->num_syscall_sites; i++) {
+        if (vm->syscall_sites[i].number != number) continue;
+        vm->syscall_sites[i].handler = handler;
+        vm->syscall_sites[i].user = user;
+    }
+    return 1;
+}
+
+// --- Gönderim Profili ---
+
+/**
+ * @brief Her kayda işlem kodunun işleyicisini yazar (switch yedeğinde NULL).
+ */
+static void bvm_bind_handlers(Bvm* vm) {
+    const void* const* handlers;
+    bvm_execute(vm, &handlers);
+    for (size_t i = 0; i < vm->code_length; i++) vm->code[i].handler = handlers ? handlers[vm->code[i].op] : NULL;
+}
+
+int bvm_enable_dispatch_profile(Bvm* vm) {
+    if (!vm->dispatch_counts) {
+        vm->dispatch_counts = (uint64_t*)calloc(vm->code_length, sizeof(uint64_t));
+        if (!vm->dispatch_counts) {
+            fprintf(stderr, "Hata: BVM: gönderim profili için bellek tahsis edilemedi.\n");
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < vm->code_length; i++) vm->code[i].op = BVM_OP_PROFILE_DISPATCH;
+    vm->num_fused = 0;
+    bvm_bind_handlers(vm);
+    return 1;
+}
+
+// --- Döngü Sayaçları ---
+
+int bvm_enable_loop_counting(Bvm* vm, uint64_t threshold, BvmLoopHook hook, void* user) {
+    if (!vm->loop_counts) {
+        vm->loop_counts = (uint64_t*)calloc(vm->code_length, sizeof(uint64_t));
+        vm->loop_ops = (uint8_t*)malloc(vm->code_length);
+        if (!vm->loop_counts || !vm->loop_ops) {
+            fprintf(stderr, "Hata: BVM: döngü sayaçları için bellek tahsis edilemedi.\n");
+            return 0;
+        }
+    }
+    vm->loop_threshold = threshold ? threshold : 1;
+    vm->loop_hook = hook;
+    vm->loop_user = user;
+    // Geri dalların (hedefi dalın kendisinden önce olan) hedefleri döngü başlarıdır; birleştirilmiş
+    // dizilerde dal kaydı hedefini korur
+    for (size_t i = 0; i < vm->code_length; i++) {
+        uint8_t op = vm->code[i].base_op;
+        if (op < BVM_OP_JMP || op > BVM_OP_JGE) continue;
+        size_t target = (size_t)(vm->code[i].u.target - vm->code);
+        if (target > i || vm->code[target].op == BVM_OP_LOOP_HEADER) continue;
+        vm->loop_ops[target] = vm->code[target].op;
+        vm->code[target].op = BVM_OP_LOOP_HEADER;
+    }
+    bvm_bind_handlers(vm);
+    return 1;
+}
+
+int bvm_call_sites(const Bvm* vm, uint32_t* sites) {
+    uint32_t* ordinals = (uint32_t*)malloc(sizeof(uint32_t) * (vm->code_length + 1));
+    if (!ordinals) {
+        fprintf(stderr, "Hata: BVM: çağrı yığını dökümü için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    uint32_t calls = 0;
+    for (size_t i = 0; i < vm->code_length; i++) {
+        ordinals[i] = calls;
+        if (vm->code[i].base_op == BVM_OP_CALL) calls++;
+    }
+    // Dönüş adresi çağrının bir sonraki kaydıdır
+    for (size_t d = 0; d < vm->call_depth; d++) sites[d] = ordinals[vm->call_stack[d] - 1 - vm->code];
+    free(ordinals);
+    return 1;
+}
+
+typedef struct {
+    uint64_t count;
+    uint8_t ops[BVM_MAX_FUSED];
+    uint8_t length;
+} BvmSequenceCount;
+
+static int bvm_compare_sequence_counts(const void* left, const void* right) {
+    const BvmSequenceCount* a = (const BvmSequenceCount*)left;
+    const BvmSequenceCount* b = (const BvmSequenceCount*)right;
+    if (a->count != b->count) return a->count < b->count ? 1 : -1;
+    if (a->length != b->length) return a->length < b->length ? 1 : -1;
+    return memcmp(a->ops, b->ops, sizeof(a->ops));
+}
+
+int bvm_write_dispatch_profile(const Bvm* vm, const char* path) {
+    if (!vm->dispatch_counts) {
+        fprintf(stderr, "Hata: BVM: gönderim profili açılmadan yürütüldü.\n");
+        return 0;
+    }
+    // Diziler işlem kodlarına göre toplanır: çiftler N*N, üçlüler N*N*N tabloda
+    const size_t n = BVM_NUM_BASE_OPS;
+    uint64_t* pairs = (uint64_t*)calloc(n * n, sizeof(uint64_t));
+    uint64_t* triples = (uint64_t*)calloc(n * n * n, sizeof(uint64_t));
+    BvmSequenceCount* sequences = NULL;
+    size_t num_sequences = 0, sequence_capacity = 0;
+    uint64_t total = 0;
+    int ok = pairs && triples;
+    size_t end = vm->code_length - 1;
+    for (size_t i = 0; i < end && ok; i++) {
+        const BvmInstr* code = vm->code;
+        uint64_t count = vm->dispatch_counts[i];
+        total += count;
+        // Birleştirilebilir diziler: araya dal hedefi girmeyen, akışı sadece sonda değişen komutlar
+        if (count == 0 || !bvm_falls_through(code[i].base_op) || i + 1 >= end || vm->branch_targets[i + 1]) continue;
+        pairs[code[i].base_op * n + code[i + 1].base_op] += count;
+        if (!bvm_falls_through(code[i + 1].base_op) || i + 2 >= end || vm->branch_targets[i + 2]) continue;
+        triples[(code[i].base_op * n + code[i + 1].base_op) * n + code[i + 2].base_op] += count;
+    }
+    for (size_t k = 0; k < n * n * n && ok; k++) {
+        for (uint8_t length = 2; length <= 3; length++) {
+            if (length == 2 ? (k >= n * n || pairs[k] == 0) : triples[k] == 0) continue;
+            if (!bvm_grow((void**)&sequences, &sequence_capacity, num_sequences + 1, sizeof(BvmSequenceCount))) {
+                ok = 0;
+                break;
+            }
+            BvmSequenceCount* sequence = &sequences[num_sequences++];
+            memset(sequence, 0, sizeof(BvmSequenceCount));
+            sequence->length = length;
+            sequence->count = length == 2 ? pairs[k] : triples[k];
+            size_t key = k;
+            for (int position = length - 1; position >= 0; position--) {
+                sequence->ops[position] = (uint8_t)(key % n);
+                key /= n;
+            }
+        }
+    }
+    free(pairs);
+    free(triples);
+    if (!ok) {
+        fprintf(stderr, "Hata: BVM: gönderim profili için bellek tahsis edilemedi.\n");
+        free(sequences);
+        return 0;
+    }
+    if (num_sequences > 0) qsort(sequences, num_sequences, sizeof(BvmSequenceCount), bvm_compare_sequence_counts);
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Hata: '%s' gönderim profili yazmak için açılamadı.\n", path);
+        free(sequences);
+        return 0;
+    }
+    fprintf(file, "%s %d\n", BVM_DISPATCH_PROFILE_MAGIC, BVM_DISPATCH_PROFILE_VERSION);
+    fprintf(file, "# BVM gönderim profili: <yürütme sayısı> <işlem>... (toplam %" PRIu64 " komut)\n", total);
+    for (size_t q = 0; q < num_sequences; q++) {
+        fprintf(file, "%" PRIu64, sequences[q].count);
+        for (uint8_t k = 0; k < sequences[q].length; k++) fprintf(file, " %s", bvm_op_names[sequences[q].ops[k]]);
+        fprintf(file, "\n");
+    }
+    free(sequences);
+    ok = !ferror(file);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) fprintf(stderr, "Hata: '%s' gönderim profiline yazılamadı.\n", path);
+    return ok;
+}
+
+/**
+ * @brief Profil satırını ayrıştırır: "<sayı> <işlem> <işlem> [<işlem>]".
+ * @return Geçerliyse 1, aksi takdirde 0.
+ */
+static int bvm_parse_profile_line(char* line, BvmSequenceCount* sequence) {
+    char* cursor = line;
+    char* token_end;
+    memset(sequence, 0, sizeof(BvmSequenceCount));
+    if (*cursor < '0' || *cursor > '9') return 0;
+    sequence->count = strtoull(cursor, &token_end, 10);
+    cursor = token_end;
+    while (*cursor) {
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        if (!*cursor) break;
+        token_end = cursor + strcspn(cursor, " \t");
+        char saved = *token_end;
+        *token_end = '\0';
+        int op = 0;
+        while (op < BVM_NUM_BASE_OPS && strcmp(bvm_op_names[op], cursor) != 0) op++;
+        *token_end = saved;
+        if (op == BVM_NUM_BASE_OPS || sequence->length == BVM_MAX_FUSED) return 0;
+        sequence->ops[sequence->length++] = (uint8_t)op;
+        cursor = token_end;
+    }
+    return sequence->length >= 2;
+}
+
+BvmSuperinstructionSet* bvm_superinstructions_load(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Hata: '%s' gönderim profili açılamadı.\n", path);
+        return NULL;
+    }
+    char line[BVM_PROFILE_LINE_MAX];
+    char header[32];
+    snprintf(header, sizeof(header), "%s %d", BVM_DISPATCH_PROFILE_MAGIC, BVM_DISPATCH_PROFILE_VERSION);
+    if (!fgets(line, sizeof(line), file) || strncmp(line, header, strlen(header)) != 0 ||
+        (line[strlen(header)] != '\n' && line[strlen(header)] != '\r' && line[strlen(header)] != '\0')) {
+        fprintf(stderr, "Hata: '%s' geçerli bir gönderim profili değil (beklenen başlık '%s').\n", path, header);
+        fclose(file);
+        return NULL;
+    }
+    BvmSuperinstructionSet* set = (BvmSuperinstructionSet*)calloc(1, sizeof(BvmSuperinstructionSet));
+    if (!set) {
+        fprintf(stderr, "Hata: Üst-komut kümesi için bellek tahsis edilemedi.\n");
+        fclose(file);
+        return NULL;
+    }
+    int line_number = 1;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        char* text = line;
+        while (*text == ' ' || *text == '\t') text++;
+        if (!*text || *text == '#') continue;
+        BvmSequenceCount sequence;
+        if (!bvm_parse_profile_line(text, &sequence)) {
+            fprintf(stderr, "Uyarı: '%s' satır %d: geçersiz profil satırı atlandı.\n", path, line_number);
+            continue;
+        }
+        // Ağırlık: dizinin her yürütmesinde kazanılan gönderim sayısı x sıklık
+        for (int p = 0; p < BVM_NUM_SUPERINSTRUCTIONS; p++) {
+            const BvmPattern* pattern = &bvm_superinstruction_patterns[p];
+            if (pattern->length != sequence.length || memcmp(pattern->ops, sequence.ops, sequence.length) != 0) continue;
+            uint64_t count = sequence.count < BVM_MAX_PROFILE_WEIGHT ? sequence.count : BVM_MAX_PROFILE_WEIGHT;
+            set->weights[p] += count * (uint64_t)(pattern->length - 1);
+            if (set->weights[p] > BVM_MAX_PROFILE_WEIGHT) set->weights[p] = BVM_MAX_PROFILE_WEIGHT;
+        }
+    }
+    fclose(file);
+    return set;
+}
+
+void bvm_superinstructions_free(BvmSuperinstructionSet* set) {
+    free(set);
+}
+
+// --- Oluşturma ---
+
+Bvm* bvm_create(const VbsmModule* module, const BvmSuperinstructionSet* superinstructions) {
+    Bvm* vm = (Bvm*)calloc(1, sizeof(Bvm));
+    if (!vm) {
+        fprintf(stderr, "Hata: BVM için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    vm->module = module;
+    if (!bvm_decode(vm) || !bvm_fuse(vm, superinstructions)) {
+        bvm_free(vm);
+        return NULL;
+    }
+    bvm_bind_handlers(vm);
+
+    if (!bvm_register_syscall(vm, BVM_SYS_EXIT, bvm_syscall_exit, NULL) ||
+        !bvm_register_syscall(vm, BVM_SYS_EXIT_GROUP, bvm_syscall_exit, NULL) ||
+        !bvm_register_syscall(vm, BVM_HYPERCALL_PRINT, bvm_hypercall_print, NULL)) {
+        bvm_free(vm);
+        return NULL;
+    }
+    return vm;
+}
+
+void bvm_free(Bvm* vm) {
+    if (!vm) return;
+    free(vm->code);
+    free(vm->code_offsets);
+    free(vm->branch_targets);
+    free(vm->dispatch_counts);
+    free(vm->syscall_sites);
+    free(vm->syscall_args);
+    free(vm->jump_tables);
+    free(vm->jump_targets);
+    free(vm->syscalls);
+    free(vm->call_stack);
+    free(vm->counters);
+    free(vm->loop_counts);
+    free(vm->loop_ops);
+    free(vm);
+}
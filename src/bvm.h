@@ -0,0 +1,231 @@
+#ifndef BVM_H
+#define BVM_H
+
+#include "vbsm.h" // VbsmModule (yürütülecek bayt kodu)
+#include <stdint.h> // int64_t, uint64_t için
+#include <stddef.h> // size_t için
+
+// --- Bessambly Sanal Makinesi (BVM) ---
+// .vbsm bayt kodu yürütülmeden önce bir kez çözülür (pre-decode): değişken uzunluklu komutlar
+// sabit boyutlu kayıtlara açılır, LEB128 sabitleri ve havuz girdileri yerine konur, dal
+// uzaklıkları doğrudan hedef kayda işaret eden pointer'lara çevrilir ve her kayda işleyicisinin
+// adresi yazılır. Yürütme doğrudan iş parçacıklıdır (direct threading): her işleyici bir sonraki
+// kaydın adresine "goto *" ile atlar (GCC/Clang hesaplanmış goto). Bu uzantı olmayan
+// derleyicilerde aynı işleyiciler bir switch döngüsüyle çalışır.
+//
+// Yürütme sırasında 16 kaydedici yerel bir dizide tutulur; adresi dışarı verilmediği için
+// derleyici bunları makine kaydedicilerinde tutabilir. Bvm.registers sadece yürütmenin başında,
+// sonunda ve sistem çağrısı işleyicilerine girerken eşitlenir.
+//
+// Üst-komutlar (superinstructions): çözücü sık görülen bitişik komut dizilerini (CMP+Jcc,
+// MOV+ADD, döngü sonlarındaki ADD+CMP+Jcc gibi) tek bir işleyicide birleştirir; dizinin ilk
+// kaydı birleşik işleyiciyi gösterir, diğer kayıtlar sadece operandlarını taşır. Böylece dizi
+// başına tek gönderim (dispatch) yapılır. İşleyiciler sabit bir katalogdadır; hangilerinin
+// kullanılacağı bir gönderim profilinden seçilir (bkz. bvm_enable_dispatch_profile). Bir dalın,
+// çağrının veya atlama tablosunun hedefi olan kayıt bir dizinin içinde kalamaz.
+//
+// Anlam (referans):
+//  - ADD/SUB sonucu bayraklara yazar (sonuç, 0); CMP (a, b) yazar. Diğer komutlar bayrakları
+//    değiştirmez (IR'da bozulan bayraklar zaten okunmaz).
+//  - Aritmetik 64-bit ve taşmada sarmalıdır. Sıfıra bölme bir yürütme hatasıdır.
+//  - Çağrı yığını boşken RET veya kodun sonu programı 0 çıkış koduyla bitirir.
+//
+// Döngü sayaçları (bkz. bvm_enable_loop_counting): geri dalların hedefleri döngü başı kabul
+// edilir ve her girişte sayılır. Sayaç eşiği geçince kanca çağrılır; kanca yürütmeyi başka bir
+// yürütücüye devredebilir (yerinde geçiş, OSR). Devirde kaydediciler, bayraklar ve çağrı yığını
+// Bvm'de kalır; yürütme BVM'de sürdürülmez.
+
+#define BVM_NUM_REGISTERS 16
+#define BVM_MAX_CALL_DEPTH 4096
+
+// --- Yerleşik Sistem Çağrıları ---
+#define BVM_SYS_EXIT 60             // exit(kod): ilk argüman (yoksa R0) çıkış kodudur
+#define BVM_SYS_EXIT_GROUP 231      // exit_group(kod): exit ile aynı
+#define BVM_HYPERCALL_PRINT 0x1000  // BVM çağrısı: argümanları ondalık olarak stdout'a yazar
+
+// --- Gönderim Profili Dosyası ---
+// Metin biçimi: ilk satır "BVMDISPATCH <sürüm>", '#' ile başlayan satırlar yorumdur, diğer
+// satırlar "<yürütme sayısı> <işlem> <işlem> [<işlem>]" biçiminde birleştirilebilir bitişik bir
+// diziyi ve kaç kez yürütüldüğünü verir (katalogda işleyicisi olmayan diziler de yazılır).
+#define BVM_DISPATCH_PROFILE_MAGIC "BVMDISPATCH"
+#define BVM_DISPATCH_PROFILE_VERSION 1
+
+// --- Yürütme Sonucu ---
+typedef enum {
+    BVM_STATUS_HALTED,      // Program bitti (Bvm.exit_code geçerli)
+    BVM_STATUS_ERROR,       // Yürütme hatası (stderr'e açıklama yazıldı)
+    BVM_STATUS_SUSPENDED    // Döngü kancası yürütmeyi devraldı (Bvm.resume_offset'teki döngü başında)
+} BvmStatus;
+
+// --- Döngü Kancası Kararı ---
+typedef enum {
+    BVM_LOOP_CONTINUE,      // Yorumlamaya devam et (kanca bir sonraki girişte yine çağrılır)
+    BVM_LOOP_STOP_COUNTING, // Bu döngü başını artık sayma
+    BVM_LOOP_TRANSFER       // Yürütmeyi döngü başında durdur (BVM_STATUS_SUSPENDED)
+} BvmLoopAction;
+
+// --- Sistem Çağrısı İşleyicisi Sonucu ---
+typedef enum {
+    BVM_SYSCALL_CONTINUE,   // Yürütmeye devam et
+    BVM_SYSCALL_EXIT,       // Programı bitir (işleyici Bvm.exit_code'u ayarlar)
+    BVM_SYSCALL_ERROR       // Yürütme hatası
+} BvmSyscallResult;
+
+struct Bvm;
+typedef struct BvmInstr BvmInstr;       // Çözülmüş komut (bvm.c'ye özel)
+typedef struct BvmSyscallSite BvmSyscallSite;
+typedef struct BvmJumpTable BvmJumpTable;
+typedef struct BvmSuperinstructionSet BvmSuperinstructionSet; // Birleştirilecek üst-komutlar ve ağırlıkları
+
+/**
+ * @brief Sistem çağrısı işleyicisi. Kaydediciler vm->registers içinde okunabilir ve
+ * değiştirilebilir (sonuç için R0 kullanılır).
+ * @param vm Sanal makine.
+ * @param args SYSCALL komutunda verilen argüman kaydedicilerinin değerleri.
+ * @param num_args Argüman sayısı.
+ * @param user bvm_register_syscall'a verilen kullanıcı verisi.
+ */
+typedef BvmSyscallResult (*BvmSyscallHandler)(struct Bvm* vm, const int64_t* args, size_t num_args, void* user);
+
+/**
+ * @brief Döngü kancası: sayacı eşiği geçen bir döngü başına her girişte çağrılır.
+ * @param vm Sanal makine (kaydediciler henüz eşitlenmemiştir).
+ * @param header_offset Döngü başının bayt kodundaki konumu.
+ * @param count Döngü başına giriş sayısı.
+ * @param user bvm_enable_loop_counting'e verilen kullanıcı verisi.
+ */
+typedef BvmLoopAction (*BvmLoopHook)(struct Bvm* vm, uint32_t header_offset, uint64_t count, void* user);
+
+// --- Sistem Çağrısı Tablosu Girdisi ---
+typedef struct {
+    int64_t number;
+    BvmSyscallHandler handler;
+    void* user;
+} BvmSyscall;
+
+// --- Sanal Makine ---
+typedef struct Bvm {
+    const VbsmModule* module;       // Yürütülen modül (Bvm'e ait değildir)
+
+    BvmInstr* code;                 // Çözülmüş komutlar (sonda bir HALT kaydı)
+    uint32_t* code_offsets;         // Her çözülmüş komutun bayt kodundaki konumu (hata mesajları için)
+    size_t code_length;
+    uint8_t* branch_targets;        // Kayıt başına: dal/çağrı/tablo hedefi veya dönüş adresi mi
+    size_t num_fused;               // Birleştirilmiş üst-komut sayısı
+    uint64_t* dispatch_counts;      // Kayıt başına yürütme sayısı (gönderim profili açıksa)
+    BvmSyscallSite* syscall_sites;  // SYSCALL komutlarının numara, argüman ve işleyicileri
+    size_t num_syscall_sites;
+    uint8_t* syscall_args;          // Sitelerin argüman kaydedicileri
+    BvmJumpTable* jump_tables;
+    size_t num_jump_tables;
+    const BvmInstr** jump_targets;  // Atlama tablolarının hedefleri
+
+    BvmSyscall* syscalls;           // Takılabilir sistem çağrısı tablosu
+    size_t num_syscalls;
+    size_t syscall_capacity;
+
+    int64_t registers[BVM_NUM_REGISTERS];
+    int64_t flags[2];               // Son karşılaştırmanın iki tarafı (yürütme bitince veya devredilince)
+    int64_t exit_code;
+    const BvmInstr** call_stack;    // Dönüş adresleri
+    size_t call_depth;
+
+    uint64_t* counters;             // PROFCNT sayaçları
+    size_t num_counters;
+    void (*profile_dump)(const uint64_t* counters, size_t num_counters, void* user); // PROFDUMP'ta (NULL olabilir)
+    void* profile_user;
+
+    uint64_t* loop_counts;          // Kayıt başına döngü başı giriş sayısı (döngü sayaçları açıksa)
+    uint8_t* loop_ops;              // Döngü başı kayıtlarının asıl işlemleri
+    uint64_t loop_threshold;
+    BvmLoopHook loop_hook;
+    void* loop_user;
+    uint32_t resume_offset;         // BVM_STATUS_SUSPENDED: yürütmenin devredildiği döngü başı
+} Bvm;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Modülü çözer, üst-komutları birleştirir ve yerleşik sistem çağrılarıyla bir sanal
+ * makine oluşturur. Bozuk bayt kodu (sınır dışı okuma, komut ortasına dal, geçersiz işlem
+ * kodu) reddedilir.
+ * @param module Yürütülecek modül (Bvm serbest bırakılana kadar geçerli kalmalı).
+ * @param superinstructions Birleştirilecek üst-komutlar (NULL: yerleşik varsayılan küme).
+ * @return Yeni Bvm pointer'ı veya NULL hata durumunda.
+ */
+Bvm* bvm_create(const VbsmModule* module, const BvmSuperinstructionSet* superinstructions);
+
+/**
+ * @brief Sanal makineyi serbest bırakır.
+ * @param vm Serbest bırakılacak Bvm pointer'ı.
+ */
+void bvm_free(Bvm* vm);
+
+/**
+ * @brief Bir sistem çağrısı numarasına işleyici bağlar (varsa öncekinin yerine geçer).
+ * @param vm Sanal makine.
+ * @param number Sistem çağrısı numarası.
+ * @param handler İşleyici (NULL: çağrı tanımsız olur).
+ * @param user İşleyiciye verilecek kullanıcı verisi.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int bvm_register_syscall(Bvm* vm, int64_t number, BvmSyscallHandler handler, void* user);
+
+/**
+ * @brief Programı baştan yürütür. Kaydediciler vm->registers'tan başlar; sayaçlar birikir.
+ * @param vm Sanal makine.
+ * @return BVM_STATUS_HALTED veya BVM_STATUS_ERROR.
+ */
+BvmStatus bvm_run(Bvm* vm);
+
+/**
+ * @brief Döngü sayaçlarını açar: geri dalların hedefleri sayılır ve sayaç 'threshold'a ulaşınca
+ * her girişte kanca çağrılır. Sayılmayan kayıtların yürütmesi yavaşlamaz. bvm_run'dan önce çağrılmalıdır.
+ * @param vm Sanal makine.
+ * @param threshold Kancanın çağrılmaya başladığı giriş sayısı (0 ise 1).
+ * @param hook Döngü kancası.
+ * @param user Kancaya verilecek kullanıcı verisi.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int bvm_enable_loop_counting(Bvm* vm, uint64_t threshold, BvmLoopHook hook, void* user);
+
+/**
+ * @brief Çağrı yığınındaki her çerçeveyi oluşturan CALL komutunun sıra numarasını yazar
+ * (kodda baştan itibaren kaçıncı CALL olduğu; dıştaki çerçeve önce).
+ * @param vm Sanal makine (yürütmesi devredilmiş).
+ * @param sites vm->call_depth elemanlık çıktı dizisi.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int bvm_call_sites(const Bvm* vm, uint32_t* sites);
+
+/**
+ * @brief Gönderim profilini açar: üst-komutlar çözülür (her komut ayrı gönderilir) ve her
+ * kaydın kaç kez yürütüldüğü sayılır. bvm_run'dan önce çağrılmalıdır.
+ * @param vm Sanal makine.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int bvm_enable_dispatch_profile(Bvm* vm);
+
+/**
+ * @brief Yürütülen birleştirilebilir bitişik komut çiftlerini ve üçlülerini sıklıklarıyla
+ * gönderim profili dosyasına yazar (sıklığa göre azalan sırada).
+ * @param vm Gönderim profili açık olarak yürütülmüş sanal makine.
+ * @param path Dosya yolu.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int bvm_write_dispatch_profile(const Bvm* vm, const char* path);
+
+/**
+ * @brief Gönderim profilinden üst-komut kümesini seçer: katalogdaki her dizi profildeki
+ * sıklığı kadar ağırlık alır, hiç yürütülmemiş diziler birleştirilmez.
+ * @param path Gönderim profili dosya yolu.
+ * @return Yeni küme veya NULL hata durumunda.
+ */
+BvmSuperinstructionSet* bvm_superinstructions_load(const char* path);
+
+/**
+ * @brief Üst-komut kümesini serbest bırakır.
+ */
+void bvm_superinstructions_free(BvmSuperinstructionSet* set);
+
+#endif // BVM_H
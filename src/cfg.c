@@ -0,0 +1,1194 @@
+#include "cfg.h"
+#include <stdlib.h> // malloc, free, calloc, qsort, bsearch
+#include <stdio.h>  // fprintf, snprintf
+#include <string.h> // strcmp, memset
+
+// --- Dahili Yardımcı Fonksiyonlar ---
+
+/**
+ * @brief Bir komutun tek etiket operandlı bir atlama olup olmadığını kontrol eder
+ * ve hedef etiket adını döndürür.
+ * @param instr Kontrol edilecek komut düğümü.
+ * @return Hedef etiket adı veya atlama değilse NULL.
+ */
+static const char* branch_target_label(const AstNode* instr) {
+    if (!instr || instr->type != AST_INSTRUCTION) return NULL;
+    TokenType op = instr->data.instruction.opcode;
+    if (op != TOKEN_JMP && !cfg_is_conditional_branch(op)) return NULL;
+    if (instr->data.instruction.num_operands != 1 ||
+        instr->data.instruction.operands[0].type != OP_LABEL_REF) {
+        return NULL;
+    }
+    return instr->data.instruction.operands[0].value.label_name;
+}
+
+static int compare_cfg_labels(const void* a, const void* b) {
+    return strcmp(((const CfgLabel*)a)->name, ((const CfgLabel*)b)->name);
+}
+
+/**
+ * @brief CFG'ye yeni bir kenar ekler (blokların kenar listeleri daha sonra doldurulur).
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int add_edge(Cfg* cfg, int from, int to, CfgEdgeKind kind) {
+    if (cfg->num_edges >= cfg->edge_capacity) {
+        size_t new_capacity = cfg->edge_capacity ? cfg->edge_capacity * 2 : 16;
+        CfgEdge* new_edges = (CfgEdge*)realloc(cfg->edges, sizeof(CfgEdge) * new_capacity);
+        if (!new_edges) {
+            fprintf(stderr, "Hata: CFG kenarları için bellek tahsis edilemedi.\n");
+            return 0;
+        }
+        cfg->edges = new_edges;
+        cfg->edge_capacity = new_capacity;
+    }
+    CfgEdge* edge = &cfg->edges[cfg->num_edges++];
+    edge->from = from;
+    edge->to = to;
+    edge->kind = kind;
+    edge->weight = 0;
+    return 1;
+}
+
+/**
+ * @brief Kenar listesinden her bloğun giriş/çıkış kenar dizilerini doldurur.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int fill_block_edge_lists(Cfg* cfg) {
+    for (size_t e = 0; e < cfg->num_edges; e++) {
+        cfg->blocks[cfg->edges[e].from].num_succs++;
+        cfg->blocks[cfg->edges[e].to].num_preds++;
+    }
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        BasicBlock* block = &cfg->blocks[b];
+        if (block->num_succs > 0) {
+            block->succ_edges = (int*)malloc(sizeof(int) * block->num_succs);
+            if (!block->succ_edges) return 0;
+        }
+        if (block->num_preds > 0) {
+            block->pred_edges = (int*)malloc(sizeof(int) * block->num_preds);
+            if (!block->pred_edges) return 0;
+        }
+        block->num_succs = 0;
+        block->num_preds = 0;
+    }
+    for (size_t e = 0; e < cfg->num_edges; e++) {
+        BasicBlock* from = &cfg->blocks[cfg->edges[e].from];
+        BasicBlock* to = &cfg->blocks[cfg->edges[e].to];
+        from->succ_edges[from->num_succs++] = (int)e;
+        to->pred_edges[to->num_preds++] = (int)e;
+    }
+    return 1;
+}
+
+// --- Harici Fonksiyon Gerçeklemeleri ---
+
+int cfg_is_conditional_branch(TokenType opcode) {
+    return opcode == TOKEN_JEQ || opcode == TOKEN_JNE ||
+           opcode == TOKEN_JLT || opcode == TOKEN_JGT;
+}
+
+int cfg_is_block_terminator(TokenType opcode) {
+    return opcode == TOKEN_JMP || opcode == TOKEN_RET || opcode == TOKEN_JTAB ||
+           cfg_is_conditional_branch(opcode);
+}
+
+int cfg_has_fallthrough(TokenType opcode) {
+    return opcode != TOKEN_JMP && opcode != TOKEN_RET && opcode != TOKEN_JTAB;
+}
+
+Cfg* cfg_build(AstNode* program) {
+    if (!program || program->type != AST_PROGRAM) {
+        fprintf(stderr, "Hata: CFG oluşturmak için geçersiz program düğümü.\n");
+        return NULL;
+    }
+
+    Cfg* cfg = (Cfg*)calloc(1, sizeof(Cfg));
+    if (!cfg) {
+        fprintf(stderr, "Hata: CFG için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    cfg->program = program;
+
+    size_t n = program->data.program.num_statements;
+    AstNode** statements = program->data.program.statements;
+    if (n == 0) {
+        return cfg; // Boş program: blok yok
+    }
+
+    // 1. Blok başlangıçlarını (leader) belirle:
+    //    - İlk ifade
+    //    - Bir önceki ifade etiket olmayan her etiket (ardışık etiketler aynı bloğu başlatır)
+    //    - Blok sonlandırıcı bir komuttan sonraki ifade
+    unsigned char* is_leader = (unsigned char*)calloc(n, 1);
+    if (!is_leader) {
+        fprintf(stderr, "Hata: CFG için bellek tahsis edilemedi.\n");
+        free(cfg);
+        return NULL;
+    }
+    is_leader[0] = 1;
+    size_t num_labels = 0;
+    for (size_t i = 0; i < n; i++) {
+        AstNode* statement = statements[i];
+        if (statement->type == AST_LABEL_DECLARATION) {
+            num_labels++;
+            if (i > 0 && statements[i - 1]->type != AST_LABEL_DECLARATION) {
+                is_leader[i] = 1;
+            }
+        } else if (statement->type == AST_INSTRUCTION &&
+                   cfg_is_block_terminator(statement->data.instruction.opcode) && i + 1 < n) {
+            is_leader[i + 1] = 1;
+        }
+    }
+
+    size_t num_blocks = 0;
+    for (size_t i = 0; i < n; i++) num_blocks += is_leader[i];
+
+    cfg->blocks = (BasicBlock*)calloc(num_blocks, sizeof(BasicBlock));
+    cfg->labels = num_labels ? (CfgLabel*)malloc(sizeof(CfgLabel) * num_labels) : NULL;
+    if (!cfg->blocks || (num_labels && !cfg->labels)) {
+        fprintf(stderr, "Hata: CFG blokları için bellek tahsis edilemedi.\n");
+        free(is_leader);
+        cfg_free(cfg);
+        return NULL;
+    }
+
+    // 2. Blokları oluştur ve etiketleri bloklara eşle
+    for (size_t i = 0; i < n; i++) {
+        if (is_leader[i]) {
+            if (cfg->num_blocks > 0) {
+                cfg->blocks[cfg->num_blocks - 1].end = i;
+            }
+            cfg->blocks[cfg->num_blocks].first = i;
+            cfg->num_blocks++;
+        }
+        if (statements[i]->type == AST_LABEL_DECLARATION) {
+            cfg->labels[cfg->num_labels].name = statements[i]->data.label_decl.name;
+            cfg->labels[cfg->num_labels].block = (int)cfg->num_blocks - 1;
+            cfg->num_labels++;
+        }
+    }
+    cfg->blocks[cfg->num_blocks - 1].end = n;
+    free(is_leader);
+
+    if (cfg->num_labels > 1) {
+        qsort(cfg->labels, cfg->num_labels, sizeof(CfgLabel), compare_cfg_labels);
+    }
+
+    // 3. Kenarları oluştur (blok içinde önce TAKEN, sonra FALLTHROUGH)
+    int* edge_seen = (int*)malloc(sizeof(int) * cfg->num_blocks); // JTAB hedeflerinde tekrarlanan kenarları önler
+    if (!edge_seen) {
+        fprintf(stderr, "Hata: CFG için bellek tahsis edilemedi.\n");
+        cfg_free(cfg);
+        return NULL;
+    }
+    for (size_t b = 0; b < cfg->num_blocks; b++) edge_seen[b] = -1;
+
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        AstNode* last = cfg_block_last_instruction(cfg, (int)b);
+        int falls_through = 1;
+
+        if (last) {
+            TokenType op = last->data.instruction.opcode;
+            const char* target = branch_target_label(last);
+            if (target) {
+                int target_block = cfg_block_of_label(cfg, target);
+                if (target_block >= 0 && !add_edge(cfg, (int)b, target_block, CFG_EDGE_TAKEN)) {
+                    free(edge_seen);
+                    cfg_free(cfg);
+                    return NULL;
+                }
+            } else if (op == TOKEN_JTAB) {
+                // Varsayılan hedef ve tablo girişleri: her farklı hedef blok için tek kenar
+                const AstInstruction* instr = &last->data.instruction;
+                for (size_t o = 2; o < instr->num_operands; o++) {
+                    if (instr->operands[o].type != OP_LABEL_REF) continue;
+                    int target_block = cfg_block_of_label(cfg, instr->operands[o].value.label_name);
+                    if (target_block < 0 || edge_seen[target_block] == (int)b) continue;
+                    edge_seen[target_block] = (int)b;
+                    if (!add_edge(cfg, (int)b, target_block, CFG_EDGE_TAKEN)) {
+                        free(edge_seen);
+                        cfg_free(cfg);
+                        return NULL;
+                    }
+                }
+            }
+            falls_through = cfg_has_fallthrough(op);
+        }
+
+        if (falls_through && b + 1 < cfg->num_blocks) {
+            if (!add_edge(cfg, (int)b, (int)b + 1, CFG_EDGE_FALLTHROUGH)) {
+                free(edge_seen);
+                cfg_free(cfg);
+                return NULL;
+            }
+        }
+    }
+    free(edge_seen);
+
+    if (!fill_block_edge_lists(cfg)) {
+        fprintf(stderr, "Hata: CFG kenar listeleri için bellek tahsis edilemedi.\n");
+        cfg_free(cfg);
+        return NULL;
+    }
+    return cfg;
+}
+
+void cfg_free(Cfg* cfg) {
+    if (cfg) {
+        if (cfg->blocks) {
+            for (size_t b = 0; b < cfg->num_blocks; b++) {
+                free(cfg->blocks[b].succ_edges);
+                free(cfg->blocks[b].pred_edges);
+            }
+            free(cfg->blocks);
+        }
+        free(cfg->edges);
+        free(cfg->labels);
+        free(cfg);
+    }
+}
+
+int cfg_block_of_label(const Cfg* cfg, const char* label_name) {
+    if (!cfg || !label_name || cfg->num_labels == 0) return -1;
+    CfgLabel key;
+    key.name = label_name;
+    key.block = -1;
+    const CfgLabel* found = (const CfgLabel*)bsearch(&key, cfg->labels, cfg->num_labels,
+                                                     sizeof(CfgLabel), compare_cfg_labels);
+    return found ? found->block : -1;
+}
+
+const char* cfg_block_label(const Cfg* cfg, int block) {
+    const BasicBlock* bb = &cfg->blocks[block];
+    if (bb->first < bb->end) {
+        AstNode* statement = cfg->program->data.program.statements[bb->first];
+        if (statement->type == AST_LABEL_DECLARATION) {
+            return statement->data.label_decl.name;
+        }
+    }
+    return NULL;
+}
+
+AstNode* cfg_block_last_instruction(const Cfg* cfg, int block) {
+    const BasicBlock* bb = &cfg->blocks[block];
+    AstNode** statements = cfg->program->data.program.statements;
+    for (size_t i = bb->end; i > bb->first; i--) {
+        if (statements[i - 1]->type == AST_INSTRUCTION) {
+            return statements[i - 1];
+        }
+    }
+    return NULL;
+}
+
+int cfg_find_succ_edge(const Cfg* cfg, int block, CfgEdgeKind kind) {
+    const BasicBlock* bb = &cfg->blocks[block];
+    for (size_t i = 0; i < bb->num_succs; i++) {
+        if (cfg->edges[bb->succ_edges[i]].kind == kind) {
+            return bb->succ_edges[i];
+        }
+    }
+    return -1;
+}
+
+uint64_t cfg_checksum(const Cfg* cfg) {
+    // FNV-1a: hızlı, deterministik ve platformdan bağımsız
+    uint64_t hash = 1469598103934665603ULL;
+#define CFG_HASH_MIX(value) do { hash ^= (uint64_t)(value); hash *= 1099511628211ULL; } while (0)
+
+    CFG_HASH_MIX(cfg->num_blocks);
+    CFG_HASH_MIX(cfg->num_edges);
+    for (size_t e = 0; e < cfg->num_edges; e++) {
+        CFG_HASH_MIX(cfg->edges[e].from);
+        CFG_HASH_MIX(cfg->edges[e].to);
+        CFG_HASH_MIX(cfg->edges[e].kind);
+    }
+    AstNode** statements = cfg->program->data.program.statements;
+    for (size_t i = 0; i < cfg->program->data.program.num_statements; i++) {
+        if (statements[i]->type == AST_INSTRUCTION) {
+            CFG_HASH_MIX(statements[i]->data.instruction.opcode);
+            CFG_HASH_MIX(statements[i]->data.instruction.num_operands);
+        }
+    }
+#undef CFG_HASH_MIX
+    return hash;
+}
+
+int cfg_compute_profile_weights(Cfg* cfg) {
+    int has_profile = 0;
+    AstNode** statements = cfg->program->data.program.statements;
+
+    for (size_t e = 0; e < cfg->num_edges; e++) cfg->edges[e].weight = 0;
+
+    // Komut içeren bloklar: ağırlıklar doğrudan komut sayımlarından gelir
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        BasicBlock* bb = &cfg->blocks[b];
+        bb->weight = 0;
+        AstNode* first_instr = NULL;
+        for (size_t i = bb->first; i < bb->end; i++) {
+            if (statements[i]->type == AST_INSTRUCTION) { first_instr = statements[i]; break; }
+        }
+        AstNode* last = cfg_block_last_instruction(cfg, (int)b);
+        if (!first_instr || !last->data.instruction.has_profile) continue;
+
+        has_profile = 1;
+        bb->weight = first_instr->data.instruction.profile_count;
+
+        AstInstruction* instr = &last->data.instruction;
+        for (size_t s = 0; s < bb->num_succs; s++) {
+            CfgEdge* edge = &cfg->edges[bb->succ_edges[s]];
+            if (edge->kind == CFG_EDGE_TAKEN) {
+                edge->weight = cfg_is_conditional_branch(instr->opcode) ? instr->profile_taken_count
+                                                                        : instr->profile_count;
+            } else if (cfg_is_conditional_branch(instr->opcode)) {
+                edge->weight = instr->profile_count > instr->profile_taken_count
+                                   ? instr->profile_count - instr->profile_taken_count : 0;
+            } else {
+                edge->weight = instr->profile_count;
+            }
+        }
+    }
+
+    // Sadece etiketlerden oluşan bloklar: ağırlık gelen kenarların toplamıdır
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        BasicBlock* bb = &cfg->blocks[b];
+        if (cfg_block_last_instruction(cfg, (int)b) != NULL) continue;
+        uint64_t sum = 0;
+        for (size_t p = 0; p < bb->num_preds; p++) sum += cfg->edges[bb->pred_edges[p]].weight;
+        bb->weight = sum;
+        for (size_t s = 0; s < bb->num_succs; s++) cfg->edges[bb->succ_edges[s]].weight = sum;
+    }
+    return has_profile;
+}
+
+void cfg_make_unique_label(SymbolTable* symbol_table, const char* prefix, char* buffer, size_t buffer_size) {
+    // Sayaç tüm çağrılarda ortaktır; böylece arama genellikle ilk denemede biter.
+    static unsigned long next_id = 0;
+    do {
+        snprintf(buffer, buffer_size, "%s_%lu", prefix, next_id++);
+    } while (symbol_table && symbol_table_lookup_symbol(symbol_table, buffer) != NULL);
+}
+
+/**
+ * @brief Koşullu atlamanın tersini döndürür (sadece JEQ/JNE tersine çevrilebilir).
+ * @return Ters komut veya tersi yoksa TOKEN_UNKNOWN.
+ */
+static TokenType invert_condition(TokenType opcode) {
+    switch (opcode) {
+        case TOKEN_JEQ: return TOKEN_JNE;
+        case TOKEN_JNE: return TOKEN_JEQ;
+        default: return TOKEN_UNKNOWN; // JLT/JGT'nin tersi (JGE/JLE) Bessambly'de yok
+    }
+}
+
+// cfg_linearize içinde her blok için verilen kararlar
+typedef enum {
+    LAYOUT_KEEP,            // Blok olduğu gibi kalır
+    LAYOUT_DROP_JMP,        // Sondaki JMP gereksiz (hedef bir sonraki blok)
+    LAYOUT_INVERT,          // Koşullu atlama tersine çevrilir, hedef düşme bloğu olur
+    LAYOUT_APPEND_JMP       // Düşme bloğuna (veya program sonuna) JMP eklenir
+} LayoutAction;
+
+int cfg_linearize(Cfg* cfg, const int* order, SymbolTable* symbol_table) {
+    size_t nb = cfg->num_blocks;
+    if (nb == 0) return 1;
+    if (order[0] != 0) {
+        fprintf(stderr, "Hata: Blok sıralamasında giriş bloğu ilk sırada olmalı.\n");
+        return 0;
+    }
+
+    AstNode** statements = cfg->program->data.program.statements;
+    LayoutAction* actions = (LayoutAction*)calloc(nb, sizeof(LayoutAction));
+    int* jump_target = (int*)malloc(sizeof(int) * nb);      // APPEND_JMP/INVERT hedefi (-1: program sonu)
+    AstNode** new_labels = (AstNode**)calloc(nb, sizeof(AstNode*));
+    if (!actions || !jump_target || !new_labels) {
+        fprintf(stderr, "Hata: Blok yerleşimi için bellek tahsis edilemedi.\n");
+        free(actions); free(jump_target); free(new_labels);
+        return 0;
+    }
+
+    // 1. Karar geçişi: her blok için gerekli düzeltmeleri belirle
+    int needs_end_label = 0;
+    for (size_t k = 0; k < nb; k++) {
+        int b = order[k];
+        int next = (k + 1 < nb) ? order[k + 1] : -1;
+        AstNode* last = cfg_block_last_instruction(cfg, b);
+        TokenType op = last ? last->data.instruction.opcode : TOKEN_UNKNOWN;
+        int ft_edge = cfg_find_succ_edge(cfg, b, CFG_EDGE_FALLTHROUGH);
+        int taken_edge = cfg_find_succ_edge(cfg, b, CFG_EDGE_TAKEN);
+        int ft = ft_edge >= 0 ? cfg->edges[ft_edge].to : -1;
+        int falls_off_end = (cfg_has_fallthrough(op) && ft < 0);
+
+        actions[b] = LAYOUT_KEEP;
+        jump_target[b] = -1;
+
+        if (op == TOKEN_JMP && taken_edge >= 0 && cfg->edges[taken_edge].to == next) {
+            actions[b] = LAYOUT_DROP_JMP;
+        } else if (ft >= 0 && ft != next) {
+            int taken = taken_edge >= 0 ? cfg->edges[taken_edge].to : -1;
+            if (cfg_is_conditional_branch(op) && taken == next && invert_condition(op) != TOKEN_UNKNOWN) {
+                actions[b] = LAYOUT_INVERT;
+            } else {
+                actions[b] = LAYOUT_APPEND_JMP;
+            }
+            jump_target[b] = ft;
+        } else if (falls_off_end && next != -1) {
+            actions[b] = LAYOUT_APPEND_JMP; // Program sonuna düşen blok artık son değil
+            needs_end_label = 1;
+        }
+    }
+
+    // 2. Atlama hedefi olacak ama etiketi olmayan bloklara etiket oluştur
+    char label_buffer[64];
+    for (size_t b = 0; b < nb; b++) {
+        int target = jump_target[b];
+        if (target < 0 || cfg_block_label(cfg, target) || new_labels[target]) continue;
+        cfg_make_unique_label(symbol_table, "__bsm_bb", label_buffer, sizeof(label_buffer));
+        new_labels[target] = ast_label_declaration_create(label_buffer, 0, 0);
+        if (!new_labels[target] || !symbol_table_add_symbol(symbol_table, label_buffer, 0, 0, 0)) {
+            goto fail;
+        }
+    }
+    AstNode* end_label = NULL;
+    if (needs_end_label) {
+        cfg_make_unique_label(symbol_table, "__bsm_end", label_buffer, sizeof(label_buffer));
+        end_label = ast_label_declaration_create(label_buffer, 0, 0);
+        if (!end_label || !symbol_table_add_symbol(symbol_table, label_buffer, 0, 0, 0)) {
+            ast_node_free(end_label);
+            goto fail;
+        }
+    }
+
+    // 3. Eklenecek JMP komutlarını önceden oluştur (emit sırasında bellek hatası olmasın)
+    AstNode** new_jumps = (AstNode**)calloc(nb, sizeof(AstNode*));
+    if (!new_jumps) goto fail_end;
+    for (size_t b = 0; b < nb; b++) {
+        if (actions[b] != LAYOUT_APPEND_JMP) continue;
+        AstNode* last = cfg_block_last_instruction(cfg, (int)b);
+        int target = jump_target[b];
+        const char* target_name;
+        if (target < 0) {
+            target_name = end_label->data.label_decl.name;
+        } else {
+            target_name = cfg_block_label(cfg, target);
+            if (!target_name) target_name = new_labels[target]->data.label_decl.name;
+        }
+        AstNode* jmp = ast_instruction_create(TOKEN_JMP, 1, last ? last->line : 0, last ? last->column : 0);
+        if (!jmp || !ast_operand_set_label(&jmp->data.instruction.operands[0], target_name)) {
+            ast_node_free(jmp);
+            for (size_t j = 0; j < nb; j++) ast_node_free(new_jumps[j]);
+            free(new_jumps);
+            goto fail_end;
+        }
+        // Eklenen JMP, düşme kenarının profil sayımını devralır
+        if (last && last->data.instruction.has_profile) {
+            AstInstruction* li = &last->data.instruction;
+            jmp->data.instruction.has_profile = 1;
+            jmp->data.instruction.profile_count = cfg_is_conditional_branch(li->opcode)
+                ? (li->profile_count > li->profile_taken_count ? li->profile_count - li->profile_taken_count : 0)
+                : li->profile_count;
+        }
+        new_jumps[b] = jmp;
+    }
+
+    // 4. Yeni ifade dizisini oluştur
+    size_t capacity = cfg->program->data.program.num_statements + 2 * nb + 1;
+    AstNode** new_statements = (AstNode**)malloc(sizeof(AstNode*) * capacity);
+    if (!new_statements) {
+        for (size_t j = 0; j < nb; j++) ast_node_free(new_jumps[j]);
+        free(new_jumps);
+        goto fail_end;
+    }
+    size_t count = 0;
+    for (size_t k = 0; k < nb; k++) {
+        int b = order[k];
+        BasicBlock* bb = &cfg->blocks[b];
+        AstNode* last = cfg_block_last_instruction(cfg, b);
+
+        if (new_labels[b]) new_statements[count++] = new_labels[b];
+        for (size_t i = bb->first; i < bb->end; i++) {
+            if (statements[i] == last && actions[b] == LAYOUT_DROP_JMP) {
+                ast_node_free(last); // Hedefi bir sonraki blok olan gereksiz JMP
+                continue;
+            }
+            new_statements[count++] = statements[i];
+        }
+        if (actions[b] == LAYOUT_INVERT) {
+            AstInstruction* instr = &last->data.instruction;
+            int target = jump_target[b];
+            const char* target_name = cfg_block_label(cfg, target);
+            if (!target_name) target_name = new_labels[target]->data.label_decl.name;
+            // Etiket düğümü programda kaldığı için ad kopyalanarak atanır
+            ast_operand_set_label(&instr->operands[0], target_name);
+            instr->opcode = invert_condition(instr->opcode);
+            if (instr->has_profile) {
+                instr->profile_taken_count = instr->profile_count > instr->profile_taken_count
+                                                 ? instr->profile_count - instr->profile_taken_count : 0;
+            }
+        } else if (actions[b] == LAYOUT_APPEND_JMP) {
+            new_statements[count++] = new_jumps[b];
+        }
+    }
+    if (end_label) new_statements[count++] = end_label;
+
+    free(cfg->program->data.program.statements);
+    cfg->program->data.program.statements = new_statements;
+    cfg->program->data.program.num_statements = count;
+
+    free(new_jumps);
+    free(actions);
+    free(jump_target);
+    free(new_labels);
+    return 1;
+
+fail_end:
+    ast_node_free(end_label);
+fail:
+    fprintf(stderr, "Hata: Blok yerleşimi uygulanamadı (bellek hatası).\n");
+    for (size_t b = 0; b < nb; b++) ast_node_free(new_labels[b]);
+    free(actions);
+    free(jump_target);
+    free(new_labels);
+    return 0;
+}
+
+// --- Kaydedici, Bayrak ve Canlılık Analizleri ---
+
+/**
+ * @brief Kaydedici operandının maske bitini döndürür (geçersiz/kaydedici değilse 0).
+ */
+static uint32_t operand_register_mask(const AstOperand* operand) {
+    if (operand->type == OP_REGISTER && operand->value.reg_index >= 0 &&
+        operand->value.reg_index < CFG_NUM_REGISTERS) {
+        return 1u << operand->value.reg_index;
+    }
+    return 0;
+}
+
+FlagsEffect cfg_instruction_flags_effect(const AstInstruction* instr) {
+    switch (instr->opcode) {
+        case TOKEN_CMP:
+            return FLAGS_DEF_COMPARE;
+        case TOKEN_JEQ:
+        case TOKEN_JNE:
+        case TOKEN_JLT:
+        case TOKEN_JGT:
+        case TOKEN_SELEQ:
+        case TOKEN_SELNE:
+        case TOKEN_SELLT:
+        case TOKEN_SELGT:
+        case TOKEN_SELLE:
+        case TOKEN_SELGE:
+            return FLAGS_USE;
+        case TOKEN_ADD:
+        case TOKEN_SUB:
+            return FLAGS_DEF_RESULT;
+        case TOKEN_MUL:
+        case TOKEN_DIV:
+        case TOKEN_SYSCALL:
+        case TOKEN_CALL:
+        case TOKEN_PROFDUMP:
+        case TOKEN_JTAB: // Sınır kontrolü bir karşılaştırma olarak üretilir
+            return FLAGS_CLOBBER;
+        default:
+            // MOV, JMP, RET ve PROFCNT bayrakları korur (PROFCNT bayrak korumalı üretilir)
+            return FLAGS_NONE;
+    }
+}
+
+RegisterEffects cfg_instruction_register_effects(const AstInstruction* instr) {
+    RegisterEffects fx = {0, 0, 0};
+
+    switch (instr->opcode) {
+        case TOKEN_MOV:
+            if (instr->num_operands == 2) {
+                fx.def = operand_register_mask(&instr->operands[0]);
+                fx.use = operand_register_mask(&instr->operands[1]);
+            }
+            break;
+        case TOKEN_ADD:
+        case TOKEN_SUB:
+        case TOKEN_MUL:
+        case TOKEN_DIV:
+            if (instr->num_operands == 2) {
+                fx.def = operand_register_mask(&instr->operands[0]);
+                fx.use = fx.def | operand_register_mask(&instr->operands[1]);
+            }
+            break;
+        case TOKEN_SELEQ:
+        case TOKEN_SELNE:
+        case TOKEN_SELLT:
+        case TOKEN_SELGT:
+        case TOKEN_SELLE:
+        case TOKEN_SELGE:
+            // Koşul sağlanmazsa hedef eski değerini korur: hedef hem okunur hem yazılır
+            if (instr->num_operands == 2) {
+                fx.def = operand_register_mask(&instr->operands[0]);
+                fx.use = fx.def | operand_register_mask(&instr->operands[1]);
+            }
+            break;
+        case TOKEN_CMP:
+            for (size_t i = 0; i < instr->num_operands; i++) {
+                fx.use |= operand_register_mask(&instr->operands[i]);
+            }
+            break;
+        case TOKEN_SYSCALL:
+        case TOKEN_CALL:
+            // Argümanlar örtük olarak kaydedicilerde; dönüş değerleri herhangi bir kaydediciye yazılabilir
+            fx.use = CFG_ALL_REGISTERS;
+            fx.clobber = CFG_ALL_REGISTERS;
+            break;
+        case TOKEN_RET:
+            fx.use = CFG_ALL_REGISTERS; // Çağıran taraf tüm kaydedicileri okuyabilir
+            break;
+        case TOKEN_JTAB:
+            if (instr->num_operands > 0) fx.use = operand_register_mask(&instr->operands[0]);
+            break;
+        default:
+            break;
+    }
+
+    switch (cfg_instruction_flags_effect(instr)) {
+        case FLAGS_USE: fx.use |= CFG_FLAGS_BIT; break;
+        case FLAGS_DEF_COMPARE:
+        case FLAGS_DEF_RESULT: fx.def |= CFG_FLAGS_BIT; break;
+        case FLAGS_CLOBBER: fx.clobber |= CFG_FLAGS_BIT; break;
+        case FLAGS_NONE: break;
+    }
+    fx.clobber |= fx.def;
+    return fx;
+}
+
+void cfg_compute_liveness(const Cfg* cfg, uint32_t* live_in, uint32_t* live_out) {
+    AstNode** statements = cfg->program->data.program.statements;
+    size_t nb = cfg->num_blocks;
+
+    // Blok özetleri: gen (tanımdan önce okunan), kill (kesin yazılan)
+    uint32_t* gen = (uint32_t*)calloc(nb ? nb : 1, sizeof(uint32_t));
+    uint32_t* kill = (uint32_t*)calloc(nb ? nb : 1, sizeof(uint32_t));
+    for (size_t b = 0; b < nb; b++) {
+        live_in[b] = 0;
+        live_out[b] = 0;
+    }
+    if (!gen || !kill) {
+        // Bellek yoksa en güvenli varsayım: her şey her yerde canlı
+        for (size_t b = 0; b < nb; b++) {
+            live_in[b] = CFG_ALL_REGISTERS | CFG_FLAGS_BIT;
+            live_out[b] = CFG_ALL_REGISTERS | CFG_FLAGS_BIT;
+        }
+        free(gen);
+        free(kill);
+        return;
+    }
+
+    for (size_t b = 0; b < nb; b++) {
+        for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            if (statements[i]->type != AST_INSTRUCTION) continue;
+            RegisterEffects fx = cfg_instruction_register_effects(&statements[i]->data.instruction);
+            gen[b] |= fx.use & ~kill[b];
+            kill[b] |= fx.def;
+        }
+    }
+
+    // Sabit noktaya kadar geriye doğru yinele (ters blok sırası hızlı yakınsar)
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (size_t k = nb; k > 0; k--) {
+            size_t b = k - 1;
+            uint32_t out = 0;
+            for (size_t s = 0; s < cfg->blocks[b].num_succs; s++) {
+                out |= live_in[cfg->edges[cfg->blocks[b].succ_edges[s]].to];
+            }
+            uint32_t in = gen[b] | (out & ~kill[b]);
+            if (out != live_out[b] || in != live_in[b]) {
+                live_out[b] = out;
+                live_in[b] = in;
+                changed = 1;
+            }
+        }
+    }
+    free(gen);
+    free(kill);
+}
+
+static int operands_equal(const AstOperand* a, const AstOperand* b) {
+    if (a->type == OP_REGISTER || b->type == OP_REGISTER) {
+        return a->type == b->type && a->value.reg_index == b->value.reg_index;
+    }
+    if ((a->type == OP_INTEGER || a->type == OP_HEX_INTEGER) &&
+        (b->type == OP_INTEGER || b->type == OP_HEX_INTEGER)) {
+        return a->value.int_value == b->value.int_value; // 16 ve 0x10 aynı değerdir
+    }
+    return 0;
+}
+
+int cfg_flags_value_equal(const FlagsValue* a, const FlagsValue* b) {
+    if (a->kind != b->kind) return 0;
+    switch (a->kind) {
+        case FLAGS_VALUE_COMPARE:
+            return operands_equal(&a->lhs, &b->lhs) && operands_equal(&a->rhs, &b->rhs);
+        case FLAGS_VALUE_RESULT:
+            return a->reg == b->reg;
+        default:
+            return 1;
+    }
+}
+
+void cfg_flags_transfer(FlagsValue* value, const AstInstruction* instr) {
+    if (value->kind == FLAGS_VALUE_TOP) return;
+
+    RegisterEffects fx = cfg_instruction_register_effects(instr);
+    switch (cfg_instruction_flags_effect(instr)) {
+        case FLAGS_DEF_COMPARE:
+            if (instr->num_operands == 2 && instr->operands[0].type != OP_LABEL_REF &&
+                instr->operands[1].type != OP_LABEL_REF) {
+                value->kind = FLAGS_VALUE_COMPARE;
+                value->lhs = instr->operands[0];
+                value->rhs = instr->operands[1];
+            } else {
+                value->kind = FLAGS_VALUE_UNKNOWN;
+            }
+            return;
+        case FLAGS_DEF_RESULT:
+            value->kind = FLAGS_VALUE_RESULT;
+            value->reg = instr->operands[0].value.reg_index;
+            return;
+        case FLAGS_CLOBBER:
+            value->kind = FLAGS_VALUE_UNKNOWN;
+            return;
+        default:
+            break;
+    }
+
+    // Bayraklar değişmedi ama kaynak operandlar değiştiyse aynı karşılaştırma artık farklı sonuç verir
+    uint32_t sources = 0;
+    if (value->kind == FLAGS_VALUE_COMPARE) {
+        sources = operand_register_mask(&value->lhs) | operand_register_mask(&value->rhs);
+    } else if (value->kind == FLAGS_VALUE_RESULT) {
+        sources = 1u << value->reg;
+    }
+    if (fx.clobber & sources) {
+        value->kind = FLAGS_VALUE_UNKNOWN;
+    }
+}
+
+int cfg_compute_available_flags(const Cfg* cfg, FlagsValue* block_in) {
+    size_t nb = cfg->num_blocks;
+    AstNode** statements = cfg->program->data.program.statements;
+    FlagsValue* block_out = (FlagsValue*)malloc(sizeof(FlagsValue) * (nb ? nb : 1));
+    if (!block_out) {
+        fprintf(stderr, "Hata: Bayrak analizi için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    for (size_t b = 0; b < nb; b++) {
+        block_in[b].kind = FLAGS_VALUE_TOP;
+        block_out[b].kind = FLAGS_VALUE_TOP;
+    }
+
+    // İyimser ileri veri akışı: TOP değerleri döngülerde geri kenarları başlangıçta yok sayar
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (size_t b = 0; b < nb; b++) {
+            FlagsValue in;
+            in.kind = (b == 0) ? FLAGS_VALUE_UNKNOWN : FLAGS_VALUE_TOP;
+            for (size_t p = 0; p < cfg->blocks[b].num_preds; p++) {
+                const FlagsValue* pred_out = &block_out[cfg->edges[cfg->blocks[b].pred_edges[p]].from];
+                if (pred_out->kind == FLAGS_VALUE_TOP) continue;
+                if (in.kind == FLAGS_VALUE_TOP) {
+                    in = *pred_out;
+                } else if (!cfg_flags_value_equal(&in, pred_out)) {
+                    in.kind = FLAGS_VALUE_UNKNOWN;
+                }
+            }
+            // Önceli olmayan (ulaşılamayan veya sadece CALL ile girilen) bloklar için bilinmiyor
+            if (in.kind == FLAGS_VALUE_TOP && cfg->blocks[b].num_preds == 0) in.kind = FLAGS_VALUE_UNKNOWN;
+
+            FlagsValue out = in;
+            for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+                if (statements[i]->type == AST_INSTRUCTION) {
+                    cfg_flags_transfer(&out, &statements[i]->data.instruction);
+                }
+            }
+            if (!cfg_flags_value_equal(&in, &block_in[b]) || !cfg_flags_value_equal(&out, &block_out[b])) {
+                block_in[b] = in;
+                block_out[b] = out;
+                changed = 1;
+            }
+        }
+    }
+    // Hâlâ TOP kalan bloklar (sadece ulaşılamayan döngüler) bilinmiyor kabul edilir
+    for (size_t b = 0; b < nb; b++) {
+        if (block_in[b].kind == FLAGS_VALUE_TOP) block_in[b].kind = FLAGS_VALUE_UNKNOWN;
+    }
+    free(block_out);
+    return 1;
+}
+
+// --- Alt Program Keşfi ---
+
+int cfg_subroutine_of_call(const Cfg* cfg, const CfgSubroutine* subroutines, size_t count, const AstNode* call) {
+    if (!call || call->type != AST_INSTRUCTION || call->data.instruction.opcode != TOKEN_CALL ||
+        call->data.instruction.num_operands != 1 || call->data.instruction.operands[0].type != OP_LABEL_REF) {
+        return -1;
+    }
+    int block = cfg_block_of_label(cfg, call->data.instruction.operands[0].value.label_name);
+    if (block < 0) return -1;
+    for (size_t s = 0; s < count; s++) {
+        if (subroutines[s].entry_block == block) return (int)s;
+    }
+    return -1;
+}
+
+void cfg_free_subroutines(CfgSubroutine* subroutines, size_t count) {
+    if (!subroutines) return;
+    for (size_t s = 0; s < count; s++) {
+        free(subroutines[s].in_body);
+    }
+    free(subroutines);
+}
+
+/**
+ * @brief Alt programın gövdesini (girişten ulaşılabilen bloklar) ve özelliklerini hesaplar.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int compute_subroutine_body(const Cfg* cfg, CfgSubroutine* sub, int* worklist) {
+    AstNode** statements = cfg->program->data.program.statements;
+    size_t nb = cfg->num_blocks;
+
+    sub->in_body = (unsigned char*)calloc(nb, 1);
+    if (!sub->in_body) return 0;
+
+    size_t top = 0;
+    worklist[top++] = sub->entry_block;
+    sub->in_body[sub->entry_block] = 1;
+    while (top > 0) {
+        int b = worklist[--top];
+        sub->num_body_blocks++;
+        for (size_t s = 0; s < cfg->blocks[b].num_succs; s++) {
+            int to = cfg->edges[cfg->blocks[b].succ_edges[s]].to;
+            if (!sub->in_body[to]) {
+                sub->in_body[to] = 1;
+                worklist[top++] = to;
+            }
+        }
+    }
+
+    // Gövde, girişten başlayan kesintisiz bir blok dizisi mi?
+    size_t last = (size_t)sub->entry_block;
+    while (last + 1 < nb && sub->in_body[last + 1]) last++;
+    sub->contiguous = (last - (size_t)sub->entry_block + 1) == sub->num_body_blocks;
+    sub->first = cfg->blocks[sub->entry_block].first;
+    sub->end = cfg->blocks[last].end;
+
+    for (size_t b = 0; b < nb; b++) {
+        if (!sub->in_body[b]) continue;
+        for (size_t p = 0; p < cfg->blocks[b].num_preds; p++) {
+            if (!sub->in_body[cfg->edges[cfg->blocks[b].pred_edges[p]].from]) {
+                sub->has_side_entry = 1; // Dışarıdan atlama veya düşme ile giriliyor
+            }
+        }
+        for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            if (statements[i]->type != AST_INSTRUCTION) continue;
+            sub->num_instructions++;
+            if (statements[i]->data.instruction.opcode == TOKEN_RET) sub->num_returns++;
+        }
+    }
+    return 1;
+}
+
+int cfg_find_subroutines(const Cfg* cfg, CfgSubroutine** subroutines, size_t* count) {
+    *subroutines = NULL;
+    *count = 0;
+    AstNode** statements = cfg->program->data.program.statements;
+    size_t n = cfg->program->data.program.num_statements;
+
+    // 1. CALL hedeflerini topla (her giriş bloğu için tek kayıt)
+    size_t capacity = 0;
+    for (size_t i = 0; i < n; i++) {
+        AstNode* statement = statements[i];
+        if (statement->type != AST_INSTRUCTION || statement->data.instruction.opcode != TOKEN_CALL ||
+            statement->data.instruction.num_operands != 1 ||
+            statement->data.instruction.operands[0].type != OP_LABEL_REF) {
+            continue;
+        }
+        const char* name = statement->data.instruction.operands[0].value.label_name;
+        int block = cfg_block_of_label(cfg, name);
+        if (block < 0) continue;
+
+        int index = cfg_subroutine_of_call(cfg, *subroutines, *count, statement);
+        if (index < 0) {
+            if (*count >= capacity) {
+                size_t new_capacity = capacity ? capacity * 2 : 8;
+                CfgSubroutine* grown = (CfgSubroutine*)realloc(*subroutines, sizeof(CfgSubroutine) * new_capacity);
+                if (!grown) {
+                    fprintf(stderr, "Hata: Alt program listesi için bellek tahsis edilemedi.\n");
+                    cfg_free_subroutines(*subroutines, *count);
+                    *subroutines = NULL;
+                    *count = 0;
+                    return 0;
+                }
+                *subroutines = grown;
+                capacity = new_capacity;
+            }
+            index = (int)(*count)++;
+            memset(&(*subroutines)[index], 0, sizeof(CfgSubroutine));
+            (*subroutines)[index].name = cfg_block_label(cfg, block);
+            (*subroutines)[index].entry_block = block;
+        }
+        (*subroutines)[index].num_call_sites++;
+    }
+    if (*count == 0) return 1;
+
+    // 2. Her alt programın gövdesini hesapla
+    int* worklist = (int*)malloc(sizeof(int) * cfg->num_blocks);
+    if (!worklist) {
+        fprintf(stderr, "Hata: Alt program analizi için bellek tahsis edilemedi.\n");
+        cfg_free_subroutines(*subroutines, *count);
+        *subroutines = NULL;
+        *count = 0;
+        return 0;
+    }
+    for (size_t s = 0; s < *count; s++) {
+        if (!compute_subroutine_body(cfg, &(*subroutines)[s], worklist)) {
+            fprintf(stderr, "Hata: Alt program analizi için bellek tahsis edilemedi.\n");
+            free(worklist);
+            cfg_free_subroutines(*subroutines, *count);
+            *subroutines = NULL;
+            *count = 0;
+            return 0;
+        }
+    }
+    free(worklist);
+
+    // 3. Doğrudan özyineleme: gövdede kendisine CALL var mı?
+    for (size_t s = 0; s < *count; s++) {
+        CfgSubroutine* sub = &(*subroutines)[s];
+        for (size_t b = 0; b < cfg->num_blocks && !sub->is_recursive; b++) {
+            if (!sub->in_body[b]) continue;
+            for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+                if (cfg_subroutine_of_call(cfg, *subroutines, *count, statements[i]) == (int)s) {
+                    sub->is_recursive = 1;
+                    break;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// --- Doğal Döngüler ---
+
+/**
+ * @brief İki bloğun dominatör ağacındaki en yakın ortak atasını bulur.
+ * @param postorder Blokların sonsıra (postorder) numaraları; sanal kök en büyüğüdür.
+ */
+static int dominator_intersect(const int* idom, const int* postorder, int a, int b) {
+    while (a != b) {
+        while (postorder[a] < postorder[b]) a = idom[a];
+        while (postorder[b] < postorder[a]) b = idom[b];
+    }
+    return a;
+}
+
+int cfg_compute_dominators(const Cfg* cfg, int* idom) {
+    size_t nb = cfg->num_blocks;
+    if (nb == 0) return 1;
+    AstNode** statements = cfg->program->data.program.statements;
+    int root = (int)nb; // Sanal kök: tüm giriş noktalarının ortak öncülü
+
+    int* dom = (int*)malloc(sizeof(int) * (nb + 1));
+    int* postorder = (int*)malloc(sizeof(int) * (nb + 1));
+    int* order = (int*)malloc(sizeof(int) * (nb + 1));      // Sonsıradaki bloklar
+    int* stack = (int*)malloc(sizeof(int) * (nb + 1));
+    size_t* next_succ = (size_t*)calloc(nb + 1, sizeof(size_t));
+    unsigned char* is_root = (unsigned char*)calloc(nb, 1);
+    unsigned char* visited = (unsigned char*)calloc(nb + 1, 1);
+    if (!dom || !postorder || !order || !stack || !next_succ || !is_root || !visited) {
+        fprintf(stderr, "Hata: Dominatör analizi için bellek tahsis edilemedi.\n");
+        free(dom); free(postorder); free(order); free(stack); free(next_succ); free(is_root); free(visited);
+        return 0;
+    }
+
+    // 1. Kökler: program girişi, öncülü olmayan bloklar ve CALL hedefleri (CALL kenar oluşturmaz)
+    is_root[0] = 1;
+    for (size_t b = 0; b < nb; b++) {
+        if (cfg->blocks[b].num_preds == 0) is_root[b] = 1;
+    }
+    for (size_t i = 0; i < cfg->program->data.program.num_statements; i++) {
+        const AstNode* statement = statements[i];
+        if (statement->type == AST_INSTRUCTION && statement->data.instruction.opcode == TOKEN_CALL &&
+            statement->data.instruction.num_operands == 1 &&
+            statement->data.instruction.operands[0].type == OP_LABEL_REF) {
+            int target = cfg_block_of_label(cfg, statement->data.instruction.operands[0].value.label_name);
+            if (target >= 0) is_root[target] = 1;
+        }
+    }
+
+    // 2. Sanal kökten yinelemeli DFS ile sonsıra numaraları (ulaşılamayan bloklar -1)
+    for (size_t b = 0; b <= nb; b++) {
+        postorder[b] = -1;
+        dom[b] = -1;
+    }
+    size_t sp = 0, num_ordered = 0;
+    stack[sp++] = root;
+    visited[root] = 1;
+    while (sp > 0) {
+        int b = stack[sp - 1];
+        int succ = -1;
+        if (b == root) {
+            while (next_succ[root] < nb && succ < 0) {
+                size_t candidate = next_succ[root]++;
+                if (is_root[candidate] && !visited[candidate]) succ = (int)candidate;
+            }
+        } else {
+            while (next_succ[b] < cfg->blocks[b].num_succs && succ < 0) {
+                int candidate = cfg->edges[cfg->blocks[b].succ_edges[next_succ[b]++]].to;
+                if (!visited[candidate]) succ = candidate;
+            }
+        }
+        if (succ >= 0) {
+            visited[succ] = 1;
+            stack[sp++] = succ;
+        } else {
+            postorder[b] = (int)num_ordered;
+            order[num_ordered++] = b;
+            sp--;
+        }
+    }
+
+    // 3. Ters sonsırada sabit noktaya kadar yinele (sanal kök sonsıranın son elemanıdır)
+    dom[root] = root;
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (size_t k = num_ordered - 1; k-- > 0;) {
+            int b = order[k];
+            int new_idom = is_root[b] ? root : -1;
+            for (size_t p = 0; p < cfg->blocks[b].num_preds; p++) {
+                int pred = cfg->edges[cfg->blocks[b].pred_edges[p]].from;
+                if (dom[pred] < 0) continue; // Henüz işlenmemiş veya ulaşılamayan öncül
+                new_idom = new_idom < 0 ? pred : dominator_intersect(dom, postorder, pred, new_idom);
+            }
+            if (new_idom >= 0 && dom[b] != new_idom) {
+                dom[b] = new_idom;
+                changed = 1;
+            }
+        }
+    }
+
+    for (size_t b = 0; b < nb; b++) idom[b] = dom[b] == root ? -1 : dom[b];
+    free(dom); free(postorder); free(order); free(stack); free(next_succ); free(is_root); free(visited);
+    return 1;
+}
+
+int cfg_dominates(const int* idom, int a, int b) {
+    while (b >= 0) {
+        if (a == b) return 1;
+        b = idom[b];
+    }
+    return 0;
+}
+
+void cfg_free_loops(CfgLoop* loops, size_t count) {
+    if (!loops) return;
+    for (size_t i = 0; i < count; i++) free(loops[i].in_loop);
+    free(loops);
+}
+
+int cfg_find_loops(const Cfg* cfg, CfgLoop** loops, size_t* count) {
+    *loops = NULL;
+    *count = 0;
+    size_t nb = cfg->num_blocks;
+    if (nb == 0) return 1;
+
+    int* idom = (int*)malloc(sizeof(int) * nb);
+    int* loop_of_header = (int*)malloc(sizeof(int) * nb);
+    int* worklist = (int*)malloc(sizeof(int) * nb);
+    if (!idom || !loop_of_header || !worklist || !cfg_compute_dominators(cfg, idom)) {
+        if (!idom || !loop_of_header || !worklist) {
+            fprintf(stderr, "Hata: Döngü analizi için bellek tahsis edilemedi.\n");
+        }
+        free(idom); free(loop_of_header); free(worklist);
+        return 0;
+    }
+    for (size_t b = 0; b < nb; b++) loop_of_header[b] = -1;
+
+    // 1. Geri kenarlar: hedef kaynağı domine ediyor (kendine dönen kenar dahil)
+    size_t capacity = 0;
+    int ok = 1;
+    for (size_t h = 0; h < nb && ok; h++) {
+        for (size_t p = 0; p < cfg->blocks[h].num_preds && ok; p++) {
+            int latch = cfg->edges[cfg->blocks[h].pred_edges[p]].from;
+            if (!cfg_dominates(idom, (int)h, latch)) continue;
+
+            int index = loop_of_header[h];
+            if (index < 0) {
+                if (*count >= capacity) {
+                    size_t new_capacity = capacity ? capacity * 2 : 8;
+                    CfgLoop* grown = (CfgLoop*)realloc(*loops, sizeof(CfgLoop) * new_capacity);
+                    if (!grown) { ok = 0; break; }
+                    *loops = grown;
+                    capacity = new_capacity;
+                }
+                CfgLoop* loop = &(*loops)[*count];
+                loop->header = (int)h;
+                loop->in_loop = (unsigned char*)calloc(nb, 1);
+                loop->num_body_blocks = 1;
+                loop->num_back_edges = 0;
+                loop->parent = -1;
+                loop->depth = 1;
+                if (!loop->in_loop) { ok = 0; break; }
+                loop->in_loop[h] = 1;
+                index = (int)(*count)++;
+                loop_of_header[h] = index;
+            }
+
+            // 2. Geri kenarın kaynağından başlığa kadar geriye doğru ulaşılabilen bloklar
+            CfgLoop* loop = &(*loops)[index];
+            loop->num_back_edges++;
+            size_t top = 0;
+            if (!loop->in_loop[latch]) {
+                loop->in_loop[latch] = 1;
+                loop->num_body_blocks++;
+                worklist[top++] = latch;
+            }
+            while (top > 0) {
+                int b = worklist[--top];
+                for (size_t q = 0; q < cfg->blocks[b].num_preds; q++) {
+                    int pred = cfg->edges[cfg->blocks[b].pred_edges[q]].from;
+                    if (loop->in_loop[pred]) continue;
+                    loop->in_loop[pred] = 1;
+                    loop->num_body_blocks++;
+                    worklist[top++] = pred;
+                }
+            }
+        }
+    }
+    free(idom); free(loop_of_header); free(worklist);
+    if (!ok) {
+        fprintf(stderr, "Hata: Döngü listesi için bellek tahsis edilemedi.\n");
+        cfg_free_loops(*loops, *count);
+        *loops = NULL;
+        *count = 0;
+        return 0;
+    }
+
+    // 3. İç içelik: başlığı içeren en küçük diğer döngü ebeveyndir (doğal döngüler ya iç içe ya ayrıktır)
+    for (size_t i = 0; i < *count; i++) {
+        CfgLoop* loop = &(*loops)[i];
+        for (size_t j = 0; j < *count; j++) {
+            const CfgLoop* outer = &(*loops)[j];
+            if (j == i || !outer->in_loop[loop->header] || outer->num_body_blocks <= loop->num_body_blocks) continue;
+            if (loop->parent < 0 || outer->num_body_blocks < (*loops)[loop->parent].num_body_blocks) {
+                loop->parent = (int)j;
+            }
+        }
+    }
+    for (size_t i = 0; i < *count; i++) {
+        int depth = 1;
+        for (int p = (*loops)[i].parent; p >= 0; p = (*loops)[p].parent) depth++;
+        (*loops)[i].depth = depth;
+    }
+    return 1;
+}
@@ -0,0 +1,342 @@
+#ifndef CFG_H
+#define CFG_H
+
+#include "ast.h" // AST düğüm yapılarına erişim
+#include "semantic_analyzer.h" // Yeni etiketleri sembol tablosuna eklemek için
+#include <stdint.h> // uint64_t için
+#include <stddef.h> // size_t için
+
+// --- Kontrol Akış Grafiği (CFG) ---
+// Program düğümünün düz ifade listesi üzerinde temel bloklar ve kenarlar oluşturur.
+// Bloklar, program->statements dizisinde ardışık indeks aralıklarıdır; bu sayede
+// AST'yi kopyalamadan analiz yapılabilir. AST değiştirildiğinde CFG geçersiz olur
+// ve yeniden oluşturulmalıdır.
+
+// --- Kenar Türleri ---
+typedef enum {
+    CFG_EDGE_FALLTHROUGH,   // Bir sonraki bloğa düşme (atlama yapılmadan)
+    CFG_EDGE_TAKEN          // Atlama komutunun hedefine giden kenar
+} CfgEdgeKind;
+
+// --- CFG Kenarı ---
+typedef struct {
+    int from;               // Kaynak blok indeksi
+    int to;                 // Hedef blok indeksi
+    CfgEdgeKind kind;       // Kenarın türü
+    uint64_t weight;        // Kenar ağırlığı (profil verisinden, yoksa 0)
+} CfgEdge;
+
+// --- Temel Blok ---
+typedef struct {
+    size_t first;           // Bloğun ilk ifadesinin indeksi (baştaki etiketler dahil)
+    size_t end;             // Bloğun son ifadesinden bir sonraki indeks
+    int* succ_edges;        // Çıkan kenarların indeksleri (Cfg.edges içinde)
+    size_t num_succs;
+    int* pred_edges;        // Gelen kenarların indeksleri (Cfg.edges içinde)
+    size_t num_preds;
+    uint64_t weight;        // Bloğun çalıştırılma sayısı (profil verisinden, yoksa 0)
+} BasicBlock;
+
+// --- Etiket -> Blok Eşlemesi ---
+typedef struct {
+    const char* name;       // Etiket adı (AST'deki etiket düğümüne aittir)
+    int block;              // Etiketin başlattığı blok
+} CfgLabel;
+
+// --- CFG Yapısı ---
+typedef struct {
+    AstNode* program;       // CFG'nin oluşturulduğu program düğümü
+    BasicBlock* blocks;     // Program sırasındaki temel bloklar (0 giriş bloğudur)
+    size_t num_blocks;
+    CfgEdge* edges;         // Tüm kenarlar (blok sırasına göre, blok içinde önce TAKEN)
+    size_t num_edges;
+    size_t edge_capacity;
+    CfgLabel* labels;       // İsme göre sıralı etiket eşlemesi (ikili arama için)
+    size_t num_labels;
+} Cfg;
+
+// --- Alt Programlar ---
+// CALL komutları CFG'de kenar oluşturmaz (çağrıdan sonra akış bir sonraki komuta döner).
+// Bir alt programın kapsamı, CALL hedefi etiketin bloğundan kenarlar boyunca
+// ulaşılabilen bloklardır; RET blokları çıkış noktalarıdır.
+typedef struct {
+    const char* name;           // Giriş etiketi (AST'deki etiket düğümüne aittir)
+    int entry_block;            // Giriş bloğu
+    unsigned char* in_body;     // num_blocks elemanlı üyelik dizisi (1 = gövdeye ait)
+    size_t num_body_blocks;     // Gövdedeki blok sayısı
+    int contiguous;             // Gövde [first, end) ifade aralığını tam olarak kaplıyorsa 1
+    size_t first;               // Gövdenin ilk ifadesi (contiguous ise geçerli)
+    size_t end;                 // Gövdenin son ifadesinden bir sonraki indeks (contiguous ise geçerli)
+    size_t num_instructions;    // Gövdedeki komut sayısı (RET dahil)
+    size_t num_returns;         // Gövdedeki RET sayısı
+    size_t num_call_sites;      // Bu alt programı çağıran CALL sayısı
+    int is_recursive;           // Gövde kendisini (doğrudan) çağırıyorsa 1
+    int has_side_entry;         // Gövdeye girişi dışında bir yerden (atlama/düşme) girilebiliyorsa 1
+} CfgSubroutine;
+
+// --- Kaydedici ve Bayrak Etkileri ---
+// Kaydedici kümeleri 32-bit maskelerle tutulur: bit 0-15 R0-R15, bit 16 bayraklar.
+#define CFG_NUM_REGISTERS 16
+#define CFG_FLAGS_BIT (1u << 16)
+#define CFG_ALL_REGISTERS 0xFFFFu
+
+// Bir komutun bayraklar (flags) üzerindeki etkisi
+typedef enum {
+    FLAGS_NONE,         // Bayrakları okumaz ve değiştirmez (MOV, JMP, PROFCNT)
+    FLAGS_USE,          // Bayrakları okur (koşullu atlamalar, SELcc)
+    FLAGS_DEF_COMPARE,  // Bayrakları iki operandın karşılaştırmasıyla tanımlar (CMP)
+    FLAGS_DEF_RESULT,   // Bayrakları (sonuç, 0) karşılaştırması olarak tanımlar (ADD/SUB)
+    FLAGS_CLOBBER       // Bayrakları belirsiz bırakır (MUL, DIV, SYSCALL, ...)
+} FlagsEffect;
+
+// Bir komutun kaydedici etkileri
+typedef struct {
+    uint32_t use;       // Okunan kaydediciler (+ bayraklar)
+    uint32_t def;       // Kesin olarak yazılan kaydediciler (+ bayraklar)
+    uint32_t clobber;   // Değişmiş olabilecek kaydediciler (+ bayraklar), def'i de içerir
+} RegisterEffects;
+
+// Bayraklar birinci sınıf bir değer olarak modellenir: bir program noktasındaki
+// bayrakların hangi hesaplamadan geldiği bu yapı ile ifade edilir.
+typedef enum {
+    FLAGS_VALUE_TOP,        // Henüz hesaplanmadı (veri akışı başlangıç değeri)
+    FLAGS_VALUE_UNKNOWN,    // Bilinmiyor veya yollar arasında farklı
+    FLAGS_VALUE_COMPARE,    // CMP lhs, rhs sonucu
+    FLAGS_VALUE_RESULT      // reg'e yazan ADD/SUB sonucunun 0 ile karşılaştırması
+} FlagsValueKind;
+
+typedef struct {
+    FlagsValueKind kind;
+    AstOperand lhs;         // FLAGS_VALUE_COMPARE için (etiket operandı olamaz)
+    AstOperand rhs;
+    int reg;                // FLAGS_VALUE_RESULT için hedef kaydedici
+} FlagsValue;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Bir komutun koşullu atlama olup olmadığını kontrol eder (JEQ, JNE, JLT, JGT).
+ * @param opcode Kontrol edilecek komut türü.
+ * @return Koşullu atlama ise 1, aksi takdirde 0.
+ */
+int cfg_is_conditional_branch(TokenType opcode);
+
+/**
+ * @brief Bir komutun temel bloğu sonlandırıp sonlandırmadığını kontrol eder (atlamalar, JTAB ve RET).
+ * @param opcode Kontrol edilecek komut türü.
+ * @return Blok sonlandırıcı ise 1, aksi takdirde 0.
+ */
+int cfg_is_block_terminator(TokenType opcode);
+
+/**
+ * @brief Akışın komuttan sonra bir sonraki ifadeye düşüp düşmeyeceğini kontrol eder.
+ * JMP, RET ve JTAB (varsayılan hedefi de bir atlamadır) düşme kenarı oluşturmaz.
+ * @param opcode Kontrol edilecek komut türü.
+ * @return Düşme mümkünse 1, aksi takdirde 0.
+ */
+int cfg_has_fallthrough(TokenType opcode);
+
+/**
+ * @brief Program düğümü için kontrol akış grafiğini oluşturur.
+ * Etiket referansları program içindeki etiket bildirimlerine göre çözümlenir.
+ * @param program AST_PROGRAM türündeki kök düğüm.
+ * @return Oluşturulan Cfg pointer'ı veya NULL hata durumunda.
+ */
+Cfg* cfg_build(AstNode* program);
+
+/**
+ * @brief CFG'yi ve tüm bloklarını serbest bırakır (AST'ye dokunmaz).
+ * @param cfg Serbest bırakılacak Cfg pointer'ı.
+ */
+void cfg_free(Cfg* cfg);
+
+/**
+ * @brief Verilen etiketin başlattığı bloğun indeksini bulur.
+ * @param cfg CFG pointer'ı.
+ * @param label_name Aranan etiket adı.
+ * @return Blok indeksi veya bulunamazsa -1.
+ */
+int cfg_block_of_label(const Cfg* cfg, const char* label_name);
+
+/**
+ * @brief Bir bloğun başındaki ilk etiketin adını döndürür.
+ * @param cfg CFG pointer'ı.
+ * @param block Blok indeksi.
+ * @return Etiket adı veya blok etiketle başlamıyorsa NULL.
+ */
+const char* cfg_block_label(const Cfg* cfg, int block);
+
+/**
+ * @brief Bloğun son komutunu döndürür (etiketler atlanır).
+ * @param cfg CFG pointer'ı.
+ * @param block Blok indeksi.
+ * @return Son komut düğümü veya blok sadece etiketlerden oluşuyorsa NULL.
+ */
+AstNode* cfg_block_last_instruction(const Cfg* cfg, int block);
+
+/**
+ * @brief Bloğun belirtilen türdeki çıkış kenarını bulur.
+ * @param cfg CFG pointer'ı.
+ * @param block Blok indeksi.
+ * @param kind Aranan kenar türü.
+ * @return Kenar indeksi veya yoksa -1.
+ */
+int cfg_find_succ_edge(const Cfg* cfg, int block, CfgEdgeKind kind);
+
+/**
+ * @brief CFG'nin yapısal özetini (blok/kenar yapısı ve komut türleri) hesaplar.
+ * Profil verisinin kaynak koda uygunluğunu doğrulamak için kullanılır.
+ * @param cfg CFG pointer'ı.
+ * @return 64-bit FNV-1a özeti.
+ */
+uint64_t cfg_checksum(const Cfg* cfg);
+
+/**
+ * @brief Komutlara uygulanmış profil sayımlarından blok ve kenar ağırlıklarını hesaplar.
+ * @param cfg CFG pointer'ı.
+ * @return Programda profil verisi varsa 1, yoksa 0.
+ */
+int cfg_compute_profile_weights(Cfg* cfg);
+
+/**
+ * @brief Program ifadelerini verilen blok sırasına göre yeniden dizer.
+ * Düşme (fallthrough) kenarları bozulan bloklara JMP eklenir, gerektiğinde koşullu
+ * atlamalar tersine çevrilir, hedefi hemen sonraki blok olan JMP'ler kaldırılır ve
+ * atlama hedefi olan etiketsiz bloklara yeni etiketler (sembol tablosuna da) eklenir.
+ * Bu çağrıdan sonra CFG geçersizdir; cfg_free ile serbest bırakılmalıdır.
+ * @param cfg CFG pointer'ı.
+ * @param order Her bloğun tam bir kez geçtiği yeni blok sırası (order[0] giriş bloğu olmalı).
+ * @param symbol_table Yeni etiketlerin ekleneceği sembol tablosu.
+ * @return Başarılıysa 1, hata durumunda 0 (hata durumunda program değişmez).
+ */
+int cfg_linearize(Cfg* cfg, const int* order, SymbolTable* symbol_table);
+
+/**
+ * @brief Programda kullanılmayan, derleyiciye ait benzersiz bir etiket adı üretir.
+ * @param symbol_table Çakışma kontrolü için sembol tablosu.
+ * @param prefix Etiket öneki (örn: "__bsm_bb").
+ * @param buffer Sonucun yazılacağı arabellek.
+ * @param buffer_size Arabellek boyutu.
+ */
+void cfg_make_unique_label(SymbolTable* symbol_table, const char* prefix, char* buffer, size_t buffer_size);
+
+/**
+ * @brief Bir komutun bayraklar üzerindeki etkisini döndürür.
+ * Kaynak düzeyi anlam tüm motorlarda ve hedeflerde aynıdır (BVM referansı): ADD/SUB bayrakları
+ * sonucun 0 ile karşılaştırması olarak kurar. Aritmetiği bayrak kurmayan hedeflerde kod üretici
+ * bunu gerektiğinde kendisi sağlar; target_arch_arith_sets_flags sadece optimizasyon kararlarını etkiler.
+ * @param instr Komut.
+ * @return Komutun bayrak etkisi.
+ */
+FlagsEffect cfg_instruction_flags_effect(const AstInstruction* instr);
+
+/**
+ * @brief Bir komutun okuduğu/yazdığı kaydedicileri ve bayrakları hesaplar.
+ * SYSCALL ve RET tüm kaydedicileri okur kabul edilir (argümanlar örtük olarak kaydedicilerde).
+ * @param instr Komut.
+ * @return Kaydedici etkileri.
+ */
+RegisterEffects cfg_instruction_register_effects(const AstInstruction* instr);
+
+/**
+ * @brief Kaydedici ve bayrak canlılığını (liveness) hesaplar (geriye doğru veri akışı).
+ * @param cfg CFG pointer'ı.
+ * @param live_in Her blok için giriş canlılık maskesi (num_blocks eleman).
+ * @param live_out Her blok için çıkış canlılık maskesi (num_blocks eleman).
+ */
+void cfg_compute_liveness(const Cfg* cfg, uint32_t* live_in, uint32_t* live_out);
+
+/**
+ * @brief Bir bayrak değerini komutun etkisinden geçirir (ileriye doğru transfer fonksiyonu).
+ * @param value Güncellenecek bayrak değeri.
+ * @param instr Komut.
+ */
+void cfg_flags_transfer(FlagsValue* value, const AstInstruction* instr);
+
+/**
+ * @brief İki bayrak değerinin aynı hesaplamayı temsil edip etmediğini kontrol eder.
+ */
+int cfg_flags_value_equal(const FlagsValue* a, const FlagsValue* b);
+
+/**
+ * @brief Her bloğun girişinde kullanılabilir bayrak değerini hesaplar.
+ * Bir bloğa gelen tüm yollarda aynı karşılaştırma geçerliyse o değer, aksi halde UNKNOWN olur.
+ * @param cfg CFG pointer'ı.
+ * @param block_in Her blok için giriş bayrak değeri (num_blocks eleman).
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int cfg_compute_available_flags(const Cfg* cfg, FlagsValue* block_in);
+
+/**
+ * @brief CALL hedeflerinden alt programları ve kapsamlarını bulur.
+ * Aynı bloğu işaret eden farklı etiketler tek bir alt program olarak sayılır.
+ * @param cfg CFG pointer'ı.
+ * @param subroutines Bulunan alt programların dizisi buraya yazılır (cfg_free_subroutines ile serbest bırakılır).
+ * @param count Alt program sayısı buraya yazılır.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int cfg_find_subroutines(const Cfg* cfg, CfgSubroutine** subroutines, size_t* count);
+
+/**
+ * @brief cfg_find_subroutines tarafından döndürülen diziyi serbest bırakır.
+ * @param subroutines Alt program dizisi.
+ * @param count Alt program sayısı.
+ */
+void cfg_free_subroutines(CfgSubroutine* subroutines, size_t count);
+
+/**
+ * @brief Bir CALL komutunun çağırdığı alt programın indeksini bulur.
+ * @param cfg CFG pointer'ı.
+ * @param subroutines cfg_find_subroutines sonucu.
+ * @param count Alt program sayısı.
+ * @param call CALL komutu düğümü.
+ * @return Alt program indeksi veya CALL değilse/hedef bulunamazsa -1.
+ */
+int cfg_subroutine_of_call(const Cfg* cfg, const CfgSubroutine* subroutines, size_t count, const AstNode* call);
+
+// --- Doğal Döngüler ---
+// Bir geri kenar (hedefi kaynağını domine eden kenar) bir doğal döngü tanımlar: başlık ve
+// geri kenarın kaynağından başlığa uğramadan geriye doğru ulaşılabilen bloklar. Aynı
+// başlığa dönen geri kenarların döngüleri birleştirilir. Dominatörler program girişi,
+// öncülü olmayan bloklar ve CALL hedefleri kök kabul edilerek hesaplanır; böylece alt
+// programların içindeki döngüler de bulunur.
+typedef struct {
+    int header;                 // Döngü başlığı (döngüye tek giriş noktası)
+    unsigned char* in_loop;     // num_blocks elemanlı üyelik dizisi (1 = döngüye ait)
+    size_t num_body_blocks;     // Döngüdeki blok sayısı (başlık dahil)
+    size_t num_back_edges;      // Başlığa dönen geri kenar sayısı
+    int parent;                 // İçinde bulunduğu en yakın döngü (yoksa -1)
+    int depth;                  // İç içelik derinliği (en dış döngü 1)
+} CfgLoop;
+
+/**
+ * @brief Her bloğun anlık dominatörünü (immediate dominator) hesaplar (Cooper-Harvey-Kennedy).
+ * @param cfg CFG pointer'ı.
+ * @param idom num_blocks elemanlı dizi; kök ve ulaşılamayan bloklar için -1 yazılır.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int cfg_compute_dominators(const Cfg* cfg, int* idom);
+
+/**
+ * @brief a bloğunun b bloğunu domine edip etmediğini kontrol eder (her blok kendini domine eder).
+ * @param idom cfg_compute_dominators sonucu.
+ */
+int cfg_dominates(const int* idom, int a, int b);
+
+/**
+ * @brief CFG'deki doğal döngüleri bulur (başlık sırasına göre).
+ * @param cfg CFG pointer'ı.
+ * @param loops Bulunan döngülerin dizisi buraya yazılır (cfg_free_loops ile serbest bırakılır).
+ * @param count Döngü sayısı buraya yazılır.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int cfg_find_loops(const Cfg* cfg, CfgLoop** loops, size_t* count);
+
+/**
+ * @brief cfg_find_loops tarafından döndürülen diziyi serbest bırakır.
+ * @param loops Döngü dizisi.
+ * @param count Döngü sayısı.
+ */
+void cfg_free_loops(CfgLoop* loops, size_t count);
+
+#endif // CFG_H
@@ -1 +1,254 @@
-
+#include "cli_args.h"
+#include "optimizer.h" // OptimizationLevel
+#include "vbsm.h" // vbsm_has_extension
+#include "wasm.h" // wasm_has_extension
+#include "object_file_writer.h" // object_file_has_extension
+#include <stdio.h>  // fprintf
+#include <stdlib.h> // strtol
+#include <string.h> // strcmp, strncmp
+#include <errno.h>  // errno
+
+// --- Dahili Yardımcı Fonksiyonlar ---
+
+/**
+ * @brief "--secenek=deger" veya "--secenek deger" biçimindeki bir seçeneğin değerini alır.
+ * @param argc Argüman sayısı.
+ * @param argv Argüman dizisi.
+ * @param index Mevcut argümanın indeksi; ayrı verilen değer tüketilirse ilerletilir.
+ * @param option Seçenek adı (örn: "--opt-budget-ms").
+ * @return Değer, seçenek eşleşmezse NULL. Eşleşip değer eksikse "" döner.
+ */
+static const char* option_value(int argc, char** argv, int* index, const char* option) {
+    const char* arg = argv[*index];
+    size_t length = strlen(option);
+    if (strncmp(arg, option, length) != 0) return NULL;
+    if (arg[length] == '=') return arg + length + 1;
+    if (arg[length] != '\0') return NULL; // Başka bir seçeneğin öneki
+    if (*index + 1 >= argc) return "";
+    (*index)++;
+    return argv[*index];
+}
+
+/**
+ * @brief Negatif olmayan bir tamsayı değeri ayrıştırır.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+static int parse_non_negative(const char* text, long* value) {
+    if (!text || !*text) return 0;
+    char* end = NULL;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (errno != 0 || *end != '\0' || parsed < 0) return 0;
+    *value = parsed;
+    return 1;
+}
+
+// --- Harici Fonksiyon Gerçeklemeleri ---
+
+void cli_args_print_usage(const char* program_name) {
+    fprintf(stdout,
+            "Kullanım: %s [seçenekler] <dosya.bsm | dosya.bsmir | dosya.vbsm>\n"
+            "\n"
+            "Seçenekler:\n"
+            "  -o <dosya>                 Çıktı dosyası (.vbsm: BVM bayt kodu, .wasm: WebAssembly modülü,\n"
+            "                             .o: Linux ELF nesne dosyası; amd64, armv8, armv9,\n"
+            "                             rv64i veya rv64e)\n"
+            "  -O0                        Optimizasyon yok (hızlı derleme)\n"
+            "  -O1                        Ucuz yerel optimizasyonlar (varsayılan)\n"
+            "  -O2                        Tüm optimizasyonlar\n"
+            "  -O3                        Tüm optimizasyonlar, agresif satır içi açma\n"
+            "  -Os                        Boyut için optimizasyon\n"
+            "  --opt-budget-ms=<ms>       Derleme süresi bütçesi; aşılacaksa pahalı geçişler atlanır\n"
+            "  --target-arch=<mimari>     Hedef mimari (örn: amd64, armv8, rv64i)\n"
+            "  --target-os=<sistem>       Hedef işletim sistemi (örn: linux, baremetal)\n"
+            "  --profile-generate[=<yol>] PGO sayaçlarıyla enstrümante et\n"
+            "  --profile-use=<yol>        .bsmprof profiliyle optimize et\n"
+            "  --superopt-rules=<yol>     .bsmrules süperoptimizasyon kurallarını uygula\n"
+            "  --superoptimize            Sıcak diziler için yeni kurallar ara ve veritabanına ekle (yavaş)\n"
+            "  --dump-ir                  Optimize edilmiş programın IR'sini yazdır\n"
+            "  --emit-ir=<yol>            Optimize edilmiş IR'yi ikili .bsmir dosyasına yaz (önbellek)\n"
+            "  --run[=bvm|jit|tiered]     Programı BVM'de, JIT ile süreç içinde veya BVM'de başlayıp sıcak\n"
+            "                             döngülerde makine koduna geçerek yürüt; çıkış kodu programınkidir\n"
+            "                             (jit/tiered: sadece Linux x86-64)\n"
+            "  --osr-threshold=<n>        Katmanlı yürütmede JIT derlemesini başlatan döngü girişi sayısı\n"
+            "  --bvm-dispatch-profile=<yol> Yürütmedeki bitişik komut dizilerinin sıklığını yaz\n"
+            "  --bvm-superinstructions=<yol> BVM üst-komutlarını bu gönderim profilinden seç\n"
+            "  -h, --help                 Bu yardımı göster\n",
+            program_name ? program_name : "bessambly");
+}
+
+int cli_args_parse(int argc, char** argv, CliArgs* args) {
+    args->input_path = NULL;
+    args->output_path = NULL;
+    args->optimization_level = OPT_LEVEL_O1;
+    args->opt_budget_ms = 0;
+    args->target_arch = UNKNOWN_ARCH;
+    args->target_os = UNKNOWN_OS;
+    args->profile_generate = 0;
+    args->profile_path = NULL;
+    args->profile_use = 0;
+    args->superopt_rules_path = NULL;
+    args->superoptimize = 0;
+    args->dump_ir = 0;
+    args->emit_ir_path = NULL;
+    args->run = RUN_NONE;
+    args->osr_threshold = 0;
+    args->dispatch_profile_path = NULL;
+    args->superinstructions_path = NULL;
+    args->show_help = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value;
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            args->show_help = 1;
+        } else if (strcmp(arg, "-O0") == 0) {
+            args->optimization_level = OPT_LEVEL_O0;
+        } else if (strcmp(arg, "-O1") == 0 || strcmp(arg, "-O") == 0) {
+            args->optimization_level = OPT_LEVEL_O1;
+        } else if (strcmp(arg, "-O2") == 0) {
+            args->optimization_level = OPT_LEVEL_O2;
+        } else if (strcmp(arg, "-O3") == 0) {
+            args->optimization_level = OPT_LEVEL_O3;
+        } else if (strcmp(arg, "-Os") == 0) {
+            args->optimization_level = OPT_LEVEL_OS;
+        } else if (strcmp(arg, "-o") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Hata: '-o' seçeneği bir dosya adı bekliyor.\n");
+                return 0;
+            }
+            args->output_path = argv[++i];
+        } else if ((value = option_value(argc, argv, &i, "--opt-budget-ms")) != NULL) {
+            if (!parse_non_negative(value, &args->opt_budget_ms)) {
+                fprintf(stderr, "Hata: '--opt-budget-ms' negatif olmayan bir milisaniye değeri bekliyor: '%s'\n", value);
+                return 0;
+            }
+        } else if ((value = option_value(argc, argv, &i, "--target-arch")) != NULL) {
+            args->target_arch = target_arch_from_string(value);
+            if (args->target_arch == UNKNOWN_ARCH) {
+                fprintf(stderr, "Hata: Bilinmeyen hedef mimari: '%s'\n", value);
+                return 0;
+            }
+        } else if ((value = option_value(argc, argv, &i, "--target-os")) != NULL) {
+            args->target_os = target_os_from_string(value);
+            if (args->target_os == UNKNOWN_OS) {
+                fprintf(stderr, "Hata: Bilinmeyen hedef işletim sistemi: '%s'\n", value);
+                return 0;
+            }
+        } else if (strncmp(arg, "--profile-generate", 18) == 0 && (arg[18] == '\0' || arg[18] == '=')) {
+            // Değer isteğe bağlıdır; ayrı argüman olarak verilirse giriş dosyasıyla karışır
+            args->profile_generate = 1;
+            if (arg[18] == '=') args->profile_path = arg + 19;
+        } else if ((value = option_value(argc, argv, &i, "--profile-use")) != NULL) {
+            if (!*value) {
+                fprintf(stderr, "Hata: '--profile-use' bir .bsmprof dosya yolu bekliyor.\n");
+                return 0;
+            }
+            args->profile_use = 1;
+            args->profile_path = value;
+        } else if ((value = option_value(argc, argv, &i, "--superopt-rules")) != NULL) {
+            if (!*value) {
+                fprintf(stderr, "Hata: '--superopt-rules' bir .bsmrules dosya yolu bekliyor.\n");
+                return 0;
+            }
+            args->superopt_rules_path = value;
+        } else if (strcmp(arg, "--superoptimize") == 0) {
+            args->superoptimize = 1;
+        } else if (strcmp(arg, "--dump-ir") == 0) {
+            args->dump_ir = 1;
+        } else if ((value = option_value(argc, argv, &i, "--emit-ir")) != NULL) {
+            if (!*value) {
+                fprintf(stderr, "Hata: '--emit-ir' bir .bsmir dosya yolu bekliyor.\n");
+                return 0;
+            }
+            args->emit_ir_path = value;
+        } else if (strncmp(arg, "--run", 5) == 0 && (arg[5] == '\0' || arg[5] == '=')) {
+            // --profile-generate gibi: değer sadece '=' ile verilir
+            if (arg[5] == '\0' || strcmp(arg + 6, "bvm") == 0) {
+                args->run = RUN_BVM;
+            } else if (strcmp(arg + 6, "jit") == 0) {
+                args->run = RUN_JIT;
+            } else if (strcmp(arg + 6, "tiered") == 0) {
+                args->run = RUN_TIERED;
+            } else {
+                fprintf(stderr, "Hata: Bilinmeyen yürütme kipi: '%s' (bvm, jit veya tiered bekleniyor)\n", arg + 6);
+                return 0;
+            }
+        } else if ((value = option_value(argc, argv, &i, "--osr-threshold")) != NULL) {
+            if (!parse_non_negative(value, &args->osr_threshold) || args->osr_threshold == 0) {
+                fprintf(stderr, "Hata: '--osr-threshold' pozitif bir sayı bekliyor: '%s'\n", value);
+                return 0;
+            }
+        } else if ((value = option_value(argc, argv, &i, "--bvm-dispatch-profile")) != NULL) {
+            if (!*value) {
+                fprintf(stderr, "Hata: '--bvm-dispatch-profile' bir dosya yolu bekliyor.\n");
+                return 0;
+            }
+            args->dispatch_profile_path = value;
+        } else if ((value = option_value(argc, argv, &i, "--bvm-superinstructions")) != NULL) {
+            if (!*value) {
+                fprintf(stderr, "Hata: '--bvm-superinstructions' bir gönderim profili yolu bekliyor.\n");
+                return 0;
+            }
+            args->superinstructions_path = value;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            fprintf(stderr, "Hata: Bilinmeyen seçenek: '%s'\n", arg);
+            return 0;
+        } else if (args->input_path) {
+            fprintf(stderr, "Hata: Birden fazla giriş dosyası verildi ('%s' ve '%s').\n", args->input_path, arg);
+            return 0;
+        } else {
+            args->input_path = arg;
+        }
+    }
+
+    if (args->show_help) return 1;
+    if (args->profile_generate && args->profile_use) {
+        fprintf(stderr, "Hata: '--profile-generate' ve '--profile-use' birlikte kullanılamaz.\n");
+        return 0;
+    }
+    if (args->superoptimize && !args->superopt_rules_path) {
+        fprintf(stderr, "Hata: '--superoptimize' sonuçların yazılacağı bir kural veritabanı gerektirir "
+                        "(--superopt-rules=<yol>).\n");
+        return 0;
+    }
+    if (!args->input_path) {
+        fprintf(stderr, "Hata: Giriş dosyası belirtilmedi.\n");
+        return 0;
+    }
+    if ((args->run == RUN_JIT || args->run == RUN_TIERED) && vbsm_has_extension(args->input_path)) {
+        fprintf(stderr, "Hata: '--run=jit' ve '--run=tiered' IR'den derler; .vbsm girişi sadece BVM'de "
+                        "yürütülebilir.\n");
+        return 0;
+    }
+    if (args->output_path && wasm_has_extension(args->output_path) && vbsm_has_extension(args->input_path)) {
+        fprintf(stderr, "Hata: .wasm çıktısı IR'den üretilir; .vbsm girişi için kullanılamaz.\n");
+        return 0;
+    }
+    if (args->output_path && object_file_has_extension(args->output_path)) {
+        if (vbsm_has_extension(args->input_path)) {
+            fprintf(stderr, "Hata: .o çıktısı IR'den üretilir; .vbsm girişi için kullanılamaz.\n");
+            return 0;
+        }
+        // Hedef verilmezse amd64/linux varsayılır
+        if ((args->target_arch != UNKNOWN_ARCH && args->target_arch != ARCH_AMD64 && args->target_arch != ARCH_ARMV8 &&
+             args->target_arch != ARCH_ARMV9 && args->target_arch != ARCH_RV64I && args->target_arch != ARCH_RV64E) ||
+            (args->target_os != UNKNOWN_OS && args->target_os != OS_LINUX)) {
+            fprintf(stderr, "Hata: Nesne dosyası üretimi şimdilik sadece amd64, armv8, armv9, rv64i ve "
+                            "rv64e (linux) hedeflerini destekliyor.\n");
+            return 0;
+        }
+    }
+    if (args->osr_threshold && args->run != RUN_TIERED) {
+        fprintf(stderr, "Hata: '--osr-threshold' katmanlı yürütme gerektirir (--run=tiered).\n");
+        return 0;
+    }
+    if ((args->dispatch_profile_path || args->superinstructions_path) && args->run != RUN_BVM &&
+        !vbsm_has_extension(args->input_path)) {
+        fprintf(stderr, "Hata: '--bvm-dispatch-profile' ve '--bvm-superinstructions' BVM'de yürütme "
+                        "gerektirir (--run veya --run=bvm).\n");
+        return 0;
+    }
+    return 1;
+}
@@ -1 +1,60 @@
-
+#ifndef CLI_ARGS_H
+#define CLI_ARGS_H
+
+#include "os/target.h" // TargetArchitecture, TargetOperatingSystem
+
+// --- Yürütme Kipi (--run) ---
+typedef enum {
+    RUN_NONE,                       // Yürütme yok (sadece derle)
+    RUN_BVM,                        // BVM bayt kodu yorumlayıcısında yürüt (--run, --run=bvm)
+    RUN_JIT,                        // Makine koduna derleyip süreç içinde yürüt (--run=jit)
+    RUN_TIERED                      // BVM'de başla, sıcak döngüde makine koduna geç (--run=tiered)
+} RunMode;
+
+// --- Komut Satırı Seçenekleri ---
+typedef struct {
+    const char* input_path;         // Derlenecek .bsm, önbelleğe alınmış .bsmir veya yürütülecek .vbsm dosyası (argv'ye aittir)
+    const char* output_path;        // Çıktı dosyası (-o), verilmezse NULL
+
+    int optimization_level;         // OptimizationLevel (-O0, -O1, -O2, -O3, -Os)
+    long opt_budget_ms;             // --opt-budget-ms: derleme süresi bütçesi, 0 = sınırsız
+
+    TargetArchitecture target_arch; // --target-arch
+    TargetOperatingSystem target_os; // --target-os
+
+    int profile_generate;           // --profile-generate: PGO sayaçlarıyla enstrümante et
+    const char* profile_path;       // --profile-generate=<yol> çıktı yolu veya --profile-use=<yol> girdi yolu
+    int profile_use;                // --profile-use: .bsmprof ile optimize et
+
+    const char* superopt_rules_path; // --superopt-rules=<yol>: gözetleme deliği kural veritabanı
+    int superoptimize;              // --superoptimize: yeni kurallar ara ve veritabanına ekle
+
+    int dump_ir;                    // --dump-ir: optimize edilmiş programın IR'sini yazdır
+    const char* emit_ir_path;       // --emit-ir=<yol>: optimize edilmiş IR'yi ikili .bsmir dosyasına yaz
+    int run;                        // RunMode: --run[=bvm|jit|tiered] (.vbsm girişi için her zaman RUN_BVM)
+    long osr_threshold;             // --osr-threshold: katmanlı yürütmede derlemeyi başlatan döngü girişi, 0 = varsayılan
+    const char* dispatch_profile_path; // --bvm-dispatch-profile=<yol>: yürütmenin gönderim profilini yaz
+    const char* superinstructions_path; // --bvm-superinstructions=<yol>: üst-komutları bu gönderim profilinden seç
+
+    int show_help;                  // -h / --help verildi
+} CliArgs;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Komut satırı argümanlarını ayrıştırır.
+ * Hatalı argümanlarda stderr'e açıklayıcı bir mesaj yazılır.
+ * @param argc Argüman sayısı.
+ * @param argv Argüman dizisi.
+ * @param args Sonuçların yazılacağı yapı (varsayılanlarla doldurulur).
+ * @return Başarılıysa 1, hatalı argümanlarda 0.
+ */
+int cli_args_parse(int argc, char** argv, CliArgs* args);
+
+/**
+ * @brief Kullanım bilgisini yazdırır.
+ * @param program_name Çalıştırılabilir dosyanın adı (argv[0]).
+ */
+void cli_args_print_usage(const char* program_name);
+
+#endif // CLI_ARGS_H
@@ -0,0 +1,393 @@
+#include "ir_file.h"
+#include <stdlib.h> // malloc, free
+#include <stdio.h>  // fprintf, FILE
+#include <string.h> // memcmp, memcpy, memset, strlen, strcmp, strerror
+#include <errno.h>  // errno, EINTR
+
+#ifdef _WIN32
+// mmap/writev olmayan platformlarda dosya stdio ile yazılır ve tek bir tampona okunur
+#define IR_FILE_USE_STDIO 1
+#else
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <sys/uio.h>  // writev, struct iovec
+#include <unistd.h>   // close
+#endif
+
+#define IR_FILE_EXTENSION ".bsmir"
+
+// --- Yardımcı Fonksiyonlar ---
+
+#define IR_FILE_HASH_SEED 0xcbf29ce484222325ULL
+
+static const uint8_t ir_file_padding[IR_FILE_ALIGNMENT] = {0};
+
+static uint64_t ir_file_align(uint64_t offset) {
+    return (offset + IR_FILE_ALIGNMENT - 1) & ~(uint64_t)(IR_FILE_ALIGNMENT - 1);
+}
+
+/**
+ * @brief FNV-1a özetini verilen baytlarla günceller.
+ */
+static uint64_t ir_file_hash(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+int ir_file_has_extension(const char* path) {
+    size_t length = path ? strlen(path) : 0;
+    size_t extension = strlen(IR_FILE_EXTENSION);
+    return length > extension && strcmp(path + length - extension, IR_FILE_EXTENSION) == 0;
+}
+
+/**
+ * @brief IrFunction tablolarını bölüm sırasıyla (veri, eleman sayısı, eleman boyutu) listeler.
+ */
+static void ir_file_describe_sections(const IrFunction* fn, const void* data[IR_FILE_NUM_SECTIONS],
+                                      IrFileSection sections[IR_FILE_NUM_SECTIONS]) {
+    data[IR_FILE_SECTION_INSTRS] = fn->instrs;
+    sections[IR_FILE_SECTION_INSTRS].count = fn->num_instrs;
+    sections[IR_FILE_SECTION_INSTRS].element_size = sizeof(IrInstr);
+    data[IR_FILE_SECTION_LOCATIONS] = fn->locations;
+    sections[IR_FILE_SECTION_LOCATIONS].count = fn->num_instrs;
+    sections[IR_FILE_SECTION_LOCATIONS].element_size = sizeof(IrSourceLocation);
+    data[IR_FILE_SECTION_BLOCKS] = fn->blocks;
+    sections[IR_FILE_SECTION_BLOCKS].count = fn->num_blocks;
+    sections[IR_FILE_SECTION_BLOCKS].element_size = sizeof(IrBlock);
+    data[IR_FILE_SECTION_LAYOUT] = fn->layout;
+    sections[IR_FILE_SECTION_LAYOUT].count = fn->num_layout;
+    sections[IR_FILE_SECTION_LAYOUT].element_size = sizeof(uint32_t);
+    data[IR_FILE_SECTION_LABELS] = fn->labels;
+    sections[IR_FILE_SECTION_LABELS].count = fn->num_labels;
+    sections[IR_FILE_SECTION_LABELS].element_size = sizeof(IrLabel);
+    data[IR_FILE_SECTION_STRINGS] = fn->strings;
+    sections[IR_FILE_SECTION_STRINGS].count = fn->strings_size;
+    sections[IR_FILE_SECTION_STRINGS].element_size = 1;
+    data[IR_FILE_SECTION_VREGS] = fn->vregs;
+    sections[IR_FILE_SECTION_VREGS].count = fn->num_vregs;
+    sections[IR_FILE_SECTION_VREGS].element_size = sizeof(IrVreg);
+    data[IR_FILE_SECTION_CONSTANTS] = fn->constants;
+    sections[IR_FILE_SECTION_CONSTANTS].count = fn->num_constants;
+    sections[IR_FILE_SECTION_CONSTANTS].element_size = sizeof(int64_t);
+    data[IR_FILE_SECTION_JUMP_TABLES] = fn->jump_tables;
+    sections[IR_FILE_SECTION_JUMP_TABLES].count = fn->num_jump_tables;
+    sections[IR_FILE_SECTION_JUMP_TABLES].element_size = sizeof(IrJumpTable);
+    data[IR_FILE_SECTION_SYSCALLS] = fn->syscalls;
+    sections[IR_FILE_SECTION_SYSCALLS].count = fn->num_syscalls;
+    sections[IR_FILE_SECTION_SYSCALLS].element_size = sizeof(IrSyscall);
+    data[IR_FILE_SECTION_POOL] = fn->pool;
+    sections[IR_FILE_SECTION_POOL].count = fn->pool_size;
+    sections[IR_FILE_SECTION_POOL].element_size = sizeof(uint32_t);
+}
+
+// --- Yazma ---
+
+#ifndef IR_FILE_USE_STDIO
+/**
+ * @brief Tüm parçaları yazana kadar writev çağırır (kısa yazma ve kesintiler için).
+ * Normalde tek bir çağrı yeterlidir.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+static int ir_file_writev_all(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (uint8_t*)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return 1;
+}
+#endif
+
+int ir_file_write(const char* path, const IrFunction* fn) {
+    if (!path || !fn) return 0;
+
+    IrFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, IR_FILE_MAGIC, sizeof(header.magic));
+    header.version = IR_FILE_VERSION;
+    header.header_size = sizeof(IrFileHeader);
+    header.byte_order = IR_FILE_BYTE_ORDER_MARK;
+    header.arith_sets_flags = fn->arith_sets_flags ? 1 : 0;
+
+    const void* data[IR_FILE_NUM_SECTIONS];
+    ir_file_describe_sections(fn, data, header.sections);
+
+    // Parçalar: başlık, her bölüm için hizalama dolgusu ve veri
+    const void* piece_data[1 + 2 * IR_FILE_NUM_SECTIONS];
+    size_t piece_size[1 + 2 * IR_FILE_NUM_SECTIONS];
+    int num_pieces = 1;
+    uint64_t offset = sizeof(IrFileHeader);
+    uint64_t checksum = IR_FILE_HASH_SEED;
+    for (int s = 0; s < IR_FILE_NUM_SECTIONS; s++) {
+        IrFileSection* section = &header.sections[s];
+        uint64_t aligned = ir_file_align(offset);
+        if (aligned > offset) {
+            piece_data[num_pieces] = ir_file_padding;
+            piece_size[num_pieces] = (size_t)(aligned - offset);
+            checksum = ir_file_hash(checksum, ir_file_padding, piece_size[num_pieces]);
+            num_pieces++;
+        }
+        section->offset = aligned;
+        size_t size = (size_t)(section->count * section->element_size);
+        if (size > 0) {
+            piece_data[num_pieces] = data[s];
+            piece_size[num_pieces] = size;
+            checksum = ir_file_hash(checksum, data[s], size);
+            num_pieces++;
+        }
+        offset = aligned + size;
+    }
+    header.file_size = offset;
+    header.checksum = checksum;
+    piece_data[0] = &header;
+    piece_size[0] = sizeof(header);
+
+    int ok;
+#ifdef IR_FILE_USE_STDIO
+    FILE* file = fopen(path, "wb");
+    ok = file != NULL;
+    for (int p = 0; p < num_pieces && ok; p++) ok = fwrite(piece_data[p], 1, piece_size[p], file) == piece_size[p];
+    if (file && fclose(file) != 0) ok = 0;
+#else
+    struct iovec iov[1 + 2 * IR_FILE_NUM_SECTIONS];
+    for (int p = 0; p < num_pieces; p++) {
+        iov[p].iov_base = (void*)piece_data[p];
+        iov[p].iov_len = piece_size[p];
+    }
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ok = fd >= 0 && ir_file_writev_all(fd, iov, num_pieces);
+    if (fd >= 0 && close(fd) != 0) ok = 0;
+#endif
+    if (!ok) {
+        fprintf(stderr, "Hata: IR dosyası '%s' yazılamadı: %s\n", path, strerror(errno));
+    }
+    return ok;
+}
+
+// --- Yükleme ---
+
+static void ir_file_release(void* mapping, size_t size) {
+#ifdef IR_FILE_USE_STDIO
+    (void)size;
+    free(mapping);
+#else
+    munmap(mapping, size);
+#endif
+}
+
+/**
+ * @brief Başlığı ve bölüm tablosunu denetler.
+ * @return Geçerliyse 1, aksi takdirde 0.
+ */
+static int ir_file_check_header(const IrFileHeader* header, uint64_t file_size, const char* path) {
+    if (memcmp(header->magic, IR_FILE_MAGIC, sizeof(header->magic)) != 0) {
+        fprintf(stderr, "Hata: '%s' bir Bessambly IR dosyası değil.\n", path);
+        return 0;
+    }
+    if (header->version != IR_FILE_VERSION || header->header_size != sizeof(IrFileHeader)) {
+        fprintf(stderr, "Hata: '%s' desteklenmeyen IR dosyası sürümü (%u, beklenen %d).\n", path,
+                header->version, IR_FILE_VERSION);
+        return 0;
+    }
+    if (header->byte_order != IR_FILE_BYTE_ORDER_MARK) {
+        fprintf(stderr, "Hata: '%s' farklı bayt sırasına sahip bir makinede üretilmiş.\n", path);
+        return 0;
+    }
+    if (header->file_size != file_size) {
+        fprintf(stderr, "Hata: '%s' IR dosyası kesik veya bozuk (boyut uyuşmuyor).\n", path);
+        return 0;
+    }
+
+    IrFileSection expected[IR_FILE_NUM_SECTIONS];
+    const void* unused[IR_FILE_NUM_SECTIONS];
+    IrFunction empty;
+    memset(&empty, 0, sizeof(empty));
+    ir_file_describe_sections(&empty, unused, expected);
+    for (int s = 0; s < IR_FILE_NUM_SECTIONS; s++) {
+        const IrFileSection* section = &header->sections[s];
+        if (section->element_size != expected[s].element_size) {
+            fprintf(stderr, "Hata: '%s' IR dosyasının yapı düzeni bu derleyiciyle uyumsuz.\n", path);
+            return 0;
+        }
+        if (section->offset % IR_FILE_ALIGNMENT != 0 || section->offset < sizeof(IrFileHeader) ||
+            section->offset > file_size || section->count > (file_size - section->offset) / section->element_size) {
+            fprintf(stderr, "Hata: '%s' IR dosyasında bölüm %d dosya sınırları dışında.\n", path, s);
+            return 0;
+        }
+    }
+    if (header->sections[IR_FILE_SECTION_LOCATIONS].count != header->sections[IR_FILE_SECTION_INSTRS].count) {
+        fprintf(stderr, "Hata: '%s' IR dosyasında konum tablosu komut sayısıyla uyuşmuyor.\n", path);
+        return 0;
+    }
+    if (ir_file_hash(IR_FILE_HASH_SEED, (const uint8_t*)header + sizeof(IrFileHeader),
+                     (size_t)(file_size - sizeof(IrFileHeader))) != header->checksum) {
+        fprintf(stderr, "Hata: '%s' IR dosyası bozuk (özet uyuşmuyor).\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Tablolar arası indeksleri denetler; ir_verify sadece sınırları geçerli tablolarda çalışır.
+ * @return Geçerliyse 1, aksi takdirde 0.
+ */
+static int ir_file_check_tables(const IrFunction* fn) {
+    if (fn->num_vregs <= IR_VREG_FLAGS || fn->num_vregs > IR_MAX_VREGS) return 0;
+    for (size_t v = 0; v < fn->num_vregs; v++) {
+        const IrVreg* vreg = &fn->vregs[v];
+        IrVregClass expected = v == IR_VREG_FLAGS ? IR_CLASS_FLAGS : IR_CLASS_INT;
+        if (vreg->origin < -1 || vreg->origin > IR_NUM_REGISTERS) return 0;
+        if (v < IR_FIRST_VIRTUAL && (vreg->vreg_class != expected || vreg->origin != (int)v)) return 0;
+        if (vreg->vreg_class != IR_CLASS_INT && vreg->vreg_class != IR_CLASS_FLAGS) return 0;
+    }
+    if (fn->strings_size > 0 && fn->strings[fn->strings_size - 1] != '\0') return 0;
+    for (size_t l = 0; l < fn->num_labels; l++) {
+        if (fn->labels[l].name >= fn->strings_size) return 0;
+    }
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        if (block->first > fn->num_instrs || block->num_instrs > fn->num_instrs - block->first) return 0;
+        if (block->first_label > fn->num_labels || block->num_labels > fn->num_labels - block->first_label) return 0;
+    }
+    for (size_t l = 0; l < fn->num_layout; l++) {
+        if (fn->layout[l] >= fn->num_blocks || !fn->blocks[fn->layout[l]].placed) return 0;
+    }
+    for (size_t t = 0; t < fn->num_jump_tables; t++) {
+        const IrJumpTable* table = &fn->jump_tables[t];
+        if (table->first_target > fn->pool_size || table->num_targets > fn->pool_size - table->first_target) return 0;
+    }
+    for (size_t s = 0; s < fn->num_syscalls; s++) {
+        const IrSyscall* syscall = &fn->syscalls[s];
+        if (syscall->first_arg > fn->pool_size || syscall->num_args > fn->pool_size - syscall->first_arg) return 0;
+        for (uint32_t a = 0; a < syscall->num_args; a++) {
+            if (fn->pool[syscall->first_arg + a] >= IR_NUM_REGISTERS) return 0;
+        }
+    }
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if ((instr->attrs & IR_ATTR_WIDE) &&
+            (instr->u.op.imm < 0 || (size_t)instr->u.op.imm >= fn->num_constants)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+IrFunction* ir_file_load(const char* path) {
+    uint8_t* mapping = NULL;
+    size_t size = 0;
+
+#ifdef IR_FILE_USE_STDIO
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Hata: IR dosyası '%s' açılamadı: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    long length = (fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+    if (length >= (long)sizeof(IrFileHeader) && fseek(file, 0, SEEK_SET) == 0) {
+        size = (size_t)length;
+        mapping = (uint8_t*)malloc(size);
+        if (mapping && fread(mapping, 1, size, file) != size) {
+            free(mapping);
+            mapping = NULL;
+        }
+    }
+    fclose(file);
+    if (!mapping) {
+        fprintf(stderr, "Hata: IR dosyası '%s' okunamadı.\n", path);
+        return NULL;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Hata: IR dosyası '%s' açılamadı: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(IrFileHeader)) {
+        fprintf(stderr, "Hata: '%s' bir Bessambly IR dosyası değil.\n", path);
+        close(fd);
+        return NULL;
+    }
+    size = (size_t)info.st_size;
+    // MAP_PRIVATE: sayfalar süreçler arasında paylaşılır, yazma sadece bu sürecin kopyasını değiştirir
+    void* mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        fprintf(stderr, "Hata: IR dosyası '%s' belleğe eşlenemedi: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    mapping = (uint8_t*)mapped;
+#endif
+
+    const IrFileHeader* header = (const IrFileHeader*)mapping;
+    if (!ir_file_check_header(header, size, path)) {
+        ir_file_release(mapping, size);
+        return NULL;
+    }
+
+    IrFunction* fn = (IrFunction*)calloc(1, sizeof(IrFunction));
+    if (!fn) {
+        fprintf(stderr, "Hata: IR fonksiyonu için bellek tahsis edilemedi.\n");
+        ir_file_release(mapping, size);
+        return NULL;
+    }
+    // Tablolar eşlenmiş belleği gösterir; kapasiteler 0 kalır (ödünç alınmış diziler)
+    fn->mapping = mapping;
+    fn->mapping_size = size;
+    fn->release_mapping = ir_file_release;
+    fn->current_block = IR_NO_BLOCK;
+    fn->arith_sets_flags = header->arith_sets_flags ? 1 : 0;
+
+    const IrFileSection* sections = header->sections;
+#define IR_FILE_SECTION_DATA(kind) ((void*)(mapping + sections[kind].offset))
+    fn->instrs = (IrInstr*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_INSTRS);
+    fn->locations = (IrSourceLocation*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_LOCATIONS);
+    fn->num_instrs = (size_t)sections[IR_FILE_SECTION_INSTRS].count;
+    fn->blocks = (IrBlock*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_BLOCKS);
+    fn->num_blocks = (size_t)sections[IR_FILE_SECTION_BLOCKS].count;
+    fn->layout = (uint32_t*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_LAYOUT);
+    fn->num_layout = (size_t)sections[IR_FILE_SECTION_LAYOUT].count;
+    fn->labels = (IrLabel*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_LABELS);
+    fn->num_labels = (size_t)sections[IR_FILE_SECTION_LABELS].count;
+    fn->strings = (char*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_STRINGS);
+    fn->strings_size = (size_t)sections[IR_FILE_SECTION_STRINGS].count;
+    fn->vregs = (IrVreg*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_VREGS);
+    fn->num_vregs = (size_t)sections[IR_FILE_SECTION_VREGS].count;
+    fn->constants = (int64_t*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_CONSTANTS);
+    fn->num_constants = (size_t)sections[IR_FILE_SECTION_CONSTANTS].count;
+    fn->jump_tables = (IrJumpTable*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_JUMP_TABLES);
+    fn->num_jump_tables = (size_t)sections[IR_FILE_SECTION_JUMP_TABLES].count;
+    fn->syscalls = (IrSyscall*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_SYSCALLS);
+    fn->num_syscalls = (size_t)sections[IR_FILE_SECTION_SYSCALLS].count;
+    fn->pool = (uint32_t*)IR_FILE_SECTION_DATA(IR_FILE_SECTION_POOL);
+    fn->pool_size = (size_t)sections[IR_FILE_SECTION_POOL].count;
+#undef IR_FILE_SECTION_DATA
+
+    if (!ir_file_check_tables(fn)) {
+        fprintf(stderr, "Hata: '%s' IR dosyasında geçersiz tablo indeksleri.\n", path);
+        ir_function_free(fn);
+        return NULL;
+    }
+    if (!ir_verify(fn)) {
+        ir_function_free(fn);
+        return NULL;
+    }
+    return fn;
+}
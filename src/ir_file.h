@@ -0,0 +1,84 @@
+#ifndef IR_FILE_H
+#define IR_FILE_H
+
+#include "ir_generator.h" // IrFunction ve IR tabloları
+#include <stdint.h> // uint32_t, uint64_t için
+
+// --- İkili IR Dosyası (.bsmir) ---
+// Optimize edilmiş IR, bellekteki tablolarla birebir aynı düzende diske yazılır: sabit bir
+// başlık, bir bölüm tablosu ve ardından 8 bayta hizalı düz diziler. Tablolar işaretçi
+// içermez (bağlantılar indeks ve konumlardır); bu yüzden dosya konumdan bağımsızdır ve
+// yükleme tek bir mmap ile yapılır: IrFunction dizileri doğrudan eşlenmiş belleği gösterir,
+// işaretçi düzeltmesi veya kayıt başına tahsis gerekmez. Eşleme MAP_PRIVATE'tır; aynı dosyayı
+// yükleyen süreçler sayfaları salt okunur paylaşır, sadece değiştirilen sayfalar kopyalanır
+// (ödünç alınan bir diziyi büyüten geçişler onu kendi belleğine taşır, bkz. IrFunction).
+//
+// Dosya yazıldığı makinenin bayt sırasını ve yapı düzenini kullanır; başlıktaki bayt sırası
+// işareti ve bölüm eleman boyutları uyuşmazsa dosya reddedilir (yeniden üretilmelidir).
+#define IR_FILE_MAGIC "BSMIR\0\0"   // 8 bayt (sonlandırıcı NUL dahil)
+#define IR_FILE_VERSION 1
+#define IR_FILE_BYTE_ORDER_MARK 0x01020304u
+#define IR_FILE_ALIGNMENT 8
+
+// --- Bölümler (dosyadaki sırayla) ---
+typedef enum {
+    IR_FILE_SECTION_INSTRS,         // IrInstr[num_instrs]
+    IR_FILE_SECTION_LOCATIONS,      // IrSourceLocation[num_instrs]
+    IR_FILE_SECTION_BLOCKS,         // IrBlock[num_blocks]
+    IR_FILE_SECTION_LAYOUT,         // uint32_t[num_layout]
+    IR_FILE_SECTION_LABELS,         // IrLabel[num_labels]
+    IR_FILE_SECTION_STRINGS,        // char[strings_size]
+    IR_FILE_SECTION_VREGS,          // IrVreg[num_vregs]
+    IR_FILE_SECTION_CONSTANTS,      // int64_t[num_constants]
+    IR_FILE_SECTION_JUMP_TABLES,    // IrJumpTable[num_jump_tables]
+    IR_FILE_SECTION_SYSCALLS,       // IrSyscall[num_syscalls]
+    IR_FILE_SECTION_POOL,           // uint32_t[pool_size]
+    IR_FILE_NUM_SECTIONS
+} IrFileSectionKind;
+
+// --- Bölüm Tablosu Girdisi ---
+typedef struct {
+    uint64_t offset;        // Dosya başından itibaren konum (IR_FILE_ALIGNMENT'a hizalı)
+    uint64_t count;         // Eleman sayısı
+    uint32_t element_size;  // Eleman boyutu (yapı düzeni denetimi için)
+    uint32_t reserved;      // 0
+} IrFileSection;
+
+// --- Dosya Başlığı ---
+typedef struct {
+    char magic[8];                  // IR_FILE_MAGIC
+    uint32_t version;               // IR_FILE_VERSION
+    uint32_t header_size;           // sizeof(IrFileHeader)
+    uint64_t file_size;             // Toplam dosya boyutu
+    uint32_t byte_order;            // IR_FILE_BYTE_ORDER_MARK (yazan makinenin bayt sırasıyla)
+    uint32_t arith_sets_flags;      // IR'ın indirgendiği bayrak modeli
+    uint64_t checksum;              // Başlıktan sonraki tüm baytların FNV-1a özeti
+    IrFileSection sections[IR_FILE_NUM_SECTIONS];
+} IrFileHeader;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief IR'ı ikili dosyaya yazar. Başlık ve tüm bölümler tek bir writev çağrısıyla yazılır.
+ * @param path Dosya yolu.
+ * @param fn Yazılacak IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int ir_file_write(const char* path, const IrFunction* fn);
+
+/**
+ * @brief İkili IR dosyasını belleğe eşleyerek yükler. Başlık, bölüm sınırları, tablolar
+ * arası indeksler ve özet denetlenir, ardından ir_verify çalıştırılır.
+ * @param path Dosya yolu.
+ * @return Eşlenmiş dosyayı gösteren IrFunction (ir_function_free ile bırakılır) veya NULL hata durumunda.
+ */
+IrFunction* ir_file_load(const char* path);
+
+/**
+ * @brief Bir dosya yolunun ikili IR dosyası olup olmadığını uzantısından belirler.
+ * @param path Dosya yolu.
+ * @return ".bsmir" ile bitiyorsa 1, aksi takdirde 0.
+ */
+int ir_file_has_extension(const char* path);
+
+#endif // IR_FILE_H
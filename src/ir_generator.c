@@ -1 +1,1334 @@
-
+#include "ir_generator.h"
+#include "cfg.h"    // Blok sınırları, canlılık ve profil ağırlıkları (indirgeme için)
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <string.h> // memset, strdup
+
+// --- Ara Gösterim (IR) Gerçeklemeleri ---
+
+#define IR_LABEL_PREFIX "__bsm_ir"     // Geri dönüşümde hedef olan etiketsiz bloklar için
+#define IR_END_LABEL_PREFIX "__bsm_ir_end" // Ortadaki END blokları için program sonu etiketi
+
+/**
+ * @brief Dinamik bir diziyi en az 'needed' elemana büyütür (kapasite ikiye katlanır).
+ * Kapasitesi 0 olan dolu bir dizi ödünç alınmıştır (örn: eşlenmiş bir IR dosyası); ilk
+ * büyütmede mevcut 'count' eleman yeni bir diziye kopyalanır, ödünç alınan bellek değişmez.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int ir_grow(void** data, size_t* capacity, size_t count, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown;
+    if (*capacity == 0 && *data != NULL) {
+        grown = malloc(new_capacity * element_size);
+        if (grown && count > 0) memcpy(grown, *data, count * element_size);
+    } else {
+        grown = realloc(*data, new_capacity * element_size);
+    }
+    if (!grown) {
+        fprintf(stderr, "Hata: IR için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+IrFunction* ir_function_create(void) {
+    IrFunction* fn = (IrFunction*)calloc(1, sizeof(IrFunction));
+    if (!fn) {
+        fprintf(stderr, "Hata: IR fonksiyonu için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    fn->current_block = IR_NO_BLOCK;
+    // Mimari kaydediciler ve bayrak değeri her zaman tanımlıdır
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (ir_new_vreg(fn, IR_CLASS_INT, r) == IR_NO_VREG) {
+            ir_function_free(fn);
+            return NULL;
+        }
+    }
+    if (ir_new_vreg(fn, IR_CLASS_FLAGS, IR_VREG_FLAGS) == IR_NO_VREG) {
+        ir_function_free(fn);
+        return NULL;
+    }
+    return fn;
+}
+
+void ir_function_free(IrFunction* fn) {
+    if (!fn) return;
+    // Kapasitesi 0 olan diziler ödünç alınmıştır (eşlenmiş dosya); sadece sahip olunanlar serbest bırakılır
+    if (fn->instr_capacity) free(fn->instrs);
+    if (fn->location_capacity) free(fn->locations);
+    if (fn->block_capacity) free(fn->blocks);
+    if (fn->layout_capacity) free(fn->layout);
+    if (fn->label_capacity) free(fn->labels);
+    if (fn->string_capacity) free(fn->strings);
+    if (fn->vreg_capacity) free(fn->vregs);
+    if (fn->constant_capacity) free(fn->constants);
+    if (fn->jump_table_capacity) free(fn->jump_tables);
+    if (fn->syscall_capacity) free(fn->syscalls);
+    if (fn->pool_capacity) free(fn->pool);
+    if (fn->release_mapping) fn->release_mapping(fn->mapping, fn->mapping_size);
+    free(fn);
+}
+
+uint32_t ir_new_block(IrFunction* fn) {
+    if (!ir_grow((void**)&fn->blocks, &fn->block_capacity, fn->num_blocks, fn->num_blocks + 1, sizeof(IrBlock))) {
+        return IR_NO_BLOCK;
+    }
+    IrBlock* block = &fn->blocks[fn->num_blocks];
+    memset(block, 0, sizeof(IrBlock));
+    block->first_label = (uint32_t)fn->num_labels;
+    return (uint32_t)fn->num_blocks++;
+}
+
+int ir_add_block_label(IrFunction* fn, uint32_t block, const char* name, int unroll_pragma, int line, int column) {
+    if (block >= fn->num_blocks || fn->blocks[block].placed) return 0;
+    IrBlock* bb = &fn->blocks[block];
+    // Bir bloğun etiketleri labels dizisinde ardışık olmalıdır
+    if (bb->num_labels == 0) {
+        bb->first_label = (uint32_t)fn->num_labels;
+    } else if (bb->first_label + bb->num_labels != fn->num_labels) {
+        fprintf(stderr, "Hata: IR bloğu bb%u etiketleri ardışık eklenmedi.\n", block);
+        return 0;
+    }
+    size_t length = strlen(name) + 1;
+    if (!ir_grow((void**)&fn->labels, &fn->label_capacity, fn->num_labels, fn->num_labels + 1, sizeof(IrLabel)) ||
+        !ir_grow((void**)&fn->strings, &fn->string_capacity, fn->strings_size, fn->strings_size + length, 1)) {
+        return 0;
+    }
+    IrLabel* label = &fn->labels[fn->num_labels++];
+    label->name = (uint32_t)fn->strings_size;
+    label->unroll_pragma = unroll_pragma;
+    label->line = line;
+    label->column = column;
+    memcpy(fn->strings + fn->strings_size, name, length);
+    fn->strings_size += length;
+    bb->num_labels++;
+    return 1;
+}
+
+int ir_is_terminator(IrOpcode opcode) {
+    return opcode >= IR_OP_JMP && opcode <= IR_OP_END;
+}
+
+int ir_start_block(IrFunction* fn, uint32_t block) {
+    if (block >= fn->num_blocks || fn->blocks[block].placed) {
+        fprintf(stderr, "Hata: IR bloğu bb%u başlatılamadı (geçersiz veya zaten yerleştirilmiş).\n", block);
+        return 0;
+    }
+    if (fn->current_block != IR_NO_BLOCK) {
+        const IrInstr* last = ir_block_terminator(fn, fn->current_block);
+        if (!last || !ir_is_terminator((IrOpcode)last->opcode)) {
+            fprintf(stderr, "Hata: IR bloğu bb%u sonlandırıcı olmadan bitti.\n", fn->current_block);
+            return 0;
+        }
+    }
+    if (!ir_grow((void**)&fn->layout, &fn->layout_capacity, fn->num_layout, fn->num_layout + 1, sizeof(uint32_t))) return 0;
+    fn->layout[fn->num_layout++] = block;
+    fn->blocks[block].placed = 1;
+    fn->blocks[block].first = (uint32_t)fn->num_instrs;
+    fn->blocks[block].num_instrs = 0;
+    fn->current_block = block;
+    return 1;
+}
+
+uint16_t ir_new_vreg(IrFunction* fn, IrVregClass vreg_class, int origin) {
+    if (fn->num_vregs >= IR_MAX_VREGS) {
+        fprintf(stderr, "Hata: IR sanal kaydedici sınırı (%d) aşıldı.\n", IR_MAX_VREGS);
+        return IR_NO_VREG;
+    }
+    if (!ir_grow((void**)&fn->vregs, &fn->vreg_capacity, fn->num_vregs, fn->num_vregs + 1, sizeof(IrVreg))) return IR_NO_VREG;
+    fn->vregs[fn->num_vregs].vreg_class = (uint8_t)vreg_class;
+    fn->vregs[fn->num_vregs].origin = (int8_t)origin;
+    return (uint16_t)fn->num_vregs++;
+}
+
+IrInstr* ir_emit(IrFunction* fn, IrOpcode opcode, int line, int column) {
+    if (fn->current_block == IR_NO_BLOCK) {
+        fprintf(stderr, "Hata: IR komutu için başlatılmış blok yok.\n");
+        return NULL;
+    }
+    if (!ir_grow((void**)&fn->instrs, &fn->instr_capacity, fn->num_instrs, fn->num_instrs + 1, sizeof(IrInstr)) ||
+        !ir_grow((void**)&fn->locations, &fn->location_capacity, fn->num_instrs, fn->num_instrs + 1,
+                 sizeof(IrSourceLocation))) {
+        return NULL;
+    }
+    IrInstr* instr = &fn->instrs[fn->num_instrs];
+    memset(instr, 0, sizeof(IrInstr));
+    instr->opcode = (uint8_t)opcode;
+    instr->cond = IR_COND_NONE;
+    instr->dst = IR_NO_VREG;
+    instr->flags = IR_NO_VREG;
+    instr->u.op.src1 = IR_NO_VREG;
+    instr->u.op.src2 = IR_NO_VREG;
+    fn->locations[fn->num_instrs].line = line;
+    fn->locations[fn->num_instrs].column = column;
+    fn->num_instrs++;
+    fn->blocks[fn->current_block].num_instrs++;
+    return instr;
+}
+
+int ir_set_immediate(IrFunction* fn, IrInstr* instr, int64_t value) {
+    instr->attrs |= IR_ATTR_IMM;
+    instr->u.op.src2 = IR_NO_VREG;
+    if (value >= INT32_MIN && value <= INT32_MAX) {
+        instr->attrs &= (uint8_t)~IR_ATTR_WIDE;
+        instr->u.op.imm = (int32_t)value;
+        return 1;
+    }
+    if (!ir_grow((void**)&fn->constants, &fn->constant_capacity, fn->num_constants, fn->num_constants + 1, sizeof(int64_t))) return 0;
+    fn->constants[fn->num_constants] = value;
+    instr->attrs |= IR_ATTR_WIDE;
+    instr->u.op.imm = (int32_t)fn->num_constants++;
+    return 1;
+}
+
+const char* ir_label_name(const IrFunction* fn, const IrLabel* label) {
+    return fn->strings + label->name;
+}
+
+int64_t ir_instr_immediate(const IrFunction* fn, const IrInstr* instr) {
+    if (instr->attrs & IR_ATTR_WIDE) return fn->constants[instr->u.op.imm];
+    return instr->u.op.imm;
+}
+
+/**
+ * @brief Ortak havuza değerler ekler.
+ * @return İlk değerin havuz indeksi veya bellek hatasında -1.
+ */
+static long ir_pool_append(IrFunction* fn, const uint32_t* values, size_t count) {
+    if (!ir_grow((void**)&fn->pool, &fn->pool_capacity, fn->pool_size, fn->pool_size + count, sizeof(uint32_t))) return -1;
+    long first = (long)fn->pool_size;
+    for (size_t i = 0; i < count; i++) fn->pool[fn->pool_size++] = values[i];
+    return first;
+}
+
+int ir_add_jump_table(IrFunction* fn, int64_t min, uint32_t default_block, const uint32_t* targets,
+                      size_t num_targets) {
+    if (!ir_grow((void**)&fn->jump_tables, &fn->jump_table_capacity, fn->num_jump_tables, fn->num_jump_tables + 1,
+                 sizeof(IrJumpTable))) {
+        return -1;
+    }
+    long first = ir_pool_append(fn, targets, num_targets);
+    if (first < 0) return -1;
+    IrJumpTable* table = &fn->jump_tables[fn->num_jump_tables];
+    table->min = min;
+    table->default_block = default_block;
+    table->first_target = (uint32_t)first;
+    table->num_targets = (uint32_t)num_targets;
+    table->reserved = 0;
+    return (int)fn->num_jump_tables++;
+}
+
+int ir_add_syscall(IrFunction* fn, int64_t number, const uint32_t* args, size_t num_args) {
+    if (!ir_grow((void**)&fn->syscalls, &fn->syscall_capacity, fn->num_syscalls, fn->num_syscalls + 1, sizeof(IrSyscall))) {
+        return -1;
+    }
+    long first = ir_pool_append(fn, args, num_args);
+    if (first < 0) return -1;
+    IrSyscall* syscall = &fn->syscalls[fn->num_syscalls];
+    syscall->number = number;
+    syscall->first_arg = (uint32_t)first;
+    syscall->num_args = (uint32_t)num_args;
+    return (int)fn->num_syscalls++;
+}
+
+const IrInstr* ir_block_terminator(const IrFunction* fn, uint32_t block) {
+    if (block >= fn->num_blocks || fn->blocks[block].num_instrs == 0) return NULL;
+    return &fn->instrs[fn->blocks[block].first + fn->blocks[block].num_instrs - 1];
+}
+
+size_t ir_instr_uses(const IrInstr* instr, uint16_t* uses) {
+    size_t n = 0;
+    int reads_b = 0;
+    switch ((IrOpcode)instr->opcode) {
+        case IR_OP_MOV:
+            reads_b = 1;
+            break;
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_CMP:
+            uses[n++] = instr->u.op.src1;
+            reads_b = 1;
+            break;
+        case IR_OP_SEL:
+            uses[n++] = instr->u.op.src1;
+            uses[n++] = instr->flags;
+            reads_b = 1;
+            break;
+        case IR_OP_BR:
+            uses[n++] = instr->flags;
+            break;
+        case IR_OP_JTAB:
+            uses[n++] = instr->u.op.src1;
+            break;
+        default:
+            break;
+    }
+    if (reads_b && !(instr->attrs & IR_ATTR_IMM)) uses[n++] = instr->u.op.src2;
+    return n;
+}
+
+size_t ir_instr_defs(const IrInstr* instr, uint16_t* defs) {
+    size_t n = 0;
+    if (instr->dst != IR_NO_VREG) defs[n++] = instr->dst;
+    if (instr->flags != IR_NO_VREG && instr->opcode != IR_OP_SEL && instr->opcode != IR_OP_BR) {
+        defs[n++] = instr->flags;
+    }
+    return n;
+}
+
+// --- AST -> IR İndirgemesi ---
+
+static const struct {
+    TokenType token;
+    IrOpcode opcode;
+    IrCondition cond;
+} ir_token_map[] = {
+    {TOKEN_MOV, IR_OP_MOV, IR_COND_NONE},     {TOKEN_ADD, IR_OP_ADD, IR_COND_NONE},
+    {TOKEN_SUB, IR_OP_SUB, IR_COND_NONE},     {TOKEN_MUL, IR_OP_MUL, IR_COND_NONE},
+    {TOKEN_DIV, IR_OP_DIV, IR_COND_NONE},     {TOKEN_CMP, IR_OP_CMP, IR_COND_NONE},
+    {TOKEN_SELEQ, IR_OP_SEL, IR_COND_EQ},     {TOKEN_SELNE, IR_OP_SEL, IR_COND_NE},
+    {TOKEN_SELLT, IR_OP_SEL, IR_COND_LT},     {TOKEN_SELGT, IR_OP_SEL, IR_COND_GT},
+    {TOKEN_SELLE, IR_OP_SEL, IR_COND_LE},     {TOKEN_SELGE, IR_OP_SEL, IR_COND_GE},
+    {TOKEN_JEQ, IR_OP_BR, IR_COND_EQ},        {TOKEN_JNE, IR_OP_BR, IR_COND_NE},
+    {TOKEN_JLT, IR_OP_BR, IR_COND_LT},        {TOKEN_JGT, IR_OP_BR, IR_COND_GT},
+    {TOKEN_JMP, IR_OP_JMP, IR_COND_NONE},     {TOKEN_CALL, IR_OP_CALL, IR_COND_NONE},
+    {TOKEN_SYSCALL, IR_OP_SYSCALL, IR_COND_NONE}, {TOKEN_RET, IR_OP_RET, IR_COND_NONE},
+    {TOKEN_JTAB, IR_OP_JTAB, IR_COND_NONE},   {TOKEN_PROFCNT, IR_OP_PROFCNT, IR_COND_NONE},
+    {TOKEN_PROFDUMP, IR_OP_PROFDUMP, IR_COND_NONE},
+};
+
+#define IR_TOKEN_MAP_SIZE (sizeof(ir_token_map) / sizeof(ir_token_map[0]))
+
+/**
+ * @brief Bir AST komut türünün IR karşılığını bulur.
+ * @return Tablodaki indeks veya desteklenmiyorsa -1.
+ */
+static int ir_find_token(TokenType token) {
+    for (size_t i = 0; i < IR_TOKEN_MAP_SIZE; i++) {
+        if (ir_token_map[i].token == token) return (int)i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Komutun tek kaydedici hedefini döndürür (MOV, aritmetik ve SELcc'nin ilk operandı).
+ * @return Kaydedici indeksi veya hedef yoksa -1.
+ */
+static int ir_ast_destination(const AstInstruction* instr) {
+    int index = ir_find_token(instr->opcode);
+    if (index < 0 || instr->num_operands != 2 || instr->operands[0].type != OP_REGISTER) return -1;
+    IrOpcode opcode = ir_token_map[index].opcode;
+    if (opcode == IR_OP_CMP || opcode == IR_OP_BR || opcode == IR_OP_JMP) return -1;
+    return instr->operands[0].value.reg_index;
+}
+
+static int ir_defines_flags(FlagsEffect effect) {
+    return effect == FLAGS_DEF_COMPARE || effect == FLAGS_DEF_RESULT || effect == FLAGS_CLOBBER;
+}
+
+static int ir_valid_register(const AstOperand* operand) {
+    return operand->type == OP_REGISTER && operand->value.reg_index >= 0 &&
+           operand->value.reg_index < IR_NUM_REGISTERS;
+}
+
+static int ir_is_integer(const AstOperand* operand) {
+    return operand->type == OP_INTEGER || operand->type == OP_HEX_INTEGER;
+}
+
+// İndirgeme sırasında bir bloğun durumu
+typedef struct {
+    IrFunction* fn;
+    const Cfg* cfg;
+    uint16_t current[IR_NUM_REGISTERS + 1]; // Her mimari kaydedicinin (ve bayrakların) güncel değeri
+    uint32_t exit_block;                    // Programın sonundan düşme bloğu (gerekirse oluşturulur)
+} IrLowering;
+
+/**
+ * @brief Bir tanımın hedef sanal kaydedicisini seçer: değer blok sonunda veya örtük bir
+ * okumada gerekiyorsa mimari kaydedici, aksi halde yeni bir blok yerel kaydedici.
+ */
+static uint16_t ir_lower_def(IrLowering* lowering, int reg, int to_architectural) {
+    uint16_t vreg;
+    if (to_architectural) {
+        vreg = (uint16_t)reg;
+    } else {
+        vreg = ir_new_vreg(lowering->fn, reg == IR_VREG_FLAGS ? IR_CLASS_FLAGS : IR_CLASS_INT, reg);
+    }
+    if (vreg != IR_NO_VREG) lowering->current[reg] = vreg;
+    return vreg;
+}
+
+/**
+ * @brief Komutun ikinci kaynağını (kaydedici veya sabit) ayarlar.
+ */
+static int ir_lower_source(IrLowering* lowering, IrInstr* instr, const AstOperand* operand) {
+    if (ir_valid_register(operand)) {
+        instr->u.op.src2 = lowering->current[operand->value.reg_index];
+        return 1;
+    }
+    if (ir_is_integer(operand)) return ir_set_immediate(lowering->fn, instr, operand->value.int_value);
+    return 0;
+}
+
+/**
+ * @brief Etiket operandının bloğunu bulur.
+ */
+static uint32_t ir_lower_target(IrLowering* lowering, const AstOperand* operand) {
+    if (operand->type != OP_LABEL_REF) return IR_NO_BLOCK;
+    int block = cfg_block_of_label(lowering->cfg, operand->value.label_name);
+    if (block < 0) {
+        fprintf(stderr, "Hata: IR indirgemesi: '%s' etiketi bulunamadı.\n", operand->value.label_name);
+        return IR_NO_BLOCK;
+    }
+    return (uint32_t)block;
+}
+
+/**
+ * @brief Bloğun düşme hedefini döndürür (son blok için END bloğu oluşturulur).
+ */
+static uint32_t ir_lower_fallthrough(IrLowering* lowering, size_t block) {
+    if (block + 1 < lowering->cfg->num_blocks) return (uint32_t)(block + 1);
+    if (lowering->exit_block == IR_NO_BLOCK) lowering->exit_block = ir_new_block(lowering->fn);
+    return lowering->exit_block;
+}
+
+/**
+ * @brief Bir AST komutunu IR'ye indirger.
+ * @param arch_dst Kaydedici hedefi mimari kaydediciye yazılmalıysa 1.
+ * @param arch_flags Bayrak tanımı mimari bayrak değerine yazılmalıysa 1.
+ * @return Başarılıysa 1, hata durumunda 0.
+ */
+static int ir_lower_instruction(IrLowering* lowering, size_t block, const AstNode* node, int arch_dst,
+                                int arch_flags) {
+    IrFunction* fn = lowering->fn;
+    const AstInstruction* instr = &node->data.instruction;
+    int index = ir_find_token(instr->opcode);
+    if (index < 0) {
+        fprintf(stderr, "Hata: IR indirgemesi: '%s' komutu desteklenmiyor (%d:%d).\n",
+                token_type_to_string(instr->opcode), node->line, node->column);
+        return 0;
+    }
+    IrOpcode opcode = ir_token_map[index].opcode;
+    FlagsEffect effect = cfg_instruction_flags_effect(instr);
+    int ok = 1;
+
+    IrInstr* ir = ir_emit(fn, opcode, node->line, node->column);
+    if (!ir) return 0;
+    ir->cond = (uint8_t)ir_token_map[index].cond;
+
+    // Kaynaklar tanımlardan önce okunur (ADD R1, R1 gibi)
+    switch (opcode) {
+        case IR_OP_MOV:
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_CMP:
+        case IR_OP_SEL:
+            ok = instr->num_operands == 2 && ir_valid_register(&instr->operands[0]) &&
+                 ir_lower_source(lowering, ir, &instr->operands[1]);
+            if (ok && opcode != IR_OP_MOV) ir->u.op.src1 = lowering->current[instr->operands[0].value.reg_index];
+            if (ok && opcode == IR_OP_SEL) ir->flags = lowering->current[IR_VREG_FLAGS];
+            break;
+        case IR_OP_BR:
+        case IR_OP_JMP:
+        case IR_OP_CALL: {
+            uint32_t target = instr->num_operands == 1 ? ir_lower_target(lowering, &instr->operands[0]) : IR_NO_BLOCK;
+            ok = target != IR_NO_BLOCK;
+            ir->u.br.taken = target;
+            if (opcode == IR_OP_BR) {
+                ir->flags = lowering->current[IR_VREG_FLAGS];
+                ir->u.br.fallthrough = ir_lower_fallthrough(lowering, block);
+                ok = ok && ir->u.br.fallthrough != IR_NO_BLOCK;
+            }
+            break;
+        }
+        case IR_OP_SYSCALL: {
+            uint32_t args[16];
+            size_t num_args = 0;
+            ok = instr->num_operands >= 1 && ir_is_integer(&instr->operands[0]) &&
+                 instr->num_operands - 1 <= sizeof(args) / sizeof(args[0]);
+            for (size_t o = 1; ok && o < instr->num_operands; o++) {
+                ok = ir_valid_register(&instr->operands[o]);
+                if (ok) args[num_args++] = (uint32_t)instr->operands[o].value.reg_index;
+            }
+            int record = ok ? ir_add_syscall(fn, instr->operands[0].value.int_value, args, num_args) : -1;
+            ok = record >= 0;
+            ir->u.op.imm = record;
+            break;
+        }
+        case IR_OP_JTAB: {
+            ok = instr->num_operands >= 3 && ir_valid_register(&instr->operands[0]) &&
+                 ir_is_integer(&instr->operands[1]);
+            if (!ok) break;
+            ir->u.op.src1 = lowering->current[instr->operands[0].value.reg_index];
+            uint32_t default_block = ir_lower_target(lowering, &instr->operands[2]);
+            size_t num_targets = instr->num_operands - 3;
+            uint32_t* targets = (uint32_t*)malloc(sizeof(uint32_t) * (num_targets ? num_targets : 1));
+            ok = default_block != IR_NO_BLOCK && targets != NULL;
+            for (size_t t = 0; ok && t < num_targets; t++) {
+                targets[t] = ir_lower_target(lowering, &instr->operands[3 + t]);
+                ok = targets[t] != IR_NO_BLOCK;
+            }
+            int table = ok ? ir_add_jump_table(fn, instr->operands[1].value.int_value, default_block, targets,
+                                               num_targets)
+                           : -1;
+            free(targets);
+            ok = table >= 0;
+            ir->u.op.imm = table;
+            break;
+        }
+        case IR_OP_PROFCNT:
+            ok = instr->num_operands == 1 && ir_is_integer(&instr->operands[0]) &&
+                 ir_set_immediate(fn, ir, instr->operands[0].value.int_value);
+            break;
+        default: // PROFDUMP, RET
+            break;
+    }
+    if (!ok) {
+        fprintf(stderr, "Hata: IR indirgemesi: '%s' komutunun operandları desteklenmiyor (%d:%d).\n",
+                token_type_to_string(instr->opcode), node->line, node->column);
+        return 0;
+    }
+
+    // Tanımlar: kaydedici hedefi, ardından bayrak değeri
+    int dst = ir_ast_destination(instr);
+    if (dst >= 0) {
+        uint16_t vreg = ir_lower_def(lowering, dst, arch_dst);
+        if (vreg == IR_NO_VREG) return 0;
+        fn->instrs[fn->num_instrs - 1].dst = vreg;
+    }
+    if (ir_defines_flags(effect)) {
+        uint16_t vreg = ir_lower_def(lowering, IR_VREG_FLAGS, arch_flags);
+        if (vreg == IR_NO_VREG) return 0;
+        fn->instrs[fn->num_instrs - 1].flags = vreg;
+        if (effect == FLAGS_CLOBBER) fn->instrs[fn->num_instrs - 1].attrs |= IR_ATTR_FLAGS_CLOBBER;
+    }
+    // Çağrılar tüm kaydedicileri yazabilir: sonraki okumalar mimari kaydedicilerden yapılır
+    if (opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL) {
+        for (int r = 0; r < IR_NUM_REGISTERS; r++) lowering->current[r] = (uint16_t)r;
+    }
+    return 1;
+}
+
+/**
+ * @brief Bir CFG bloğunu IR'ye indirger.
+ * Önce geriye doğru bir taramayla hangi tanımların mimari kaydediciye yazılması gerektiği
+ * belirlenir (blok sonunda canlı olanlar ve CALL/SYSCALL/RET'in örtük okumaları).
+ * @param scratch En az bloktaki ifade sayısı kadar elemanlı çalışma dizisi.
+ */
+static int ir_lower_block(IrLowering* lowering, size_t block, uint32_t live_out, unsigned char* scratch) {
+    const BasicBlock* bb = &lowering->cfg->blocks[block];
+    AstNode** statements = lowering->cfg->program->data.program.statements;
+    enum { ARCH_DST = 1, ARCH_FLAGS = 2 };
+
+    uint32_t need = live_out;
+    for (size_t i = bb->end; i > bb->first; i--) {
+        const AstNode* node = statements[i - 1];
+        scratch[i - 1 - bb->first] = 0;
+        if (node->type != AST_INSTRUCTION) continue;
+        const AstInstruction* instr = &node->data.instruction;
+        if (ir_defines_flags(cfg_instruction_flags_effect(instr))) {
+            if (need & CFG_FLAGS_BIT) scratch[i - 1 - bb->first] |= ARCH_FLAGS;
+            need &= ~CFG_FLAGS_BIT;
+        }
+        int dst = ir_ast_destination(instr);
+        if (dst >= 0 && dst < IR_NUM_REGISTERS) {
+            if (need & (1u << dst)) scratch[i - 1 - bb->first] |= ARCH_DST;
+            need &= ~(1u << dst);
+        }
+        if (instr->opcode == TOKEN_CALL || instr->opcode == TOKEN_SYSCALL || instr->opcode == TOKEN_RET) {
+            need |= CFG_ALL_REGISTERS;
+        }
+    }
+
+    for (int r = 0; r <= IR_NUM_REGISTERS; r++) lowering->current[r] = (uint16_t)r;
+    const AstNode* last = NULL;
+    for (size_t i = bb->first; i < bb->end; i++) {
+        const AstNode* node = statements[i];
+        if (node->type != AST_INSTRUCTION) continue;
+        unsigned char arch = scratch[i - bb->first];
+        if (!ir_lower_instruction(lowering, block, node, (arch & ARCH_DST) != 0, (arch & ARCH_FLAGS) != 0)) {
+            return 0;
+        }
+        last = node;
+    }
+
+    // Örtük düşme açık bir sonlandırıcı olur
+    if (!last || !cfg_is_block_terminator(last->data.instruction.opcode)) {
+        int line = last ? last->line : 0;
+        int column = last ? last->column : 0;
+        if (block + 1 < lowering->cfg->num_blocks) {
+            IrInstr* jmp = ir_emit(lowering->fn, IR_OP_JMP, line, column);
+            if (!jmp) return 0;
+            jmp->u.br.taken = (uint32_t)(block + 1);
+        } else if (!ir_emit(lowering->fn, IR_OP_END, line, column)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+IrFunction* ir_lower_program(AstNode* program) {
+    if (!program || program->type != AST_PROGRAM) {
+        fprintf(stderr, "Hata: IR indirgemesi için geçersiz program düğümü.\n");
+        return NULL;
+    }
+    Cfg* cfg = cfg_build(program);
+    if (!cfg) return NULL;
+
+    IrFunction* fn = ir_function_create();
+    size_t nb = cfg->num_blocks;
+    size_t n = program->data.program.num_statements;
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    unsigned char* scratch = (unsigned char*)malloc(n ? n : 1);
+    int ok = fn && live_in && live_out && scratch;
+    if (!ok) {
+        fprintf(stderr, "Hata: IR indirgemesi için bellek tahsis edilemedi.\n");
+    }
+
+    if (ok) {
+        fn->arith_sets_flags = 1; // Kaynak anlamı: ADD/SUB bayrakları (sonuç, 0) olarak kurar
+        cfg_compute_liveness(cfg, live_in, live_out);
+        int has_profile = cfg_compute_profile_weights(cfg);
+
+        // Blok kimlikleri CFG blok indeksleriyle aynıdır
+        for (size_t b = 0; b < nb && ok; b++) ok = ir_new_block(fn) == b;
+        if (ok && nb == 0) {
+            // Boş program: tek bir END bloğu
+            ok = ir_new_block(fn) == 0 && ir_start_block(fn, 0) && ir_emit(fn, IR_OP_END, 0, 0) != NULL;
+        }
+
+        IrLowering lowering;
+        lowering.fn = fn;
+        lowering.cfg = cfg;
+        lowering.exit_block = IR_NO_BLOCK;
+
+        for (size_t b = 0; b < nb && ok; b++) {
+            const BasicBlock* bb = &cfg->blocks[b];
+            for (size_t i = bb->first; i < bb->end && ok; i++) {
+                const AstNode* node = program->data.program.statements[i];
+                if (node->type != AST_LABEL_DECLARATION) continue;
+                ok = ir_add_block_label(fn, (uint32_t)b, node->data.label_decl.name,
+                                        node->data.label_decl.unroll_pragma, node->line, node->column);
+            }
+            ok = ok && ir_start_block(fn, (uint32_t)b) && ir_lower_block(&lowering, b, live_out[b], scratch + bb->first);
+
+            // Profil: bloğa giriş sayısı ve sonlandırıcının sayımları (cfg_compute_profile_weights ile aynı)
+            AstNode* last = ok ? cfg_block_last_instruction(cfg, (int)b) : NULL;
+            IrBlock* block = &fn->blocks[b];
+            if (ok && has_profile && (!last || last->data.instruction.has_profile)) {
+                block->has_profile = 1;
+                block->weight = bb->weight;
+                block->exit_weight = last ? last->data.instruction.profile_count : bb->weight;
+                block->taken_weight = last ? last->data.instruction.profile_taken_count : 0;
+            }
+        }
+        if (ok && lowering.exit_block != IR_NO_BLOCK) {
+            ok = ir_start_block(fn, lowering.exit_block) && ir_emit(fn, IR_OP_END, 0, 0) != NULL;
+        }
+    }
+
+    free(live_in);
+    free(live_out);
+    free(scratch);
+    cfg_free(cfg);
+    if (!ok) {
+        ir_function_free(fn);
+        return NULL;
+    }
+    return fn;
+}
+
+// --- IR Doğrulama ---
+
+/**
+ * @brief Bir sanal kaydedicinin beklenen sınıfta olup olmadığını kontrol eder.
+ */
+static int ir_check_vreg(const IrFunction* fn, uint16_t vreg, IrVregClass vreg_class) {
+    return vreg < fn->num_vregs && fn->vregs[vreg].vreg_class == vreg_class;
+}
+
+static int ir_check_block_ref(const IrFunction* fn, uint32_t block) {
+    return block < fn->num_blocks && fn->blocks[block].placed;
+}
+
+/**
+ * @brief Bir komutun alanlarının türlerini ve hedeflerini doğrular.
+ * @return Geçerliyse 1, aksi takdirde 0.
+ */
+static int ir_verify_fields(const IrFunction* fn, const IrInstr* instr) {
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    int has_b = opcode == IR_OP_MOV || opcode == IR_OP_ADD || opcode == IR_OP_SUB || opcode == IR_OP_MUL ||
+                opcode == IR_OP_DIV || opcode == IR_OP_CMP || opcode == IR_OP_SEL;
+    if (has_b) {
+        if (instr->attrs & IR_ATTR_IMM) {
+            if ((instr->attrs & IR_ATTR_WIDE) &&
+                (instr->u.op.imm < 0 || (size_t)instr->u.op.imm >= fn->num_constants)) {
+                return 0;
+            }
+        } else if (!ir_check_vreg(fn, instr->u.op.src2, IR_CLASS_INT)) {
+            return 0;
+        }
+        if (opcode != IR_OP_MOV && !ir_check_vreg(fn, instr->u.op.src1, IR_CLASS_INT)) return 0;
+        if (opcode == IR_OP_CMP ? instr->dst != IR_NO_VREG : !ir_check_vreg(fn, instr->dst, IR_CLASS_INT)) return 0;
+    } else if (instr->dst != IR_NO_VREG) {
+        return 0;
+    }
+
+    int uses_flags = opcode == IR_OP_SEL || opcode == IR_OP_BR;
+    int defines_flags = opcode == IR_OP_ADD || opcode == IR_OP_SUB || opcode == IR_OP_MUL || opcode == IR_OP_DIV ||
+                        opcode == IR_OP_CMP || opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL ||
+                        opcode == IR_OP_PROFDUMP || opcode == IR_OP_JTAB;
+    if (uses_flags || (defines_flags && instr->flags != IR_NO_VREG)) {
+        if (!ir_check_vreg(fn, instr->flags, IR_CLASS_FLAGS)) return 0;
+    } else if (instr->flags != IR_NO_VREG) {
+        return 0;
+    }
+    if (opcode == IR_OP_CMP && instr->flags == IR_NO_VREG) return 0;
+    if ((opcode == IR_OP_SEL || opcode == IR_OP_BR) && instr->cond >= IR_COND_NONE) return 0;
+
+    switch (opcode) {
+        case IR_OP_JMP:
+        case IR_OP_CALL:
+            return ir_check_block_ref(fn, instr->u.br.taken);
+        case IR_OP_BR:
+            return ir_check_block_ref(fn, instr->u.br.taken) && ir_check_block_ref(fn, instr->u.br.fallthrough);
+        case IR_OP_SYSCALL:
+            return instr->u.op.imm >= 0 && (size_t)instr->u.op.imm < fn->num_syscalls;
+        case IR_OP_PROFCNT:
+            return (instr->attrs & IR_ATTR_IMM) != 0;
+        case IR_OP_JTAB: {
+            if (!ir_check_vreg(fn, instr->u.op.src1, IR_CLASS_INT) || instr->u.op.imm < 0 ||
+                (size_t)instr->u.op.imm >= fn->num_jump_tables) {
+                return 0;
+            }
+            const IrJumpTable* table = &fn->jump_tables[instr->u.op.imm];
+            if (!ir_check_block_ref(fn, table->default_block)) return 0;
+            for (uint32_t t = 0; t < table->num_targets; t++) {
+                if (!ir_check_block_ref(fn, fn->pool[table->first_target + t])) return 0;
+            }
+            return 1;
+        }
+        default:
+            return opcode < IR_OP_COUNT;
+    }
+}
+
+int ir_verify(const IrFunction* fn) {
+    if (!fn || fn->num_layout == 0 || fn->layout[0] != 0) {
+        fprintf(stderr, "Hata: IR doğrulaması: giriş bloğu (bb0) yerleşimin başında değil.\n");
+        return 0;
+    }
+    uint32_t* def_block = (uint32_t*)malloc(sizeof(uint32_t) * fn->num_vregs);
+    if (!def_block) {
+        fprintf(stderr, "Hata: IR doğrulaması için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    for (size_t v = 0; v < fn->num_vregs; v++) def_block[v] = IR_NO_BLOCK;
+
+    int ok = 1;
+    size_t expected_first = 0;
+    for (size_t l = 0; l < fn->num_layout && ok; l++) {
+        uint32_t b = fn->layout[l];
+        const IrBlock* block = &fn->blocks[b];
+        if (block->first != expected_first || block->num_instrs == 0) {
+            fprintf(stderr, "Hata: IR doğrulaması: bb%u boş veya komut dizisinde yerleşim sırasında değil.\n", b);
+            ok = 0;
+            break;
+        }
+        expected_first += block->num_instrs;
+
+        uint16_t current[IR_NUM_REGISTERS + 1];
+        for (int r = 0; r <= IR_NUM_REGISTERS; r++) current[r] = (uint16_t)r;
+
+        for (uint32_t k = 0; k < block->num_instrs && ok; k++) {
+            const IrInstr* instr = &fn->instrs[block->first + k];
+            IrOpcode opcode = (IrOpcode)instr->opcode;
+            if (!ir_verify_fields(fn, instr)) {
+                fprintf(stderr, "Hata: IR doğrulaması: bb%u içinde geçersiz '%s' komutu.\n", b,
+                        ir_opcode_to_string(opcode));
+                ok = 0;
+                break;
+            }
+            if (ir_is_terminator(opcode) != (k + 1 == block->num_instrs)) {
+                fprintf(stderr, "Hata: IR doğrulaması: bb%u tam olarak bir sonlandırıcıyla bitmeli.\n", b);
+                ok = 0;
+                break;
+            }
+
+            // Okumalar: blok yerel değerler önceden tanımlanmış olmalı ve kökeninin güncel değeri olmalı
+            uint16_t uses[3];
+            size_t num_uses = ir_instr_uses(instr, uses);
+            for (size_t u = 0; u < num_uses && ok; u++) {
+                uint16_t v = uses[u];
+                int origin = fn->vregs[v].origin;
+                if (v >= IR_FIRST_VIRTUAL && def_block[v] != b) {
+                    fprintf(stderr, "Hata: IR doğrulaması: bb%u içinde tanımlanmamış değer v%u okunuyor.\n", b, v);
+                    ok = 0;
+                } else if (origin >= 0 && origin <= IR_NUM_REGISTERS && current[origin] != v) {
+                    fprintf(stderr, "Hata: IR doğrulaması: bb%u içinde v%u okunurken kökeninin güncel değeri v%u.\n",
+                            b, v, current[origin]);
+                    ok = 0;
+                }
+            }
+            // Örtük okumalar: tüm değerler mimari kaydedicilerde olmalı
+            if (ok && (opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL || opcode == IR_OP_RET)) {
+                for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+                    if (current[r] != r) {
+                        fprintf(stderr, "Hata: IR doğrulaması: bb%u içinde '%s' öncesi R%d mimari kaydedicide değil.\n",
+                                b, ir_opcode_to_string(opcode), r);
+                        ok = 0;
+                        break;
+                    }
+                }
+            }
+
+            uint16_t defs[2];
+            size_t num_defs = ir_instr_defs(instr, defs);
+            for (size_t d = 0; d < num_defs && ok; d++) {
+                uint16_t v = defs[d];
+                if (v >= IR_FIRST_VIRTUAL) {
+                    if (def_block[v] != IR_NO_BLOCK) {
+                        fprintf(stderr, "Hata: IR doğrulaması: v%u birden fazla kez tanımlanıyor.\n", v);
+                        ok = 0;
+                        break;
+                    }
+                    def_block[v] = b;
+                }
+                int origin = fn->vregs[v].origin;
+                if (origin >= 0 && origin <= IR_NUM_REGISTERS) current[origin] = v;
+            }
+            if (opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL) {
+                for (int r = 0; r < IR_NUM_REGISTERS; r++) current[r] = (uint16_t)r;
+            }
+        }
+    }
+    if (ok && expected_first != fn->num_instrs) {
+        fprintf(stderr, "Hata: IR doğrulaması: yerleştirilmemiş bloklara ait komutlar var.\n");
+        ok = 0;
+    }
+    free(def_block);
+    return ok;
+}
+
+// --- IR -> AST Geri Dönüşümü ---
+
+typedef struct {
+    AstNode** items;
+    size_t count;
+    size_t capacity;
+} IrStatementList;
+
+static int ir_statement_append(IrStatementList* list, AstNode* node) {
+    if (!node) return 0;
+    if (!ir_grow((void**)&list->items, &list->capacity, list->count, list->count + 1, sizeof(AstNode*))) {
+        ast_node_free(node);
+        return 0;
+    }
+    list->items[list->count++] = node;
+    return 1;
+}
+
+/**
+ * @brief Sanal kaydedicinin kökeni olan mimari kaydediciyi döndürür.
+ * @return Kaydedici indeksi veya kökeni yoksa -1.
+ */
+static int ir_lift_register(const IrFunction* fn, uint16_t vreg) {
+    int origin = fn->vregs[vreg].origin;
+    if (origin < 0 || origin >= IR_NUM_REGISTERS) {
+        fprintf(stderr, "Hata: IR geri dönüşümü: v%u bir mimari kaydediciye eşlenemiyor.\n", vreg);
+        return -1;
+    }
+    return origin;
+}
+
+/**
+ * @brief Komutun "b" kaynağını AST operandına çevirir.
+ */
+static int ir_lift_source(const IrFunction* fn, const IrInstr* instr, AstOperand* operand) {
+    if (instr->attrs & IR_ATTR_IMM) {
+        operand->type = OP_INTEGER;
+        operand->value.int_value = ir_instr_immediate(fn, instr);
+        return 1;
+    }
+    int reg = ir_lift_register(fn, instr->u.op.src2);
+    operand->type = OP_REGISTER;
+    operand->value.reg_index = reg;
+    return reg >= 0;
+}
+
+static AstNode* ir_lift_jump(TokenType opcode, const char* label, int line, int column) {
+    AstNode* node = ast_instruction_create(opcode, 1, line, column);
+    if (node && !ast_operand_set_label(&node->data.instruction.operands[0], label)) {
+        ast_node_free(node);
+        return NULL;
+    }
+    return node;
+}
+
+static const TokenType ir_branch_tokens[] = {TOKEN_JEQ, TOKEN_JNE, TOKEN_JLT, TOKEN_JGT};
+static const TokenType ir_select_tokens[] = {TOKEN_SELEQ, TOKEN_SELNE, TOKEN_SELLT,
+                                             TOKEN_SELGT, TOKEN_SELLE, TOKEN_SELGE};
+
+/**
+ * @brief Sonlandırıcı olmayan bir IR komutunu AST komutuna çevirir.
+ * @return Yeni düğüm veya hata durumunda NULL.
+ */
+static AstNode* ir_lift_instruction(const IrFunction* fn, const IrInstr* instr, const IrSourceLocation* location,
+                                    const char* const* names) {
+    static const TokenType arithmetic_tokens[] = {TOKEN_MOV, TOKEN_ADD, TOKEN_SUB, TOKEN_MUL, TOKEN_DIV};
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    int line = location->line;
+    int column = location->column;
+    AstNode* node = NULL;
+    int ok = 1;
+
+    switch (opcode) {
+        case IR_OP_MOV:
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_SEL:
+        case IR_OP_CMP: {
+            TokenType token = opcode == IR_OP_SEL   ? ir_select_tokens[instr->cond]
+                              : opcode == IR_OP_CMP ? TOKEN_CMP
+                                                    : arithmetic_tokens[opcode - IR_OP_MOV];
+            node = ast_instruction_create(token, 2, line, column);
+            if (!node) return NULL;
+            AstOperand* operands = node->data.instruction.operands;
+            int first = ir_lift_register(fn, opcode == IR_OP_CMP ? instr->u.op.src1 : instr->dst);
+            operands[0].type = OP_REGISTER;
+            operands[0].value.reg_index = first;
+            ok = first >= 0 && ir_lift_source(fn, instr, &operands[1]);
+            // İki adresli biçim: hedef birinci kaynağın kaydedicisi olmalı
+            if (ok && opcode != IR_OP_MOV && opcode != IR_OP_CMP && ir_lift_register(fn, instr->u.op.src1) != first) {
+                fprintf(stderr, "Hata: IR geri dönüşümü: '%s' iki adresli biçime çevrilemiyor.\n",
+                        ir_opcode_to_string(opcode));
+                ok = 0;
+            }
+            break;
+        }
+        case IR_OP_CALL:
+            node = ir_lift_jump(TOKEN_CALL, names[instr->u.br.taken], line, column);
+            break;
+        case IR_OP_SYSCALL: {
+            const IrSyscall* syscall = &fn->syscalls[instr->u.op.imm];
+            node = ast_instruction_create(TOKEN_SYSCALL, 1 + syscall->num_args, line, column);
+            if (!node) return NULL;
+            AstOperand* operands = node->data.instruction.operands;
+            operands[0].type = OP_INTEGER;
+            operands[0].value.int_value = syscall->number;
+            for (uint32_t a = 0; a < syscall->num_args; a++) {
+                operands[1 + a].type = OP_REGISTER;
+                operands[1 + a].value.reg_index = (int)fn->pool[syscall->first_arg + a];
+            }
+            break;
+        }
+        case IR_OP_PROFCNT:
+            node = ast_instruction_create(TOKEN_PROFCNT, 1, line, column);
+            if (!node) return NULL;
+            node->data.instruction.operands[0].type = OP_INTEGER;
+            node->data.instruction.operands[0].value.int_value = ir_instr_immediate(fn, instr);
+            break;
+        case IR_OP_PROFDUMP:
+            node = ast_instruction_create(TOKEN_PROFDUMP, 0, line, column);
+            break;
+        case IR_OP_RET:
+            node = ast_instruction_create(TOKEN_RET, 0, line, column);
+            break;
+        case IR_OP_JTAB: {
+            const IrJumpTable* table = &fn->jump_tables[instr->u.op.imm];
+            node = ast_instruction_create(TOKEN_JTAB, 3 + table->num_targets, line, column);
+            if (!node) return NULL;
+            AstOperand* operands = node->data.instruction.operands;
+            int reg = ir_lift_register(fn, instr->u.op.src1);
+            operands[0].type = OP_REGISTER;
+            operands[0].value.reg_index = reg;
+            operands[1].type = OP_INTEGER;
+            operands[1].value.int_value = table->min;
+            ok = reg >= 0 && ast_operand_set_label(&operands[2], names[table->default_block]);
+            for (uint32_t t = 0; ok && t < table->num_targets; t++) {
+                ok = ast_operand_set_label(&operands[3 + t], names[fn->pool[table->first_target + t]]);
+            }
+            break;
+        }
+        default:
+            fprintf(stderr, "Hata: IR geri dönüşümü: beklenmeyen '%s' komutu.\n", ir_opcode_to_string(opcode));
+            return NULL;
+    }
+    if (node && !ok) {
+        ast_node_free(node);
+        return NULL;
+    }
+    return node;
+}
+
+/**
+ * @brief Bloğa atlama veya çağrı ile ulaşılan (etiket gerektiren) blokları işaretler.
+ * @param position Her bloğun yerleşimdeki konumu.
+ */
+static void ir_mark_referenced_blocks(const IrFunction* fn, const size_t* position, unsigned char* referenced) {
+    for (size_t l = 0; l < fn->num_layout; l++) {
+        const IrBlock* block = &fn->blocks[fn->layout[l]];
+        for (uint32_t k = 0; k < block->num_instrs; k++) {
+            const IrInstr* instr = &fn->instrs[block->first + k];
+            switch ((IrOpcode)instr->opcode) {
+                case IR_OP_CALL:
+                    referenced[instr->u.br.taken] = 1;
+                    break;
+                case IR_OP_JMP:
+                    if (position[instr->u.br.taken] != l + 1) referenced[instr->u.br.taken] = 1;
+                    break;
+                case IR_OP_BR:
+                    referenced[instr->u.br.taken] = 1;
+                    if (position[instr->u.br.fallthrough] != l + 1) referenced[instr->u.br.fallthrough] = 1;
+                    break;
+                case IR_OP_JTAB: {
+                    const IrJumpTable* table = &fn->jump_tables[instr->u.op.imm];
+                    referenced[table->default_block] = 1;
+                    for (uint32_t t = 0; t < table->num_targets; t++) {
+                        referenced[fn->pool[table->first_target + t]] = 1;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Bir bloğun komutlarını (ve gerekiyorsa atlamalarını) AST'ye çevirir.
+ */
+static int ir_lift_block(const IrFunction* fn, size_t layout_index, const char* const* names, const char* end_label,
+                         IrStatementList* out) {
+    uint32_t b = fn->layout[layout_index];
+    const IrBlock* block = &fn->blocks[b];
+    uint32_t next = layout_index + 1 < fn->num_layout ? fn->layout[layout_index + 1] : IR_NO_BLOCK;
+
+    for (uint32_t l = 0; l < block->num_labels; l++) {
+        const IrLabel* label = &fn->labels[block->first_label + l];
+        AstNode* node = ast_label_declaration_create(ir_label_name(fn, label), label->line, label->column);
+        if (!ir_statement_append(out, node)) return 0;
+        node->data.label_decl.unroll_pragma = label->unroll_pragma;
+    }
+    if (block->num_labels == 0 && names[b]) {
+        if (!ir_statement_append(out, ast_label_declaration_create(names[b], 0, 0))) return 0;
+    }
+    size_t first_instr = out->count;
+
+    for (uint32_t k = 0; k < block->num_instrs; k++) {
+        const IrInstr* instr = &fn->instrs[block->first + k];
+        const IrSourceLocation* location = &fn->locations[block->first + k];
+        switch ((IrOpcode)instr->opcode) {
+            case IR_OP_JMP:
+                if (instr->u.br.taken != next &&
+                    !ir_statement_append(out, ir_lift_jump(TOKEN_JMP, names[instr->u.br.taken], location->line,
+                                                           location->column))) {
+                    return 0;
+                }
+                break;
+            case IR_OP_BR:
+                if (instr->cond >= sizeof(ir_branch_tokens) / sizeof(ir_branch_tokens[0])) {
+                    fprintf(stderr, "Hata: IR geri dönüşümü: bb%u koşulu için dallanma komutu yok.\n", b);
+                    return 0;
+                }
+                if (!ir_statement_append(out, ir_lift_jump(ir_branch_tokens[instr->cond], names[instr->u.br.taken],
+                                                           location->line, location->column))) {
+                    return 0;
+                }
+                if (instr->u.br.fallthrough != next &&
+                    !ir_statement_append(out, ir_lift_jump(TOKEN_JMP, names[instr->u.br.fallthrough],
+                                                           location->line, location->column))) {
+                    return 0;
+                }
+                break;
+            case IR_OP_END:
+                if (next != IR_NO_BLOCK &&
+                    !ir_statement_append(out, ir_lift_jump(TOKEN_JMP, end_label, location->line, location->column))) {
+                    return 0;
+                }
+                break;
+            default:
+                if (!ir_statement_append(out, ir_lift_instruction(fn, instr, location, names))) return 0;
+                break;
+        }
+    }
+
+    // Profil: ilk komut bloğa giriş sayısını, son komut sonlandırıcının sayımlarını taşır
+    if (block->has_profile) {
+        for (size_t i = first_instr; i < out->count; i++) {
+            AstInstruction* instr = &out->items[i]->data.instruction;
+            instr->has_profile = 1;
+            instr->profile_count = i + 1 == out->count ? block->exit_weight : block->weight;
+            instr->profile_taken_count = i + 1 == out->count ? block->taken_weight : 0;
+        }
+    }
+    return 1;
+}
+
+int ir_lift_to_program(const IrFunction* fn, AstNode* program, SymbolTable* symbol_table) {
+    if (!fn || !program || program->type != AST_PROGRAM || !symbol_table) return 0;
+
+    size_t* position = (size_t*)malloc(sizeof(size_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    unsigned char* referenced = (unsigned char*)calloc(fn->num_blocks ? fn->num_blocks : 1, 1);
+    const char** names = (const char**)calloc(fn->num_blocks ? fn->num_blocks : 1, sizeof(char*));
+    char** generated = (char**)calloc(fn->num_blocks ? fn->num_blocks : 1, sizeof(char*)); // Serbest bırakılacaklar
+    IrStatementList out = {NULL, 0, 0};
+    char end_label[64] = "";
+    int ok = position && referenced && names && generated;
+    if (!ok) fprintf(stderr, "Hata: IR geri dönüşümü için bellek tahsis edilemedi.\n");
+
+    if (ok) {
+        for (size_t b = 0; b < fn->num_blocks; b++) position[b] = (size_t)-1;
+        for (size_t l = 0; l < fn->num_layout; l++) position[fn->layout[l]] = l;
+        ir_mark_referenced_blocks(fn, position, referenced);
+
+        // Blok adları: ilk etiket veya hedef olan etiketsiz bloklar için yeni bir etiket
+        char buffer[64];
+        for (size_t b = 0; b < fn->num_blocks && ok; b++) {
+            if (fn->blocks[b].num_labels > 0) {
+                names[b] = ir_label_name(fn, &fn->labels[fn->blocks[b].first_label]);
+            } else if (referenced[b]) {
+                cfg_make_unique_label(symbol_table, IR_LABEL_PREFIX, buffer, sizeof(buffer));
+                generated[b] = strdup(buffer);
+                names[b] = generated[b];
+                ok = names[b] && symbol_table_add_symbol(symbol_table, buffer, 0, 0, 0);
+            }
+        }
+        // Ortadaki END blokları programın sonuna atlar
+        int needs_end_label = 0;
+        for (size_t l = 0; l + 1 < fn->num_layout; l++) {
+            const IrInstr* last = ir_block_terminator(fn, fn->layout[l]);
+            if (last && last->opcode == IR_OP_END) needs_end_label = 1;
+        }
+        if (ok && needs_end_label) {
+            cfg_make_unique_label(symbol_table, IR_END_LABEL_PREFIX, end_label, sizeof(end_label));
+            ok = symbol_table_add_symbol(symbol_table, end_label, 0, 0, 0);
+        }
+
+        for (size_t l = 0; l < fn->num_layout && ok; l++) ok = ir_lift_block(fn, l, names, end_label, &out);
+        if (ok && needs_end_label) ok = ir_statement_append(&out, ast_label_declaration_create(end_label, 0, 0));
+    }
+
+    if (ok) {
+        for (size_t i = 0; i < program->data.program.num_statements; i++) {
+            ast_node_free(program->data.program.statements[i]);
+        }
+        free(program->data.program.statements);
+        program->data.program.statements = out.items;
+        program->data.program.num_statements = out.count;
+    } else {
+        for (size_t i = 0; i < out.count; i++) ast_node_free(out.items[i]);
+        free(out.items);
+    }
+    if (generated) {
+        for (size_t b = 0; b < fn->num_blocks; b++) free(generated[b]);
+    }
+    free(generated);
+    free(names);
+    free(referenced);
+    free(position);
+    return ok;
+}
+
+// --- IR Yazdırma ---
+
+static const char* const ir_opcode_names[IR_OP_COUNT] = {
+    "mov", "add", "sub", "mul", "div", "cmp", "sel", "call", "syscall", "profcnt", "profdump",
+    "jmp", "br", "jtab", "ret", "end",
+};
+
+static const char* const ir_condition_names[] = {"eq", "ne", "lt", "gt", "le", "ge"};
+
+const char* ir_opcode_to_string(IrOpcode opcode) {
+    if (opcode < 0 || opcode >= IR_OP_COUNT) return "?";
+    return ir_opcode_names[opcode];
+}
+
+/**
+ * @brief Sanal kaydediciyi yazdırır: mimari kaydediciler "R3"/"F", blok yerel değerler "v17"/"f18".
+ */
+static void ir_print_vreg(const IrFunction* fn, uint16_t vreg, FILE* out) {
+    if (vreg < IR_NUM_REGISTERS) {
+        fprintf(out, "R%u", vreg);
+    } else if (vreg == IR_VREG_FLAGS) {
+        fputs("F", out);
+    } else if (vreg < fn->num_vregs && fn->vregs[vreg].vreg_class == IR_CLASS_FLAGS) {
+        fprintf(out, "f%u", vreg);
+    } else {
+        fprintf(out, "v%u", vreg);
+    }
+}
+
+static void ir_print_source(const IrFunction* fn, const IrInstr* instr, FILE* out) {
+    if (instr->attrs & IR_ATTR_IMM) {
+        fprintf(out, "%lld", (long long)ir_instr_immediate(fn, instr));
+    } else {
+        ir_print_vreg(fn, instr->u.op.src2, out);
+    }
+}
+
+static void ir_print_instruction(const IrFunction* fn, const IrInstr* instr, FILE* out) {
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    fputs("    ", out);
+
+    // Sonuçlar: "v17, f18 = add R1, 5"; bozulan bayraklar "~f18" olarak gösterilir
+    uint16_t defs[2];
+    size_t num_defs = ir_instr_defs(instr, defs);
+    for (size_t d = 0; d < num_defs; d++) {
+        if (d > 0) fputs(", ", out);
+        if (defs[d] == instr->flags && (instr->attrs & IR_ATTR_FLAGS_CLOBBER)) fputc('~', out);
+        ir_print_vreg(fn, defs[d], out);
+    }
+    if (num_defs > 0) fputs(" = ", out);
+
+    fputs(ir_opcode_to_string(opcode), out);
+    if (opcode == IR_OP_SEL || opcode == IR_OP_BR) fprintf(out, ".%s", ir_condition_names[instr->cond]);
+
+    switch (opcode) {
+        case IR_OP_MOV:
+            fputc(' ', out);
+            ir_print_source(fn, instr, out);
+            break;
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_CMP:
+            fputc(' ', out);
+            ir_print_vreg(fn, instr->u.op.src1, out);
+            fputs(", ", out);
+            ir_print_source(fn, instr, out);
+            break;
+        case IR_OP_SEL:
+            fputc(' ', out);
+            ir_print_vreg(fn, instr->flags, out);
+            fputs(", ", out);
+            ir_print_vreg(fn, instr->u.op.src1, out);
+            fputs(", ", out);
+            ir_print_source(fn, instr, out);
+            break;
+        case IR_OP_BR:
+            fputc(' ', out);
+            ir_print_vreg(fn, instr->flags, out);
+            fprintf(out, ", bb%u, bb%u", instr->u.br.taken, instr->u.br.fallthrough);
+            break;
+        case IR_OP_JMP:
+        case IR_OP_CALL:
+            fprintf(out, " bb%u", instr->u.br.taken);
+            break;
+        case IR_OP_SYSCALL: {
+            const IrSyscall* syscall = &fn->syscalls[instr->u.op.imm];
+            fprintf(out, " %lld", (long long)syscall->number);
+            for (uint32_t a = 0; a < syscall->num_args; a++) fprintf(out, ", R%u", fn->pool[syscall->first_arg + a]);
+            break;
+        }
+        case IR_OP_PROFCNT:
+            fprintf(out, " %lld", (long long)ir_instr_immediate(fn, instr));
+            break;
+        case IR_OP_JTAB: {
+            const IrJumpTable* table = &fn->jump_tables[instr->u.op.imm];
+            fputc(' ', out);
+            ir_print_vreg(fn, instr->u.op.src1, out);
+            fprintf(out, ", %lld, bb%u [", (long long)table->min, table->default_block);
+            for (uint32_t t = 0; t < table->num_targets; t++) {
+                fprintf(out, "%sbb%u", t ? ", " : "", fn->pool[table->first_target + t]);
+            }
+            fputc(']', out);
+            break;
+        }
+        default:
+            break;
+    }
+    fputc('\n', out);
+}
+
+void ir_print(const IrFunction* fn, FILE* out) {
+    if (!fn || !out) return;
+    fprintf(out, "; IR: %zu blok, %zu komut, %zu sanal kaydedici\n", fn->num_layout, fn->num_instrs, fn->num_vregs);
+    for (size_t l = 0; l < fn->num_layout; l++) {
+        uint32_t b = fn->layout[l];
+        const IrBlock* block = &fn->blocks[b];
+        fprintf(out, "bb%u:", b);
+        if (block->num_labels > 0 || block->has_profile) fputs("  ;", out);
+        for (uint32_t i = 0; i < block->num_labels; i++) fprintf(out, " %s", ir_label_name(fn, &fn->labels[block->first_label + i]));
+        if (block->has_profile) fprintf(out, " (ağırlık %llu)", (unsigned long long)block->weight);
+        fputc('\n', out);
+        for (uint32_t k = 0; k < block->num_instrs; k++) ir_print_instruction(fn, &fn->instrs[block->first + k], out);
+    }
+}
+
+// --- IR Geçişleri ---
+
+int ir_eliminate_dead_values(IrFunction* fn) {
+    if (!fn || fn->num_instrs == 0) return 0;
+    uint32_t* uses = (uint32_t*)calloc(fn->num_vregs, sizeof(uint32_t));
+    unsigned char* remove = (unsigned char*)calloc(fn->num_instrs, 1);
+    if (!uses || !remove) {
+        fprintf(stderr, "Hata: IR ölü değer eliminasyonu için bellek tahsis edilemedi.\n");
+        free(uses);
+        free(remove);
+        return 0;
+    }
+
+    uint16_t operands[3];
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        size_t n = ir_instr_uses(&fn->instrs[i], operands);
+        for (size_t u = 0; u < n; u++) uses[operands[u]]++;
+    }
+
+    // Blok yerel değerler sadece kendi bloklarında okunur: geriye doğru tek tarama zincirleri de siler.
+    // DIV sıfıra bölmede tuzak (trap) oluşturabileceği için yan etkili kabul edilir.
+    int removed = 0;
+    for (size_t i = fn->num_instrs; i > 0; i--) {
+        const IrInstr* instr = &fn->instrs[i - 1];
+        IrOpcode opcode = (IrOpcode)instr->opcode;
+        if (opcode != IR_OP_MOV && opcode != IR_OP_ADD && opcode != IR_OP_SUB && opcode != IR_OP_MUL &&
+            opcode != IR_OP_SEL) {
+            continue;
+        }
+        if (instr->dst < IR_FIRST_VIRTUAL || uses[instr->dst] > 0) continue;
+        if (opcode != IR_OP_SEL && instr->flags != IR_NO_VREG &&
+            (instr->flags < IR_FIRST_VIRTUAL || uses[instr->flags] > 0)) {
+            continue;
+        }
+        remove[i - 1] = 1;
+        removed++;
+        size_t n = ir_instr_uses(instr, operands);
+        for (size_t u = 0; u < n; u++) uses[operands[u]]--;
+    }
+
+    // Komut dizisini yerleşim sırasıyla sıkıştır
+    if (removed > 0) {
+        size_t write = 0;
+        for (size_t l = 0; l < fn->num_layout; l++) {
+            IrBlock* block = &fn->blocks[fn->layout[l]];
+            uint32_t read = block->first;
+            uint32_t count = block->num_instrs;
+            block->first = (uint32_t)write;
+            block->num_instrs = 0;
+            for (uint32_t k = 0; k < count; k++) {
+                if (remove[read + k]) continue;
+                fn->instrs[write] = fn->instrs[read + k];
+                fn->locations[write] = fn->locations[read + k];
+                write++;
+                block->num_instrs++;
+            }
+        }
+        fn->num_instrs = write;
+    }
+    free(uses);
+    free(remove);
+    return removed;
+}
@@ -1 +1,364 @@
-
+#ifndef IR_GENERATOR_H
+#define IR_GENERATOR_H
+
+#include "ast.h" // AST düğüm yapılarına erişim
+#include "semantic_analyzer.h" // Geri dönüşümde yeni etiketleri sembol tablosuna eklemek için
+#include <stdio.h> // FILE* için
+#include <stdint.h> // uint16_t, uint32_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- Üç Adresli Ara Gösterim (IR) ---
+// AST'nin işaretçi ağırlıklı düğüm yapısı yerine, komutlar tek bir dizide 16 baytlık sabit
+// boyutlu kayıtlar olarak tutulur. Etiket adları yerine tamsayı blok kimlikleri, kaydediciler
+// yerine sanal kaydediciler kullanılır ve bayraklar açık bir değer olarak modellenir.
+//
+// Sanal kaydediciler:
+//  - 0..15 mimari kaydedicilerdir (R0..R15), 16 mimari bayrak değeridir. Bloklar arasında
+//    ve örtük olarak tüm kaydedicileri okuyan/yazan komutlarda (CALL, SYSCALL, RET) değerler
+//    bu kaydedicilerde taşınır.
+//  - 17 ve sonrası blok yereldir ve tek atamalıdır: aynı blokta, kullanımlarından önce bir kez
+//    tanımlanır. AST'den indirgemede bloğun sonunda canlı olmayan her tanım yeni bir sanal
+//    kaydediciye yazılır; böylece ölü değerler ve değer ömürleri doğrudan görülebilir.
+//  - Her sanal kaydedicinin bir kökeni (origin) vardır: geldiği mimari kaydedici. Köken
+//    tutarlılığı korunduğu sürece IR kayıpsız olarak AST'ye geri çevrilebilir.
+//
+// Bayraklar: bayrakları tanımlayan veya bozan her komut (CMP, ADD, MUL, CALL, ...) 'flags'
+// alanına yeni bir bayrak değeri yazar; koşullu dallanmalar ve seçimler okudukları bayrak
+// değerini 'flags' alanında açıkça belirtir.
+//
+// Bloklar: her blok tam olarak bir sonlandırıcı ile biter (JMP, BR, JTAB, RET veya END);
+// AST'deki örtük düşme (fallthrough) IR'de açık bir hedeftir.
+
+#define IR_NUM_REGISTERS 16     // Mimari kaydedici sayısı (R0..R15)
+#define IR_VREG_FLAGS 16        // Mimari bayrak değeri
+#define IR_FIRST_VIRTUAL 17     // İlk blok yerel sanal kaydedici
+#define IR_MAX_VREGS 0xFFFF     // uint16_t alanlara sığan en fazla sanal kaydedici
+#define IR_NO_VREG 0xFFFFu      // Kullanılmayan kaydedici alanı
+#define IR_NO_BLOCK 0xFFFFFFFFu // Geçersiz blok kimliği
+
+// --- IR Komut Türleri ---
+typedef enum {
+    IR_OP_MOV,          // dst = b
+    IR_OP_ADD,          // dst = src1 + b (flags tanımlanır)
+    IR_OP_SUB,          // dst = src1 - b (flags tanımlanır)
+    IR_OP_MUL,          // dst = src1 * b (flags bozulur)
+    IR_OP_DIV,          // dst = src1 / b (flags bozulur)
+    IR_OP_CMP,          // flags = src1 ? b
+    IR_OP_SEL,          // dst = koşul(flags) ? b : src1
+    IR_OP_CALL,         // br.taken bloğunu çağır (tüm kaydedicileri okur/yazar, flags bozulur)
+    IR_OP_SYSCALL,      // imm: IrSyscall indeksi (tüm kaydedicileri okur/yazar, flags bozulur)
+    IR_OP_PROFCNT,      // imm: PGO sayaç indeksi
+    IR_OP_PROFDUMP,     // PGO sayaçlarını yaz (flags bozulur)
+    // Sonlandırıcılar
+    IR_OP_JMP,          // br.taken bloğuna atla
+    IR_OP_BR,           // koşul(flags) ? br.taken : br.fallthrough
+    IR_OP_JTAB,         // src1 indeksiyle atlama tablosu; imm: IrJumpTable indeksi (flags bozulur)
+    IR_OP_RET,          // Alt programdan dön (tüm kaydedicileri okur)
+    IR_OP_END,          // Programın sonu (AST'de programın sonundan düşme)
+    IR_OP_COUNT
+} IrOpcode;
+
+// --- Koşullar (BR ve SEL) ---
+typedef enum {
+    IR_COND_EQ,
+    IR_COND_NE,
+    IR_COND_LT,
+    IR_COND_GT,
+    IR_COND_LE,
+    IR_COND_GE,
+    IR_COND_NONE
+} IrCondition;
+
+// --- Komut Öznitelikleri (IrInstr.attrs) ---
+#define IR_ATTR_IMM 0x01            // İkinci kaynak (b) src2 değil, sabittir (op.imm)
+#define IR_ATTR_WIDE 0x02           // op.imm 32 bite sığmayan sabitin IrFunction.constants indeksidir
+#define IR_ATTR_FLAGS_CLOBBER 0x04  // flags alanındaki değerin içeriği tanımsızdır (sadece bozma)
+
+// --- IR Komutu (16 bayt) ---
+// "b" ikinci kaynaktır: IR_ATTR_IMM varsa sabit (ir_instr_immediate), yoksa src2.
+typedef struct {
+    uint8_t opcode;         // IrOpcode
+    uint8_t cond;           // IrCondition (BR ve SEL, diğerlerinde IR_COND_NONE)
+    uint8_t attrs;          // IR_ATTR_* bitleri
+    uint8_t reserved;       // Hizalama (0)
+    uint16_t dst;           // Yazılan sanal kaydedici (yoksa IR_NO_VREG)
+    uint16_t flags;         // Tanımlanan veya okunan bayrak değeri (yoksa IR_NO_VREG)
+    union {
+        struct {
+            uint16_t src1;  // Birinci kaynak
+            uint16_t src2;  // İkinci kaynak (IR_ATTR_IMM yoksa)
+            int32_t imm;    // Sabit veya yan tablo indeksi
+        } op;
+        struct {
+            uint32_t taken;         // Atlama/çağrı hedef bloğu
+            uint32_t fallthrough;   // BR: koşul sağlanmazsa gidilecek blok
+        } br;
+    } u;
+} IrInstr;
+
+// Kayıt boyutu derleme zamanında doğrulanır
+typedef char ir_instr_size_check[(sizeof(IrInstr) == 16) ? 1 : -1];
+
+// --- Komutun Kaynak Konumu (komut dizisine paralel) ---
+typedef struct {
+    int32_t line;
+    int32_t column;
+} IrSourceLocation;
+
+// --- Blok Etiketi ---
+typedef struct {
+    uint32_t name;          // Etiket adının IrFunction.strings içindeki konumu (ir_label_name)
+    int32_t unroll_pragma;  // "#unroll N" yönergesi (AstLabelDeclaration ile aynı anlam)
+    int32_t line;
+    int32_t column;
+} IrLabel;
+
+// --- Temel Blok ---
+typedef struct {
+    uint32_t first;         // İlk komutun IrFunction.instrs indeksi
+    uint32_t num_instrs;    // Komut sayısı (son komut sonlandırıcıdır)
+    uint32_t first_label;   // İlk etiketin IrFunction.labels indeksi
+    uint32_t num_labels;    // Bloğun etiket sayısı (0 olabilir)
+    int32_t placed;         // Blok yerleşime (layout) eklendiyse 1
+    int32_t has_profile;    // Profil ağırlıkları geçerliyse 1
+    uint64_t weight;        // Bloğa giriş sayısı
+    uint64_t exit_weight;   // Sonlandırıcının çalıştırılma sayısı
+    uint64_t taken_weight;  // BR için atlamanın gerçekleştiği sayı
+} IrBlock;
+
+// --- Atlama Tablosu (JTAB) ---
+typedef struct {
+    int64_t min;            // Tablonun ilk girişine karşılık gelen değer
+    uint32_t default_block; // Aralık dışı değerler için hedef
+    uint32_t first_target;  // Hedeflerin IrFunction.pool indeksi
+    uint32_t num_targets;
+    uint32_t reserved;      // Hizalama (0)
+} IrJumpTable;
+
+// --- Sistem Çağrısı ---
+typedef struct {
+    int64_t number;         // Sistem çağrı numarası
+    uint32_t first_arg;     // Argüman kaydedicilerinin IrFunction.pool indeksi
+    uint32_t num_args;      // Belgeleyici argüman sayısı (tüm kaydediciler örtük olarak okunur)
+} IrSyscall;
+
+// --- Sanal Kaydedici Bilgisi ---
+typedef enum {
+    IR_CLASS_INT,           // 64-bit tamsayı değeri
+    IR_CLASS_FLAGS          // Bayrak değeri
+} IrVregClass;
+
+typedef struct {
+    uint8_t vreg_class;     // IrVregClass
+    int8_t origin;          // Kökeni olan mimari kaydedici (bayraklar için IR_VREG_FLAGS, yoksa -1)
+} IrVreg;
+
+// --- IR Fonksiyonu (tüm program) ---
+// Tüm tablolar işaretçi içermeyen düz dizilerdir (bağlantılar indeks ve konumlarla ifade edilir);
+// bu sayede IR bir dosyadan olduğu gibi eşlenebilir (bkz. ir_file.h). Kapasitesi 0 olan dolu bir
+// dizi ödünç alınmıştır; ilk değişiklikte kopyalanır.
+typedef struct {
+    IrInstr* instrs;                // Bloklar yerleşim sırasıyla ardışık tutulur
+    IrSourceLocation* locations;    // instrs ile aynı indeksleme
+    size_t num_instrs;
+    size_t instr_capacity;
+    size_t location_capacity;
+
+    IrBlock* blocks;                // Blok kimliğine göre (0 giriş bloğudur)
+    size_t num_blocks;
+    size_t block_capacity;
+    uint32_t* layout;               // Blokların yerleşim sırası (başlatılma sırası)
+    size_t num_layout;
+    size_t layout_capacity;
+    uint32_t current_block;         // Komutların eklendiği blok (IR_NO_BLOCK = yok)
+
+    IrLabel* labels;
+    size_t num_labels;
+    size_t label_capacity;
+    char* strings;                  // NUL ile biten etiket adları
+    size_t strings_size;
+    size_t string_capacity;
+
+    IrVreg* vregs;
+    size_t num_vregs;
+    size_t vreg_capacity;
+
+    int64_t* constants;             // 32 bite sığmayan sabitler
+    size_t num_constants;
+    size_t constant_capacity;
+    IrJumpTable* jump_tables;
+    size_t num_jump_tables;
+    size_t jump_table_capacity;
+    IrSyscall* syscalls;
+    size_t num_syscalls;
+    size_t syscall_capacity;
+    uint32_t* pool;                 // Atlama tablosu hedefleri ve sistem çağrısı argümanları
+    size_t pool_size;
+    size_t pool_capacity;
+
+    int arith_sets_flags;           // ADD/SUB bayrakları kuruyorsa 1 (indirgeme hep 1; eski dosyalarda 0)
+
+    // Ödünç alınan tabloların ait olduğu bellek (örn: eşlenmiş dosya); ir_function_free bırakır
+    void* mapping;
+    size_t mapping_size;
+    void (*release_mapping)(void* mapping, size_t size);
+} IrFunction;
+
+// --- Fonksiyon Prototipleri: Oluşturma (Builder) ---
+
+/**
+ * @brief Boş bir IR fonksiyonu oluşturur (mimari kaydediciler ve bayrak değeri tanımlı).
+ * @return Yeni IrFunction pointer'ı veya NULL bellek hatası durumunda.
+ */
+IrFunction* ir_function_create(void);
+
+/**
+ * @brief IR fonksiyonunu ve tüm tablolarını serbest bırakır.
+ * @param fn Serbest bırakılacak IrFunction pointer'ı.
+ */
+void ir_function_free(IrFunction* fn);
+
+/**
+ * @brief Yeni (henüz yerleştirilmemiş) bir blok oluşturur.
+ * @param fn IR fonksiyonu.
+ * @return Blok kimliği veya bellek hatasında IR_NO_BLOCK.
+ */
+uint32_t ir_new_block(IrFunction* fn);
+
+/**
+ * @brief Bloğa bir etiket ekler (isim kopyalanır). Blok başlatılmadan önce ve bir bloğun
+ * etiketleri ardışık olarak eklenmelidir.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int ir_add_block_label(IrFunction* fn, uint32_t block, const char* name, int unroll_pragma, int line, int column);
+
+/**
+ * @brief Bloğu yerleşimin sonuna ekler; sonraki komutlar bu bloğa yazılır.
+ * Her blok bir kez başlatılır ve önceki blok bir sonlandırıcıyla bitmiş olmalıdır.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int ir_start_block(IrFunction* fn, uint32_t block);
+
+/**
+ * @brief Yeni bir sanal kaydedici oluşturur.
+ * @param vreg_class Kaydedici sınıfı.
+ * @param origin Kökeni olan mimari kaydedici (yoksa -1).
+ * @return Sanal kaydedici veya sınır aşıldığında/bellek hatasında IR_NO_VREG.
+ */
+uint16_t ir_new_vreg(IrFunction* fn, IrVregClass vreg_class, int origin);
+
+/**
+ * @brief Geçerli bloğun sonuna bir komut ekler. Alanlar IR_NO_VREG/IR_COND_NONE ile başlatılır.
+ * Dönen pointer sonraki ekleme çağrısına kadar geçerlidir.
+ * @return Yeni komut veya bellek hatasında/başlatılmış blok yoksa NULL.
+ */
+IrInstr* ir_emit(IrFunction* fn, IrOpcode opcode, int line, int column);
+
+/**
+ * @brief Komutun ikinci kaynağını sabit olarak ayarlar (gerekirse sabit tablosuna ekler).
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int ir_set_immediate(IrFunction* fn, IrInstr* instr, int64_t value);
+
+/**
+ * @brief Etiketin adını döndürür.
+ */
+const char* ir_label_name(const IrFunction* fn, const IrLabel* label);
+
+/**
+ * @brief Komutun sabitini döndürür (IR_ATTR_WIDE ise sabit tablosundan).
+ */
+int64_t ir_instr_immediate(const IrFunction* fn, const IrInstr* instr);
+
+/**
+ * @brief Bir atlama tablosu ekler.
+ * @return Tablo indeksi veya bellek hatasında -1.
+ */
+int ir_add_jump_table(IrFunction* fn, int64_t min, uint32_t default_block, const uint32_t* targets,
+                      size_t num_targets);
+
+/**
+ * @brief Bir sistem çağrısı kaydı ekler.
+ * @param args Argüman kaydedicileri (0-15).
+ * @return Kayıt indeksi veya bellek hatasında -1.
+ */
+int ir_add_syscall(IrFunction* fn, int64_t number, const uint32_t* args, size_t num_args);
+
+/**
+ * @brief Komutun bir sonlandırıcı olup olmadığını kontrol eder (JMP, BR, JTAB, RET, END).
+ */
+int ir_is_terminator(IrOpcode opcode);
+
+/**
+ * @brief Komutun okuduğu sanal kaydedicileri döndürür (CALL, SYSCALL ve RET'in tüm mimari
+ * kaydedicileri örtük okuması dahil değildir).
+ * @param uses En az 3 elemanlı çıktı dizisi.
+ * @return Okunan kaydedici sayısı.
+ */
+size_t ir_instr_uses(const IrInstr* instr, uint16_t* uses);
+
+/**
+ * @brief Komutun yazdığı sanal kaydedicileri (hedef ve bayrak değeri) döndürür.
+ * @param defs En az 2 elemanlı çıktı dizisi.
+ * @return Yazılan kaydedici sayısı.
+ */
+size_t ir_instr_defs(const IrInstr* instr, uint16_t* defs);
+
+/**
+ * @brief Bloğun sonlandırıcısını döndürür.
+ * @return Sonlandırıcı komut veya blok boşsa NULL.
+ */
+const IrInstr* ir_block_terminator(const IrFunction* fn, uint32_t block);
+
+// --- Fonksiyon Prototipleri: AST <-> IR ---
+
+/**
+ * @brief Program AST'sini IR'ye indirger. Bloklar CFG bloklarına karşılık gelir ve yerleşim
+ * program sırasıdır; programın sonundan düşen akış için gerekirse bir END bloğu eklenir.
+ * @param program AST_PROGRAM türündeki kök düğüm.
+ * Bayraklar hedeften bağımsız kaynak anlamıyla indirgenir (bkz. cfg_instruction_flags_effect).
+ * @return Oluşturulan IrFunction pointer'ı veya NULL hata durumunda.
+ */
+IrFunction* ir_lower_program(AstNode* program);
+
+/**
+ * @brief IR'yi yerleşim sırasıyla AST ifadelerine geri çevirir ve programın ifadelerini değiştirir.
+ * Sanal kaydediciler kökenlerine eşlenir; sonraki bloğa giden atlamalar düşmeye dönüşür ve
+ * hedef olan etiketsiz bloklara yeni etiketler (sembol tablosuna da) eklenir.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param program Değiştirilecek AST_PROGRAM düğümü.
+ * @param symbol_table Yeni etiketlerin ekleneceği sembol tablosu.
+ * @return Başarılıysa 1, hata durumunda 0 (hata durumunda program değişmez).
+ */
+int ir_lift_to_program(const IrFunction* fn, AstNode* program, SymbolTable* symbol_table);
+
+/**
+ * @brief IR'nin yapısal kurallarını doğrular: blok sonlandırıcıları, hedefler, kaydedici sınıfları,
+ * blok yerel değerlerin tek atanması ve köken tutarlılığı (her okuma kökeninin güncel değeridir).
+ * @return Geçerliyse 1, aksi takdirde stderr'e hata yazıp 0.
+ */
+int ir_verify(const IrFunction* fn);
+
+/**
+ * @brief IR'yi okunabilir metin olarak yazdırır.
+ * @param fn IR fonksiyonu.
+ * @param out Çıktı akışı.
+ */
+void ir_print(const IrFunction* fn, FILE* out);
+
+/**
+ * @brief IrOpcode'u string'e dönüştürür (örn: "add").
+ */
+const char* ir_opcode_to_string(IrOpcode opcode);
+
+// --- Fonksiyon Prototipleri: IR Geçişleri ---
+
+/**
+ * @brief Hiç okunmayan blok yerel değerleri üreten yan etkisiz komutları siler (MOV, ADD, SUB,
+ * MUL, SEL). Bayrak değeri okunan komutlar korunur; silme zincirleri tek geriye taramada bulunur.
+ * @param fn IR fonksiyonu (yerinde değiştirilir).
+ * @return Silinen komut sayısı.
+ */
+int ir_eliminate_dead_values(IrFunction* fn);
+
+#endif // IR_GENERATOR_H
@@ -0,0 +1,383 @@
+#include "isel.h"
+#include <stdlib.h> // malloc, calloc, free
+#include <stdio.h>  // fprintf
+#include <string.h> // memset, memcpy
+#include <ctype.h>  // isalpha, isspace, tolower
+
+// Kalıp yaprakları (IrOpcode değerlerinden sonra)
+#define ISEL_LEAF_REG IR_OP_COUNT
+#define ISEL_LEAF_IMM (IR_OP_COUNT + 1)
+
+#define ISEL_DEFAULT_COST 1             // Kalıbı olmayan komutun maliyeti
+#define ISEL_BARRIER 0xFFFFFFFFu        // Tüm kaydedicileri değiştiren komut (CALL, SYSCALL, ...)
+
+// --- Kalıp Derleme ---
+
+/**
+ * @brief Kalıplarda kullanılabilen işlem kodlarının işlenen sayısı (0: kalıplarda kullanılamaz).
+ */
+static int isel_arity(IrOpcode opcode) {
+    switch (opcode) {
+        case IR_OP_MOV:
+            return 1;
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_CMP:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Kullanan komutun kalıbına katılabilen (yan etkisiz, değer tanımlayan) işlem kodları.
+ */
+static int isel_is_foldable_opcode(IrOpcode opcode) {
+    return opcode == IR_OP_MOV || opcode == IR_OP_ADD || opcode == IR_OP_SUB || opcode == IR_OP_MUL;
+}
+
+static int isel_name_equals(const char* name, const char* keyword) {
+    for (; *name && *keyword; name++, keyword++) {
+        if (tolower((unsigned char)*name) != tolower((unsigned char)*keyword)) return 0;
+    }
+    return *name == *keyword;
+}
+
+static void isel_skip_spaces(const char** cursor) {
+    while (isspace((unsigned char)**cursor)) (*cursor)++;
+}
+
+static int isel_expect(const char** cursor, char c) {
+    isel_skip_spaces(cursor);
+    if (**cursor != c) return 0;
+    (*cursor)++;
+    return 1;
+}
+
+/**
+ * @brief Kalıp ağacının bir düğümünü (ve alt ağacını) önden sıralı olarak ayrıştırır.
+ * @param position Düğümün ebeveynindeki konumu: -1 kök, 0 ilk kaynak, 1 ikinci kaynak (b).
+ */
+static int isel_parse_node(const char** cursor, IselCompiledPattern* compiled, int position) {
+    char name[16];
+    size_t length = 0;
+    isel_skip_spaces(cursor);
+    while (isalpha((unsigned char)**cursor)) {
+        if (length + 1 >= sizeof(name)) return 0;
+        name[length++] = *(*cursor)++;
+    }
+    name[length] = '\0';
+    if (length == 0 || compiled->num_nodes >= ISEL_MAX_NODES) return 0;
+
+    IselNode* node = &compiled->nodes[compiled->num_nodes++];
+    if (isel_name_equals(name, "reg") || isel_name_equals(name, "imm")) {
+        // Kök yaprak olamaz; ilk kaynak her zaman bir kaydedicidir
+        if (position < 0 || compiled->num_leaves >= ISEL_MAX_LEAVES) return 0;
+        node->kind = isel_name_equals(name, "reg") ? ISEL_LEAF_REG : ISEL_LEAF_IMM;
+        node->num_kids = 0;
+        compiled->num_leaves++;
+        return node->kind == ISEL_LEAF_REG || position != 0;
+    }
+
+    int opcode = -1;
+    for (int op = 0; op < IR_OP_COUNT && opcode < 0; op++) {
+        if (isel_arity((IrOpcode)op) > 0 && isel_name_equals(name, ir_opcode_to_string((IrOpcode)op))) opcode = op;
+    }
+    // İç düğümler kalıba katılan komutlardır
+    if (opcode < 0 || (position >= 0 && !isel_is_foldable_opcode((IrOpcode)opcode))) return 0;
+    node->kind = (uint8_t)opcode;
+    node->num_kids = (uint8_t)isel_arity((IrOpcode)opcode);
+    if (!isel_expect(cursor, '(')) return 0;
+    for (int k = 0; k < node->num_kids; k++) {
+        if (k > 0 && !isel_expect(cursor, ',')) return 0;
+        // MOV'un tek işleneni ikinci kaynaktır (b)
+        if (!isel_parse_node(cursor, compiled, node->num_kids == 1 ? 1 : k)) return 0;
+    }
+    return isel_expect(cursor, ')');
+}
+
+int isel_compile(IselMatcher* matcher, const IselPattern* patterns, size_t num_patterns, const char* target_name) {
+    memset(matcher, 0, sizeof(IselMatcher));
+    matcher->patterns = (IselCompiledPattern*)calloc(num_patterns ? num_patterns : 1, sizeof(IselCompiledPattern));
+    if (!matcher->patterns) {
+        fprintf(stderr, "Hata: %s komut seçimi için bellek tahsis edilemedi.\n", target_name);
+        return 0;
+    }
+
+    // Kök işlem koduna göre sayılıp tablodaki sırayı koruyarak gruplanır
+    uint32_t count[IR_OP_COUNT + 1] = {0};
+    IselCompiledPattern parsed;
+    for (size_t p = 0; p < num_patterns; p++) {
+        memset(&parsed, 0, sizeof(parsed));
+        const char* cursor = patterns[p].tree;
+        if (!isel_parse_node(&cursor, &parsed, -1) || (isel_skip_spaces(&cursor), *cursor != '\0')) {
+            fprintf(stderr, "Hata: %s komut seçimi: geçersiz kalıp \"%s\".\n", target_name, patterns[p].tree);
+            isel_matcher_free(matcher);
+            return 0;
+        }
+        count[parsed.nodes[0].kind + 1]++;
+    }
+    for (int op = 0; op < IR_OP_COUNT; op++) count[op + 1] += count[op];
+    memcpy(matcher->first, count, sizeof(matcher->first));
+    for (size_t p = 0; p < num_patterns; p++) {
+        memset(&parsed, 0, sizeof(parsed));
+        const char* cursor = patterns[p].tree;
+        isel_parse_node(&cursor, &parsed, -1);
+        parsed.pattern = &patterns[p];
+        matcher->patterns[count[parsed.nodes[0].kind]++] = parsed;
+    }
+    matcher->num_patterns = num_patterns;
+    return 1;
+}
+
+void isel_matcher_free(IselMatcher* matcher) {
+    if (!matcher) return;
+    free(matcher->patterns);
+    matcher->patterns = NULL;
+    matcher->num_patterns = 0;
+}
+
+// --- Eşleme ---
+
+typedef struct {
+    const IselSelection* selection;
+    const IselCompiledPattern* compiled;
+    size_t node;                            // Sıradaki kalıp düğümü
+    IselOperand leaves[ISEL_MAX_LEAVES];
+    size_t num_leaves;
+    uint32_t interior[ISEL_MAX_NODES];      // Kalıba katılan komutlar
+    size_t num_interior;
+    int64_t cost;                           // Yapraklara bağlanan katılabilir komutların maliyeti
+} IselMatch;
+
+/**
+ * @brief Komutun makine düzeyinde değiştirdiği kaydedici kökenleri (bit r: Rr) veya ISEL_BARRIER.
+ */
+static uint32_t isel_writes(const IrFunction* fn, const IrInstr* instr) {
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    if (opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL || opcode == IR_OP_PROFDUMP || ir_is_terminator(opcode)) {
+        return ISEL_BARRIER;
+    }
+    if (instr->dst == IR_NO_VREG || instr->dst >= fn->num_vregs) return 0;
+    int origin = fn->vregs[instr->dst].origin;
+    return origin >= 0 && origin < IR_NUM_REGISTERS ? 1u << origin : 0;
+}
+
+/**
+ * @brief Tanımı 'reader' komutunun kalıbına katılabilen komut (yoksa UINT32_MAX).
+ */
+static uint32_t isel_foldable_def(const IselSelection* selection, uint16_t vreg, uint32_t reader) {
+    if (vreg < IR_FIRST_VIRTUAL || vreg >= selection->fn->num_vregs) return UINT32_MAX;
+    uint32_t def = selection->defs[vreg];
+    return def != UINT32_MAX && selection->user[def] == reader ? def : UINT32_MAX;
+}
+
+static int isel_match_node(IselMatch* match, uint32_t index);
+
+/**
+ * @brief Komutun bir işlenenini sıradaki kalıp düğümüyle eşler.
+ * @param operand 0: ilk kaynak, 1: ikinci kaynak (b).
+ */
+static int isel_match_operand(IselMatch* match, uint32_t index, int operand) {
+    const IrFunction* fn = match->selection->fn;
+    const IrInstr* instr = &fn->instrs[index];
+    const IselNode* node = &match->compiled->nodes[match->node];
+    int is_immediate = operand == 1 && (instr->attrs & IR_ATTR_IMM);
+    uint16_t vreg = operand == 0 ? instr->u.op.src1 : instr->u.op.src2;
+
+    if (node->kind == ISEL_LEAF_IMM || node->kind == ISEL_LEAF_REG) {
+        if (is_immediate != (node->kind == ISEL_LEAF_IMM)) return 0;
+        IselOperand* leaf = &match->leaves[match->num_leaves++];
+        leaf->is_immediate = is_immediate;
+        leaf->vreg = is_immediate ? IR_NO_VREG : vreg;
+        leaf->imm = is_immediate ? ir_instr_immediate(fn, instr) : 0;
+        leaf->reader = index;
+        match->node++;
+        if (!is_immediate) {
+            // Değer kendi kalıbıyla hesaplanır
+            uint32_t def = isel_foldable_def(match->selection, vreg, index);
+            if (def != UINT32_MAX) match->cost += match->selection->cost[def];
+        }
+        return 1;
+    }
+    if (is_immediate) return 0;
+    uint32_t def = isel_foldable_def(match->selection, vreg, index);
+    if (def == UINT32_MAX) return 0;
+    match->interior[match->num_interior++] = def;
+    return isel_match_node(match, def);
+}
+
+static int isel_match_node(IselMatch* match, uint32_t index) {
+    const IrInstr* instr = &match->selection->fn->instrs[index];
+    if (match->compiled->nodes[match->node].kind != instr->opcode) return 0;
+    match->node++;
+    if (instr->opcode == IR_OP_MOV) return isel_match_operand(match, index, 1);
+    return isel_match_operand(match, index, 0) && isel_match_operand(match, index, 1);
+}
+
+static int isel_is_interior(const IselMatch* match, uint32_t index) {
+    for (size_t i = 0; i < match->num_interior; i++) {
+        if (match->interior[i] == index) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Kalıba katılan komutların okuduğu değerler kök komutta okunur: aradaki komutlar (kalıba
+ * katılanlar hariç) bu değerlerin kaydedicilerini değiştirmemeli ve engel olmamalıdır.
+ */
+static int isel_operands_survive(const IselMatch* match, uint32_t root) {
+    const IrFunction* fn = match->selection->fn;
+    for (size_t i = 0; i < match->num_interior; i++) {
+        uint32_t reader = match->interior[i];
+        uint32_t read = 0;
+        for (size_t l = 0; l < match->num_leaves; l++) {
+            const IselOperand* leaf = &match->leaves[l];
+            if (leaf->reader != reader || leaf->is_immediate) continue;
+            int origin = fn->vregs[leaf->vreg].origin;
+            if (origin >= 0 && origin < IR_NUM_REGISTERS) read |= 1u << origin;
+        }
+        for (uint32_t k = reader + 1; k < root; k++) {
+            if (isel_is_interior(match, k)) continue;
+            uint32_t writes = isel_writes(fn, &fn->instrs[k]);
+            if (writes == ISEL_BARRIER || (writes & read)) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Kalıbı kök komutta eşler; toplam maliyet match->cost'a yazılır.
+ * @param target Uygunluk denetiminin bağlamı (NULL ise denetim atlanır: seçilmiş kalıbın yeniden eşlenmesi).
+ * @return Eşleşme ve uygunluk varsa 1.
+ */
+static int isel_try(const IselSelection* selection, const IselCompiledPattern* compiled, uint32_t root, void* target,
+                    IselMatch* match) {
+    memset(match, 0, sizeof(IselMatch));
+    match->selection = selection;
+    match->compiled = compiled;
+    if (!isel_match_node(match, root) || !isel_operands_survive(match, root)) return 0;
+    if (target && compiled->pattern->applies &&
+        !compiled->pattern->applies(target, &selection->fn->instrs[root], match->leaves)) {
+        return 0;
+    }
+    match->cost += compiled->pattern->cost;
+    return 1;
+}
+
+// --- Seçim ---
+
+int isel_select(const IselMatcher* matcher, const IrFunction* fn, void* target, IselSelection* selection) {
+    memset(selection, 0, sizeof(IselSelection));
+    selection->matcher = matcher;
+    selection->fn = fn;
+    size_t n = fn->num_instrs ? fn->num_instrs : 1;
+    size_t num_vregs = fn->num_vregs ? fn->num_vregs : 1;
+    selection->choice = (uint16_t*)malloc(sizeof(uint16_t) * n);
+    selection->folded = (uint8_t*)calloc(n, 1);
+    selection->user = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    selection->cost = (int64_t*)malloc(sizeof(int64_t) * n);
+    selection->defs = (uint32_t*)malloc(sizeof(uint32_t) * num_vregs);
+    uint32_t* defs = selection->defs;
+    uint32_t* last_use = (uint32_t*)malloc(sizeof(uint32_t) * num_vregs);
+    uint32_t* num_uses = (uint32_t*)calloc(num_vregs, sizeof(uint32_t));
+    if (!selection->choice || !selection->folded || !selection->user || !selection->cost || !defs || !last_use ||
+        !num_uses) {
+        fprintf(stderr, "Hata: Komut seçimi için bellek tahsis edilemedi.\n");
+        free(last_use);
+        free(num_uses);
+        isel_selection_free(selection);
+        return 0;
+    }
+
+    // Tanımlar ve kullanımlar (blok yerel değerler tek atamalıdır)
+    for (size_t v = 0; v < fn->num_vregs; v++) defs[v] = UINT32_MAX;
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        uint16_t uses[3];
+        size_t count = ir_instr_uses(instr, uses);
+        for (size_t u = 0; u < count; u++) {
+            if (uses[u] >= fn->num_vregs) continue;
+            num_uses[uses[u]]++;
+            last_use[uses[u]] = (uint32_t)i;
+        }
+        if (instr->dst >= IR_FIRST_VIRTUAL && instr->dst < fn->num_vregs) defs[instr->dst] = (uint32_t)i;
+    }
+
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        uint32_t end = block->first + block->num_instrs;
+        for (uint32_t i = block->first; i < end; i++) {
+            const IrInstr* instr = &fn->instrs[i];
+            selection->choice[i] = ISEL_NO_PATTERN;
+            selection->user[i] = UINT32_MAX;
+
+            // Katılabilirlik: tek kullanımlı blok yerel değer, bayrak değeri okunmuyor
+            uint16_t dst = instr->dst;
+            uint16_t flags = instr->flags;
+            int flags_dead = flags == IR_NO_VREG || (instr->attrs & IR_ATTR_FLAGS_CLOBBER) ||
+                             (flags != IR_VREG_FLAGS && flags < fn->num_vregs && num_uses[flags] == 0);
+            if (isel_is_foldable_opcode((IrOpcode)instr->opcode) && dst >= IR_FIRST_VIRTUAL && dst < fn->num_vregs &&
+                num_uses[dst] == 1 && last_use[dst] > i && last_use[dst] < end &&
+                last_use[dst] - i <= ISEL_MAX_DISTANCE && flags_dead) {
+                selection->user[i] = last_use[dst];
+            }
+
+            // Etiketleme: düğüm başına en ucuz kalıp (alt düğümler daha önce etiketlendi)
+            selection->cost[i] = ISEL_DEFAULT_COST;
+            IselMatch match;
+            for (uint32_t p = matcher->first[instr->opcode]; p < matcher->first[instr->opcode + 1]; p++) {
+                if (!isel_try(selection, &matcher->patterns[p], i, target, &match)) continue;
+                if (selection->choice[i] == ISEL_NO_PATTERN || match.cost < selection->cost[i]) {
+                    selection->choice[i] = (uint16_t)p;
+                    selection->cost[i] = match.cost;
+                }
+            }
+        }
+
+        // İndirgeme: kök komutların kalıplarına katılan komutlar işaretlenir
+        for (uint32_t i = end; i-- > block->first;) {
+            if (selection->folded[i] || selection->choice[i] == ISEL_NO_PATTERN) continue;
+            IselMatch match;
+            isel_try(selection, &matcher->patterns[selection->choice[i]], i, NULL, &match);
+            for (size_t k = 0; k < match.num_interior; k++) {
+                selection->folded[match.interior[k]] = 1;
+                selection->num_folded++;
+            }
+        }
+    }
+    free(last_use);
+    free(num_uses);
+    return 1;
+}
+
+void isel_selection_free(IselSelection* selection) {
+    if (!selection) return;
+    free(selection->choice);
+    free(selection->folded);
+    free(selection->user);
+    free(selection->cost);
+    free(selection->defs);
+    memset(selection, 0, sizeof(IselSelection));
+}
+
+int isel_rule(const IselSelection* selection, size_t instr) {
+    if (!selection->choice || instr >= selection->fn->num_instrs || selection->choice[instr] == ISEL_NO_PATTERN) {
+        return ISEL_RULE_DEFAULT;
+    }
+    return selection->matcher->patterns[selection->choice[instr]].pattern->rule;
+}
+
+size_t isel_leaves(const IselSelection* selection, size_t instr, IselOperand* leaves) {
+    if (!selection->choice || instr >= selection->fn->num_instrs || selection->choice[instr] == ISEL_NO_PATTERN) {
+        return 0;
+    }
+    IselMatch match;
+    if (!isel_try(selection, &selection->matcher->patterns[selection->choice[instr]], (uint32_t)instr, NULL, &match)) {
+        return 0;
+    }
+    memcpy(leaves, match.leaves, sizeof(IselOperand) * match.num_leaves);
+    return match.num_leaves;
+}
@@ -0,0 +1,130 @@
+#ifndef ISEL_H
+#define ISEL_H
+
+#include "ir_generator.h" // IrFunction, IrInstr (seçimin girdisi)
+#include <stdint.h> // uint8_t, uint16_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- Ağaç Örüntülü Komut Seçimi (BURS) ---
+// Kod üreticiler IR komutlarını tek tek çevirmek yerine blok içi ifade ağaçlarını hedefin kalıp
+// tablosundaki makine komutu kalıplarıyla döşer (örn: MOV + ADD -> lea veya 3 adresli add).
+// Ağaç düğümleri saf IR komutlarıdır (MOV, ADD, SUB, MUL). Bir düğüm, tek kullanımlı ve blok
+// yerel bir değer tanımlıyorsa, bayrak değeri okunmuyorsa ve kaynakları kullanıldığı komuta
+// kadar değişmiyorsa kullanan komutun kalıbına katılabilir; katılan komut ayrıca yazılmaz.
+// Çok kullanımlı değerler ifade DAG'ını ağaçlara böler: bu değerler kalıplarda yapraktır.
+//
+// Kalıplar metin olarak yazılır, örn: "ADD(reg, MUL(MOV(reg), imm))". İşlem adları IR işlem
+// kodlarıdır (büyük/küçük harf fark etmez); "reg" herhangi bir kaydedici değeri, "imm" komutun
+// sabitidir. İşlenenler IR'deki sırayla yazılır: ilk kaynak, ardından ikinci kaynak (b); MOV'un
+// tek işleneni b'dir. Her kalıbın bir maliyeti (komut sayısı ve gecikmeye göre) ve isteğe bağlı
+// bir uygunluk denetimi (sabit aralıkları, kaydedici konumları) vardır.
+//
+// isel_compile kalıp tablosunu kök işlem koduna göre gruplanmış düz eşleme tablolarına derler.
+// isel_select her bloğu aşağıdan yukarıya dinamik programlamayla etiketler (düğüm başına en ucuz
+// döşeme; yaprağa bağlanan düğümlerin maliyetleri toplanır) ve yukarıdan aşağıya indirger: kök
+// komutlar seçilen kuralla yazılır, kalıba katılan komutlar atlanır. Kalıbı olmayan komutlar
+// kod üreticinin varsayılan çevirisiyle (kural 0) yazılır.
+
+#define ISEL_MAX_NODES 8            // Bir kalıptaki en fazla düğüm (yapraklar dahil)
+#define ISEL_MAX_LEAVES 4           // Bir kalıptaki en fazla yaprak
+#define ISEL_MAX_DISTANCE 32        // Katılan komutla kullanıldığı komut arasındaki en fazla uzaklık
+#define ISEL_RULE_DEFAULT 0         // Kod üreticinin tek komutluk varsayılan çevirisi
+#define ISEL_NO_PATTERN 0xFFFFu     // Komut için kalıp seçilmedi
+
+// --- Kalıp Yaprağına Bağlanan İşlenen ---
+typedef struct {
+    int is_immediate;       // 1: sabit (imm), 0: sanal kaydedici (reg)
+    uint16_t vreg;          // reg yaprağının değeri
+    int64_t imm;            // imm yaprağının değeri
+    uint32_t reader;        // İşleneni okuyan IR komutunun indeksi
+} IselOperand;
+
+// --- Hedef Kalıbı ---
+typedef struct {
+    int rule;               // Kod üreticinin kural numarası (ISEL_RULE_DEFAULT: varsayılan çeviri)
+    const char* tree;       // Kalıp ağacı, örn: "ADD(MOV(reg), imm)"
+    int cost;               // Kalıbın maliyeti
+    // Uygunluk denetimi (NULL: her zaman uygun). leaves kalıptaki yaprak sırasıyladır.
+    int (*applies)(void* target, const IrInstr* root, const IselOperand* leaves);
+} IselPattern;
+
+// --- Derlenmiş Kalıp ---
+typedef struct {
+    uint8_t kind;           // IrOpcode veya ISEL_LEAF_* (isel.c)
+    uint8_t num_kids;
+} IselNode;
+
+typedef struct {
+    const IselPattern* pattern;
+    IselNode nodes[ISEL_MAX_NODES]; // Önden sıralı (preorder)
+    uint8_t num_nodes;
+    uint8_t num_leaves;
+} IselCompiledPattern;
+
+// --- Eşleyici (kök işlem koduna göre gruplanmış kalıplar) ---
+typedef struct {
+    IselCompiledPattern* patterns;
+    size_t num_patterns;
+    uint32_t first[IR_OP_COUNT + 1]; // Kök işlem kodu başına kalıp aralığı: [first[op], first[op + 1])
+} IselMatcher;
+
+// --- Seçim Sonucu ---
+typedef struct {
+    const IselMatcher* matcher;
+    const IrFunction* fn;
+    uint16_t* choice;       // Komut başına seçilen kalıp (ISEL_NO_PATTERN: varsayılan çeviri)
+    uint8_t* folded;        // 1: komut kullanıldığı komutun kalıbına katıldı, yazılmaz
+    uint32_t* user;         // Katılabilir komutlar için tek kullanan komut, aksi takdirde UINT32_MAX
+    int64_t* cost;          // Komut başına en ucuz döşemenin maliyeti
+    uint32_t* defs;         // Blok yerel değer başına tanımlayan komut (yoksa UINT32_MAX)
+    size_t num_folded;      // Kalıplara katılan komut sayısı
+} IselSelection;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Kalıp tablosunu eşleyiciye derler.
+ * @param matcher Doldurulacak eşleyici.
+ * @param patterns Hedefin kalıp tablosu (eşleyiciden uzun yaşamalı).
+ * @param num_patterns Kalıp sayısı.
+ * @param target_name Hata mesajları için hedef adı.
+ * @return Başarılıysa 1, sözdizimi hatasında veya bellek hatasında 0 (stderr'e açıklama yazılır).
+ */
+int isel_compile(IselMatcher* matcher, const IselPattern* patterns, size_t num_patterns, const char* target_name);
+
+/**
+ * @brief Eşleyicinin tablolarını serbest bırakır.
+ */
+void isel_matcher_free(IselMatcher* matcher);
+
+/**
+ * @brief Fonksiyonun tüm bloklarını döşer.
+ * @param matcher Derlenmiş eşleyici.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param target Uygunluk denetimlerine aktarılır (kod üretici).
+ * @param selection Doldurulacak seçim sonucu.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int isel_select(const IselMatcher* matcher, const IrFunction* fn, void* target, IselSelection* selection);
+
+/**
+ * @brief Seçim sonucunun dizilerini serbest bırakır.
+ */
+void isel_selection_free(IselSelection* selection);
+
+/**
+ * @brief Komut için seçilen kuralı döndürür.
+ * @return Kalıbın kural numarası veya kalıp seçilmediyse ISEL_RULE_DEFAULT.
+ */
+int isel_rule(const IselSelection* selection, size_t instr);
+
+/**
+ * @brief Komutun seçilen kalıbındaki yaprakları bağlar.
+ * @param selection Seçim sonucu.
+ * @param instr Kök komutun indeksi.
+ * @param leaves En az ISEL_MAX_LEAVES elemanlı çıktı dizisi (kalıptaki yaprak sırasıyla).
+ * @return Yaprak sayısı; kalıp seçilmediyse 0.
+ */
+size_t isel_leaves(const IselSelection* selection, size_t instr, IselOperand* leaves);
+
+#endif // ISEL_H
@@ -0,0 +1,323 @@
+#include "jit.h"
+#include <stdio.h>  // fprintf, printf
+#include <stdlib.h> // calloc, realloc, free
+#include <string.h> // memcpy
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_SUPPORTED 1
+#include "arch/amd64/amd64_codegen.h"
+#include <sys/mman.h> // mmap, mprotect, munmap
+#include <unistd.h>   // sysconf
+#else
+#define JIT_SUPPORTED 0
+#endif
+
+int jit_is_supported(void) {
+    return JIT_SUPPORTED;
+}
+
+#if JIT_SUPPORTED
+
+typedef void (*JitEntry)(JitContext* ctx);
+
+// --- Sistem Çağrıları ---
+
+static JitSyscallResult jit_syscall_exit(JitContext* ctx, const int64_t* args, size_t num_args, void* user) {
+    (void)user;
+    ctx->exit_code = num_args > 0 ? args[0] : ctx->registers[0];
+    return JIT_SYSCALL_EXIT;
+}
+
+static JitSyscallResult jit_hypercall_print(JitContext* ctx, const int64_t* args, size_t num_args, void* user) {
+    (void)ctx;
+    (void)user;
+    for (size_t a = 0; a < num_args; a++) printf(a ? " %lld" : "%lld", (long long)args[a]);
+    printf("\n");
+    return JIT_SYSCALL_CONTINUE;
+}
+
+int jit_register_syscall(JitProgram* program, int64_t number, JitSyscallHandler handler, void* user) {
+    size_t s = 0;
+    while (s < program->num_syscalls && program->syscalls[s].number != number) s++;
+    if (s == program->num_syscalls) {
+        if (program->num_syscalls == program->syscall_capacity) {
+            size_t new_capacity = program->syscall_capacity ? program->syscall_capacity * 2 : 8;
+            JitSyscall* grown = (JitSyscall*)realloc(program->syscalls, new_capacity * sizeof(JitSyscall));
+            if (!grown) {
+                fprintf(stderr, "Hata: JIT: sistem çağrısı tablosu için bellek tahsis edilemedi.\n");
+                return 0;
+            }
+            program->syscalls = grown;
+            program->syscall_capacity = new_capacity;
+        }
+        program->num_syscalls++;
+    }
+    program->syscalls[s].number = number;
+    program->syscalls[s].handler = handler;
+    program->syscalls[s].user = user;
+    // İşleyiciler çözülmüş sitelere doğrudan yazılır; trampolin tablo araması yapmaz
+    for (size_t i = 0; i < program->num_syscall_sites; i++) {
+        if (program->syscall_sites[i].number != number) continue;
+        program->syscall_sites[i].handler = handler;
+        program->syscall_sites[i].user = user;
+    }
+    return 1;
+}
+
+/**
+ * @brief Konak trampolini: üretilen kod SYSCALL ve PROFDUMP'ta kaydedicileri bağlama yazıp
+ * bu fonksiyonu çağırır.
+ * @return 0 ise yürütme devam eder; aksi halde üretilen kod çıkar (exit veya hata).
+ */
+static int jit_host_call(JitContext* ctx, uint32_t site_index) {
+    JitProgram* program = ctx->program;
+    if (site_index == JIT_HOST_PROFILE_DUMP) {
+        if (program->profile_dump) {
+            program->profile_dump(program->context.counters, program->num_counters, program->profile_user);
+        }
+        return 0;
+    }
+    const JitSyscallSite* site = &program->syscall_sites[site_index];
+    if (!site->handler) {
+        fprintf(stderr, "Hata: JIT: satır %d: tanımsız sistem çağrısı %lld.\n", site->line, (long long)site->number);
+        ctx->exit_reason = JIT_EXIT_HOST_ERROR;
+        return 1;
+    }
+    int64_t args[JIT_MAX_SYSCALL_ARGS];
+    for (uint32_t a = 0; a < site->num_args; a++) args[a] = ctx->registers[program->syscall_args[site->first_arg + a]];
+    JitSyscallResult result = site->handler(ctx, args, site->num_args, site->user);
+    if (result == JIT_SYSCALL_EXIT) return 1;
+    if (result == JIT_SYSCALL_ERROR) {
+        ctx->exit_reason = JIT_EXIT_HOST_ERROR;
+        return 1;
+    }
+    return 0;
+}
+
+// --- Derleme ---
+
+/**
+ * @brief Sistem çağrısı sitelerini, argüman kaydedicilerini ve PGO sayaçlarını IR'den kopyalar
+ * (derlenmiş program IR'ye bağlı kalmaz).
+ */
+static int jit_copy_runtime_tables(JitProgram* program, const IrFunction* fn) {
+    size_t num_args = 0;
+    for (size_t s = 0; s < fn->num_syscalls; s++) {
+        if (fn->syscalls[s].num_args > JIT_MAX_SYSCALL_ARGS) {
+            fprintf(stderr, "Hata: JIT: sistem çağrısı en fazla %d argüman alabilir.\n", JIT_MAX_SYSCALL_ARGS);
+            return 0;
+        }
+        num_args += fn->syscalls[s].num_args;
+    }
+    size_t num_counters = 0;
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode != IR_OP_PROFCNT) continue;
+        int64_t counter = ir_instr_immediate(fn, instr);
+        if (counter >= 0 && (size_t)counter + 1 > num_counters) num_counters = (size_t)counter + 1;
+    }
+
+    program->syscall_sites = (JitSyscallSite*)calloc(fn->num_syscalls + 1, sizeof(JitSyscallSite));
+    program->syscall_args = (uint8_t*)calloc(num_args + 1, 1);
+    program->context.counters = (uint64_t*)calloc(num_counters + 1, sizeof(uint64_t));
+    program->num_counters = num_counters;
+    if (!program->syscall_sites || !program->syscall_args || !program->context.counters) {
+        fprintf(stderr, "Hata: JIT: çalışma zamanı tabloları için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    size_t next_arg = 0;
+    for (size_t s = 0; s < fn->num_syscalls; s++) {
+        const IrSyscall* syscall = &fn->syscalls[s];
+        JitSyscallSite* site = &program->syscall_sites[s];
+        site->number = syscall->number;
+        site->first_arg = (uint32_t)next_arg;
+        site->num_args = syscall->num_args;
+        for (uint32_t a = 0; a < syscall->num_args; a++) {
+            program->syscall_args[next_arg++] = (uint8_t)(fn->pool[syscall->first_arg + a] & 0x0f);
+        }
+    }
+    program->num_syscall_sites = fn->num_syscalls;
+    // Hata mesajları için sitenin satırı
+    for (size_t i = 0; i < fn->num_instrs && fn->locations; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode == IR_OP_SYSCALL && (size_t)instr->u.op.imm < fn->num_syscalls) {
+            program->syscall_sites[instr->u.op.imm].line = fn->locations[i].line;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Kodu W^X kod belleğine yerleştirir: önce yazılabilir eşlemeye kopyalanır, sonra
+ * eşleme salt okunur+yürütülebilir yapılır.
+ */
+static int jit_map_code(JitProgram* program, const Amd64Buffer* code) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) page_size = 4096;
+    size_t size = (code->size + (size_t)page_size - 1) / (size_t)page_size * (size_t)page_size;
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("Hata: JIT: kod belleği ayrılamadı");
+        return 0;
+    }
+    memcpy(memory, code->data, code->size);
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        perror("Hata: JIT: kod belleği yürütülebilir yapılamadı");
+        munmap(memory, size);
+        return 0;
+    }
+    program->code = memory;
+    program->code_size = size;
+    program->machine_code_size = code->size;
+    return 1;
+}
+
+JitProgram* jit_compile(const IrFunction* fn) {
+    JitProgram* program = (JitProgram*)calloc(1, sizeof(JitProgram));
+    if (!program) {
+        fprintf(stderr, "Hata: JIT için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    Amd64Buffer code = {0};
+    Amd64CodeMap map = {0};
+    int ok = jit_copy_runtime_tables(program, fn) && amd64_generate_jit(fn, &code, &map) &&
+             jit_map_code(program, &code);
+    amd64_buffer_free(&code);
+    program->osr_entry = map.osr_entry;
+    program->block_entries = map.block_offsets; // Sahiplik programa geçer
+    program->num_blocks = map.num_blocks;
+    program->call_returns = map.call_returns;
+    program->num_calls = map.num_calls;
+    if (ok) {
+        ok = jit_register_syscall(program, JIT_SYS_EXIT, jit_syscall_exit, NULL) &&
+             jit_register_syscall(program, JIT_SYS_EXIT_GROUP, jit_syscall_exit, NULL) &&
+             jit_register_syscall(program, JIT_HYPERCALL_PRINT, jit_hypercall_print, NULL);
+    }
+    if (!ok) {
+        jit_free(program);
+        return NULL;
+    }
+    return program;
+}
+
+// --- Yürütme ---
+
+/**
+ * @brief Kodu verilen konumdaki girişten çalıştırır ve çıkış nedenini raporlar.
+ */
+static JitStatus jit_execute(JitProgram* program, size_t entry_offset) {
+    JitContext* ctx = &program->context;
+    ctx->exit_code = 0;
+    ctx->exit_reason = JIT_EXIT_NONE;
+    ctx->error_line = 0;
+    ctx->host_call = jit_host_call;
+    ctx->program = program;
+
+    // Nesne pointer'ından fonksiyon pointer'ına dönüşüm ISO C'de tanımlı değildir
+    void* address = (uint8_t*)program->code + entry_offset;
+    JitEntry entry;
+    memcpy(&entry, &address, sizeof(entry));
+    entry(ctx);
+
+    program->exit_code = ctx->exit_code;
+    switch ((JitExitReason)ctx->exit_reason) {
+        case JIT_EXIT_NONE:
+            return JIT_STATUS_HALTED;
+        case JIT_EXIT_DIVIDE_BY_ZERO:
+            fprintf(stderr, "Hata: JIT: satır %d: sıfıra bölme.\n", ctx->error_line);
+            break;
+        case JIT_EXIT_CALL_OVERFLOW:
+            fprintf(stderr, "Hata: JIT: satır %d: çağrı yığını taştı (derinlik %d).\n", ctx->error_line,
+                    JIT_MAX_CALL_DEPTH);
+            break;
+        case JIT_EXIT_HOST_ERROR:
+            break; // Trampolin mesajı yazdı
+    }
+    return JIT_STATUS_ERROR;
+}
+
+JitStatus jit_run(JitProgram* program) {
+    return jit_execute(program, 0);
+}
+
+JitStatus jit_enter(JitProgram* program, uint32_t block, const uint32_t* call_sites, size_t num_frames,
+                    const int64_t flags[2]) {
+    if (block >= program->num_blocks || program->block_entries[block] == UINT32_MAX ||
+        num_frames > JIT_MAX_CALL_DEPTH) {
+        fprintf(stderr, "Hata: JIT: b%u bloğuna yerinde geçiş yapılamıyor.\n", block);
+        return JIT_STATUS_ERROR;
+    }
+    uintptr_t base = (uintptr_t)program->code;
+    uintptr_t* frames = (uintptr_t*)malloc(sizeof(uintptr_t) * (num_frames + 1));
+    if (!frames) {
+        fprintf(stderr, "Hata: JIT: yerinde geçiş için bellek tahsis edilemedi.\n");
+        return JIT_STATUS_ERROR;
+    }
+    for (size_t f = 0; f < num_frames; f++) {
+        if (call_sites[f] >= program->num_calls) {
+            fprintf(stderr, "Hata: JIT: %zu. çağrı çerçevesi eşlenemiyor.\n", f);
+            free(frames);
+            return JIT_STATUS_ERROR;
+        }
+        frames[f] = base + program->call_returns[call_sites[f]];
+    }
+    JitContext* ctx = &program->context;
+    ctx->osr_target = base + program->block_entries[block];
+    ctx->osr_frames = frames;
+    ctx->osr_num_frames = num_frames;
+    ctx->osr_flags[0] = flags[0];
+    ctx->osr_flags[1] = flags[1];
+    JitStatus status = jit_execute(program, program->osr_entry);
+    ctx->osr_frames = NULL;
+    free(frames);
+    return status;
+}
+
+void jit_free(JitProgram* program) {
+    if (!program) return;
+    if (program->code) munmap(program->code, program->code_size);
+    free(program->block_entries);
+    free(program->call_returns);
+    free(program->syscall_sites);
+    free(program->syscall_args);
+    free(program->syscalls);
+    free(program->context.counters);
+    free(program);
+}
+
+#else // !JIT_SUPPORTED
+
+int jit_register_syscall(JitProgram* program, int64_t number, JitSyscallHandler handler, void* user) {
+    (void)program;
+    (void)number;
+    (void)handler;
+    (void)user;
+    return 0;
+}
+
+JitProgram* jit_compile(const IrFunction* fn) {
+    (void)fn;
+    fprintf(stderr, "Hata: JIT bu platformda desteklenmiyor (sadece Linux x86-64).\n");
+    return NULL;
+}
+
+JitStatus jit_run(JitProgram* program) {
+    (void)program;
+    return JIT_STATUS_ERROR;
+}
+
+JitStatus jit_enter(JitProgram* program, uint32_t block, const uint32_t* call_sites, size_t num_frames,
+                    const int64_t flags[2]) {
+    (void)program;
+    (void)block;
+    (void)call_sites;
+    (void)num_frames;
+    (void)flags;
+    return JIT_STATUS_ERROR;
+}
+
+void jit_free(JitProgram* program) {
+    (void)program;
+}
+
+#endif // JIT_SUPPORTED
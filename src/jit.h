@@ -0,0 +1,170 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "ir_generator.h" // IrFunction (derlenecek program)
+#include <stdint.h> // int64_t, uint64_t, uintptr_t için
+#include <stddef.h> // size_t için
+
+// --- Süreç İçi JIT Yürütme ---
+// Optimize edilmiş IR doğrudan makine koduna derlenir ve aynı süreçte çalıştırılır; nesne
+// dosyası, bağlayıcı veya yeni süreç gerekmez. Şu an sadece Linux x86-64 desteklenir
+// (bkz. arch/amd64/amd64_codegen.h).
+//
+// Kod belleği W^X'tir: kod yazılabilir (salt yürütülemez) bir mmap bölgesine kopyalanır, sonra
+// bölge salt okunur+yürütülebilir yapılır; hiçbir an hem yazılabilir hem yürütülebilir değildir.
+//
+// Üretilen kod JitContext'i ayrılmış bir kaydedicide tutar. SYSCALL ve PROFDUMP komutları
+// kaydedicileri bağlama yazıp konak trampolinini (JitContext.host_call) çağırır; trampolin
+// sistem çağrısını kayıtlı işleyiciye yönlendirir. Anlam BVM ile aynıdır (bkz. bvm.h): yürütme
+// hataları (sıfıra bölme, çağrı yığını taşması, tanımsız sistem çağrısı) programı durdurur.
+
+#define JIT_NUM_REGISTERS 16
+#define JIT_MAX_CALL_DEPTH 4096
+#define JIT_MAX_SYSCALL_ARGS 16
+
+// --- Yerleşik Sistem Çağrıları (BVM ile aynı numaralar) ---
+#define JIT_SYS_EXIT 60
+#define JIT_SYS_EXIT_GROUP 231
+#define JIT_HYPERCALL_PRINT 0x1000
+
+#define JIT_HOST_PROFILE_DUMP 0xFFFFFFFFu // host_call'a PROFDUMP için verilen site
+
+// --- Yürütme Sonucu ---
+typedef enum {
+    JIT_STATUS_HALTED,      // Program bitti (JitProgram.exit_code geçerli)
+    JIT_STATUS_ERROR        // Yürütme hatası (stderr'e açıklama yazıldı)
+} JitStatus;
+
+// --- Bağlamın Çıkış Nedeni (JitContext.exit_reason) ---
+typedef enum {
+    JIT_EXIT_NONE,              // Program sona erdi veya exit çağrısı yapıldı
+    JIT_EXIT_HOST_ERROR,        // Sistem çağrısı işleyicisi hata döndürdü
+    JIT_EXIT_DIVIDE_BY_ZERO,
+    JIT_EXIT_CALL_OVERFLOW
+} JitExitReason;
+
+// --- Sistem Çağrısı İşleyicisi Sonucu ---
+typedef enum {
+    JIT_SYSCALL_CONTINUE,
+    JIT_SYSCALL_EXIT,       // İşleyici JitContext.exit_code'u ayarlar
+    JIT_SYSCALL_ERROR
+} JitSyscallResult;
+
+struct JitContext;
+struct JitProgram;
+
+/**
+ * @brief Sistem çağrısı işleyicisi. Kaydediciler ctx->registers içinde okunabilir ve
+ * değiştirilebilir (sonuç için R0 kullanılır).
+ */
+typedef JitSyscallResult (*JitSyscallHandler)(struct JitContext* ctx, const int64_t* args, size_t num_args,
+                                              void* user);
+
+// --- Yürütme Bağlamı ---
+// Üretilen kod alanlara sabit uzaklıklarla erişir; düzen değişirse kod üretici de güncellenir.
+typedef struct JitContext {
+    int64_t registers[JIT_NUM_REGISTERS]; // Makine kaydedicisi almayan kaydediciler burada yaşar;
+                                          // sistem çağrılarında ve çıkışta hepsi eşitlenir
+    uint64_t* counters;                   // PROFCNT sayaçları
+    uintptr_t entry_sp;                   // Girişteki yığın göstericisi (çıkışta geri yüklenir)
+    uintptr_t stack_limit;                // CALL bu adresin altına inemez (JIT_MAX_CALL_DEPTH)
+    int (*host_call)(struct JitContext* ctx, uint32_t site); // 0: devam, aksi halde çık
+    int64_t exit_code;
+    int32_t exit_reason;                  // JitExitReason
+    int32_t error_line;                   // Hatanın kaynak satırı (bilinmiyorsa 0)
+    struct JitProgram* program;
+    // Yerinde geçiş (jit_enter): giriş bloğunun adresi, dıştan içe çerçevelerin dönüş adresleri
+    // ve bayraklar (son karşılaştırmanın iki tarafı)
+    uintptr_t osr_target;
+    const uintptr_t* osr_frames;
+    uint64_t osr_num_frames;
+    int64_t osr_flags[2];
+} JitContext;
+
+// --- Sistem Çağrısı Sitesi ---
+typedef struct {
+    int64_t number;
+    uint32_t first_arg;         // JitProgram.syscall_args içindeki ilk argüman
+    uint32_t num_args;
+    int32_t line;               // Kaynak satırı (bilinmiyorsa 0)
+    JitSyscallHandler handler;  // Çözülmüş işleyici (tanımsızsa NULL)
+    void* user;
+} JitSyscallSite;
+
+// --- Sistem Çağrısı Tablosu Girdisi ---
+typedef struct {
+    int64_t number;
+    JitSyscallHandler handler;
+    void* user;
+} JitSyscall;
+
+// --- Derlenmiş Program ---
+typedef struct JitProgram {
+    void* code;                     // Yürütülebilir eşleme (salt okunur)
+    size_t code_size;               // Eşlemenin boyutu (sayfa katı)
+    size_t machine_code_size;       // Üretilen kodun gerçek boyutu
+    size_t osr_entry;               // OSR girişinin koddaki konumu
+    uint32_t* block_entries;        // IR bloğu başına kod konumu (yerleşimde değilse UINT32_MAX)
+    size_t num_blocks;
+    uint32_t* call_returns;         // IR CALL komutlarının (yerleşim sırasıyla) dönüş konumları
+    size_t num_calls;
+    JitSyscallSite* syscall_sites;  // IR sistem çağrısı indeksleriyle aynı sırada
+    size_t num_syscall_sites;
+    uint8_t* syscall_args;
+    JitSyscall* syscalls;           // Takılabilir sistem çağrısı tablosu
+    size_t num_syscalls;
+    size_t syscall_capacity;
+    size_t num_counters;            // context.counters'ın eleman sayısı
+    JitContext context;
+    int64_t exit_code;
+    void (*profile_dump)(const uint64_t* counters, size_t num_counters, void* user); // PROFDUMP'ta (NULL olabilir)
+    void* profile_user;
+} JitProgram;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Bu derlemenin JIT yürütmeyi destekleyip desteklemediğini bildirir (Linux x86-64).
+ */
+int jit_is_supported(void);
+
+/**
+ * @brief IR'yı makine koduna derler ve W^X kod belleğine yerleştirir.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı; derlemeden sonra serbest bırakılabilir).
+ * @return Yeni JitProgram pointer'ı veya NULL hata durumunda.
+ */
+JitProgram* jit_compile(const IrFunction* fn);
+
+/**
+ * @brief Programı baştan yürütür. Kaydediciler context.registers'tan başlar; sayaçlar birikir.
+ * @param program Derlenmiş program.
+ * @return JIT_STATUS_HALTED veya JIT_STATUS_ERROR.
+ */
+JitStatus jit_run(JitProgram* program);
+
+/**
+ * @brief Yerinde geçiş (OSR): yürütmeye bir IR bloğundan, başka bir yürütücünün (BVM) durumuyla
+ * devam eder. Kaydediciler context.registers'tan alınır.
+ * @param program Derlenmiş program.
+ * @param block Giriş bloğu.
+ * @param call_sites Dıştan içe her çağrı çerçevesini oluşturan CALL'un sıra numarası (yerleşim sırasıyla).
+ * @param num_frames Çerçeve sayısı (en fazla JIT_MAX_CALL_DEPTH).
+ * @param flags Son karşılaştırmanın iki tarafı.
+ * @return JIT_STATUS_HALTED veya JIT_STATUS_ERROR (blok veya çerçeve eşlenemezse de).
+ */
+JitStatus jit_enter(JitProgram* program, uint32_t block, const uint32_t* call_sites, size_t num_frames,
+                    const int64_t flags[2]);
+
+/**
+ * @brief Bir sistem çağrısı numarasına işleyici bağlar (varsa öncekinin yerine geçer).
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+int jit_register_syscall(JitProgram* program, int64_t number, JitSyscallHandler handler, void* user);
+
+/**
+ * @brief Programı ve kod belleğini serbest bırakır.
+ * @param program Serbest bırakılacak JitProgram pointer'ı.
+ */
+void jit_free(JitProgram* program);
+
+#endif // JIT_H
@@ -1 +1,276 @@
-
+// Bessambly Standart AOT Derleyicisi - Komut satırı giriş noktası
+// Aşamalar: Lexer -> Parser -> Semantik Analiz -> Optimizer -> IR -> Kod üretimi (.vbsm, .wasm, .o) -> BVM (--run)
+// --run=jit ile IR doğrudan makine koduna derlenip süreç içinde yürütülür (bkz. jit.h);
+// --run=tiered BVM'de başlar ve sıcak döngülerde makine koduna geçer (bkz. tiered.h).
+// Giriş bir .bsmir dosyasıysa önbelleğe alınmış IR doğrudan belleğe eşlenir ve ön aşamalar atlanır;
+// bir .vbsm dosyasıysa doğrudan BVM'de yürütülür.
+
+#include "cli_args.h"
+#include "lexer.h"
+#include "parser.h"
+#include "semantic_analyzer.h"
+#include "optimizer.h"
+#include "profile.h"
+#include "superopt.h"
+#include "ir_generator.h"
+#include "ir_file.h"
+#include "vbsm.h"
+#include "wasm.h"
+#include "object_file_writer.h"
+#include "arch/amd64/amd64_codegen.h"
+#include "arch/aarch64/aarch64_codegen.h"
+#include "arch/riscv/riscv_codegen.h"
+#include "bvm.h"
+#include "jit.h"
+#include "tiered.h"
+#include <stdio.h>  // fprintf
+
+/**
+ * @brief BVM/JIT PROFDUMP geri çağrısı: enstrümante programın sayaçlarını .bsmprof'a yazar.
+ */
+static void write_profile_counters(const uint64_t* counters, size_t num_counters, void* user) {
+    profile_sink_dump((ProfileSink*)user, counters, num_counters);
+}
+
+/**
+ * @brief Yürütme bittiğinde (PROFDUMP'a varılmadıysa) sayaçları yazar ve sonucu bildirir.
+ */
+static int finish_profile(ProfileSink* sink, const uint64_t* counters, size_t num_counters) {
+    if (!sink) return 1;
+    if (!profile_sink_dump(sink, counters, num_counters)) return 0;
+    fprintf(stdout, "PGO: Profil sayaçları '%s' dosyasına yazıldı (%zu sayaç).\n", sink->path, sink->num_counters);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    CliArgs args;
+    if (!cli_args_parse(argc, argv, &args)) {
+        cli_args_print_usage(argv[0]);
+        return 1;
+    }
+    if (args.show_help) {
+        cli_args_print_usage(argv[0]);
+        return 0;
+    }
+    // Nesne dosyası için mimari verilmezse amd64 üretilir; optimizer (örn: bayrak yeniden kullanımı)
+    // ve IR indirgemesi de aynı mimariyi görmelidir
+    if (args.target_arch == UNKNOWN_ARCH && args.output_path && object_file_has_extension(args.output_path)) {
+        args.target_arch = ARCH_AMD64;
+    }
+
+    int exit_code = 1;
+    Lexer* lexer = NULL;
+    Parser* parser = NULL;
+    AstNode* ast_root = NULL;
+    SemanticAnalyzer* analyzer = NULL;
+    Optimizer* optimizer = NULL;
+    IrFunction* ir = NULL;
+    VbsmModule* bytecode = NULL;
+    Bvm* vm = NULL;
+    BvmSuperinstructionSet* superinstructions = NULL;
+    JitProgram* jit = NULL;
+    TieredEngine* tiered = NULL;
+    ObjectFile* object = NULL;
+    ProfileSink profile_sink = {0};
+    ProfileSink* profile = NULL;    // --profile-generate ile --run: yürütücünün sayaçları buraya yazılır
+
+    if (vbsm_has_extension(args.input_path)) {
+        bytecode = vbsm_read_file(args.input_path);
+        if (!bytecode) goto cleanup;
+        args.run = RUN_BVM;
+        goto execute;
+    }
+    if (ir_file_has_extension(args.input_path)) {
+        ir = ir_file_load(args.input_path);
+        if (!ir) goto cleanup;
+        goto ir_ready;
+    }
+
+    // 1. Sözdizimsel analiz
+    lexer = lexer_init(args.input_path);
+    if (!lexer) goto cleanup;
+    parser = parser_init(lexer);
+    if (!parser) goto cleanup;
+    ast_root = parse_program(parser);
+    if (!ast_root) {
+        fprintf(stderr, "Hata: '%s' ayrıştırılamadı.\n", args.input_path);
+        goto cleanup;
+    }
+
+    // 2. Semantik analiz
+    analyzer = semantic_analyzer_init();
+    if (!analyzer || !perform_semantic_analysis(analyzer, ast_root)) goto cleanup;
+
+    // 3. Optimizasyon (PGO enstrümantasyonu/kullanımı ve süperoptimizasyon kuralları dahil)
+    optimizer = optimizer_init();
+    if (!optimizer) goto cleanup;
+    optimizer->optimization_level = args.optimization_level;
+    optimizer->opt_budget_ms = args.opt_budget_ms;
+    optimizer->target_arch = args.target_arch;
+    optimizer->instrument_profile = args.profile_generate;
+    if (args.profile_generate && args.profile_path) {
+        optimizer->profile_output_path = args.profile_path;
+    }
+    if (args.profile_use) {
+        optimizer->profile = profile_load(args.profile_path);
+        if (!optimizer->profile) goto cleanup;
+    }
+    if (args.superopt_rules_path) {
+        // İlk aramada veritabanı henüz yoktur; arama yapılmıyorsa dosya olmalıdır
+        optimizer->superopt_rules = superopt_rules_load(args.superopt_rules_path, args.superoptimize);
+        if (!optimizer->superopt_rules) goto cleanup;
+        optimizer->superoptimize = args.superoptimize;
+    }
+    if (!perform_optimizations(optimizer, ast_root, analyzer->symbol_table)) goto cleanup;
+    if (optimizer->instrument_profile && args.run != RUN_NONE) {
+        profile_sink.path = optimizer->profile_output_path;
+        profile_sink.cfg_checksum = optimizer->instrumentation.cfg_checksum;
+        profile_sink.num_counters = optimizer->instrumentation.num_counters;
+        profile = &profile_sink;
+    }
+    if (optimizer->superoptimize && optimizer->superopt_rules->modified &&
+        !superopt_rules_save(args.superopt_rules_path, optimizer->superopt_rules)) {
+        goto cleanup;
+    }
+
+    // 4. Üç adresli IR'ye indirgeme
+    ir = ir_lower_program(ast_root);
+    if (!ir || !ir_verify(ir)) goto cleanup;
+
+ir_ready:
+    if (args.dump_ir) ir_print(ir, stdout);
+    if (args.emit_ir_path && !ir_file_write(args.emit_ir_path, ir)) goto cleanup;
+
+    // 5. Kod üretimi: çıktı biçimi -o uzantısından seçilir; --run bayt kodunu bellekte üretir
+    int emit_vbsm = args.output_path && vbsm_has_extension(args.output_path);
+    if (emit_vbsm || args.run == RUN_BVM || args.run == RUN_TIERED) {
+        bytecode = vbsm_emit_program(ir);
+        if (!bytecode) goto cleanup;
+    }
+    if (emit_vbsm) {
+        if (!vbsm_write_file(args.output_path, bytecode)) goto cleanup;
+        fprintf(stdout, "VBSM: '%s' yazıldı (%zu bayt kod, %zu sabit, %zu etiket).\n", args.output_path,
+                bytecode->code_size, bytecode->num_constants, bytecode->num_labels);
+    }
+
+    if (args.output_path && wasm_has_extension(args.output_path)) {
+        WasmEmitStats stats;
+        if (!wasm_emit_file(ir, args.output_path, &stats)) goto cleanup;
+        fprintf(stdout, "WASM: '%s' yazıldı (%zu bayt; %zu fonksiyon, %zu döngü, %zu dağıtıcı).\n", args.output_path,
+                stats.file_size, stats.num_functions, stats.num_loops, stats.num_dispatchers);
+    }
+
+    if (args.output_path && object_file_has_extension(args.output_path)) {
+        ObjectCodegenOptions options = {0, 0, NULL};
+        if (optimizer && optimizer->instrument_profile) {
+            options.profile_checksum = optimizer->instrumentation.cfg_checksum;
+            options.profile_num_counters = optimizer->instrumentation.num_counters;
+            options.profile_path = optimizer->profile_output_path;
+        }
+        ObjectCodegenStats stats;
+        TargetArchitecture object_arch = args.target_arch;
+        int is_aarch64 = object_arch == ARCH_ARMV8 || object_arch == ARCH_ARMV9;
+        int is_riscv = object_arch == ARCH_RV64I || object_arch == ARCH_RV64E;
+        object = object_file_create(object_arch);
+        if (!object ||
+            !(is_aarch64 ? aarch64_generate_object(ir, object, &options, &stats)
+              : is_riscv ? riscv_generate_object(ir, object, &options, &stats)
+                         : amd64_generate_object(ir, object, &options, &stats)) ||
+            !object_file_write_elf(object, args.output_path)) {
+            goto cleanup;
+        }
+        // Etiket adresleri: optimizer'ın komut sırasına göre verdiği sanal adresler yerine .text
+        // içindeki gerçek bayt konumları (dallar gevşetildikten sonraki son yerleşim)
+        for (size_t i = 0; analyzer && i < analyzer->symbol_table->count; i++) {
+            SymbolEntry* entry = &analyzer->symbol_table->entries[i];
+            int symbol = object_file_find_symbol(object, entry->name);
+            if (symbol >= 0 && object->symbols[symbol].section >= 0 &&
+                object->sections[object->symbols[symbol].section].kind == OBJ_SECTION_TEXT) {
+                entry->address = (uint32_t)object->symbols[symbol].offset;
+            }
+        }
+        fprintf(stdout, "ELF: '%s' yazıldı (%s/linux; %zu bayt kod, %zu/%d kaydedici makine kaydedicisinde, "
+                        "%zu IR komutu kalıplara katıldı, %zu bölge yeniden sıralandı, %zu yeniden konumlandırma).\n",
+                args.output_path, is_aarch64 ? "aarch64" : is_riscv ? "riscv64" : "amd64", stats.code_size, stats.num_machine_registers,
+                IR_NUM_REGISTERS, stats.num_folded_instrs, stats.num_scheduled_regions, stats.num_relocations);
+    }
+
+    // JIT nesne dosyası ve bağlayıcı olmadan optimize edilmiş IR'den derler
+    if (args.run == RUN_JIT) {
+        jit = jit_compile(ir);
+        if (!jit) goto cleanup;
+        if (profile) {
+            jit->profile_dump = write_profile_counters;
+            jit->profile_user = profile;
+        }
+        if (jit_run(jit) != JIT_STATUS_HALTED) goto cleanup;
+        if (!finish_profile(profile, jit->context.counters, jit->num_counters)) goto cleanup;
+        fprintf(stdout, "JIT: Program %lld çıkış koduyla sonlandı.\n", (long long)jit->exit_code);
+        exit_code = (int)(jit->exit_code & 0xff);
+        goto cleanup;
+    }
+    if (args.run == RUN_TIERED) {
+        tiered = tiered_create(ir, bytecode, (uint64_t)args.osr_threshold);
+        if (!tiered) goto cleanup;
+        if (profile) {
+            tiered->vm->profile_dump = write_profile_counters;
+            tiered->vm->profile_user = profile;
+        }
+        if (!tiered_run(tiered)) goto cleanup;
+        if (!(tiered->osr_header ? finish_profile(profile, tiered->jit->context.counters, tiered->jit->num_counters)
+                                 : finish_profile(profile, tiered->vm->counters, tiered->vm->num_counters))) {
+            goto cleanup;
+        }
+        if (tiered->osr_header) {
+            fprintf(stdout, "TIER: '%s' döngüsünde %llu girişten sonra makine koduna geçildi (çağrı derinliği %zu).\n",
+                    ir_label_name(ir, &ir->labels[tiered->osr_header->label]),
+                    (unsigned long long)tiered->osr_count, tiered->osr_depth);
+        }
+        fprintf(stdout, "TIER: Program %lld çıkış koduyla sonlandı.\n", (long long)tiered->exit_code);
+        exit_code = (int)(tiered->exit_code & 0xff);
+        goto cleanup;
+    }
+
+execute:
+    // 6. BVM'de yürütme
+    if (args.run == RUN_BVM) {
+        if (args.superinstructions_path) {
+            superinstructions = bvm_superinstructions_load(args.superinstructions_path);
+            if (!superinstructions) goto cleanup;
+        }
+        vm = bvm_create(bytecode, superinstructions);
+        if (!vm) goto cleanup;
+        // Profil birleştirilmemiş komutlar üzerinden toplanır
+        if (args.dispatch_profile_path && !bvm_enable_dispatch_profile(vm)) goto cleanup;
+        if (profile) {
+            vm->profile_dump = write_profile_counters;
+            vm->profile_user = profile;
+        }
+        if (bvm_run(vm) != BVM_STATUS_HALTED) goto cleanup;
+        if (!finish_profile(profile, vm->counters, vm->num_counters)) goto cleanup;
+        fprintf(stdout, "BVM: Program %lld çıkış koduyla sonlandı.\n", (long long)vm->exit_code);
+        if (args.dispatch_profile_path) {
+            if (!bvm_write_dispatch_profile(vm, args.dispatch_profile_path)) goto cleanup;
+            fprintf(stdout, "BVM: Gönderim profili '%s' dosyasına yazıldı.\n", args.dispatch_profile_path);
+        }
+        exit_code = (int)(vm->exit_code & 0xff);
+        goto cleanup;
+    }
+
+    exit_code = 0;
+
+cleanup:
+    object_file_free(object);
+    tiered_free(tiered);
+    jit_free(jit);
+    bvm_free(vm);
+    bvm_superinstructions_free(superinstructions);
+    vbsm_module_free(bytecode);
+    ir_function_free(ir);
+    optimizer_close(optimizer);
+    semantic_analyzer_close(analyzer);
+    ast_node_free(ast_root);
+    parser_close(parser);
+    lexer_close(lexer);
+    return exit_code;
+}
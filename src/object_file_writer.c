@@ -1 +1,625 @@
-
+#include "object_file_writer.h"
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // FILE, fopen, fwrite, fprintf
+#include <string.h> // strcmp, strdup, strlen, memcpy, memset
+
+// --- Dahili Yardımcı Fonksiyonlar ---
+
+/**
+ * @brief Sembol adının özetini hesaplar (64-bit FNV-1a).
+ */
+static uint64_t symbol_name_hash(const char* name) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Sembol özet tablosunu verilen boyutla yeniden oluşturur.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int rebuild_symbol_index(ObjectFile* obj, size_t new_size) {
+    int* index = (int*)malloc(sizeof(int) * new_size);
+    if (!index) return 0;
+    for (size_t i = 0; i < new_size; i++) index[i] = -1;
+    for (size_t s = 0; s < obj->num_symbols; s++) {
+        size_t slot = (size_t)symbol_name_hash(obj->symbols[s].name) & (new_size - 1);
+        while (index[slot] >= 0) slot = (slot + 1) & (new_size - 1);
+        index[slot] = (int)s;
+    }
+    free(obj->symbol_index);
+    obj->symbol_index = index;
+    obj->symbol_index_size = new_size;
+    return 1;
+}
+
+/**
+ * @brief Sembolü adıyla arar.
+ * @return Sembol indeksi veya bulunamazsa -1.
+ */
+static int lookup_symbol(const ObjectFile* obj, const char* name) {
+    if (obj->symbol_index_size == 0) return -1;
+    size_t slot = (size_t)symbol_name_hash(name) & (obj->symbol_index_size - 1);
+    while (obj->symbol_index[slot] >= 0) {
+        if (strcmp(obj->symbols[obj->symbol_index[slot]].name, name) == 0) return obj->symbol_index[slot];
+        slot = (slot + 1) & (obj->symbol_index_size - 1);
+    }
+    return -1;
+}
+
+static int is_power_of_two(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// --- Harici Fonksiyon Gerçeklemeleri ---
+
+ObjectFile* object_file_create(TargetArchitecture arch) {
+    ObjectFile* obj = (ObjectFile*)calloc(1, sizeof(ObjectFile));
+    if (!obj) {
+        fprintf(stderr, "Hata: Nesne dosyası için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    obj->arch = arch;
+    obj->flags = 0;
+    return obj;
+}
+
+void object_file_free(ObjectFile* obj) {
+    if (obj) {
+        for (size_t s = 0; s < obj->num_sections; s++) {
+            free(obj->sections[s].name);
+            free(obj->sections[s].data);
+        }
+        for (size_t s = 0; s < obj->num_symbols; s++) {
+            free(obj->symbols[s].name);
+        }
+        free(obj->sections);
+        free(obj->symbols);
+        free(obj->symbol_index);
+        free(obj->relocations);
+        free(obj);
+    }
+}
+
+int object_file_add_section(ObjectFile* obj, const char* name, ObjectSectionKind kind, uint32_t alignment) {
+    if (!obj || !name || !is_power_of_two(alignment)) {
+        fprintf(stderr, "Hata: Geçersiz bölüm tanımı.\n");
+        return -1;
+    }
+    if (object_file_find_section(obj, name) >= 0) {
+        fprintf(stderr, "Hata: '%s' bölümü zaten mevcut.\n", name);
+        return -1;
+    }
+    if (obj->num_sections >= obj->section_capacity) {
+        size_t new_capacity = obj->section_capacity ? obj->section_capacity * 2 : 4;
+        ObjectSection* sections = (ObjectSection*)realloc(obj->sections, sizeof(ObjectSection) * new_capacity);
+        if (!sections) {
+            fprintf(stderr, "Hata: Bölüm listesi için bellek tahsis edilemedi.\n");
+            return -1;
+        }
+        obj->sections = sections;
+        obj->section_capacity = new_capacity;
+    }
+    ObjectSection* section = &obj->sections[obj->num_sections];
+    memset(section, 0, sizeof(ObjectSection));
+    section->name = strdup(name);
+    if (!section->name) {
+        fprintf(stderr, "Hata: Bölüm adı için bellek tahsis edilemedi.\n");
+        return -1;
+    }
+    section->kind = kind;
+    section->alignment = alignment;
+    return (int)obj->num_sections++;
+}
+
+int object_file_find_section(const ObjectFile* obj, const char* name) {
+    for (size_t s = 0; s < obj->num_sections; s++) {
+        if (strcmp(obj->sections[s].name, name) == 0) return (int)s;
+    }
+    return -1;
+}
+
+int object_file_append(ObjectFile* obj, int section_index, const void* bytes, size_t size) {
+    if (section_index < 0 || (size_t)section_index >= obj->num_sections) {
+        fprintf(stderr, "Hata: Geçersiz bölüm indeksi: %d\n", section_index);
+        return 0;
+    }
+    ObjectSection* section = &obj->sections[section_index];
+    if (section->kind == OBJ_SECTION_BSS) {
+        section->size += size;
+        return 1;
+    }
+    if (section->size + size > section->capacity) {
+        size_t new_capacity = section->capacity ? section->capacity : 64;
+        while (new_capacity < section->size + size) new_capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(section->data, new_capacity);
+        if (!data) {
+            fprintf(stderr, "Hata: '%s' bölümü için bellek tahsis edilemedi.\n", section->name);
+            return 0;
+        }
+        section->data = data;
+        section->capacity = new_capacity;
+    }
+    if (bytes) memcpy(section->data + section->size, bytes, size);
+    else memset(section->data + section->size, 0, size);
+    section->size += size;
+    return 1;
+}
+
+int object_file_align(ObjectFile* obj, int section_index, uint32_t alignment) {
+    if (!is_power_of_two(alignment) || section_index < 0 || (size_t)section_index >= obj->num_sections) {
+        fprintf(stderr, "Hata: Geçersiz hizalama isteği.\n");
+        return 0;
+    }
+    ObjectSection* section = &obj->sections[section_index];
+    if (alignment > section->alignment) section->alignment = alignment;
+    size_t padding = (alignment - (section->size & (alignment - 1))) & (alignment - 1);
+    return padding == 0 || object_file_append(obj, section_index, NULL, padding);
+}
+
+int object_file_symbol(ObjectFile* obj, const char* name) {
+    int existing = lookup_symbol(obj, name);
+    if (existing >= 0) return existing;
+
+    if (obj->num_symbols >= obj->symbol_capacity) {
+        size_t new_capacity = obj->symbol_capacity ? obj->symbol_capacity * 2 : 32;
+        ObjectSymbol* symbols = (ObjectSymbol*)realloc(obj->symbols, sizeof(ObjectSymbol) * new_capacity);
+        if (!symbols) {
+            fprintf(stderr, "Hata: Sembol listesi için bellek tahsis edilemedi.\n");
+            return -1;
+        }
+        obj->symbols = symbols;
+        obj->symbol_capacity = new_capacity;
+    }
+    // Özet tablosu en fazla yarı dolu tutulur
+    if ((obj->num_symbols + 1) * 2 > obj->symbol_index_size &&
+        !rebuild_symbol_index(obj, obj->symbol_index_size ? obj->symbol_index_size * 2 : 64)) {
+        fprintf(stderr, "Hata: Sembol tablosu için bellek tahsis edilemedi.\n");
+        return -1;
+    }
+
+    ObjectSymbol* symbol = &obj->symbols[obj->num_symbols];
+    memset(symbol, 0, sizeof(ObjectSymbol));
+    symbol->name = strdup(name);
+    if (!symbol->name) {
+        fprintf(stderr, "Hata: Sembol adı için bellek tahsis edilemedi.\n");
+        return -1;
+    }
+    symbol->section = OBJ_SECTION_UNDEFINED;
+    symbol->binding = OBJ_SYMBOL_LOCAL;
+    symbol->type = OBJ_SYMBOL_NOTYPE;
+
+    size_t slot = (size_t)symbol_name_hash(name) & (obj->symbol_index_size - 1);
+    while (obj->symbol_index[slot] >= 0) slot = (slot + 1) & (obj->symbol_index_size - 1);
+    obj->symbol_index[slot] = (int)obj->num_symbols;
+    return (int)obj->num_symbols++;
+}
+
+int object_file_find_symbol(const ObjectFile* obj, const char* name) {
+    return lookup_symbol(obj, name);
+}
+
+int object_file_define_symbol(ObjectFile* obj, const char* name, int section, uint64_t offset,
+                              ObjectSymbolBinding binding, ObjectSymbolType type) {
+    if (section != OBJ_SECTION_UNDEFINED && (section < 0 || (size_t)section >= obj->num_sections)) {
+        fprintf(stderr, "Hata: '%s' sembolü için geçersiz bölüm indeksi: %d\n", name, section);
+        return -1;
+    }
+    if (section == OBJ_SECTION_UNDEFINED && binding != OBJ_SYMBOL_GLOBAL) {
+        fprintf(stderr, "Hata: Dış sembol '%s' global olmalı.\n", name);
+        return -1;
+    }
+    int index = object_file_symbol(obj, name);
+    if (index < 0) return -1;
+    ObjectSymbol* symbol = &obj->symbols[index];
+    if (symbol->declared && symbol->section != OBJ_SECTION_UNDEFINED) {
+        fprintf(stderr, "Hata: '%s' sembolü birden fazla kez tanımlandı.\n", name);
+        return -1;
+    }
+    symbol->section = section;
+    symbol->offset = offset;
+    symbol->binding = binding;
+    symbol->type = type;
+    symbol->declared = 1;
+    return index;
+}
+
+int object_file_add_relocation(ObjectFile* obj, int section, uint64_t offset, const char* symbol_name,
+                               RelocationKind kind, int64_t addend) {
+    size_t width = kind == RELOC_ABS64 ? 8 : 4;
+    if (section < 0 || (size_t)section >= obj->num_sections || obj->sections[section].kind == OBJ_SECTION_BSS ||
+        offset + width > obj->sections[section].size) {
+        fprintf(stderr, "Hata: '%s' için yeniden konumlandırma bölüm sınırları dışında.\n", symbol_name);
+        return 0;
+    }
+    int symbol = object_file_symbol(obj, symbol_name);
+    if (symbol < 0) return 0;
+
+    if (obj->num_relocations >= obj->relocation_capacity) {
+        size_t new_capacity = obj->relocation_capacity ? obj->relocation_capacity * 2 : 32;
+        Relocation* relocations = (Relocation*)realloc(obj->relocations, sizeof(Relocation) * new_capacity);
+        if (!relocations) {
+            fprintf(stderr, "Hata: Yeniden konumlandırma listesi için bellek tahsis edilemedi.\n");
+            return 0;
+        }
+        obj->relocations = relocations;
+        obj->relocation_capacity = new_capacity;
+    }
+    Relocation* relocation = &obj->relocations[obj->num_relocations++];
+    relocation->section = section;
+    relocation->offset = offset;
+    relocation->symbol = symbol;
+    relocation->kind = kind;
+    relocation->addend = addend;
+    return 1;
+}
+
+int object_file_emit_jump_table(ObjectFile* obj, const char* table_symbol, const char* const* targets,
+                                size_t num_targets, JumpTableEncoding encoding) {
+    int rodata = object_file_find_section(obj, ".rodata");
+    if (rodata < 0) rodata = object_file_add_section(obj, ".rodata", OBJ_SECTION_RODATA, 8);
+    if (rodata < 0) return 0;
+
+    uint32_t entry_size = encoding == JUMP_TABLE_ABS64 ? 8 : 4;
+    if (!object_file_align(obj, rodata, entry_size)) return 0;
+    uint64_t table_offset = obj->sections[rodata].size;
+    int symbol = object_file_define_symbol(obj, table_symbol, rodata, table_offset, OBJ_SYMBOL_LOCAL,
+                                           OBJ_SYMBOL_OBJECT);
+    if (symbol < 0 || !object_file_append(obj, rodata, NULL, entry_size * num_targets)) return 0;
+    obj->symbols[symbol].size = entry_size * num_targets;
+
+    for (size_t i = 0; i < num_targets; i++) {
+        uint64_t entry_offset = table_offset + i * entry_size;
+        int ok;
+        if (encoding == JUMP_TABLE_ABS64) {
+            ok = object_file_add_relocation(obj, rodata, entry_offset, targets[i], RELOC_ABS64, 0);
+        } else {
+            // hedef + (P - tablo başı) - P = hedef - tablo başı
+            ok = object_file_add_relocation(obj, rodata, entry_offset, targets[i], RELOC_PC32,
+                                            (int64_t)(i * entry_size));
+        }
+        if (!ok) return 0;
+    }
+    return 1;
+}
+
+// --- ELF64 Yazıcı ---
+
+// ELF sabitleri (sistem başlıklarına bağımlı olmamak için burada tanımlanır)
+#define ELF_HEADER_SIZE 64
+#define ELF_SECTION_HEADER_SIZE 64
+#define ELF_SYMBOL_SIZE 24
+#define ELF_RELA_SIZE 24
+#define ELF_ET_REL 1
+#define ELF_SHT_PROGBITS 1
+#define ELF_SHT_SYMTAB 2
+#define ELF_SHT_STRTAB 3
+#define ELF_SHT_RELA 4
+#define ELF_SHT_NOBITS 8
+#define ELF_SHF_WRITE 0x1
+#define ELF_SHF_ALLOC 0x2
+#define ELF_SHF_EXECINSTR 0x4
+#define ELF_SHF_INFO_LINK 0x40
+#define ELF_STB_LOCAL 0
+#define ELF_STB_GLOBAL 1
+#define ELF_STT_NOTYPE 0
+#define ELF_STT_OBJECT 1
+#define ELF_STT_FUNC 2
+
+// Mimariye göre ELF makine türü ve yeniden konumlandırma türleri
+typedef struct {
+    uint16_t machine;
+    uint32_t reloc_abs64;
+    uint32_t reloc_abs32;
+    uint32_t reloc_pc32;
+} ElfArchInfo;
+
+/**
+ * @brief Mimarinin ELF64 bilgilerini döndürür.
+ * @return Desteklenen mimari ise 1, aksi takdirde 0.
+ */
+static int elf_arch_info(TargetArchitecture arch, ElfArchInfo* info) {
+    switch (arch) {
+        case ARCH_AMD64:
+            *info = (ElfArchInfo){62, 1, 10, 2};        // EM_X86_64: R_X86_64_64, _32, _PC32
+            return 1;
+        case ARCH_ARMV8:
+        case ARCH_ARMV9:
+            *info = (ElfArchInfo){183, 257, 258, 261};  // EM_AARCH64: ABS64, ABS32, PREL32
+            return 1;
+        case ARCH_RV64I:
+        case ARCH_RV64E:
+            *info = (ElfArchInfo){243, 2, 1, 57};       // EM_RISCV: R_RISCV_64, _32, _32_PCREL
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Yeniden konumlandırma türünü mimarinin ELF türüne çevirir.
+ * @return ELF türü veya tür bu mimaride geçerli değilse 0.
+ */
+static uint32_t elf_relocation_type(const ElfArchInfo* info, RelocationKind kind) {
+    switch (kind) {
+        case RELOC_ABS64: return info->reloc_abs64;
+        case RELOC_ABS32: return info->reloc_abs32;
+        case RELOC_PC32: return info->reloc_pc32;
+        case RELOC_AARCH64_ADR_PAGE21: return info->machine == 183 ? 275 : 0; // R_AARCH64_ADR_PREL_PG_HI21
+        case RELOC_AARCH64_ADD_LO12: return info->machine == 183 ? 277 : 0;   // R_AARCH64_ADD_ABS_LO12_NC
+        case RELOC_AARCH64_CALL26: return info->machine == 183 ? 283 : 0;     // R_AARCH64_CALL26
+        case RELOC_RISCV_PCREL_HI20: return info->machine == 243 ? 23 : 0;   // R_RISCV_PCREL_HI20
+        case RELOC_RISCV_PCREL_LO12_I: return info->machine == 243 ? 24 : 0; // R_RISCV_PCREL_LO12_I
+        case RELOC_RISCV_CALL_PLT: return info->machine == 243 ? 19 : 0;     // R_RISCV_CALL_PLT
+        default: return 0;
+    }
+}
+
+// Küçük-sonlu (little-endian) bayt arabelleği; ELF dosyası bellekte oluşturulup tek seferde yazılır
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int failed;
+} ElfBuffer;
+
+static void elf_put(ElfBuffer* buffer, const void* bytes, size_t size) {
+    if (buffer->failed) return;
+    if (buffer->size + size > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity : 1024;
+        while (new_capacity < buffer->size + size) new_capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, new_capacity);
+        if (!data) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = new_capacity;
+    }
+    if (bytes) memcpy(buffer->data + buffer->size, bytes, size);
+    else memset(buffer->data + buffer->size, 0, size);
+    buffer->size += size;
+}
+
+static void elf_put_uint(ElfBuffer* buffer, uint64_t value, size_t width) {
+    uint8_t bytes[8];
+    for (size_t i = 0; i < width; i++) bytes[i] = (uint8_t)(value >> (8 * i));
+    elf_put(buffer, bytes, width);
+}
+
+static void elf_align(ElfBuffer* buffer, size_t alignment) {
+    while (!buffer->failed && (buffer->size & (alignment - 1)) != 0) elf_put(buffer, NULL, 1);
+}
+
+/**
+ * @brief Dize tablosuna (strtab/shstrtab) bir ad ekler.
+ * @return Adın tablodaki konumu.
+ */
+static uint32_t elf_add_string(ElfBuffer* table, const char* name) {
+    uint32_t offset = (uint32_t)table->size;
+    elf_put(table, name, strlen(name) + 1);
+    return offset;
+}
+
+static void elf_put_section_header(ElfBuffer* out, uint32_t name, uint32_t type, uint64_t flags, uint64_t offset,
+                                   uint64_t size, uint32_t link, uint32_t info, uint64_t alignment,
+                                   uint64_t entry_size) {
+    elf_put_uint(out, name, 4);
+    elf_put_uint(out, type, 4);
+    elf_put_uint(out, flags, 8);
+    elf_put_uint(out, 0, 8); // sh_addr: ilişkilendirilebilir dosyada 0
+    elf_put_uint(out, offset, 8);
+    elf_put_uint(out, size, 8);
+    elf_put_uint(out, link, 4);
+    elf_put_uint(out, info, 4);
+    elf_put_uint(out, alignment, 8);
+    elf_put_uint(out, entry_size, 8);
+}
+
+int object_file_write_elf(const ObjectFile* obj, const char* path) {
+    ElfArchInfo arch;
+    if (!elf_arch_info(obj->arch, &arch)) {
+        fprintf(stderr, "Hata: '%s' mimarisi için ELF64 nesne dosyası üretilemiyor.\n",
+                target_arch_to_string(obj->arch));
+        return 0;
+    }
+    for (size_t r = 0; r < obj->num_relocations; r++) {
+        if (elf_relocation_type(&arch, obj->relocations[r].kind) == 0) {
+            fprintf(stderr, "Hata: '%s' mimarisinde geçersiz yeniden konumlandırma türü (%d).\n",
+                    target_arch_to_string(obj->arch), (int)obj->relocations[r].kind);
+            return 0;
+        }
+    }
+
+    // Bölüm başlığı düzeni: 0 boş, 1..k kullanıcı bölümleri, .note.GNU-stack, .rela.* (yeniden
+    // konumlandırması olan her bölüm için), .symtab, .strtab, .shstrtab
+    size_t k = obj->num_sections;
+    size_t* rela_count = (size_t*)calloc(k ? k : 1, sizeof(size_t));
+    uint32_t* elf_symbol = (uint32_t*)malloc(sizeof(uint32_t) * (obj->num_symbols ? obj->num_symbols : 1));
+    if (!rela_count || !elf_symbol) {
+        fprintf(stderr, "Hata: ELF yazıcısı için bellek tahsis edilemedi.\n");
+        free(rela_count); free(elf_symbol);
+        return 0;
+    }
+    for (size_t r = 0; r < obj->num_relocations; r++) rela_count[obj->relocations[r].section]++;
+    size_t num_rela_sections = 0;
+    for (size_t s = 0; s < k; s++) num_rela_sections += rela_count[s] > 0;
+    uint32_t note_index = (uint32_t)k + 1;
+    uint32_t symtab_index = note_index + 1 + (uint32_t)num_rela_sections;
+    uint32_t strtab_index = symtab_index + 1;
+    uint32_t shstrtab_index = strtab_index + 1;
+    uint32_t num_headers = shstrtab_index + 1;
+
+    // 1. Sembol tablosu: ELF yerel sembollerin globallerden önce gelmesini ister
+    ElfBuffer symtab = {NULL, 0, 0, 0};
+    ElfBuffer strtab = {NULL, 0, 0, 0};
+    elf_put(&strtab, "", 1);
+    elf_put(&symtab, NULL, ELF_SYMBOL_SIZE); // 0: boş sembol
+    uint32_t next_symbol = 1;
+    uint32_t first_global = 0;
+    int ok = 1;
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        ObjectSymbolBinding binding = pass == 0 ? OBJ_SYMBOL_LOCAL : OBJ_SYMBOL_GLOBAL;
+        if (pass == 1) first_global = next_symbol;
+        for (size_t s = 0; s < obj->num_symbols; s++) {
+            const ObjectSymbol* symbol = &obj->symbols[s];
+            if (symbol->binding != binding) continue;
+            if (symbol->section == OBJ_SECTION_UNDEFINED && binding == OBJ_SYMBOL_LOCAL) {
+                fprintf(stderr, "Hata: '%s' sembolüne başvuruldu ama tanımlanmadı.\n", symbol->name);
+                ok = 0;
+                break;
+            }
+            uint8_t type = symbol->type == OBJ_SYMBOL_FUNCTION ? ELF_STT_FUNC
+                         : symbol->type == OBJ_SYMBOL_OBJECT ? ELF_STT_OBJECT : ELF_STT_NOTYPE;
+            uint8_t bind = binding == OBJ_SYMBOL_LOCAL ? ELF_STB_LOCAL : ELF_STB_GLOBAL;
+            elf_put_uint(&symtab, elf_add_string(&strtab, symbol->name), 4);
+            elf_put_uint(&symtab, (uint64_t)((bind << 4) | type), 1);
+            elf_put_uint(&symtab, 0, 1); // st_other: varsayılan görünürlük
+            elf_put_uint(&symtab, symbol->section == OBJ_SECTION_UNDEFINED ? 0 : (uint64_t)symbol->section + 1, 2);
+            elf_put_uint(&symtab, symbol->offset, 8);
+            elf_put_uint(&symtab, symbol->size, 8);
+            elf_symbol[s] = next_symbol++;
+        }
+    }
+
+    // 2. Dosya içeriği: başlık, bölüm verileri, RELA tabloları, sembol/dize tabloları, bölüm başlıkları
+    ElfBuffer out = {NULL, 0, 0, 0};
+    ElfBuffer shstrtab = {NULL, 0, 0, 0};
+    uint64_t* section_offset = (uint64_t*)calloc(num_headers, sizeof(uint64_t));
+    uint32_t* section_name = (uint32_t*)calloc(num_headers, sizeof(uint32_t));
+    if (!section_offset || !section_name) ok = 0;
+    elf_put(&shstrtab, "", 1);
+    elf_put(&out, NULL, ELF_HEADER_SIZE); // Başlık en sonda doldurulur
+
+    for (size_t s = 0; ok && s < k; s++) {
+        const ObjectSection* section = &obj->sections[s];
+        section_name[s + 1] = elf_add_string(&shstrtab, section->name);
+        elf_align(&out, section->alignment);
+        section_offset[s + 1] = out.size;
+        if (section->kind != OBJ_SECTION_BSS) elf_put(&out, section->data, section->size);
+    }
+    if (ok) {
+        section_name[note_index] = elf_add_string(&shstrtab, ".note.GNU-stack"); // Çalıştırılamaz yığın
+        section_offset[note_index] = out.size;
+    }
+
+    uint32_t rela_index = note_index + 1;
+    for (size_t s = 0; ok && s < k; s++) {
+        if (rela_count[s] == 0) continue;
+        char rela_name[256];
+        snprintf(rela_name, sizeof(rela_name), ".rela%s", obj->sections[s].name);
+        section_name[rela_index] = elf_add_string(&shstrtab, rela_name);
+        elf_align(&out, 8);
+        section_offset[rela_index] = out.size;
+        for (size_t r = 0; r < obj->num_relocations; r++) {
+            const Relocation* relocation = &obj->relocations[r];
+            if (relocation->section != (int)s) continue;
+            uint32_t type = elf_relocation_type(&arch, relocation->kind);
+            elf_put_uint(&out, relocation->offset, 8);
+            elf_put_uint(&out, ((uint64_t)elf_symbol[relocation->symbol] << 32) | type, 8);
+            elf_put_uint(&out, (uint64_t)relocation->addend, 8);
+        }
+        rela_index++;
+    }
+
+    if (ok) {
+        section_name[symtab_index] = elf_add_string(&shstrtab, ".symtab");
+        section_name[strtab_index] = elf_add_string(&shstrtab, ".strtab");
+        section_name[shstrtab_index] = elf_add_string(&shstrtab, ".shstrtab");
+        elf_align(&out, 8);
+        section_offset[symtab_index] = out.size;
+        elf_put(&out, symtab.data, symtab.size);
+        section_offset[strtab_index] = out.size;
+        elf_put(&out, strtab.data, strtab.size);
+        section_offset[shstrtab_index] = out.size;
+        elf_put(&out, shstrtab.data, shstrtab.size);
+    }
+
+    uint64_t header_offset = 0;
+    if (ok) {
+        elf_align(&out, 8);
+        header_offset = out.size;
+        elf_put(&out, NULL, ELF_SECTION_HEADER_SIZE); // 0: boş bölüm
+        for (size_t s = 0; s < k; s++) {
+            const ObjectSection* section = &obj->sections[s];
+            uint64_t flags = ELF_SHF_ALLOC;
+            if (section->kind == OBJ_SECTION_TEXT) flags |= ELF_SHF_EXECINSTR;
+            if (section->kind == OBJ_SECTION_DATA || section->kind == OBJ_SECTION_BSS) flags |= ELF_SHF_WRITE;
+            elf_put_section_header(&out, section_name[s + 1],
+                                   section->kind == OBJ_SECTION_BSS ? ELF_SHT_NOBITS : ELF_SHT_PROGBITS, flags,
+                                   section_offset[s + 1], section->size, 0, 0, section->alignment, 0);
+        }
+        elf_put_section_header(&out, section_name[note_index], ELF_SHT_PROGBITS, 0, section_offset[note_index],
+                               0, 0, 0, 1, 0);
+        rela_index = note_index + 1;
+        for (size_t s = 0; s < k; s++) {
+            if (rela_count[s] == 0) continue;
+            elf_put_section_header(&out, section_name[rela_index], ELF_SHT_RELA, ELF_SHF_INFO_LINK,
+                                   section_offset[rela_index], rela_count[s] * ELF_RELA_SIZE, symtab_index,
+                                   (uint32_t)s + 1, 8, ELF_RELA_SIZE);
+            rela_index++;
+        }
+        elf_put_section_header(&out, section_name[symtab_index], ELF_SHT_SYMTAB, 0, section_offset[symtab_index],
+                               symtab.size, strtab_index, first_global, 8, ELF_SYMBOL_SIZE);
+        elf_put_section_header(&out, section_name[strtab_index], ELF_SHT_STRTAB, 0, section_offset[strtab_index],
+                               strtab.size, 0, 0, 1, 0);
+        elf_put_section_header(&out, section_name[shstrtab_index], ELF_SHT_STRTAB, 0,
+                               section_offset[shstrtab_index], shstrtab.size, 0, 0, 1, 0);
+    }
+
+    if (ok && (out.failed || symtab.failed || strtab.failed || shstrtab.failed)) {
+        fprintf(stderr, "Hata: ELF dosyası için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+
+    // 3. ELF başlığını doldur ve dosyayı yaz
+    if (ok) {
+        ElfBuffer header = {NULL, 0, 0, 0};
+        static const uint8_t ident[16] = {0x7f, 'E', 'L', 'F', 2 /* ELFCLASS64 */, 1 /* ELFDATA2LSB */,
+                                          1 /* EV_CURRENT */, 0 /* ELFOSABI_NONE */};
+        elf_put(&header, ident, sizeof(ident));
+        elf_put_uint(&header, ELF_ET_REL, 2);
+        elf_put_uint(&header, arch.machine, 2);
+        elf_put_uint(&header, 1, 4);            // e_version
+        elf_put_uint(&header, 0, 8);            // e_entry
+        elf_put_uint(&header, 0, 8);            // e_phoff
+        elf_put_uint(&header, header_offset, 8);
+        elf_put_uint(&header, obj->flags, 4);
+        elf_put_uint(&header, ELF_HEADER_SIZE, 2);
+        elf_put_uint(&header, 0, 2);            // e_phentsize
+        elf_put_uint(&header, 0, 2);            // e_phnum
+        elf_put_uint(&header, ELF_SECTION_HEADER_SIZE, 2);
+        elf_put_uint(&header, num_headers, 2);
+        elf_put_uint(&header, shstrtab_index, 2);
+        if (header.failed) {
+            ok = 0;
+        } else {
+            memcpy(out.data, header.data, ELF_HEADER_SIZE);
+        }
+        free(header.data);
+    }
+
+    if (ok) {
+        FILE* file = fopen(path, "wb");
+        if (!file) {
+            fprintf(stderr, "Hata: '%s' nesne dosyası yazmak için açılamadı.\n", path);
+            ok = 0;
+        } else {
+            ok = fwrite(out.data, 1, out.size, file) == out.size;
+            if (fclose(file) != 0) ok = 0;
+            if (!ok) fprintf(stderr, "Hata: '%s' nesne dosyasına yazılamadı.\n", path);
+        }
+    }
+
+    free(out.data); free(symtab.data); free(strtab.data); free(shstrtab.data);
+    free(section_offset); free(section_name); free(rela_count); free(elf_symbol);
+    return ok;
+}
+
+int object_file_has_extension(const char* path) {
+    size_t length = path ? strlen(path) : 0;
+    return length > 2 && strcmp(path + length - 2, ".o") == 0;
+}
@@ -1 +1,247 @@
-
+#ifndef OBJECT_FILE_WRITER_H
+#define OBJECT_FILE_WRITER_H
+
+#include "os/target.h" // Hedef mimari (ELF makine türü ve yeniden konumlandırma türleri)
+#include <stdint.h> // uint8_t, uint64_t için
+#include <stddef.h> // size_t için
+
+// --- Nesne Dosyası Modeli ---
+// Kod üreticiler makine kodunu ve verileri bölümlere (section) yazar, etiketleri sembol
+// olarak tanımlar ve adresi bağlama (link) zamanında belli olacak başvurular için
+// yeniden konumlandırma (relocation) kayıtları ekler. Model çıktı biçiminden bağımsızdır;
+// object_file_write_elf ilişkilendirilebilir (ET_REL) ELF64 dosyası üretir.
+// Semboller tanımlanmadan önce de başvurulabilir (ileri atlamalar, atlama tabloları).
+
+// --- Bölüm Türleri ---
+typedef enum {
+    OBJ_SECTION_TEXT,       // Çalıştırılabilir kod (.text)
+    OBJ_SECTION_RODATA,     // Salt okunur veri (.rodata; atlama tabloları)
+    OBJ_SECTION_DATA,       // Yazılabilir veri (.data)
+    OBJ_SECTION_BSS         // Sıfırla başlatılan veri (.bss; dosyada yer kaplamaz)
+} ObjectSectionKind;
+
+// --- Bölüm ---
+typedef struct {
+    char* name;             // Bölüm adı (örn: ".text")
+    ObjectSectionKind kind; // Bölümün türü
+    uint8_t* data;          // Bölüm içeriği (BSS için NULL)
+    size_t size;            // İçerik boyutu (bayt)
+    size_t capacity;        // Ayrılmış kapasite
+    uint32_t alignment;     // Bölümün hizalaması (2'nin kuvveti)
+} ObjectSection;
+
+// --- Semboller ---
+#define OBJ_SECTION_UNDEFINED (-1) // Sembol bu dosyada tanımlı değil (dış sembol)
+
+typedef enum {
+    OBJ_SYMBOL_LOCAL,       // Sadece bu nesne dosyasında görünür (etiketler, tablolar)
+    OBJ_SYMBOL_GLOBAL       // Diğer nesne dosyalarına açık veya dışarıdan gelen
+} ObjectSymbolBinding;
+
+typedef enum {
+    OBJ_SYMBOL_NOTYPE,      // Türsüz (kod etiketleri)
+    OBJ_SYMBOL_FUNCTION,    // Fonksiyon / alt program girişi
+    OBJ_SYMBOL_OBJECT       // Veri nesnesi (örn: atlama tablosu)
+} ObjectSymbolType;
+
+typedef struct {
+    char* name;                 // Sembol adı
+    int section;                // Tanımlandığı bölüm veya OBJ_SECTION_UNDEFINED
+    uint64_t offset;            // Bölüm içindeki konum
+    uint64_t size;              // Sembolün boyutu (bilinmiyorsa 0)
+    ObjectSymbolBinding binding;
+    ObjectSymbolType type;
+    int declared;               // Tanımlandı veya dış sembol olarak bildirildi mi?
+} ObjectSymbol;
+
+// --- Yeniden Konumlandırma (Relocation) ---
+// Türler biçimden bağımsızdır; yazıcı bunları hedef mimarinin ELF türlerine çevirir.
+// S: sembol adresi, A: ek değer (addend), P: düzeltilen baytların adresi.
+typedef enum {
+    RELOC_ABS64,            // S + A, 64-bit mutlak adres
+    RELOC_ABS32,            // S + A, 32-bit mutlak adres
+    RELOC_PC32,             // S + A - P, 32-bit işaretli PC göreli uzaklık
+    // Mimariye özgü komut alanları (sadece ilgili mimaride geçerli)
+    RELOC_AARCH64_ADR_PAGE21, // adrp: Page(S + A) - Page(P), Page(x) = x & ~0xfff
+    RELOC_AARCH64_ADD_LO12,   // add (sabitli): (S + A) & 0xfff
+    RELOC_AARCH64_CALL26,     // bl: (S + A - P) >> 2, 26 bit
+    RELOC_RISCV_PCREL_HI20,   // auipc: (S + A - P + 0x800) >> 12
+    RELOC_RISCV_PCREL_LO12_I, // addi: S, HI20 kaydı taşıyan auipc'yi gösteren etikettir
+    RELOC_RISCV_CALL_PLT      // auipc + jalr çifti: S + A - P
+} RelocationKind;
+
+typedef struct {
+    int section;            // Düzeltilecek baytların bulunduğu bölüm
+    uint64_t offset;        // Bölüm içindeki konum (P)
+    int symbol;             // Hedef sembolün indeksi (S)
+    RelocationKind kind;    // Yeniden konumlandırma türü
+    int64_t addend;         // Ek değer (A)
+} Relocation;
+
+// --- Atlama Tablosu Kodlamaları ---
+typedef enum {
+    JUMP_TABLE_ABS64,       // Her giriş 8 baytlık mutlak hedef adresi (konuma bağımlı kod)
+    JUMP_TABLE_REL32        // Her giriş 4 baytlık (hedef - tablo başı) uzaklığı (konumdan bağımsız kod)
+} JumpTableEncoding;
+
+// --- Kod Üretici Seçenekleri (arch/*: *_generate_object) ---
+// PGO enstrümantasyonu; program PROFCNT içermiyorsa kullanılmaz.
+typedef struct {
+    uint64_t profile_checksum;      // __bsm_prof_init'e aktarılan CFG özeti
+    uint64_t profile_num_counters;  // Sayaç sayısı (0 ise IR'deki en büyük sayaçtan hesaplanır)
+    const char* profile_path;       // .bsmprof yolu (NULL ise BSM_PROFILE_DEFAULT_PATH)
+} ObjectCodegenOptions;
+
+// --- Kod Üretici İstatistikleri ---
+typedef struct {
+    size_t code_size;               // .text boyutu (bayt)
+    size_t num_machine_registers;   // Makine kaydedicisine atanan Bessambly kaydedicileri
+    size_t num_relocations;         // Nesne dosyasındaki yeniden konumlandırma kayıtları
+    size_t num_folded_instrs;       // Komut seçiminde başka bir komutun kalıbına katılan IR komutları
+    size_t num_scheduled_regions;   // Kaydedici atamasından sonra yeniden sıralanan makine kodu bölgeleri
+} ObjectCodegenStats;
+
+// --- Nesne Dosyası ---
+typedef struct {
+    TargetArchitecture arch;    // Hedef mimari
+    uint32_t flags;             // Biçime özgü bayraklar (ELF e_flags, örn: RISC-V RVC)
+
+    ObjectSection* sections;
+    size_t num_sections;
+    size_t section_capacity;
+
+    ObjectSymbol* symbols;
+    size_t num_symbols;
+    size_t symbol_capacity;
+    int* symbol_index;          // Ada göre açık adresli özet tablosu (sembol indeksi, -1 = boş)
+    size_t symbol_index_size;   // Özet tablosunun boyutu (2'nin kuvveti)
+
+    Relocation* relocations;
+    size_t num_relocations;
+    size_t relocation_capacity;
+} ObjectFile;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Boş bir nesne dosyası oluşturur.
+ * @param arch Hedef mimari.
+ * @return Yeni ObjectFile pointer'ı veya NULL hata durumunda.
+ */
+ObjectFile* object_file_create(TargetArchitecture arch);
+
+/**
+ * @brief Nesne dosyasını ve tüm bölüm, sembol ve yeniden konumlandırma kayıtlarını serbest bırakır.
+ * @param obj Serbest bırakılacak ObjectFile pointer'ı.
+ */
+void object_file_free(ObjectFile* obj);
+
+/**
+ * @brief Yeni bir bölüm ekler.
+ * @param obj Nesne dosyası.
+ * @param name Bölüm adı (kopyalanır).
+ * @param kind Bölümün türü.
+ * @param alignment Bölümün hizalaması (2'nin kuvveti).
+ * @return Bölüm indeksi veya hata durumunda -1.
+ */
+int object_file_add_section(ObjectFile* obj, const char* name, ObjectSectionKind kind, uint32_t alignment);
+
+/**
+ * @brief Adı verilen bölümün indeksini bulur.
+ * @return Bölüm indeksi veya bulunamazsa -1.
+ */
+int object_file_find_section(const ObjectFile* obj, const char* name);
+
+/**
+ * @brief Bölümün sonuna bayt ekler (BSS için sadece boyut büyür).
+ * @param obj Nesne dosyası.
+ * @param section Bölüm indeksi.
+ * @param bytes Eklenecek baytlar (BSS için NULL olabilir).
+ * @param size Bayt sayısı.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int object_file_append(ObjectFile* obj, int section, const void* bytes, size_t size);
+
+/**
+ * @brief Bölümün sonunu sıfır baytlarla verilen hizalamaya tamamlar.
+ * Bölümün kendi hizalaması gerekiyorsa büyütülür.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int object_file_align(ObjectFile* obj, int section, uint32_t alignment);
+
+/**
+ * @brief Adı verilen sembolün indeksini döndürür; yoksa tanımsız bir sembol oluşturur.
+ * Bu sayede semboller tanımlanmadan önce başvurulabilir.
+ * @param obj Nesne dosyası.
+ * @param name Sembol adı (kopyalanır).
+ * @return Sembol indeksi veya bellek hatasında -1.
+ */
+int object_file_symbol(ObjectFile* obj, const char* name);
+
+/**
+ * @brief Adı verilen sembolü arar; object_file_symbol'ün aksine yoksa oluşturmaz.
+ * @param obj Nesne dosyası.
+ * @param name Sembol adı.
+ * @return Sembol indeksi veya bulunamazsa -1.
+ */
+int object_file_find_symbol(const ObjectFile* obj, const char* name);
+
+/**
+ * @brief Bir sembolü tanımlar veya dış sembol olarak bildirir.
+ * @param obj Nesne dosyası.
+ * @param name Sembol adı.
+ * @param section Tanımlandığı bölüm veya dış semboller için OBJ_SECTION_UNDEFINED.
+ * @param offset Bölüm içindeki konum.
+ * @param binding Görünürlük (dış semboller OBJ_SYMBOL_GLOBAL olmalı).
+ * @param type Sembol türü.
+ * @return Sembol indeksi veya hata durumunda (örn: iki kez tanımlama) -1.
+ */
+int object_file_define_symbol(ObjectFile* obj, const char* name, int section, uint64_t offset,
+                              ObjectSymbolBinding binding, ObjectSymbolType type);
+
+/**
+ * @brief Bir yeniden konumlandırma kaydı ekler.
+ * Düzeltilecek baytlar bölümde zaten bulunmalıdır (RELA biçiminde sıfır bırakılır).
+ * @param obj Nesne dosyası.
+ * @param section Düzeltilecek baytların bölümü.
+ * @param offset Bölüm içindeki konum.
+ * @param symbol_name Hedef sembol adı (henüz tanımlı olması gerekmez).
+ * @param kind Yeniden konumlandırma türü.
+ * @param addend Ek değer.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int object_file_add_relocation(ObjectFile* obj, int section, uint64_t offset, const char* symbol_name,
+                               RelocationKind kind, int64_t addend);
+
+/**
+ * @brief Bir atlama tablosunu .rodata bölümüne yazar (JTAB sözde komutunun veri kısmı).
+ * Tablo başı table_symbol olarak tanımlanır; her giriş için bir yeniden konumlandırma eklenir.
+ * REL32 girişleri (hedef - tablo başı) değerini taşır: kod üretici girişi tablo adresine
+ * ekleyerek hedefi bulur (örn: amd64 "movslq (T,i,4), r; add T, r; jmp *r").
+ * @param obj Nesne dosyası.
+ * @param table_symbol Tablonun sembol adı.
+ * @param targets Giriş sırasıyla hedef etiket adları.
+ * @param num_targets Giriş sayısı.
+ * @param encoding Giriş kodlaması.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int object_file_emit_jump_table(ObjectFile* obj, const char* table_symbol, const char* const* targets,
+                                size_t num_targets, JumpTableEncoding encoding);
+
+/**
+ * @brief Nesne dosyasını ilişkilendirilebilir ELF64 (ET_REL) olarak diske yazar.
+ * Desteklenen mimariler: amd64, ARMv8/ARMv9 (AArch64), RV64I/RV64E.
+ * @param obj Yazılacak nesne dosyası.
+ * @param path Çıktı dosyasının yolu.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int object_file_write_elf(const ObjectFile* obj, const char* path);
+
+/**
+ * @brief Bir dosya yolunun nesne dosyası olup olmadığını uzantısından belirler.
+ * @param path Dosya yolu.
+ * @return ".o" ile bitiyorsa 1, aksi takdirde 0.
+ */
+int object_file_has_extension(const char* path);
+
+#endif // OBJECT_FILE_WRITER_H
@@ -1,326 +1,3280 @@
-#include "optimizer.h"
-#include <stdlib.h> // malloc, free, realloc
-#include <stdio.h>  // fprintf
-#include <string.h> // strcmp, strdup
-
-// --- Optimizer Gerçeklemeleri ---
-
-Optimizer* optimizer_init() {
-    Optimizer* optimizer = (Optimizer*)malloc(sizeof(Optimizer));
-    if (!optimizer) {
-        fprintf(stderr, "Hata: Optimizer için bellek tahsis edilemedi.\n");
-        return NULL;
-    }
-    optimizer->optimization_level = 1; // Varsayılan optimizasyon seviyesi
-    return optimizer;
-}
-
-void optimizer_close(Optimizer* optimizer) {
-    if (optimizer) {
-        free(optimizer);
-    }
-}
-
-// --- Yardımcı Fonksiyonlar (Sembol Tablosu Adresleri için) ---
-// NOT: Bu fonksiyonlar Semantik Analiz sonrası kod üretimine yakın bir aşamada çalışmalı.
-// Şimdilik adresleri semantik analiz aşamasında doldurmadığımız için 0 varsayılıyor.
-// Gerçek optimizasyonlar için doğru adreslere ihtiyaç duyulacaktır.
-// Bu kısım, daha sonra kod üretimi ile birleşebilir veya semantik analizde ikinci bir geçişle doldurulabilir.
-// VEYA optimizasyonlar, AST'nin kendisinde bu adres bilgilerini depolayacak şekilde geliştirilebilir.
-
-/**
- * @brief Programdaki her ifadenin (instruction veya label) sanal adresini hesaplar.
- * Bu adresler, JMP komutlarının hedeflerini çözümlemek için kullanılır.
- * Bu fonksiyon genellikle semantik analiz sonrası veya optimizasyon öncesi çalışır.
- * Her Bessambly komutunun sanal boyutu burada varsayılıyor (örn: 1 birim).
- * @param ast_root Programın AST kök düğümü.
- * @param symbol_table Sembol tablosu.
- */
-static void calculate_virtual_addresses(AstNode* ast_root, SymbolTable* symbol_table) {
-    if (!ast_root || ast_root->type != AST_PROGRAM) return;
-
-    uint32_t current_address = 0;
-    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
-        AstNode* statement = ast_root->data.program.statements[i];
-        
-        if (statement->type == AST_LABEL_DECLARATION) {
-            // Etiket adresini güncelle
-            SymbolEntry* entry = symbol_table_lookup_symbol(symbol_table, statement->data.label_decl.name);
-            if (entry) { // Semantik analizde zaten kontrol edildi, burada olmalı
-                entry->address = current_address;
-            }
-            // Etiket bildirimi kendi başına bir komut boyutu kaplamaz, sonraki komutun adresidir.
-        } else if (statement->type == AST_INSTRUCTION) {
-            // Komutun sanal boyutunu varsayalım (örn: 1 birim veya komut/operand sayısına göre değişebilir)
-            // Basitlik adına her komut 1 sanal adres birimi kaplasın.
-            // Gerçekte, makine koduna dönüşünce instruction'ların farklı bayt boyutları olacaktır.
-            statement->data.instruction.virtual_address = current_address; // Yeni alan eklemeyi unutmayın AST_Instruction'a
-            current_address++; 
-        }
-    }
-}
-
-
-// --- Optimizasyon Geçişi Gerçeklemeleri ---
-
-// Bu örnekte basitleştirilmiş bir yaklaşım izlenmiştir.
-// Gerçek bir dead code elimination, kontrol akış grafiği (CFG) gerektirebilir.
-int optimize_dead_code_elimination(AstNode* ast_root, SymbolTable* symbol_table) {
-    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
-
-    int changed = 0;
-    // Geçici olarak yeni bir ifade listesi oluştur
-    AstNode** new_statements = (AstNode**)malloc(sizeof(AstNode*) * ast_root->data.program.num_statements);
-    if (!new_statements) {
-        fprintf(stderr, "Hata: Ölü kod eleme için bellek tahsis edilemedi.\n");
-        return 0;
-    }
-    size_t new_count = 0;
-
-    // Bir atlama sonrası (JMP, JEQ vb.) ulaşılamayan kodları tespit etmeye çalışalım.
-    // Bu basit bir "birincil" dead code elimination'dır.
-    // Daha karmaşık durumlar için (örn: döngüler, çoklu atlamalar) Kontrol Akış Grafiği gerekir.
-
-    int unreachable_mode = 0; // 1 ise mevcut kod bloğuna ulaşılamıyor demektir
-
-    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
-        AstNode* current_statement = ast_root->data.program.statements[i];
-
-        if (current_statement->type == AST_LABEL_DECLARATION) {
-            // Bir etikete ulaşıldığında, ulaşılamayan moddan çıkılır
-            unreachable_mode = 0;
-            new_statements[new_count++] = current_statement;
-        } else if (current_statement->type == AST_INSTRUCTION) {
-            if (unreachable_mode) {
-                // Bu komuta ulaşılamıyor, kaldır
-                fprintf(stdout, "Optimizer: Ulaşılamayan komut kaldırıldı (%s, %d:%d).\n",
-                        token_type_to_string(current_statement->data.instruction.opcode),
-                        current_statement->line, current_statement->column);
-                ast_node_free(current_statement); // Belleği serbest bırak
-                changed = 1;
-            } else {
-                new_statements[new_count++] = current_statement;
-                // JMP veya RET gibi kontrol akışını değiştiren bir komut mu?
-                // Sonraki komutlara ulaşılamayabilir.
-                if (current_statement->data.instruction.opcode == TOKEN_JMP ||
-                    current_statement->data.instruction.opcode == TOKEN_RET ||
-                    current_statement->data.instruction.opcode == TOKEN_SYSCALL // SYSCALL da genellikle programı sonlandırabilir veya başka bir yere dallanabilir
-                   ) {
-                    unreachable_mode = 1;
-                }
-            }
-        }
-    }
-
-    // Orijinal ifade dizisini yeni diziyle değiştir
-    if (changed) {
-        free(ast_root->data.program.statements); // Orijinal diziyi serbest bırak
-        ast_root->data.program.statements = (AstNode**)realloc(new_statements, sizeof(AstNode*) * new_count);
-        ast_root->data.program.num_statements = new_count;
-        // realloc NULL dönerse hata kontrolü yapılmalı
-        if (!ast_root->data.program.statements && new_count > 0) {
-            fprintf(stderr, "Hata: Ölü kod eleme sonrası bellek yeniden tahsis edilemedi.\n");
-            // Ciddi bir hata, burada daha sağlam bir hata işleme gerekebilir
-        }
-    } else {
-        free(new_statements); // Değişiklik yapılmadıysa tahsis edilen yeni diziyi serbest bırak
-    }
-    return changed;
-}
-
-int optimize_constant_folding(AstNode* ast_root) {
-    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
-    int changed = 0;
-
-    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
-        AstNode* statement = ast_root->data.program.statements[i];
-        if (statement->type == AST_INSTRUCTION) {
-            AstInstruction* instr = &statement->data.instruction;
-
-            // Örnek: ADD R_dest, constant1; MOV R_dest, constant2 gibi durumları basitleştir.
-            // Bu, çok basit bir örnek, daha gelişmiş constant folding AST üzerinde birden fazla
-            // komuta bakarak yapılabilir (örneğin, bir sonraki komutun da aynı kaydediciyi kullanıp kullanmadığı).
-            
-            // Eğer bir ikili işlem (ADD, SUB, MUL, DIV) ve ikinci operandı sabit ise
-            if ((instr->opcode == TOKEN_ADD || instr->opcode == TOKEN_SUB ||
-                 instr->opcode == TOKEN_MUL || instr->opcode == TOKEN_DIV) &&
-                instr->num_operands == 2 &&
-                (instr->operands[1].type == OP_INTEGER || instr->operands[1].type == OP_HEX_INTEGER)) {
-                
-                // İlk operandın kaydedici olduğunu varsayıyoruz (semantik analiz kontrol etti)
-                // Bu optimizasyon için, ilk operandın da sabit bir değer taşıması gerekir
-                // VEYA, daha önceki bir komutun sabit bir değere sahip olduğunu takip etmemiz gerekir.
-                // Bu karmaşık bir Veri Akış Analizi (Data Flow Analysis) gerektirir.
-                // Şimdilik, sadece doğrudan bir sabit atamayı düşünelim.
-
-                // Basit bir örnek: MOV R0, 5; ADD R0, 3  -> MOV R0, 8
-                // Bu optimizasyon için, R0'ın önceki değerini bilmemiz gerekir.
-                // Bu, daha çok Data Flow Analysis'e girer ve burada uygulamak zor olabilir.
-                // Şimdilik bu kısmı atlayalım veya daha sonraki IR aşamasında yapalım.
-
-                // Bir alternatif: doğrudan bir "değişmez" komutunu optimize etme
-                // Bessambly'de bu tür durumlar nasıl modellenir?
-                // Örn: Eğer Bessambly'nin bir "Load Immediate" veya benzeri bir komutu olsaydı
-                // MOV R0, 10
-                // ADD R0, 5 (burada R0'ın değeri bilinmiyor, sadece JIT/RunTime'da bilinebilir)
-
-                // En basit hali:
-                // Eğer bir komutun tüm operandları sabit ise ve sonucu da sabit oluyorsa,
-                // komutu doğrudan bir MOV komutuna dönüştürebiliriz.
-                // Ama Bessambly komutları genellikle kaydedicilerle çalışır.
-                // Bu optimizasyon, daha çok bir "Intermediate Representation (IR)" üzerinde daha kolay yapılır.
-                // Bessambly AST'sinde bunu doğrudan yapmak zor çünkü kaydedici değerlerini takip etmiyoruz.
-            }
-        }
-    }
-    return changed;
-}
-
-// Bu optimizasyon, temel kontrol akışını anlamayı gerektirir.
-int optimize_jump_threading(AstNode* ast_root, SymbolTable* symbol_table) {
-    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
-    if (symbol_table == NULL) {
-        fprintf(stderr, "Hata: Jump threading için sembol tablosu gerekli.\n");
-        return 0;
-    }
-
-    int changed = 0;
-    calculate_virtual_addresses(ast_root, symbol_table); // Etiket adreslerini güncelleyelim
-
-    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
-        AstNode* current_statement = ast_root->data.program.statements[i];
-
-        if (current_statement->type == AST_INSTRUCTION &&
-            (current_statement->data.instruction.opcode == TOKEN_JMP ||
-             current_statement->data.instruction.opcode == TOKEN_JEQ ||
-             current_statement->data.instruction.opcode == TOKEN_JNE ||
-             current_statement->data.instruction.opcode == TOKEN_JLT ||
-             current_statement->data.instruction.opcode == TOKEN_JGT)) {
-            
-            // Bu bir atlama komutu ve bir etiket referansı içeriyor mu? (Semantik analiz kontrol etti)
-            if (current_statement->data.instruction.num_operands == 1 &&
-                current_statement->data.instruction.operands[0].type == OP_LABEL_REF) {
-                
-                char* target_label_name = current_statement->data.instruction.operands[0].value.label_name;
-                SymbolEntry* target_entry = symbol_table_lookup_symbol(symbol_table, target_label_name);
-
-                if (target_entry) {
-                    // Atladığı adresin hemen sonrasındaki komut bir JMP mi?
-                    // target_entry->address, etiketin başladığı sanal adres
-                    // Bu adresi, AstNode'lara eklediğimiz 'virtual_address' ile eşleştirmemiz gerekir.
-
-                    // Bu optimizasyon, özellikle JMP'den sonra doğrudan bir etiket ve o etiketin 
-                    // hemen altında başka bir JMP varsa uygulanır.
-                    // Örnek: JMP LabelA; ... LabelA: JMP LabelB
-                    // Bu durumun tespiti biraz karmaşıktır ve AST'nin düz bir listesi üzerinden zordur.
-                    // Daha çok bir kontrol akış grafiği (CFG) gerektirir.
-                    // Basit bir yaklaşım için: Eğer bir etiket sadece bir JMP'den sonra geliyorsa
-                    // ve o etiketteki ilk komut da bir JMP ise.
-
-                    // Bu optimizasyon için aşağıdaki mantık bir başlangıç noktasıdır:
-                    // 1. Hedef etiketin hemen arkasındaki ifadenin bir JMP komutu olup olmadığını bul
-                    AstNode* target_label_node = NULL;
-                    size_t target_label_index = -1;
-                    for (size_t k = 0; k < ast_root->data.program.num_statements; k++) {
-                        if (ast_root->data.program.statements[k]->type == AST_LABEL_DECLARATION &&
-                            strcmp(ast_root->data.program.statements[k]->data.label_decl.name, target_label_name) == 0) {
-                            target_label_node = ast_root->data.program.statements[k];
-                            target_label_index = k;
-                            break;
-                        }
-                    }
-
-                    if (target_label_node && (target_label_index + 1) < ast_root->data.program.num_statements) {
-                        AstNode* next_statement = ast_root->data.program.statements[target_label_index + 1];
-                        if (next_statement->type == AST_INSTRUCTION && next_statement->data.instruction.opcode == TOKEN_JMP) {
-                            // "JMP LabelA; ... LabelA: JMP LabelB" durumu
-                            // İlk JMP'yi doğrudan LabelB'ye atlayacak şekilde değiştir.
-                            if (next_statement->data.instruction.num_operands == 1 &&
-                                next_statement->data.instruction.operands[0].type == OP_LABEL_REF) {
-                                
-                                char* final_target_label = next_statement->data.instruction.operands[0].value.label_name;
-
-                                // Mevcut JMP komutunun operandını değiştir
-                                free(current_statement->data.instruction.operands[0].value.label_name); // Eski label adını free et
-                                current_statement->data.instruction.operands[0].value.label_name = strdup(final_target_label); // Yeni label adını kopyala
-                                
-                                fprintf(stdout, "Optimizer: Atlama kısaltma yapıldı (%s, %d:%d -> %s).\n",
-                                        token_type_to_string(current_statement->data.instruction.opcode),
-                                        current_statement->line, current_statement->column, final_target_label);
-                                changed = 1;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    return changed;
-}
-
-
-int perform_optimizations(Optimizer* optimizer, AstNode* ast_root, SymbolTable* symbol_table) {
-    if (!optimizer || !ast_root || !symbol_table) {
-        fprintf(stderr, "Hata: Optimizasyon için geçersiz giriş.\n");
-        return 0;
-    }
-
-    int total_changes = 0;
-    int iteration_changes;
-    
-    // Optimizasyonları birden fazla geçişte ve sıralı olarak uygulayabiliriz
-    // Her bir optimizasyon geçişi, bir diğerinin daha fazla optimizasyon yapmasını sağlayabilir.
-    // Bu nedenle bir "Fixed-Point Iteration" (Sabit Nokta İterasyonu) döngüsü kullanırız.
-    // Hiçbir değişiklik yapılmayana kadar döngü devam eder.
-
-    fprintf(stdout, "\n--- Bessambly Optimizasyon Başlatılıyor ---\n");
-
-    // Optimizasyon öncesi sanal adresleri hesaplayın.
-    // Bu kısım, semantik analizden sonra veya optimizasyonun başında yapılabilir.
-    // Önemli: Bu fonksiyonun doğru çalışması için AST_Instruction yapısına 'virtual_address'
-    // adında bir 'uint32_t' alanı eklemeniz gerekmektedir.
-    // calculate_virtual_addresses(ast_root, symbol_table); 
-
-
-    if (optimizer->optimization_level >= 1) { // Eğer optimizasyon seviyesi >= 1 ise
-        do {
-            iteration_changes = 0;
-
-            // 1. Ölü Kod Eleme
-            int dce_changes = optimize_dead_code_elimination(ast_root, symbol_table);
-            if (dce_changes) {
-                iteration_changes += dce_changes;
-                total_changes += dce_changes;
-                // Dead code elimination, etiket adreslerini değiştirebileceği için
-                // adresleri yeniden hesaplamak gerekebilir.
-                // calculate_virtual_addresses(ast_root, symbol_table);
-            }
-
-            // 2. Atlama Kısaltma (Jump Threading)
-            int jt_changes = optimize_jump_threading(ast_root, symbol_table);
-            if (jt_changes) {
-                iteration_changes += jt_changes;
-                total_changes += jt_changes;
-            }
-
-            // 3. Sabit Katlama (Şimdilik çok basit, ileri aşamalarda geliştirilmeli)
-            int cf_changes = optimize_constant_folding(ast_root);
-            if (cf_changes) {
-                iteration_changes += cf_changes;
-                total_changes += cf_changes;
-            }
-            
-            // Diğer optimizasyon geçişleri buraya eklenebilir.
-
-        } while (iteration_changes > 0); // Hiçbir değişiklik yapılmayana kadar tekrarla
-    }
-
-    if (total_changes > 0) {
-        fprintf(stdout, "Toplam %d optimizasyon değişikliği yapıldı.\n", total_changes);
-    } else {
-        fprintf(stdout, "Hiçbir optimizasyon değişikliği yapılmadı.\n");
-    }
-
-    fprintf(stdout, "Optimizasyon başarıyla tamamlandı.\n");
-    return 1; // Başarılı
-}
+#include "optimizer.h"
+#include "cfg.h"    // Kontrol akış grafiği (blok yerleşimi, alt programlar, veri akışı)
+#include "ir_generator.h" // Üç adresli IR (IR üzerinde çalışan geçişler)
+#include "sched.h"  // Liste komut zamanlayıcısı
+#include <stdlib.h> // malloc, free, realloc, qsort
+#include <stdio.h>  // fprintf
+#include <string.h> // strcmp, strdup
+#include <time.h>   // clock (derleme süresi bütçesi)
+
+// --- Optimizer Gerçeklemeleri ---
+
+Optimizer* optimizer_init() {
+    Optimizer* optimizer = (Optimizer*)malloc(sizeof(Optimizer));
+    if (!optimizer) {
+        fprintf(stderr, "Hata: Optimizer için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    optimizer->optimization_level = OPT_LEVEL_O1; // Varsayılan optimizasyon seviyesi
+    optimizer->opt_budget_ms = 0; // Sınırsız
+    optimizer->instrument_profile = 0;
+    optimizer->profile_exit_syscall = BSM_PROFILE_DEFAULT_EXIT_SYSCALL;
+    optimizer->profile_output_path = BSM_PROFILE_DEFAULT_PATH;
+    optimizer->instrumentation.cfg_checksum = 0;
+    optimizer->instrumentation.num_counters = 0;
+    optimizer->profile = NULL;
+    optimizer->superopt_rules = NULL;
+    optimizer->superoptimize = 0;
+    optimizer->target_arch = UNKNOWN_ARCH; // Bilinmiyorsa aritmetik bayrakları yeniden kullanılmaz
+    return optimizer;
+}
+
+void optimizer_close(Optimizer* optimizer) {
+    if (optimizer) {
+        profile_free(optimizer->profile);
+        superopt_rules_free(optimizer->superopt_rules);
+        free(optimizer);
+    }
+}
+
+// --- Yardımcı Fonksiyonlar (Sembol Tablosu Adresleri için) ---
+// NOT: Bu fonksiyonlar Semantik Analiz sonrası kod üretimine yakın bir aşamada çalışmalı.
+// Şimdilik adresleri semantik analiz aşamasında doldurmadığımız için 0 varsayılıyor.
+// Gerçek optimizasyonlar için doğru adreslere ihtiyaç duyulacaktır.
+// Bu kısım, daha sonra kod üretimi ile birleşebilir veya semantik analizde ikinci bir geçişle doldurulabilir.
+// VEYA optimizasyonlar, AST'nin kendisinde bu adres bilgilerini depolayacak şekilde geliştirilebilir.
+
+/**
+ * @brief Programdaki her ifadenin (instruction veya label) sanal adresini hesaplar.
+ * Bu adresler, JMP komutlarının hedeflerini çözümlemek için kullanılır.
+ * Bu fonksiyon genellikle semantik analiz sonrası veya optimizasyon öncesi çalışır.
+ * Her Bessambly komutunun sanal boyutu burada varsayılıyor (örn: 1 birim).
+ * @param ast_root Programın AST kök düğümü.
+ * @param symbol_table Sembol tablosu.
+ */
+static void calculate_virtual_addresses(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return;
+
+    uint32_t current_address = 0;
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        AstNode* statement = ast_root->data.program.statements[i];
+        
+        if (statement->type == AST_LABEL_DECLARATION) {
+            // Etiket adresini güncelle
+            SymbolEntry* entry = symbol_table_lookup_symbol(symbol_table, statement->data.label_decl.name);
+            if (entry) { // Semantik analizde zaten kontrol edildi, burada olmalı
+                entry->address = current_address;
+            }
+            // Etiket bildirimi kendi başına bir komut boyutu kaplamaz, sonraki komutun adresidir.
+        } else if (statement->type == AST_INSTRUCTION) {
+            // Komutun sanal boyutunu varsayalım (örn: 1 birim veya komut/operand sayısına göre değişebilir)
+            // Basitlik adına her komut 1 sanal adres birimi kaplasın.
+            // Gerçekte, makine koduna dönüşünce instruction'ların farklı bayt boyutları olacaktır.
+            statement->data.instruction.virtual_address = current_address; // Yeni alan eklemeyi unutmayın AST_Instruction'a
+            current_address++; 
+        }
+    }
+}
+
+
+// --- Optimizasyon Geçişi Gerçeklemeleri ---
+
+// Bu örnekte basitleştirilmiş bir yaklaşım izlenmiştir.
+// Gerçek bir dead code elimination, kontrol akış grafiği (CFG) gerektirebilir.
+int optimize_dead_code_elimination(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+
+    int changed = 0;
+    // Geçici olarak yeni bir ifade listesi oluştur
+    AstNode** new_statements = (AstNode**)malloc(sizeof(AstNode*) * ast_root->data.program.num_statements);
+    if (!new_statements) {
+        fprintf(stderr, "Hata: Ölü kod eleme için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    size_t new_count = 0;
+
+    // Bir atlama sonrası (JMP, JEQ vb.) ulaşılamayan kodları tespit etmeye çalışalım.
+    // Bu basit bir "birincil" dead code elimination'dır.
+    // Daha karmaşık durumlar için (örn: döngüler, çoklu atlamalar) Kontrol Akış Grafiği gerekir.
+
+    int unreachable_mode = 0; // 1 ise mevcut kod bloğuna ulaşılamıyor demektir
+
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        AstNode* current_statement = ast_root->data.program.statements[i];
+
+        if (current_statement->type == AST_LABEL_DECLARATION) {
+            // Bir etikete ulaşıldığında, ulaşılamayan moddan çıkılır
+            unreachable_mode = 0;
+            new_statements[new_count++] = current_statement;
+        } else if (current_statement->type == AST_INSTRUCTION) {
+            if (unreachable_mode) {
+                // Bu komuta ulaşılamıyor, kaldır
+                fprintf(stdout, "Optimizer: Ulaşılamayan komut kaldırıldı (%s, %d:%d).\n",
+                        token_type_to_string(current_statement->data.instruction.opcode),
+                        current_statement->line, current_statement->column);
+                ast_node_free(current_statement); // Belleği serbest bırak
+                changed = 1;
+            } else {
+                new_statements[new_count++] = current_statement;
+                // JMP, JTAB veya RET gibi kontrol akışını değiştiren bir komut mu?
+                // Sonraki komutlara ulaşılamayabilir.
+                // SYSCALL ve CALL sonlandırıcı değildir: çağrı döndüğünde akış sonraki komuttan devam eder.
+                if (!cfg_has_fallthrough(current_statement->data.instruction.opcode)) {
+                    unreachable_mode = 1;
+                }
+            }
+        }
+    }
+
+    // Orijinal ifade dizisini yeni diziyle değiştir
+    if (changed) {
+        free(ast_root->data.program.statements); // Orijinal diziyi serbest bırak
+        ast_root->data.program.statements = (AstNode**)realloc(new_statements, sizeof(AstNode*) * new_count);
+        ast_root->data.program.num_statements = new_count;
+        // realloc NULL dönerse hata kontrolü yapılmalı
+        if (!ast_root->data.program.statements && new_count > 0) {
+            fprintf(stderr, "Hata: Ölü kod eleme sonrası bellek yeniden tahsis edilemedi.\n");
+            // Ciddi bir hata, burada daha sağlam bir hata işleme gerekebilir
+        }
+    } else {
+        free(new_statements); // Değişiklik yapılmadıysa tahsis edilen yeni diziyi serbest bırak
+    }
+    return changed;
+}
+
+int optimize_constant_folding(AstNode* ast_root) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+    int changed = 0;
+
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        AstNode* statement = ast_root->data.program.statements[i];
+        if (statement->type == AST_INSTRUCTION) {
+            AstInstruction* instr = &statement->data.instruction;
+
+            // Örnek: ADD R_dest, constant1; MOV R_dest, constant2 gibi durumları basitleştir.
+            // Bu, çok basit bir örnek, daha gelişmiş constant folding AST üzerinde birden fazla
+            // komuta bakarak yapılabilir (örneğin, bir sonraki komutun da aynı kaydediciyi kullanıp kullanmadığı).
+            
+            // Eğer bir ikili işlem (ADD, SUB, MUL, DIV) ve ikinci operandı sabit ise
+            if ((instr->opcode == TOKEN_ADD || instr->opcode == TOKEN_SUB ||
+                 instr->opcode == TOKEN_MUL || instr->opcode == TOKEN_DIV) &&
+                instr->num_operands == 2 &&
+                (instr->operands[1].type == OP_INTEGER || instr->operands[1].type == OP_HEX_INTEGER)) {
+                
+                // İlk operandın kaydedici olduğunu varsayıyoruz (semantik analiz kontrol etti)
+                // Bu optimizasyon için, ilk operandın da sabit bir değer taşıması gerekir
+                // VEYA, daha önceki bir komutun sabit bir değere sahip olduğunu takip etmemiz gerekir.
+                // Bu karmaşık bir Veri Akış Analizi (Data Flow Analysis) gerektirir.
+                // Şimdilik, sadece doğrudan bir sabit atamayı düşünelim.
+
+                // Basit bir örnek: MOV R0, 5; ADD R0, 3  -> MOV R0, 8
+                // Bu optimizasyon için, R0'ın önceki değerini bilmemiz gerekir.
+                // Bu, daha çok Data Flow Analysis'e girer ve burada uygulamak zor olabilir.
+                // Şimdilik bu kısmı atlayalım veya daha sonraki IR aşamasında yapalım.
+
+                // Bir alternatif: doğrudan bir "değişmez" komutunu optimize etme
+                // Bessambly'de bu tür durumlar nasıl modellenir?
+                // Örn: Eğer Bessambly'nin bir "Load Immediate" veya benzeri bir komutu olsaydı
+                // MOV R0, 10
+                // ADD R0, 5 (burada R0'ın değeri bilinmiyor, sadece JIT/RunTime'da bilinebilir)
+
+                // En basit hali:
+                // Eğer bir komutun tüm operandları sabit ise ve sonucu da sabit oluyorsa,
+                // komutu doğrudan bir MOV komutuna dönüştürebiliriz.
+                // Ama Bessambly komutları genellikle kaydedicilerle çalışır.
+                // Bu optimizasyon, daha çok bir "Intermediate Representation (IR)" üzerinde daha kolay yapılır.
+                // Bessambly AST'sinde bunu doğrudan yapmak zor çünkü kaydedici değerlerini takip etmiyoruz.
+            }
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief "CMP R, 0" aritmetik sonucunun bayraklarıyla değiştirilebilir mi kontrol eder.
+ * Donanımın ADD/SUB'ı taşma bayrağını farklı ayarlar ve kod üretici sıralama okuyucuları için
+ * karşılaştırmayı yeniden üretir; bu yüzden sadece eşitlik okuyucularına (JEQ/JNE) izin verilir.
+ * Bayraklar bloktan çıkıyorsa okuyucuları bilinemez.
+ */
+static int compare_zero_readers_are_equality(const Cfg* cfg, int block, size_t after, const uint32_t* live_out) {
+    AstNode** statements = cfg->program->data.program.statements;
+    for (size_t i = after + 1; i < cfg->blocks[block].end; i++) {
+        if (statements[i]->type != AST_INSTRUCTION) continue;
+        const AstInstruction* instr = &statements[i]->data.instruction;
+        FlagsEffect effect = cfg_instruction_flags_effect(instr);
+        if (effect == FLAGS_USE && instr->opcode != TOKEN_JEQ && instr->opcode != TOKEN_JNE &&
+            instr->opcode != TOKEN_SELEQ && instr->opcode != TOKEN_SELNE) return 0;
+        if (effect == FLAGS_DEF_COMPARE || effect == FLAGS_DEF_RESULT || effect == FLAGS_CLOBBER) return 1;
+    }
+    return (live_out[block] & CFG_FLAGS_BIT) == 0;
+}
+
+int optimize_redundant_compares(AstNode* ast_root, TargetArchitecture arch) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    // ADD/SUB her hedefte bayrakları (sonuç, 0) olarak kurar; "CMP R, 0" sadece aritmetiği bayrak
+    // kuran hedeflerde kazançlıdır (diğerlerinde kod üretici karşılaştırmayı yine dala katar)
+    int native_flags = target_arch_arith_sets_flags(arch);
+
+    FlagsValue* block_in = (FlagsValue*)malloc(sizeof(FlagsValue) * (nb ? nb : 1));
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    char* remove = (char*)calloc(ast_root->data.program.num_statements + 1, 1);
+    if (!block_in || !live_in || !live_out || !remove) {
+        fprintf(stderr, "Hata: Gereksiz karşılaştırma eleme için bellek tahsis edilemedi.\n");
+        free(block_in); free(live_in); free(live_out); free(remove);
+        cfg_free(cfg);
+        return 0;
+    }
+    if (!cfg_compute_available_flags(cfg, block_in)) {
+        free(block_in); free(live_in); free(live_out); free(remove);
+        cfg_free(cfg);
+        return 0;
+    }
+    cfg_compute_liveness(cfg, live_in, live_out);
+
+    AstNode** statements = ast_root->data.program.statements;
+    int changed = 0;
+    for (size_t b = 0; b < nb; b++) {
+        FlagsValue flags = block_in[b];
+        for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            if (statements[i]->type != AST_INSTRUCTION) continue;
+            const AstInstruction* instr = &statements[i]->data.instruction;
+
+            if (instr->opcode == TOKEN_CMP && instr->num_operands == 2) {
+                FlagsValue produced = flags;
+                cfg_flags_transfer(&produced, instr);
+
+                // 1. Aynı operandlarla yapılmış ve arada bozulmamış bir karşılaştırma zaten mevcut
+                int redundant = produced.kind == FLAGS_VALUE_COMPARE && cfg_flags_value_equal(&flags, &produced);
+
+                // 2. "CMP R, 0": R'yi son yazan ADD/SUB bayrakları zaten ayarladı
+                if (!redundant && native_flags && flags.kind == FLAGS_VALUE_RESULT &&
+                    instr->operands[0].type == OP_REGISTER && instr->operands[0].value.reg_index == flags.reg &&
+                    (instr->operands[1].type == OP_INTEGER || instr->operands[1].type == OP_HEX_INTEGER) &&
+                    instr->operands[1].value.int_value == 0 &&
+                    compare_zero_readers_are_equality(cfg, (int)b, i, live_out)) {
+                    redundant = 1;
+                    produced = flags; // Sonraki "CMP R, 0" da aynı sonucu kullanabilir
+                }
+
+                if (redundant) {
+                    fprintf(stdout, "Optimizer: Gereksiz karşılaştırma kaldırıldı (%d:%d).\n",
+                            statements[i]->line, statements[i]->column);
+                    remove[i] = 1;
+                    changed = 1;
+                    continue; // Kaldırılan komut bayrak durumunu değiştirmez
+                }
+                flags = produced;
+                continue;
+            }
+            cfg_flags_transfer(&flags, instr);
+        }
+    }
+
+    if (changed) {
+        size_t new_count = 0;
+        for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+            if (remove[i]) {
+                ast_node_free(statements[i]);
+            } else {
+                statements[new_count++] = statements[i];
+            }
+        }
+        ast_root->data.program.num_statements = new_count;
+    }
+
+    free(block_in); free(live_in); free(live_out); free(remove);
+    cfg_free(cfg);
+    return changed;
+}
+
+// --- Kopya Yayma ve Taşıma Birleştirme ---
+
+#define COPY_NONE (-1)  // Kaydedici hiçbir kaydedicinin kopyası değil
+#define COPY_TOP (-2)   // Veri akışı başlangıç değeri (henüz ziyaret edilmedi)
+
+/**
+ * @brief İşaretli ifadeleri programdan çıkarır ve serbest bırakır.
+ * @param remove Program boyutunda işaret dizisi (1 = kaldır).
+ */
+static void remove_marked_statements(AstNode* ast_root, const unsigned char* remove) {
+    AstNode** statements = ast_root->data.program.statements;
+    size_t new_count = 0;
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        if (remove[i]) {
+            ast_node_free(statements[i]);
+        } else {
+            statements[new_count++] = statements[i];
+        }
+    }
+    ast_root->data.program.num_statements = new_count;
+}
+
+// Dönüşümlerin ürettiği ifade listesi
+typedef struct {
+    AstNode** items;
+    size_t count;
+    size_t capacity;
+} StatementList;
+
+// Programda [first, end) aralığındaki ifadelerin yerine emitted gelir
+typedef struct {
+    size_t first;
+    size_t end;
+    StatementList emitted;
+} StatementReplacement;
+
+/**
+ * @brief Listeye bir düğüm ekler. Düğüm NULL ise (oluşturma hatası) veya bellek yetmezse 0 döner;
+ * eklenemeyen düğüm serbest bırakılır.
+ */
+static int statement_list_append(StatementList* list, AstNode* node) {
+    if (!node) return 0;
+    if (list->count >= list->capacity) {
+        size_t new_capacity = list->capacity ? list->capacity * 2 : 16;
+        AstNode** items = (AstNode**)realloc(list->items, sizeof(AstNode*) * new_capacity);
+        if (!items) {
+            ast_node_free(node);
+            return 0;
+        }
+        list->items = items;
+        list->capacity = new_capacity;
+    }
+    list->items[list->count++] = node;
+    return 1;
+}
+
+static void statement_list_free(StatementList* list) {
+    for (size_t i = 0; i < list->count; i++) ast_node_free(list->items[i]);
+    free(list->items);
+    list->items = NULL;
+    list->count = list->capacity = 0;
+}
+
+/**
+ * @brief Sıralı ve çakışmayan aralık değişikliklerini programa uygular.
+ * first == end == num_statements olan boş bir aralık değişikliği programın sonuna ekler.
+ * Başarılıysa eski ifadeler ve listelerin dizileri serbest bırakılır (düğümler programa geçer);
+ * bellek hatasında program değişmez ve listeler çağıranda kalır.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+static int apply_statement_replacements(AstNode* ast_root, StatementReplacement* replacements,
+                                        size_t num_replacements) {
+    size_t n = ast_root->data.program.num_statements;
+    size_t new_count = n;
+    for (size_t r = 0; r < num_replacements; r++) {
+        new_count += replacements[r].emitted.count - (replacements[r].end - replacements[r].first);
+    }
+    AstNode** statements = ast_root->data.program.statements;
+    AstNode** new_statements = (AstNode**)malloc(sizeof(AstNode*) * (new_count ? new_count : 1));
+    if (!new_statements) return 0;
+
+    size_t out = 0, r = 0;
+    for (size_t i = 0; i < n || r < num_replacements;) {
+        if (r < num_replacements && replacements[r].first == i) {
+            for (size_t k = 0; k < replacements[r].emitted.count; k++) {
+                new_statements[out++] = replacements[r].emitted.items[k];
+            }
+            for (size_t k = replacements[r].first; k < replacements[r].end; k++) ast_node_free(statements[k]);
+            free(replacements[r].emitted.items);
+            replacements[r].emitted.items = NULL;
+            replacements[r].emitted.count = replacements[r].emitted.capacity = 0;
+            i = replacements[r].end;
+            r++;
+        } else {
+            new_statements[out++] = statements[i++];
+        }
+    }
+    free(ast_root->data.program.statements);
+    ast_root->data.program.statements = new_statements;
+    ast_root->data.program.num_statements = out;
+    return 1;
+}
+
+/**
+ * @brief Kopya tablosunda, clobber maskesindeki kaydedicilerle ilgili tüm kopyaları geçersiz kılar.
+ */
+static void kill_copies(signed char* copy_of, uint32_t clobber) {
+    for (int r = 0; r < CFG_NUM_REGISTERS; r++) {
+        if ((clobber & (1u << r)) ||
+            (copy_of[r] >= 0 && (clobber & (1u << copy_of[r])))) {
+            copy_of[r] = COPY_NONE;
+        }
+    }
+}
+
+/**
+ * @brief Bir komutun kopya tablosu üzerindeki etkisini uygular (MOV Rx, Ry -> Rx, Ry'nin kopyası).
+ */
+static void copy_transfer(signed char* copy_of, const AstInstruction* instr) {
+    RegisterEffects fx = cfg_instruction_register_effects(instr);
+    kill_copies(copy_of, fx.clobber);
+    if (instr->opcode == TOKEN_MOV && instr->num_operands == 2 &&
+        instr->operands[0].type == OP_REGISTER && instr->operands[1].type == OP_REGISTER &&
+        instr->operands[0].value.reg_index != instr->operands[1].value.reg_index) {
+        copy_of[instr->operands[0].value.reg_index] = (signed char)instr->operands[1].value.reg_index;
+    }
+}
+
+/**
+ * @brief Kopyası bilinen kaydedici okumalarını kaynak kaydediciye yönlendirir.
+ * Sadece değer olarak okunan operandlar değiştirilir (ADD/SUB/MUL/DIV'in hedefi hem
+ * okunur hem yazılır, SYSCALL argümanları çağrı sözleşmesine bağlıdır; bunlara dokunulmaz).
+ * @return Değiştirilen operand sayısı.
+ */
+static int rewrite_copy_uses(AstInstruction* instr, const signed char* copy_of) {
+    size_t first_use, last_use;
+    switch (instr->opcode) {
+        case TOKEN_MOV:
+        case TOKEN_ADD:
+        case TOKEN_SUB:
+        case TOKEN_MUL:
+        case TOKEN_DIV:
+            first_use = 1; last_use = 1; break;
+        case TOKEN_CMP:
+            first_use = 0; last_use = 1; break;
+        default:
+            return 0;
+    }
+    int rewritten = 0;
+    for (size_t o = first_use; o <= last_use && o < instr->num_operands; o++) {
+        AstOperand* operand = &instr->operands[o];
+        if (operand->type == OP_REGISTER && operand->value.reg_index >= 0 &&
+            operand->value.reg_index < CFG_NUM_REGISTERS && copy_of[operand->value.reg_index] >= 0) {
+            operand->value.reg_index = copy_of[operand->value.reg_index];
+            rewritten++;
+        }
+    }
+    return rewritten;
+}
+
+/**
+ * @brief Canlı olmayan hedefe yazan MOV'ları ve MOV Rx, Rx'leri işaretler (geriye doğru tarama).
+ * MOV bayrakları etkilemediği için güvenle silinebilir.
+ * @return İşaretlenen komut sayısı.
+ */
+static int mark_dead_moves(const Cfg* cfg, const uint32_t* live_out, unsigned char* remove) {
+    AstNode** statements = cfg->program->data.program.statements;
+    int removed = 0;
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        uint32_t live = live_out[b];
+        for (size_t i = cfg->blocks[b].end; i > cfg->blocks[b].first; i--) {
+            AstNode* statement = statements[i - 1];
+            if (statement->type != AST_INSTRUCTION) continue;
+            const AstInstruction* instr = &statement->data.instruction;
+            RegisterEffects fx = cfg_instruction_register_effects(instr);
+
+            if (instr->opcode == TOKEN_MOV && instr->num_operands == 2 && instr->operands[0].type == OP_REGISTER &&
+                ((fx.def & live) == 0 ||
+                 (instr->operands[1].type == OP_REGISTER &&
+                  instr->operands[0].value.reg_index == instr->operands[1].value.reg_index))) {
+                remove[i - 1] = 1;
+                removed++;
+                continue; // Silinen komut canlılığı etkilemez
+            }
+            live = (live & ~fx.def) | fx.use;
+        }
+    }
+    return removed;
+}
+
+int optimize_copy_propagation(AstNode* ast_root) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    AstNode** statements = ast_root->data.program.statements;
+
+    signed char (*block_in)[CFG_NUM_REGISTERS] = malloc(sizeof(*block_in) * (nb ? nb : 1));
+    signed char (*block_out)[CFG_NUM_REGISTERS] = malloc(sizeof(*block_out) * (nb ? nb : 1));
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    unsigned char* remove = (unsigned char*)calloc(ast_root->data.program.num_statements + 1, 1);
+    if (!block_in || !block_out || !live_in || !live_out || !remove) {
+        fprintf(stderr, "Hata: Kopya yayma için bellek tahsis edilemedi.\n");
+        free(block_in); free(block_out); free(live_in); free(live_out); free(remove);
+        cfg_free(cfg);
+        return 0;
+    }
+
+    // 1. Kullanılabilir kopyalar (ileri veri akışı, kesişim): Rx = Ry tüm yollarda geçerliyse kopya
+    for (size_t b = 0; b < nb; b++) {
+        memset(block_in[b], COPY_TOP, CFG_NUM_REGISTERS);
+        memset(block_out[b], COPY_TOP, CFG_NUM_REGISTERS);
+    }
+    int iterate = 1;
+    while (iterate) {
+        iterate = 0;
+        for (size_t b = 0; b < nb; b++) {
+            signed char in[CFG_NUM_REGISTERS];
+            memset(in, (b == 0 || cfg->blocks[b].num_preds == 0) ? COPY_NONE : COPY_TOP, CFG_NUM_REGISTERS);
+            for (size_t p = 0; p < cfg->blocks[b].num_preds; p++) {
+                const signed char* pred = block_out[cfg->edges[cfg->blocks[b].pred_edges[p]].from];
+                for (int r = 0; r < CFG_NUM_REGISTERS; r++) {
+                    if (pred[r] == COPY_TOP) continue;
+                    if (in[r] == COPY_TOP) in[r] = pred[r];
+                    else if (in[r] != pred[r]) in[r] = COPY_NONE;
+                }
+            }
+            if (b == 0) memset(in, COPY_NONE, CFG_NUM_REGISTERS); // Program girişinde kopya yok
+
+            signed char out[CFG_NUM_REGISTERS];
+            memcpy(out, in, CFG_NUM_REGISTERS);
+            int reached = 1;
+            for (int r = 0; r < CFG_NUM_REGISTERS; r++) if (out[r] == COPY_TOP) reached = 0;
+            if (reached) {
+                for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+                    if (statements[i]->type == AST_INSTRUCTION) {
+                        copy_transfer(out, &statements[i]->data.instruction);
+                    }
+                }
+            }
+            if (memcmp(in, block_in[b], CFG_NUM_REGISTERS) != 0 || memcmp(out, block_out[b], CFG_NUM_REGISTERS) != 0) {
+                memcpy(block_in[b], in, CFG_NUM_REGISTERS);
+                memcpy(block_out[b], out, CFG_NUM_REGISTERS);
+                iterate = 1;
+            }
+        }
+    }
+
+    // 2. Okumaları kopyanın kaynağına yönlendir
+    int rewritten = 0;
+    for (size_t b = 0; b < nb; b++) {
+        signed char copy_of[CFG_NUM_REGISTERS];
+        memcpy(copy_of, block_in[b], CFG_NUM_REGISTERS);
+        for (int r = 0; r < CFG_NUM_REGISTERS; r++) if (copy_of[r] == COPY_TOP) copy_of[r] = COPY_NONE;
+        for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            if (statements[i]->type != AST_INSTRUCTION) continue;
+            AstInstruction* instr = &statements[i]->data.instruction;
+            rewritten += rewrite_copy_uses(instr, copy_of);
+            copy_transfer(copy_of, instr);
+        }
+    }
+
+    // 3. Artık okunmayan kopyaları (ve MOV Rx, Rx) sil
+    cfg_compute_liveness(cfg, live_in, live_out);
+    int removed = mark_dead_moves(cfg, live_out, remove);
+    if (removed) remove_marked_statements(ast_root, remove);
+    if (rewritten || removed) {
+        fprintf(stdout, "Optimizer: Kopya yayma: %d okuma yönlendirildi, %d gereksiz MOV kaldırıldı.\n",
+                rewritten, removed);
+    }
+
+    free(block_in); free(block_out); free(live_in); free(live_out); free(remove);
+    cfg_free(cfg);
+    return rewritten > 0 || removed > 0;
+}
+
+int optimize_move_coalescing(AstNode* ast_root) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    AstNode** statements = ast_root->data.program.statements;
+    size_t n = ast_root->data.program.num_statements;
+
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_after = (uint32_t*)malloc(sizeof(uint32_t) * (n ? n : 1)); // Komuttan sonra canlı kümesi
+    unsigned char* remove = (unsigned char*)calloc(n + 1, 1);
+    if (!live_in || !live_out || !live_after || !remove) {
+        fprintf(stderr, "Hata: Taşıma birleştirme için bellek tahsis edilemedi.\n");
+        free(live_in); free(live_out); free(live_after); free(remove);
+        cfg_free(cfg);
+        return 0;
+    }
+    cfg_compute_liveness(cfg, live_in, live_out);
+
+    int coalesced = 0;
+    for (size_t b = 0; b < nb; b++) {
+        size_t first = cfg->blocks[b].first, end = cfg->blocks[b].end;
+        // Blok içi canlılık (geriye doğru); birleştirme bloğu değiştirdiğinde yeniden hesaplanır
+        int recompute = 1;
+        for (size_t i = first; i < end; i++) {
+            if (recompute) {
+                uint32_t live = live_out[b];
+                for (size_t k = end; k > first; k--) {
+                    live_after[k - 1] = live;
+                    if (statements[k - 1]->type == AST_INSTRUCTION && !remove[k - 1]) {
+                        RegisterEffects fx = cfg_instruction_register_effects(&statements[k - 1]->data.instruction);
+                        live = (live & ~fx.def) | fx.use;
+                    }
+                }
+                recompute = 0;
+            }
+
+            if (remove[i] || statements[i]->type != AST_INSTRUCTION) continue;
+            AstInstruction* mov = &statements[i]->data.instruction;
+            if (mov->opcode != TOKEN_MOV || mov->num_operands != 2 ||
+                mov->operands[0].type != OP_REGISTER || mov->operands[1].type != OP_REGISTER) {
+                continue;
+            }
+            int x = mov->operands[0].value.reg_index;
+            int y = mov->operands[1].value.reg_index;
+            if (x == y || (live_after[i] & (1u << y))) continue; // Ry kopyadan sonra da yaşıyor: çakışma
+
+            // Rx'in bu tanımdan başlayan yaşam aralığını bul. Aralık blok içinde bitmeli ve
+            // aralıkta Ry hiç kullanılmamalı; aksi halde iki değer aynı kaydediciye sığmaz.
+            size_t rename_end = i; // [i + 1, rename_end) aralığındaki Rx'ler Ry olur
+            int closed = 0;        // Yaşam aralığının sonu blok içinde bulundu
+            for (size_t k = i + 1; k < end; k++) {
+                if (remove[k] || statements[k]->type != AST_INSTRUCTION) continue;
+                const AstInstruction* instr = &statements[k]->data.instruction;
+                RegisterEffects fx = cfg_instruction_register_effects(instr);
+                if ((fx.use | fx.clobber) & (1u << y)) {
+                    // Tek istisna: Rx'i son kez okuyup Ry'ye yazan komut (örn: MOV Ry, Rx)
+                    if (!(fx.use & (1u << y)) && (fx.use & (1u << x)) && !(live_after[k] & (1u << x)) &&
+                        instr->opcode != TOKEN_SYSCALL && instr->opcode != TOKEN_CALL) {
+                        rename_end = k + 1;
+                        closed = 1;
+                    }
+                    break;
+                }
+                if (!((fx.use | fx.clobber) & (1u << x))) continue;
+                // Örtük okuma/yazma (SYSCALL, CALL, RET) kaydedici adına bağlıdır, yeniden adlandırılamaz
+                if (instr->opcode == TOKEN_SYSCALL || instr->opcode == TOKEN_CALL || instr->opcode == TOKEN_RET) break;
+                if (!(fx.use & (1u << x))) { // Rx okunmadan yeniden tanımlanıyor: aralık önceki komutta bitti
+                    rename_end = k;
+                    closed = 1;
+                    break;
+                }
+                rename_end = k + 1;
+                if (!(live_after[k] & (1u << x))) { // Rx'in son okuması
+                    closed = 1;
+                    break;
+                }
+            }
+            if (!closed || rename_end == i) continue; // Aralık bloktan taşıyor veya kopya hiç okunmuyor
+
+            // Rx -> Ry yeniden adlandır ve kopyayı sil
+            for (size_t k = i + 1; k < rename_end; k++) {
+                if (remove[k] || statements[k]->type != AST_INSTRUCTION) continue;
+                AstInstruction* instr = &statements[k]->data.instruction;
+                for (size_t o = 0; o < instr->num_operands; o++) {
+                    AstOperand* operand = &instr->operands[o];
+                    if (operand->type == OP_REGISTER && operand->value.reg_index == x) operand->value.reg_index = y;
+                }
+            }
+            remove[i] = 1;
+            coalesced++;
+            recompute = 1;
+        }
+    }
+
+    if (coalesced) {
+        remove_marked_statements(ast_root, remove);
+        fprintf(stdout, "Optimizer: %d kaydedici taşıması birleştirildi.\n", coalesced);
+    }
+    free(live_in); free(live_out); free(live_after); free(remove);
+    cfg_free(cfg);
+    return coalesced > 0;
+}
+
+// --- Satır İçi Açma (Inlining) ---
+
+// Maliyet modeli sabitleri (boyutlar komut sayısıdır)
+#define INLINE_ALWAYS_SIZE 3            // Bu kadar küçük gövdeler CALL+RET'ten ucuzdur; soğuk olsa da açılır
+#define INLINE_DEFAULT_MAX_SIZE 12      // Profil yokken açılabilecek en büyük gövde
+#define INLINE_HOT_MAX_SIZE 48          // Sıcak çağrı noktalarında açılabilecek en büyük gövde
+#define INLINE_SINGLE_SITE_MAX_SIZE 200 // Tek çağrı noktalı (orijinali silinebilen) alt programlar
+#define INLINE_HOT_PERCENT 10           // En sık çağrının bu yüzdesi kadar çalışan çağrı noktası sıcaktır
+#define INLINE_MIN_GROWTH 32            // Küçük programlar için en az büyüme bütçesi
+
+// Bir çağrı noktası için açma adayı
+typedef struct {
+    size_t call_index;      // CALL ifadesinin indeksi
+    int subroutine;         // Çağrılan alt program
+    long growth;            // Açma sonrası program boyutundaki değişim (komut)
+    double score;           // Kazanç / maliyet (büyük olan önce açılır)
+} InlineCandidate;
+
+static int compare_inline_candidates(const void* a, const void* b) {
+    const InlineCandidate* x = (const InlineCandidate*)a;
+    const InlineCandidate* y = (const InlineCandidate*)b;
+    if (x->score != y->score) return x->score > y->score ? -1 : 1;
+    return x->call_index < y->call_index ? -1 : (x->call_index > y->call_index); // Kararlı sıra
+}
+
+/**
+ * @brief Programın boyutuna göre kodu büyüten bir dönüşümün (satır içi açma, döngü açma)
+ * toplam büyüme bütçesini hesaplar.
+ * @param growth_percent Program boyutunun yüzdesi olarak izin verilen büyüme (seviyeye göre).
+ */
+static long inline_growth_budget(const AstNode* ast_root, int growth_percent) {
+    if (growth_percent <= 0) return 0; // Sadece programı küçülten açmalar
+    long size = 0;
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        if (ast_root->data.program.statements[i]->type == AST_INSTRUCTION) size++;
+    }
+    long budget = size * growth_percent / 100;
+    return budget < INLINE_MIN_GROWTH ? INLINE_MIN_GROWTH : budget;
+}
+
+/**
+ * @brief Alt program gövdesinin bir kopyasını oluşturur: etiketler yeniden adlandırılır,
+ * RET'ler dönüş etiketine JMP olur ve profil sayımları çağrı noktasına göre ölçeklenir.
+ * @param count Oluşturulan düğüm sayısı buraya yazılır.
+ * @return Kopya düğüm dizisi veya NULL hata durumunda.
+ */
+static AstNode** clone_subroutine_body(AstNode** statements, const CfgSubroutine* sub, const AstNode* call,
+                                       SymbolTable* symbol_table, size_t* count) {
+    size_t body_size = sub->end - sub->first;
+    AstNode** clone = (AstNode**)malloc(sizeof(AstNode*) * (body_size + 1));
+    char** old_names = (char**)malloc(sizeof(char*) * body_size);
+    char** new_names = (char**)malloc(sizeof(char*) * body_size);
+    size_t num_labels = 0;
+    *count = 0;
+    if (!clone || !old_names || !new_names) {
+        fprintf(stderr, "Hata: Satır içi açma için bellek tahsis edilemedi.\n");
+        free(clone); free(old_names); free(new_names);
+        return NULL;
+    }
+
+    // Profil: kopya, çağrı noktasının çalışma sayısı oranında sayım alır
+    uint64_t entry_count = 0;
+    for (size_t i = sub->first; i < sub->end; i++) {
+        if (statements[i]->type == AST_INSTRUCTION) {
+            if (statements[i]->data.instruction.has_profile) entry_count = statements[i]->data.instruction.profile_count;
+            break;
+        }
+    }
+    const AstInstruction* call_instr = &call->data.instruction;
+    double scale = (call_instr->has_profile && entry_count > 0)
+                       ? (double)call_instr->profile_count / (double)entry_count : 0.0;
+    if (scale > 1.0) scale = 1.0;
+
+    // 1. Gövde içinden başvurulan her etikete yeni bir isim ver; başvurulmayanlar
+    //    (genellikle giriş etiketi) kopyalanmaz, böylece gereksiz blok sınırı oluşmaz.
+    int ok = 1;
+    char name_buffer[64];
+    for (size_t i = sub->first; i < sub->end && ok; i++) {
+        if (statements[i]->type != AST_LABEL_DECLARATION) continue;
+        int referenced = 0;
+        for (size_t j = sub->first; j < sub->end && !referenced; j++) {
+            if (statements[j]->type != AST_INSTRUCTION) continue;
+            for (size_t o = 0; o < statements[j]->data.instruction.num_operands; o++) {
+                const AstOperand* operand = &statements[j]->data.instruction.operands[o];
+                if (operand->type == OP_LABEL_REF &&
+                    strcmp(operand->value.label_name, statements[i]->data.label_decl.name) == 0) {
+                    referenced = 1;
+                    break;
+                }
+            }
+        }
+        if (!referenced) continue;
+        cfg_make_unique_label(symbol_table, "__bsm_inl", name_buffer, sizeof(name_buffer));
+        old_names[num_labels] = statements[i]->data.label_decl.name;
+        new_names[num_labels] = strdup(name_buffer);
+        if (!new_names[num_labels] || !symbol_table_add_symbol(symbol_table, name_buffer, 0, 0, 0)) {
+            free(new_names[num_labels]);
+            ok = 0;
+            break;
+        }
+        num_labels++;
+    }
+
+    // 2. Dönüş etiketi (sadece gövdenin ortasında RET varsa gerekir)
+    char* return_label = NULL;
+    int last_is_ret = statements[sub->end - 1]->type == AST_INSTRUCTION &&
+                      statements[sub->end - 1]->data.instruction.opcode == TOKEN_RET;
+    if (ok && sub->num_returns > (size_t)last_is_ret) {
+        cfg_make_unique_label(symbol_table, "__bsm_inl_ret", name_buffer, sizeof(name_buffer));
+        return_label = strdup(name_buffer);
+        ok = return_label && symbol_table_add_symbol(symbol_table, name_buffer, 0, 0, 0);
+    }
+
+    // 3. İfadeleri kopyala
+    for (size_t i = sub->first; i < sub->end && ok; i++) {
+        AstNode* source = statements[i];
+        AstNode* copy = NULL;
+
+        if (source->type == AST_LABEL_DECLARATION) {
+            size_t k = 0;
+            while (k < num_labels && old_names[k] != source->data.label_decl.name) k++;
+            if (k == num_labels) continue; // Başvurulmayan etiket
+            copy = ast_label_declaration_create(new_names[k], source->line, source->column);
+            if (copy) copy->data.label_decl.unroll_pragma = source->data.label_decl.unroll_pragma;
+        } else if (source->data.instruction.opcode == TOKEN_RET) {
+            if (i + 1 == sub->end) continue; // Son RET: kopya çağrı noktasının ardına düşer
+            copy = ast_instruction_create(TOKEN_JMP, 1, source->line, source->column);
+            if (copy && !ast_operand_set_label(&copy->data.instruction.operands[0], return_label)) {
+                ast_node_free(copy);
+                copy = NULL;
+            }
+        } else {
+            copy = ast_node_clone(source);
+            for (size_t o = 0; copy && o < copy->data.instruction.num_operands; o++) {
+                AstOperand* operand = &copy->data.instruction.operands[o];
+                if (operand->type != OP_LABEL_REF) continue;
+                for (size_t k = 0; k < num_labels; k++) {
+                    if (strcmp(old_names[k], operand->value.label_name) == 0) {
+                        if (!ast_operand_set_label(operand, new_names[k])) {
+                            ast_node_free(copy);
+                            copy = NULL;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!copy) {
+            ok = 0;
+            break;
+        }
+        if (copy->type == AST_INSTRUCTION && copy->data.instruction.has_profile) {
+            AstInstruction* instr = &copy->data.instruction;
+            if (!call_instr->has_profile) {
+                instr->has_profile = 0;
+            } else {
+                uint64_t scaled = (uint64_t)((double)instr->profile_count * scale);
+                uint64_t scaled_taken = (uint64_t)((double)instr->profile_taken_count * scale);
+                // Orijinal gövde artık sadece kalan çağrı noktalarından çalışır
+                AstInstruction* original = &source->data.instruction;
+                original->profile_count -= scaled < original->profile_count ? scaled : original->profile_count;
+                original->profile_taken_count -= scaled_taken < original->profile_taken_count
+                                                     ? scaled_taken : original->profile_taken_count;
+                instr->profile_count = scaled;
+                instr->profile_taken_count = scaled_taken;
+            }
+        }
+        clone[(*count)++] = copy;
+    }
+
+    if (ok && return_label) {
+        AstNode* label = ast_label_declaration_create(return_label, call->line, call->column);
+        if (label) clone[(*count)++] = label;
+        else ok = 0;
+    }
+
+    for (size_t k = 0; k < num_labels; k++) free(new_names[k]);
+    free(old_names); free(new_names); free(return_label);
+    if (!ok) {
+        fprintf(stderr, "Hata: Alt program gövdesi kopyalanamadı.\n");
+        for (size_t k = 0; k < *count; k++) ast_node_free(clone[k]);
+        free(clone);
+        *count = 0;
+        return NULL;
+    }
+    return clone;
+}
+
+int optimize_inline_subroutines(AstNode* ast_root, SymbolTable* symbol_table, long* growth_budget) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !symbol_table || !growth_budget) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    CfgSubroutine* subs = NULL;
+    size_t num_subs = 0;
+    if (!cfg_find_subroutines(cfg, &subs, &num_subs) || num_subs == 0) {
+        cfg_free(cfg);
+        return 0;
+    }
+
+    size_t n = ast_root->data.program.num_statements;
+    AstNode** statements = ast_root->data.program.statements;
+    int* block_of = (int*)malloc(sizeof(int) * n);
+    InlineCandidate* candidates = (InlineCandidate*)malloc(sizeof(InlineCandidate) * n);
+    unsigned char* sub_cloned = (unsigned char*)calloc(num_subs, 1);    // Bu turda kopyalanan gövdeler
+    unsigned char* sub_modified = (unsigned char*)calloc(num_subs, 1);  // Bu turda içine açma yapılan gövdeler
+    size_t* sub_inlined_sites = (size_t*)calloc(num_subs, sizeof(size_t));
+    AstNode*** clones = (AstNode***)calloc(n, sizeof(AstNode**));       // Çağrı noktası -> kopya gövde
+    size_t* clone_sizes = (size_t*)calloc(n, sizeof(size_t));
+    unsigned char* remove = (unsigned char*)calloc(n, 1);
+    if (!block_of || !candidates || !sub_cloned || !sub_modified || !sub_inlined_sites || !clones ||
+        !clone_sizes || !remove) {
+        fprintf(stderr, "Hata: Satır içi açma için bellek tahsis edilemedi.\n");
+        free(block_of); free(candidates); free(sub_cloned); free(sub_modified);
+        free(sub_inlined_sites); free(clones); free(clone_sizes); free(remove);
+        cfg_free_subroutines(subs, num_subs);
+        cfg_free(cfg);
+        return 0;
+    }
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        for (size_t i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) block_of[i] = (int)b;
+    }
+
+    // 1. Adayları topla ve maliyet modeliyle puanla
+    uint64_t max_call_count = 0;
+    for (size_t i = 0; i < n; i++) {
+        const AstNode* st = statements[i];
+        if (st->type == AST_INSTRUCTION && st->data.instruction.opcode == TOKEN_CALL &&
+            st->data.instruction.has_profile && st->data.instruction.profile_count > max_call_count) {
+            max_call_count = st->data.instruction.profile_count;
+        }
+    }
+
+    size_t num_candidates = 0;
+    for (size_t i = 0; i < n; i++) {
+        int s = cfg_subroutine_of_call(cfg, subs, num_subs, statements[i]);
+        if (s < 0) continue;
+        const CfgSubroutine* sub = &subs[s];
+        const AstInstruction* call = &statements[i]->data.instruction;
+
+        // Yapısal koşullar: ardışık gövde, özyineleme yok, gövde sonundan dışarı düşme yok
+        const AstNode* last = statements[sub->end - 1];
+        if (!sub->contiguous || sub->is_recursive || sub->in_body[block_of[i]] ||
+            sub->num_instructions == 0 || last->type != AST_INSTRUCTION ||
+            (last->data.instruction.opcode != TOKEN_RET && last->data.instruction.opcode != TOKEN_JMP)) {
+            continue;
+        }
+
+        // Boyut: RET'ler JMP'ye dönüşür, sondaki RET ve CALL kaybolur
+        long body = (long)sub->num_instructions;
+        long growth = body - 1 - (last->data.instruction.opcode == TOKEN_RET ? 1 : 0);
+        int removes_original = sub->num_call_sites == 1 && !sub->has_side_entry && sub->entry_block != 0;
+        if (removes_original) growth -= body; // Orijinal gövde silinecek
+
+        int cold = call->has_profile && call->profile_count == 0;
+        int hot = call->has_profile && max_call_count > 0 &&
+                  call->profile_count * 100 >= max_call_count * INLINE_HOT_PERCENT;
+        long size_limit;
+        if (removes_original) size_limit = INLINE_SINGLE_SITE_MAX_SIZE;
+        else if (hot) size_limit = INLINE_HOT_MAX_SIZE;
+        else if (cold) size_limit = INLINE_ALWAYS_SIZE;
+        else size_limit = INLINE_DEFAULT_MAX_SIZE;
+        if (body > size_limit && body > INLINE_ALWAYS_SIZE) continue;
+
+        // Kazanç: kaldırılan CALL/RET çifti ve çağrı sınırında kaybolan bayrak/kaydedici bilgisi,
+        // çalışma sayısıyla ağırlıklandırılır. Küçülten açmalar her zaman önce gelir.
+        double frequency = call->has_profile ? (double)call->profile_count + 1.0 : 1.0;
+        InlineCandidate* c = &candidates[num_candidates++];
+        c->call_index = i;
+        c->subroutine = s;
+        c->growth = growth;
+        c->score = growth <= 0 ? 1e300 - (double)growth : frequency * 2.0 / (double)(growth + 1);
+    }
+    qsort(candidates, num_candidates, sizeof(InlineCandidate), compare_inline_candidates);
+
+    // 2. Bütçe içinde kalan ve birbirini bozmayan adayları seç, gövdeleri kopyala
+    int changed = 0;
+    for (size_t k = 0; k < num_candidates; k++) {
+        InlineCandidate* c = &candidates[k];
+        if (c->growth > 0 && c->growth > *growth_budget) continue;
+        if (sub_modified[c->subroutine]) continue; // Gövdesi bu turda değişiyor; kopyası eski olurdu
+
+        // Çağrı noktası bu turda kopyalanan bir gövdenin içindeyse atla
+        int conflict = 0;
+        for (size_t s = 0; s < num_subs && !conflict; s++) {
+            if (sub_cloned[s] && subs[s].in_body[block_of[c->call_index]]) conflict = 1;
+        }
+        if (conflict) continue;
+
+        clones[c->call_index] = clone_subroutine_body(statements, &subs[c->subroutine], statements[c->call_index],
+                                                      symbol_table, &clone_sizes[c->call_index]);
+        if (!clones[c->call_index]) continue;
+
+        fprintf(stdout, "Optimizer: '%s' alt programı satır içi açıldı (%d:%d, %zu komut).\n",
+                subs[c->subroutine].name ? subs[c->subroutine].name : "?",
+                statements[c->call_index]->line, statements[c->call_index]->column,
+                subs[c->subroutine].num_instructions);
+        sub_cloned[c->subroutine] = 1;
+        sub_inlined_sites[c->subroutine]++;
+        for (size_t s = 0; s < num_subs; s++) {
+            if (subs[s].in_body[block_of[c->call_index]]) sub_modified[s] = 1;
+        }
+        *growth_budget -= c->growth;
+        changed = 1;
+    }
+
+    // 3. Tüm çağrı noktaları açılan ve başka yoldan girilemeyen orijinal gövdeleri sil
+    for (size_t s = 0; s < num_subs; s++) {
+        const CfgSubroutine* sub = &subs[s];
+        if (!sub_cloned[s] || sub_inlined_sites[s] != sub->num_call_sites || sub->has_side_entry ||
+            sub->entry_block == 0 || !sub->contiguous) {
+            continue;
+        }
+        int nested_entry = 0; // Gövde içindeki başka bir etiket ayrıca CALL ediliyor mu?
+        for (size_t t = 0; t < num_subs; t++) {
+            if (t != s && sub->in_body[subs[t].entry_block]) nested_entry = 1;
+        }
+        if (nested_entry) continue;
+        for (size_t i = sub->first; i < sub->end; i++) remove[i] = 1;
+        fprintf(stdout, "Optimizer: Artık çağrılmayan '%s' alt programı kaldırıldı.\n", sub->name ? sub->name : "?");
+    }
+
+    // 4. Yeni ifade listesini oluştur
+    if (changed) {
+        size_t new_count = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (clones[i]) new_count += clone_sizes[i];
+            else if (!remove[i]) new_count++;
+        }
+        AstNode** new_statements = (AstNode**)malloc(sizeof(AstNode*) * (new_count ? new_count : 1));
+        if (!new_statements) {
+            fprintf(stderr, "Hata: Satır içi açma sonrası bellek tahsis edilemedi.\n");
+            for (size_t i = 0; i < n; i++) {
+                for (size_t k = 0; clones[i] && k < clone_sizes[i]; k++) ast_node_free(clones[i][k]);
+                free(clones[i]);
+            }
+            changed = 0;
+        } else {
+            size_t out = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (clones[i]) {
+                    for (size_t k = 0; k < clone_sizes[i]; k++) new_statements[out++] = clones[i][k];
+                    free(clones[i]);
+                    ast_node_free(statements[i]); // CALL
+                } else if (remove[i]) {
+                    ast_node_free(statements[i]);
+                } else {
+                    new_statements[out++] = statements[i];
+                }
+            }
+            free(ast_root->data.program.statements);
+            ast_root->data.program.statements = new_statements;
+            ast_root->data.program.num_statements = new_count;
+        }
+    }
+
+    free(block_of); free(candidates); free(sub_cloned); free(sub_modified);
+    free(sub_inlined_sites); free(clones); free(clone_sizes); free(remove);
+    cfg_free_subroutines(subs, num_subs);
+    cfg_free(cfg);
+    return changed;
+}
+
+// Bu optimizasyon, temel kontrol akışını anlamayı gerektirir.
+int optimize_jump_threading(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+    if (symbol_table == NULL) {
+        fprintf(stderr, "Hata: Jump threading için sembol tablosu gerekli.\n");
+        return 0;
+    }
+
+    int changed = 0;
+    calculate_virtual_addresses(ast_root, symbol_table); // Etiket adreslerini güncelleyelim
+
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        AstNode* current_statement = ast_root->data.program.statements[i];
+
+        if (current_statement->type == AST_INSTRUCTION &&
+            (current_statement->data.instruction.opcode == TOKEN_JMP ||
+             current_statement->data.instruction.opcode == TOKEN_JEQ ||
+             current_statement->data.instruction.opcode == TOKEN_JNE ||
+             current_statement->data.instruction.opcode == TOKEN_JLT ||
+             current_statement->data.instruction.opcode == TOKEN_JGT)) {
+            
+            // Bu bir atlama komutu ve bir etiket referansı içeriyor mu? (Semantik analiz kontrol etti)
+            if (current_statement->data.instruction.num_operands == 1 &&
+                current_statement->data.instruction.operands[0].type == OP_LABEL_REF) {
+                
+                char* target_label_name = current_statement->data.instruction.operands[0].value.label_name;
+                SymbolEntry* target_entry = symbol_table_lookup_symbol(symbol_table, target_label_name);
+
+                if (target_entry) {
+                    // Atladığı adresin hemen sonrasındaki komut bir JMP mi?
+                    // target_entry->address, etiketin başladığı sanal adres
+                    // Bu adresi, AstNode'lara eklediğimiz 'virtual_address' ile eşleştirmemiz gerekir.
+
+                    // Bu optimizasyon, özellikle JMP'den sonra doğrudan bir etiket ve o etiketin 
+                    // hemen altında başka bir JMP varsa uygulanır.
+                    // Örnek: JMP LabelA; ... LabelA: JMP LabelB
+                    // Bu durumun tespiti biraz karmaşıktır ve AST'nin düz bir listesi üzerinden zordur.
+                    // Daha çok bir kontrol akış grafiği (CFG) gerektirir.
+                    // Basit bir yaklaşım için: Eğer bir etiket sadece bir JMP'den sonra geliyorsa
+                    // ve o etiketteki ilk komut da bir JMP ise.
+
+                    // Bu optimizasyon için aşağıdaki mantık bir başlangıç noktasıdır:
+                    // 1. Hedef etiketin hemen arkasındaki ifadenin bir JMP komutu olup olmadığını bul
+                    AstNode* target_label_node = NULL;
+                    size_t target_label_index = -1;
+                    for (size_t k = 0; k < ast_root->data.program.num_statements; k++) {
+                        if (ast_root->data.program.statements[k]->type == AST_LABEL_DECLARATION &&
+                            strcmp(ast_root->data.program.statements[k]->data.label_decl.name, target_label_name) == 0) {
+                            target_label_node = ast_root->data.program.statements[k];
+                            target_label_index = k;
+                            break;
+                        }
+                    }
+
+                    if (target_label_node && (target_label_index + 1) < ast_root->data.program.num_statements) {
+                        AstNode* next_statement = ast_root->data.program.statements[target_label_index + 1];
+                        if (next_statement->type == AST_INSTRUCTION && next_statement->data.instruction.opcode == TOKEN_JMP) {
+                            // "JMP LabelA; ... LabelA: JMP LabelB" durumu
+                            // İlk JMP'yi doğrudan LabelB'ye atlayacak şekilde değiştir.
+                            if (next_statement->data.instruction.num_operands == 1 &&
+                                next_statement->data.instruction.operands[0].type == OP_LABEL_REF) {
+                                
+                                char* final_target_label = next_statement->data.instruction.operands[0].value.label_name;
+
+                                // Mevcut JMP komutunun operandını değiştir
+                                free(current_statement->data.instruction.operands[0].value.label_name); // Eski label adını free et
+                                current_statement->data.instruction.operands[0].value.label_name = strdup(final_target_label); // Yeni label adını kopyala
+                                
+                                fprintf(stdout, "Optimizer: Atlama kısaltma yapıldı (%s, %d:%d -> %s).\n",
+                                        token_type_to_string(current_statement->data.instruction.opcode),
+                                        current_statement->line, current_statement->column, final_target_label);
+                                changed = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+
+// --- Karşılaştırma Zinciri İndirgeme (Switch Lowering) ---
+
+#define DISPATCH_MIN_CASES 4            // Daha kısa zincirler doğrusal kalır
+#define DISPATCH_LINEAR_MAX 3           // Ağacın yapraklarında doğrusal karşılaştırılan en fazla anahtar
+#define DISPATCH_TABLE_MIN_DENSITY 40   // Atlama tablosu için anahtarların aralığı doldurma yüzdesi
+#define DISPATCH_TABLE_MAX_ENTRIES 4096 // Atlama tablosunun en fazla giriş sayısı
+#define DISPATCH_SIZE_MIN_DENSITY 50    // -Os: tablo ancak zincirden küçükse kullanılır
+
+// Zincirdeki bir durum (anahtar -> hedef etiket)
+typedef struct {
+    int64_t key;
+    const char* label;      // Hedef etiket adı (orijinal JEQ operandına aittir)
+    uint64_t count;         // Profil: bu anahtarla atlanma sayısı
+} DispatchCase;
+
+static int compare_dispatch_cases(const void* a, const void* b) {
+    const DispatchCase* x = (const DispatchCase*)a;
+    const DispatchCase* y = (const DispatchCase*)b;
+    return x->key < y->key ? -1 : (x->key > y->key);
+}
+
+/**
+ * @brief Profil sayımlı (varsa) yeni bir komut oluşturur.
+ */
+static AstNode* dispatch_instruction(TokenType opcode, size_t num_operands, const AstNode* origin,
+                                     int has_profile, uint64_t count, uint64_t taken) {
+    AstNode* node = ast_instruction_create(opcode, num_operands, origin->line, origin->column);
+    if (node && has_profile) {
+        node->data.instruction.has_profile = 1;
+        node->data.instruction.profile_count = count;
+        node->data.instruction.profile_taken_count = taken;
+    }
+    return node;
+}
+
+static AstNode* dispatch_compare(int reg, int64_t key, const AstNode* origin, int has_profile, uint64_t count) {
+    AstNode* cmp = dispatch_instruction(TOKEN_CMP, 2, origin, has_profile, count, 0);
+    if (cmp) {
+        cmp->data.instruction.operands[0].type = OP_REGISTER;
+        cmp->data.instruction.operands[0].value.reg_index = reg;
+        cmp->data.instruction.operands[1].type = OP_INTEGER;
+        cmp->data.instruction.operands[1].value.int_value = key;
+    }
+    return cmp;
+}
+
+static AstNode* dispatch_jump(TokenType opcode, const char* label, const AstNode* origin, int has_profile,
+                              uint64_t count, uint64_t taken) {
+    AstNode* jump = dispatch_instruction(opcode, 1, origin, has_profile, count, taken);
+    if (jump && !ast_operand_set_label(&jump->data.instruction.operands[0], label)) {
+        ast_node_free(jump);
+        return NULL;
+    }
+    return jump;
+}
+
+/**
+ * @brief Sıralı anahtarlar için dengeli karşılaştırma ağacı üretir.
+ * Her iç düğüm "CMP R, orta; JEQ L_orta; JLT sol" şeklindedir; sağ alt ağaç hemen
+ * ardından, sol alt ağaç yeni bir etiketle sonra gelir. Yapraklarda en fazla
+ * DISPATCH_LINEAR_MAX anahtar doğrusal karşılaştırılır. Profil sayımları yaklaşıktır:
+ * varsayılan hedefe giden sayım her düğümde tam olarak eklenir (üst sınır).
+ * @param jump_to_default Son yaprak varsayılan bloğa atlamalı mı (0: hemen ardından gelir).
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int dispatch_emit_tree(StatementList* out, const DispatchCase* cases, size_t count, int reg,
+                              const char* default_label, uint64_t default_count, int jump_to_default,
+                              const AstNode* origin, int has_profile, SymbolTable* symbol_table) {
+    uint64_t total = default_count;
+    for (size_t i = 0; i < count; i++) total += cases[i].count;
+
+    if (count <= DISPATCH_LINEAR_MAX) {
+        uint64_t remaining = total;
+        for (size_t i = 0; i < count; i++) {
+            if (!statement_list_append(out, dispatch_compare(reg, cases[i].key, origin, has_profile, remaining)) ||
+                !statement_list_append(out, dispatch_jump(TOKEN_JEQ, cases[i].label, origin, has_profile,
+                                                  remaining, cases[i].count))) {
+                return 0;
+            }
+            remaining -= cases[i].count < remaining ? cases[i].count : remaining;
+        }
+        if (jump_to_default) {
+            return statement_list_append(out, dispatch_jump(TOKEN_JMP, default_label, origin, has_profile, remaining, 0));
+        }
+        return 1;
+    }
+
+    size_t mid = count / 2;
+    uint64_t left_count = 0;
+    for (size_t i = 0; i < mid; i++) left_count += cases[i].count;
+
+    char left_label[64];
+    cfg_make_unique_label(symbol_table, "__bsm_sw", left_label, sizeof(left_label));
+    if (!symbol_table_add_symbol(symbol_table, left_label, 0, 0, 0)) return 0;
+
+    return statement_list_append(out, dispatch_compare(reg, cases[mid].key, origin, has_profile, total)) &&
+           statement_list_append(out, dispatch_jump(TOKEN_JEQ, cases[mid].label, origin, has_profile, total,
+                                            cases[mid].count)) &&
+           statement_list_append(out, dispatch_jump(TOKEN_JLT, left_label, origin, has_profile,
+                                            total - cases[mid].count, left_count)) &&
+           dispatch_emit_tree(out, cases + mid + 1, count - mid - 1, reg, default_label, default_count, 1,
+                              origin, has_profile, symbol_table) &&
+           statement_list_append(out, ast_label_declaration_create(left_label, origin->line, origin->column)) &&
+           dispatch_emit_tree(out, cases, mid, reg, default_label, default_count, jump_to_default,
+                              origin, has_profile, symbol_table);
+}
+
+/**
+ * @brief Bloğun "CMP R, sabit; JEQ L" ile bitip bitmediğini kontrol eder.
+ * @param only_compare 1 ise blok sadece bu iki komuttan (etiketsiz) oluşmalıdır.
+ * @return CMP'nin ifade indeksi veya eşleşmezse -1.
+ */
+static long dispatch_chain_link(const Cfg* cfg, int block, int reg, int only_compare) {
+    const BasicBlock* bb = &cfg->blocks[block];
+    AstNode** statements = cfg->program->data.program.statements;
+    if (bb->end - bb->first < 2) return -1;
+    const AstNode* cmp = statements[bb->end - 2];
+    const AstNode* jeq = statements[bb->end - 1];
+    if (cmp->type != AST_INSTRUCTION || jeq->type != AST_INSTRUCTION) return -1;
+    if (only_compare && bb->end - bb->first != 2) return -1;
+
+    const AstInstruction* c = &cmp->data.instruction;
+    const AstInstruction* j = &jeq->data.instruction;
+    if (c->opcode != TOKEN_CMP || c->num_operands != 2 || j->opcode != TOKEN_JEQ || j->num_operands != 1 ||
+        j->operands[0].type != OP_LABEL_REF || c->operands[0].type != OP_REGISTER ||
+        (c->operands[1].type != OP_INTEGER && c->operands[1].type != OP_HEX_INTEGER)) {
+        return -1;
+    }
+    if (reg >= 0 && c->operands[0].value.reg_index != reg) return -1;
+    return (long)(bb->end - 2);
+}
+
+/**
+ * @brief Bir bloktan başlayan karşılaştırma zincirini bulur ve uygunsa indirgenmiş kodu üretir.
+ * @param next_block Zincirden sonraki ilk blok buraya yazılır (taramanın devamı için).
+ * @return İndirgeme yapıldıysa 1, yapılmadıysa 0, bellek hatasında -1.
+ */
+static int lower_dispatch_chain(const Cfg* cfg, int head, const uint32_t* live_in, SymbolTable* symbol_table,
+                                int optimize_for_size, StatementReplacement* replacement, int* next_block) {
+    AstNode** statements = cfg->program->data.program.statements;
+    *next_block = head + 1;
+
+    long first = dispatch_chain_link(cfg, head, -1, 0);
+    if (first < 0) return 0;
+    const AstInstruction* head_cmp = &statements[first]->data.instruction;
+    const AstInstruction* head_jeq = &statements[first + 1]->data.instruction;
+    int reg = head_cmp->operands[0].value.reg_index;
+    if (reg < 0 || reg >= CFG_NUM_REGISTERS) return 0;
+
+    // 1. Zinciri uzat: sonraki bloklar etiketsiz, tek öncüllü ve sadece "CMP R, k; JEQ L" olmalı
+    int last = head;
+    while (last + 1 < (int)cfg->num_blocks) {
+        int candidate = last + 1;
+        if (cfg->blocks[candidate].num_preds != 1 || cfg_block_label(cfg, candidate) ||
+            dispatch_chain_link(cfg, candidate, reg, 1) < 0) {
+            break;
+        }
+        last = candidate;
+    }
+    *next_block = last + 1;
+    int default_block = last + 1;
+    size_t num_links = (size_t)(last - head + 1);
+    if (num_links < DISPATCH_MIN_CASES || default_block >= (int)cfg->num_blocks ||
+        cfg_find_succ_edge(cfg, last, CFG_EDGE_FALLTHROUGH) < 0) {
+        return 0;
+    }
+
+    // 2. Durumları topla; tekrar eden anahtarlarda ilki geçerlidir (sonrakiler hiç alınmaz)
+    DispatchCase* cases = (DispatchCase*)malloc(sizeof(DispatchCase) * num_links);
+    if (!cases) return -1;
+    size_t num_cases = 0;
+    int has_profile = head_jeq->has_profile;
+    uint64_t default_count = 0;
+    for (int b = head; b <= last; b++) {
+        const AstInstruction* cmp = &statements[cfg->blocks[b].end - 2]->data.instruction;
+        const AstInstruction* jeq = &statements[cfg->blocks[b].end - 1]->data.instruction;
+        int target = cfg_block_of_label(cfg, jeq->operands[0].value.label_name);
+        // Hedeflerde bayraklar okunuyorsa (zincirin CMP sonucu) indirgeme davranışı değiştirir
+        if (target < 0 || (live_in[target] & CFG_FLAGS_BIT)) {
+            free(cases);
+            return 0;
+        }
+        has_profile = has_profile && jeq->has_profile;
+        int duplicate = 0;
+        for (size_t k = 0; k < num_cases && !duplicate; k++) {
+            duplicate = cases[k].key == cmp->operands[1].value.int_value;
+        }
+        if (!duplicate) {
+            cases[num_cases].key = cmp->operands[1].value.int_value;
+            cases[num_cases].label = jeq->operands[0].value.label_name;
+            cases[num_cases].count = jeq->profile_taken_count;
+            num_cases++;
+        }
+        if (b == last) {
+            default_count = jeq->profile_count > jeq->profile_taken_count
+                                ? jeq->profile_count - jeq->profile_taken_count : 0;
+        }
+    }
+    if (live_in[default_block] & CFG_FLAGS_BIT || num_cases < DISPATCH_MIN_CASES) {
+        free(cases);
+        return 0;
+    }
+    qsort(cases, num_cases, sizeof(DispatchCase), compare_dispatch_cases);
+
+    // 3. Tablo mu ağaç mı? Aralık (max - min + 1) taşmayı önlemek için işaretsiz hesaplanır.
+    uint64_t span = (uint64_t)cases[num_cases - 1].key - (uint64_t)cases[0].key;
+    int min_density = optimize_for_size ? DISPATCH_SIZE_MIN_DENSITY : DISPATCH_TABLE_MIN_DENSITY;
+    int use_table = span < DISPATCH_TABLE_MAX_ENTRIES && num_cases * 100 >= (span + 1) * (uint64_t)min_density;
+    if (!use_table && optimize_for_size) {
+        free(cases);
+        return 0; // Karşılaştırma ağacı zincirden büyüktür
+    }
+
+    // 4. Varsayılan blok etiketsizse yeni bir etiket gerekir (zincirin hemen ardından gelir)
+    const AstNode* origin = statements[first];
+    const char* default_label = cfg_block_label(cfg, default_block);
+    char label_buffer[64];
+    AstNode* new_default_label = NULL;
+    if (!default_label) {
+        cfg_make_unique_label(symbol_table, "__bsm_sw", label_buffer, sizeof(label_buffer));
+        new_default_label = ast_label_declaration_create(label_buffer, origin->line, origin->column);
+        if (!new_default_label || !symbol_table_add_symbol(symbol_table, label_buffer, 0, 0, 0)) {
+            ast_node_free(new_default_label);
+            free(cases);
+            return -1;
+        }
+        default_label = new_default_label->data.label_decl.name;
+    }
+
+    StatementList out = {NULL, 0, 0};
+    int ok;
+    if (use_table) {
+        // JTAB R, min, Varsayılan, L0..Ln-1 (aralıktaki boşluklar varsayılana gider)
+        size_t entries = (size_t)span + 1;
+        AstNode* jtab = dispatch_instruction(TOKEN_JTAB, entries + 3, origin, has_profile,
+                                             head_jeq->profile_count, 0);
+        ok = jtab != NULL;
+        if (ok) {
+            AstInstruction* instr = &jtab->data.instruction;
+            instr->operands[0].type = OP_REGISTER;
+            instr->operands[0].value.reg_index = reg;
+            instr->operands[1].type = OP_INTEGER;
+            instr->operands[1].value.int_value = cases[0].key;
+            for (size_t o = 2; o < instr->num_operands; o++) {
+                instr->operands[o].type = OP_LABEL_REF;
+                instr->operands[o].value.label_name = NULL;
+            }
+            ok = ast_operand_set_label(&instr->operands[2], default_label);
+            size_t next_case = 0;
+            for (size_t e = 0; ok && e < entries; e++) {
+                const char* target = default_label;
+                if (next_case < num_cases && (uint64_t)cases[next_case].key - (uint64_t)cases[0].key == e) {
+                    target = cases[next_case++].label;
+                }
+                ok = ast_operand_set_label(&instr->operands[e + 3], target);
+            }
+            ok = statement_list_append(&out, jtab) && ok;
+        }
+    } else {
+        ok = dispatch_emit_tree(&out, cases, num_cases, reg, default_label, default_count, 0,
+                                origin, has_profile, symbol_table);
+    }
+    if (ok && new_default_label) {
+        ok = statement_list_append(&out, new_default_label);
+        new_default_label = NULL;
+    }
+    if (!ok) {
+        ast_node_free(new_default_label);
+        statement_list_free(&out);
+        free(cases);
+        return -1;
+    }
+
+    if (use_table) {
+        fprintf(stdout, "Optimizer: %zu durumlu karşılaştırma zinciri atlama tablosuna dönüştürüldü "
+                        "(R%d, %zu giriş, %d:%d).\n",
+                num_cases, reg, (size_t)span + 1, origin->line, origin->column);
+    } else {
+        fprintf(stdout, "Optimizer: %zu durumlu karşılaştırma zinciri dengeli karşılaştırma ağacına "
+                        "dönüştürüldü (R%d, %d:%d).\n",
+                num_cases, reg, origin->line, origin->column);
+    }
+    replacement->first = (size_t)first;
+    replacement->end = cfg->blocks[last].end;
+    replacement->emitted = out;
+    free(cases);
+    return 1;
+}
+
+int optimize_dispatch_chains(AstNode* ast_root, SymbolTable* symbol_table, int optimize_for_size) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !symbol_table) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    StatementReplacement* replacements = (StatementReplacement*)malloc(sizeof(StatementReplacement) * (nb ? nb : 1));
+    if (!live_in || !live_out || !replacements) {
+        fprintf(stderr, "Hata: Karşılaştırma zinciri indirgeme için bellek tahsis edilemedi.\n");
+        free(live_in); free(live_out); free(replacements);
+        cfg_free(cfg);
+        return 0;
+    }
+    cfg_compute_liveness(cfg, live_in, live_out);
+
+    // 1. Zincirleri bul ve yerlerine gelecek kodu üret (zincirler birbiriyle çakışmaz)
+    size_t num_replacements = 0;
+    int failed = 0;
+    for (int b = 0; b < (int)nb && !failed;) {
+        int next_block;
+        int result = lower_dispatch_chain(cfg, b, live_in, symbol_table, optimize_for_size,
+                                          &replacements[num_replacements], &next_block);
+        if (result < 0) failed = 1;
+        else if (result > 0) num_replacements++;
+        b = next_block;
+    }
+    if (failed) {
+        fprintf(stderr, "Hata: Karşılaştırma zinciri indirgenemedi (bellek hatası).\n");
+    }
+
+    // 2. Yeni ifade listesini oluştur
+    if (!failed && num_replacements > 0 && !apply_statement_replacements(ast_root, replacements, num_replacements)) {
+        fprintf(stderr, "Hata: Karşılaştırma zinciri indirgeme sonrası bellek tahsis edilemedi.\n");
+        failed = 1;
+    }
+    if (failed) {
+        for (size_t r = 0; r < num_replacements; r++) statement_list_free(&replacements[r].emitted);
+        num_replacements = 0;
+    }
+
+    free(live_in); free(live_out); free(replacements);
+    cfg_free(cfg);
+    return num_replacements > 0;
+}
+
+// --- Koşullu Seçime Dönüştürme (If-Conversion) ---
+// Kısa üçgen ve elmas biçimli dallanmalar, bayrakları okuyan SELcc komutlarına çevrilir:
+//   Üçgen:  Jcc L; MOV...; L:                  ->  SEL!cc...
+//   Elmas:  Jcc E; MOV...; JMP J; E: MOV...; J: ->  SEL!cc...; SELcc...
+// Koşullar karşılıklı dışlayan olduğundan her durumda sadece bir kolun seçimleri etkili olur.
+// Dönüşüm hedef maliyet modeline göre yapılır: iyi tahmin edilen dallanma çoğu zaman
+// seçimden ucuzdur, seçim komutu olmayan hedeflerde (temel RISC-V) seçim bir maske dizisidir.
+
+#define IFCONV_MAX_MOVES 4                  // Bir koldaki en fazla MOV sayısı
+#define IFCONV_UNKNOWN_MISPREDICT_PERCENT 25 // Profil yokken varsayılan yanlış tahmin oranı
+
+// Dönüştürülebilir bir kolun (blok) özeti
+typedef struct {
+    size_t first_move;      // İlk MOV'un ifade indeksi
+    size_t num_moves;       // MOV sayısı
+    size_t num_immediates;  // Kaynağı sabit olan MOV sayısı
+    long label;             // Baştaki etiketin ifade indeksi veya -1
+    long jump;              // Sondaki JMP'nin ifade indeksi veya -1
+} IfConvArm;
+
+/**
+ * @brief Koşullu atlamanın koşuluna (negate ise tersine) karşılık gelen seçim komutunu döndürür.
+ */
+static TokenType select_for_condition(TokenType jcc, int negate) {
+    switch (jcc) {
+        case TOKEN_JEQ: return negate ? TOKEN_SELNE : TOKEN_SELEQ;
+        case TOKEN_JNE: return negate ? TOKEN_SELEQ : TOKEN_SELNE;
+        case TOKEN_JLT: return negate ? TOKEN_SELGE : TOKEN_SELLT;
+        case TOKEN_JGT: return negate ? TOKEN_SELLE : TOKEN_SELGT;
+        default: return TOKEN_UNKNOWN;
+    }
+}
+
+/**
+ * @brief Bloğun en fazla bir etiket, kaydediciye yazan MOV'lar ve isteğe bağlı sondaki
+ * JMP'den oluşup oluşmadığını kontrol eder.
+ * @return Blok uygunsa 1 (özet arm'a yazılır), aksi takdirde 0.
+ */
+static int ifconv_scan_arm(const Cfg* cfg, int block, IfConvArm* arm) {
+    AstNode** statements = cfg->program->data.program.statements;
+    const BasicBlock* bb = &cfg->blocks[block];
+    arm->num_moves = 0;
+    arm->num_immediates = 0;
+    arm->label = -1;
+    arm->jump = -1;
+    for (size_t i = bb->first; i < bb->end; i++) {
+        const AstNode* statement = statements[i];
+        if (statement->type == AST_LABEL_DECLARATION) {
+            if (arm->label >= 0 || arm->num_moves > 0) return 0;
+            arm->label = (long)i;
+            continue;
+        }
+        if (statement->type != AST_INSTRUCTION) return 0;
+        const AstInstruction* instr = &statement->data.instruction;
+        if (instr->opcode == TOKEN_JMP && i + 1 == bb->end) {
+            arm->jump = (long)i;
+            continue;
+        }
+        if (instr->opcode != TOKEN_MOV || instr->num_operands != 2 || instr->operands[0].type != OP_REGISTER) {
+            return 0;
+        }
+        int immediate = instr->operands[1].type == OP_INTEGER || instr->operands[1].type == OP_HEX_INTEGER;
+        if (!immediate && instr->operands[1].type != OP_REGISTER) return 0;
+        if (arm->num_moves == 0) arm->first_move = i;
+        arm->num_moves++;
+        arm->num_immediates += (size_t)immediate;
+    }
+    return arm->num_moves <= IFCONV_MAX_MOVES;
+}
+
+/**
+ * @brief Programda etikete yapılan başvuru sayısını döndürür (atlamalar, CALL, JTAB, ...).
+ */
+static size_t count_label_references(const AstNode* ast_root, const char* label_name) {
+    size_t count = 0;
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        const AstNode* statement = ast_root->data.program.statements[i];
+        if (statement->type != AST_INSTRUCTION) continue;
+        const AstInstruction* instr = &statement->data.instruction;
+        for (size_t o = 0; o < instr->num_operands; o++) {
+            if (instr->operands[o].type == OP_LABEL_REF &&
+                strcmp(instr->operands[o].value.label_name, label_name) == 0) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Dallanmalı ve dallanmasız kodun beklenen maliyetlerini karşılaştırır.
+ * Hız için birim "yüzde x çevrim"dir (olasılıklar tamsayı yüzde olarak tutulur); boyut için komut sayısı.
+ * Yanlış tahmin oranı profilden min(p, 1 - p) olarak kestirilir (p: atlanma oranı).
+ * @return Dönüşüm kârlıysa 1.
+ */
+static int ifconv_profitable(const TargetCostModel* model, const AstInstruction* jcc, const IfConvArm* fall,
+                             const IfConvArm* taken, int optimize_for_size) {
+    size_t num_moves = fall->num_moves + (taken ? taken->num_moves : 0);
+    size_t num_immediates = fall->num_immediates + (taken ? taken->num_immediates : 0);
+    long branchless = (long)num_moves * model->select_cost + (long)num_immediates * model->select_immediate_cost;
+
+    if (optimize_for_size) {
+        // Seçim maliyeti komut sayısına yaklaşık eşittir (maske dizisi birkaç komuttur)
+        long branchy = (long)num_moves + 1 + (taken ? 1 : 0);
+        return branchless <= branchy;
+    }
+
+    long taken_percent = 50, mispredict_percent = IFCONV_UNKNOWN_MISPREDICT_PERCENT;
+    if (jcc->has_profile && jcc->profile_count > 0) {
+        taken_percent = (long)(jcc->profile_taken_count * 100 / jcc->profile_count);
+        if (taken_percent > 100) taken_percent = 100;
+        mispredict_percent = taken_percent < 100 - taken_percent ? taken_percent : 100 - taken_percent;
+    }
+    long fall_percent = 100 - taken_percent;
+    long branchy = 100 * model->branch_cost + mispredict_percent * model->mispredict_penalty +
+                   fall_percent * (long)fall->num_moves; // MOV: 1 çevrim
+    if (taken) {
+        branchy += fall_percent * model->branch_cost + taken_percent * (long)taken->num_moves; // Koldan çıkan JMP
+    }
+    return 100 * branchless < branchy;
+}
+
+/**
+ * @brief Bir kolun MOV'larını seçime çevirir; seçimler her zaman çalıştığından Jcc'nin profilini alırlar.
+ */
+static void ifconv_rewrite_arm(AstNode** statements, const IfConvArm* arm, TokenType select,
+                               const AstInstruction* jcc) {
+    for (size_t i = arm->first_move; i < arm->first_move + arm->num_moves; i++) {
+        AstInstruction* instr = &statements[i]->data.instruction;
+        instr->opcode = select;
+        instr->has_profile = jcc->has_profile;
+        instr->profile_count = jcc->profile_count;
+        instr->profile_taken_count = 0;
+    }
+}
+
+int optimize_if_conversion(AstNode* ast_root, TargetArchitecture arch, int optimize_for_size) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    const TargetCostModel* model = target_cost_model(arch);
+    AstNode** statements = ast_root->data.program.statements;
+    unsigned char* remove = (unsigned char*)calloc(ast_root->data.program.num_statements + 1, 1);
+    if (!remove) {
+        fprintf(stderr, "Hata: Koşullu seçime dönüştürme için bellek tahsis edilemedi.\n");
+        cfg_free(cfg);
+        return 0;
+    }
+
+    int converted = 0;
+    for (size_t b = 0; b + 2 < nb; b++) {
+        AstNode* branch = cfg_block_last_instruction(cfg, (int)b);
+        if (!branch || !cfg_is_conditional_branch(branch->data.instruction.opcode) ||
+            branch->data.instruction.num_operands != 1 ||
+            branch->data.instruction.operands[0].type != OP_LABEL_REF) {
+            continue;
+        }
+        const AstInstruction* jcc = &branch->data.instruction;
+        int then_block = (int)b + 1;
+        int target = cfg_block_of_label(cfg, jcc->operands[0].value.label_name);
+        IfConvArm then_arm, else_arm;
+        if (cfg_find_succ_edge(cfg, (int)b, CFG_EDGE_FALLTHROUGH) < 0 || cfg->blocks[then_block].num_preds != 1 ||
+            target != then_block + 1 || !ifconv_scan_arm(cfg, then_block, &then_arm) || then_arm.label >= 0) {
+            continue;
+        }
+
+        int diamond = then_arm.jump >= 0;
+        if (diamond) {
+            // Else kolu Jcc hedefidir: sadece Jcc'den girilmeli ve birleşme bloğuna düşmeli
+            const AstInstruction* jmp = &statements[then_arm.jump]->data.instruction;
+            int join = target + 1;
+            if (jmp->num_operands != 1 || jmp->operands[0].type != OP_LABEL_REF ||
+                join >= (int)nb || cfg_block_of_label(cfg, jmp->operands[0].value.label_name) != join ||
+                cfg->blocks[target].num_preds != 1 || !ifconv_scan_arm(cfg, target, &else_arm) ||
+                else_arm.jump >= 0 || else_arm.num_moves == 0 ||
+                count_label_references(ast_root, jcc->operands[0].value.label_name) != 1) {
+                continue; // Etikete CALL vb. ile de başvuruluyorsa orada seçimler yanlış koşulla çalışırdı
+            }
+        } else if (then_arm.num_moves == 0) {
+            continue;
+        }
+        if (!ifconv_profitable(model, jcc, &then_arm, diamond ? &else_arm : NULL, optimize_for_size)) continue;
+
+        // Düşme kolu koşul sağlanmadığında, atlama kolu sağlandığında çalışır
+        ifconv_rewrite_arm(statements, &then_arm, select_for_condition(jcc->opcode, 1), jcc);
+        if (diamond) {
+            ifconv_rewrite_arm(statements, &else_arm, select_for_condition(jcc->opcode, 0), jcc);
+            remove[then_arm.jump] = 1;
+            remove[else_arm.label] = 1;
+        }
+        fprintf(stdout, "Optimizer: %s dallanma koşullu seçime dönüştürüldü (%d:%d, %zu seçim).\n",
+                diamond ? "Elmas" : "Üçgen", branch->line, branch->column,
+                then_arm.num_moves + (diamond ? else_arm.num_moves : 0));
+        remove[cfg->blocks[b].end - 1] = 1;
+        converted++;
+        b = (size_t)(diamond ? target : then_block); // Değiştirilen kollar yeniden incelenmez
+    }
+
+    if (converted) remove_marked_statements(ast_root, remove);
+    free(remove);
+    cfg_free(cfg);
+    return converted > 0;
+}
+
+// --- Döngü Açma (Loop Unrolling) ---
+// Tek bloklu sayaç döngüleri hedeflenir (doğal döngü analizinde gövdesi başlığından ibaret olanlar):
+//   H:  S              ; gövde: sayaç i tek bir "ADD i, c" veya "SUB i, c" ile ilerler (c > 0)
+//       CMP i, b       ; b sabit veya döngüde değişmeyen bir kaydedici
+//       Jcc H          ; ADD ile JLT, SUB ile JGT (sabit tur sayısında JEQ/JNE de olabilir)
+// Tur sayısı derleme zamanında biliniyorsa döngü tamamen açılır (S x T). Aksi halde gövde U kez
+// kopyalanır; kalan turlar orijinal döngüde çalışır (K = (U-1)*c, b' = b -/+ K):
+//   H:  [b = b']  CMP i, b'  Jcc M  [b = b]  ; en az U tur kaldı mı?
+//   R:  S  CMP i, b  Jcc R  JMP X            ; kalan turlar
+//   M:  S x U  CMP i, b'  Jcc M              ; U turda bir karşılaştırma
+//       [b = b]  CMP i, b  Jcc R
+//   X:
+// b sabitse b' derleme zamanında hesaplanır ve taşıyorsa döngü kısmi açılmaz. Kaydediciyse geçici
+// olarak kaydırılır ve gövde b'yi okumamalıdır; kaydırma taşacaksa (b, en küçük/en büyük değere K'dan
+// yakın) çalışma zamanında M atlanır:
+//   yukarı sayan:  SUB b, K  CMP b, MAX-K  JGT G  CMP i, b  JLT M  G: ADD b, K  R: ...
+//   aşağı sayan:   CMP b, MAX-K  JGT R  ADD b, K  CMP i, b  JGT M  SUB b, K  R: ...
+// Açılan döngülerin etiketleri UNROLL_LABEL_PREFIX ile başlar ve yeniden açılmaz.
+
+#define UNROLL_LABEL_PREFIX "__bsm_unroll"
+#define UNROLL_MAX_STEP 0x7FFFFFFFLL    // Daha büyük adımlarda K hesaplanmaz (taşma koruması)
+#define UNROLL_VALUE_SEARCH_DEPTH 8     // Giriş değeri aranırken geriye yürünecek en fazla blok
+
+// Çözümlenmiş bir sayaç döngüsü
+typedef struct {
+    int block;                  // Döngünün tek bloğu (başlık)
+    const char* name;           // Başlık etiketi (mesajlar için)
+    size_t first;               // Bloğun ilk ifadesi (etiketler dahil)
+    size_t body_first;          // Gövdenin (S) ilk komutu
+    size_t compare;             // CMP i, b (gövde [body_first, compare) aralığıdır)
+    int counter;                // Sayaç kaydedicisi i
+    TokenType step_op;          // TOKEN_ADD veya TOKEN_SUB
+    int64_t step;               // Adım c (> 0)
+    const AstOperand* bound;    // b (sabit veya kaydedici)
+    TokenType condition;        // Geri kenarın koşulu
+    int bound_read_in_body;     // Gövde b kaydedicisini okuyor mu?
+    int pragma;                 // "#unroll N" değeri (0 = yok)
+    const AstInstruction* branch; // Geri kenar (profil için)
+} UnrollLoop;
+
+static int operand_is_immediate(const AstOperand* operand) {
+    return operand->type == OP_INTEGER || operand->type == OP_HEX_INTEGER;
+}
+
+/**
+ * @brief Sabit sınırı K kadar kaydırır (yukarı sayanda b - K, aşağı sayanda b + K).
+ * @return b' taşmadan hesaplandı ve (negatif sabit yazılamadığı için) negatif değilse 1, aksi takdirde 0.
+ */
+static int unroll_shifted_bound(const UnrollLoop* loop, int64_t k, int64_t* shifted) {
+    int64_t b = loop->bound->value.int_value;
+    int overflow = loop->step_op == TOKEN_ADD ? __builtin_sub_overflow(b, k, shifted)
+                                              : __builtin_add_overflow(b, k, shifted);
+    return !overflow && *shifted >= 0;
+}
+
+/**
+ * @brief Koşulun (CMP a, b ardından Jcc) sağlanıp sağlanmadığını hesaplar.
+ */
+static int condition_holds(TokenType condition, int64_t a, int64_t b) {
+    switch (condition) {
+        case TOKEN_JEQ: return a == b;
+        case TOKEN_JNE: return a != b;
+        case TOKEN_JLT: return a < b;
+        case TOKEN_JGT: return a > b;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Etikete CALL ile başvurulup başvurulmadığını kontrol eder.
+ */
+static int label_is_call_target(const AstNode* ast_root, const char* label_name) {
+    for (size_t i = 0; i < ast_root->data.program.num_statements; i++) {
+        const AstNode* statement = ast_root->data.program.statements[i];
+        if (statement->type == AST_INSTRUCTION && statement->data.instruction.opcode == TOKEN_CALL &&
+            statement->data.instruction.num_operands == 1 &&
+            statement->data.instruction.operands[0].type == OP_LABEL_REF &&
+            strcmp(statement->data.instruction.operands[0].value.label_name, label_name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Bir kaydedicinin bloğun sonundaki değeri sabit mi bulur.
+ * Blokta kaydediciye yazılmıyorsa tek öncüllü ve etiketsiz (CALL ile girilemeyen) bloklar
+ * boyunca geriye yürünür.
+ * @return Değer "MOV r, sabit" ile belirlendiyse 1 (value'ya yazılır), aksi takdirde 0.
+ */
+static int register_constant_at_block_end(const Cfg* cfg, int block, int reg, int64_t* value) {
+    AstNode** statements = cfg->program->data.program.statements;
+    for (int depth = 0; depth < UNROLL_VALUE_SEARCH_DEPTH; depth++) {
+        const BasicBlock* bb = &cfg->blocks[block];
+        for (size_t i = bb->end; i > bb->first; i--) {
+            if (statements[i - 1]->type != AST_INSTRUCTION) continue;
+            const AstInstruction* instr = &statements[i - 1]->data.instruction;
+            RegisterEffects fx = cfg_instruction_register_effects(instr);
+            if (!(fx.clobber & (1u << reg))) continue;
+            if (instr->opcode == TOKEN_MOV && instr->num_operands == 2 && operand_is_immediate(&instr->operands[1])) {
+                *value = instr->operands[1].value.int_value;
+                return 1;
+            }
+            return 0;
+        }
+        if (block == 0 || bb->num_preds != 1 || cfg_block_label(cfg, block)) return 0;
+        block = cfg->edges[bb->pred_edges[0]].from;
+    }
+    return 0;
+}
+
+/**
+ * @brief Tek bloklu bir döngünün sayaç döngüsü olup olmadığını çözümler.
+ * @return Uygunsa 1 (loop doldurulur), aksi takdirde 0.
+ */
+static int analyze_counting_loop(const Cfg* cfg, const CfgLoop* cfg_loop, const uint32_t* live_in,
+                                 UnrollLoop* loop) {
+    AstNode** statements = cfg->program->data.program.statements;
+    int h = cfg_loop->header;
+    const BasicBlock* bb = &cfg->blocks[h];
+    if (cfg_loop->num_body_blocks != 1 || (live_in[h] & CFG_FLAGS_BIT) ||
+        cfg_find_succ_edge(cfg, h, CFG_EDGE_FALLTHROUGH) < 0) {
+        return 0; // Gövde başında okunan bayraklar kopyalar arasında korunmaz
+    }
+
+    memset(loop, 0, sizeof(UnrollLoop));
+    loop->block = h;
+    loop->first = bb->first;
+    size_t i = bb->first;
+    for (; i < bb->end && statements[i]->type == AST_LABEL_DECLARATION; i++) {
+        const AstLabelDeclaration* label = &statements[i]->data.label_decl;
+        if (strncmp(label->name, UNROLL_LABEL_PREFIX, strlen(UNROLL_LABEL_PREFIX)) == 0) return 0;
+        if (!loop->name) loop->name = label->name;
+        if (!loop->pragma) loop->pragma = label->unroll_pragma;
+    }
+    loop->body_first = i;
+    if (!loop->name || bb->end < loop->body_first + 3 || loop->pragma == 1) return 0;
+
+    // Son iki komut: CMP i, b ve bloğun kendisine dönen Jcc
+    const AstInstruction* cmp = &statements[bb->end - 2]->data.instruction;
+    const AstInstruction* jcc = &statements[bb->end - 1]->data.instruction;
+    if (statements[bb->end - 2]->type != AST_INSTRUCTION || cmp->opcode != TOKEN_CMP || cmp->num_operands != 2 ||
+        cmp->operands[0].type != OP_REGISTER || cmp->operands[0].value.reg_index < 0 ||
+        cmp->operands[0].value.reg_index >= CFG_NUM_REGISTERS ||
+        (cmp->operands[1].type != OP_REGISTER && !operand_is_immediate(&cmp->operands[1])) ||
+        !cfg_is_conditional_branch(jcc->opcode) || jcc->num_operands != 1 ||
+        jcc->operands[0].type != OP_LABEL_REF || cfg_block_of_label(cfg, jcc->operands[0].value.label_name) != h) {
+        return 0;
+    }
+    loop->compare = bb->end - 2;
+    loop->counter = cmp->operands[0].value.reg_index;
+    loop->bound = &cmp->operands[1];
+    loop->condition = jcc->opcode;
+    loop->branch = jcc;
+    uint32_t counter_bit = 1u << loop->counter;
+    uint32_t bound_bit = loop->bound->type == OP_REGISTER ? (1u << loop->bound->value.reg_index) : 0;
+    if (bound_bit == counter_bit) return 0;
+
+    // Gövde: sadece düz hesaplama; sayaca tek bir ADD/SUB sabit yazar, sınır değişmez
+    int steps = 0;
+    for (size_t k = loop->body_first; k < loop->compare; k++) {
+        const AstInstruction* instr = &statements[k]->data.instruction;
+        switch (instr->opcode) {
+            case TOKEN_MOV: case TOKEN_ADD: case TOKEN_SUB: case TOKEN_MUL: case TOKEN_DIV: case TOKEN_CMP:
+            case TOKEN_SELEQ: case TOKEN_SELNE: case TOKEN_SELLT: case TOKEN_SELGT: case TOKEN_SELLE: case TOKEN_SELGE:
+                break;
+            default:
+                return 0; // CALL/SYSCALL tüm kaydedicileri bozar; PROFCNT vb. kopyalanmamalı
+        }
+        RegisterEffects fx = cfg_instruction_register_effects(instr);
+        if (fx.clobber & bound_bit) return 0;
+        if (fx.use & bound_bit) loop->bound_read_in_body = 1;
+        if (!(fx.clobber & counter_bit)) continue;
+        if ((instr->opcode != TOKEN_ADD && instr->opcode != TOKEN_SUB) || instr->num_operands != 2 ||
+            !operand_is_immediate(&instr->operands[1]) || instr->operands[1].value.int_value <= 0 ||
+            instr->operands[1].value.int_value > UNROLL_MAX_STEP || ++steps > 1) {
+            return 0;
+        }
+        loop->step_op = instr->opcode;
+        loop->step = instr->operands[1].value.int_value;
+    }
+    return steps == 1;
+}
+
+/**
+ * @brief Döngünün tur sayısını (gövdenin kaç kez çalıştığını) derleme zamanında hesaplamaya çalışır.
+ * Döngüye tek bir öncülden girilmeli ve sayacın (kaydediciyse sınırın) giriş değeri sabit olmalıdır.
+ * @param limit Bu sayıdan fazla tur "bilinmiyor" sayılır.
+ * @return Tur sayısı veya bilinmiyorsa -1.
+ */
+static long constant_trip_count(const Cfg* cfg, const AstNode* ast_root, const UnrollLoop* loop, long limit) {
+    AstNode** statements = cfg->program->data.program.statements;
+    const BasicBlock* bb = &cfg->blocks[loop->block];
+    int entry = -1;
+    for (size_t p = 0; p < bb->num_preds; p++) {
+        int pred = cfg->edges[bb->pred_edges[p]].from;
+        if (pred == loop->block) continue;
+        if (entry >= 0) return -1;
+        entry = pred;
+    }
+    if (entry < 0) return -1;
+    for (size_t i = loop->first; i < loop->body_first; i++) {
+        if (label_is_call_target(ast_root, statements[i]->data.label_decl.name)) return -1;
+    }
+
+    int64_t value, bound;
+    if (!register_constant_at_block_end(cfg, entry, loop->counter, &value)) return -1;
+    if (operand_is_immediate(loop->bound)) {
+        bound = loop->bound->value.int_value;
+    } else if (!register_constant_at_block_end(cfg, entry, loop->bound->value.reg_index, &bound)) {
+        return -1;
+    }
+
+    // Bessambly kaydedicileri 64-bit ikiye tümleyen aritmetiğiyle taşar
+    for (long trips = 1; trips <= limit; trips++) {
+        uint64_t next = loop->step_op == TOKEN_ADD ? (uint64_t)value + (uint64_t)loop->step
+                                                   : (uint64_t)value - (uint64_t)loop->step;
+        value = (int64_t)next;
+        if (!condition_holds(loop->condition, value, bound)) return trips;
+    }
+    return -1;
+}
+
+/**
+ * @brief Gövdenin (S) kopyalarını listeye ekler; kopyaların profil sayımı scale_divisor'a bölünür
+ * (0 ise profil bilgisi silinir).
+ */
+static int emit_loop_body(StatementList* out, AstNode** statements, const UnrollLoop* loop, uint64_t scale_divisor) {
+    for (size_t k = loop->body_first; k < loop->compare; k++) {
+        AstNode* copy = ast_node_clone(statements[k]);
+        if (!statement_list_append(out, copy)) return 0;
+        AstInstruction* instr = &copy->data.instruction;
+        if (scale_divisor == 0) {
+            instr->has_profile = 0;
+        } else {
+            instr->profile_count /= scale_divisor;
+        }
+    }
+    return 1;
+}
+
+static AstNode* unroll_register_compare(int reg, const AstOperand* bound, const AstNode* origin) {
+    AstNode* node = ast_instruction_create(TOKEN_CMP, 2, origin->line, origin->column);
+    if (!node) return NULL;
+    node->data.instruction.operands[0].type = OP_REGISTER;
+    node->data.instruction.operands[0].value.reg_index = reg;
+    node->data.instruction.operands[1] = *bound; // Kaydedici veya sabit (etiket değil)
+    return node;
+}
+
+static AstNode* unroll_compare(const UnrollLoop* loop, const AstOperand* bound, const AstNode* origin) {
+    return unroll_register_compare(loop->counter, bound, origin);
+}
+
+static AstNode* unroll_jump(TokenType opcode, const char* label, const AstNode* origin) {
+    AstNode* node = ast_instruction_create(opcode, 1, origin->line, origin->column);
+    if (node && !ast_operand_set_label(&node->data.instruction.operands[0], label)) {
+        ast_node_free(node);
+        return NULL;
+    }
+    return node;
+}
+
+static AstNode* unroll_adjust(TokenType opcode, int reg, int64_t amount, const AstNode* origin) {
+    AstNode* node = ast_instruction_create(opcode, 2, origin->line, origin->column);
+    if (!node) return NULL;
+    node->data.instruction.operands[0].type = OP_REGISTER;
+    node->data.instruction.operands[0].value.reg_index = reg;
+    node->data.instruction.operands[1].type = OP_INTEGER;
+    node->data.instruction.operands[1].value.int_value = amount;
+    return node;
+}
+
+/**
+ * @brief Döngüyü tamamen açar: etiketler, T gövde kopyası ve bayraklar çıkışta canlıysa son CMP.
+ */
+static int emit_full_unroll(StatementList* out, AstNode** statements, const UnrollLoop* loop, long trips,
+                            int flags_live_at_exit) {
+    for (size_t i = loop->first; i < loop->body_first; i++) {
+        if (!statement_list_append(out, ast_node_clone(statements[i]))) return 0;
+    }
+    uint64_t divisor = (uint64_t)trips;
+    for (long t = 0; t < trips; t++) {
+        if (!emit_loop_body(out, statements, loop, divisor)) return 0;
+    }
+    return !flags_live_at_exit || statement_list_append(out, ast_node_clone(statements[loop->compare]));
+}
+
+/**
+ * @brief Döngüyü factor kat açar ve kalan turlar için orijinal döngüyü korur (bölüm başındaki şema).
+ * @param exit_label Çıkış bloğunun etiketi veya NULL (yeni etiket üretilir).
+ */
+static int emit_partial_unroll(StatementList* out, AstNode** statements, const UnrollLoop* loop, int factor,
+                               const char* exit_label, SymbolTable* symbol_table) {
+    const AstNode* origin = statements[loop->compare];
+    int64_t k = (int64_t)(factor - 1) * loop->step;
+    int bound_is_register = loop->bound->type == OP_REGISTER;
+    int reg = bound_is_register ? loop->bound->value.reg_index : -1;
+    // b' = b - K (yukarı sayan) veya b + K (aşağı sayan)
+    TokenType shift_op = loop->step_op == TOKEN_ADD ? TOKEN_SUB : TOKEN_ADD;
+    TokenType restore_op = loop->step_op == TOKEN_ADD ? TOKEN_ADD : TOKEN_SUB;
+    AstOperand shifted = *loop->bound;
+    if (!bound_is_register && !unroll_shifted_bound(loop, k, &shifted.value.int_value)) {
+        return 0; // Çağıran taşmayı önceden eler
+    }
+    // Kaydırılmış kaydedici taşma koruması: b' = b - K taşmışsa b' > MAX-K olur; b + K ise
+    // b > MAX-K iken taşar (kaydırmadan önce denetlenir). İki durumda da sabit negatif değildir.
+    AstOperand wrap_limit = {0};
+    wrap_limit.type = OP_INTEGER;
+    wrap_limit.value.int_value = INT64_MAX - k;
+    int counts_up = loop->step_op == TOKEN_ADD;
+
+    char main_label[64], rest_label[64], guard_label[64], exit_buffer[64];
+    cfg_make_unique_label(symbol_table, UNROLL_LABEL_PREFIX "_body", main_label, sizeof(main_label));
+    if (!symbol_table_add_symbol(symbol_table, main_label, 0, 0, 0)) return 0;
+    cfg_make_unique_label(symbol_table, UNROLL_LABEL_PREFIX "_rest", rest_label, sizeof(rest_label));
+    if (!symbol_table_add_symbol(symbol_table, rest_label, 0, 0, 0)) return 0;
+    if (bound_is_register && counts_up) {
+        cfg_make_unique_label(symbol_table, UNROLL_LABEL_PREFIX "_guard", guard_label, sizeof(guard_label));
+        if (!symbol_table_add_symbol(symbol_table, guard_label, 0, 0, 0)) return 0;
+    }
+    if (!exit_label) {
+        cfg_make_unique_label(symbol_table, UNROLL_LABEL_PREFIX "_exit", exit_buffer, sizeof(exit_buffer));
+        if (!symbol_table_add_symbol(symbol_table, exit_buffer, 0, 0, 0)) return 0;
+    }
+
+    // H: en az U tur kaldıysa M'ye git
+    for (size_t i = loop->first; i < loop->body_first; i++) {
+        if (!statement_list_append(out, ast_node_clone(statements[i]))) return 0;
+    }
+    if (bound_is_register) {
+        // Yukarı sayanda kaydırmadan sonra, aşağı sayanda önce denetlenir
+        const char* wrap_target = counts_up ? guard_label : rest_label;
+        if ((counts_up && !statement_list_append(out, unroll_adjust(shift_op, reg, k, origin))) ||
+            !statement_list_append(out, unroll_register_compare(reg, &wrap_limit, origin)) ||
+            !statement_list_append(out, unroll_jump(TOKEN_JGT, wrap_target, origin)) ||
+            (!counts_up && !statement_list_append(out, unroll_adjust(shift_op, reg, k, origin)))) {
+            return 0;
+        }
+    }
+    if (!statement_list_append(out, unroll_compare(loop, &shifted, origin)) ||
+        !statement_list_append(out, unroll_jump(loop->condition, main_label, origin)) ||
+        (bound_is_register && counts_up &&
+         !statement_list_append(out, ast_label_declaration_create(guard_label, origin->line, origin->column))) ||
+        (bound_is_register && !statement_list_append(out, unroll_adjust(restore_op, reg, k, origin)))) {
+        return 0;
+    }
+
+    // R: kalan turlar (orijinal döngü)
+    if (!statement_list_append(out, ast_label_declaration_create(rest_label, origin->line, origin->column)) ||
+        !emit_loop_body(out, statements, loop, 0) ||
+        !statement_list_append(out, unroll_compare(loop, loop->bound, origin)) ||
+        !statement_list_append(out, unroll_jump(loop->condition, rest_label, origin)) ||
+        !statement_list_append(out, unroll_jump(TOKEN_JMP, exit_label ? exit_label : exit_buffer, origin))) {
+        return 0;
+    }
+
+    // M: açılmış gövde
+    if (!statement_list_append(out, ast_label_declaration_create(main_label, origin->line, origin->column))) {
+        return 0;
+    }
+    for (int u = 0; u < factor; u++) {
+        if (!emit_loop_body(out, statements, loop, 0)) return 0;
+    }
+    if (!statement_list_append(out, unroll_compare(loop, &shifted, origin)) ||
+        !statement_list_append(out, unroll_jump(loop->condition, main_label, origin)) ||
+        (bound_is_register && !statement_list_append(out, unroll_adjust(restore_op, reg, k, origin))) ||
+        !statement_list_append(out, unroll_compare(loop, loop->bound, origin)) ||
+        !statement_list_append(out, unroll_jump(loop->condition, rest_label, origin))) {
+        return 0;
+    }
+    return exit_label ||
+           statement_list_append(out, ast_label_declaration_create(exit_buffer, origin->line, origin->column));
+}
+
+/**
+ * @brief Kısmi açma için katsayıyı seçer (0 = açılmaz).
+ * Yönerge yoksa katsayı seviye sınırından başlayıp açılmış gövde boyut sınırına sığana kadar
+ * yarıya indirilir; profil ortalama tur sayısının katsayıdan az olduğunu gösteriyorsa da küçültülür.
+ */
+static int choose_unroll_factor(const UnrollLoop* loop, int max_factor, int max_unrolled_size) {
+    if (loop->condition != (loop->step_op == TOKEN_ADD ? TOKEN_JLT : TOKEN_JGT)) return 0;
+    if (loop->bound->type == OP_REGISTER && loop->bound_read_in_body) return 0; // b geçici olarak kaydırılır
+    if (loop->pragma > 1) return loop->pragma;
+
+    long body_size = (long)(loop->compare - loop->body_first);
+    int factor = max_factor;
+    while (factor >= 2 && factor * body_size > max_unrolled_size) factor /= 2;
+    const AstInstruction* branch = loop->branch;
+    if (branch->has_profile) {
+        if (branch->profile_count == 0) return 0; // Soğuk döngü
+        uint64_t exits = branch->profile_count - branch->profile_taken_count;
+        uint64_t average_trips = branch->profile_count / (exits ? exits : 1);
+        while (factor >= 2 && (uint64_t)factor > average_trips) factor /= 2;
+    }
+    return factor >= 2 ? factor : 0;
+}
+
+int optimize_loop_unrolling(AstNode* ast_root, SymbolTable* symbol_table, int max_factor, int max_unrolled_size,
+                            long* growth_budget) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !symbol_table) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    CfgLoop* loops = NULL;
+    size_t num_loops = 0;
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    StatementReplacement* replacements = NULL;
+    if (!live_in || !live_out || !cfg_find_loops(cfg, &loops, &num_loops) ||
+        (num_loops > 0 && !(replacements = (StatementReplacement*)calloc(num_loops, sizeof(StatementReplacement))))) {
+        fprintf(stderr, "Hata: Döngü açma için bellek tahsis edilemedi.\n");
+        free(live_in); free(live_out); cfg_free_loops(loops, num_loops);
+        cfg_free(cfg);
+        return 0;
+    }
+    cfg_compute_liveness(cfg, live_in, live_out);
+
+    AstNode** statements = ast_root->data.program.statements;
+    size_t num_replacements = 0;
+    int failed = 0;
+    for (size_t l = 0; l < num_loops && !failed; l++) {
+        UnrollLoop loop;
+        if (!analyze_counting_loop(cfg, &loops[l], live_in, &loop)) continue;
+        long body_size = (long)(loop.compare - loop.body_first);
+        int exit_block = loop.block + 1;
+        StatementReplacement* replacement = &replacements[num_replacements];
+        replacement->first = loop.first;
+        replacement->end = cfg->blocks[loop.block].end;
+
+        // 1. Sabit tur sayısı: tamamen aç
+        long full_limit = loop.pragma > 1 ? loop.pragma : max_unrolled_size / (body_size ? body_size : 1);
+        long trips = constant_trip_count(cfg, ast_root, &loop, full_limit);
+        if (trips > 0) {
+            long growth = (trips - 1) * body_size - 2; // Son CMP ve Jcc kalkar
+            if (loop.pragma > 1 || growth <= *growth_budget) {
+                int flags_live = (live_in[exit_block] & CFG_FLAGS_BIT) != 0;
+                if (!emit_full_unroll(&replacement->emitted, statements, &loop, trips, flags_live)) {
+                    failed = 1;
+                } else {
+                    *growth_budget -= growth + (flags_live ? 1 : 0);
+                    fprintf(stdout, "Optimizer: '%s' döngüsü tamamen açıldı (%ld tur).\n", loop.name, trips);
+                    num_replacements++;
+                }
+                continue;
+            }
+        }
+
+        // 2. Çalışma zamanında belli tur sayısı: U kat aç, kalan turlar için döngüyü koru
+        int factor = choose_unroll_factor(&loop, max_factor, max_unrolled_size);
+        if (factor < 2 || (trips > 0 && trips < factor)) continue;
+        int64_t shifted_bound;
+        if (loop.bound->type != OP_REGISTER &&
+            !unroll_shifted_bound(&loop, (int64_t)(factor - 1) * loop.step, &shifted_bound)) {
+            continue;
+        }
+        // Ön kontrol (kaydedici sınırda taşma koruması dahil), M'nin kuyruğu ve çıkış atlaması
+        long growth = factor * body_size + (loop.bound->type == OP_REGISTER ? 10 : 8);
+        if (loop.pragma <= 1 && growth > *growth_budget) continue;
+        const char* exit_label = cfg_block_label(cfg, exit_block);
+        if (!emit_partial_unroll(&replacement->emitted, statements, &loop, factor, exit_label, symbol_table)) {
+            failed = 1;
+            continue;
+        }
+        *growth_budget -= growth;
+        fprintf(stdout, "Optimizer: '%s' döngüsü %d kat açıldı (kalan turlar orijinal döngüde).\n",
+                loop.name, factor);
+        num_replacements++;
+    }
+    if (!failed && num_replacements > 0 && !apply_statement_replacements(ast_root, replacements, num_replacements)) {
+        failed = 1;
+    }
+    if (failed) {
+        fprintf(stderr, "Hata: Döngü açılamadı (bellek hatası).\n");
+        for (size_t r = 0; r < num_loops; r++) statement_list_free(&replacements[r].emitted);
+        num_replacements = 0;
+    }
+
+    free(live_in); free(live_out); free(replacements);
+    cfg_free_loops(loops, num_loops);
+    cfg_free(cfg);
+    return num_replacements > 0;
+}
+
+// --- Kod Dışlama (Outlining) ve Kuyruk Birleştirme (Tail Merging) ---
+// -Os için iki boyut dönüşümü. Gömülü hedeflerde (örn: OS_BAREMETAL üzerinde RV32E, ARMv7)
+// imaj boyutu flash ve komut önbelleğiyle sınırlıdır; üretilen kodda aynı komut dizileri
+// sıkça tekrarlanır.
+// Kod dışlama: her komut eşdeğer komutlar aynı sayıyı alacak şekilde bir tamsayıya çevrilir;
+// etiketler ve dışlanamayan komutlar benzersiz ayraçlar olur. Bu dizinin son ek dizisi (suffix
+// array) ve LCP dizisinden tekrarlanan alt diziler (son ek ağacının iç düğümleri) bulunur.
+// Kazancı çağrı maliyetini aşan diziler programın sonundaki ortak alt programlara taşınır,
+// her geçiş CALL ile değiştirilir.
+// Kuyruk birleştirme (cross-jumping): aynı bloğa atlayan veya düşen iki bloğun özdeş son
+// komutları tek kopyada toplanır; diğer blok kopyanın başına atlar.
+
+#define OUTLINE_LABEL_PREFIX "__bsm_outlined"
+#define OUTLINE_MIN_LENGTH 2    // Tek komut CALL ile değiştirildiğinde küçülmez
+#define OUTLINE_CALL_SIZE 1     // Her geçişin yerine gelen CALL
+#define OUTLINE_RETURN_SIZE 1   // Alt programın sonundaki RET
+#define TAIL_MERGE_MAX_PREDS 16 // Bir bloğun bu kadarından fazla öncülü ikili karşılaştırılmaz
+
+// Tekrarlanan dizi adayı: son ek dizisinde [lb, rb] aralığındaki son ekler length komut ortaktır
+typedef struct {
+    size_t lb;
+    size_t rb;
+    size_t length;
+    long benefit;           // Tahmini kazanç (komut sayısı)
+} OutlineCandidate;
+
+/**
+ * @brief Bir komutun dışlanabilir olup olmadığını kontrol eder: sadece kaydedici/bayrak
+ * etkisi olan, akışı değiştirmeyen komutlar (atlama, CALL, RET, SYSCALL ve sözde komutlar hariç).
+ */
+static int outline_opcode_allowed(TokenType opcode) {
+    switch (opcode) {
+        case TOKEN_MOV:
+        case TOKEN_ADD:
+        case TOKEN_SUB:
+        case TOKEN_MUL:
+        case TOKEN_DIV:
+        case TOKEN_CMP:
+        case TOKEN_SELEQ:
+        case TOKEN_SELNE:
+        case TOKEN_SELLT:
+        case TOKEN_SELGT:
+        case TOKEN_SELLE:
+        case TOKEN_SELGE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief İki komutun aynı işi yapıp yapmadığını kontrol eder (16 ve 0x10 aynı değerdir).
+ */
+static int instructions_identical(const AstInstruction* a, const AstInstruction* b) {
+    if (a->opcode != b->opcode || a->num_operands != b->num_operands) return 0;
+    for (size_t o = 0; o < a->num_operands; o++) {
+        const AstOperand* x = &a->operands[o];
+        const AstOperand* y = &b->operands[o];
+        if (x->type == OP_LABEL_REF || y->type == OP_LABEL_REF) {
+            if (x->type != y->type || strcmp(x->value.label_name, y->value.label_name) != 0) return 0;
+        } else if (x->type == OP_REGISTER || y->type == OP_REGISTER) {
+            if (x->type != y->type || x->value.reg_index != y->value.reg_index) return 0;
+        } else if (x->value.int_value != y->value.int_value) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint64_t instruction_hash(const AstInstruction* instr) {
+    uint64_t hash = 1469598103934665603ULL; // FNV-1a
+    hash = (hash ^ (uint64_t)instr->opcode) * 1099511628211ULL;
+    for (size_t o = 0; o < instr->num_operands; o++) {
+        const AstOperand* operand = &instr->operands[o];
+        uint64_t value = operand->type == OP_REGISTER ? (uint64_t)operand->value.reg_index + 1
+                                                      : (uint64_t)operand->value.int_value;
+        hash = (hash ^ (operand->type == OP_REGISTER ? 1u : 2u)) * 1099511628211ULL;
+        hash = (hash ^ value) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Programı tamsayı dizisine çevirir: eşdeğer dışlanabilir komutlar aynı sayıyı
+ * (0..n-1), diğer tüm ifadeler benzersiz bir ayraç (n + indeks) alır.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int outline_encode_program(AstNode** statements, size_t n, int* text) {
+    size_t table_size = 16;
+    while (table_size < n * 2) table_size *= 2;
+    long* table = (long*)malloc(sizeof(long) * table_size); // Temsilci ifade indeksi (-1 = boş)
+    if (!table) return 0;
+    for (size_t i = 0; i < table_size; i++) table[i] = -1;
+
+    int next_id = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (statements[i]->type != AST_INSTRUCTION ||
+            !outline_opcode_allowed(statements[i]->data.instruction.opcode)) {
+            text[i] = (int)(n + i);
+            continue;
+        }
+        const AstInstruction* instr = &statements[i]->data.instruction;
+        size_t slot = (size_t)instruction_hash(instr) & (table_size - 1);
+        while (table[slot] >= 0 &&
+               !instructions_identical(&statements[table[slot]]->data.instruction, instr)) {
+            slot = (slot + 1) & (table_size - 1);
+        }
+        if (table[slot] < 0) {
+            table[slot] = (long)i;
+            text[i] = next_id++;
+        } else {
+            text[i] = text[table[slot]];
+        }
+    }
+    free(table);
+    return 1;
+}
+
+// Son ek dizisini sıralarken kullanılan bağlam (önek ikiye katlama)
+static const int* suffix_sort_rank = NULL;
+static size_t suffix_sort_step = 0;
+static size_t suffix_sort_length = 0;
+
+static int compare_suffixes(const void* a, const void* b) {
+    size_t i = (size_t)*(const int*)a, j = (size_t)*(const int*)b;
+    if (suffix_sort_rank[i] != suffix_sort_rank[j]) return suffix_sort_rank[i] < suffix_sort_rank[j] ? -1 : 1;
+    int ri = i + suffix_sort_step < suffix_sort_length ? suffix_sort_rank[i + suffix_sort_step] : -1;
+    int rj = j + suffix_sort_step < suffix_sort_length ? suffix_sort_rank[j + suffix_sort_step] : -1;
+    return ri < rj ? -1 : (ri > rj ? 1 : 0);
+}
+
+/**
+ * @brief Son ek dizisini önek ikiye katlama ile oluşturur (O(n log^2 n)) ve Kasai
+ * algoritmasıyla LCP dizisini hesaplar: lcp[i], sa[i-1] ve sa[i] son eklerinin ortak önek uzunluğu.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int build_suffix_array(const int* text, size_t n, int* sa, int* lcp) {
+    int* rank = (int*)malloc(sizeof(int) * (n ? n : 1));
+    int* next_rank = (int*)malloc(sizeof(int) * (n ? n : 1));
+    if (!rank || !next_rank) {
+        free(rank); free(next_rank);
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        sa[i] = (int)i;
+        rank[i] = text[i];
+    }
+    suffix_sort_rank = rank;
+    suffix_sort_length = n;
+    for (size_t step = 1; n > 1; step *= 2) {
+        suffix_sort_step = step;
+        qsort(sa, n, sizeof(int), compare_suffixes);
+        next_rank[sa[0]] = 0;
+        for (size_t i = 1; i < n; i++) {
+            next_rank[sa[i]] = next_rank[sa[i - 1]] + (compare_suffixes(&sa[i - 1], &sa[i]) < 0);
+        }
+        memcpy(rank, next_rank, sizeof(int) * n);
+        if ((size_t)rank[sa[n - 1]] == n - 1 || step >= n) break; // Tüm sıralar farklı
+    }
+    suffix_sort_rank = NULL;
+
+    for (size_t i = 0; i < n; i++) rank[sa[i]] = (int)i;
+    size_t h = 0;
+    if (n) lcp[0] = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        size_t j = (size_t)sa[rank[i] - 1];
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) h++;
+        lcp[rank[i]] = (int)h;
+        if (h > 0) h--;
+    }
+    free(rank);
+    free(next_rank);
+    return 1;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_outline_candidates(const void* a, const void* b) {
+    const OutlineCandidate* x = (const OutlineCandidate*)a;
+    const OutlineCandidate* y = (const OutlineCandidate*)b;
+    if (x->benefit != y->benefit) return x->benefit > y->benefit ? -1 : 1;
+    if (x->length != y->length) return x->length > y->length ? -1 : 1;
+    return x->lb < y->lb ? -1 : (x->lb > y->lb ? 1 : 0); // Deterministik sıra
+}
+
+static long outline_benefit(size_t occurrences, size_t length) {
+    return (long)(occurrences * length) -
+           (long)(occurrences * OUTLINE_CALL_SIZE + length + OUTLINE_RETURN_SIZE);
+}
+
+/**
+ * @brief Bir adayın geçişlerini seçer: son ek aralığındaki konumlar sıralanır, daha önce
+ * dışlanan veya çakışan geçişler ile bayrakları dizinin sınırında canlı olanlar elenir.
+ * CALL bayrakları belirsiz bıraktığı için dizi öncesinden bayrak okuyamaz, sonrasına bayrak taşıyamaz.
+ * @param positions Çıktı (en az rb - lb + 1 eleman).
+ * @return Seçilen geçiş sayısı.
+ */
+static size_t outline_select_occurrences(const OutlineCandidate* candidate, const int* sa,
+                                         const unsigned char* claimed, const unsigned char* flags_live_before,
+                                         const unsigned char* flags_live_after, int* positions) {
+    size_t count = 0;
+    for (size_t k = candidate->lb; k <= candidate->rb; k++) positions[count++] = sa[k];
+    qsort(positions, count, sizeof(int), compare_ints);
+
+    size_t selected = 0, next_free = 0;
+    for (size_t k = 0; k < count; k++) {
+        size_t p = (size_t)positions[k];
+        if (p < next_free || flags_live_before[p] || flags_live_after[p + candidate->length - 1]) continue;
+        int overlaps = 0;
+        for (size_t i = p; i < p + candidate->length && !overlaps; i++) overlaps = claimed[i];
+        if (overlaps) continue;
+        positions[selected++] = (int)p;
+        next_free = p + candidate->length;
+    }
+    return selected;
+}
+
+/**
+ * @brief İfade başına bayrak canlılığını hesaplar (komuttan önce ve sonra).
+ */
+static void compute_statement_flags_liveness(const Cfg* cfg, const uint32_t* live_out,
+                                             unsigned char* live_before, unsigned char* live_after) {
+    AstNode** statements = cfg->program->data.program.statements;
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        uint32_t live = live_out[b];
+        for (size_t i = cfg->blocks[b].end; i > cfg->blocks[b].first; i--) {
+            live_after[i - 1] = (live & CFG_FLAGS_BIT) != 0;
+            if (statements[i - 1]->type == AST_INSTRUCTION) {
+                RegisterEffects fx = cfg_instruction_register_effects(&statements[i - 1]->data.instruction);
+                live = (live & ~fx.def) | fx.use;
+            }
+            live_before[i - 1] = (live & CFG_FLAGS_BIT) != 0;
+        }
+    }
+}
+
+/**
+ * @brief Son ek dizisinin LCP aralıklarını (son ek ağacının iç düğümleri) aday olarak toplar.
+ * Her aralık için çakışmayan geçiş sayısıyla kazanç tahmin edilir; kazançsızlar atlanır.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int collect_outline_candidates(const int* sa, const int* lcp, size_t n, OutlineCandidate** candidates,
+                                      size_t* count) {
+    typedef struct { int lcp; size_t lb; } LcpInterval;
+    LcpInterval* stack = (LcpInterval*)malloc(sizeof(LcpInterval) * (n + 1));
+    int* positions = (int*)malloc(sizeof(int) * (n ? n : 1));
+    size_t capacity = 0, top = 0;
+    *candidates = NULL;
+    *count = 0;
+    if (!stack || !positions) {
+        free(stack); free(positions);
+        return 0;
+    }
+
+    stack[top++] = (LcpInterval){0, 0};
+    for (size_t i = 1; i <= n; i++) {
+        int current = i < n ? lcp[i] : 0; // Sonda tüm açık aralıklar kapanır
+        size_t lb = i - 1;
+        while (current < stack[top - 1].lcp) {
+            LcpInterval interval = stack[--top];
+            lb = interval.lb;
+            if (interval.lcp < OUTLINE_MIN_LENGTH) continue;
+
+            // Çakışmayan geçiş sayısı (bayrak ve önceki seçimler uygulama sırasında denetlenir)
+            size_t num = 0;
+            for (size_t k = interval.lb; k < i; k++) positions[num++] = sa[k];
+            qsort(positions, num, sizeof(int), compare_ints);
+            size_t occurrences = 0, next_free = 0;
+            for (size_t k = 0; k < num; k++) {
+                if ((size_t)positions[k] < next_free) continue;
+                occurrences++;
+                next_free = (size_t)positions[k] + (size_t)interval.lcp;
+            }
+            long benefit = outline_benefit(occurrences, (size_t)interval.lcp);
+            if (benefit <= 0) continue;
+
+            if (*count >= capacity) {
+                size_t new_capacity = capacity ? capacity * 2 : 16;
+                OutlineCandidate* grown = (OutlineCandidate*)realloc(*candidates,
+                                                                     sizeof(OutlineCandidate) * new_capacity);
+                if (!grown) {
+                    free(stack); free(positions);
+                    return 0;
+                }
+                *candidates = grown;
+                capacity = new_capacity;
+            }
+            (*candidates)[(*count)++] = (OutlineCandidate){interval.lb, i - 1, (size_t)interval.lcp, benefit};
+        }
+        if (current > stack[top - 1].lcp) stack[top++] = (LcpInterval){current, lb};
+    }
+    free(stack);
+    free(positions);
+    return 1;
+}
+
+/**
+ * @brief Dışlanan bir dizi için "etiket: dizi; RET" alt programını üretir.
+ */
+static int emit_outlined_function(StatementList* out, AstNode** statements, size_t first, size_t length,
+                                  const char* label) {
+    AstNode* entry = ast_label_declaration_create(label, statements[first]->line, statements[first]->column);
+    if (!statement_list_append(out, entry)) return 0;
+    for (size_t i = first; i < first + length; i++) {
+        AstNode* copy = ast_node_clone(statements[i]);
+        if (!statement_list_append(out, copy)) return 0;
+        copy->data.instruction.has_profile = 0; // Birden fazla geçişin sayımı karışır
+    }
+    AstNode* ret = ast_instruction_create(TOKEN_RET, 0, statements[first]->line, statements[first]->column);
+    return statement_list_append(out, ret);
+}
+
+static int compare_replacements(const void* a, const void* b) {
+    const StatementReplacement* x = (const StatementReplacement*)a;
+    const StatementReplacement* y = (const StatementReplacement*)b;
+    return x->first < y->first ? -1 : (x->first > y->first ? 1 : 0);
+}
+
+int optimize_outlining(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !symbol_table) return 0;
+    size_t n = ast_root->data.program.num_statements;
+    if (n < OUTLINE_MIN_LENGTH * 2) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    AstNode** statements = ast_root->data.program.statements;
+    int* text = (int*)malloc(sizeof(int) * n);
+    int* sa = (int*)malloc(sizeof(int) * n);
+    int* lcp = (int*)malloc(sizeof(int) * n);
+    int* positions = (int*)malloc(sizeof(int) * n);
+    unsigned char* claimed = (unsigned char*)calloc(n, 1);
+    unsigned char* flags_before = (unsigned char*)calloc(n, 1);
+    unsigned char* flags_after = (unsigned char*)calloc(n, 1);
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    OutlineCandidate* candidates = NULL;
+    size_t num_candidates = 0;
+    StatementReplacement* replacements = NULL;
+    size_t num_replacements = 0, replacement_capacity = 0;
+    StatementList functions = {NULL, 0, 0};
+    int ok = text && sa && lcp && positions && claimed && flags_before && flags_after && live_in && live_out &&
+             outline_encode_program(statements, n, text) && build_suffix_array(text, n, sa, lcp) &&
+             collect_outline_candidates(sa, lcp, n, &candidates, &num_candidates);
+
+    // Program sonundan düşülebiliyorsa alt programların önüne "JMP son; ...; son:" gerekir
+    int needs_guard = statements[n - 1]->type != AST_INSTRUCTION ||
+                      cfg_has_fallthrough(statements[n - 1]->data.instruction.opcode);
+    char end_label[64];
+    long total_benefit = 0;
+    int outlined = 0;
+    if (ok && num_candidates > 0) {
+        cfg_compute_liveness(cfg, live_in, live_out);
+        compute_statement_flags_liveness(cfg, live_out, flags_before, flags_after);
+        qsort(candidates, num_candidates, sizeof(OutlineCandidate), compare_outline_candidates);
+    }
+
+    // Açgözlü seçim: en kazançlı adaydan başlayarak, henüz dışlanmamış geçişler
+    for (size_t c = 0; ok && c < num_candidates; c++) {
+        const OutlineCandidate* candidate = &candidates[c];
+        size_t occurrences = outline_select_occurrences(candidate, sa, claimed, flags_before, flags_after, positions);
+        long benefit = outline_benefit(occurrences, candidate->length);
+        if (occurrences < 2 || benefit <= (outlined == 0 && needs_guard ? 1 : 0)) continue;
+
+        if (outlined == 0 && needs_guard) {
+            cfg_make_unique_label(symbol_table, OUTLINE_LABEL_PREFIX "_end", end_label, sizeof(end_label));
+            if (!symbol_table_add_symbol(symbol_table, end_label, 0, 0, 0) ||
+                !statement_list_append(&functions, dispatch_jump(TOKEN_JMP, end_label, statements[n - 1], 0, 0, 0))) {
+                ok = 0;
+                break;
+            }
+        }
+        char label[64];
+        cfg_make_unique_label(symbol_table, OUTLINE_LABEL_PREFIX, label, sizeof(label));
+        if (!symbol_table_add_symbol(symbol_table, label, 0, 0, 0) ||
+            !emit_outlined_function(&functions, statements, (size_t)positions[0], candidate->length, label)) {
+            ok = 0;
+            break;
+        }
+        if (num_replacements + occurrences + 1 > replacement_capacity) { // +1: alt programların eklenmesi
+            size_t new_capacity = (replacement_capacity ? replacement_capacity * 2 : 16) + occurrences + 1;
+            StatementReplacement* grown = (StatementReplacement*)realloc(replacements,
+                                                                         sizeof(StatementReplacement) * new_capacity);
+            if (!grown) {
+                ok = 0;
+                break;
+            }
+            replacements = grown;
+            replacement_capacity = new_capacity;
+        }
+        for (size_t k = 0; k < occurrences && ok; k++) {
+            size_t p = (size_t)positions[k];
+            const AstInstruction* head = &statements[p]->data.instruction;
+            StatementReplacement* r = &replacements[num_replacements++];
+            r->first = p;
+            r->end = p + candidate->length;
+            r->emitted = (StatementList){NULL, 0, 0};
+            ok = statement_list_append(&r->emitted, dispatch_jump(TOKEN_CALL, label, statements[p], head->has_profile,
+                                                                  head->profile_count, 0));
+            memset(claimed + p, 1, candidate->length);
+        }
+        fprintf(stdout, "Optimizer: %zu komutluk dizi %zu yerden '%s' alt programına taşındı (%ld komut kazanç).\n",
+                candidate->length, occurrences, label, benefit);
+        total_benefit += benefit;
+        outlined++;
+    }
+
+    if (ok && outlined && needs_guard) {
+        ok = statement_list_append(&functions, ast_label_declaration_create(end_label, statements[n - 1]->line,
+                                                                            statements[n - 1]->column));
+    }
+
+    // Alt programlar programın sonuna eklenir (boş aralık değişikliği)
+    if (ok && outlined) {
+        qsort(replacements, num_replacements, sizeof(StatementReplacement), compare_replacements);
+        replacements[num_replacements++] = (StatementReplacement){n, n, functions};
+        functions = (StatementList){NULL, 0, 0};
+        ok = apply_statement_replacements(ast_root, replacements, num_replacements);
+        if (ok) {
+            fprintf(stdout, "Optimizer: Kod dışlama %d alt program oluşturdu (toplam %ld komut kazanç).\n",
+                    outlined, total_benefit - (needs_guard ? 1 : 0));
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Hata: Kod dışlama yapılamadı (bellek hatası).\n");
+        outlined = 0;
+    }
+
+    for (size_t r = 0; r < num_replacements; r++) statement_list_free(&replacements[r].emitted);
+    statement_list_free(&functions);
+    free(replacements); free(candidates);
+    free(text); free(sa); free(lcp); free(positions);
+    free(claimed); free(flags_before); free(flags_after);
+    free(live_in); free(live_out);
+    cfg_free(cfg);
+    return outlined > 0;
+}
+
+// Kuyruk birleştirme için bir öncül bloğun gövdesi
+typedef struct {
+    int block;
+    size_t body_first;      // Baştaki etiketlerden sonraki ilk ifade
+    size_t body_end;        // Sondaki JMP (varsa) hariç gövde sonu
+    int jumps;              // Blok JMP ile mi bitiyor (0: ardılına düşüyor)
+} TailMergeBlock;
+
+/**
+ * @brief Bloğun tek ardılına koşulsuz geçip geçmediğini kontrol eder (JMP veya düşme)
+ * ve gövde sınırlarını doldurur.
+ */
+static int tail_merge_scan_block(const Cfg* cfg, int block, TailMergeBlock* info) {
+    AstNode** statements = cfg->program->data.program.statements;
+    const BasicBlock* bb = &cfg->blocks[block];
+    if (bb->num_succs != 1) return 0;
+    AstNode* last = cfg_block_last_instruction(cfg, block);
+    info->block = block;
+    info->jumps = last && last->data.instruction.opcode == TOKEN_JMP;
+    if (last && !info->jumps && cfg_is_block_terminator(last->data.instruction.opcode)) return 0;
+    if (info->jumps && (last->data.instruction.num_operands != 1 ||
+                        last->data.instruction.operands[0].type != OP_LABEL_REF)) {
+        return 0;
+    }
+    info->body_first = bb->first;
+    while (info->body_first < bb->end && statements[info->body_first]->type == AST_LABEL_DECLARATION) {
+        info->body_first++;
+    }
+    info->body_end = bb->end - (info->jumps ? 1 : 0);
+    return 1;
+}
+
+static size_t common_tail_length(AstNode** statements, const TailMergeBlock* a, const TailMergeBlock* b) {
+    size_t length = 0;
+    while (a->body_end - length > a->body_first && b->body_end - length > b->body_first &&
+           instructions_identical(&statements[a->body_end - length - 1]->data.instruction,
+                                  &statements[b->body_end - length - 1]->data.instruction)) {
+        length++;
+    }
+    return length;
+}
+
+/**
+ * @brief Kuyruğu silinen blok, kopyanın başladığı noktaya doğrudan düşer mi
+ * (korunan blok hemen ardından geliyor ve kuyruk gövdesinin tamamı)?
+ */
+static int tail_merge_falls_into(const Cfg* cfg, const TailMergeBlock* move, const TailMergeBlock* keep,
+                                 size_t length) {
+    return cfg->blocks[move->block].end == cfg->blocks[keep->block].first &&
+           keep->body_end - length == keep->body_first;
+}
+
+int optimize_tail_merging(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !symbol_table) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    AstNode** statements = ast_root->data.program.statements;
+    StatementReplacement* replacements = (StatementReplacement*)calloc(nb * 2 + 1, sizeof(StatementReplacement));
+    if (!replacements) {
+        fprintf(stderr, "Hata: Kuyruk birleştirme için bellek tahsis edilemedi.\n");
+        cfg_free(cfg);
+        return 0;
+    }
+
+    size_t num_replacements = 0;
+    int merged = 0, ok = 1;
+    for (size_t x = 0; x < nb && ok; x++) {
+        const BasicBlock* target = &cfg->blocks[x];
+        TailMergeBlock preds[TAIL_MERGE_MAX_PREDS];
+        size_t num_preds = 0;
+        for (size_t e = 0; e < target->num_preds && num_preds < TAIL_MERGE_MAX_PREDS; e++) {
+            if (tail_merge_scan_block(cfg, cfg->edges[target->pred_edges[e]].from, &preds[num_preds])) num_preds++;
+        }
+
+        // En çok küçülten çift: taşınan blok kuyruğunu ve JMP'sini "JMP T" ile değiştirir,
+        // düşen blok ise JMP eklemek zorunda kaldığı için bir komut daha az kazandırır.
+        // Kopya taşınan bloğun hemen ardından başlıyorsa JMP gerekmez.
+        long best_saving = 0;
+        size_t best_keep = 0, best_move = 0, best_length = 0;
+        for (size_t i = 0; i < num_preds; i++) {
+            for (size_t j = i + 1; j < num_preds; j++) {
+                size_t length = common_tail_length(statements, &preds[i], &preds[j]);
+                if (length == 0) continue;
+                size_t keep = preds[i].jumps ? j : i; // JMP ile biten taşınır
+                size_t move = keep == i ? j : i;
+                long saving = (long)length - (preds[move].jumps ? 0 : 1) +
+                              (tail_merge_falls_into(cfg, &preds[move], &preds[keep], length) ? 1 : 0);
+                if (saving > best_saving) {
+                    best_saving = saving;
+                    best_keep = keep;
+                    best_move = move;
+                    best_length = length;
+                }
+            }
+        }
+        if (best_saving <= 0) continue;
+
+        const TailMergeBlock* keep = &preds[best_keep];
+        const TailMergeBlock* move = &preds[best_move];
+        size_t keep_first = keep->body_end - best_length;
+        size_t move_first = move->body_end - best_length;
+        AstNode* origin = statements[move_first];
+        fprintf(stdout, "Optimizer: %zu komutluk ortak kuyruk birleştirildi (%d:%d -> %d:%d).\n", best_length,
+                origin->line, origin->column, statements[keep_first]->line, statements[keep_first]->column);
+        merged++;
+        StatementReplacement* at_move = &replacements[num_replacements++];
+        at_move->first = move_first;
+        at_move->end = cfg->blocks[move->block].end;
+        if (tail_merge_falls_into(cfg, move, keep, best_length)) continue;
+
+        char label[64];
+        cfg_make_unique_label(symbol_table, "__bsm_tail", label, sizeof(label));
+        StatementReplacement* at_keep = &replacements[num_replacements++];
+        at_keep->first = at_keep->end = keep_first;
+        ok = symbol_table_add_symbol(symbol_table, label, 0, 0, 0) &&
+             statement_list_append(&at_keep->emitted, ast_label_declaration_create(label, statements[keep_first]->line,
+                                                                                   statements[keep_first]->column)) &&
+             statement_list_append(&at_move->emitted,
+                                   dispatch_jump(TOKEN_JMP, label, origin, origin->data.instruction.has_profile,
+                                                 origin->data.instruction.profile_count, 0));
+    }
+
+    // Her öncülün tek ardılı olduğundan farklı hedeflerin çiftleri çakışmaz
+    qsort(replacements, num_replacements, sizeof(StatementReplacement), compare_replacements);
+    if (ok && merged && !apply_statement_replacements(ast_root, replacements, num_replacements)) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Hata: Kuyruk birleştirme yapılamadı (bellek hatası).\n");
+        merged = 0;
+    }
+    for (size_t r = 0; r < num_replacements; r++) statement_list_free(&replacements[r].emitted);
+    free(replacements);
+    cfg_free(cfg);
+    return merged > 0;
+}
+
+// --- Gözetleme Deliği (Peephole) ---
+// Süperoptimizasyon kural veritabanındaki kurallar uygulanır (bkz. superopt.h). Kurallar
+// tüm kalıp değişkenlerinin değerlerini korur; bayraklar korunmadığı için pencerenin
+// sonunda canlı olmamalıdır. Uzun kalıplar önce denenir.
+
+/**
+ * @brief Kural komutunu gerçek kaydedicilerle bir AST komutuna çevirir.
+ */
+static AstNode* peephole_instruction(const SuperoptInstr* instr, const int* registers, const AstNode* origin) {
+    AstNode* node = ast_instruction_create(instr->opcode, 2, origin->line, origin->column);
+    if (!node) return NULL;
+    AstInstruction* out = &node->data.instruction;
+    out->operands[0].type = OP_REGISTER;
+    out->operands[0].value.reg_index = registers[instr->dest];
+    if (instr->src_is_variable) {
+        out->operands[1].type = OP_REGISTER;
+        out->operands[1].value.reg_index = registers[instr->src];
+    } else {
+        out->operands[1].type = OP_INTEGER;
+        out->operands[1].value.int_value = instr->src;
+    }
+    out->has_profile = origin->data.instruction.has_profile;
+    out->profile_count = origin->data.instruction.profile_count;
+    return node;
+}
+
+int optimize_peephole(AstNode* ast_root, const SuperoptRules* rules) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !rules || rules->num_rules == 0) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t n = ast_root->data.program.num_statements;
+    size_t nb = cfg->num_blocks;
+    AstNode** statements = ast_root->data.program.statements;
+    uint32_t* live_in = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    uint32_t* live_out = (uint32_t*)malloc(sizeof(uint32_t) * (nb ? nb : 1));
+    unsigned char* flags_before = (unsigned char*)calloc(n + 1, 1);
+    unsigned char* flags_after = (unsigned char*)calloc(n + 1, 1);
+    StatementReplacement* replacements = (StatementReplacement*)calloc(n + 1, sizeof(StatementReplacement));
+    if (!live_in || !live_out || !flags_before || !flags_after || !replacements) {
+        fprintf(stderr, "Hata: Gözetleme deliği için bellek tahsis edilemedi.\n");
+        free(live_in); free(live_out); free(flags_before); free(flags_after); free(replacements);
+        cfg_free(cfg);
+        return 0;
+    }
+    cfg_compute_liveness(cfg, live_in, live_out);
+    compute_statement_flags_liveness(cfg, live_out, flags_before, flags_after);
+
+    size_t num_replacements = 0;
+    long saved = 0;
+    int ok = 1;
+    for (size_t i = 0; i < n && ok;) {
+        const SuperoptRule* rule = NULL;
+        SuperoptInstr pattern[SUPEROPT_MAX_PATTERN];
+        int registers[SUPEROPT_MAX_VARIABLES];
+        size_t length = SUPEROPT_MAX_PATTERN < n - i ? SUPEROPT_MAX_PATTERN : n - i;
+        for (; length > 0; length--) {
+            if (flags_after[i + length - 1] || superopt_canonicalize(statements, i, length, pattern, registers) < 0) {
+                continue;
+            }
+            rule = superopt_rules_find(rules, pattern, length);
+            if (rule && rule->has_replacement) break;
+            rule = NULL;
+        }
+        if (!rule) {
+            i++;
+            continue;
+        }
+        StatementReplacement* r = &replacements[num_replacements++];
+        r->first = i;
+        r->end = i + length;
+        for (size_t k = 0; k < rule->replacement_length && ok; k++) {
+            ok = statement_list_append(&r->emitted, peephole_instruction(&rule->replacement[k], registers,
+                                                                         statements[i]));
+        }
+        saved += (long)(length - rule->replacement_length);
+        i += length;
+    }
+
+    if (ok && num_replacements > 0) {
+        ok = apply_statement_replacements(ast_root, replacements, num_replacements);
+        if (ok) {
+            fprintf(stdout, "Optimizer: Gözetleme deliği %zu kural uyguladı (%ld komut kısaldı).\n",
+                    num_replacements, saved);
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Hata: Gözetleme deliği kuralları uygulanamadı (bellek hatası).\n");
+        num_replacements = 0;
+    }
+    for (size_t r = 0; r < n + 1; r++) statement_list_free(&replacements[r].emitted);
+    free(live_in); free(live_out); free(flags_before); free(flags_after); free(replacements);
+    cfg_free(cfg);
+    return num_replacements > 0;
+}
+
+// Blok yerleşimi için kenarları ağırlığa göre (azalan) sıralarken kullanılan bağlam
+static const Cfg* layout_sort_cfg = NULL;
+
+static int compare_edges_by_weight(const void* a, const void* b) {
+    const CfgEdge* x = &layout_sort_cfg->edges[*(const int*)a];
+    const CfgEdge* y = &layout_sort_cfg->edges[*(const int*)b];
+    if (x->weight != y->weight) return x->weight > y->weight ? -1 : 1;
+    return *(const int*)a - *(const int*)b; // Deterministik sıra
+}
+
+// Pettis-Hansen tarzı alttan üste zincirleme: en ağır kenarlardan başlayarak, kaynağı bir
+// zincirin sonu ve hedefi başka bir zincirin başı olan kenarlar birleştirilir.
+int optimize_block_layout(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM || !symbol_table) return 0;
+
+    Cfg* cfg = cfg_build(ast_root);
+    if (!cfg) return 0;
+    size_t nb = cfg->num_blocks;
+    if (nb < 2 || !cfg_compute_profile_weights(cfg)) {
+        cfg_free(cfg); // Profil yoksa statik sezgiler yerine mevcut sıra korunur
+        return 0;
+    }
+
+    int* chain_of = (int*)malloc(sizeof(int) * nb);   // Bloğun ait olduğu zincir (baş bloğu)
+    int* next_in_chain = (int*)malloc(sizeof(int) * nb);
+    int* chain_tail = (int*)malloc(sizeof(int) * nb); // Zincir başı -> son blok
+    int* sorted_edges = (int*)malloc(sizeof(int) * (cfg->num_edges ? cfg->num_edges : 1));
+    int* order = (int*)malloc(sizeof(int) * nb);
+    int* chains = (int*)malloc(sizeof(int) * nb);
+    uint64_t* chain_weight = (uint64_t*)calloc(nb, sizeof(uint64_t));
+    if (!chain_of || !next_in_chain || !chain_tail || !sorted_edges || !order || !chains || !chain_weight) {
+        fprintf(stderr, "Hata: Blok yerleşimi için bellek tahsis edilemedi.\n");
+        free(chain_of); free(next_in_chain); free(chain_tail); free(sorted_edges);
+        free(order); free(chains); free(chain_weight);
+        cfg_free(cfg);
+        return 0;
+    }
+
+    for (size_t b = 0; b < nb; b++) {
+        chain_of[b] = (int)b;
+        next_in_chain[b] = -1;
+        chain_tail[b] = (int)b;
+    }
+    for (size_t e = 0; e < cfg->num_edges; e++) sorted_edges[e] = (int)e;
+    layout_sort_cfg = cfg;
+    qsort(sorted_edges, cfg->num_edges, sizeof(int), compare_edges_by_weight);
+    layout_sort_cfg = NULL;
+
+    for (size_t i = 0; i < cfg->num_edges; i++) {
+        const CfgEdge* edge = &cfg->edges[sorted_edges[i]];
+        if (edge->weight == 0) break;
+        if (edge->to == 0 || edge->from == edge->to) continue; // Giriş bloğu daima zincir başıdır
+        if (edge->kind == CFG_EDGE_TAKEN) {
+            // Alınan kenarın düşmeye dönüşmesi için atlama ya JMP ya da tersine çevrilebilir olmalı
+            AstNode* last = cfg_block_last_instruction(cfg, edge->from);
+            TokenType op = last->data.instruction.opcode;
+            if (op != TOKEN_JMP && op != TOKEN_JEQ && op != TOKEN_JNE) continue;
+        }
+        int from_chain = chain_of[edge->from];
+        int to_chain = chain_of[edge->to];
+        if (from_chain == to_chain || chain_tail[from_chain] != edge->from || to_chain != edge->to) continue;
+
+        next_in_chain[edge->from] = edge->to;
+        chain_tail[from_chain] = chain_tail[to_chain];
+        for (int b = to_chain; b != -1; b = next_in_chain[b]) chain_of[b] = from_chain;
+    }
+
+    // Zincirleri sırala: giriş zinciri, sıcak zincirler (ağırlığa göre), soğuk zincirler (orijinal sıra)
+    size_t num_chains = 0;
+    for (size_t b = 0; b < nb; b++) {
+        if (chain_of[b] == (int)b) chains[num_chains++] = (int)b;
+        if (cfg->blocks[b].weight > chain_weight[chain_of[b]]) chain_weight[chain_of[b]] = cfg->blocks[b].weight;
+    }
+    for (size_t i = 1; i < num_chains; i++) { // Kararlı ekleme sıralaması (zincir sayısı küçük)
+        int c = chains[i];
+        size_t j = i;
+        while (j > 1 && chain_weight[chains[j - 1]] < chain_weight[c]) {
+            chains[j] = chains[j - 1];
+            j--;
+        }
+        chains[j] = c;
+    }
+
+    size_t count = 0;
+    size_t cold_blocks = 0;
+    int changed = 0;
+    for (size_t i = 0; i < num_chains; i++) {
+        for (int b = chains[i]; b != -1; b = next_in_chain[b]) {
+            if (chain_weight[chains[i]] == 0) cold_blocks++;
+            if (b != (int)count) changed = 1;
+            order[count++] = b;
+        }
+    }
+
+    if (changed) {
+        if (cfg_linearize(cfg, order, symbol_table)) {
+            fprintf(stdout, "Optimizer: Profil güdümlü blok yerleşimi uygulandı (%zu blok, %zu soğuk blok sona taşındı).\n",
+                    nb, cold_blocks);
+        } else {
+            changed = 0;
+        }
+    }
+
+    free(chain_of); free(next_in_chain); free(chain_tail); free(sorted_edges);
+    free(order); free(chains); free(chain_weight);
+    cfg_free(cfg);
+    return changed;
+}
+
+
+// --- IR Üzerinde Çalışan Geçişler ---
+// Program üç adresli IR'ye indirgenir, geçiş IR üzerinde çalışır ve değişiklik varsa IR
+// AST'ye geri çevrilir. Değişiklik yoksa AST'ye dokunulmaz.
+
+int optimize_dead_values(AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+
+    IrFunction* fn = ir_lower_program(ast_root);
+    if (!fn) return 0;
+    int removed = ir_eliminate_dead_values(fn);
+    if (removed > 0 && (!ir_verify(fn) || !ir_lift_to_program(fn, ast_root, symbol_table))) {
+        removed = 0;
+    }
+    ir_function_free(fn);
+
+    if (removed > 0) {
+        fprintf(stdout, "Optimizer: %d ölü değer üreten komut silindi (IR).\n", removed);
+    }
+    return removed > 0;
+}
+
+int optimize_instruction_scheduling(AstNode* ast_root, SymbolTable* symbol_table, TargetArchitecture arch) {
+    if (!ast_root || ast_root->type != AST_PROGRAM) return 0;
+    const TargetPipelineModel* model = target_cost_model(arch)->pipeline;
+    if (!model->in_order) return 0; // Sıra dışı çekirdekler komutları kendileri yeniden sıralar
+
+    IrFunction* fn = ir_lower_program(ast_root);
+    if (!fn) return 0;
+    SchedStats stats;
+    int changed = sched_ir_function(fn, model, &stats) && stats.num_regions > 0;
+    if (changed && (!ir_verify(fn) || !ir_lift_to_program(fn, ast_root, symbol_table))) {
+        changed = 0;
+    }
+    ir_function_free(fn);
+
+    if (changed) {
+        fprintf(stdout, "Optimizer: %zu bölgede komutlar yeniden sıralandı (tahmini %llu -> %llu çevrim, IR).\n",
+                stats.num_regions, (unsigned long long)stats.cycles_before, (unsigned long long)stats.cycles_after);
+    }
+    return changed;
+}
+
+// --- Geçiş Hatları (Pass Pipelines) ---
+// Her optimizasyon seviyesi bir geçiş tablosuyla tanımlanır. ITERATIVE geçişler sabit
+// noktaya kadar (veya iterasyon sınırına kadar) tekrarlanır; FINAL geçişler en sonda
+// bir kez çalışır. "expensive" geçişler zaman bütçesi aşılacaksa atlanır.
+
+typedef struct {
+    Optimizer* optimizer;
+    SymbolTable* symbol_table;
+    long inline_budget;         // Kalan satır içi açma büyüme bütçesi (tüm iterasyonlarda ortak)
+    long unroll_budget;         // Kalan döngü açma büyüme bütçesi (tüm iterasyonlarda ortak)
+    int unroll_factor;          // Seviyenin kısmi döngü açma katsayısı sınırı
+    int unroll_max_size;        // Seviyenin açılmış gövde boyutu sınırı
+} PassContext;
+
+typedef enum {
+    PASS_ITERATIVE,             // Sabit nokta döngüsünde çalışır
+    PASS_FINAL                  // Döngüden sonra bir kez çalışır
+} PassPhase;
+
+// Geçişin program boyutuna göre kabaca karmaşıklığı (ilk çalışma süresi tahmini için)
+typedef enum {
+    PASS_COST_LINEAR,
+    PASS_COST_QUADRATIC
+} PassCost;
+
+typedef struct {
+    const char* name;
+    int (*run)(AstNode* ast_root, PassContext* context);
+    PassPhase phase;
+    int expensive;              // Zaman bütçesi aşılacaksa atlanabilir
+    PassCost cost;
+} OptimizerPass;
+
+typedef struct {
+    const char* name;
+    const OptimizerPass* passes;
+    size_t num_passes;
+    int inline_growth_percent;  // Satır içi açma bütçesi (program boyutunun yüzdesi, 0 = sadece küçülten açmalar)
+    int unroll_factor;          // Kısmi döngü açmanın en büyük katsayısı (1 = sadece #unroll yönergeleri)
+    int unroll_max_size;        // Açılmış döngü gövdesinin en fazla komut sayısı (0 = sadece yönergeler)
+    int unroll_growth_percent;  // Döngü açma bütçesi (program boyutunun yüzdesi)
+    int max_iterations;         // Sabit nokta döngüsünün üst sınırı
+} OptimizationLevelConfig;
+
+static int pass_inline(AstNode* ast_root, PassContext* context) {
+    return optimize_inline_subroutines(ast_root, context->symbol_table, &context->inline_budget);
+}
+static int pass_dead_code(AstNode* ast_root, PassContext* context) {
+    return optimize_dead_code_elimination(ast_root, context->symbol_table);
+}
+static int pass_jump_threading(AstNode* ast_root, PassContext* context) {
+    return optimize_jump_threading(ast_root, context->symbol_table);
+}
+static int pass_constant_folding(AstNode* ast_root, PassContext* context) {
+    (void)context;
+    return optimize_constant_folding(ast_root);
+}
+static int pass_redundant_compares(AstNode* ast_root, PassContext* context) {
+    return optimize_redundant_compares(ast_root, context->optimizer->target_arch);
+}
+static int pass_copy_propagation(AstNode* ast_root, PassContext* context) {
+    return optimize_copy_propagation(ast_root);
+}
+static int pass_move_coalescing(AstNode* ast_root, PassContext* context) {
+    return optimize_move_coalescing(ast_root);
+}
+static int pass_dead_values(AstNode* ast_root, PassContext* context) {
+    return optimize_dead_values(ast_root, context->symbol_table);
+}
+static int pass_peephole(AstNode* ast_root, PassContext* context) {
+    return optimize_peephole(ast_root, context->optimizer->superopt_rules);
+}
+static int pass_dispatch_chains(AstNode* ast_root, PassContext* context) {
+    return optimize_dispatch_chains(ast_root, context->symbol_table,
+                                    context->optimizer->optimization_level == OPT_LEVEL_OS);
+}
+static int pass_if_conversion(AstNode* ast_root, PassContext* context) {
+    return optimize_if_conversion(ast_root, context->optimizer->target_arch,
+                                  context->optimizer->optimization_level == OPT_LEVEL_OS);
+}
+static int pass_loop_unrolling(AstNode* ast_root, PassContext* context) {
+    return optimize_loop_unrolling(ast_root, context->symbol_table, context->unroll_factor,
+                                   context->unroll_max_size, &context->unroll_budget);
+}
+static int pass_tail_merging(AstNode* ast_root, PassContext* context) {
+    return optimize_tail_merging(ast_root, context->symbol_table);
+}
+static int pass_outlining(AstNode* ast_root, PassContext* context) {
+    return optimize_outlining(ast_root, context->symbol_table);
+}
+static int pass_block_layout(AstNode* ast_root, PassContext* context) {
+    return optimize_block_layout(ast_root, context->symbol_table);
+}
+static int pass_scheduling(AstNode* ast_root, PassContext* context) {
+    return optimize_instruction_scheduling(ast_root, context->symbol_table, context->optimizer->target_arch);
+}
+
+// -O1: Hızlı derleme; sadece ucuz, yerel temizlik geçişleri ve küçülten satır içi açma
+static const OptimizerPass o1_passes[] = {
+    {"inline", pass_inline, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"dce", pass_dead_code, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"jump-threading", pass_jump_threading, PASS_ITERATIVE, 1, PASS_COST_QUADRATIC},
+    {"constant-folding", pass_constant_folding, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"copy-propagation", pass_copy_propagation, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"move-coalescing", pass_move_coalescing, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"dead-values", pass_dead_values, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"peephole", pass_peephole, PASS_ITERATIVE, 0, PASS_COST_LINEAR}, // Kural veritabanı yüklendiyse
+    {"loop-unrolling", pass_loop_unrolling, PASS_ITERATIVE, 1, PASS_COST_LINEAR}, // Sadece #unroll yönergeleri
+};
+
+// -O2 / -O3: Tüm geçişler; -O3 daha büyük satır içi açma bütçesi kullanır
+static const OptimizerPass o2_passes[] = {
+    {"inline", pass_inline, PASS_ITERATIVE, 1, PASS_COST_LINEAR},
+    {"dce", pass_dead_code, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"jump-threading", pass_jump_threading, PASS_ITERATIVE, 1, PASS_COST_QUADRATIC},
+    {"constant-folding", pass_constant_folding, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"copy-propagation", pass_copy_propagation, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"move-coalescing", pass_move_coalescing, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"dead-values", pass_dead_values, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"peephole", pass_peephole, PASS_ITERATIVE, 0, PASS_COST_LINEAR}, // Kural veritabanı yüklendiyse
+    {"redundant-compares", pass_redundant_compares, PASS_ITERATIVE, 1, PASS_COST_LINEAR},
+    {"dispatch-chains", pass_dispatch_chains, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"if-conversion", pass_if_conversion, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"loop-unrolling", pass_loop_unrolling, PASS_ITERATIVE, 1, PASS_COST_LINEAR}, // Seçimler tek bloklu döngü açar
+    {"block-layout", pass_block_layout, PASS_FINAL, 1, PASS_COST_LINEAR}, // Diğer geçişler yerleşimi bozabilir
+    {"scheduling", pass_scheduling, PASS_FINAL, 1, PASS_COST_LINEAR}, // Komut sırası son haliyle
+};
+
+// -Os: Boyut; kodu büyüten geçişler (büyüten satır içi açma, JMP ekleyen blok yerleşimi) yok,
+// tekrarlanan kod kuyruk birleştirme ve kod dışlama ile paylaşılır
+static const OptimizerPass os_passes[] = {
+    {"inline", pass_inline, PASS_ITERATIVE, 1, PASS_COST_LINEAR},
+    {"dce", pass_dead_code, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"jump-threading", pass_jump_threading, PASS_ITERATIVE, 1, PASS_COST_QUADRATIC},
+    {"constant-folding", pass_constant_folding, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"copy-propagation", pass_copy_propagation, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"move-coalescing", pass_move_coalescing, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"dead-values", pass_dead_values, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"peephole", pass_peephole, PASS_ITERATIVE, 0, PASS_COST_LINEAR}, // Kural veritabanı yüklendiyse
+    {"redundant-compares", pass_redundant_compares, PASS_ITERATIVE, 1, PASS_COST_LINEAR},
+    {"dispatch-chains", pass_dispatch_chains, PASS_ITERATIVE, 0, PASS_COST_LINEAR}, // Sadece küçülten tablolar
+    {"if-conversion", pass_if_conversion, PASS_ITERATIVE, 0, PASS_COST_LINEAR},     // Sadece küçülten dönüşümler
+    {"loop-unrolling", pass_loop_unrolling, PASS_ITERATIVE, 1, PASS_COST_LINEAR},   // Sadece #unroll yönergeleri
+    {"tail-merging", pass_tail_merging, PASS_ITERATIVE, 0, PASS_COST_LINEAR},
+    {"outlining", pass_outlining, PASS_FINAL, 1, PASS_COST_LINEAR}, // CALL tüm kaydedicileri bozar; en sonda
+};
+
+#define PASS_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+#define OPTIMIZER_MAX_PASSES 32 // Bir seviyedeki en fazla geçiş sayısı
+
+// {ad, geçişler, geçiş sayısı, satır içi büyüme %, açma katsayısı, açılmış gövde sınırı, açma büyüme %, iterasyon}
+static const OptimizationLevelConfig level_configs[] = {
+    [OPT_LEVEL_O0] = {"-O0", NULL, 0, 0, 1, 0, 0, 0},
+    [OPT_LEVEL_O1] = {"-O1", o1_passes, PASS_COUNT(o1_passes), 0, 1, 0, 0, 4},
+    [OPT_LEVEL_O2] = {"-O2", o2_passes, PASS_COUNT(o2_passes), 25, 4, 32, 25, 16},
+    [OPT_LEVEL_O3] = {"-O3", o2_passes, PASS_COUNT(o2_passes), 60, 8, 128, 60, 32},
+    [OPT_LEVEL_OS] = {"-Os", os_passes, PASS_COUNT(os_passes), 0, 1, 0, 0, 16},
+};
+
+const char* optimization_level_to_string(int level) {
+    if (level < OPT_LEVEL_O0 || level > OPT_LEVEL_OS) return "UNKNOWN_OPT_LEVEL";
+    return level_configs[level].name;
+}
+
+/**
+ * @brief Başlangıçtan bu yana geçen işlemci zamanını milisaniye cinsinden döndürür.
+ */
+static double elapsed_ms(clock_t start) {
+    return (double)(clock() - start) * 1000.0 / (double)CLOCKS_PER_SEC;
+}
+
+// İlk çalışma süresi tahmini için kaba hız varsayımları (ifade/ms)
+#define PASS_LINEAR_STATEMENTS_PER_MS 20000.0
+#define PASS_QUADRATIC_STEPS_PER_MS 2000000.0
+
+/**
+ * @brief Bir geçişin süresini tahmin eder: daha önce çalıştıysa son süresi,
+ * çalışmadıysa program boyutuna ve geçişin karmaşıklığına göre bir tahmin.
+ */
+static double predict_pass_ms(const OptimizerPass* pass, const AstNode* ast_root, double last_cost_ms) {
+    if (last_cost_ms >= 0.0) return last_cost_ms;
+    double n = (double)ast_root->data.program.num_statements;
+    return pass->cost == PASS_COST_QUADRATIC ? n * n / PASS_QUADRATIC_STEPS_PER_MS
+                                             : n / PASS_LINEAR_STATEMENTS_PER_MS;
+}
+
+/**
+ * @brief Bir geçişi zaman bütçesini gözeterek çalıştırır.
+ * Pahalı bir geçişin tahmini süresi kalan bütçeyi aşacaksa geçiş atlanır;
+ * bu sayede çok büyük girdilerde pahalı geçişler bütçeyi tüketmeden devre dışı kalır.
+ * @param last_cost_ms Geçişin son çalışma süresi (hiç çalışmadıysa negatif, güncellenir).
+ * @return Geçişin döndürdüğü değişiklik sayısı (atlandıysa 0).
+ */
+static int run_pass(const OptimizerPass* pass, AstNode* ast_root, PassContext* context, clock_t start,
+                    double* last_cost_ms, int* skipped) {
+    long budget_ms = context->optimizer->opt_budget_ms;
+    if (pass->expensive && budget_ms > 0 &&
+        elapsed_ms(start) + predict_pass_ms(pass, ast_root, *last_cost_ms) > (double)budget_ms) {
+        if (!*skipped) {
+            fprintf(stdout, "Optimizer: Derleme süresi bütçesi (%ld ms) nedeniyle '%s' geçişi atlandı.\n",
+                    budget_ms, pass->name);
+            *skipped = 1;
+        }
+        return 0;
+    }
+    clock_t pass_start = clock();
+    int changes = pass->run(ast_root, context);
+    *last_cost_ms = elapsed_ms(pass_start);
+    return changes;
+}
+
+int perform_optimizations(Optimizer* optimizer, AstNode* ast_root, SymbolTable* symbol_table) {
+    if (!optimizer || !ast_root || !symbol_table) {
+        fprintf(stderr, "Hata: Optimizasyon için geçersiz giriş.\n");
+        return 0;
+    }
+    if (optimizer->optimization_level < OPT_LEVEL_O0 || optimizer->optimization_level > OPT_LEVEL_OS) {
+        fprintf(stderr, "Hata: Geçersiz optimizasyon seviyesi: %d\n", optimizer->optimization_level);
+        return 0;
+    }
+
+    const OptimizationLevelConfig* config = &level_configs[optimizer->optimization_level];
+    clock_t start = clock();
+    int total_changes = 0;
+
+    fprintf(stdout, "\n--- Bessambly Optimizasyon Başlatılıyor (%s) ---\n", config->name);
+
+    // Optimizasyon öncesi sanal adresleri hesaplayın.
+    // Bu kısım, semantik analizden sonra veya optimizasyonun başında yapılabilir.
+    // calculate_virtual_addresses(ast_root, symbol_table); 
+
+    // PGO: Profil, enstrümantasyonun yapıldığı aynı noktada (hiçbir dönüşümden önce)
+    // uygulanmalıdır; aksi halde CFG özeti eşleşmez. Bu adımlar her seviyede yapılır.
+    if (optimizer->profile) {
+        profile_annotate_program(ast_root, optimizer->profile);
+    }
+    if (optimizer->instrument_profile) {
+        if (!profile_instrument_program(ast_root, symbol_table, optimizer->profile_exit_syscall,
+                                        &optimizer->instrumentation)) {
+            return 0;
+        }
+    }
+
+    PassContext context;
+    context.optimizer = optimizer;
+    context.symbol_table = symbol_table;
+    context.inline_budget = inline_growth_budget(ast_root, config->inline_growth_percent);
+    context.unroll_budget = inline_growth_budget(ast_root, config->unroll_growth_percent);
+    context.unroll_factor = config->unroll_factor;
+    context.unroll_max_size = config->unroll_max_size;
+
+    double pass_costs[OPTIMIZER_MAX_PASSES];      // Her geçişin son çalışma süresi (ms, -1 = henüz çalışmadı)
+    int pass_skipped[OPTIMIZER_MAX_PASSES] = {0}; // Atlama mesajı her geçiş için bir kez yazılır
+    size_t num_passes = config->num_passes < OPTIMIZER_MAX_PASSES ? config->num_passes : OPTIMIZER_MAX_PASSES;
+    for (size_t p = 0; p < num_passes; p++) pass_costs[p] = -1.0;
+
+    // Sabit Nokta İterasyonu: Hiçbir değişiklik yapılmayana kadar (veya sınıra kadar) tekrarla.
+    // Her geçiş, bir diğerinin daha fazla optimizasyon yapmasını sağlayabilir.
+    int iteration = 0;
+    int iteration_changes;
+    do {
+        iteration_changes = 0;
+        for (size_t p = 0; p < num_passes; p++) {
+            if (config->passes[p].phase != PASS_ITERATIVE) continue;
+            iteration_changes += run_pass(&config->passes[p], ast_root, &context, start,
+                                          &pass_costs[p], &pass_skipped[p]);
+        }
+        total_changes += iteration_changes;
+        iteration++;
+    } while (iteration_changes > 0 && iteration < config->max_iterations);
+
+    if (iteration_changes > 0) {
+        fprintf(stdout, "Optimizer: İterasyon sınırına (%d) ulaşıldı.\n", config->max_iterations);
+    }
+
+    // Süperoptimizasyon: optimize edilmiş koddaki sıcak diziler aranır; yeni kurallar hemen uygulanır
+    if (optimizer->superoptimize && optimizer->superopt_rules) {
+        int found = superopt_search_program(ast_root, optimizer->superopt_rules);
+        if (found < 0) return 0;
+        if (found > 0 && config->num_passes > 0) {
+            total_changes += optimize_peephole(ast_root, optimizer->superopt_rules);
+        }
+    }
+
+    for (size_t p = 0; p < num_passes; p++) {
+        if (config->passes[p].phase != PASS_FINAL) continue;
+        total_changes += run_pass(&config->passes[p], ast_root, &context, start, &pass_costs[p], &pass_skipped[p]);
+    }
+
+    if (total_changes > 0) {
+        fprintf(stdout, "Toplam %d optimizasyon değişikliği yapıldı.\n", total_changes);
+    } else {
+        fprintf(stdout, "Hiçbir optimizasyon değişikliği yapılmadı.\n");
+    }
+
+    fprintf(stdout, "Optimizasyon başarıyla tamamlandı (%.1f ms).\n", elapsed_ms(start));
+    return 1; // Başarılı
+}
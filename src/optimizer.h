@@ -1,70 +1,264 @@
-#ifndef OPTIMIZER_H
-#define OPTIMIZER_H
-
-#include "ast.h" // AST düğüm yapılarına erişim
-#include "semantic_analyzer.h" // Sembol tablosu gibi bilgilere erişim
-
-// --- Optimizer Yapısı (İsteğe Bağlı) ---
-// Daha karmaşık optimizasyonlar için bir bağlam tutabilir.
-// Şimdilik sadece fonksiyonlar yeterli olabilir.
-typedef struct {
-    // Gelecekte eklenebilecek bağlam bilgileri (örn: optimizasyon seviyesi, istatistikler)
-    int optimization_level; // Örn: 0=Hiç optimizasyon yok, 1=Basit optimizasyonlar
-} Optimizer;
-
-// --- Fonksiyon Prototipleri ---
-
-/**
- * @brief Yeni bir Optimizer örneği başlatır.
- * @return Başlatılmış Optimizer pointer'ı veya NULL hata durumunda.
- */
-Optimizer* optimizer_init();
-
-/**
- * @brief Optimizer'ı kapatır ve kullanılan kaynakları serbest bırakır.
- * @param optimizer Kapatılacak Optimizer pointer'ı.
- */
-void optimizer_close(Optimizer* optimizer);
-
-/**
- * @brief AST üzerinde çeşitli optimizasyon geçişlerini gerçekleştirir.
- * Bu fonksiyon, bir veya daha fazla optimizasyon algoritmasını uygulayabilir.
- * @param optimizer Optimizer pointer'ı.
- * @param ast_root Optimize edilecek AST'nin kök düğümü.
- * @param symbol_table Semantik analizden gelen sembol tablosu (gerekli olabilir).
- * @return Optimizasyon başarılıysa 1, aksi takdirde 0.
- */
-int perform_optimizations(Optimizer* optimizer, AstNode* ast_root, SymbolTable* symbol_table);
-
-// --- Bağımsız Optimizasyon Geçişleri (Örnekler) ---
-
-/**
- * @brief Ölü kod eleme geçişi. Ulaşılmayan kodları (örn: JMP sonrası ölü kod) kaldırır.
- * @param ast_root Optimize edilecek AST'nin kök düğümü.
- * @param symbol_table Sembol tablosu (etiket adresleri için).
- * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
- */
-int optimize_dead_code_elimination(AstNode* ast_root, SymbolTable* symbol_table);
-
-/**
- * @brief Sabit katlama geçişi. Derleme zamanında bilinen aritmetik işlemleri hesaplar.
- * Örn: ADD R0, 5; ADD R0, 3  -> ADD R0, 8 (bu Instruction Level IR'de daha iyi olurdu)
- * Bu örnek için daha çok "doğrudan sabit kullanım" anlamında düşünebiliriz:
- * MOV R0, 10; ADD R0, 5 -> MOV R0, 15
- * @param ast_root Optimize edilecek AST'nin kök düğümü.
- * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
- */
-int optimize_constant_folding(AstNode* ast_root);
-
-/**
- * @brief Etiket atlamalarını kısaltma (Jump Threading) geçişi.
- * Birden fazla JMP komutunu birleştirmeye çalışır.
- * Örn: JMP LabelA; ... LabelA: JMP LabelB -> JMP LabelB
- * @param ast_root Optimize edilecek AST'nin kök düğümü.
- * @param symbol_table Sembol tablosu (etiket adresleri için).
- * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
- */
-int optimize_jump_threading(AstNode* ast_root, SymbolTable* symbol_table);
-
-
-#endif // OPTIMIZER_H
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "ast.h" // AST düğüm yapılarına erişim
+#include "semantic_analyzer.h" // Sembol tablosu gibi bilgilere erişim
+#include "profile.h" // PGO profil verisi ve enstrümantasyon
+#include "superopt.h" // Süperoptimizasyon kural veritabanı
+#include "os/target.h" // Hedef mimari (bayrak davranışı vb.)
+
+// --- Optimizasyon Seviyeleri ---
+// Her seviyenin geçiş hattı optimizer.c'deki seviye tablosunda tanımlıdır.
+typedef enum {
+    OPT_LEVEL_O0 = 0,   // Optimizasyon yok (en hızlı derleme; PGO enstrümantasyonu yine yapılır)
+    OPT_LEVEL_O1 = 1,   // Ucuz yerel geçişler
+    OPT_LEVEL_O2 = 2,   // Tüm geçişler, ölçülü kod büyümesi
+    OPT_LEVEL_O3 = 3,   // Tüm geçişler, daha agresif satır içi açma
+    OPT_LEVEL_OS = 4    // Boyut için optimizasyon (kodu büyüten geçişler yok)
+} OptimizationLevel;
+
+// --- Optimizer Yapısı (İsteğe Bağlı) ---
+// Daha karmaşık optimizasyonlar için bir bağlam tutabilir.
+// Şimdilik sadece fonksiyonlar yeterli olabilir.
+typedef struct {
+    // Gelecekte eklenebilecek bağlam bilgileri (örn: optimizasyon seviyesi, istatistikler)
+    int optimization_level; // OptimizationLevel değerlerinden biri
+    long opt_budget_ms;     // Derleme süresi bütçesi (ms); aşılacaksa pahalı geçişler atlanır, 0 = sınırsız
+
+    // Profil güdümlü optimizasyon (PGO)
+    int instrument_profile;         // 1 ise program kenar sayaçlarıyla enstrümante edilir
+    int64_t profile_exit_syscall;   // PROFDUMP eklenecek çıkış sistem çağrısı numarası
+    const char* profile_output_path; // Enstrümante programın sayaçları yazacağı .bsmprof yolu (kod üretici için)
+    ProfileInstrumentation instrumentation; // Enstrümantasyon sonucu (kod üretici için)
+    ProfileData* profile;           // Kullanılacak .bsmprof verisi (yoksa NULL, Optimizer'a aittir)
+
+    // Süperoptimizasyon
+    SuperoptRules* superopt_rules;  // Gözetleme deliği kuralları (yoksa NULL, Optimizer'a aittir)
+    int superoptimize;              // 1 ise sıcak diziler için yeni kurallar aranır ve veritabanına eklenir
+
+    TargetArchitecture target_arch; // Hedefe bağlı geçişler için (örn: aritmetik bayrak ayarlar mı)
+} Optimizer;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Yeni bir Optimizer örneği başlatır.
+ * @return Başlatılmış Optimizer pointer'ı veya NULL hata durumunda.
+ */
+Optimizer* optimizer_init();
+
+/**
+ * @brief Optimizer'ı kapatır ve kullanılan kaynakları serbest bırakır.
+ * @param optimizer Kapatılacak Optimizer pointer'ı.
+ */
+void optimizer_close(Optimizer* optimizer);
+
+/**
+ * @brief Optimizasyon seviyesinin komut satırı karşılığını döndürür (örn: "-O2").
+ * @param level OptimizationLevel değeri.
+ * @return Seviyenin string karşılığı.
+ */
+const char* optimization_level_to_string(int level);
+
+/**
+ * @brief AST üzerinde seçili optimizasyon seviyesinin geçiş hattını çalıştırır.
+ * Geçişler sabit noktaya kadar tekrarlanır; opt_budget_ms verildiyse pahalı geçişler
+ * bütçeyi aşacaklarsa atlanır.
+ * @param optimizer Optimizer pointer'ı.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Semantik analizden gelen sembol tablosu (gerekli olabilir).
+ * @return Optimizasyon başarılıysa 1, aksi takdirde 0.
+ */
+int perform_optimizations(Optimizer* optimizer, AstNode* ast_root, SymbolTable* symbol_table);
+
+// --- Bağımsız Optimizasyon Geçişleri (Örnekler) ---
+
+/**
+ * @brief Ölü kod eleme geçişi. Ulaşılmayan kodları (örn: JMP sonrası ölü kod) kaldırır.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (etiket adresleri için).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_dead_code_elimination(AstNode* ast_root, SymbolTable* symbol_table);
+
+/**
+ * @brief Sabit katlama geçişi. Derleme zamanında bilinen aritmetik işlemleri hesaplar.
+ * Örn: ADD R0, 5; ADD R0, 3  -> ADD R0, 8 (bu Instruction Level IR'de daha iyi olurdu)
+ * Bu örnek için daha çok "doğrudan sabit kullanım" anlamında düşünebiliriz:
+ * MOV R0, 10; ADD R0, 5 -> MOV R0, 15
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_constant_folding(AstNode* ast_root);
+
+/**
+ * @brief Etiket atlamalarını kısaltma (Jump Threading) geçişi.
+ * Birden fazla JMP komutunu birleştirmeye çalışır.
+ * Örn: JMP LabelA; ... LabelA: JMP LabelB -> JMP LabelB
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (etiket adresleri için).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_jump_threading(AstNode* ast_root, SymbolTable* symbol_table);
+
+/**
+ * @brief Profil güdümlü blok yerleşimi ve sıcak/soğuk ayrımı geçişi.
+ * Kenar ağırlıklarına göre blokları zincirler (Pettis-Hansen): en sık alınan kenarlar
+ * düşme (fallthrough) kenarı olur. Hiç çalışmamış (soğuk) bloklar program sonuna taşınır.
+ * Sadece komutlarda profil bilgisi varsa çalışır.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (yeni etiketler için).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_block_layout(AstNode* ast_root, SymbolTable* symbol_table);
+
+/**
+ * @brief Alt program satır içi açma (inlining) geçişi.
+ * Alt programlar CALL hedeflerinden CFG üzerinde bulunur. Küçük veya tek çağrı noktalı
+ * alt programların gövdesi çağrı noktasına kopyalanır: gövdedeki etiketler yeniden
+ * adlandırılır, RET'ler dönüş etiketine JMP olur. Karar, gövde boyutu ile çağrı sıklığına
+ * (varsa profil sayımları) dayalı bir maliyet modeli ve toplam büyüme bütçesiyle verilir.
+ * Tüm çağrıları açılan alt programın orijinal gövdesi silinir.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (yeni etiketler için).
+ * @param growth_budget Kalan büyüme bütçesi (komut sayısı); açılan her gövde kadar azaltılır.
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_inline_subroutines(AstNode* ast_root, SymbolTable* symbol_table, long* growth_budget);
+
+/**
+ * @brief Kopya yayma (copy propagation) geçişi.
+ * "MOV Rx, Ry" sonrasında, ne Rx ne Ry yeniden tanımlanmadığı sürece Rx okumaları Ry'ye
+ * yönlendirilir (CFG üzerinde tüm yollarda geçerli kopyalar). Ardından hedefi artık
+ * okunmayan MOV'lar ve "MOV Rx, Rx" komutları silinir.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_copy_propagation(AstNode* ast_root);
+
+/**
+ * @brief Kaydedici taşıma birleştirme (move coalescing) geçişi.
+ * "MOV Rx, Ry" komutunda Ry'nin yaşam aralığı kopyada bitiyorsa ve Rx'in yeni yaşam aralığı
+ * Ry ile çakışmadan blok içinde sona eriyorsa, aralıktaki Rx'ler Ry olarak yeniden adlandırılır
+ * ve kopya tamamen silinir (örn: MOV R1, R0; ADD R1, 5; MOV R2, R1 -> ADD R0, 5; MOV R2, R0).
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_move_coalescing(AstNode* ast_root);
+
+/**
+ * @brief Gereksiz karşılaştırma (CMP) eleme geçişi.
+ * Bayrak yazmacı CFG üzerinde birinci sınıf bir değer olarak izlenir: aynı operandlarla
+ * yapılmış ve arada bayrakları veya operandları bozulmamış bir CMP zaten tüm yollarda
+ * mevcutsa tekrar eden CMP kaldırılır.
+ * Örn: CMP R1, R2; JEQ A; CMP R1, R2; JLT B -> CMP R1, R2; JEQ A; JLT B
+ * ADD/SUB bayrakları her hedefte (sonuç, 0) olarak kurar; aritmetiği bayrak ayarlayan
+ * hedeflerde, sadece JEQ/JNE tarafından okunan "CMP R, 0" komutu R'yi üreten ADD/SUB'ın
+ * bayraklarıyla değiştirilir.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param arch Hedef mimari (sadece kazanç kararı için; anlamı etkilemez).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_redundant_compares(AstNode* ast_root, TargetArchitecture arch);
+
+/**
+ * @brief Karşılaştırma zinciri indirgeme (switch lowering) geçişi.
+ * Aynı kaydediciyi sırayla sabitlerle karşılaştıran "CMP R, k; JEQ Lk" zincirleri bulunur.
+ * Anahtarlar yoğunsa zincir tek bir sınır kontrollü atlama tablosuna (JTAB) dönüştürülür,
+ * seyrekse O(log n) adımda karar veren dengeli bir karşılaştırma ağacı (CMP/JEQ/JLT) üretilir.
+ * Hedeflerde bayraklar canlıysa zincire dokunulmaz (zincirin bıraktığı bayraklar değişir).
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (yeni etiketler için).
+ * @param optimize_for_size 1 ise sadece kodu küçülten atlama tabloları üretilir (-Os).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_dispatch_chains(AstNode* ast_root, SymbolTable* symbol_table, int optimize_for_size);
+
+/**
+ * @brief Koşullu seçime dönüştürme (if-conversion) geçişi.
+ * Sadece MOV içeren kısa üçgen (Jcc L; MOV...; L:) ve elmas (Jcc E; MOV...; JMP J; E: MOV...; J:)
+ * dallanmalarını bayrakları okuyan SELcc sözde komutlarına çevirir. Kod üretici SELcc'yi
+ * x86'da cmovcc, AArch64'te csel, seçim komutu olmayan hedeflerde maske dizisi olarak üretir.
+ * Dönüşüme hedefin maliyet modeli ve (varsa) profilden kestirilen yanlış tahmin oranı karar verir.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param arch Hedef mimari (maliyet modeli için).
+ * @param optimize_for_size 1 ise sadece kodu küçülten dönüşümler yapılır (-Os).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_if_conversion(AstNode* ast_root, TargetArchitecture arch, int optimize_for_size);
+
+/**
+ * @brief Döngü açma (loop unrolling) geçişi.
+ * Doğal döngülerden tek bloklu sayaç döngüleri ("S; CMP i, b; JLT/JGT başlık", sayaç gövdede
+ * tek bir ADD/SUB sabitle ilerler) seçilir. Tur sayısı derleme zamanında biliniyorsa döngü
+ * tamamen açılır; aksi halde gövde katsayı kadar kopyalanır ve kalan turlar için orijinal
+ * döngü korunur. Başlık etiketinden önceki "#unroll N" yönergesi seviye sınırlarını ve
+ * bütçeyi geçersiz kılar (N = 1 açmayı engeller).
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (yeni etiketler için).
+ * @param max_factor Kısmi açmanın en büyük katsayısı (1 = sadece yönergeler).
+ * @param max_unrolled_size Açılmış gövdenin en fazla komut sayısı (tam ve kısmi açma için).
+ * @param growth_budget Kalan büyüme bütçesi (komut sayısı); her açma kadar azaltılır.
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_loop_unrolling(AstNode* ast_root, SymbolTable* symbol_table, int max_factor, int max_unrolled_size,
+                            long* growth_budget);
+
+/**
+ * @brief Kuyruk birleştirme (tail merging / cross-jumping) geçişi.
+ * Aynı bloğa JMP ile veya düşerek geçen iki bloğun özdeş son komutları tek kopyada toplanır:
+ * kopyanın başına bir etiket eklenir, diğer blok kuyruğu yerine oraya atlar.
+ * Sadece kodu küçülten birleştirmeler yapılır (-Os).
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (yeni etiketler için).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_tail_merging(AstNode* ast_root, SymbolTable* symbol_table);
+
+/**
+ * @brief Kod dışlama (machine outlining) geçişi.
+ * Tekrarlanan, akışı değiştirmeyen komut dizileri (MOV, aritmetik, CMP, SELcc) komut
+ * akışının son ek dizisi ve LCP dizisiyle bulunur. Kazancı (geçiş sayısı x uzunluk) çağrı
+ * maliyetini (geçiş başına CALL, bir kopya ve RET) aşan diziler programın sonundaki ortak
+ * alt programlara taşınır ve her geçiş CALL ile değiştirilir. Bayrakları dizi sınırında canlı
+ * olan geçişler dışlanmaz. CALL tüm kaydedicileri bozduğu için geçiş hattının en sonunda çalışır.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (yeni etiketler için).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_outlining(AstNode* ast_root, SymbolTable* symbol_table);
+
+/**
+ * @brief Ölü değer eliminasyonu (IR üzerinde): hiç okunmayan bir değer üreten MOV, ADD, SUB,
+ * MUL ve SELcc komutlarını siler (örn: "ADD R1, 5; MOV R1, 3" -> "MOV R1, 3"). Program IR'ye
+ * indirgenir; bayrak sonucu okunan komutlar korunur.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (IR'den geri dönüşümde gerekirse etiket eklenir).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_dead_values(AstNode* ast_root, SymbolTable* symbol_table);
+
+/**
+ * @brief Komut zamanlama geçişi (IR üzerinde, kaydedici atamasından önce): her temel bloğun
+ * komutlarını hedefin ardışık düzen modeline göre kritik yol öncelikli liste zamanlamasıyla
+ * sıralar (bkz. sched.h); örn: çarpmanın sonucunu bekleyen komutun önüne bağımsız komutlar alınır.
+ * Sadece sıralı (in-order) çekirdek modelli hedeflerde ve tahmini süre kısalıyorsa uygulanır.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param symbol_table Sembol tablosu (IR'den geri dönüşümde gerekirse etiket eklenir).
+ * @param arch Hedef mimari (ardışık düzen modeli ve ADD/SUB'ın bayrak davranışı için).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_instruction_scheduling(AstNode* ast_root, SymbolTable* symbol_table, TargetArchitecture arch);
+
+/**
+ * @brief Gözetleme deliği (peephole) geçişi: süperoptimizasyon kural veritabanındaki kuralları uygular.
+ * Bir blok içindeki düz MOV/ADD/SUB/MUL pencereleri kanonik kalıba çevrilir; veritabanında
+ * daha kısa karşılığı olan pencereler, bayraklar pencerenin sonunda canlı değilse değiştirilir.
+ * @param ast_root Optimize edilecek AST'nin kök düğümü.
+ * @param rules Kural veritabanı (NULL ise geçiş hiçbir şey yapmaz).
+ * @return Değişiklik yapıldıysa 1, yapılmadıysa 0.
+ */
+int optimize_peephole(AstNode* ast_root, const SuperoptRules* rules);
+
+
+#endif // OPTIMIZER_H
@@ -1,91 +1,182 @@
-#ifndef TARGET_H
-#define TARGET_H
-
-#include <stdint.h> // uint32_t, uint64_t için
-
-// --- Hedef CPU Mimarileri ---
-typedef enum {
-    ARCH_AMD64,    // 64-bit x86_64 (amd64)
-    ARCH_AMD32,    // 32-bit IA-32 (amd64)
-    ARCH_ARMV9,    // 64-bit ARM mimarisi (armv9)
-    ARCH_ARMV8,    // 64-bit ARM mimarisi (armv8)
-    ARCH_ARMV7,    // 32-bit ARM mimarisi (armv7)
-    ARCH_RV64I,    // genel amaçlı 64 bit RISC-V mimarisi (rv64i)
-    ARCH_RV64E,    // gömülü sistem 64 bit RISC-V mimarisi (rv64e)
-    ARCH_RV32I,    // genel amaçlı 32 bit RISC-V mimarisi (rv32i)
-    ARCH_RV32E,    // gömülü sistem 32 bit RISC-V mimarisi (rv32e)
-    ARCH_POWERPC64,    // 64-bit PowerPC mimarisi (powerpc64)
-    ARCH_POWERPC32,    // 32-bit PowerPC mimarisi (powerpc64)
-    ARCH_MIPS64,    // 64-bit MIPS mimarisi (mips64)
-    ARCH_MIPS32,    // 32-bit MIPS mimarisi (mips32)
-    ARCH_MICRO_MIPS, // Micro MIPS mimarisi (micro_mips)
-    ARCH_OPENRISC64,    // 64-bit OpenRISC mimarisi (openrisc64)
-    ARCH_OPENRISC32,    // 32-bit OpenRISC mimarisi (openrisc32)
-    ARCH_LOONGARCH64,    // 64-bit LoongArch mimarisi (loongarch64)
-    ARCH_LOONGARCH32,    // 32-bit LoongArch mimarisi (loongarch32)
-    ARCH_SPARCV9,    // 64-bit SPARC mimarisi (sparcv9)
-    ARCH_SPARCV8,    // 32-bit SPARC mimarisi (sparcv8)
-    ARCH_SPARCV7,    // 32-bit SPARC mimarisi (sparcv7)
-    UNKNOWN_ARCH    // Bilinmeyen mimari
-} TargetArchitecture;
-
-// --- Hedef İşletim Sistemleri ---
-typedef enum {
-    OS_LINUX,       // Linux işletim sistemi
-    OS_WINDOWS,     // Windows işletim sistemi
-    OS_BAREMETAL,   // Çıplak Metal programlama
-    OS_ANDROID,     // Android işletim sistemi
-    OS_IOS,         // iOS işletim sistemi
-    OS_MACOS,       // MacOS işletim sistemi
-    OS_RISCOS,      // RISCOS işletim sistemi
-    OS_HAIKU,       // Haiku işletim sistemi
-    OS_KOLIBRIOS,   // KolibriOS işletim sistemi
-    OS_REACTOS,     // ReactOS işletim sistemi
-    OS_UNIX,        // Orijinal Unix işletim sistemi
-    UNKNOWN_OS      // Bilinmeyen işletim sistemi
-} TargetOperatingSystem;
-
-// --- Genel Hedef Yapılandırma Yapısı ---
-// Bu yapı, seçilen işletim sistemi için yüklenen spesifik yapılandırmayı işaret eder.
-typedef struct {
-    TargetArchitecture arch;
-    TargetOperatingSystem os;
-
-    // Hedef işletim sistemine ve mimariye özgü yapılandırma bilgileri için bir pointer.
-    // Bu, seçilen OS/mimari kombinasyonuna göre farklı bir struct'a işaret edecektir.
-    void* os_arch_config_data;
-
-} Target;
-
-// --- Fonksiyon Prototipleri ---
-
-/**
- * @brief Yeni bir Target örneği başlatır ve belirtilen OS/mimari için yapılandırmayı yükler.
- * @param arch Hedef CPU mimarisi.
- * @param os Hedef İşletim Sistemi.
- * @return Başlatılmış Target pointer'ı veya NULL hata durumunda.
- */
-Target* target_init(TargetArchitecture arch, TargetOperatingSystem os);
-
-/**
- * @brief Target yapısının kullandığı belleği serbest bırakır.
- * Aynı zamanda OS/mimariye özgü yapılandırma verilerini de serbest bırakır.
- * @param target Serbest bırakılacak Target pointer'ı.
- */
-void target_close(Target* target);
-
-/**
- * @brief Bir TargetArchitecture enum değerini string'e dönüştürür.
- * @param arch Dönüştürülecek mimari.
- * @return Mimarinin string karşılığı.
- */
-const char* target_arch_to_string(TargetArchitecture arch);
-
-/**
- * @brief Bir TargetOperatingSystem enum değerini string'e dönüştürür.
- * @param os Dönüştürülecek işletim sistemi.
- * @return İşletim sisteminin string karşılığı.
- */
-const char* target_os_to_string(TargetOperatingSystem os);
-
-#endif // TARGET_H
+#ifndef TARGET_H
+#define TARGET_H
+
+#include <stdint.h> // uint32_t, uint64_t, int64_t için
+
+// --- Hedef CPU Mimarileri ---
+typedef enum {
+    ARCH_AMD64,    // 64-bit x86_64 (amd64)
+    ARCH_AMD32,    // 32-bit IA-32 (amd64)
+    ARCH_ARMV9,    // 64-bit ARM mimarisi (armv9)
+    ARCH_ARMV8,    // 64-bit ARM mimarisi (armv8)
+    ARCH_ARMV7,    // 32-bit ARM mimarisi (armv7)
+    ARCH_RV64I,    // genel amaçlı 64 bit RISC-V mimarisi (rv64i)
+    ARCH_RV64E,    // gömülü sistem 64 bit RISC-V mimarisi (rv64e)
+    ARCH_RV32I,    // genel amaçlı 32 bit RISC-V mimarisi (rv32i)
+    ARCH_RV32E,    // gömülü sistem 32 bit RISC-V mimarisi (rv32e)
+    ARCH_POWERPC64,    // 64-bit PowerPC mimarisi (powerpc64)
+    ARCH_POWERPC32,    // 32-bit PowerPC mimarisi (powerpc64)
+    ARCH_MIPS64,    // 64-bit MIPS mimarisi (mips64)
+    ARCH_MIPS32,    // 32-bit MIPS mimarisi (mips32)
+    ARCH_MICRO_MIPS, // Micro MIPS mimarisi (micro_mips)
+    ARCH_OPENRISC64,    // 64-bit OpenRISC mimarisi (openrisc64)
+    ARCH_OPENRISC32,    // 32-bit OpenRISC mimarisi (openrisc32)
+    ARCH_LOONGARCH64,    // 64-bit LoongArch mimarisi (loongarch64)
+    ARCH_LOONGARCH32,    // 32-bit LoongArch mimarisi (loongarch32)
+    ARCH_SPARCV9,    // 64-bit SPARC mimarisi (sparcv9)
+    ARCH_SPARCV8,    // 32-bit SPARC mimarisi (sparcv8)
+    ARCH_SPARCV7,    // 32-bit SPARC mimarisi (sparcv7)
+    UNKNOWN_ARCH    // Bilinmeyen mimari
+} TargetArchitecture;
+
+// --- Hedef İşletim Sistemleri ---
+typedef enum {
+    OS_LINUX,       // Linux işletim sistemi
+    OS_WINDOWS,     // Windows işletim sistemi
+    OS_BAREMETAL,   // Çıplak Metal programlama
+    OS_ANDROID,     // Android işletim sistemi
+    OS_IOS,         // iOS işletim sistemi
+    OS_MACOS,       // MacOS işletim sistemi
+    OS_RISCOS,      // RISCOS işletim sistemi
+    OS_HAIKU,       // Haiku işletim sistemi
+    OS_KOLIBRIOS,   // KolibriOS işletim sistemi
+    OS_REACTOS,     // ReactOS işletim sistemi
+    OS_UNIX,        // Orijinal Unix işletim sistemi
+    UNKNOWN_OS      // Bilinmeyen işletim sistemi
+} TargetOperatingSystem;
+
+// --- Genel Hedef Yapılandırma Yapısı ---
+// Bu yapı, seçilen işletim sistemi için yüklenen spesifik yapılandırmayı işaret eder.
+typedef struct {
+    TargetArchitecture arch;
+    TargetOperatingSystem os;
+
+    // Hedef işletim sistemine ve mimariye özgü yapılandırma bilgileri için bir pointer.
+    // Bu, seçilen OS/mimari kombinasyonuna göre farklı bir struct'a işaret edecektir.
+    void* os_arch_config_data;
+
+} Target;
+
+// --- Komut Ardışık Düzen Modeli (Pipeline Model) ---
+// Komut zamanlayıcısının (bkz. sched.h) kullandığı gecikme ve işlev birimi tabloları. Komutlar
+// birkaç sınıfa ayrılır; her sınıfın sonucunun bağımlı komuta ulaşma süresi, çalıştığı birim ve
+// birimi meşgul ettiği süre (ardışık düzenlenmemiş bölücülerde gecikmeye eşit) vardır.
+typedef enum {
+    TARGET_OP_ALU,          // Toplama, çıkarma, karşılaştırma, taşıma, kaydırma, sabit yükleme
+    TARGET_OP_MUL,
+    TARGET_OP_DIV,
+    TARGET_OP_LOAD,
+    TARGET_OP_STORE,
+    TARGET_OP_BRANCH,       // Dallar, çağrılar, sistem çağrıları
+    TARGET_OP_CLASS_COUNT
+} TargetOpClass;
+
+typedef enum {
+    TARGET_UNIT_ALU,
+    TARGET_UNIT_MUL,        // Çarpma ve bölme
+    TARGET_UNIT_MEM,
+    TARGET_UNIT_BRANCH,
+    TARGET_UNIT_COUNT
+} TargetUnit;
+
+typedef struct {
+    uint8_t latency;        // Sonucun bağımlı komutta kullanılabilmesi için geçen çevrim
+    uint8_t unit;           // TargetUnit
+    uint8_t occupancy;      // Birimin yeni komut kabul edemediği çevrim (ardışık düzenliyse 1)
+} TargetOpTiming;
+
+typedef struct {
+    int issue_width;                        // Çevrim başına başlatılabilen en fazla komut
+    int in_order;                           // Komutlar program sırasıyla başlatılıyorsa 1
+    int num_units[TARGET_UNIT_COUNT];       // Birim türü başına kopya sayısı
+    TargetOpTiming ops[TARGET_OP_CLASS_COUNT];
+} TargetPipelineModel;
+
+// --- Hedef Maliyet Modeli ---
+// Optimizer'ın hedefe bağlı kararları (örn: dallanmasız koşullu seçim) için kaba çevrim
+// maliyetleri. Değerler tipik çekirdekler içindir; amaç kesin süre değil doğru sıralamadır.
+typedef struct {
+    int branch_cost;            // Doğru tahmin edilen koşullu dallanmanın maliyeti (çevrim)
+    int mispredict_penalty;     // Yanlış tahmin edilen dallanmanın ek maliyeti (çevrim)
+    int select_cost;            // Tek bir koşullu seçimin maliyeti (cmov/csel veya maske dizisi)
+    int select_immediate_cost;  // Seçilen değer sabitse ek maliyet (sabitin kaydediciye yüklenmesi)
+    int has_select;             // Donanımda koşullu seçim komutu var mı (cmov, csel, isel, ...)?
+    const TargetPipelineModel* pipeline; // Komut zamanlaması için ardışık düzen modeli
+} TargetCostModel;
+
+// --- Fonksiyon Prototipleri ---
+
+// target_init ve target_close sadece OS/mimari yapılandırma başlıklarıyla (-DBSM_TARGET_CONFIGS)
+// derlenen yapılarda vardır; diğer fonksiyonlar her zaman kullanılabilir (target_model.c).
+
+/**
+ * @brief Yeni bir Target örneği başlatır ve belirtilen OS/mimari için yapılandırmayı yükler.
+ * @param arch Hedef CPU mimarisi.
+ * @param os Hedef İşletim Sistemi.
+ * @return Başlatılmış Target pointer'ı veya NULL hata durumunda.
+ */
+Target* target_init(TargetArchitecture arch, TargetOperatingSystem os);
+
+/**
+ * @brief Target yapısının kullandığı belleği serbest bırakır.
+ * Aynı zamanda OS/mimariye özgü yapılandırma verilerini de serbest bırakır.
+ * @param target Serbest bırakılacak Target pointer'ı.
+ */
+void target_close(Target* target);
+
+/**
+ * @brief Bir TargetArchitecture enum değerini string'e dönüştürür.
+ * @param arch Dönüştürülecek mimari.
+ * @return Mimarinin string karşılığı.
+ */
+const char* target_arch_to_string(TargetArchitecture arch);
+
+/**
+ * @brief Bir TargetOperatingSystem enum değerini string'e dönüştürür.
+ * @param os Dönüştürülecek işletim sistemi.
+ * @return İşletim sisteminin string karşılığı.
+ */
+const char* target_os_to_string(TargetOperatingSystem os);
+
+/**
+ * @brief Bir mimari adını (örn: "amd64", "aarch64") TargetArchitecture değerine dönüştürür.
+ * Büyük/küçük harf duyarsızdır; yaygın takma adlar da kabul edilir.
+ * @param name Mimari adı.
+ * @return Mimari veya tanınmazsa UNKNOWN_ARCH.
+ */
+TargetArchitecture target_arch_from_string(const char* name);
+
+/**
+ * @brief Bir işletim sistemi adını (örn: "linux") TargetOperatingSystem değerine dönüştürür.
+ * @param name İşletim sistemi adı (büyük/küçük harf duyarsız).
+ * @return İşletim sistemi veya tanınmazsa UNKNOWN_OS.
+ */
+TargetOperatingSystem target_os_from_string(const char* name);
+
+/**
+ * @brief Mimarinin aritmetik komutlarının (ADD/SUB) karşılaştırma bayraklarını ayarlayıp ayarlamadığını bildirir.
+ * Optimizer, bayrak ayarlayan mimarilerde "CMP Rx, 0" yerine önceki aritmetik sonucun bayraklarını kullanabilir.
+ * @param arch Sorgulanacak mimari.
+ * @return Aritmetik bayrakları ayarlıyorsa 1, aksi takdirde 0.
+ */
+int target_arch_arith_sets_flags(TargetArchitecture arch);
+
+/**
+ * @brief Bessambly sistem çağrısı numarasını (Linux x86-64 numaraları; BVM ile aynı) hedef
+ * mimarinin Linux numarasına çevirir. AArch64, RISC-V ve LoongArch ortak (asm-generic) tabloyu
+ * kullanır; tabloda sadece yaygın çağrılar vardır.
+ * @param arch Hedef mimari.
+ * @param number Bessambly'deki numara.
+ * @return Hedefteki numara veya karşılığı yoksa -1.
+ */
+int64_t target_linux_syscall_number(TargetArchitecture arch, int64_t number);
+
+/**
+ * @brief Mimarinin optimizer maliyet modelini döndürür.
+ * Bilinmeyen mimari için modern sıra dışı (out-of-order) çekirdekleri varsayan genel bir model döner.
+ * @param arch Sorgulanacak mimari.
+ * @return Maliyet modeli (statik; serbest bırakılmamalı).
+ */
+const TargetCostModel* target_cost_model(TargetArchitecture arch);
+
+#endif // TARGET_H
@@ -0,0 +1,245 @@
+#include "target.h"
+#include <stddef.h> // size_t
+#include <ctype.h>  // toupper
+
+// Hedef modeli: optimizer ve kod üreticilerin sorguladığı mimari özellikleri (bayrak modeli,
+// maliyet ve ardışık düzen tabloları), ad çözümleme ve Linux sistem çağrısı numaraları.
+// OS/mimari yapılandırmalarına (target.c) bağlı değildir.
+
+int target_arch_arith_sets_flags(TargetArchitecture arch) {
+    switch (arch) {
+        // Bu mimarilerde ADD/SUB (veya ARM'da ADDS/SUBS) durum bayraklarını sonuca göre ayarlar
+        case ARCH_AMD64:
+        case ARCH_AMD32:
+        case ARCH_ARMV9:
+        case ARCH_ARMV8:
+        case ARCH_ARMV7:
+        case ARCH_POWERPC64: // add. / subf. (CR0)
+        case ARCH_POWERPC32:
+        case ARCH_SPARCV9:   // addcc / subcc
+        case ARCH_SPARCV8:
+        case ARCH_SPARCV7:
+            return 1;
+        // RISC-V, MIPS, LoongArch ve OpenRISC'te bayrak yazmacı yoktur; karşılaştırma
+        // her dalda yeniden yapılır. Bilinmeyen mimaride de güvenli tarafta kalınır.
+        default:
+            return 0;
+    }
+}
+
+// Ardışık düzen modelleri: {başlatma genişliği, sıralı mı, {ALU, MUL, MEM, BRANCH birim sayısı},
+// {{gecikme, birim, meşguliyet} x ALU, MUL, DIV, LOAD, STORE, BRANCH}}. Değerler hedefin tipik
+// (çoğunlukla küçük, sıralı) çekirdeklerine göredir; sıralı çekirdeklerde zamanlama en çok kazandırır.
+#define TARGET_ALU(lat) {lat, TARGET_UNIT_ALU, 1}
+#define TARGET_MUL(lat, occ) {lat, TARGET_UNIT_MUL, occ}
+#define TARGET_MEM(lat, occ) {lat, TARGET_UNIT_MEM, occ}
+#define TARGET_BRANCH {1, TARGET_UNIT_BRANCH, 1}
+static const TargetPipelineModel pipeline_x86 = {           // Sıra dışı, 4 başlatma
+    4, 0, {4, 1, 2, 2},
+    {TARGET_ALU(1), TARGET_MUL(3, 1), TARGET_MUL(26, 6), TARGET_MEM(5, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_aarch64 = {       // Cortex-A55 benzeri: sıralı, çift başlatma
+    2, 1, {2, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(4, 1), TARGET_MUL(12, 12), TARGET_MEM(3, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_armv7 = {         // Cortex-A7 benzeri: sıralı, kısıtlı çift başlatma
+    2, 1, {2, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(4, 1), TARGET_MUL(10, 10), TARGET_MEM(3, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_powerpc = {       // e500 benzeri: sıralı, çift başlatma
+    2, 1, {2, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(4, 1), TARGET_MUL(20, 20), TARGET_MEM(3, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_mips = {          // MIPS32 24K benzeri: tek başlatma, yükleme gecikme aralığı
+    1, 1, {1, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(5, 1), TARGET_MUL(35, 35), TARGET_MEM(2, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_sparcv9 = {       // Sıralı, çift başlatma
+    2, 1, {2, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(5, 1), TARGET_MUL(40, 40), TARGET_MEM(3, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_sparcv8 = {       // LEON3 benzeri: tek başlatma, saklama 2 çevrim
+    1, 1, {1, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(5, 1), TARGET_MUL(36, 36), TARGET_MEM(2, 1), TARGET_MEM(1, 2), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_openrisc = {      // mor1kx benzeri: tek başlatma
+    1, 1, {1, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(3, 1), TARGET_MUL(32, 32), TARGET_MEM(2, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_loongarch = {     // LA464 benzeri: sıra dışı, 4 başlatma
+    4, 0, {4, 2, 2, 1},
+    {TARGET_ALU(1), TARGET_MUL(4, 1), TARGET_MUL(13, 13), TARGET_MEM(4, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_riscv = {         // U74 benzeri: sıralı, çift başlatma
+    2, 1, {2, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(3, 1), TARGET_MUL(20, 20), TARGET_MEM(3, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+static const TargetPipelineModel pipeline_riscv_embedded = { // E31 benzeri: tek başlatma, yinelemeli bölücü
+    1, 1, {1, 1, 1, 1},
+    {TARGET_ALU(1), TARGET_MUL(3, 1), TARGET_MUL(33, 33), TARGET_MEM(2, 1), TARGET_MEM(1, 1), TARGET_BRANCH}};
+#undef TARGET_ALU
+#undef TARGET_MUL
+#undef TARGET_MEM
+#undef TARGET_BRANCH
+
+// Maliyet modelleri: {dallanma, yanlış tahmin cezası, seçim, sabit seçim eki, seçim komutu var mı, ardışık düzen}
+static const TargetCostModel cost_model_x86 = {1, 16, 1, 1, 1, &pipeline_x86};             // cmovcc (kaynak kaydedici olmalı)
+static const TargetCostModel cost_model_aarch64 = {1, 12, 1, 1, 1, &pipeline_aarch64};     // csel
+static const TargetCostModel cost_model_armv7 = {1, 10, 1, 0, 1, &pipeline_armv7};         // Koşullu MOV sabit alabilir
+static const TargetCostModel cost_model_powerpc = {1, 12, 1, 1, 1, &pipeline_powerpc};     // isel
+static const TargetCostModel cost_model_mips = {1, 8, 1, 1, 1, &pipeline_mips};            // movn/movz (R6: seleqz/selnez)
+static const TargetCostModel cost_model_sparcv9 = {1, 8, 1, 0, 1, &pipeline_sparcv9};      // movcc (13-bit sabit alabilir)
+static const TargetCostModel cost_model_openrisc = {1, 6, 1, 1, 1, &pipeline_openrisc};    // l.cmov
+static const TargetCostModel cost_model_loongarch = {1, 10, 3, 1, 0, &pipeline_loongarch}; // maskeqz/masknez + or
+static const TargetCostModel cost_model_riscv = {1, 6, 4, 1, 0, &pipeline_riscv};          // Temel ISA: neg/xor/and/xor maske dizisi
+static const TargetCostModel cost_model_riscv_embedded = {1, 6, 4, 1, 0, &pipeline_riscv_embedded}; // RV64E/RV32E
+static const TargetCostModel cost_model_no_select = {1, 6, 4, 1, 0, &pipeline_sparcv8};    // SPARC V7/V8: maske dizisi
+static const TargetCostModel cost_model_generic = {1, 14, 1, 1, 1, &pipeline_x86};
+
+const TargetCostModel* target_cost_model(TargetArchitecture arch) {
+    switch (arch) {
+        case ARCH_AMD64:
+        case ARCH_AMD32:
+            return &cost_model_x86;
+        case ARCH_ARMV9:
+        case ARCH_ARMV8:
+            return &cost_model_aarch64;
+        case ARCH_ARMV7:
+            return &cost_model_armv7;
+        case ARCH_POWERPC64:
+        case ARCH_POWERPC32:
+            return &cost_model_powerpc;
+        case ARCH_MIPS64:
+        case ARCH_MIPS32:
+        case ARCH_MICRO_MIPS:
+            return &cost_model_mips;
+        case ARCH_SPARCV9:
+            return &cost_model_sparcv9;
+        case ARCH_SPARCV8:
+        case ARCH_SPARCV7:
+            return &cost_model_no_select;
+        case ARCH_OPENRISC64:
+        case ARCH_OPENRISC32:
+            return &cost_model_openrisc;
+        case ARCH_LOONGARCH64:
+        case ARCH_LOONGARCH32:
+            return &cost_model_loongarch;
+        case ARCH_RV64I:
+        case ARCH_RV32I:
+            return &cost_model_riscv;
+        case ARCH_RV64E:
+        case ARCH_RV32E:
+            return &cost_model_riscv_embedded;
+        default:
+            return &cost_model_generic;
+    }
+}
+
+/**
+ * @brief İki string'i büyük/küçük harf ayrımı yapmadan karşılaştırır.
+ * @return Eşitse 1, değilse 0.
+ */
+static int equals_ignore_case(const char* a, const char* b) {
+    while (*a && *b) {
+        if (toupper((unsigned char)*a) != toupper((unsigned char)*b)) return 0;
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+TargetArchitecture target_arch_from_string(const char* name) {
+    if (!name) return UNKNOWN_ARCH;
+    for (int arch = ARCH_AMD64; arch < UNKNOWN_ARCH; arch++) {
+        if (equals_ignore_case(name, target_arch_to_string((TargetArchitecture)arch))) {
+            return (TargetArchitecture)arch;
+        }
+    }
+    // Yaygın takma adlar
+    if (equals_ignore_case(name, "x86_64") || equals_ignore_case(name, "x86-64")) return ARCH_AMD64;
+    if (equals_ignore_case(name, "i386") || equals_ignore_case(name, "x86")) return ARCH_AMD32;
+    if (equals_ignore_case(name, "aarch64") || equals_ignore_case(name, "arm64")) return ARCH_ARMV8;
+    if (equals_ignore_case(name, "riscv64")) return ARCH_RV64I;
+    if (equals_ignore_case(name, "riscv32")) return ARCH_RV32I;
+    return UNKNOWN_ARCH;
+}
+
+TargetOperatingSystem target_os_from_string(const char* name) {
+    if (!name) return UNKNOWN_OS;
+    for (int os = OS_LINUX; os < UNKNOWN_OS; os++) {
+        if (equals_ignore_case(name, target_os_to_string((TargetOperatingSystem)os))) {
+            return (TargetOperatingSystem)os;
+        }
+    }
+    return UNKNOWN_OS;
+}
+
+// Bessambly (Linux x86-64) -> asm-generic sistem çağrısı numaraları: {x86-64, asm-generic}
+static const int64_t linux_generic_syscalls[][2] = {
+    {0, 63},    // read
+    {1, 64},    // write
+    {3, 57},    // close
+    {5, 80},    // fstat
+    {8, 62},    // lseek
+    {9, 222},   // mmap
+    {10, 226},  // mprotect
+    {11, 215},  // munmap
+    {12, 214},  // brk
+    {13, 134},  // rt_sigaction
+    {14, 135},  // rt_sigprocmask
+    {16, 29},   // ioctl
+    {17, 67},   // pread64
+    {18, 68},   // pwrite64
+    {19, 65},   // readv
+    {20, 66},   // writev
+    {24, 124},  // sched_yield
+    {28, 233},  // madvise
+    {32, 23},   // dup
+    {35, 101},  // nanosleep
+    {39, 172},  // getpid
+    {41, 198},  // socket
+    {42, 203},  // connect
+    {43, 202},  // accept
+    {44, 206},  // sendto
+    {45, 207},  // recvfrom
+    {56, 220},  // clone
+    {59, 221},  // execve
+    {60, 93},   // exit
+    {61, 260},  // wait4
+    {62, 129},  // kill
+    {63, 160},  // uname
+    {72, 25},   // fcntl
+    {74, 82},   // fsync
+    {77, 46},   // ftruncate
+    {79, 17},   // getcwd
+    {80, 49},   // chdir
+    {96, 169},  // gettimeofday
+    {102, 174}, // getuid
+    {104, 176}, // getgid
+    {107, 175}, // geteuid
+    {108, 177}, // getegid
+    {110, 173}, // getppid
+    {186, 178}, // gettid
+    {202, 98},  // futex
+    {218, 96},  // set_tid_address
+    {228, 113}, // clock_gettime
+    {230, 115}, // clock_nanosleep
+    {231, 94},  // exit_group
+    {234, 131}, // tgkill
+    {257, 56},  // openat
+    {258, 34},  // mkdirat
+    {263, 35},  // unlinkat
+    {264, 38},  // renameat
+    {292, 24},  // dup3
+    {293, 59},  // pipe2
+    {302, 261}, // prlimit64
+    {318, 278}, // getrandom
+};
+
+int64_t target_linux_syscall_number(TargetArchitecture arch, int64_t number) {
+    switch (arch) {
+        case ARCH_AMD64:
+            return number;
+        case ARCH_ARMV9:
+        case ARCH_ARMV8:
+        case ARCH_RV64I:
+        case ARCH_RV64E:
+        case ARCH_LOONGARCH64:
+            for (size_t i = 0; i < sizeof(linux_generic_syscalls) / sizeof(linux_generic_syscalls[0]); i++) {
+                if (linux_generic_syscalls[i][0] == number) return linux_generic_syscalls[i][1];
+            }
+            return -1;
+        default:
+            return -1;
+    }
+}
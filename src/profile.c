@@ -0,0 +1,327 @@
+#include "profile.h"
+#include "cfg.h"
+#include <stdlib.h> // malloc, free, calloc
+#include <stdio.h>  // FILE, fopen, fread, fprintf
+#include <string.h> // memcpy
+
+// --- Dosya Okuma/Yazma ---
+
+ProfileData* profile_load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Hata: '%s' profil dosyası açılamadı.\n", path);
+        return NULL;
+    }
+
+    BsmProfileHeader header;
+    if (!bsm_profile_read_header(file, &header)) {
+        fprintf(stderr, "Hata: '%s' profil dosyası başlığı okunamadı.\n", path);
+        fclose(file);
+        return NULL;
+    }
+    if (!bsm_profile_header_valid(&header)) {
+        fprintf(stderr, "Hata: '%s' geçerli bir .bsmprof dosyası değil (sürüm %u).\n", path, header.version);
+        fclose(file);
+        return NULL;
+    }
+
+    ProfileData* data = (ProfileData*)malloc(sizeof(ProfileData));
+    if (!data) {
+        fprintf(stderr, "Hata: Profil verisi için bellek tahsis edilemedi.\n");
+        fclose(file);
+        return NULL;
+    }
+    data->cfg_checksum = header.cfg_checksum;
+    data->num_counters = (size_t)header.num_counters;
+    data->counters = (uint64_t*)calloc(data->num_counters ? data->num_counters : 1, sizeof(uint64_t));
+    if (!data->counters) {
+        fprintf(stderr, "Hata: Profil sayaçları için bellek tahsis edilemedi.\n");
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    if (fread(data->counters, sizeof(uint64_t), data->num_counters, file) != data->num_counters) {
+        fprintf(stderr, "Hata: '%s' profil dosyası eksik (beklenen %zu sayaç).\n", path, data->num_counters);
+        profile_free(data);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+int profile_save(const char* path, const ProfileData* data) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Hata: '%s' profil dosyası yazmak için açılamadı.\n", path);
+        return 0;
+    }
+    int ok = bsm_profile_write(file, data->cfg_checksum, data->num_counters, data->counters);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Hata: '%s' profil dosyasına yazılamadı.\n", path);
+    }
+    return ok;
+}
+
+int profile_sink_dump(ProfileSink* sink, const uint64_t* counters, size_t num_counters) {
+    if (sink->dumped) return !sink->failed;
+    sink->dumped = 1;
+    ProfileData data;
+    data.cfg_checksum = sink->cfg_checksum;
+    data.num_counters = sink->num_counters;
+    data.counters = (uint64_t*)calloc(data.num_counters ? data.num_counters : 1, sizeof(uint64_t));
+    if (!data.counters) {
+        fprintf(stderr, "Hata: Profil sayaçları için bellek tahsis edilemedi.\n");
+        sink->failed = 1;
+        return 0;
+    }
+    size_t count = num_counters < data.num_counters ? num_counters : data.num_counters;
+    if (count > 0) memcpy(data.counters, counters, sizeof(uint64_t) * count);
+    bsm_profile_merge_file(sink->path, data.cfg_checksum, data.num_counters, data.counters);
+    sink->failed = !profile_save(sink->path, &data);
+    free(data.counters);
+    return !sink->failed;
+}
+
+void profile_free(ProfileData* data) {
+    if (data) {
+        free(data->counters);
+        free(data);
+    }
+}
+
+// --- Enstrümantasyon ---
+
+// Orijinal ifade dizisinde belirli bir indeksin önüne eklenecek düğüm
+typedef struct {
+    size_t index;
+    size_t sequence;    // Aynı indeksteki eklemelerin sırasını korumak için
+    AstNode* node;
+} PendingInsertion;
+
+typedef struct {
+    PendingInsertion* items;
+    size_t count;
+    size_t capacity;
+} InsertionList;
+
+static int insertion_list_push(InsertionList* list, size_t index, AstNode* node) {
+    if (!node) return 0;
+    if (list->count >= list->capacity) {
+        size_t new_capacity = list->capacity ? list->capacity * 2 : 32;
+        PendingInsertion* items = (PendingInsertion*)realloc(list->items, sizeof(PendingInsertion) * new_capacity);
+        if (!items) {
+            ast_node_free(node);
+            return 0;
+        }
+        list->items = items;
+        list->capacity = new_capacity;
+    }
+    list->items[list->count].index = index;
+    list->items[list->count].sequence = list->count;
+    list->items[list->count].node = node;
+    list->count++;
+    return 1;
+}
+
+static int compare_insertions(const void* a, const void* b) {
+    const PendingInsertion* x = (const PendingInsertion*)a;
+    const PendingInsertion* y = (const PendingInsertion*)b;
+    if (x->index != y->index) return x->index < y->index ? -1 : 1;
+    return x->sequence < y->sequence ? -1 : (x->sequence > y->sequence);
+}
+
+/**
+ * @brief "PROFCNT <sayaç>" komutunu oluşturur.
+ */
+static AstNode* create_profcnt(size_t counter, int line, int column) {
+    AstNode* node = ast_instruction_create(TOKEN_PROFCNT, 1, line, column);
+    if (node) {
+        node->data.instruction.operands[0].type = OP_INTEGER;
+        node->data.instruction.operands[0].value.int_value = (int64_t)counter;
+    }
+    return node;
+}
+
+/**
+ * @brief Tek etiket operandlı bir JMP komutu oluşturur.
+ */
+static AstNode* create_jump(const char* label, int line, int column) {
+    AstNode* node = ast_instruction_create(TOKEN_JMP, 1, line, column);
+    if (node && !ast_operand_set_label(&node->data.instruction.operands[0], label)) {
+        ast_node_free(node);
+        return NULL;
+    }
+    return node;
+}
+
+/**
+ * @brief Etiket oluşturur ve sembol tablosuna ekler.
+ */
+static AstNode* create_label(SymbolTable* symbol_table, const char* name) {
+    if (!symbol_table_add_symbol(symbol_table, name, 0, 0, 0)) return NULL;
+    return ast_label_declaration_create(name, 0, 0);
+}
+
+static int is_exit_syscall(const AstNode* statement, int64_t exit_syscall) {
+    if (statement->type != AST_INSTRUCTION) return 0;
+    const AstInstruction* instr = &statement->data.instruction;
+    return instr->opcode == TOKEN_SYSCALL && instr->num_operands >= 1 &&
+           (instr->operands[0].type == OP_INTEGER || instr->operands[0].type == OP_HEX_INTEGER) &&
+           instr->operands[0].value.int_value == exit_syscall;
+}
+
+int profile_instrument_program(AstNode* program, SymbolTable* symbol_table, int64_t exit_syscall,
+                               ProfileInstrumentation* result) {
+    if (!program || program->type != AST_PROGRAM || !symbol_table || !result) {
+        fprintf(stderr, "Hata: Enstrümantasyon için geçersiz giriş.\n");
+        return 0;
+    }
+
+    Cfg* cfg = cfg_build(program);
+    if (!cfg) return 0;
+
+    result->cfg_checksum = cfg_checksum(cfg);
+    result->num_counters = cfg->num_edges + 1;
+
+    AstNode** statements = program->data.program.statements;
+    size_t num_statements = program->data.program.num_statements;
+    InsertionList inserts = {NULL, 0, 0};
+    InsertionList tail = {NULL, 0, 0}; // Program sonuna eklenecek trambolin blokları
+    char label_buffer[64];
+    int ok = 1;
+
+    // Sayaç 0: programa giriş (başlangıçtaki etiketlerden de önce; geri atlamalar saymaz)
+    ok = insertion_list_push(&inserts, 0, create_profcnt(0, 0, 0));
+
+    for (size_t e = 0; ok && e < cfg->num_edges; e++) {
+        CfgEdge* edge = &cfg->edges[e];
+        BasicBlock* from = &cfg->blocks[edge->from];
+        AstNode* last = cfg_block_last_instruction(cfg, edge->from);
+        size_t counter = e + 1;
+
+        if (edge->kind == CFG_EDGE_FALLTHROUGH) {
+            // Bloğun sonu ile bir sonraki bloğun etiketleri arası sadece bu kenarın yoludur
+            ok = insertion_list_push(&inserts, from->end, create_profcnt(counter, 0, 0));
+        } else if (last->data.instruction.opcode == TOKEN_JMP) {
+            // Koşulsuz atlama: sayaç atlamadan hemen önce
+            size_t jmp_index = from->end;
+            while (statements[jmp_index - 1] != last) jmp_index--;
+            ok = insertion_list_push(&inserts, jmp_index - 1, create_profcnt(counter, last->line, last->column));
+        } else {
+            // Koşullu atlamanın alınan kenarı: atlama trambolin etiketine yönlendirilir
+            AstInstruction* instr = &last->data.instruction;
+            cfg_make_unique_label(symbol_table, "__bsm_prof_e", label_buffer, sizeof(label_buffer));
+            ok = insertion_list_push(&tail, 0, create_label(symbol_table, label_buffer)) &&
+                 insertion_list_push(&tail, 0, create_profcnt(counter, last->line, last->column)) &&
+                 insertion_list_push(&tail, 0, create_jump(instr->operands[0].value.label_name,
+                                                          last->line, last->column)) &&
+                 ast_operand_set_label(&instr->operands[0], label_buffer);
+        }
+    }
+
+    // Çıkış sistem çağrılarından önce sayaçları diske yaz (atexit bu yolda çalışmaz)
+    for (size_t i = 0; ok && i < num_statements; i++) {
+        if (is_exit_syscall(statements[i], exit_syscall)) {
+            ok = insertion_list_push(&inserts, i, ast_instruction_create(TOKEN_PROFDUMP, 0,
+                                                                         statements[i]->line,
+                                                                         statements[i]->column));
+        }
+    }
+
+    // Trambolinler program sonuna eklenir; son blok programın sonuna düşüyorsa
+    // bu davranışı korumak için trambolinlerin üzerinden bir son etiketine atlanır.
+    AstNode* end_label = NULL;
+    AstNode* end_jump = NULL;
+    if (ok && tail.count > 0 && cfg->num_blocks > 0) {
+        AstNode* last = cfg_block_last_instruction(cfg, (int)cfg->num_blocks - 1);
+        if (!last || cfg_has_fallthrough(last->data.instruction.opcode)) {
+            cfg_make_unique_label(symbol_table, "__bsm_prof_end", label_buffer, sizeof(label_buffer));
+            end_label = create_label(symbol_table, label_buffer);
+            end_jump = create_jump(label_buffer, 0, 0);
+            ok = end_label && end_jump;
+        }
+    }
+
+    AstNode** new_statements = NULL;
+    size_t new_count = 0;
+    if (ok) {
+        new_statements = (AstNode**)malloc(sizeof(AstNode*) * (num_statements + inserts.count + tail.count + 2));
+        ok = new_statements != NULL;
+    }
+
+    if (ok) {
+        qsort(inserts.items, inserts.count, sizeof(PendingInsertion), compare_insertions);
+        size_t next_insert = 0;
+        for (size_t i = 0; i <= num_statements; i++) {
+            while (next_insert < inserts.count && inserts.items[next_insert].index == i) {
+                new_statements[new_count++] = inserts.items[next_insert++].node;
+            }
+            if (i < num_statements) new_statements[new_count++] = statements[i];
+        }
+        if (end_jump) new_statements[new_count++] = end_jump;
+        for (size_t t = 0; t < tail.count; t++) new_statements[new_count++] = tail.items[t].node;
+        if (end_label) new_statements[new_count++] = end_label;
+
+        free(program->data.program.statements);
+        program->data.program.statements = new_statements;
+        program->data.program.num_statements = new_count;
+        fprintf(stdout, "PGO: %zu kenar sayacı eklendi (CFG özeti: %016llx).\n",
+                result->num_counters, (unsigned long long)result->cfg_checksum);
+    } else {
+        fprintf(stderr, "Hata: Profil enstrümantasyonu başarısız oldu.\n");
+        for (size_t i = 0; i < inserts.count; i++) ast_node_free(inserts.items[i].node);
+        for (size_t i = 0; i < tail.count; i++) ast_node_free(tail.items[i].node);
+        ast_node_free(end_label);
+        ast_node_free(end_jump);
+    }
+
+    free(inserts.items);
+    free(tail.items);
+    cfg_free(cfg);
+    return ok;
+}
+
+// --- Profil Uygulama ---
+
+int profile_annotate_program(AstNode* program, const ProfileData* data) {
+    if (!program || program->type != AST_PROGRAM || !data) return 0;
+
+    Cfg* cfg = cfg_build(program);
+    if (!cfg) return 0;
+
+    if (cfg_checksum(cfg) != data->cfg_checksum || data->num_counters != cfg->num_edges + 1) {
+        fprintf(stderr, "Uyarı: Profil verisi bu kaynak kodla eşleşmiyor (eski .bsmprof?); yok sayılıyor.\n");
+        cfg_free(cfg);
+        return 0;
+    }
+
+    AstNode** statements = program->data.program.statements;
+    for (size_t b = 0; b < cfg->num_blocks; b++) {
+        BasicBlock* bb = &cfg->blocks[b];
+
+        // Blok sayımı = gelen kenar sayımlarının toplamı (+ giriş bloğu için giriş sayacı)
+        uint64_t count = (b == 0) ? data->counters[0] : 0;
+        for (size_t p = 0; p < bb->num_preds; p++) {
+            count += data->counters[bb->pred_edges[p] + 1];
+        }
+
+        int taken_edge = cfg_find_succ_edge(cfg, (int)b, CFG_EDGE_TAKEN);
+        for (size_t i = bb->first; i < bb->end; i++) {
+            if (statements[i]->type != AST_INSTRUCTION) continue;
+            AstInstruction* instr = &statements[i]->data.instruction;
+            instr->has_profile = 1;
+            instr->profile_count = count;
+            instr->profile_taken_count = 0;
+            if (cfg_is_conditional_branch(instr->opcode) && taken_edge >= 0) {
+                instr->profile_taken_count = data->counters[taken_edge + 1];
+            }
+        }
+    }
+
+    fprintf(stdout, "PGO: Profil uygulandı (%zu sayaç, giriş sayısı %llu).\n",
+            data->num_counters, (unsigned long long)data->counters[0]);
+    cfg_free(cfg);
+    return 1;
+}
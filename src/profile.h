@@ -0,0 +1,109 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "ast.h" // AST düğüm yapılarına erişim
+#include "semantic_analyzer.h" // Sembol tablosu (yeni etiketler için)
+#include "profile_format.h" // .bsmprof biçimi (BSM_PROFILE_*)
+#include <stdint.h> // uint64_t için
+#include <stddef.h> // size_t için
+
+// --- Profil Güdümlü Optimizasyon (PGO) ---
+// İki aşamalı iş akışı:
+//  1. Enstrümantasyon: Her CFG kenarına bir PROFCNT sözde komutu yerleştirilir.
+//     Kod üretici PROFCNT'yi süreç başına tek sayaç dizisinde (__bsm_state.counters)
+//     atomik olmayan bir artırmaya dönüştürür; sayaçlar program çıkışında
+//     veya çıkış SYSCALL'ından hemen önce (PROFDUMP) .bsmprof dosyasına yazılır.
+//  2. Kullanım: Yeniden derlemede .bsmprof okunur, kenar sayımları komutlara
+//     (AstInstruction.profile_*) işlenir ve blok yerleşimi, satır içi açma,
+//     sıcak/soğuk kararları ve döngü açma bu sayımları kullanır.
+//
+// Sayaç 0 programa giriş sayısıdır; sayaç (e + 1), enstrümantasyon öncesi CFG'deki
+// e indeksli kenara aittir. CFG özeti, profilin aynı kaynaktan üretildiğini doğrular.
+
+// .bsmprof dosya biçimi profile_format.h'dedir (çalışma zamanı kütüphanesiyle ortak).
+
+// Linux amd64 'exit' sistem çağrısı numarası; PROFDUMP bu çağrıdan önce eklenir.
+#define BSM_PROFILE_DEFAULT_EXIT_SYSCALL 60
+
+// --- Profil Verisi ---
+typedef struct {
+    uint64_t cfg_checksum;  // Profilin üretildiği CFG'nin özeti
+    size_t num_counters;    // Sayaç sayısı (kenar sayısı + 1)
+    uint64_t* counters;     // Sayaç değerleri
+} ProfileData;
+
+// --- Enstrümantasyon Sonucu ---
+// Kod üretici bu bilgileri çalışma zamanına (__bsm_prof_init) aktarır.
+typedef struct {
+    uint64_t cfg_checksum;  // Enstrümante edilen CFG'nin özeti
+    size_t num_counters;    // Üretilen sayaç sayısı
+} ProfileInstrumentation;
+
+// --- Yürütücü Profil Çıktısı ---
+// --run ile BVM, JIT veya katmanlı yürütmede çalışan enstrümante programların sayaçları, derlenmiş
+// programlardaki çalışma zamanı kütüphanesi gibi PROFDUMP'ta veya yürütme bitince bir kez yazılır
+// ve dosyadaki önceki çalıştırmaların sayımlarıyla birleştirilir.
+typedef struct {
+    const char* path;       // .bsmprof yolu
+    uint64_t cfg_checksum;  // Enstrümante edilen CFG'nin özeti
+    size_t num_counters;    // Enstrümantasyonun ürettiği sayaç sayısı
+    int dumped;             // Yazıldıysa 1 (sonraki çağrılar bir şey yapmaz)
+    int failed;             // Yazım başarısız olduysa 1
+} ProfileSink;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Bir .bsmprof dosyasını okur.
+ * @param path Dosya yolu.
+ * @return Okunan ProfileData pointer'ı veya NULL hata durumunda.
+ */
+ProfileData* profile_load(const char* path);
+
+/**
+ * @brief Profil verisini .bsmprof biçiminde diske yazar.
+ * @param path Dosya yolu.
+ * @param data Yazılacak profil verisi.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int profile_save(const char* path, const ProfileData* data);
+
+/**
+ * @brief Yürütücünün sayaçlarını profile_save ile yazar (sadece ilk çağrıda).
+ * @param sink Hedef dosya ve enstrümantasyon bilgileri.
+ * @param counters Yürütücünün sayaçları (optimizasyonla kalkan sayaçlar olmayabilir; eksikler 0'dır).
+ * @param num_counters counters'ın eleman sayısı.
+ * @return Sayaçlar yazıldıysa (veya daha önce yazıldıysa) 1, aksi takdirde 0.
+ */
+int profile_sink_dump(ProfileSink* sink, const uint64_t* counters, size_t num_counters);
+
+/**
+ * @brief Profil verisini serbest bırakır.
+ * @param data Serbest bırakılacak ProfileData pointer'ı.
+ */
+void profile_free(ProfileData* data);
+
+/**
+ * @brief Programın her CFG kenarına PROFCNT sayaçları ekler (enstrümantasyon).
+ * Koşullu atlamaların alınan kenarları için program sonuna küçük bir "trambolin"
+ * bloğu eklenir; diğer kenarlarda sayaç doğrudan kenarın yoluna yerleştirilir.
+ * Çıkış sistem çağrılarından önce PROFDUMP eklenir.
+ * @param program Enstrümante edilecek program (semantik analizden geçmiş olmalı).
+ * @param symbol_table Yeni etiketlerin ekleneceği sembol tablosu.
+ * @param exit_syscall Programı sonlandıran sistem çağrısının numarası.
+ * @param result Sayaç sayısı ve CFG özeti buraya yazılır.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int profile_instrument_program(AstNode* program, SymbolTable* symbol_table, int64_t exit_syscall,
+                               ProfileInstrumentation* result);
+
+/**
+ * @brief Profil sayaçlarını programın komutlarına işler (profile_count, profile_taken_count).
+ * Optimizasyonlardan önce, enstrümantasyonun yapıldığı aynı noktada çağrılmalıdır.
+ * @param program Profil uygulanacak program.
+ * @param data Okunmuş profil verisi.
+ * @return Profil programla eşleşip uygulandıysa 1, eşleşmezse (eski profil) 0.
+ */
+int profile_annotate_program(AstNode* program, const ProfileData* data);
+
+#endif // PROFILE_H
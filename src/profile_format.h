@@ -0,0 +1,93 @@
+#ifndef PROFILE_FORMAT_H
+#define PROFILE_FORMAT_H
+
+// --- .bsmprof Dosya Biçimi ---
+// Derleyici (profile.c: okuma, --run ile yürütülen programların sayaçları) ve çalışma zamanı
+// kütüphanesi (runtime/bsm_profile_rt.c: derlenmiş programların sayaçları) aynı tanımları
+// kullanır. Bu başlık derleyicinin geri kalanına bağlı değildir; çalışma zamanı kütüphanesi onu
+// göreli yoluyla dahil eder, bu yüzden yardımcılar başlıkta tanımlıdır.
+//
+// Biçim (host bayt sırası):
+//  char     magic[8]      "BSMPROF" + '\0'
+//  uint32_t version       BSM_PROFILE_VERSION
+//  uint32_t reserved      0
+//  uint64_t cfg_checksum  cfg_checksum() değeri
+//  uint64_t num_counters  Sayaç sayısı
+//  uint64_t counters[num_counters]
+//
+// Aynı programın (özet ve sayaç sayısı eşleşen) ardışık çalıştırmaları dosyadaki sayımlara eklenir.
+
+#include <stdint.h> // uint32_t, uint64_t
+#include <stdio.h>  // FILE, fopen, fread, fwrite
+#include <string.h> // memcmp, memcpy
+
+#define BSM_PROFILE_MAGIC "BSMPROF"
+#define BSM_PROFILE_VERSION 1u
+#define BSM_PROFILE_DEFAULT_PATH "default.bsmprof" // --profile-generate'e yol verilmezse
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t cfg_checksum;
+    uint64_t num_counters;
+} BsmProfileHeader;
+
+/**
+ * @brief Dosyanın başlığını okur (sihirli sayı ve sürüm denetlenmez).
+ * @return Başlık tam okunduysa 1, aksi takdirde 0.
+ */
+static inline int bsm_profile_read_header(FILE* file, BsmProfileHeader* header) {
+    return fread(header->magic, 1, sizeof(header->magic), file) == sizeof(header->magic) &&
+           fread(&header->version, sizeof(header->version), 1, file) == 1 &&
+           fread(&header->reserved, sizeof(header->reserved), 1, file) == 1 &&
+           fread(&header->cfg_checksum, sizeof(header->cfg_checksum), 1, file) == 1 &&
+           fread(&header->num_counters, sizeof(header->num_counters), 1, file) == 1;
+}
+
+/**
+ * @brief Başlığın bu sürümün .bsmprof dosyasına ait olup olmadığını kontrol eder.
+ */
+static inline int bsm_profile_header_valid(const BsmProfileHeader* header) {
+    return memcmp(header->magic, BSM_PROFILE_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == BSM_PROFILE_VERSION;
+}
+
+/**
+ * @brief Başlığı ve sayaçları açık dosyaya yazar.
+ * @return Tümü yazıldıysa 1, aksi takdirde 0.
+ */
+static inline int bsm_profile_write(FILE* file, uint64_t cfg_checksum, uint64_t num_counters,
+                                    const uint64_t* counters) {
+    char magic[8] = {0};
+    memcpy(magic, BSM_PROFILE_MAGIC, sizeof(BSM_PROFILE_MAGIC));
+    uint32_t version = BSM_PROFILE_VERSION, reserved = 0;
+    return fwrite(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+           fwrite(&version, sizeof(version), 1, file) == 1 &&
+           fwrite(&reserved, sizeof(reserved), 1, file) == 1 &&
+           fwrite(&cfg_checksum, sizeof(cfg_checksum), 1, file) == 1 &&
+           fwrite(&num_counters, sizeof(num_counters), 1, file) == 1 &&
+           fwrite(counters, sizeof(uint64_t), (size_t)num_counters, file) == (size_t)num_counters;
+}
+
+/**
+ * @brief Aynı programın önceki çalıştırmalarının sayımlarını (dosya varsa ve özet ile sayaç sayısı
+ * eşleşiyorsa) totals'a ekler. Dosya yoksa veya başka bir programa aitse totals değişmez.
+ */
+static inline void bsm_profile_merge_file(const char* path, uint64_t cfg_checksum, uint64_t num_counters,
+                                          uint64_t* totals) {
+    FILE* existing = fopen(path, "rb");
+    if (!existing) return;
+    BsmProfileHeader header;
+    if (bsm_profile_read_header(existing, &header) && bsm_profile_header_valid(&header) &&
+        header.cfg_checksum == cfg_checksum && header.num_counters == num_counters) {
+        for (uint64_t i = 0; i < num_counters; i++) {
+            uint64_t value;
+            if (fread(&value, sizeof(value), 1, existing) != 1) break;
+            totals[i] += value;
+        }
+    }
+    fclose(existing);
+}
+
+#endif // PROFILE_FORMAT_H
@@ -0,0 +1,613 @@
+#include "regalloc.h"
+#include <stdlib.h> // malloc, calloc, free, qsort
+#include <stdio.h>  // fprintf
+#include <string.h> // memset
+
+#define REGALLOC_ALL_REGISTERS ((1u << IR_NUM_REGISTERS) - 1)
+#define REGALLOC_LOOP_WEIGHT 10         // Döngü derinliği başına erişim ağırlığı çarpanı
+#define REGALLOC_MAX_LOOP_DEPTH 8       // Ağırlığın taşmaması için derinlik sınırı
+
+// --- Çözümleme Durumu ---
+typedef struct {
+    const IrFunction* fn;
+    uint32_t* reads;        // Komut başına okunan kaydediciler (bit r: Rr)
+    uint32_t* writes;       // Komut başına yazılan kaydediciler
+    uint32_t* live;         // Komut başına: komuttan sonra canlı kaydediciler
+    uint8_t* barrier;       // 1: CALL, SYSCALL, PROFDUMP veya sonlandırıcı (parçalar aşamaz)
+    uint32_t* gen;          // Blok başına: bloktaki ilk yazmadan önce okunan kaydediciler
+    uint32_t* kill;         // Blok başına: yazılan kaydediciler
+    uint32_t* live_in;
+    uint32_t* live_out;
+    uint64_t* block_weight; // Blok başına REGALLOC_LOOP_WEIGHT^döngü derinliği
+} RegAllocState;
+
+// --- Bloğun İçi Parça Adayı ---
+typedef struct {
+    RegAllocPiece piece;
+    int64_t benefit;        // Parçanın kazandırdığı bellek erişimi sayısı
+    int dropped;            // 1: kaydedici verilemedi
+} RegAllocCandidate;
+
+static void regalloc_state_free(RegAllocState* state) {
+    free(state->reads);
+    free(state->writes);
+    free(state->live);
+    free(state->barrier);
+    free(state->gen);
+    free(state->kill);
+    free(state->live_in);
+    free(state->live_out);
+    free(state->block_weight);
+}
+
+static uint32_t regalloc_origin_mask(const IrFunction* fn, uint16_t vreg) {
+    if (vreg == IR_NO_VREG || vreg >= fn->num_vregs) return 0;
+    int origin = fn->vregs[vreg].origin;
+    return origin >= 0 && origin < IR_NUM_REGISTERS ? 1u << origin : 0;
+}
+
+// --- Kontrol Akışı ---
+
+static size_t regalloc_num_successors(const IrFunction* fn, uint32_t block) {
+    const IrInstr* terminator = ir_block_terminator(fn, block);
+    if (!terminator) return 0;
+    switch ((IrOpcode)terminator->opcode) {
+        case IR_OP_JMP:
+            return 1;
+        case IR_OP_BR:
+            return 2;
+        case IR_OP_JTAB:
+            return (size_t)fn->jump_tables[terminator->u.op.imm].num_targets + 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Bloğun k. ardılı (JTAB için hedefler, ardından varsayılan hedef).
+ */
+static uint32_t regalloc_successor(const IrFunction* fn, uint32_t block, size_t k) {
+    const IrInstr* terminator = ir_block_terminator(fn, block);
+    if (terminator->opcode == IR_OP_JTAB) {
+        const IrJumpTable* table = &fn->jump_tables[terminator->u.op.imm];
+        return k < table->num_targets ? fn->pool[table->first_target + k] : table->default_block;
+    }
+    return k == 0 ? terminator->u.br.taken : terminator->u.br.fallthrough;
+}
+
+/**
+ * @brief Blokların döngü derinliğini bulur: derinlik öncelikli aramadaki her geri kenar (hedefi
+ * yığında olan kenar), hedefini başlık kabul eden doğal bir döngü tanımlar; gövde, kenarın
+ * kaynağından başlığa varmadan geriye doğru ulaşılan bloklardır. Aynı başlığın döngüleri birleştirilir.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int regalloc_loop_weights(RegAllocState* state) {
+    const IrFunction* fn = state->fn;
+    size_t n = fn->num_blocks ? fn->num_blocks : 1;
+    uint32_t* num_preds = (uint32_t*)calloc(n + 1, sizeof(uint32_t));
+    uint8_t* color = (uint8_t*)calloc(n, 1);
+    uint32_t* depth = (uint32_t*)calloc(n, sizeof(uint32_t));
+    uint32_t* marked = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t* stack = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    size_t* next = (size_t*)malloc(sizeof(size_t) * n);
+    uint32_t* preds = NULL;
+    uint32_t* back_edges = NULL;    // Geri kenar çiftleri (kaynak, başlık)
+    size_t num_back_edges = 0;
+    int ok = num_preds && color && depth && marked && stack && next;
+
+    // Öncüller (sıkıştırılmış satır düzeni)
+    size_t num_edges = 0;
+    for (uint32_t b = 0; b < fn->num_blocks && ok; b++) {
+        size_t count = regalloc_num_successors(fn, b);
+        for (size_t k = 0; k < count; k++) num_preds[regalloc_successor(fn, b, k) + 1]++;
+        num_edges += count;
+    }
+    if (ok) {
+        for (size_t b = 0; b < fn->num_blocks; b++) num_preds[b + 1] += num_preds[b];
+        preds = (uint32_t*)malloc(sizeof(uint32_t) * (num_edges ? num_edges : 1));
+        back_edges = (uint32_t*)malloc(sizeof(uint32_t) * 2 * (num_edges ? num_edges : 1));
+        ok = preds && back_edges;
+    }
+    if (ok) {
+        for (size_t b = 0; b < fn->num_blocks; b++) next[b] = num_preds[b];
+        for (uint32_t b = 0; b < fn->num_blocks; b++) {
+            size_t count = regalloc_num_successors(fn, b);
+            for (size_t k = 0; k < count; k++) {
+                uint32_t s = regalloc_successor(fn, b, k);
+                preds[next[s]++] = b;
+            }
+        }
+
+        // Derinlik öncelikli arama (color 1: yığında, 2: bitti); alt programlar ayrı köklerden
+        for (uint32_t root = 0; root < fn->num_blocks; root++) {
+            if (color[root]) continue;
+            size_t top = 0;
+            stack[top++] = root;
+            next[root] = 0;
+            color[root] = 1;
+            while (top > 0) {
+                uint32_t b = stack[top - 1];
+                if (next[b] >= regalloc_num_successors(fn, b)) {
+                    color[b] = 2;
+                    top--;
+                    continue;
+                }
+                uint32_t s = regalloc_successor(fn, b, next[b]++);
+                if (color[s] == 1) {
+                    back_edges[2 * num_back_edges] = b;
+                    back_edges[2 * num_back_edges + 1] = s;
+                    num_back_edges++;
+                } else if (color[s] == 0) {
+                    color[s] = 1;
+                    next[s] = 0;
+                    stack[top++] = s;
+                }
+            }
+        }
+
+        // Başlık başına gövde: geri kenar kaynaklarından öncüllere doğru, başlıkta durarak
+        for (size_t b = 0; b < fn->num_blocks; b++) marked[b] = UINT32_MAX;
+        for (uint32_t h = 0; h < fn->num_blocks; h++) {
+            size_t top = 0;
+            for (size_t e = 0; e < num_back_edges; e++) {
+                if (back_edges[2 * e + 1] != h) continue;
+                if (marked[h] != h) {
+                    marked[h] = h;
+                    depth[h]++;
+                }
+                uint32_t source = back_edges[2 * e];
+                if (marked[source] == h) continue;
+                marked[source] = h;
+                stack[top++] = source;
+            }
+            while (top > 0) {
+                uint32_t b = stack[--top];
+                depth[b]++;
+                for (uint32_t p = num_preds[b]; p < num_preds[b + 1]; p++) {
+                    if (marked[preds[p]] == h) continue;
+                    marked[preds[p]] = h;
+                    stack[top++] = preds[p];
+                }
+            }
+        }
+        for (size_t b = 0; b < fn->num_blocks; b++) {
+            uint64_t weight = 1;
+            for (uint32_t d = 0; d < depth[b] && d < REGALLOC_MAX_LOOP_DEPTH; d++) weight *= REGALLOC_LOOP_WEIGHT;
+            state->block_weight[b] = weight;
+        }
+    }
+    free(num_preds);
+    free(color);
+    free(depth);
+    free(marked);
+    free(stack);
+    free(next);
+    free(preds);
+    free(back_edges);
+    return ok;
+}
+
+// --- Canlılık ---
+
+/**
+ * @brief Komut başına okunan/yazılan kaydedicileri ve engelleri bulur, blok düzeyinde canlılığı
+ * sabit noktaya kadar hesaplar ve her komuttan sonra canlı kaydedicileri yazar.
+ */
+static void regalloc_liveness(RegAllocState* state, const RegAllocTarget* target) {
+    const IrFunction* fn = state->fn;
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        IrOpcode opcode = (IrOpcode)instr->opcode;
+        uint16_t uses[3];
+        size_t count = ir_instr_uses(instr, uses);
+        uint32_t reads = 0;
+        for (size_t k = 0; k < count; k++) reads |= regalloc_origin_mask(fn, uses[k]);
+        if (opcode == IR_OP_CALL || opcode == IR_OP_RET) {
+            reads = REGALLOC_ALL_REGISTERS;
+        } else if (opcode == IR_OP_SYSCALL) {
+            // Argümanlar ve R0 (argsız exit'in kodu)
+            const IrSyscall* syscall = &fn->syscalls[instr->u.op.imm];
+            reads |= 1u;
+            for (uint32_t a = 0; a < syscall->num_args; a++) reads |= 1u << (fn->pool[syscall->first_arg + a] & 0x0f);
+        }
+        if (target->reads) reads |= target->reads(target->context, i) & REGALLOC_ALL_REGISTERS;
+        state->reads[i] = reads;
+        state->writes[i] = regalloc_origin_mask(fn, instr->dst);
+        state->barrier[i] = (uint8_t)(opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL || opcode == IR_OP_PROFDUMP ||
+                                      ir_is_terminator(opcode));
+    }
+
+    // Blok başına üst düzeyde açığa çıkan okumalar (gen) ve yazmalar (kill): in = gen | (out & ~kill)
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        uint32_t gen = 0, kill = 0;
+        for (size_t i = (size_t)block->first + block->num_instrs; i-- > block->first;) {
+            gen = (gen & ~state->writes[i]) | state->reads[i];
+            kill |= state->writes[i];
+        }
+        state->gen[b] = gen;
+        state->kill[b] = kill;
+        state->live_in[b] = gen;
+        state->live_out[b] = 0;
+    }
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (size_t b = fn->num_blocks; b-- > 0;) {
+            uint32_t out = 0;
+            size_t count = regalloc_num_successors(fn, (uint32_t)b);
+            for (size_t k = 0; k < count; k++) out |= state->live_in[regalloc_successor(fn, (uint32_t)b, k)];
+            if (out == state->live_out[b]) continue;
+            state->live_out[b] = out;
+            state->live_in[b] = state->gen[b] | (out & ~state->kill[b]);
+            changed = 1;
+        }
+    }
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        uint32_t live = state->live_out[b];
+        for (size_t i = (size_t)block->first + block->num_instrs; i-- > block->first;) {
+            state->live[i] = live;
+            live = (live & ~state->writes[i]) | state->reads[i];
+        }
+    }
+}
+
+static uint32_t regalloc_live_before(const RegAllocState* state, size_t instr) {
+    return (state->live[instr] & ~state->writes[instr]) | state->reads[instr];
+}
+
+// --- 1. Evler ---
+
+/**
+ * @brief Kaydedicilerin canlı aralıklarını doğrusal tarar ve evlerini atar. Havuz dolduğunda
+ * aktif aralıklar ve yeni aralık arasından ağırlığı en düşük olan belleğe taşınır. Sonunda havuz
+ * indeksleri, paylaşan kaydedicilerin toplam ağırlığına göre yeniden numaralanır (hedefler ucuz
+ * kaydedicileri havuzun başına koyar, örn: sıkıştırılmış komutların adreslediği x8-x15).
+ */
+static void regalloc_assign_homes(const RegAllocState* state, size_t num_registers, RegAllocation* allocation) {
+    const IrFunction* fn = state->fn;
+    int64_t start[IR_NUM_REGISTERS], end[IR_NUM_REGISTERS];
+    uint64_t weight[IR_NUM_REGISTERS] = {0};
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        start[r] = -1;
+        end[r] = -1;
+        allocation->homes[r] = REGALLOC_MEMORY;
+    }
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        for (size_t i = block->first; i < (size_t)block->first + block->num_instrs; i++) {
+            uint32_t accessed = state->reads[i] | state->writes[i];
+            uint32_t touched = accessed | state->live[i];
+            for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+                if (!(touched & (1u << r))) continue;
+                if (start[r] < 0 || (int64_t)i < start[r]) start[r] = (int64_t)i;
+                if ((int64_t)i > end[r]) end[r] = (int64_t)i;
+                if (accessed & (1u << r)) weight[r] += state->block_weight[b];
+            }
+        }
+    }
+
+    // Başlangıç sırası (eşitlikte kaydedici numarası)
+    int order[IR_NUM_REGISTERS];
+    size_t num_intervals = 0;
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (start[r] < 0) continue;
+        size_t k = num_intervals++;
+        while (k > 0 && start[order[k - 1]] > start[r]) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = r;
+    }
+
+    int active[IR_NUM_REGISTERS];
+    size_t num_active = 0;
+    for (size_t k = 0; k < num_intervals; k++) {
+        int r = order[k];
+        uint32_t used = 0;
+        size_t kept = 0;
+        for (size_t a = 0; a < num_active; a++) {
+            if (end[active[a]] < start[r]) continue; // Süresi doldu
+            active[kept++] = active[a];
+            used |= 1u << allocation->homes[active[a]];
+        }
+        num_active = kept;
+        int reg = -1;
+        for (size_t p = 0; p < num_registers && reg < 0; p++) {
+            if (!(used & (1u << p))) reg = (int)p;
+        }
+        if (reg >= 0) {
+            allocation->homes[r] = reg;
+            active[num_active++] = r;
+            continue;
+        }
+        size_t victim = 0;
+        for (size_t a = 1; a < num_active; a++) {
+            if (weight[active[a]] < weight[active[victim]]) victim = a;
+        }
+        if (num_active == 0 || weight[active[victim]] >= weight[r]) continue; // r bellekte kalır
+        allocation->homes[r] = allocation->homes[active[victim]];
+        allocation->homes[active[victim]] = REGALLOC_MEMORY;
+        active[victim] = r;
+    }
+
+    // Havuz indekslerini toplam ağırlığa göre sırala
+    uint64_t total[IR_NUM_REGISTERS] = {0};
+    int rank[IR_NUM_REGISTERS];
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (allocation->homes[r] != REGALLOC_MEMORY) total[allocation->homes[r]] += weight[r] + 1;
+    }
+    for (size_t p = 0; p < num_registers; p++) {
+        int position = 0;
+        for (size_t q = 0; q < num_registers; q++) {
+            if (total[q] > total[p] || (total[q] == total[p] && q < p)) position++;
+        }
+        rank[p] = position;
+    }
+    uint32_t homes_of[IR_NUM_REGISTERS] = {0}; // Havuz kaydedicisi başına ev sahibi sayısı
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (allocation->homes[r] == REGALLOC_MEMORY) {
+            if (start[r] >= 0) allocation->num_spilled++;
+            continue;
+        }
+        allocation->homes[r] = rank[allocation->homes[r]];
+        homes_of[allocation->homes[r]]++;
+    }
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (allocation->homes[r] != REGALLOC_MEMORY && homes_of[allocation->homes[r]] > 1) allocation->num_shared++;
+    }
+}
+
+// --- 2. Blok İçi Parçalar ---
+
+static int regalloc_compare_candidates(const void* a, const void* b) {
+    const RegAllocCandidate* x = (const RegAllocCandidate*)a;
+    const RegAllocCandidate* y = (const RegAllocCandidate*)b;
+    if (x->piece.first != y->piece.first) return x->piece.first < y->piece.first ? -1 : 1;
+    return (int)x->piece.origin - (int)y->piece.origin;
+}
+
+/**
+ * @brief Evi bellekte olan kaydedicinin [first, last] aralığındaki erişimlerinden parça adayı
+ * oluşturur. Aday, kazandırdığı bellek erişimi (parçasız okuma ve yazma sayısı - parçanın yükleme
+ * ve yazması) pozitifse eklenir.
+ */
+static void regalloc_add_candidate(const RegAllocState* state, int origin, uint32_t first, uint32_t last,
+                                   int64_t accesses, int dirty, RegAllocCandidate* candidates, size_t* count) {
+    RegAllocCandidate* candidate = &candidates[*count];
+    memset(candidate, 0, sizeof(RegAllocCandidate));
+    candidate->piece.first = first;
+    candidate->piece.last = last;
+    candidate->piece.origin = (uint8_t)origin;
+    candidate->piece.load = (uint8_t)((regalloc_live_before(state, first) >> origin) & 1);
+    candidate->piece.store = (uint8_t)(dirty && ((state->live[last] >> origin) & 1));
+    candidate->benefit = accesses - candidate->piece.load - candidate->piece.store;
+    if (candidate->benefit > 0) (*count)++;
+}
+
+/**
+ * @brief Bloğun parça adaylarını bulur ve blok içinde doğrusal tarar: aday, aralığı boyunca hiçbir
+ * ev sahibi canlı olmayan veya yazılmayan ve başka bir parçaya verilmemiş bir havuz kaydedicisi
+ * alır. Kaydedici yoksa kazancı daha düşük ve kaydedicisi bu aralıkta da boş olan bir parçanın
+ * kaydedicisini devralır.
+ * @param busy Blok uzunluğunda geçici dizi.
+ * @param candidates Bloktaki erişim sayısı kadar elemanlı geçici dizi.
+ * @return Bloğun parça sayısı.
+ */
+static size_t regalloc_split_block(const RegAllocState* state, size_t num_registers, uint32_t b,
+                                   const RegAllocation* allocation, uint32_t* busy, RegAllocCandidate* candidates) {
+    const IrFunction* fn = state->fn;
+    const IrBlock* block = &fn->blocks[b];
+    size_t first = block->first, end = (size_t)block->first + block->num_instrs;
+    uint32_t pool = (uint32_t)((1u << num_registers) - 1);
+
+    // Komut başına ev sahiplerinin tuttuğu havuz kaydedicileri
+    for (size_t i = first; i < end; i++) {
+        uint32_t touched = state->reads[i] | state->writes[i] | state->live[i];
+        busy[i - first] = 0;
+        for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+            if ((touched & (1u << r)) && allocation->homes[r] != REGALLOC_MEMORY) {
+                busy[i - first] |= 1u << allocation->homes[r];
+            }
+        }
+    }
+
+    // Adaylar: engeller arasındaki erişimler
+    size_t count = 0;
+    for (int r = 0; r < IR_NUM_REGISTERS; r++) {
+        if (allocation->homes[r] != REGALLOC_MEMORY) continue;
+        uint32_t bit = 1u << r;
+        int open = 0, dirty = 0;
+        uint32_t piece_first = 0, piece_last = 0;
+        int64_t accesses = 0;
+        for (size_t i = first; i < end; i++) {
+            if (state->barrier[i]) {
+                if (open) regalloc_add_candidate(state, r, piece_first, piece_last, accesses, dirty, candidates, &count);
+                open = 0;
+                continue;
+            }
+            if (!((state->reads[i] | state->writes[i]) & bit)) continue;
+            if (!open) {
+                open = 1;
+                dirty = 0;
+                accesses = 0;
+                piece_first = (uint32_t)i;
+            }
+            piece_last = (uint32_t)i;
+            // Parçasız her okuma bir yükleme, her yazma bir yuvaya yazmadır
+            accesses += ((state->reads[i] & bit) != 0) + ((state->writes[i] & bit) != 0);
+            if (state->writes[i] & bit) dirty = 1;
+        }
+        if (open) regalloc_add_candidate(state, r, piece_first, piece_last, accesses, dirty, candidates, &count);
+    }
+    qsort(candidates, count, sizeof(RegAllocCandidate), regalloc_compare_candidates);
+
+    size_t active[IR_NUM_REGISTERS];
+    size_t num_active = 0;
+    for (size_t c = 0; c < count; c++) {
+        RegAllocCandidate* candidate = &candidates[c];
+        candidate->dropped = 1;
+        uint32_t occupied = 0, used = 0;
+        for (size_t i = candidate->piece.first; i <= candidate->piece.last; i++) occupied |= busy[i - first];
+        size_t kept = 0;
+        for (size_t a = 0; a < num_active; a++) {
+            const RegAllocCandidate* other = &candidates[active[a]];
+            if (other->dropped || other->piece.last < candidate->piece.first) continue;
+            active[kept++] = active[a];
+            used |= 1u << other->piece.reg;
+        }
+        num_active = kept;
+        uint32_t free_registers = pool & ~occupied & ~used;
+        if (free_registers) {
+            uint8_t reg = 0;
+            while (!(free_registers & (1u << reg))) reg++;
+            candidate->piece.reg = reg;
+            candidate->dropped = 0;
+            active[num_active++] = c;
+            continue;
+        }
+        size_t victim = SIZE_MAX;
+        for (size_t a = 0; a < num_active; a++) {
+            const RegAllocCandidate* other = &candidates[active[a]];
+            if (occupied & (1u << other->piece.reg)) continue;
+            if (other->benefit >= candidate->benefit) continue;
+            if (victim == SIZE_MAX || other->benefit < candidates[active[victim]].benefit) victim = a;
+        }
+        if (victim == SIZE_MAX) continue;
+        candidate->piece.reg = candidates[active[victim]].piece.reg;
+        candidate->dropped = 0;
+        candidates[active[victim]].dropped = 1;
+        active[victim] = c;
+    }
+
+    size_t kept = 0;
+    for (size_t c = 0; c < count; c++) {
+        if (!candidates[c].dropped) candidates[kept++] = candidates[c];
+    }
+    return kept;
+}
+
+// --- 3. Yeniden Üretim ---
+
+/**
+ * @brief Parçaya alınamayan, evi bellekte olan sabit yüklemeli blok yerel değerleri işaretler.
+ * SEL'in ilk kaynağı olan değerler hariçtir: hedefle aynı kökenliyse seçim yerinde yapılır ve
+ * değerin evde olması gerekir.
+ */
+static void regalloc_rematerialize(const RegAllocState* state, RegAllocation* allocation) {
+    const IrFunction* fn = state->fn;
+    for (size_t v = 0; v < fn->num_vregs; v++) allocation->remat[v] = REGALLOC_NO_REMAT;
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        for (size_t i = block->first; i < (size_t)block->first + block->num_instrs; i++) {
+            const IrInstr* instr = &fn->instrs[i];
+            if (instr->opcode != IR_OP_MOV || !(instr->attrs & IR_ATTR_IMM) || instr->dst < IR_FIRST_VIRTUAL ||
+                instr->dst >= fn->num_vregs) {
+                continue;
+            }
+            int origin = fn->vregs[instr->dst].origin;
+            if (origin < 0 || origin >= IR_NUM_REGISTERS || allocation->homes[origin] != REGALLOC_MEMORY) continue;
+            int covered = 0;
+            for (uint32_t p = allocation->block_pieces[b]; p < allocation->block_pieces[b + 1] && !covered; p++) {
+                const RegAllocPiece* piece = &allocation->pieces[p];
+                covered = piece->origin == origin && piece->first <= i && i <= piece->last;
+            }
+            if (!covered) allocation->remat[instr->dst] = (uint32_t)i;
+        }
+    }
+    for (size_t i = 0; i < fn->num_instrs; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode == IR_OP_SEL && instr->u.op.src1 < fn->num_vregs) {
+            allocation->remat[instr->u.op.src1] = REGALLOC_NO_REMAT;
+        }
+    }
+    for (size_t v = 0; v < fn->num_vregs; v++) allocation->num_remat += allocation->remat[v] != REGALLOC_NO_REMAT;
+}
+
+// --- Dışa Açık Fonksiyonlar ---
+
+int regalloc_run(const IrFunction* fn, const RegAllocTarget* target, RegAllocation* allocation) {
+    memset(allocation, 0, sizeof(RegAllocation));
+    RegAllocState state;
+    memset(&state, 0, sizeof(state));
+    state.fn = fn;
+    size_t n = fn->num_instrs ? fn->num_instrs : 1;
+    size_t num_blocks = fn->num_blocks ? fn->num_blocks : 1;
+    size_t num_registers = target->num_registers < IR_NUM_REGISTERS ? target->num_registers : IR_NUM_REGISTERS;
+    state.reads = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    state.writes = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    state.live = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    state.barrier = (uint8_t*)malloc(n);
+    state.gen = (uint32_t*)malloc(sizeof(uint32_t) * num_blocks);
+    state.kill = (uint32_t*)malloc(sizeof(uint32_t) * num_blocks);
+    state.live_in = (uint32_t*)malloc(sizeof(uint32_t) * num_blocks);
+    state.live_out = (uint32_t*)malloc(sizeof(uint32_t) * num_blocks);
+    state.block_weight = (uint64_t*)malloc(sizeof(uint64_t) * num_blocks);
+    allocation->block_pieces = (uint32_t*)calloc(num_blocks + 1, sizeof(uint32_t));
+    allocation->remat = (uint32_t*)malloc(sizeof(uint32_t) * (fn->num_vregs ? fn->num_vregs : 1));
+
+    // Geçici diziler en uzun blok için
+    size_t longest = 1;
+    for (size_t b = 0; b < fn->num_blocks; b++) {
+        if (fn->blocks[b].num_instrs > longest) longest = fn->blocks[b].num_instrs;
+    }
+    uint32_t* busy = (uint32_t*)malloc(sizeof(uint32_t) * longest);
+    RegAllocCandidate* candidates = NULL;
+    int ok = state.reads && state.writes && state.live && state.barrier && state.gen && state.kill && state.live_in &&
+             state.live_out && state.block_weight && allocation->block_pieces && allocation->remat && busy &&
+             regalloc_loop_weights(&state);
+    if (ok) {
+        regalloc_liveness(&state, target);
+        regalloc_assign_homes(&state, num_registers, allocation);
+
+        // Bir bloğun adayları en fazla erişim sayısı kadardır
+        size_t most_accesses = 1;
+        for (size_t b = 0; b < fn->num_blocks; b++) {
+            size_t accesses = 0;
+            for (size_t i = fn->blocks[b].first; i < (size_t)fn->blocks[b].first + fn->blocks[b].num_instrs; i++) {
+                for (uint32_t mask = state.reads[i] | state.writes[i]; mask; mask &= mask - 1) accesses++;
+            }
+            if (accesses > most_accesses) most_accesses = accesses;
+        }
+        candidates = (RegAllocCandidate*)malloc(sizeof(RegAllocCandidate) * most_accesses);
+        ok = candidates != NULL;
+        size_t capacity = 0;
+        for (uint32_t b = 0; b < fn->num_blocks && ok; b++) {
+            allocation->block_pieces[b] = (uint32_t)allocation->num_pieces;
+            size_t count = regalloc_split_block(&state, num_registers, b, allocation, busy, candidates);
+            if (allocation->num_pieces + count > capacity) {
+                size_t new_capacity = capacity ? capacity : 16;
+                while (new_capacity < allocation->num_pieces + count) new_capacity *= 2;
+                RegAllocPiece* grown = (RegAllocPiece*)realloc(allocation->pieces, sizeof(RegAllocPiece) * new_capacity);
+                if (!grown) {
+                    ok = 0;
+                    break;
+                }
+                allocation->pieces = grown;
+                capacity = new_capacity;
+            }
+            for (size_t c = 0; c < count; c++) allocation->pieces[allocation->num_pieces++] = candidates[c].piece;
+        }
+        allocation->block_pieces[fn->num_blocks] = (uint32_t)allocation->num_pieces;
+    }
+    if (ok) regalloc_rematerialize(&state, allocation);
+    free(busy);
+    free(candidates);
+    regalloc_state_free(&state);
+    if (!ok) {
+        fprintf(stderr, "Hata: Kaydedici ataması için bellek tahsis edilemedi.\n");
+        regalloc_free(allocation);
+    }
+    return ok;
+}
+
+void regalloc_free(RegAllocation* allocation) {
+    free(allocation->pieces);
+    free(allocation->block_pieces);
+    free(allocation->remat);
+    allocation->pieces = NULL;
+    allocation->block_pieces = NULL;
+    allocation->remat = NULL;
+    allocation->num_pieces = 0;
+}
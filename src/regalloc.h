@@ -0,0 +1,82 @@
+#ifndef REGALLOC_H
+#define REGALLOC_H
+
+#include "ir_generator.h" // IrFunction, IR_NUM_REGISTERS
+#include <stdint.h> // uint8_t, uint32_t için
+#include <stddef.h> // size_t için
+
+// --- Doğrusal Taramalı Kaydedici Ataması (Linear Scan) ---
+// Bessambly'nin 16 kaydedicisini 16'dan az makine kaydedicisi olan hedeflere (örn: RV64E'de
+// x8-x15) yerleştirir. Her Bessambly kaydedicisinin bir "evi" vardır: havuzdaki bir makine
+// kaydedicisi veya durum bölümündeki yuvası (bellek). Blok sınırlarında, CALL/SYSCALL gibi
+// engellerde ve sonlandırıcılarda değerler evlerindedir.
+//
+// 1. Evler: komutlar yerleşim sırasıyla numaralanır; kaydedicinin canlı aralığı canlı olduğu,
+//    okunduğu veya yazıldığı ilk ve son komut arasıdır (blok düzeyinde canlılık çözümlemesinden).
+//    Aralıklar başlangıç sırasıyla taranır; kesişmeyen aralıklar aynı makine kaydedicisini
+//    paylaşır. Havuz dolduğunda döngü derinliğiyle ağırlıklandırılmış erişim sayısı (10^derinlik)
+//    en düşük olan kaydedici belleğe taşınır (spill).
+// 2. Bölme: evi bellekte olan kaydedicinin blok içindeki erişimleri, iki engel arasında kalan
+//    parçalar halinde o aralıkta boş olan bir havuz kaydedicisine alınır. Parça başında değer
+//    (canlıysa) bir kez yüklenir, sonunda (yazıldıysa ve hâlâ canlıysa) bir kez yuvaya yazılır;
+//    aradaki erişimler bellek trafiği üretmez. Yuva kaydedicinin kendi yuvası olduğu için blok
+//    sınırlarında taşıma gerekmez.
+// 3. Yeniden üretim: parçaya alınamayan sabit yüklemeli blok yerel değerler (MOV r, imm) yuvaya
+//    yazılmaz; okundukları yerde sabit yeniden yüklenir.
+//
+// Canlılık SYSCALL'un argümanlarını ve R0'ı, CALL ve RET'in tüm kaydedicileri okuduğunu varsayar;
+// kod üretici IR'de görünmeyen ek okumaları (örn: birleştirilmiş bayrakların karşılaştırdığı
+// kaydediciler, komut seçiminde kalıba katılan yapraklar) RegAllocTarget.reads ile bildirir.
+
+#define REGALLOC_MEMORY (-1)            // Ev: durum bölümündeki yuva
+#define REGALLOC_NO_REMAT 0xFFFFFFFFu   // Değer yeniden üretilmez
+
+// --- Hedef Açıklaması ---
+typedef struct {
+    size_t num_registers;   // Havuzdaki makine kaydedicisi sayısı (en fazla IR_NUM_REGISTERS)
+    void* context;          // reads'e aktarılır
+    // Komutun makine kodunun IR kullanımları dışında okuduğu Bessambly kaydedicileri (bit maskesi;
+    // NULL: yok)
+    uint32_t (*reads)(void* context, size_t instr);
+} RegAllocTarget;
+
+// --- Blok İçi Parça (evi bellekte olan kaydedicinin makine kaydedicisinde geçirdiği aralık) ---
+typedef struct {
+    uint32_t first;         // İlk erişen komut
+    uint32_t last;          // Son erişen komut (engel veya sonlandırıcı değildir)
+    uint8_t origin;         // Bessambly kaydedicisi
+    uint8_t reg;            // Havuz indeksi
+    uint8_t load;           // 1: ilk komuttan önce yuvadan yüklenir
+    uint8_t store;          // 1: son komuttan sonra yuvaya yazılır
+} RegAllocPiece;
+
+// --- Atama Sonucu ---
+typedef struct {
+    int homes[IR_NUM_REGISTERS];    // Havuz indeksi veya REGALLOC_MEMORY
+    RegAllocPiece* pieces;          // Bloklara göre gruplanmış, blok içinde ilk komuta göre sıralı
+    size_t num_pieces;
+    uint32_t* block_pieces;         // Blok başına parça aralığı: [block_pieces[b], block_pieces[b + 1])
+    uint32_t* remat;                // Sanal kaydedici başına: değeri tanımlayan MOV veya REGALLOC_NO_REMAT
+    size_t num_spilled;             // Evi bellekte olan (kullanılan) kaydediciler
+    size_t num_shared;              // Başka bir kaydediciyle makine kaydedicisi paylaşan kaydediciler
+    size_t num_remat;               // Yeniden üretilen değerler
+} RegAllocation;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Kaydedicilere ev atar, bellekteki kaydedicilerin blok içi parçalarını ve yeniden
+ * üretilecek sabitleri belirler.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param target Havuz boyutu ve ek okumalar.
+ * @param allocation Doldurulacak sonuç (regalloc_free ile bırakılır).
+ * @return Başarılıysa 1, bellek hatasında 0 (stderr'e açıklama yazılır).
+ */
+int regalloc_run(const IrFunction* fn, const RegAllocTarget* target, RegAllocation* allocation);
+
+/**
+ * @brief Atama sonucunun dizilerini serbest bırakır.
+ */
+void regalloc_free(RegAllocation* allocation);
+
+#endif // REGALLOC_H
@@ -0,0 +1,74 @@
+// Bessambly PGO Çalışma Zamanı Kütüphanesi
+// Enstrümante edilmiş programlara bağlanır. Derleyicinin geri kalanına bağımlılığı yoktur;
+// .bsmprof biçimi derleyiciyle ortak olan profile_format.h'den gelir.
+//
+// Kod üretici şunları üretir:
+//  - Program girişinde: __bsm_prof_init(cfg_özeti, sayaç_sayısı, "program.bsmprof") ve bir kez
+//    __bsm_prof_thread_init(); dönen dizi __bsm_state.counters'a yazılır.
+//  - PROFCNT n:  __bsm_state.counters[n] += 1  (kilitsiz, sıradan bir artırma)
+//  - PROFDUMP:   __bsm_prof_dump()  (çıkış sistem çağrısından hemen önce)
+//
+// Bessambly programları tek iş parçacıklıdır ve dizi işaretçisi global __bsm_state'te tutulur; yani
+// sayım süreç başınadır. Programa bağlanan C kodu kendi iş parçacıklarında __bsm_prof_thread_init'i
+// çağırırsa her çağrı ayrı bir dizi alır ve diziler çıkışta toplanır.
+
+#include "../profile_format.h" // .bsmprof biçimi
+#include <stdint.h> // uint64_t
+#include <stdlib.h> // calloc, atexit
+#include <stdio.h>  // FILE, fopen, fclose
+
+// __bsm_prof_thread_init'in verdiği sayaç dizisi; toplama için global bir listeye bağlanır.
+typedef struct BsmProfThreadCounters {
+    struct BsmProfThreadCounters* next;
+    uint64_t counters[];
+} BsmProfThreadCounters;
+
+static BsmProfThreadCounters* all_threads = NULL;  // Kilitsiz (CAS) eklenen liste
+static uint64_t prof_checksum = 0;
+static uint64_t prof_num_counters = 0;
+static const char* prof_path = BSM_PROFILE_DEFAULT_PATH;
+static int prof_dumped = 0;
+
+uint64_t* __bsm_prof_thread_init(void) {
+    BsmProfThreadCounters* node = (BsmProfThreadCounters*)calloc(
+        1, sizeof(BsmProfThreadCounters) + sizeof(uint64_t) * (prof_num_counters ? prof_num_counters : 1));
+    if (!node) return NULL;
+
+    BsmProfThreadCounters* head = __atomic_load_n(&all_threads, __ATOMIC_RELAXED);
+    do {
+        node->next = head;
+    } while (!__atomic_compare_exchange_n(&all_threads, &head, node, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    return node->counters;
+}
+
+void __bsm_prof_dump(void) {
+    // Hem PROFDUMP hem atexit çağırabilir; sadece ilki yazar.
+    if (__atomic_exchange_n(&prof_dumped, 1, __ATOMIC_ACQ_REL)) return;
+
+    uint64_t* totals = (uint64_t*)calloc(prof_num_counters ? prof_num_counters : 1, sizeof(uint64_t));
+    if (!totals) return;
+
+    // Diğer iş parçacıkları hâlâ sayıyor olabilir; relaxed okuma yeterlidir (sayımlar yaklaşık).
+    for (BsmProfThreadCounters* t = __atomic_load_n(&all_threads, __ATOMIC_ACQUIRE); t; t = t->next) {
+        for (uint64_t i = 0; i < prof_num_counters; i++) {
+            totals[i] += __atomic_load_n(&t->counters[i], __ATOMIC_RELAXED);
+        }
+    }
+
+    // Aynı programın önceki çalıştırmalarının sayımlarıyla birleştir
+    bsm_profile_merge_file(prof_path, prof_checksum, prof_num_counters, totals);
+    FILE* out = fopen(prof_path, "wb");
+    if (out) {
+        bsm_profile_write(out, prof_checksum, prof_num_counters, totals);
+        fclose(out);
+    }
+    free(totals);
+}
+
+void __bsm_prof_init(uint64_t checksum, uint64_t num_counters, const char* path) {
+    prof_checksum = checksum;
+    prof_num_counters = num_counters;
+    if (path) prof_path = path;
+    atexit(__bsm_prof_dump);
+}
@@ -0,0 +1,410 @@
+#include "sched.h"
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // fprintf
+#include <string.h> // memset, memcpy
+
+#define SCHED_MAX_UNITS 8       // Birim türü başına modellenen en fazla kopya
+
+// --- Grafik ---
+
+void sched_graph_init(SchedGraph* graph, const TargetPipelineModel* model) {
+    memset(graph, 0, sizeof(*graph));
+    graph->model = model;
+}
+
+void sched_graph_clear(SchedGraph* graph) {
+    graph->num_nodes = 0;
+    graph->num_edges = 0;
+}
+
+void sched_graph_free(SchedGraph* graph) {
+    free(graph->op_class);
+    free(graph->edges);
+    free(graph->work);
+    graph->op_class = NULL;
+    graph->edges = NULL;
+    graph->work = NULL;
+    graph->num_nodes = graph->node_capacity = 0;
+    graph->num_edges = graph->edge_capacity = 0;
+    graph->work_capacity = 0;
+}
+
+static int sched_grow(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (!grown) return 0;
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+uint32_t sched_add_node(SchedGraph* graph, TargetOpClass op_class) {
+    if (!sched_grow((void**)&graph->op_class, &graph->node_capacity, graph->num_nodes + 1, 1)) {
+        graph->out_of_memory = 1;
+        return (uint32_t)graph->num_nodes;
+    }
+    graph->op_class[graph->num_nodes] = (uint8_t)op_class;
+    return (uint32_t)graph->num_nodes++;
+}
+
+static uint32_t sched_latency(const SchedGraph* graph, uint32_t node) {
+    uint32_t latency = graph->model->ops[graph->op_class[node]].latency;
+    return latency ? latency : 1;
+}
+
+void sched_add_edge(SchedGraph* graph, uint32_t from, uint32_t to, SchedDependency kind) {
+    if (graph->out_of_memory || from >= to || to >= graph->num_nodes) return;
+    if (!sched_grow((void**)&graph->edges, &graph->edge_capacity, graph->num_edges + 1, sizeof(SchedEdge))) {
+        graph->out_of_memory = 1;
+        return;
+    }
+    SchedEdge* edge = &graph->edges[graph->num_edges++];
+    edge->from = from;
+    edge->to = to;
+    edge->latency = kind == SCHED_DEP_DATA ? (uint8_t)sched_latency(graph, from) : 0;
+}
+
+// --- Zamanlama ---
+
+// Çalışma dizileri (work içinde): ardıl kenar aralıkları, ardıl kenarlar, kalan öncül sayıları,
+// öncelikler, en erken başlama çevrimleri ve hazır düğümler
+typedef struct {
+    uint32_t* succ_start;   // n + 1
+    uint32_t* succ;         // Kenar indeksleri (kaynağa göre gruplanmış)
+    uint32_t* preds;
+    uint32_t* height;
+    uint32_t* earliest;
+    uint32_t* ready;
+} SchedWork;
+
+typedef struct {
+    uint32_t free_at[TARGET_UNIT_COUNT][SCHED_MAX_UNITS]; // Kopyanın yeni komut kabul edeceği çevrim
+    int count[TARGET_UNIT_COUNT];
+} SchedUnits;
+
+static void sched_units_init(const TargetPipelineModel* model, SchedUnits* units) {
+    memset(units, 0, sizeof(*units));
+    for (int u = 0; u < TARGET_UNIT_COUNT; u++) {
+        int count = model->num_units[u];
+        units->count[u] = count < 1 ? 1 : count > SCHED_MAX_UNITS ? SCHED_MAX_UNITS : count;
+    }
+}
+
+/**
+ * @brief Komutun sınıfının biriminde 'cycle' çevriminde boş olan kopyayı döndürür.
+ * @param next_free Boş kopya yoksa en erken boşalacak kopyanın çevrimi yazılır.
+ * @return Kopya indeksi veya boş kopya yoksa -1.
+ */
+static int sched_free_unit(const SchedUnits* units, int unit, uint32_t cycle, uint32_t* next_free) {
+    uint32_t earliest = UINT32_MAX;
+    for (int c = 0; c < units->count[unit]; c++) {
+        if (units->free_at[unit][c] <= cycle) return c;
+        if (units->free_at[unit][c] < earliest) earliest = units->free_at[unit][c];
+    }
+    if (next_free) *next_free = earliest;
+    return -1;
+}
+
+/**
+ * @brief Düğümü 'cycle' çevriminde başlatır: birimi meşgul eder ve ardıllarının en erken başlama
+ * çevrimlerini günceller.
+ */
+static void sched_issue(const SchedGraph* graph, SchedWork* work, SchedUnits* units, uint32_t node, int copy,
+                        uint32_t cycle) {
+    const TargetOpTiming* timing = &graph->model->ops[graph->op_class[node]];
+    units->free_at[timing->unit][copy] = cycle + (timing->occupancy ? timing->occupancy : 1);
+    for (uint32_t s = work->succ_start[node]; s < work->succ_start[node + 1]; s++) {
+        const SchedEdge* edge = &graph->edges[work->succ[s]];
+        if (cycle + edge->latency > work->earliest[edge->to]) work->earliest[edge->to] = cycle + edge->latency;
+    }
+}
+
+/**
+ * @brief Verilen sırayı sıralı (in-order) bir çekirdekte çalıştırır.
+ * @return Son sonucun hazır olduğu çevrim.
+ */
+static uint32_t sched_simulate(const SchedGraph* graph, SchedWork* work, const uint32_t* order) {
+    const TargetPipelineModel* model = graph->model;
+    size_t n = graph->num_nodes;
+    int width = model->issue_width > 0 ? model->issue_width : 1;
+    SchedUnits units;
+    sched_units_init(model, &units);
+    memset(work->earliest, 0, sizeof(uint32_t) * n);
+
+    uint32_t cycle = 0, finish = 0;
+    int slots = 0;
+    for (size_t k = 0; k < n; k++) {
+        uint32_t node = order ? order[k] : (uint32_t)k;
+        int unit = model->ops[graph->op_class[node]].unit;
+        uint32_t start = work->earliest[node] > cycle ? work->earliest[node] : cycle;
+        uint32_t next_free = start;
+        int copy = sched_free_unit(&units, unit, start, &next_free);
+        if (copy < 0) {
+            start = next_free;
+            copy = sched_free_unit(&units, unit, start, NULL);
+        }
+        if (start > cycle) {
+            cycle = start;
+            slots = 0;
+        }
+        if (slots == width) {
+            cycle++;
+            slots = 0;
+        }
+        slots++;
+        sched_issue(graph, work, &units, node, copy, cycle);
+        if (cycle + sched_latency(graph, node) > finish) finish = cycle + sched_latency(graph, node);
+    }
+    return finish;
+}
+
+int sched_schedule(SchedGraph* graph, uint32_t* order, SchedStats* stats) {
+    size_t n = graph->num_nodes;
+    size_t m = graph->num_edges;
+    if (n < 2 || graph->out_of_memory) return 0;
+    if (!sched_grow((void**)&graph->work, &graph->work_capacity, 7 * n + 1 + m, sizeof(uint32_t))) {
+        graph->out_of_memory = 1;
+        return 0;
+    }
+    SchedWork work;
+    work.succ_start = graph->work;
+    work.succ = work.succ_start + n + 1;
+    work.preds = work.succ + m;
+    work.height = work.preds + n;
+    work.earliest = work.height + n;
+    work.ready = work.earliest + n;
+    uint32_t* candidate = work.ready + n; // n eleman
+
+    // Ardıl listeleri (kaynağa göre sayma sıralaması)
+    memset(work.succ_start, 0, sizeof(uint32_t) * (n + 1));
+    memset(work.preds, 0, sizeof(uint32_t) * n);
+    for (size_t e = 0; e < m; e++) {
+        work.succ_start[graph->edges[e].from + 1]++;
+        work.preds[graph->edges[e].to]++;
+    }
+    for (size_t i = 0; i < n; i++) work.succ_start[i + 1] += work.succ_start[i];
+    memcpy(work.height, work.succ_start, sizeof(uint32_t) * n); // Geçici yazma konumları
+    for (size_t e = 0; e < m; e++) work.succ[work.height[graph->edges[e].from]++] = (uint32_t)e;
+
+    // Öncelik: kritik yol uzunluğu (kenarlar ileri gittiği için geriye doğru tek tarama yeter)
+    for (size_t i = n; i > 0; i--) {
+        uint32_t node = (uint32_t)(i - 1);
+        uint32_t height = sched_latency(graph, node);
+        for (uint32_t s = work.succ_start[node]; s < work.succ_start[node + 1]; s++) {
+            const SchedEdge* edge = &graph->edges[work.succ[s]];
+            if (edge->latency + work.height[edge->to] > height) height = edge->latency + work.height[edge->to];
+        }
+        work.height[node] = height;
+    }
+
+    // Liste zamanlaması
+    const TargetPipelineModel* model = graph->model;
+    int width = model->issue_width > 0 ? model->issue_width : 1;
+    SchedUnits units;
+    sched_units_init(model, &units);
+    memset(work.earliest, 0, sizeof(uint32_t) * n);
+    size_t num_ready = 0, done = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (work.preds[i] == 0) work.ready[num_ready++] = (uint32_t)i;
+    }
+    for (uint32_t cycle = 0; done < n; cycle++) {
+        for (int issued = 0; issued < width; issued++) {
+            size_t best = SIZE_MAX;
+            int best_copy = -1;
+            for (size_t r = 0; r < num_ready; r++) {
+                uint32_t node = work.ready[r];
+                if (work.earliest[node] > cycle) continue;
+                int copy = sched_free_unit(&units, model->ops[graph->op_class[node]].unit, cycle, NULL);
+                if (copy < 0) continue;
+                if (best != SIZE_MAX) {
+                    uint32_t other = work.ready[best];
+                    if (work.height[node] < work.height[other]) continue;
+                    if (work.height[node] == work.height[other] && node > other) continue;
+                }
+                best = r;
+                best_copy = copy;
+            }
+            if (best == SIZE_MAX) break;
+            uint32_t node = work.ready[best];
+            work.ready[best] = work.ready[--num_ready];
+            candidate[done++] = node;
+            sched_issue(graph, &work, &units, node, best_copy, cycle);
+            for (uint32_t s = work.succ_start[node]; s < work.succ_start[node + 1]; s++) {
+                uint32_t to = graph->edges[work.succ[s]].to;
+                if (--work.preds[to] == 0) work.ready[num_ready++] = to;
+            }
+        }
+    }
+
+    int changed = 0;
+    for (size_t i = 0; i < n && !changed; i++) changed = candidate[i] != i;
+    if (!changed) return 0;
+    uint32_t before = sched_simulate(graph, &work, NULL);
+    uint32_t after = sched_simulate(graph, &work, candidate);
+    if (after >= before) return 0;
+    memcpy(order, candidate, sizeof(uint32_t) * n);
+    if (stats) {
+        stats->num_regions++;
+        stats->cycles_before += before;
+        stats->cycles_after += after;
+    }
+    return 1;
+}
+
+// --- IR İstemcisi ---
+
+// Bağımlılık kaynakları (bit maskesi): R0..R15, okunan bayrak değeri ve yan etki sırası
+#define SCHED_FLAGS_BIT (1u << IR_VREG_FLAGS)
+#define SCHED_EFFECT_BIT (1u << (IR_VREG_FLAGS + 1))
+
+typedef struct {
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t clobbers;      // Okunmayan tanımlar: sadece önceki okumalardan sonra yazılmalıdır
+} SchedAccess;
+
+/**
+ * @brief Bölgelerin dışında kalan komutlar: kaydedicilerin tümünü okuyup yazan CALL/SYSCALL,
+ * sayaçları yazan PROFDUMP ve sonlandırıcılar.
+ */
+static int sched_ir_is_barrier(IrOpcode opcode) {
+    return opcode == IR_OP_CALL || opcode == IR_OP_SYSCALL || opcode == IR_OP_PROFDUMP || ir_is_terminator(opcode);
+}
+
+static TargetOpClass sched_ir_class(IrOpcode opcode) {
+    switch (opcode) {
+        case IR_OP_MUL:
+            return TARGET_OP_MUL;
+        case IR_OP_DIV:
+            return TARGET_OP_DIV;
+        case IR_OP_PROFCNT:
+            return TARGET_OP_STORE;
+        default:
+            return TARGET_OP_ALU;
+    }
+}
+
+/**
+ * @brief Komutun okuduğu ve yazdığı köken kaydedicileri. Bayrak tanımı okunuyorsa (veya bloktan
+ * çıkıyorsa) yazma, okunmuyorsa bozmadır.
+ * @param uses Sanal kaydedici başına okuma sayısı.
+ * @return Tüm değerlerin kökeni biliniyorsa 1, aksi takdirde 0 (bölge sıralanmaz).
+ */
+static int sched_ir_access(const IrFunction* fn, const IrInstr* instr, const uint32_t* uses, SchedAccess* access) {
+    uint16_t operands[3];
+    memset(access, 0, sizeof(*access));
+    size_t n = ir_instr_uses(instr, operands);
+    for (size_t u = 0; u < n; u++) {
+        int origin = operands[u] < fn->num_vregs ? fn->vregs[operands[u]].origin : -1;
+        if (origin < 0 || origin > IR_VREG_FLAGS) return 0;
+        access->reads |= 1u << origin;
+    }
+    if (instr->dst != IR_NO_VREG) {
+        int origin = instr->dst < fn->num_vregs ? fn->vregs[instr->dst].origin : -1;
+        if (origin < 0 || origin >= IR_NUM_REGISTERS) return 0;
+        access->writes |= 1u << origin;
+    }
+    if (instr->flags != IR_NO_VREG && instr->opcode != IR_OP_SEL) {
+        if (instr->flags == IR_VREG_FLAGS || (instr->flags < fn->num_vregs && uses[instr->flags] > 0)) {
+            access->writes |= SCHED_FLAGS_BIT;
+        } else {
+            access->clobbers |= SCHED_FLAGS_BIT;
+        }
+    }
+    if (instr->opcode == IR_OP_DIV || instr->opcode == IR_OP_PROFCNT) access->writes |= SCHED_EFFECT_BIT;
+    return 1;
+}
+
+/**
+ * @brief [first, first + count) bölgesinin grafiğini kurar ve daha kısa bir sıra bulunursa
+ * komutları (ve kaynak konumlarını) yeniden yazar.
+ * @param scratch En az SCHED_MAX_REGION elemanlı çalışma dizileri.
+ * @return Bellek hatasında 0, aksi takdirde 1.
+ */
+static int sched_ir_region(IrFunction* fn, SchedGraph* graph, const SchedAccess* access, size_t first, size_t count,
+                           uint32_t* order, IrInstr* instrs, IrSourceLocation* locations, SchedStats* stats) {
+    sched_graph_clear(graph);
+    for (size_t k = 0; k < count; k++) sched_add_node(graph, sched_ir_class((IrOpcode)fn->instrs[first + k].opcode));
+
+    // Her kaynak için en yakın yazana kadar geriye bakılır: ondan öncekiler o yazana bağlıdır
+    for (size_t i = 1; i < count; i++) {
+        uint32_t raw = access[i].reads;
+        uint32_t waw = access[i].writes;
+        uint32_t war = access[i].writes | access[i].clobbers;
+        for (size_t j = i; j > 0 && (raw | waw | war); j--) {
+            const SchedAccess* earlier = &access[j - 1];
+            if (raw & earlier->writes) sched_add_edge(graph, (uint32_t)(j - 1), (uint32_t)i, SCHED_DEP_DATA);
+            if ((waw & (earlier->writes | earlier->clobbers)) || (war & earlier->reads)) {
+                sched_add_edge(graph, (uint32_t)(j - 1), (uint32_t)i, SCHED_DEP_ORDER);
+            }
+            raw &= ~earlier->writes;
+            waw &= ~earlier->writes;
+            war &= ~earlier->writes;
+        }
+    }
+    if (!sched_schedule(graph, order, stats)) return !graph->out_of_memory;
+
+    for (size_t k = 0; k < count; k++) {
+        instrs[k] = fn->instrs[first + order[k]];
+        if (fn->locations) locations[k] = fn->locations[first + order[k]];
+    }
+    memcpy(&fn->instrs[first], instrs, sizeof(IrInstr) * count);
+    if (fn->locations) memcpy(&fn->locations[first], locations, sizeof(IrSourceLocation) * count);
+    return 1;
+}
+
+int sched_ir_function(IrFunction* fn, const TargetPipelineModel* model, SchedStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!fn || fn->num_instrs == 0) return 1;
+    uint32_t* uses = (uint32_t*)calloc(fn->num_vregs ? fn->num_vregs : 1, sizeof(uint32_t));
+    SchedAccess* access = (SchedAccess*)malloc(sizeof(SchedAccess) * SCHED_MAX_REGION);
+    uint32_t* order = (uint32_t*)malloc(sizeof(uint32_t) * SCHED_MAX_REGION);
+    IrInstr* instrs = (IrInstr*)malloc(sizeof(IrInstr) * SCHED_MAX_REGION);
+    IrSourceLocation* locations = (IrSourceLocation*)malloc(sizeof(IrSourceLocation) * SCHED_MAX_REGION);
+    SchedGraph graph;
+    sched_graph_init(&graph, model);
+    int ok = uses && access && order && instrs && locations;
+
+    uint16_t operands[3];
+    for (size_t i = 0; ok && i < fn->num_instrs; i++) {
+        size_t n = ir_instr_uses(&fn->instrs[i], operands);
+        for (size_t u = 0; u < n; u++) {
+            if (operands[u] < fn->num_vregs) uses[operands[u]]++;
+        }
+    }
+
+    for (size_t b = 0; ok && b < fn->num_blocks; b++) {
+        const IrBlock* block = &fn->blocks[b];
+        if (block->num_instrs < 3) continue; // En az iki komut ve sonlandırıcı
+        size_t end = block->first + block->num_instrs - 1;
+        size_t i = block->first;
+        while (ok && i < end) {
+            if (sched_ir_is_barrier((IrOpcode)fn->instrs[i].opcode)) {
+                i++;
+                continue;
+            }
+            size_t count = 0;
+            int known = 1;
+            while (i + count < end && count < SCHED_MAX_REGION &&
+                   !sched_ir_is_barrier((IrOpcode)fn->instrs[i + count].opcode)) {
+                known = known && sched_ir_access(fn, &fn->instrs[i + count], uses, &access[count]);
+                count++;
+            }
+            if (known && count >= 2) {
+                ok = sched_ir_region(fn, &graph, access, i, count, order, instrs, locations, stats);
+            }
+            i += count;
+        }
+    }
+    if (!ok) fprintf(stderr, "Hata: Komut zamanlaması için bellek tahsis edilemedi.\n");
+
+    sched_graph_free(&graph);
+    free(uses);
+    free(access);
+    free(order);
+    free(instrs);
+    free(locations);
+    return ok;
+}
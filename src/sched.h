@@ -0,0 +1,116 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "ir_generator.h" // IrFunction (IR istemcisi)
+#include "os/target.h" // TargetPipelineModel, TargetOpClass
+#include <stdint.h> // uint8_t, uint32_t, uint64_t için
+#include <stddef.h> // size_t için
+
+// --- Liste Komut Zamanlayıcısı (List Scheduling) ---
+// Temel blok içindeki komutları bir bağımlılık DAG'ı üzerinden hedefin ardışık düzen modeline
+// (bkz. TargetPipelineModel) göre yeniden sıralar. Düğümler program sırasıyla eklenir; kenarlar
+// her zaman önceki düğümden sonrakine gider, yani asıl sıra geçerli bir topolojik sıradır. Veri
+// kenarının (RAW) gecikmesi üreten komutun sınıf gecikmesidir; sıra kenarları (WAR, WAW, bellek
+// ve yan etki sırası) sadece sırayı korur.
+//
+// Öncelik kritik yol uzunluğudur: düğümden DAG'ın sonuna kadar en uzun gecikme toplamı. Zamanlayıcı
+// çevrim çevrim ilerler; her çevrimde hazır (öncülleri başlamış, sonuçları ulaşmış) düğümlerden
+// önceliği en yüksek olanları başlatma genişliği ve işlev birimlerinin boşluğu elverdiği kadar
+// başlatır. Bulunan sıra sıralı bir çekirdeğin benzetimiyle asıl sırayla karşılaştırılır ve sadece
+// daha kısa sürüyorsa kullanılır; eşitlikte kod olduğu gibi kalır.
+//
+// İki istemci vardır: kaydedici atamasından önce IR bloklarını sıralayan sched_ir_function
+// (optimizer'ın "scheduling" geçişi) ve atamadan sonra bir bloğun makine komutlarını sıralayan
+// kod üreticiler (RISC-V; parçaların yüklemeleri ve yeniden üretilen sabitler öne alınabilir).
+
+#define SCHED_MAX_REGION 256    // Bir bölgedeki en fazla düğüm (daha uzun bloklar bölünür)
+
+// --- Bağımlılık Türleri ---
+typedef enum {
+    SCHED_DEP_DATA,             // Sonuç kullanılır: üreticinin gecikmesi kadar beklenir
+    SCHED_DEP_ORDER             // Sadece sıra korunur (aynı çevrimde, sonra başlatılabilir)
+} SchedDependency;
+
+typedef struct {
+    uint32_t from;
+    uint32_t to;                // from < to
+    uint8_t latency;
+} SchedEdge;
+
+// --- Bağımlılık Grafiği (bir bölge) ---
+typedef struct {
+    const TargetPipelineModel* model;
+    uint8_t* op_class;          // Düğüm başına TargetOpClass
+    size_t num_nodes;
+    size_t node_capacity;
+    SchedEdge* edges;
+    size_t num_edges;
+    size_t edge_capacity;
+    uint32_t* work;             // Zamanlama çalışma dizileri (düğüm başına birkaç eleman)
+    size_t work_capacity;
+    int out_of_memory;
+} SchedGraph;
+
+// --- İstatistikler ---
+typedef struct {
+    size_t num_regions;         // Yeniden sıralanan bölgeler
+    uint64_t cycles_before;     // Bu bölgelerin asıl sıradaki tahmini süresi (çevrim)
+    uint64_t cycles_after;      // Yeni sıradaki tahmini süre
+} SchedStats;
+
+// --- Fonksiyon Prototipleri: Grafik ---
+
+/**
+ * @brief Boş bir grafik başlatır.
+ * @param model Gecikme ve işlev birimi tabloları (grafikten uzun yaşamalı).
+ */
+void sched_graph_init(SchedGraph* graph, const TargetPipelineModel* model);
+
+/**
+ * @brief Düğümleri ve kenarları siler; diziler sonraki bölge için saklanır.
+ */
+void sched_graph_clear(SchedGraph* graph);
+
+/**
+ * @brief Grafiğin dizilerini serbest bırakır.
+ */
+void sched_graph_free(SchedGraph* graph);
+
+/**
+ * @brief Grafiğe program sırasındaki bir sonraki düğümü ekler.
+ * @return Düğümün indeksi (bellek hatasında graph->out_of_memory 1 yapılır).
+ */
+uint32_t sched_add_node(SchedGraph* graph, TargetOpClass op_class);
+
+/**
+ * @brief 'from' düğümünün 'to' düğümünden önce başlaması gerektiğini kaydeder.
+ * @param kind Veri bağımlılığında 'to', 'from'un gecikmesi kadar sonra başlayabilir.
+ */
+void sched_add_edge(SchedGraph* graph, uint32_t from, uint32_t to, SchedDependency kind);
+
+/**
+ * @brief Grafiği kritik yol öncelikli liste zamanlamasıyla sıralar.
+ * @param order Düğüm sayısı kadar elemanlı çıktı: yeni sıradaki düğüm indeksleri.
+ * @param stats Yeni sıra kullanılacaksa bölge ve çevrim sayıları eklenir (NULL olabilir).
+ * @return Yeni sıra asıl sıradan kısa sürüyorsa 1; aksi takdirde veya bellek hatasında 0 (order
+ * doldurulmaz; bellek hatası graph->out_of_memory ile bildirilir).
+ */
+int sched_schedule(SchedGraph* graph, uint32_t* order, SchedStats* stats);
+
+// --- Fonksiyon Prototipleri: IR İstemcisi ---
+
+/**
+ * @brief IR bloklarının komutlarını kaydedici atamasından önce sıralar. Bölgeler engeller (CALL,
+ * SYSCALL, PROFDUMP) arasındaki komutlardır; sonlandırıcı yerinde kalır. Bağımlılıklar komutların
+ * kaynak kaydedicileri (köken) üzerinden kurulur, çünkü kod üreticiler ve AST'ye geri dönüşüm
+ * değerleri köken kaydedicilerinde tutar. Okunmayan bayrak tanımları (örn: ADD'in yan ürünü)
+ * birbirleriyle serbestçe yer değiştirebilir ama okunan bir bayrak değerinin tanımıyla okuyucusu
+ * arasına giremez. DIV (sıfıra bölme hatası) ve PROFCNT kendi aralarında sırayı korur.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı; komut dizileri ödünç alınmamış olmalı).
+ * @param model Hedefin ardışık düzen modeli.
+ * @param stats Yeniden sıralanan bölgelerin istatistikleri (sıfırlanır).
+ * @return Başarılıysa 1, bellek hatasında 0 (stderr'e açıklama yazılır; sıralanmış bloklar geçerlidir).
+ */
+int sched_ir_function(IrFunction* fn, const TargetPipelineModel* model, SchedStats* stats);
+
+#endif // SCHED_H
@@ -0,0 +1,701 @@
+#include "superopt.h"
+#include <stdlib.h> // malloc, free, realloc, qsort, strtoll
+#include <stdio.h>  // FILE, fopen, fgets, fprintf
+#include <string.h> // memcmp, memcpy, strlen, strncmp
+#include <inttypes.h> // PRId64
+
+// --- Arama Sınırları ---
+#define SUPEROPT_MAX_REWRITE 3          // Aranan en uzun yerine koyma dizisi
+#define SUPEROPT_MAX_NODES 2000000L     // Bir kalıp için denenen en fazla aday (ara diziler dahil)
+#define SUPEROPT_MAX_CONSTANTS 16       // Adaylarda kullanılan en fazla sabit
+#define SUPEROPT_MAX_WINDOWS 64         // Bir derlemede aranan en fazla yeni kalıp
+#define SUPEROPT_HOT_PERCENT 10         // Profil varsa en sık çalışan komutun bu yüzdesi kadar çalışan diziler aranır
+#define SUPEROPT_QUICK_TESTS 8          // Her adayın önce denendiği sabit girdi sayısı
+#define SUPEROPT_RANDOM_TESTS 256       // Doğrulamadaki rastgele 64-bit girdi sayısı
+#define SUPEROPT_EXHAUSTIVE_BITS 16     // Tüm girdilerin denendiği toplam bit sayısı (değişkenlere bölünür)
+#define SUPEROPT_SEED 0x9E3779B97F4A7C15ULL
+#define SUPEROPT_LINE_MAX 512
+
+// --- Anlam (Semantics) ---
+
+/**
+ * @brief Bir diziyi değişken değerleri üzerinde çalıştırır. Değerler mask genişliğinde
+ * ikiye tümleyen aritmetiğiyle hesaplanır (mask = ~0: 64-bit).
+ */
+static void superopt_execute(const SuperoptInstr* code, size_t length, uint64_t* values, uint64_t mask) {
+    for (size_t i = 0; i < length; i++) {
+        uint64_t src = code[i].src_is_variable ? values[code[i].src] : (uint64_t)code[i].src;
+        uint64_t* dest = &values[code[i].dest];
+        switch (code[i].opcode) {
+            case TOKEN_MOV: *dest = src; break;
+            case TOKEN_ADD: *dest += src; break;
+            case TOKEN_SUB: *dest -= src; break;
+            case TOKEN_MUL: *dest *= src; break;
+            default: break;
+        }
+        *dest &= mask;
+    }
+}
+
+static uint64_t superopt_random(uint64_t* state) {
+    uint64_t x = *state; // xorshift64: aramalar ve doğrulamalar tekrarlanabilir olsun
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Rastgele bir girdi vektörü üretir; köşe değerleri ve küçük sayılar sıkça seçilir.
+ */
+static void superopt_random_inputs(uint64_t* values, int num_variables, uint64_t* state) {
+    static const uint64_t special[] = {0, 1, 2, UINT64_MAX, (uint64_t)INT64_MAX, (uint64_t)INT64_MAX + 1};
+    for (int v = 0; v < num_variables; v++) {
+        uint64_t r = superopt_random(state);
+        switch (r & 3) {
+            case 0: values[v] = special[(r >> 2) % (sizeof(special) / sizeof(special[0]))]; break;
+            case 1: values[v] = (r >> 2) % 17; break;
+            default: values[v] = superopt_random(state); break;
+        }
+    }
+}
+
+static int superopt_same_results(const SuperoptInstr* a, size_t a_length, const SuperoptInstr* b, size_t b_length,
+                                 const uint64_t* inputs, int num_variables, uint64_t mask) {
+    uint64_t x[SUPEROPT_MAX_VARIABLES], y[SUPEROPT_MAX_VARIABLES];
+    memcpy(x, inputs, sizeof(uint64_t) * (size_t)num_variables);
+    memcpy(y, inputs, sizeof(uint64_t) * (size_t)num_variables);
+    superopt_execute(a, a_length, x, mask);
+    superopt_execute(b, b_length, y, mask);
+    return memcmp(x, y, sizeof(uint64_t) * (size_t)num_variables) == 0;
+}
+
+/**
+ * @brief İki dizinin eşdeğerliğini denetler: rastgele 64-bit girdiler ve (exhaustive 1 ise)
+ * küçük bit genişliğinde tüm girdiler (toplam SUPEROPT_EXHAUSTIVE_BITS bit).
+ * @return Tüm denemelerde tüm değişkenler aynıysa 1.
+ */
+static int superopt_equivalent(const SuperoptInstr* a, size_t a_length, const SuperoptInstr* b, size_t b_length,
+                               int num_variables, int exhaustive) {
+    uint64_t inputs[SUPEROPT_MAX_VARIABLES];
+    uint64_t state = SUPEROPT_SEED;
+    for (int t = 0; t < SUPEROPT_RANDOM_TESTS; t++) {
+        superopt_random_inputs(inputs, num_variables, &state);
+        if (!superopt_same_results(a, a_length, b, b_length, inputs, num_variables, UINT64_MAX)) return 0;
+    }
+    if (!exhaustive) return 1;
+
+    int bits = SUPEROPT_EXHAUSTIVE_BITS / num_variables;
+    uint64_t mask = (1ULL << bits) - 1;
+    uint64_t total = 1ULL << (bits * num_variables);
+    for (uint64_t x = 0; x < total; x++) {
+        for (int v = 0; v < num_variables; v++) inputs[v] = (x >> (v * bits)) & mask;
+        if (!superopt_same_results(a, a_length, b, b_length, inputs, num_variables, mask)) return 0;
+    }
+    return 1;
+}
+
+// --- Kural Veritabanı ---
+
+static uint64_t superopt_hash(const SuperoptInstr* code, size_t length) {
+    uint64_t hash = 1469598103934665603ULL; // FNV-1a
+    for (size_t i = 0; i < length; i++) {
+        uint64_t fields[4] = {(uint64_t)code[i].opcode, (uint64_t)code[i].dest, (uint64_t)code[i].src_is_variable,
+                              (uint64_t)code[i].src};
+        for (int f = 0; f < 4; f++) hash = (hash ^ fields[f]) * 1099511628211ULL;
+    }
+    return (hash ^ length) * 1099511628211ULL;
+}
+
+static int superopt_same_code(const SuperoptInstr* a, const SuperoptInstr* b, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (a[i].opcode != b[i].opcode || a[i].dest != b[i].dest || a[i].src_is_variable != b[i].src_is_variable ||
+            a[i].src != b[i].src) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void superopt_index_insert(SuperoptRules* rules, size_t rule) {
+    const SuperoptRule* entry = &rules->rules[rule];
+    size_t slot = (size_t)superopt_hash(entry->pattern, entry->pattern_length) & (rules->index_size - 1);
+    while (rules->index[slot] >= 0) slot = (slot + 1) & (rules->index_size - 1);
+    rules->index[slot] = (int)rule;
+}
+
+/**
+ * @brief Özet tablosunu kural sayısının en az iki katı olacak şekilde yeniden oluşturur.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int superopt_rebuild_index(SuperoptRules* rules, size_t min_rules) {
+    size_t size = 64;
+    while (size < min_rules * 2) size *= 2;
+    int* index = (int*)malloc(sizeof(int) * size);
+    if (!index) return 0;
+    for (size_t i = 0; i < size; i++) index[i] = -1;
+    free(rules->index);
+    rules->index = index;
+    rules->index_size = size;
+    for (size_t r = 0; r < rules->num_rules; r++) superopt_index_insert(rules, r);
+    return 1;
+}
+
+SuperoptRules* superopt_rules_create(void) {
+    SuperoptRules* rules = (SuperoptRules*)calloc(1, sizeof(SuperoptRules));
+    if (!rules || !superopt_rebuild_index(rules, 0)) {
+        fprintf(stderr, "Hata: Kural veritabanı için bellek tahsis edilemedi.\n");
+        free(rules);
+        return NULL;
+    }
+    return rules;
+}
+
+void superopt_rules_free(SuperoptRules* rules) {
+    if (rules) {
+        free(rules->rules);
+        free(rules->index);
+        free(rules);
+    }
+}
+
+const SuperoptRule* superopt_rules_find(const SuperoptRules* rules, const SuperoptInstr* pattern, size_t length) {
+    if (!rules || !rules->index) return NULL;
+    size_t slot = (size_t)superopt_hash(pattern, length) & (rules->index_size - 1);
+    while (rules->index[slot] >= 0) {
+        const SuperoptRule* rule = &rules->rules[rules->index[slot]];
+        if (rule->pattern_length == length && superopt_same_code(rule->pattern, pattern, length)) return rule;
+        slot = (slot + 1) & (rules->index_size - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Veritabanına bir kayıt ekler; kalıbın kaydı zaten varsa değişiklik yapmaz.
+ * @return Başarılıysa 1, bellek hatasında 0.
+ */
+static int superopt_rules_add(SuperoptRules* rules, const SuperoptRule* rule) {
+    if (superopt_rules_find(rules, rule->pattern, rule->pattern_length)) return 1;
+    if (rules->num_rules >= rules->capacity) {
+        size_t new_capacity = rules->capacity ? rules->capacity * 2 : 32;
+        SuperoptRule* grown = (SuperoptRule*)realloc(rules->rules, sizeof(SuperoptRule) * new_capacity);
+        if (!grown) return 0;
+        rules->rules = grown;
+        rules->capacity = new_capacity;
+    }
+    rules->rules[rules->num_rules++] = *rule;
+    if (rules->num_rules * 2 > rules->index_size) {
+        if (!superopt_rebuild_index(rules, rules->num_rules)) {
+            rules->num_rules--;
+            return 0;
+        }
+    } else {
+        superopt_index_insert(rules, rules->num_rules - 1);
+    }
+    rules->modified = 1;
+    return 1;
+}
+
+// --- Metin Biçimi ---
+
+static const char* skip_spaces(const char* text) {
+    while (*text == ' ' || *text == '\t') text++;
+    return text;
+}
+
+/**
+ * @brief "%N" değişkenini okur.
+ * @return Okunan metnin sonu veya hatalıysa NULL.
+ */
+static const char* parse_variable(const char* text, int* variable) {
+    text = skip_spaces(text);
+    if (*text != '%' || text[1] < '0' || text[1] >= '0' + SUPEROPT_MAX_VARIABLES) return NULL;
+    *variable = text[1] - '0';
+    return text + 2;
+}
+
+/**
+ * @brief ';' ile ayrılmış komut dizisini okur (boş olabilir).
+ * @return Başarılıysa 1, hatalı metinde 0.
+ */
+static int parse_sequence(const char* text, SuperoptInstr* code, size_t* length) {
+    static const TokenType opcodes[] = {TOKEN_MOV, TOKEN_ADD, TOKEN_SUB, TOKEN_MUL};
+    *length = 0;
+    text = skip_spaces(text);
+    while (*text) {
+        if (*length >= SUPEROPT_MAX_PATTERN) return 0;
+        SuperoptInstr* instr = &code[(*length)++];
+        size_t word = 0;
+        while (text[word] >= 'A' && text[word] <= 'Z') word++;
+        instr->opcode = TOKEN_UNKNOWN;
+        for (size_t o = 0; o < sizeof(opcodes) / sizeof(opcodes[0]); o++) {
+            const char* name = token_type_to_string(opcodes[o]);
+            if (strlen(name) == word && strncmp(text, name, word) == 0) instr->opcode = opcodes[o];
+        }
+        if (instr->opcode == TOKEN_UNKNOWN || !(text = parse_variable(text + word, &instr->dest))) return 0;
+        text = skip_spaces(text);
+        if (*text++ != ',') return 0;
+        text = skip_spaces(text);
+        if (*text == '%') {
+            int variable;
+            if (!(text = parse_variable(text, &variable))) return 0;
+            instr->src_is_variable = 1;
+            instr->src = variable;
+        } else {
+            char* end = NULL;
+            instr->src_is_variable = 0;
+            instr->src = (int64_t)strtoll(text, &end, 10);
+            if (end == text) return 0;
+            text = end;
+        }
+        text = skip_spaces(text);
+        if (*text == ';') {
+            text = skip_spaces(text + 1);
+            if (!*text) return 0; // Sonda boş komut
+        } else if (*text) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void write_sequence(FILE* file, const SuperoptInstr* code, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        fprintf(file, "%s%s %%%d, ", i ? "; " : "", token_type_to_string(code[i].opcode), code[i].dest);
+        if (code[i].src_is_variable) {
+            fprintf(file, "%%%d", (int)code[i].src);
+        } else {
+            fprintf(file, "%" PRId64, code[i].src);
+        }
+    }
+}
+
+/**
+ * @brief Kalıbın kanonik olup olmadığını (değişkenler ilk görünüş sırasıyla 0, 1, ...) denetler.
+ * @return Değişken sayısı veya kanonik değilse -1.
+ */
+static int superopt_canonical_variables(const SuperoptInstr* code, size_t length) {
+    int num_variables = 0;
+    for (size_t i = 0; i < length; i++) {
+        int operands[2] = {code[i].dest, code[i].src_is_variable ? (int)code[i].src : -1};
+        for (int o = 0; o < 2; o++) {
+            if (operands[o] < 0) continue;
+            if (operands[o] > num_variables) return -1;
+            if (operands[o] == num_variables) num_variables++;
+        }
+    }
+    return num_variables;
+}
+
+/**
+ * @brief Bir satırı kayda çevirir ve doğrular.
+ * @return Geçerli kayıtsa 1, aksi takdirde 0.
+ */
+static int parse_rule_line(const char* line, SuperoptRule* rule) {
+    char pattern_text[SUPEROPT_LINE_MAX];
+    const char* arrow = strstr(line, "=>");
+    if (!arrow || (size_t)(arrow - line) >= sizeof(pattern_text)) return 0;
+    memcpy(pattern_text, line, (size_t)(arrow - line));
+    pattern_text[arrow - line] = '\0';
+    size_t trim = strlen(pattern_text);
+    while (trim > 0 && (pattern_text[trim - 1] == ' ' || pattern_text[trim - 1] == '\t')) pattern_text[--trim] = '\0';
+
+    const char* replacement_text = skip_spaces(arrow + 2);
+    if (!parse_sequence(pattern_text, rule->pattern, &rule->pattern_length) || rule->pattern_length == 0) return 0;
+    int num_variables = superopt_canonical_variables(rule->pattern, rule->pattern_length);
+    if (num_variables < 0) return 0;
+
+    if (*replacement_text == '!' && !*skip_spaces(replacement_text + 1)) {
+        rule->has_replacement = 0;
+        rule->replacement_length = 0;
+        return 1;
+    }
+    rule->has_replacement = 1;
+    if (!parse_sequence(replacement_text, rule->replacement, &rule->replacement_length) ||
+        rule->replacement_length >= rule->pattern_length) {
+        return 0;
+    }
+    for (size_t i = 0; i < rule->replacement_length; i++) {
+        if (rule->replacement[i].dest >= num_variables ||
+            (rule->replacement[i].src_is_variable && rule->replacement[i].src >= num_variables)) {
+            return 0; // Kalıpta olmayan bir kaydediciye yazılamaz
+        }
+    }
+    // Veritabanı elle düzenlenmiş veya bozulmuş olabilir: yanlış kural yanlış kod üretir
+    return superopt_equivalent(rule->pattern, rule->pattern_length, rule->replacement, rule->replacement_length,
+                               num_variables, 0);
+}
+
+SuperoptRules* superopt_rules_load(const char* path, int allow_missing) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        if (allow_missing) return superopt_rules_create();
+        fprintf(stderr, "Hata: '%s' kural veritabanı açılamadı.\n", path);
+        return NULL;
+    }
+
+    char line[SUPEROPT_LINE_MAX];
+    char header[32];
+    snprintf(header, sizeof(header), "%s %d", SUPEROPT_RULES_MAGIC, SUPEROPT_RULES_VERSION);
+    if (!fgets(line, sizeof(line), file) || strncmp(line, header, strlen(header)) != 0 ||
+        (line[strlen(header)] != '\n' && line[strlen(header)] != '\r' && line[strlen(header)] != '\0')) {
+        fprintf(stderr, "Hata: '%s' geçerli bir .bsmrules dosyası değil (beklenen başlık '%s').\n", path, header);
+        fclose(file);
+        return NULL;
+    }
+
+    SuperoptRules* rules = superopt_rules_create();
+    if (!rules) {
+        fclose(file);
+        return NULL;
+    }
+    int line_number = 1;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        const char* text = skip_spaces(line);
+        if (!*text || *text == '#') continue;
+        SuperoptRule rule;
+        if (!parse_rule_line(text, &rule)) {
+            fprintf(stderr, "Uyarı: '%s' satır %d: geçersiz kural atlandı.\n", path, line_number);
+            continue;
+        }
+        if (!superopt_rules_add(rules, &rule)) {
+            fprintf(stderr, "Hata: Kural veritabanı için bellek tahsis edilemedi.\n");
+            superopt_rules_free(rules);
+            fclose(file);
+            return NULL;
+        }
+    }
+    fclose(file);
+    rules->modified = 0;
+    return rules;
+}
+
+int superopt_rules_save(const char* path, const SuperoptRules* rules) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Hata: '%s' kural veritabanı yazmak için açılamadı.\n", path);
+        return 0;
+    }
+    fprintf(file, "%s %d\n", SUPEROPT_RULES_MAGIC, SUPEROPT_RULES_VERSION);
+    fprintf(file, "# Bessambly süperoptimizasyon kuralları: <kalıp> => <yerine> | !\n");
+    for (size_t r = 0; r < rules->num_rules; r++) {
+        const SuperoptRule* rule = &rules->rules[r];
+        write_sequence(file, rule->pattern, rule->pattern_length);
+        fprintf(file, " =>");
+        if (!rule->has_replacement) {
+            fprintf(file, " !");
+        } else if (rule->replacement_length > 0) {
+            fprintf(file, " ");
+            write_sequence(file, rule->replacement, rule->replacement_length);
+        }
+        fprintf(file, "\n");
+    }
+    int ok = !ferror(file);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Hata: '%s' kural veritabanına yazılamadı.\n", path);
+    }
+    return ok;
+}
+
+// --- Kanonik Kalıplar ---
+
+static int superopt_variable_of(int reg, int* variable_of, int* registers, int* num_variables) {
+    if (reg < 0 || reg >= 16) return -1;
+    if (variable_of[reg] < 0) {
+        if (*num_variables >= SUPEROPT_MAX_VARIABLES) return -1;
+        variable_of[reg] = *num_variables;
+        registers[(*num_variables)++] = reg;
+    }
+    return variable_of[reg];
+}
+
+int superopt_canonicalize(AstNode* const* statements, size_t first, size_t length, SuperoptInstr* pattern,
+                          int* registers) {
+    int variable_of[16];
+    int num_variables = 0;
+    if (length == 0 || length > SUPEROPT_MAX_PATTERN) return -1;
+    for (int r = 0; r < 16; r++) variable_of[r] = -1;
+
+    for (size_t i = 0; i < length; i++) {
+        const AstNode* node = statements[first + i];
+        if (node->type != AST_INSTRUCTION) return -1;
+        const AstInstruction* instr = &node->data.instruction;
+        if ((instr->opcode != TOKEN_MOV && instr->opcode != TOKEN_ADD && instr->opcode != TOKEN_SUB &&
+             instr->opcode != TOKEN_MUL) ||
+            instr->num_operands != 2 || instr->operands[0].type != OP_REGISTER) {
+            return -1;
+        }
+        pattern[i].opcode = instr->opcode;
+        pattern[i].dest = superopt_variable_of(instr->operands[0].value.reg_index, variable_of, registers,
+                                               &num_variables);
+        if (pattern[i].dest < 0) return -1;
+        if (instr->operands[1].type == OP_REGISTER) {
+            int variable = superopt_variable_of(instr->operands[1].value.reg_index, variable_of, registers,
+                                                &num_variables);
+            if (variable < 0) return -1;
+            pattern[i].src_is_variable = 1;
+            pattern[i].src = variable;
+        } else if (instr->operands[1].type == OP_INTEGER || instr->operands[1].type == OP_HEX_INTEGER) {
+            pattern[i].src_is_variable = 0;
+            pattern[i].src = instr->operands[1].value.int_value;
+        } else {
+            return -1;
+        }
+    }
+    return num_variables;
+}
+
+// --- Arama ---
+
+typedef struct {
+    const SuperoptInstr* pattern;
+    size_t length;
+    int num_variables;
+    SuperoptInstr* choices;     // Her adımda denenebilecek komutlar
+    size_t num_choices;
+    uint64_t inputs[SUPEROPT_QUICK_TESTS][SUPEROPT_MAX_VARIABLES];
+    uint64_t expected[SUPEROPT_QUICK_TESTS][SUPEROPT_MAX_VARIABLES];
+    SuperoptInstr candidate[SUPEROPT_MAX_REWRITE];
+    long nodes;                 // Denenen aday sayısı (sınır için)
+} SuperoptSearch;
+
+static size_t add_constant(int64_t* constants, size_t count, int64_t value) {
+    if (value < 0 || count >= SUPEROPT_MAX_CONSTANTS) return count; // Kaynakta negatif sabit yazılamaz
+    for (size_t i = 0; i < count; i++) {
+        if (constants[i] == value) return count;
+    }
+    constants[count] = value;
+    return count + 1;
+}
+
+/**
+ * @brief Adaylarda kullanılacak sabitleri seçer: 0, 1, 2, kalıbın (negatif olmayan) sabitleri
+ * ve bunların ikili toplam, fark ve çarpımları ile tümünün toplamı ve çarpımı (taşmayanlar).
+ */
+static size_t collect_constants(const SuperoptInstr* pattern, size_t length, int64_t* constants) {
+    int64_t seen[SUPEROPT_MAX_PATTERN];
+    size_t num_seen = 0, count = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (!pattern[i].src_is_variable && pattern[i].src >= 0) seen[num_seen++] = pattern[i].src;
+    }
+    count = add_constant(constants, count, 0);
+    count = add_constant(constants, count, 1);
+    count = add_constant(constants, count, 2);
+    for (size_t i = 0; i < num_seen; i++) count = add_constant(constants, count, seen[i]);
+
+    int64_t sum = 0, product = 1;
+    for (size_t i = 0; i < num_seen; i++) {
+        sum = (sum >= 0 && seen[i] <= INT64_MAX - sum) ? sum + seen[i] : -1;
+        product = (product >= 0 && (seen[i] == 0 || product <= INT64_MAX / seen[i])) ? product * seen[i] : -1;
+        for (size_t j = i + 1; j < num_seen; j++) {
+            if (seen[j] <= INT64_MAX - seen[i]) count = add_constant(constants, count, seen[i] + seen[j]);
+            count = add_constant(constants, count, seen[i] - seen[j]); // Negatif fark eklenmez
+            count = add_constant(constants, count, seen[j] - seen[i]);
+            if (seen[j] == 0 || seen[i] <= INT64_MAX / seen[j]) {
+                count = add_constant(constants, count, seen[i] * seen[j]);
+            }
+        }
+    }
+    count = add_constant(constants, count, sum); // Taşma durumunda -1 (eklenmez)
+    return add_constant(constants, count, product);
+}
+
+/**
+ * @brief Bir adımda denenebilecek komutları üretir; etkisiz (MOV a, a; ADD a, 0; MUL a, 1) ve
+ * başka bir adayla aynı olan (SUB a, a; MUL a, 0 = MOV a, 0) komutlar atlanır.
+ */
+static size_t build_choices(int num_variables, const int64_t* constants, size_t num_constants,
+                            SuperoptInstr* choices) {
+    static const TokenType opcodes[] = {TOKEN_MOV, TOKEN_ADD, TOKEN_SUB, TOKEN_MUL};
+    size_t count = 0;
+    for (size_t o = 0; o < sizeof(opcodes) / sizeof(opcodes[0]); o++) {
+        for (int d = 0; d < num_variables; d++) {
+            for (int s = 0; s < num_variables; s++) {
+                if (s == d && (opcodes[o] == TOKEN_MOV || opcodes[o] == TOKEN_SUB)) continue;
+                choices[count++] = (SuperoptInstr){opcodes[o], d, 1, s};
+            }
+            for (size_t c = 0; c < num_constants; c++) {
+                int64_t k = constants[c];
+                if ((opcodes[o] == TOKEN_ADD || opcodes[o] == TOKEN_SUB) && k == 0) continue;
+                if (opcodes[o] == TOKEN_MUL && (k == 0 || k == 1)) continue;
+                choices[count++] = (SuperoptInstr){opcodes[o], d, 0, k};
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief target_length uzunluğundaki adayları derinlik öncelikli sayar. Ara durumlar
+ * hızlı test girdileri için adım adım taşınır; tüm hızlı testleri geçen aday tam doğrulanır.
+ * @return Bulunduysa 1, bulunamadıysa 0, sınır aşıldıysa -1.
+ */
+static int superopt_enumerate(SuperoptSearch* search, size_t depth, size_t target_length,
+                              uint64_t (*state)[SUPEROPT_MAX_VARIABLES]) {
+    size_t bytes = sizeof(uint64_t) * (size_t)search->num_variables;
+    if (depth == target_length) {
+        for (int t = 0; t < SUPEROPT_QUICK_TESTS; t++) {
+            if (memcmp(state[t], search->expected[t], bytes) != 0) return 0;
+        }
+        return superopt_equivalent(search->pattern, search->length, search->candidate, target_length,
+                                   search->num_variables, 1);
+    }
+    uint64_t next[SUPEROPT_QUICK_TESTS][SUPEROPT_MAX_VARIABLES];
+    for (size_t c = 0; c < search->num_choices; c++) {
+        if (++search->nodes > SUPEROPT_MAX_NODES) return -1;
+        search->candidate[depth] = search->choices[c];
+        for (int t = 0; t < SUPEROPT_QUICK_TESTS; t++) {
+            memcpy(next[t], state[t], bytes);
+            superopt_execute(&search->choices[c], 1, next[t], UINT64_MAX);
+        }
+        int result = superopt_enumerate(search, depth + 1, target_length, next);
+        if (result != 0) return result;
+    }
+    return 0;
+}
+
+int superopt_search(const SuperoptInstr* pattern, size_t length, int num_variables, SuperoptRule* rule) {
+    memcpy(rule->pattern, pattern, sizeof(SuperoptInstr) * length);
+    rule->pattern_length = length;
+    rule->replacement_length = 0;
+    rule->has_replacement = 0;
+    if (num_variables <= 0 || num_variables > SUPEROPT_MAX_VARIABLES) return 0;
+
+    int64_t constants[SUPEROPT_MAX_CONSTANTS];
+    size_t num_constants = collect_constants(pattern, length, constants);
+    size_t max_choices = 4 * (size_t)num_variables * ((size_t)num_variables + num_constants);
+    SuperoptSearch search;
+    search.pattern = pattern;
+    search.length = length;
+    search.num_variables = num_variables;
+    search.choices = (SuperoptInstr*)malloc(sizeof(SuperoptInstr) * max_choices);
+    if (!search.choices) return 0;
+    search.num_choices = build_choices(num_variables, constants, num_constants, search.choices);
+    search.nodes = 0;
+
+    uint64_t state = SUPEROPT_SEED ^ superopt_hash(pattern, length);
+    for (int t = 0; t < SUPEROPT_QUICK_TESTS; t++) {
+        superopt_random_inputs(search.inputs[t], num_variables, &state);
+        memcpy(search.expected[t], search.inputs[t], sizeof(search.inputs[t]));
+        superopt_execute(pattern, length, search.expected[t], UINT64_MAX);
+    }
+
+    // Artan uzunlukta arama: bulunan ilk aday en kısadır
+    int found = 0;
+    for (size_t target = 0; target < length && target <= SUPEROPT_MAX_REWRITE && found == 0; target++) {
+        uint64_t start[SUPEROPT_QUICK_TESTS][SUPEROPT_MAX_VARIABLES];
+        memcpy(start, search.inputs, sizeof(start));
+        found = superopt_enumerate(&search, 0, target, start);
+        if (found == 1) {
+            memcpy(rule->replacement, search.candidate, sizeof(SuperoptInstr) * target);
+            rule->replacement_length = target;
+            rule->has_replacement = 1;
+        }
+    }
+    free(search.choices);
+    return found == 1;
+}
+
+// Aranacak pencere
+typedef struct {
+    size_t first;
+    size_t length;
+    uint64_t weight;        // İlk komutun profil sayımı (yoksa 0)
+} SuperoptWindow;
+
+static int compare_windows(const void* a, const void* b) {
+    const SuperoptWindow* x = (const SuperoptWindow*)a;
+    const SuperoptWindow* y = (const SuperoptWindow*)b;
+    if (x->weight != y->weight) return x->weight > y->weight ? -1 : 1;
+    if (x->length != y->length) return x->length < y->length ? -1 : 1; // Kısa kalıplar daha genel
+    return x->first < y->first ? -1 : (x->first > y->first); // Deterministik sıra
+}
+
+/**
+ * @brief Pencerenin daha kısa bir alt penceresi için kural var mı? Varsa gözetleme deliği onu
+ * uygular; uzun pencere için ayrıca arama yapmak sadece aynı kuralın bir kopyasını üretir.
+ */
+static int superopt_has_shorter_rule(AstNode* const* statements, size_t first, size_t length,
+                                     const SuperoptRules* rules) {
+    SuperoptInstr pattern[SUPEROPT_MAX_PATTERN];
+    int registers[SUPEROPT_MAX_VARIABLES];
+    for (size_t sub_length = 1; sub_length < length; sub_length++) {
+        for (size_t start = first; start + sub_length <= first + length; start++) {
+            if (superopt_canonicalize(statements, start, sub_length, pattern, registers) < 0) continue;
+            const SuperoptRule* rule = superopt_rules_find(rules, pattern, sub_length);
+            if (rule && rule->has_replacement) return 1;
+        }
+    }
+    return 0;
+}
+
+int superopt_search_program(AstNode* program, SuperoptRules* rules) {
+    if (!program || program->type != AST_PROGRAM || !rules) return 0;
+    AstNode** statements = program->data.program.statements;
+    size_t n = program->data.program.num_statements;
+
+    uint64_t max_count = 0;
+    int has_profile = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (statements[i]->type == AST_INSTRUCTION && statements[i]->data.instruction.has_profile) {
+            has_profile = 1;
+            if (statements[i]->data.instruction.profile_count > max_count) {
+                max_count = statements[i]->data.instruction.profile_count;
+            }
+        }
+    }
+
+    SuperoptWindow* windows = (SuperoptWindow*)malloc(sizeof(SuperoptWindow) * (n * SUPEROPT_MAX_PATTERN + 1));
+    if (!windows) {
+        fprintf(stderr, "Hata: Süperoptimizasyon için bellek tahsis edilemedi.\n");
+        return -1;
+    }
+    size_t num_windows = 0;
+    SuperoptInstr pattern[SUPEROPT_MAX_PATTERN];
+    int registers[SUPEROPT_MAX_VARIABLES];
+    for (size_t i = 0; i < n; i++) {
+        if (statements[i]->type != AST_INSTRUCTION) continue;
+        const AstInstruction* head = &statements[i]->data.instruction;
+        uint64_t weight = head->has_profile ? head->profile_count : 0;
+        if (has_profile && (weight == 0 || weight * 100 < max_count * SUPEROPT_HOT_PERCENT)) continue; // Soğuk
+        for (size_t length = SUPEROPT_MIN_WINDOW; length <= SUPEROPT_MAX_PATTERN && i + length <= n; length++) {
+            if (superopt_canonicalize(statements, i, length, pattern, registers) < 0) break; // Uzunlar da olmaz
+            if (superopt_rules_find(rules, pattern, length)) continue;
+            windows[num_windows++] = (SuperoptWindow){i, length, weight};
+        }
+    }
+    qsort(windows, num_windows, sizeof(SuperoptWindow), compare_windows);
+
+    int found = 0, searched = 0;
+    for (size_t w = 0; w < num_windows && searched < SUPEROPT_MAX_WINDOWS; w++) {
+        int num_variables = superopt_canonicalize(statements, windows[w].first, windows[w].length, pattern, registers);
+        if (superopt_rules_find(rules, pattern, windows[w].length) || // Aynı kalıp bu derlemede arandı
+            superopt_has_shorter_rule(statements, windows[w].first, windows[w].length, rules)) {
+            continue;
+        }
+        SuperoptRule rule;
+        searched++;
+        if (superopt_search(pattern, windows[w].length, num_variables, &rule)) {
+            found++;
+            fprintf(stdout, "Süperoptimizasyon: ");
+            write_sequence(stdout, rule.pattern, rule.pattern_length);
+            fprintf(stdout, " => ");
+            write_sequence(stdout, rule.replacement, rule.replacement_length);
+            fprintf(stdout, "\n");
+        }
+        if (!superopt_rules_add(rules, &rule)) {
+            fprintf(stderr, "Hata: Kural veritabanı için bellek tahsis edilemedi.\n");
+            free(windows);
+            return -1;
+        }
+    }
+    if (num_windows > 0) {
+        fprintf(stdout, "Süperoptimizasyon: %d dizi arandı, %d yeni kural bulundu.\n", searched, found);
+    }
+    free(windows);
+    return found;
+}
@@ -0,0 +1,135 @@
+#ifndef SUPEROPT_H
+#define SUPEROPT_H
+
+#include "ast.h" // AST düğüm yapılarına erişim
+#include <stdint.h> // int64_t, uint64_t için
+#include <stddef.h> // size_t için
+
+// --- Süperoptimizasyon ve Kural Veritabanı ---
+// Sıcak, düz (dallanmasız) MOV/ADD/SUB/MUL dizileri için daha kısa eşdeğer diziler aranır.
+// Aday diziler komut kümesi üzerinde artan uzunlukta sayılır; birkaç sabit test vektörünü
+// geçen aday rastgele 64-bit girdilerle ve küçük bit genişliklerinde tüm girdilerle
+// denenerek doğrulanır. Bulunan kurallar disk üzerindeki veritabanına yazılır; gözetleme
+// deliği (peephole) geçişi veritabanını başlangıçta yükler. Böylece pahalı arama bir kez
+// yapılır, sonraki tüm derlemeler kuralları kullanır.
+//
+// Kurallar bağlamdan bağımsızdır: kaydediciler %0..%3 değişkenlerine (ilk görünüş sırasıyla)
+// eşlenir ve bir kural tüm değişkenlerin son değerlerini korur. Bayraklar korunmaz;
+// kural sadece bayrakların dizinin sonunda canlı olmadığı yerlerde uygulanabilir.
+
+// --- .bsmrules Dosya Biçimi (metin) ---
+//  İlk satır: "BSMRULES 1"
+//  '#' ile başlayan satırlar ve boş satırlar yoksayılır.
+//  Her satır bir kayıttır: "<kalıp> => <yerine>"
+//    Komutlar ';' ile ayrılır; operandlar %N (değişken) veya ondalık tamsayıdır.
+//    Örn: "MUL %0, 2; MUL %0, 2; ADD %1, %0 => MUL %0, 4; ADD %1, %0"
+//    Boş <yerine>: dizinin hiçbir etkisi yoktur.
+//    "!": arama sınırları içinde daha kısa eşdeğer bulunamadı (dizi tekrar aranmaz).
+#define SUPEROPT_RULES_MAGIC "BSMRULES"
+#define SUPEROPT_RULES_VERSION 1
+
+#define SUPEROPT_MAX_PATTERN 6      // Kalıptaki en fazla komut
+#define SUPEROPT_MIN_WINDOW 3       // Aranan en kısa dizi
+#define SUPEROPT_MAX_VARIABLES 4    // Bir kalıptaki en fazla farklı kaydedici
+
+// --- Kural Komutu ---
+// Sadece "OP Rd, Rs" ve "OP Rd, sabit" biçimindeki MOV, ADD, SUB, MUL komutları modellenir.
+typedef struct {
+    TokenType opcode;       // TOKEN_MOV, TOKEN_ADD, TOKEN_SUB veya TOKEN_MUL
+    int dest;               // Hedef değişkeni
+    int src_is_variable;    // 1: kaynak bir değişken, 0: sabit
+    int64_t src;            // Kaynak değişkeninin indeksi veya sabit değer
+} SuperoptInstr;
+
+// --- Kural ---
+typedef struct {
+    SuperoptInstr pattern[SUPEROPT_MAX_PATTERN];
+    size_t pattern_length;
+    SuperoptInstr replacement[SUPEROPT_MAX_PATTERN];
+    size_t replacement_length;
+    int has_replacement;    // 0 ise "!" kaydı (daha kısa eşdeğer bulunamadı)
+} SuperoptRule;
+
+// --- Kural Veritabanı ---
+typedef struct {
+    SuperoptRule* rules;
+    size_t num_rules;
+    size_t capacity;
+    int* index;             // Kalıba göre açık adresli özet tablosu (kural indeksi, -1 = boş)
+    size_t index_size;      // Özet tablosunun boyutu (2'nin kuvveti)
+    int modified;           // Yüklemeden sonra yeni kayıt eklendiyse 1
+} SuperoptRules;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Boş bir kural veritabanı oluşturur.
+ * @return Yeni SuperoptRules pointer'ı veya NULL hata durumunda.
+ */
+SuperoptRules* superopt_rules_create(void);
+
+/**
+ * @brief Bir .bsmrules dosyasını okur. Her kural yüklenirken rastgele girdilerle yeniden
+ * doğrulanır; bozuk veya eşdeğer olmayan kurallar uyarıyla atlanır.
+ * @param path Dosya yolu.
+ * @param allow_missing 1 ise dosya yoksa boş veritabanı döner (ilk arama için).
+ * @return Okunan SuperoptRules pointer'ı veya NULL hata durumunda.
+ */
+SuperoptRules* superopt_rules_load(const char* path, int allow_missing);
+
+/**
+ * @brief Kural veritabanını .bsmrules biçiminde diske yazar.
+ * @param path Dosya yolu.
+ * @param rules Yazılacak veritabanı.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int superopt_rules_save(const char* path, const SuperoptRules* rules);
+
+/**
+ * @brief Kural veritabanını serbest bırakır.
+ * @param rules Serbest bırakılacak SuperoptRules pointer'ı.
+ */
+void superopt_rules_free(SuperoptRules* rules);
+
+/**
+ * @brief Bir kalıbın kaydını arar.
+ * @param rules Kural veritabanı.
+ * @param pattern Kanonik kalıp (superopt_canonicalize çıktısı).
+ * @param length Kalıptaki komut sayısı.
+ * @return Kayıt (kural veya "!" kaydı) veya bulunamazsa NULL.
+ */
+const SuperoptRule* superopt_rules_find(const SuperoptRules* rules, const SuperoptInstr* pattern, size_t length);
+
+/**
+ * @brief Program ifadelerinden bir pencereyi kanonik kalıba çevirir.
+ * Kaydediciler ilk görünüş sırasıyla %0, %1, ... değişkenlerine eşlenir.
+ * @param statements Program ifadeleri.
+ * @param first Pencerenin ilk ifadesi.
+ * @param length Penceredeki ifade sayısı (en fazla SUPEROPT_MAX_PATTERN).
+ * @param pattern Çıktı kalıbı.
+ * @param registers Çıktı: değişken indeksinden kaydedici indeksine eşleme.
+ * @return Değişken sayısı veya pencere modellenemiyorsa (etiket, başka komut, çok fazla kaydedici) -1.
+ */
+int superopt_canonicalize(AstNode* const* statements, size_t first, size_t length, SuperoptInstr* pattern,
+                          int* registers);
+
+/**
+ * @brief Bir kalıp için daha kısa eşdeğer dizi arar.
+ * @param pattern Kanonik kalıp.
+ * @param length Kalıptaki komut sayısı.
+ * @param num_variables Kalıptaki değişken sayısı.
+ * @param rule Çıktı kaydı (bulunamazsa has_replacement = 0).
+ * @return Daha kısa eşdeğer bulunduysa 1, bulunamadıysa 0.
+ */
+int superopt_search(const SuperoptInstr* pattern, size_t length, int num_variables, SuperoptRule* rule);
+
+/**
+ * @brief Programdaki sıcak düz dizileri (profil yoksa tümünü) arar ve sonuçları veritabanına ekler.
+ * Veritabanında kaydı olan kalıplar tekrar aranmaz.
+ * @param program Aranacak program.
+ * @param rules Sonuçların ekleneceği veritabanı.
+ * @return Bulunan yeni kural sayısı veya bellek hatasında -1.
+ */
+int superopt_search_program(AstNode* program, SuperoptRules* rules);
+
+#endif // SUPEROPT_H
@@ -0,0 +1,154 @@
+#include "tiered.h"
+#include <stdio.h>  // fprintf
+#include <stdlib.h> // calloc, malloc, free
+#include <string.h> // strcmp, memcpy
+
+// --- Derleme ---
+
+/**
+ * @brief Arka plan iş parçacığı: programı derler ve sonucu yayımlar. IR sadece okunur; yorumlayıcı
+ * bayt kodunu kullandığı için paylaşılan yazılabilir durum yoktur.
+ */
+static void* tiered_compile_worker(void* argument) {
+    TieredEngine* engine = (TieredEngine*)argument;
+    engine->jit = jit_compile(engine->fn);
+    atomic_store_explicit(&engine->compile_state, engine->jit ? TIERED_COMPILE_READY : TIERED_COMPILE_FAILED,
+                          memory_order_release);
+    return NULL;
+}
+
+static void tiered_start_compile(TieredEngine* engine) {
+    atomic_store_explicit(&engine->compile_state, TIERED_COMPILE_RUNNING, memory_order_relaxed);
+    if (pthread_create(&engine->worker, NULL, tiered_compile_worker, engine) == 0) {
+        engine->worker_started = 1;
+        return;
+    }
+    fprintf(stderr, "Uyarı: JIT derleme iş parçacığı başlatılamadı; program yürütme içinde derleniyor.\n");
+    tiered_compile_worker(engine);
+}
+
+// --- Döngü Kancası ---
+
+static const TieredLoopHeader* tiered_find_header(const TieredEngine* engine, uint32_t offset) {
+    size_t low = 0, high = engine->num_headers;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (engine->headers[middle].offset < offset) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < engine->num_headers && engine->headers[low].offset == offset ? &engine->headers[low] : NULL;
+}
+
+static BvmLoopAction tiered_loop_hook(Bvm* vm, uint32_t header_offset, uint64_t count, void* user) {
+    (void)vm;
+    TieredEngine* engine = (TieredEngine*)user;
+    const TieredLoopHeader* header = tiered_find_header(engine, header_offset);
+    if (!header) return BVM_LOOP_STOP_COUNTING; // Etiketsiz döngü başına geçilemez
+    int state = atomic_load_explicit(&engine->compile_state, memory_order_acquire);
+    if (state == TIERED_COMPILE_IDLE) {
+        tiered_start_compile(engine);
+        state = atomic_load_explicit(&engine->compile_state, memory_order_acquire);
+    }
+    if (state == TIERED_COMPILE_FAILED) return BVM_LOOP_STOP_COUNTING;
+    if (state != TIERED_COMPILE_READY) return BVM_LOOP_CONTINUE;
+    engine->osr_header = header;
+    engine->osr_count = count;
+    return BVM_LOOP_TRANSFER;
+}
+
+// --- Oluşturma ve Yürütme ---
+
+/**
+ * @brief Etiketli blokların bayt kodu konumlarını toplar. vbsm_emit_program etiketleri yerleşim
+ * sırasıyla yazdığı için .vbsm etiket indeksi aynı sırayla yürünür (adlar ayrıca karşılaştırılır).
+ */
+static int tiered_collect_headers(TieredEngine* engine, const VbsmModule* module) {
+    const IrFunction* fn = engine->fn;
+    engine->headers = (TieredLoopHeader*)malloc(sizeof(TieredLoopHeader) * (module->num_labels + 1));
+    if (!engine->headers) {
+        fprintf(stderr, "Hata: katmanlı yürütme için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    size_t cursor = 0;
+    for (size_t l = 0; l < fn->num_layout; l++) {
+        uint32_t b = fn->layout[l];
+        const IrBlock* block = &fn->blocks[b];
+        for (uint32_t k = 0; k < block->num_labels && cursor < module->num_labels; k++) {
+            uint32_t label = block->first_label + k;
+            const VbsmLabel* entry = &module->labels[cursor];
+            if (strcmp(module->strings + entry->name, ir_label_name(fn, &fn->labels[label])) != 0) continue;
+            TieredLoopHeader* header = &engine->headers[engine->num_headers++];
+            header->offset = entry->offset;
+            header->block = b;
+            header->label = label;
+            cursor++;
+        }
+    }
+    return 1;
+}
+
+TieredEngine* tiered_create(const IrFunction* fn, const VbsmModule* module, uint64_t osr_threshold) {
+    TieredEngine* engine = (TieredEngine*)calloc(1, sizeof(TieredEngine));
+    if (!engine) {
+        fprintf(stderr, "Hata: katmanlı yürütme için bellek tahsis edilemedi.\n");
+        return NULL;
+    }
+    engine->fn = fn;
+    engine->osr_threshold = osr_threshold ? osr_threshold : TIERED_DEFAULT_OSR_THRESHOLD;
+    atomic_init(&engine->compile_state, TIERED_COMPILE_IDLE);
+    engine->vm = bvm_create(module, NULL);
+    if (!engine->vm || !tiered_collect_headers(engine, module)) {
+        tiered_free(engine);
+        return NULL;
+    }
+    if (!jit_is_supported()) {
+        fprintf(stderr, "Uyarı: JIT bu platformda desteklenmiyor; program sadece BVM'de yorumlanacak.\n");
+        return engine;
+    }
+    if (!bvm_enable_loop_counting(engine->vm, engine->osr_threshold, tiered_loop_hook, engine)) {
+        tiered_free(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+int tiered_run(TieredEngine* engine) {
+    Bvm* vm = engine->vm;
+    BvmStatus status = bvm_run(vm);
+    if (status == BVM_STATUS_HALTED) {
+        engine->exit_code = vm->exit_code;
+        return 1;
+    }
+    if (status != BVM_STATUS_SUSPENDED) return 0;
+
+    // Yerinde geçiş: yorumlayıcının durumu makine koduna taşınır
+    JitProgram* jit = engine->jit;
+    memcpy(jit->context.registers, vm->registers, sizeof(jit->context.registers));
+    jit->profile_dump = vm->profile_dump; // PGO sayaçları makine kodunda sayılmaya devam eder
+    jit->profile_user = vm->profile_user;
+    size_t num_counters = vm->num_counters < jit->num_counters ? vm->num_counters : jit->num_counters;
+    if (num_counters > 0) memcpy(jit->context.counters, vm->counters, sizeof(uint64_t) * num_counters);
+    uint32_t* sites = (uint32_t*)malloc(sizeof(uint32_t) * (vm->call_depth + 1));
+    if (!sites) {
+        fprintf(stderr, "Hata: katmanlı yürütme için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    int ok = bvm_call_sites(vm, sites);
+    engine->osr_depth = vm->call_depth;
+    if (ok) ok = jit_enter(jit, engine->osr_header->block, sites, vm->call_depth, vm->flags) == JIT_STATUS_HALTED;
+    free(sites);
+    if (ok) engine->exit_code = jit->exit_code;
+    return ok;
+}
+
+void tiered_free(TieredEngine* engine) {
+    if (!engine) return;
+    if (engine->worker_started) pthread_join(engine->worker, NULL);
+    jit_free(engine->jit);
+    bvm_free(engine->vm);
+    free(engine->headers);
+    free(engine);
+}
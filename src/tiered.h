@@ -0,0 +1,89 @@
+#ifndef TIERED_H
+#define TIERED_H
+
+#include "ir_generator.h" // IrFunction (JIT'in girdisi)
+#include "vbsm.h" // VbsmModule (yorumlayıcının girdisi)
+#include "bvm.h" // Bvm
+#include "jit.h" // JitProgram
+#include <stdint.h> // uint32_t, uint64_t, int64_t için
+#include <stddef.h> // size_t için
+#include <stdatomic.h> // atomic_int
+#include <pthread.h> // pthread_t
+
+// --- Katmanlı Yürütme (BVM -> JIT) ---
+// Program hızlı başlamak için BVM'de yorumlanarak başlar. BVM döngü başlarını sayar (bkz.
+// bvm_enable_loop_counting); bir döngü eşiği geçince program arka planda bir iş parçacığında JIT
+// ile derlenir, yorumlayıcı bu sırada durmadan devam eder. Derleme bittikten sonra sıcak döngünün
+// başına ilk girişte yürütme makine koduna geçer (yerinde geçiş, OSR): R0-R15, bayraklar ve çağrı
+// yığını taşınır ve program sonuna kadar makine kodunda çalışır.
+//
+// Derleme birimi programın tamamıdır: döngü gövdesi alt programları çağırabilir ve herhangi bir
+// yere çıkabilir. Geçiş noktaları etiketli döngü başlarıdır; bayt kodundaki konum, .vbsm etiket
+// indeksi üzerinden IR bloğuna eşlenir. Çağrı çerçeveleri CALL komutlarının sıra numarasıyla
+// eşlenir (bayt kodu ve makine kodu aynı IR yerleşim sırasından üretilir).
+//
+// PGO sayaçları ve PROFDUMP geri çağrısı (vm->profile_dump) geçişte makine koduna taşınır; geçiş
+// yapıldıysa son sayımlar jit->context.counters'tadır.
+
+#define TIERED_DEFAULT_OSR_THRESHOLD 1000 // Derlemeyi başlatan döngü başı giriş sayısı
+
+// --- Derleme Durumu ---
+typedef enum {
+    TIERED_COMPILE_IDLE,    // Henüz sıcak döngü yok
+    TIERED_COMPILE_RUNNING, // Arka planda derleniyor
+    TIERED_COMPILE_READY,   // TieredEngine.jit hazır
+    TIERED_COMPILE_FAILED   // Derlenemedi (program yorumlanarak biter)
+} TieredCompileState;
+
+// --- Etiketli Döngü Başı Adayı ---
+typedef struct {
+    uint32_t offset;        // Bayt kodundaki konum
+    uint32_t block;         // IR bloğu
+    uint32_t label;         // IrFunction.labels indeksi (mesajlar için)
+} TieredLoopHeader;
+
+// --- Katmanlı Yürütücü ---
+typedef struct TieredEngine {
+    const IrFunction* fn;           // Derlenecek IR (TieredEngine serbest bırakılana kadar geçerli kalmalı)
+    Bvm* vm;
+    JitProgram* jit;                // Derleme bitince yayımlanır (bkz. compile_state)
+    TieredLoopHeader* headers;      // Konuma göre sıralı
+    size_t num_headers;
+    uint64_t osr_threshold;
+
+    atomic_int compile_state;       // TieredCompileState
+    int worker_started;             // Arka plan iş parçacığı başlatıldıysa 1
+    pthread_t worker;
+
+    const TieredLoopHeader* osr_header; // Geçişin yapıldığı döngü başı (geçiş yoksa NULL)
+    uint64_t osr_count;             // Geçiş anında döngü başına giriş sayısı
+    size_t osr_depth;               // Geçiş anında çağrı derinliği
+    int64_t exit_code;
+} TieredEngine;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Katmanlı yürütücü oluşturur. JIT bu platformda desteklenmiyorsa program sadece
+ * yorumlanır (uyarı yazılır).
+ * @param fn Programın IR'si (ir_verify ile doğrulanmış olmalı).
+ * @param module fn'den vbsm_emit_program ile üretilmiş bayt kodu.
+ * @param osr_threshold Derlemeyi başlatan döngü başı giriş sayısı (0 ise varsayılan).
+ * @return Yeni TieredEngine pointer'ı veya NULL hata durumunda.
+ */
+TieredEngine* tiered_create(const IrFunction* fn, const VbsmModule* module, uint64_t osr_threshold);
+
+/**
+ * @brief Programı yürütür (önce BVM, sıcak döngüde makine kodu).
+ * @param engine Katmanlı yürütücü.
+ * @return Program sona erdiyse 1 (engine->exit_code geçerli), yürütme hatasında 0.
+ */
+int tiered_run(TieredEngine* engine);
+
+/**
+ * @brief Yürütücüyü serbest bırakır; süren bir derleme varsa bitmesini bekler.
+ * @param engine Serbest bırakılacak TieredEngine pointer'ı.
+ */
+void tiered_free(TieredEngine* engine);
+
+#endif // TIERED_H
@@ -0,0 +1,580 @@
+#include "vbsm.h"
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // FILE, fopen, fwrite, fprintf
+#include <string.h> // memcpy, memcmp, memset, strlen, strcmp
+
+#define VBSM_EXTENSION ".vbsm"
+
+// --- Bayt Arabelleği ---
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int failed;
+} VbsmBuffer;
+
+static void vbsm_put(VbsmBuffer* buffer, const void* bytes, size_t size) {
+    if (buffer->failed || size == 0) return;
+    if (buffer->size + size > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity : 256;
+        while (new_capacity < buffer->size + size) new_capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, new_capacity);
+        if (!data) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = new_capacity;
+    }
+    if (bytes) memcpy(buffer->data + buffer->size, bytes, size);
+    else memset(buffer->data + buffer->size, 0, size);
+    buffer->size += size;
+}
+
+static void vbsm_put_byte(VbsmBuffer* buffer, uint8_t value) {
+    vbsm_put(buffer, &value, 1);
+}
+
+static void vbsm_put_uint(VbsmBuffer* buffer, uint64_t value, size_t width) {
+    uint8_t bytes[8];
+    for (size_t i = 0; i < width; i++) bytes[i] = (uint8_t)(value >> (8 * i));
+    vbsm_put(buffer, bytes, width);
+}
+
+static void vbsm_put_uleb(VbsmBuffer* buffer, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) byte |= 0x80;
+        vbsm_put_byte(buffer, byte);
+    } while (value);
+}
+
+static size_t vbsm_sleb_size(int64_t value) {
+    size_t size = 1;
+    while (value < -64 || value > 63) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+/**
+ * @brief Değeri tam olarak 'size' baytlık SLEB128 olarak yazar; en kısa kodlamadan uzunsa
+ * işaret genişletmesiyle doldurulur (gevşetmeden sonra küçülen dal uzaklıkları için).
+ */
+static void vbsm_put_sleb(VbsmBuffer* buffer, int64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = (uint8_t)(value & 0x7f);
+        value >>= 7;
+        if (i + 1 < size) byte |= 0x80;
+        vbsm_put_byte(buffer, byte);
+    }
+}
+
+// --- Yardımcı Fonksiyonlar ---
+
+static const char* const vbsm_opcode_names[VBSM_OP_COUNT] = {
+    "HALT",
+    "MOV_R", "MOV_I", "MOV_K",
+    "ADD_R", "ADD_I", "ADD_K",
+    "SUB_R", "SUB_I", "SUB_K",
+    "MUL_R", "MUL_I", "MUL_K",
+    "DIV_R", "DIV_I", "DIV_K",
+    "CMP_R", "CMP_I", "CMP_K",
+    "SELEQ_R", "SELEQ_I", "SELEQ_K",
+    "SELNE_R", "SELNE_I", "SELNE_K",
+    "SELLT_R", "SELLT_I", "SELLT_K",
+    "SELGT_R", "SELGT_I", "SELGT_K",
+    "SELLE_R", "SELLE_I", "SELLE_K",
+    "SELGE_R", "SELGE_I", "SELGE_K",
+    "JMP",
+    "JEQ", "JNE", "JLT", "JGT", "JLE", "JGE",
+    "CALL",
+    "RET",
+    "JTAB",
+    "SYSCALL",
+    "PROFCNT",
+    "PROFDUMP",
+};
+
+const char* vbsm_opcode_to_string(VbsmOpcode opcode) {
+    return (unsigned)opcode < VBSM_OP_COUNT ? vbsm_opcode_names[opcode] : "?";
+}
+
+int vbsm_has_extension(const char* path) {
+    size_t length = path ? strlen(path) : 0;
+    size_t extension = strlen(VBSM_EXTENSION);
+    return length > extension && strcmp(path + length - extension, VBSM_EXTENSION) == 0;
+}
+
+void vbsm_module_free(VbsmModule* module) {
+    if (!module) return;
+    free(module->code);
+    free(module->constants);
+    free(module->labels);
+    free(module->strings);
+    free(module);
+}
+
+// --- IR -> Bayt Kodu ---
+
+// Kod parçaları: sabit baytlar, gevşetilen dallar ve atlama tabloları
+typedef enum {
+    VBSM_ITEM_FIXED,        // Baytlar 'scratch' içinde hazır
+    VBSM_ITEM_BRANCH,       // [op] [sleb128 uzaklık]; boyut gevşetmeyle büyür
+    VBSM_ITEM_JUMP_TABLE    // Başlık baytları 'scratch' içinde, i32 uzaklıklar son yazımda
+} VbsmItemKind;
+
+typedef struct {
+    uint8_t kind;           // VbsmItemKind
+    uint8_t opcode;         // Dallar için işlem kodu
+    uint32_t size;          // Parçanın koddaki boyutu
+    uint32_t data;          // 'scratch' içindeki baytların konumu
+    uint32_t data_size;
+    uint32_t target;        // Dal hedef bloğu veya atlama tablosu indeksi
+} VbsmItem;
+
+typedef struct {
+    const IrFunction* fn;
+    VbsmItem* items;
+    size_t num_items;
+    size_t item_capacity;
+    VbsmBuffer scratch;
+} VbsmEmitter;
+
+static VbsmItem* vbsm_add_item(VbsmEmitter* emitter, VbsmItemKind kind) {
+    if (emitter->num_items >= emitter->item_capacity) {
+        size_t new_capacity = emitter->item_capacity ? emitter->item_capacity * 2 : 64;
+        VbsmItem* items = (VbsmItem*)realloc(emitter->items, new_capacity * sizeof(VbsmItem));
+        if (!items) {
+            fprintf(stderr, "Hata: VBSM üretimi için bellek tahsis edilemedi.\n");
+            return NULL;
+        }
+        emitter->items = items;
+        emitter->item_capacity = new_capacity;
+    }
+    VbsmItem* item = &emitter->items[emitter->num_items++];
+    memset(item, 0, sizeof(VbsmItem));
+    item->kind = (uint8_t)kind;
+    item->data = (uint32_t)emitter->scratch.size;
+    return item;
+}
+
+static int vbsm_add_branch(VbsmEmitter* emitter, VbsmOpcode opcode, uint32_t target) {
+    VbsmItem* item = vbsm_add_item(emitter, VBSM_ITEM_BRANCH);
+    if (!item) return 0;
+    item->opcode = (uint8_t)opcode;
+    item->size = 2;
+    item->target = target;
+    return 1;
+}
+
+/**
+ * @brief Sanal kaydedicinin kökeni olan mimari kaydediciyi döndürür.
+ * @return Kaydedici indeksi veya kökeni yoksa -1.
+ */
+static int vbsm_register(const IrFunction* fn, uint16_t vreg) {
+    int origin = fn->vregs[vreg].origin;
+    if (origin < 0 || origin >= IR_NUM_REGISTERS) {
+        fprintf(stderr, "Hata: VBSM üretimi: v%u bir mimari kaydediciye eşlenemiyor.\n", vreg);
+        return -1;
+    }
+    return origin;
+}
+
+/**
+ * @brief "op d, b" biçimindeki bir komutu (_R/_I/_K) kodlar.
+ * @param base İşlem kodunun _R biçimi.
+ * @param dest İlk kaydedici alanı.
+ */
+static int vbsm_encode_operation(VbsmEmitter* emitter, const IrInstr* instr, VbsmOpcode base, int dest) {
+    const IrFunction* fn = emitter->fn;
+    VbsmItem* item = vbsm_add_item(emitter, VBSM_ITEM_FIXED);
+    if (!item || dest < 0) return 0;
+    VbsmBuffer* out = &emitter->scratch;
+    if (!(instr->attrs & IR_ATTR_IMM)) {
+        int source = vbsm_register(fn, instr->u.op.src2);
+        if (source < 0) return 0;
+        vbsm_put_byte(out, (uint8_t)base);
+        vbsm_put_byte(out, (uint8_t)(dest << 4 | source));
+    } else if (instr->attrs & IR_ATTR_WIDE) {
+        // 32 bite sığmayan sabitler havuzdan okunur (IR sabit tablosuyla aynı indeksler)
+        vbsm_put_byte(out, (uint8_t)(base + 2));
+        vbsm_put_byte(out, (uint8_t)(dest << 4));
+        vbsm_put_uleb(out, (uint64_t)instr->u.op.imm);
+    } else {
+        vbsm_put_byte(out, (uint8_t)(base + 1));
+        vbsm_put_byte(out, (uint8_t)(dest << 4));
+        vbsm_put_sleb(out, instr->u.op.imm, vbsm_sleb_size(instr->u.op.imm));
+    }
+    item->data_size = (uint32_t)(out->size - item->data);
+    item->size = item->data_size;
+    return 1;
+}
+
+// Koşul indeksleri IrCondition sırasıyladır (EQ, NE, LT, GT, LE, GE)
+static const IrCondition vbsm_inverse_condition[] = {IR_COND_NE, IR_COND_EQ, IR_COND_GE,
+                                                     IR_COND_LE, IR_COND_GT, IR_COND_LT};
+
+/**
+ * @brief Bir IR komutunu kod parçalarına çevirir.
+ * @param next Yerleşimde bir sonraki blok (yoksa IR_NO_BLOCK); ona giden atlamalar atlanır.
+ */
+static int vbsm_encode_instruction(VbsmEmitter* emitter, const IrInstr* instr, uint32_t next) {
+    const IrFunction* fn = emitter->fn;
+    VbsmBuffer* out = &emitter->scratch;
+    IrOpcode opcode = (IrOpcode)instr->opcode;
+    switch (opcode) {
+        case IR_OP_MOV:
+            return vbsm_encode_operation(emitter, instr, VBSM_OP_MOV_R, vbsm_register(fn, instr->dst));
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_SEL: {
+            int dest = vbsm_register(fn, instr->dst);
+            if (dest < 0) return 0;
+            if (vbsm_register(fn, instr->u.op.src1) != dest) {
+                fprintf(stderr, "Hata: VBSM üretimi: '%s' 2 adresli biçime eşlenemiyor (v%u <- v%u).\n",
+                        ir_opcode_to_string(opcode), instr->dst, instr->u.op.src1);
+                return 0;
+            }
+            VbsmOpcode base = opcode == IR_OP_ADD   ? VBSM_OP_ADD_R
+                              : opcode == IR_OP_SUB ? VBSM_OP_SUB_R
+                              : opcode == IR_OP_MUL ? VBSM_OP_MUL_R
+                              : opcode == IR_OP_DIV ? VBSM_OP_DIV_R
+                                                    : (VbsmOpcode)(VBSM_OP_SELEQ_R + 3 * instr->cond);
+            return vbsm_encode_operation(emitter, instr, base, dest);
+        }
+        case IR_OP_CMP:
+            return vbsm_encode_operation(emitter, instr, VBSM_OP_CMP_R, vbsm_register(fn, instr->u.op.src1));
+        case IR_OP_CALL:
+            return vbsm_add_branch(emitter, VBSM_OP_CALL, instr->u.br.taken);
+        case IR_OP_JMP:
+            return instr->u.br.taken == next || vbsm_add_branch(emitter, VBSM_OP_JMP, instr->u.br.taken);
+        case IR_OP_BR: {
+            IrCondition cond = (IrCondition)instr->cond;
+            uint32_t taken = instr->u.br.taken;
+            uint32_t fallthrough = instr->u.br.fallthrough;
+            if (taken == next && fallthrough != next) {
+                // Koşulu tersine çevirerek ek JMP'den kaçın
+                cond = vbsm_inverse_condition[cond];
+                taken = fallthrough;
+                fallthrough = next;
+            }
+            if (!vbsm_add_branch(emitter, (VbsmOpcode)(VBSM_OP_JEQ + cond), taken)) return 0;
+            return fallthrough == next || vbsm_add_branch(emitter, VBSM_OP_JMP, fallthrough);
+        }
+        case IR_OP_JTAB: {
+            int reg = vbsm_register(fn, instr->u.op.src1);
+            VbsmItem* item = vbsm_add_item(emitter, VBSM_ITEM_JUMP_TABLE);
+            if (!item || reg < 0) return 0;
+            const IrJumpTable* table = &fn->jump_tables[instr->u.op.imm];
+            vbsm_put_byte(out, VBSM_OP_JTAB);
+            vbsm_put_byte(out, (uint8_t)(reg << 4));
+            vbsm_put_sleb(out, table->min, vbsm_sleb_size(table->min));
+            vbsm_put_uleb(out, table->num_targets);
+            item->data_size = (uint32_t)(out->size - item->data);
+            item->size = item->data_size + 4 * (table->num_targets + 1);
+            item->target = (uint32_t)instr->u.op.imm;
+            return 1;
+        }
+        case IR_OP_SYSCALL: {
+            VbsmItem* item = vbsm_add_item(emitter, VBSM_ITEM_FIXED);
+            if (!item) return 0;
+            const IrSyscall* syscall = &fn->syscalls[instr->u.op.imm];
+            vbsm_put_byte(out, VBSM_OP_SYSCALL);
+            vbsm_put_sleb(out, syscall->number, vbsm_sleb_size(syscall->number));
+            vbsm_put_uleb(out, syscall->num_args);
+            for (uint32_t a = 0; a < syscall->num_args; a += 2) {
+                uint32_t high = fn->pool[syscall->first_arg + a];
+                uint32_t low = a + 1 < syscall->num_args ? fn->pool[syscall->first_arg + a + 1] : 0;
+                vbsm_put_byte(out, (uint8_t)(high << 4 | low));
+            }
+            item->data_size = (uint32_t)(out->size - item->data);
+            item->size = item->data_size;
+            return 1;
+        }
+        case IR_OP_PROFCNT:
+        case IR_OP_PROFDUMP:
+        case IR_OP_RET:
+        case IR_OP_END: {
+            VbsmItem* item = vbsm_add_item(emitter, VBSM_ITEM_FIXED);
+            if (!item) return 0;
+            if (opcode == IR_OP_PROFCNT) {
+                vbsm_put_byte(out, VBSM_OP_PROFCNT);
+                vbsm_put_uleb(out, (uint64_t)ir_instr_immediate(fn, instr));
+            } else {
+                vbsm_put_byte(out, opcode == IR_OP_PROFDUMP ? VBSM_OP_PROFDUMP
+                                   : opcode == IR_OP_RET    ? VBSM_OP_RET
+                                                            : VBSM_OP_HALT);
+            }
+            item->data_size = (uint32_t)(out->size - item->data);
+            item->size = item->data_size;
+            return 1;
+        }
+        default:
+            fprintf(stderr, "Hata: VBSM üretimi: desteklenmeyen IR komutu '%s'.\n", ir_opcode_to_string(opcode));
+            return 0;
+    }
+}
+
+/**
+ * @brief Parça konumlarını hesaplar ve sığmayan dalları büyütür; sabit noktaya kadar tekrarlanır.
+ * @param offsets Çıktı: her parçanın konumu (num_items + 1 eleman; son eleman kod boyutu).
+ * @param block_item Her bloğun ilk parçasının indeksi.
+ * @return Kod 4 GB'ı aşarsa 0, aksi takdirde 1.
+ */
+static int vbsm_relax(VbsmEmitter* emitter, const uint32_t* block_item, uint64_t* offsets) {
+    int changed;
+    do {
+        changed = 0;
+        offsets[0] = 0;
+        for (size_t i = 0; i < emitter->num_items; i++) offsets[i + 1] = offsets[i] + emitter->items[i].size;
+        if (offsets[emitter->num_items] > UINT32_MAX) return 0;
+        for (size_t i = 0; i < emitter->num_items; i++) {
+            VbsmItem* item = &emitter->items[i];
+            if (item->kind != VBSM_ITEM_BRANCH) continue;
+            int64_t distance = (int64_t)offsets[block_item[item->target]] - (int64_t)(offsets[i] + item->size);
+            uint32_t needed = 1 + (uint32_t)vbsm_sleb_size(distance);
+            if (needed > item->size) {
+                item->size = needed;
+                changed = 1;
+            }
+        }
+    } while (changed);
+    return 1;
+}
+
+VbsmModule* vbsm_emit_program(const IrFunction* fn) {
+    VbsmModule* module = (VbsmModule*)calloc(1, sizeof(VbsmModule));
+    VbsmEmitter emitter;
+    memset(&emitter, 0, sizeof(emitter));
+    emitter.fn = fn;
+    uint32_t* block_item = (uint32_t*)malloc(sizeof(uint32_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    uint64_t* offsets = NULL;
+    int ok = module && block_item;
+    if (!ok) fprintf(stderr, "Hata: VBSM üretimi için bellek tahsis edilemedi.\n");
+
+    // 1. Komutları parçalara çevir (dallar en kısa biçimde)
+    for (size_t l = 0; l < fn->num_layout && ok; l++) {
+        uint32_t b = fn->layout[l];
+        uint32_t next = l + 1 < fn->num_layout ? fn->layout[l + 1] : IR_NO_BLOCK;
+        const IrBlock* block = &fn->blocks[b];
+        block_item[b] = (uint32_t)emitter.num_items;
+        for (uint32_t k = 0; k < block->num_instrs && ok; k++) {
+            ok = vbsm_encode_instruction(&emitter, &fn->instrs[block->first + k], next);
+        }
+    }
+    if (ok && emitter.scratch.failed) {
+        fprintf(stderr, "Hata: VBSM üretimi için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+
+    // 2. Dal uzaklıklarını gevşet
+    if (ok) {
+        offsets = (uint64_t*)malloc(sizeof(uint64_t) * (emitter.num_items + 1));
+        ok = offsets != NULL;
+        if (ok && !vbsm_relax(&emitter, block_item, offsets)) {
+            fprintf(stderr, "Hata: VBSM üretimi: kod boyutu 4 GB sınırını aşıyor.\n");
+            ok = 0;
+        }
+    }
+
+    // 3. Son kodu yaz
+    VbsmBuffer code = {0};
+    for (size_t i = 0; i < emitter.num_items && ok; i++) {
+        const VbsmItem* item = &emitter.items[i];
+        int64_t end = (int64_t)(offsets[i] + item->size);
+        if (item->kind == VBSM_ITEM_BRANCH) {
+            vbsm_put_byte(&code, item->opcode);
+            vbsm_put_sleb(&code, (int64_t)offsets[block_item[item->target]] - end, item->size - 1);
+            continue;
+        }
+        vbsm_put(&code, emitter.scratch.data + item->data, item->data_size);
+        if (item->kind == VBSM_ITEM_JUMP_TABLE) {
+            const IrJumpTable* table = &fn->jump_tables[item->target];
+            vbsm_put_uint(&code, (uint32_t)(int32_t)((int64_t)offsets[block_item[table->default_block]] - end), 4);
+            for (uint32_t t = 0; t < table->num_targets; t++) {
+                uint32_t target = fn->pool[table->first_target + t];
+                vbsm_put_uint(&code, (uint32_t)(int32_t)((int64_t)offsets[block_item[target]] - end), 4);
+            }
+        }
+    }
+    if (ok && code.failed) {
+        fprintf(stderr, "Hata: VBSM üretimi için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+
+    // 4. Sabit havuzu ve etiket indeksi
+    if (ok) {
+        module->code = code.data;
+        module->code_size = code.size;
+        code.data = NULL;
+        module->flags = fn->arith_sets_flags ? VBSM_FLAG_ARITH_SETS_FLAGS : 0;
+        if (fn->num_constants > 0) {
+            module->constants = (int64_t*)malloc(sizeof(int64_t) * fn->num_constants);
+            ok = module->constants != NULL;
+            if (ok) {
+                memcpy(module->constants, fn->constants, sizeof(int64_t) * fn->num_constants);
+                module->num_constants = fn->num_constants;
+            } else {
+                fprintf(stderr, "Hata: VBSM üretimi için bellek tahsis edilemedi.\n");
+            }
+        }
+    }
+    if (ok && fn->num_labels > 0) {
+        module->labels = (VbsmLabel*)malloc(sizeof(VbsmLabel) * fn->num_labels);
+        VbsmBuffer strings = {0};
+        ok = module->labels != NULL;
+        for (size_t l = 0; l < fn->num_layout && ok; l++) {
+            const IrBlock* block = &fn->blocks[fn->layout[l]];
+            for (uint32_t k = 0; k < block->num_labels; k++) {
+                const char* name = ir_label_name(fn, &fn->labels[block->first_label + k]);
+                VbsmLabel* label = &module->labels[module->num_labels++];
+                label->offset = (uint32_t)offsets[block_item[fn->layout[l]]];
+                label->name = (uint32_t)strings.size;
+                vbsm_put(&strings, name, strlen(name) + 1);
+            }
+        }
+        module->strings = (char*)strings.data;
+        module->strings_size = strings.size;
+        if (strings.failed) ok = 0;
+        if (!ok) fprintf(stderr, "Hata: VBSM üretimi için bellek tahsis edilemedi.\n");
+    }
+
+    free(code.data);
+    free(offsets);
+    free(block_item);
+    free(emitter.items);
+    free(emitter.scratch.data);
+    if (!ok) {
+        vbsm_module_free(module);
+        return NULL;
+    }
+    return module;
+}
+
+// --- Dosya Yazımı ---
+
+int vbsm_write_file(const char* path, const VbsmModule* module) {
+    VbsmBuffer out = {0};
+    vbsm_put(&out, VBSM_MAGIC, 4);
+    vbsm_put_uint(&out, VBSM_VERSION, 2);
+    vbsm_put_uint(&out, module->flags, 2);
+    vbsm_put_uint(&out, module->code_size, 4);
+    vbsm_put_uint(&out, module->num_constants, 4);
+    vbsm_put_uint(&out, module->num_labels, 4);
+    vbsm_put_uint(&out, module->strings_size, 4);
+    for (size_t c = 0; c < module->num_constants; c++) vbsm_put_uint(&out, (uint64_t)module->constants[c], 8);
+    for (size_t l = 0; l < module->num_labels; l++) {
+        vbsm_put_uint(&out, module->labels[l].offset, 4);
+        vbsm_put_uint(&out, module->labels[l].name, 4);
+    }
+    vbsm_put(&out, module->strings, module->strings_size);
+    vbsm_put(&out, module->code, module->code_size);
+
+    int ok = !out.failed;
+    if (!ok) {
+        fprintf(stderr, "Hata: VBSM dosyası için bellek tahsis edilemedi.\n");
+    } else {
+        FILE* file = fopen(path, "wb");
+        if (!file) {
+            fprintf(stderr, "Hata: '%s' VBSM dosyası yazmak için açılamadı.\n", path);
+            ok = 0;
+        } else {
+            ok = fwrite(out.data, 1, out.size, file) == out.size;
+            if (fclose(file) != 0) ok = 0;
+            if (!ok) fprintf(stderr, "Hata: '%s' VBSM dosyasına yazılamadı.\n", path);
+        }
+    }
+    free(out.data);
+    return ok;
+}
+
+// --- Dosya Okuma ---
+
+static uint64_t vbsm_get_uint(const uint8_t* bytes, size_t width) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; i++) value |= (uint64_t)bytes[i] << (8 * i);
+    return value;
+}
+
+VbsmModule* vbsm_read_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Hata: VBSM dosyası '%s' açılamadı.\n", path);
+        return NULL;
+    }
+    VbsmBuffer in = {0};
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) vbsm_put(&in, chunk, read);
+    int ok = !ferror(file) && !in.failed;
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "Hata: VBSM dosyası '%s' okunamadı.\n", path);
+        free(in.data);
+        return NULL;
+    }
+
+    VbsmModule* module = NULL;
+    const uint8_t* bytes = in.data;
+    if (in.size < VBSM_HEADER_SIZE || memcmp(bytes, VBSM_MAGIC, 4) != 0) {
+        fprintf(stderr, "Hata: '%s' bir VBSM dosyası değil.\n", path);
+        ok = 0;
+    } else if (vbsm_get_uint(bytes + 4, 2) != VBSM_VERSION) {
+        fprintf(stderr, "Hata: '%s' desteklenmeyen VBSM sürümü (%u, beklenen %d).\n", path,
+                (unsigned)vbsm_get_uint(bytes + 4, 2), VBSM_VERSION);
+        ok = 0;
+    }
+    uint64_t code_size = ok ? vbsm_get_uint(bytes + 8, 4) : 0;
+    uint64_t num_constants = ok ? vbsm_get_uint(bytes + 12, 4) : 0;
+    uint64_t num_labels = ok ? vbsm_get_uint(bytes + 16, 4) : 0;
+    uint64_t strings_size = ok ? vbsm_get_uint(bytes + 20, 4) : 0;
+    if (ok && VBSM_HEADER_SIZE + 8 * num_constants + 8 * num_labels + strings_size + code_size != in.size) {
+        fprintf(stderr, "Hata: '%s' VBSM dosyası kesik veya bozuk (boyut uyuşmuyor).\n", path);
+        ok = 0;
+    }
+
+    if (ok) {
+        module = (VbsmModule*)calloc(1, sizeof(VbsmModule));
+        ok = module != NULL;
+    }
+    if (ok) {
+        module->flags = (uint16_t)vbsm_get_uint(bytes + 6, 2);
+        module->constants = (int64_t*)malloc(sizeof(int64_t) * (num_constants ? num_constants : 1));
+        module->labels = (VbsmLabel*)malloc(sizeof(VbsmLabel) * (num_labels ? num_labels : 1));
+        module->strings = (char*)malloc(strings_size ? strings_size : 1);
+        module->code = (uint8_t*)malloc(code_size ? code_size : 1);
+        ok = module->constants && module->labels && module->strings && module->code;
+        if (!ok) fprintf(stderr, "Hata: VBSM modülü için bellek tahsis edilemedi.\n");
+    }
+    if (ok) {
+        const uint8_t* cursor = bytes + VBSM_HEADER_SIZE;
+        for (size_t c = 0; c < num_constants; c++, cursor += 8) {
+            module->constants[c] = (int64_t)vbsm_get_uint(cursor, 8);
+        }
+        module->num_constants = num_constants;
+        for (size_t l = 0; l < num_labels; l++, cursor += 8) {
+            module->labels[l].offset = (uint32_t)vbsm_get_uint(cursor, 4);
+            module->labels[l].name = (uint32_t)vbsm_get_uint(cursor + 4, 4);
+            if (module->labels[l].offset > code_size || module->labels[l].name >= strings_size) ok = 0;
+        }
+        module->num_labels = num_labels;
+        memcpy(module->strings, cursor, strings_size);
+        module->strings_size = strings_size;
+        if (strings_size > 0 && module->strings[strings_size - 1] != '\0') ok = 0;
+        memcpy(module->code, cursor + strings_size, code_size);
+        module->code_size = code_size;
+        if (!ok) fprintf(stderr, "Hata: '%s' VBSM dosyasında geçersiz etiket indeksi.\n", path);
+    }
+    free(in.data);
+    if (!ok) {
+        vbsm_module_free(module);
+        return NULL;
+    }
+    return module;
+}
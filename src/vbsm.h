@@ -0,0 +1,135 @@
+#ifndef VBSM_H
+#define VBSM_H
+
+#include "ir_generator.h" // IrFunction (kod üretiminin girdisi)
+#include <stdint.h> // uint8_t, uint32_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- VirtualBessambly (.vbsm) Bayt Kodu ---
+// BVM için taşınabilir, sıkıştırılmış ara biçim. Komutlar değişken uzunluktadır:
+//  - 1 baytlık işlem kodu,
+//  - kaydedici alanları 4 bittir ve çiftler halinde tek bayta paketlenir (yüksek yarım: ilk kaydedici),
+//  - sabitler SLEB128, sayaç/havuz indeksleri ULEB128 olarak kodlanır,
+//  - dal uzaklıkları SLEB128'dir ve dal komutunun sonundan hedefe göredir.
+// Dal uzaklıkları gevşetme (relaxation) ile çözülür: tüm dallar en kısa kodlamayla başlar,
+// sığmayanlar büyütülür ve yerleşim sabit noktaya ulaşana kadar tekrarlanır (dallar sadece
+// büyüdüğü için sonlanır; gereğinden uzun kalan uzaklıklar dolgulu LEB128 ile yazılır).
+//
+// Kaynaklar AST'deki 2 adresli biçimdedir: "ADD Rd, b" -> Rd = Rd + b. IR'deki sanal
+// kaydediciler kökenleri olan mimari kaydedicilere (R0-R15) eşlenir.
+//
+// --- Dosya Düzeni (tüm tamsayılar küçük-sonlu) ---
+//  Başlık (VBSM_HEADER_SIZE bayt):
+//    char[4] magic "VBSM", u16 sürüm, u16 bayraklar (VBSM_FLAG_*),
+//    u32 kod boyutu, u32 sabit sayısı, u32 etiket sayısı, u32 dize tablosu boyutu
+//  Sabit havuzu: i64 x sabit sayısı (64 bitlik sabitler; *_K komutları indeksler)
+//  Etiket indeksi: {u32 kod konumu, u32 ad konumu} x etiket sayısı (kod konumuna göre sıralı)
+//  Dize tablosu: NUL ile biten etiket adları
+//  Kod: bayt kodu; yürütme konum 0'dan başlar
+#define VBSM_MAGIC "VBSM"
+#define VBSM_VERSION 1
+#define VBSM_HEADER_SIZE 24
+
+#define VBSM_FLAG_ARITH_SETS_FLAGS 0x1  // ADD/SUB bayrakları sonuca göre kurar (aksi halde bozar)
+
+// --- İşlem Kodları ---
+// "b" operandlı komutların üç biçimi ardışıktır: _R (kaydedici), _I (SLEB128 sabit), _K (havuz indeksi).
+// Biçimler:
+//  _R:  [op] [d|s]
+//  _I:  [op] [d|0] [sleb128 sabit]
+//  _K:  [op] [d|0] [uleb128 havuz indeksi]
+//  Jcc/JMP/CALL: [op] [sleb128 uzaklık]
+//  JTAB: [op] [r|0] [sleb128 en küçük değer] [uleb128 hedef sayısı n] [i32 varsayılan] [i32 x n]
+//        (tablo uzaklıkları sabit genişliktedir, O(1) indeksleme için; komutun sonuna göredir)
+//  SYSCALL: [op] [sleb128 numara] [uleb128 argüman sayısı n] [kaydedici çiftleri x ceil(n/2)]
+//  PROFCNT: [op] [uleb128 sayaç indeksi]
+//  RET, HALT, PROFDUMP: [op]
+typedef enum {
+    VBSM_OP_HALT = 0,
+    VBSM_OP_MOV_R, VBSM_OP_MOV_I, VBSM_OP_MOV_K,
+    VBSM_OP_ADD_R, VBSM_OP_ADD_I, VBSM_OP_ADD_K,
+    VBSM_OP_SUB_R, VBSM_OP_SUB_I, VBSM_OP_SUB_K,
+    VBSM_OP_MUL_R, VBSM_OP_MUL_I, VBSM_OP_MUL_K,
+    VBSM_OP_DIV_R, VBSM_OP_DIV_I, VBSM_OP_DIV_K,
+    VBSM_OP_CMP_R, VBSM_OP_CMP_I, VBSM_OP_CMP_K,
+    VBSM_OP_SELEQ_R, VBSM_OP_SELEQ_I, VBSM_OP_SELEQ_K,
+    VBSM_OP_SELNE_R, VBSM_OP_SELNE_I, VBSM_OP_SELNE_K,
+    VBSM_OP_SELLT_R, VBSM_OP_SELLT_I, VBSM_OP_SELLT_K,
+    VBSM_OP_SELGT_R, VBSM_OP_SELGT_I, VBSM_OP_SELGT_K,
+    VBSM_OP_SELLE_R, VBSM_OP_SELLE_I, VBSM_OP_SELLE_K,
+    VBSM_OP_SELGE_R, VBSM_OP_SELGE_I, VBSM_OP_SELGE_K,
+    VBSM_OP_JMP,
+    VBSM_OP_JEQ, VBSM_OP_JNE, VBSM_OP_JLT, VBSM_OP_JGT, VBSM_OP_JLE, VBSM_OP_JGE,
+    VBSM_OP_CALL,
+    VBSM_OP_RET,
+    VBSM_OP_JTAB,
+    VBSM_OP_SYSCALL,
+    VBSM_OP_PROFCNT,
+    VBSM_OP_PROFDUMP,
+    VBSM_OP_COUNT
+} VbsmOpcode;
+
+// --- Etiket İndeksi Girdisi ---
+typedef struct {
+    uint32_t offset;        // Etiketin kod içindeki konumu
+    uint32_t name;          // Adın dize tablosundaki konumu
+} VbsmLabel;
+
+// --- Bayt Kodu Modülü ---
+typedef struct {
+    uint8_t* code;
+    size_t code_size;
+    int64_t* constants;     // Sabit havuzu
+    size_t num_constants;
+    VbsmLabel* labels;      // Kod konumuna göre sıralı
+    size_t num_labels;
+    char* strings;          // Etiket adları
+    size_t strings_size;
+    uint16_t flags;         // VBSM_FLAG_*
+} VbsmModule;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Doğrulanmış IR'dan bayt kodu modülü üretir.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @return Yeni VbsmModule pointer'ı veya NULL hata durumunda (IR 2 adresli biçime
+ * eşlenemiyorsa açıklayıcı bir hata yazılır).
+ */
+VbsmModule* vbsm_emit_program(const IrFunction* fn);
+
+/**
+ * @brief Modülü .vbsm dosyasına yazar.
+ * @param path Dosya yolu.
+ * @param module Yazılacak modül.
+ * @return Başarılıysa 1, aksi takdirde 0.
+ */
+int vbsm_write_file(const char* path, const VbsmModule* module);
+
+/**
+ * @brief Bir .vbsm dosyasını okur. Başlık, sabit havuzu ve etiket indeksi denetlenir;
+ * kodun kendisi yürütülmeden önce BVM tarafından çözülürken doğrulanır.
+ * @param path Dosya yolu.
+ * @return Okunan VbsmModule pointer'ı veya NULL hata durumunda.
+ */
+VbsmModule* vbsm_read_file(const char* path);
+
+/**
+ * @brief Modülü serbest bırakır.
+ * @param module Serbest bırakılacak VbsmModule pointer'ı.
+ */
+void vbsm_module_free(VbsmModule* module);
+
+/**
+ * @brief İşlem kodunun adını döndürür (örn: "ADD_I").
+ */
+const char* vbsm_opcode_to_string(VbsmOpcode opcode);
+
+/**
+ * @brief Bir dosya yolunun .vbsm dosyası olup olmadığını uzantısından belirler.
+ * @param path Dosya yolu.
+ * @return ".vbsm" ile bitiyorsa 1, aksi takdirde 0.
+ */
+int vbsm_has_extension(const char* path);
+
+#endif // VBSM_H
@@ -0,0 +1,1410 @@
+#include "wasm.h"
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <stdio.h>  // FILE, fopen, fwrite, fprintf
+#include <string.h> // memcpy, memset, strlen, strcmp
+
+#define WASM_EXTENSION ".wasm"
+
+// --- İkili Biçim Sabitleri ---
+
+#define WASM_VERSION 1
+
+#define WASM_SECTION_TYPE 1
+#define WASM_SECTION_IMPORT 2
+#define WASM_SECTION_FUNCTION 3
+#define WASM_SECTION_MEMORY 5
+#define WASM_SECTION_GLOBAL 6
+#define WASM_SECTION_EXPORT 7
+#define WASM_SECTION_CODE 10
+
+#define WASM_TYPE_I32 0x7f
+#define WASM_TYPE_I64 0x7e
+#define WASM_TYPE_FUNC 0x60
+#define WASM_BLOCK_EMPTY 0x40
+#define WASM_EXTERNAL_FUNC 0x00
+#define WASM_EXTERNAL_MEMORY 0x02
+#define WASM_PAGE_SIZE 65536
+
+#define WASM_OP_UNREACHABLE 0x00
+#define WASM_OP_BLOCK 0x02
+#define WASM_OP_LOOP 0x03
+#define WASM_OP_IF 0x04
+#define WASM_OP_ELSE 0x05
+#define WASM_OP_END 0x0b
+#define WASM_OP_BR 0x0c
+#define WASM_OP_BR_IF 0x0d
+#define WASM_OP_BR_TABLE 0x0e
+#define WASM_OP_RETURN 0x0f
+#define WASM_OP_CALL 0x10
+#define WASM_OP_SELECT 0x1b
+#define WASM_OP_LOCAL_GET 0x20
+#define WASM_OP_LOCAL_SET 0x21
+#define WASM_OP_LOCAL_TEE 0x22
+#define WASM_OP_GLOBAL_GET 0x23
+#define WASM_OP_GLOBAL_SET 0x24
+#define WASM_OP_I64_LOAD 0x29
+#define WASM_OP_I64_STORE 0x37
+#define WASM_OP_I32_CONST 0x41
+#define WASM_OP_I64_CONST 0x42
+#define WASM_OP_I32_EQZ 0x45
+#define WASM_OP_I32_NE 0x47
+#define WASM_OP_I32_GE_U 0x4f
+#define WASM_OP_I64_EQ 0x51
+#define WASM_OP_I64_NE 0x52
+#define WASM_OP_I64_LT_S 0x53
+#define WASM_OP_I64_LT_U 0x54
+#define WASM_OP_I64_GT_S 0x55
+#define WASM_OP_I64_LE_S 0x57
+#define WASM_OP_I64_GE_S 0x59
+#define WASM_OP_I32_ADD 0x6a
+#define WASM_OP_I32_SUB 0x6b
+#define WASM_OP_I64_ADD 0x7c
+#define WASM_OP_I64_SUB 0x7d
+#define WASM_OP_I64_MUL 0x7e
+#define WASM_OP_I64_DIV_S 0x7f
+#define WASM_OP_I32_WRAP_I64 0xa7
+
+// --- Modül Düzeni ---
+
+// Tip indeksleri
+#define WASM_TYPE_MAIN 0        // () -> i64
+#define WASM_TYPE_REGION 1      // (i64 x 16) -> (i64 x 16)
+#define WASM_TYPE_SYSCALL 2     // (i64, i32) -> i32
+#define WASM_TYPE_VOID 3        // () -> ()
+#define WASM_TYPE_STORE 4       // (i64 x 16) -> ()
+
+// Global indeksleri
+#define WASM_GLOBAL_HALTED 0    // i32: program bittiyse 1 (çağıranlar hemen döner)
+#define WASM_GLOBAL_DEPTH 1     // i32: çağrı derinliği
+
+// Alt program fonksiyonlarının yerel değişkenleri (0-15 parametreler: R0-R15)
+#define WASM_LOCAL_FLAG_A 16    // Bayraklar: (a, b) karşılaştırması
+#define WASM_LOCAL_FLAG_B 17
+#define WASM_LOCAL_TEMP 18      // i64 geçici (JTAB indeksi)
+#define WASM_LOCAL_LABEL 19     // i32: dağıtıcının hedefi
+#define WASM_LOCAL_STATUS 20    // i32: sistem çağrısı sonucu
+
+#define WASM_MEMARG_ALIGN_I64 3
+
+// --- Bayt Arabelleği ---
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    int failed;
+} WasmBuffer;
+
+static void wasm_put(WasmBuffer* buffer, const void* bytes, size_t size) {
+    if (buffer->failed || size == 0) return;
+    if (buffer->size + size > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity : 256;
+        while (new_capacity < buffer->size + size) new_capacity *= 2;
+        uint8_t* data = (uint8_t*)realloc(buffer->data, new_capacity);
+        if (!data) {
+            buffer->failed = 1;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = new_capacity;
+    }
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+}
+
+static void wasm_put_byte(WasmBuffer* buffer, uint8_t value) {
+    wasm_put(buffer, &value, 1);
+}
+
+static void wasm_put_uleb(WasmBuffer* buffer, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) byte |= 0x80;
+        wasm_put_byte(buffer, byte);
+    } while (value);
+}
+
+static void wasm_put_sleb(WasmBuffer* buffer, int64_t value) {
+    for (;;) {
+        uint8_t byte = (uint8_t)(value & 0x7f);
+        value >>= 7;
+        int done = (value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40));
+        if (!done) byte |= 0x80;
+        wasm_put_byte(buffer, byte);
+        if (done) return;
+    }
+}
+
+static void wasm_put_name(WasmBuffer* buffer, const char* name) {
+    size_t length = strlen(name);
+    wasm_put_uleb(buffer, length);
+    wasm_put(buffer, name, length);
+}
+
+static void wasm_put_op(WasmBuffer* buffer, uint8_t opcode, uint64_t immediate) {
+    wasm_put_byte(buffer, opcode);
+    wasm_put_uleb(buffer, immediate);
+}
+
+static void wasm_put_i64_const(WasmBuffer* buffer, int64_t value) {
+    wasm_put_byte(buffer, WASM_OP_I64_CONST);
+    wasm_put_sleb(buffer, value);
+}
+
+static void wasm_put_i32_const(WasmBuffer* buffer, int32_t value) {
+    wasm_put_byte(buffer, WASM_OP_I32_CONST);
+    wasm_put_sleb(buffer, value);
+}
+
+/**
+ * @brief Doğrusal bellekteki sabit bir konuma i64 yükleme/saklama yazar (taban adres
+ * yığında 0 olarak verilmiş olmalıdır).
+ */
+static void wasm_put_memory_op(WasmBuffer* buffer, uint8_t opcode, uint32_t offset) {
+    wasm_put_byte(buffer, opcode);
+    wasm_put_uleb(buffer, WASM_MEMARG_ALIGN_I64);
+    wasm_put_uleb(buffer, offset);
+}
+
+int wasm_has_extension(const char* path) {
+    size_t length = path ? strlen(path) : 0;
+    size_t extension = strlen(WASM_EXTENSION);
+    return length > extension && strcmp(path + length - extension, WASM_EXTENSION) == 0;
+}
+
+// --- Fonksiyon Grafiği ---
+// Bir alt program fonksiyonunun düğümleri IR blokları ile iki yapay düğüm türüdür: indirgenemez
+// bir döngünün girişlerini tek başlık altında toplayan dağıtıcılar ve br_table ile dallanan bir
+// düğümden dağıtıcıya giden kenarlarda $label'ı yazan basamaklar (br_table kenarında kod olamaz).
+
+typedef enum {
+    WASM_NODE_BLOCK,        // IR bloğu
+    WASM_NODE_DISPATCH,     // $label ile kenarlarından birine dallanır
+    WASM_NODE_TRAMPOLINE    // Tek kenarı (dağıtıcıya) izler
+} WasmNodeKind;
+
+#define WASM_NO_NODE 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t target;        // Hedef düğüm
+    int32_t dispatch;       // Hedef dağıtıcıysa $label'a yazılacak değer, aksi halde -1
+} WasmEdge;
+
+typedef struct {
+    uint8_t kind;           // WasmNodeKind
+    uint8_t is_loop;        // Geri kenar hedefi ("loop" ile sarılır)
+    uint8_t is_merge;       // İki veya daha fazla ileri kenarla girilir ("block" sonuna yazılır)
+    uint8_t is_switch;      // br_table ile dallanır (JTAB veya dağıtıcı)
+    uint32_t block;         // IR bloğu (WASM_NODE_BLOCK)
+    uint32_t first_edge;    // Kenarlar ardışıktır
+    uint32_t num_edges;
+    uint32_t rpo;           // Ters sonsıra numarası (ulaşılamıyorsa WASM_NO_NODE)
+    uint32_t idom;          // Anlık dominatör (kökte kendisi)
+    uint32_t first_child;   // Dominatör ağacındaki çocukların 'children' içindeki konumu (rpo sırasıyla)
+    uint32_t num_children;
+    uint32_t mark;          // Küme üyeliği (indirgenemezlik analizi)
+} WasmNode;
+
+// Yapısal kontrol akışının iç içe yapıları; dalların hedef derinliği bu yığından bulunur
+typedef enum {
+    WASM_SCOPE_BLOCK,       // Sonu 'node' düğümüne düşer
+    WASM_SCOPE_LOOP,        // Başı 'node' düğümüdür
+    WASM_SCOPE_IF
+} WasmScopeKind;
+
+typedef struct {
+    uint8_t kind;           // WasmScopeKind
+    uint32_t node;
+} WasmScope;
+
+typedef struct {
+    uint32_t entry_block;
+
+    WasmNode* nodes;
+    size_t num_nodes;
+    size_t node_capacity;
+    WasmEdge* edges;
+    size_t num_edges;
+    size_t edge_capacity;
+    WasmEdge root;              // Fonksiyon girişinin kenarı (giriş dağıtıcıya yönlenmiş olabilir)
+    uint32_t* node_of_block;    // IR bloğu -> düğüm (WASM_NO_NODE = fonksiyonda değil)
+    uint32_t* children;
+    uint32_t next_mark;
+
+    WasmScope* scopes;
+    size_t num_scopes;
+    size_t scope_capacity;
+
+    size_t num_loops;
+    size_t num_dispatchers;
+} WasmGraph;
+
+// --- Modül Üreticisi ---
+
+typedef struct {
+    const IrFunction* fn;
+    uint32_t* regions;          // Alt program fonksiyonlarının giriş blokları (0: program girişi)
+    size_t num_regions;
+    size_t region_capacity;
+    uint32_t* region_of_block;  // Blok bir alt programın girişiyse indeksi (aksi halde WASM_NO_NODE)
+
+    int uses_syscall;           // "bsm" "syscall" içe aktarılır
+    int uses_profile_dump;      // "bsm" "profile_dump" içe aktarılır
+    uint32_t num_counters;
+    uint32_t syscall_function;
+    uint32_t profile_dump_function;
+    uint32_t main_function;
+    uint32_t store_function;    // Kaydedicileri belleğe yazan yardımcı
+    uint32_t first_region_function;
+
+    WasmBuffer code;            // Kod bölümünün içeriği (fonksiyon gövdeleri)
+    WasmBuffer body;            // Üretilmekte olan gövde
+    WasmEmitStats stats;
+} WasmEmitter;
+
+static int wasm_grow(void** items, size_t* capacity, size_t needed, size_t size) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity * 2 : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*items, new_capacity * size);
+    if (!grown) {
+        fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+        return 0;
+    }
+    *items = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+static uint32_t wasm_add_node(WasmGraph* graph, WasmNodeKind kind, uint32_t block) {
+    if (!wasm_grow((void**)&graph->nodes, &graph->node_capacity, graph->num_nodes + 1, sizeof(WasmNode))) {
+        return WASM_NO_NODE;
+    }
+    WasmNode* node = &graph->nodes[graph->num_nodes];
+    memset(node, 0, sizeof(WasmNode));
+    node->kind = (uint8_t)kind;
+    node->block = block;
+    node->first_edge = (uint32_t)graph->num_edges;
+    return (uint32_t)graph->num_nodes++;
+}
+
+static int wasm_add_edge(WasmGraph* graph, uint32_t target, int32_t dispatch) {
+    if (!wasm_grow((void**)&graph->edges, &graph->edge_capacity, graph->num_edges + 1, sizeof(WasmEdge))) return 0;
+    graph->edges[graph->num_edges].target = target;
+    graph->edges[graph->num_edges].dispatch = dispatch;
+    graph->num_edges++;
+    return 1;
+}
+
+/**
+ * @brief Bloğun sonlandırıcısının hedeflerini döndürür.
+ * @param buffer JMP/BR hedefleri için en az 2 elemanlı dizi.
+ * @param targets Hedefler (atlama tablosu için fn->pool'u gösterir).
+ * @param extra JTAB'ın varsayılan hedefi (yoksa IR_NO_BLOCK); hedeflerden sonra gelir.
+ * @return Hedef sayısı (varsayılan hedef hariç).
+ */
+static size_t wasm_block_successors(const IrFunction* fn, uint32_t block, uint32_t* buffer, const uint32_t** targets,
+                                    uint32_t* extra) {
+    const IrInstr* terminator = ir_block_terminator(fn, block);
+    *targets = buffer;
+    *extra = IR_NO_BLOCK;
+    switch ((IrOpcode)terminator->opcode) {
+        case IR_OP_JMP:
+            buffer[0] = terminator->u.br.taken;
+            return 1;
+        case IR_OP_BR:
+            buffer[0] = terminator->u.br.taken;
+            buffer[1] = terminator->u.br.fallthrough;
+            return 2;
+        case IR_OP_JTAB: {
+            const IrJumpTable* table = &fn->jump_tables[terminator->u.op.imm];
+            *targets = fn->pool + table->first_target;
+            *extra = table->default_block;
+            return table->num_targets;
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Alt programın girişinden kenarlar boyunca ulaşılan blokları düğüm olarak ekler ve
+ * kenarları kurar. Karşılaşılan CALL hedefleri yeni alt programlar olarak kaydedilir.
+ */
+static int wasm_build_graph(WasmEmitter* emitter, WasmGraph* graph) {
+    const IrFunction* fn = emitter->fn;
+    for (size_t b = 0; b < fn->num_blocks; b++) graph->node_of_block[b] = WASM_NO_NODE;
+    uint32_t pair[2];
+    const uint32_t* targets;
+    uint32_t extra;
+
+    // 1. Düğümler (ön sıra; düğüm listesi iş kuyruğu olarak kullanılır)
+    graph->node_of_block[graph->entry_block] = wasm_add_node(graph, WASM_NODE_BLOCK, graph->entry_block);
+    if (graph->node_of_block[graph->entry_block] == WASM_NO_NODE) return 0;
+    for (size_t n = 0; n < graph->num_nodes; n++) {
+        uint32_t block = graph->nodes[n].block;
+        size_t count = wasm_block_successors(fn, block, pair, &targets, &extra);
+        for (size_t s = 0; s <= count; s++) {
+            uint32_t target = s < count ? targets[s] : extra;
+            if (target == IR_NO_BLOCK || graph->node_of_block[target] != WASM_NO_NODE) continue;
+            graph->node_of_block[target] = wasm_add_node(graph, WASM_NODE_BLOCK, target);
+            if (graph->node_of_block[target] == WASM_NO_NODE) return 0;
+        }
+        const IrBlock* ir_block = &fn->blocks[block];
+        for (uint32_t k = 0; k < ir_block->num_instrs; k++) {
+            const IrInstr* instr = &fn->instrs[ir_block->first + k];
+            if (instr->opcode != IR_OP_CALL) continue;
+            uint32_t callee = instr->u.br.taken;
+            if (emitter->region_of_block[callee] != WASM_NO_NODE) continue;
+            if (!wasm_grow((void**)&emitter->regions, &emitter->region_capacity, emitter->num_regions + 1,
+                           sizeof(uint32_t))) {
+                return 0;
+            }
+            emitter->region_of_block[callee] = (uint32_t)emitter->num_regions;
+            emitter->regions[emitter->num_regions++] = callee;
+        }
+    }
+
+    // 2. Kenarlar (düğüm sırasıyla ardışık)
+    for (size_t n = 0; n < graph->num_nodes; n++) {
+        WasmNode* node = &graph->nodes[n];
+        node->first_edge = (uint32_t)graph->num_edges;
+        const IrInstr* terminator = ir_block_terminator(fn, node->block);
+        node->is_switch = terminator->opcode == IR_OP_JTAB;
+        size_t count = wasm_block_successors(fn, node->block, pair, &targets, &extra);
+        for (size_t s = 0; s <= count; s++) {
+            uint32_t target = s < count ? targets[s] : extra;
+            if (target == IR_NO_BLOCK) continue;
+            if (!wasm_add_edge(graph, graph->node_of_block[target], -1)) return 0;
+        }
+        graph->nodes[n].num_edges = (uint32_t)graph->num_edges - graph->nodes[n].first_edge;
+    }
+    graph->root.target = 0;
+    graph->root.dispatch = -1;
+    return 1;
+}
+
+// --- İndirgenemez Bölgeler ---
+
+/**
+ * @brief Kümedeki düğümlerin güçlü bağlantılı bileşenlerini bulur (yinelemeli Tarjan).
+ * Küme, 'mark' alanı verilen değere eşit olan düğümlerdir.
+ * @param order Bileşenlerin düğümleri ardışık yazılır (members ile aynı boyut).
+ * @param starts Bileşen başlangıçları (members + 1 boyut); son eleman toplamdır.
+ * @return Bileşen sayısı veya bellek hatasında -1.
+ */
+static long wasm_find_components(WasmGraph* graph, const uint32_t* members, size_t num_members, uint32_t mark,
+                                 uint32_t* order, size_t* starts) {
+    size_t n = graph->num_nodes;
+    uint32_t* index = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t* low = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint8_t* on_stack = (uint8_t*)calloc(n, 1);
+    uint32_t* stack = (uint32_t*)malloc(sizeof(uint32_t) * (num_members + 1));
+    uint32_t* frames = (uint32_t*)malloc(sizeof(uint32_t) * (num_members + 1));
+    uint32_t* positions = (uint32_t*)malloc(sizeof(uint32_t) * (num_members + 1));
+    if (!index || !low || !on_stack || !stack || !frames || !positions) {
+        fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+        free(index); free(low); free(on_stack); free(stack); free(frames); free(positions);
+        return -1;
+    }
+    for (size_t m = 0; m < num_members; m++) index[members[m]] = WASM_NO_NODE;
+    uint32_t counter = 0;
+    size_t stack_size = 0, num_frames = 0, num_ordered = 0;
+    long num_components = 0;
+    for (size_t m = 0; m < num_members; m++) {
+        if (index[members[m]] != WASM_NO_NODE) continue;
+        uint32_t start = members[m];
+        index[start] = low[start] = counter++;
+        stack[stack_size++] = start;
+        on_stack[start] = 1;
+        frames[num_frames] = start;
+        positions[num_frames++] = 0;
+        while (num_frames > 0) {
+            uint32_t v = frames[num_frames - 1];
+            const WasmNode* node = &graph->nodes[v];
+            if (positions[num_frames - 1] < node->num_edges) {
+                uint32_t w = graph->edges[node->first_edge + positions[num_frames - 1]++].target;
+                if (graph->nodes[w].mark != mark) continue;
+                if (index[w] == WASM_NO_NODE) {
+                    index[w] = low[w] = counter++;
+                    stack[stack_size++] = w;
+                    on_stack[w] = 1;
+                    frames[num_frames] = w;
+                    positions[num_frames++] = 0;
+                } else if (on_stack[w] && index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+            num_frames--;
+            if (num_frames > 0) {
+                uint32_t parent = frames[num_frames - 1];
+                if (low[v] < low[parent]) low[parent] = low[v];
+            }
+            if (low[v] != index[v]) continue;
+            starts[num_components++] = num_ordered;
+            uint32_t w;
+            do {
+                w = stack[--stack_size];
+                on_stack[w] = 0;
+                order[num_ordered++] = w;
+            } while (w != v);
+        }
+    }
+    starts[num_components] = num_ordered;
+    free(index); free(low); free(on_stack); free(stack); free(frames); free(positions);
+    return num_components;
+}
+
+/**
+ * @brief Bir kenarı dağıtıcıya yönlendirir. br_table ile dallanan düğümlerin kenarları bir
+ * basamak düğümü üzerinden yönlendirilir.
+ */
+static int wasm_redirect_edge(WasmGraph* graph, int source_is_switch, uint32_t edge, uint32_t dispatcher,
+                              int32_t value) {
+    if (!source_is_switch) {
+        graph->edges[edge].target = dispatcher;
+        graph->edges[edge].dispatch = value;
+        return 1;
+    }
+    uint32_t trampoline = wasm_add_node(graph, WASM_NODE_TRAMPOLINE, IR_NO_BLOCK);
+    if (trampoline == WASM_NO_NODE || !wasm_add_edge(graph, dispatcher, value)) return 0;
+    graph->nodes[trampoline].num_edges = 1;
+    graph->edges[edge].target = trampoline;
+    graph->edges[edge].dispatch = -1;
+    return 1;
+}
+
+/**
+ * @brief Kümedeki döngüleri inceler: tek girişli döngülerin gövdesi (başlık hariç) özyinelemeli
+ * olarak incelenir; birden fazla girişi olan döngülerin girişleri bir dağıtıcının arkasına
+ * alınır ve dağıtıcı döngünün tek başlığı olur.
+ */
+static int wasm_fix_irreducible(WasmGraph* graph, const uint32_t* members, size_t num_members) {
+    if (num_members == 0) return 1;
+    uint32_t mark = ++graph->next_mark;
+    for (size_t m = 0; m < num_members; m++) graph->nodes[members[m]].mark = mark;
+    uint32_t* order = (uint32_t*)malloc(sizeof(uint32_t) * num_members);
+    size_t* starts = (size_t*)malloc(sizeof(size_t) * (num_members + 1));
+    uint32_t* entries = (uint32_t*)malloc(sizeof(uint32_t) * num_members);
+    uint32_t* inner = (uint32_t*)malloc(sizeof(uint32_t) * num_members);
+    long num_components = order && starts && entries && inner
+                              ? wasm_find_components(graph, members, num_members, mark, order, starts)
+                              : -1;
+    if (!order || !starts || !entries || !inner) fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+    int ok = num_components >= 0;
+
+    for (long c = 0; c < num_components && ok; c++) {
+        const uint32_t* component = order + starts[c];
+        size_t size = starts[c + 1] - starts[c];
+        if (size == 1) {
+            // Tek düğüm ancak kendine dönüyorsa döngüdür; başlığı kendisidir, iç kümesi boştur
+            continue;
+        }
+        uint32_t component_mark = ++graph->next_mark;
+        for (size_t i = 0; i < size; i++) graph->nodes[component[i]].mark = component_mark;
+
+        // Girişler: dışarıdan kenar alan düğümler (fonksiyon girişi dahil)
+        size_t num_entries = 0;
+        if (graph->nodes[graph->root.target].mark == component_mark) entries[num_entries++] = graph->root.target;
+        for (size_t u = 0; u < graph->num_nodes; u++) {
+            const WasmNode* node = &graph->nodes[u];
+            if (node->mark == component_mark) continue;
+            for (uint32_t e = 0; e < node->num_edges; e++) {
+                uint32_t target = graph->edges[node->first_edge + e].target;
+                if (graph->nodes[target].mark != component_mark) continue;
+                size_t k = 0;
+                while (k < num_entries && entries[k] != target) k++;
+                if (k == num_entries) entries[num_entries++] = target;
+            }
+        }
+
+        size_t num_inner = 0;
+        if (num_entries == 1) {
+            for (size_t i = 0; i < size; i++) {
+                if (component[i] != entries[0]) inner[num_inner++] = component[i];
+            }
+        } else {
+            // Dağıtıcı: tüm girişlere giden kenarlar (döngü içinden gelenler dahil) ona yönlenir
+            uint32_t dispatcher = wasm_add_node(graph, WASM_NODE_DISPATCH, IR_NO_BLOCK);
+            ok = dispatcher != WASM_NO_NODE;
+            for (size_t k = 0; k < num_entries && ok; k++) ok = wasm_add_edge(graph, entries[k], -1);
+            if (!ok) break;
+            graph->nodes[dispatcher].num_edges = (uint32_t)num_entries;
+            graph->nodes[dispatcher].is_switch = 1;
+            graph->num_dispatchers++;
+            size_t num_original_nodes = graph->num_nodes;
+            for (size_t u = 0; u < num_original_nodes && ok; u++) {
+                if (u == dispatcher) continue;
+                uint32_t first = graph->nodes[u].first_edge, count = graph->nodes[u].num_edges;
+                int is_switch = graph->nodes[u].is_switch;
+                for (uint32_t e = first; e < first + count && ok; e++) {
+                    for (size_t k = 0; k < num_entries; k++) {
+                        if (graph->edges[e].target != entries[k]) continue;
+                        ok = wasm_redirect_edge(graph, is_switch, e, dispatcher, (int32_t)k);
+                        break;
+                    }
+                }
+            }
+            for (size_t k = 0; k < num_entries; k++) {
+                if (graph->root.target != entries[k]) continue;
+                graph->root.target = dispatcher;
+                graph->root.dispatch = (int32_t)k;
+                break;
+            }
+            for (size_t i = 0; i < size; i++) inner[num_inner++] = component[i];
+        }
+        if (ok) ok = wasm_fix_irreducible(graph, inner, num_inner);
+    }
+    free(order);
+    free(starts);
+    free(entries);
+    free(inner);
+    return ok;
+}
+
+// --- Dominatör Ağacı ---
+
+static uint32_t wasm_intersect(const WasmGraph* graph, uint32_t a, uint32_t b) {
+    while (a != b) {
+        while (graph->nodes[a].rpo > graph->nodes[b].rpo) a = graph->nodes[a].idom;
+        while (graph->nodes[b].rpo > graph->nodes[a].rpo) b = graph->nodes[b].idom;
+    }
+    return a;
+}
+
+/**
+ * @brief Ters sonsırayı, dominatörleri (Cooper-Harvey-Kennedy), döngü başlarını, birleşme
+ * düğümlerini ve dominatör ağacının çocuklarını hesaplar. Geri kenarın hedefi kaynağını
+ * domine etmiyorsa grafik indirgenemezdir (dağıtıcılar eklendikten sonra olmamalıdır).
+ */
+static int wasm_analyze_graph(WasmGraph* graph) {
+    size_t n = graph->num_nodes;
+    uint32_t* by_rpo = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t* frames = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t* positions = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t* pred_starts = (uint32_t*)calloc(n + 1, sizeof(uint32_t));
+    uint32_t* preds = (uint32_t*)malloc(sizeof(uint32_t) * (graph->num_edges + 1));
+    uint32_t* forward_in = (uint32_t*)calloc(n, sizeof(uint32_t));
+    graph->children = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    int ok = by_rpo && frames && positions && pred_starts && preds && forward_in && graph->children;
+    if (!ok) fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+
+    // 1. Ters sonsıra
+    size_t num_reached = 0;
+    if (ok) {
+        for (size_t v = 0; v < n; v++) graph->nodes[v].rpo = WASM_NO_NODE;
+        uint8_t* visited = (uint8_t*)forward_in; // Geçici olarak ziyaret işareti
+        size_t num_frames = 0, num_post = 0;
+        frames[num_frames] = graph->root.target;
+        positions[num_frames++] = 0;
+        visited[graph->root.target] = 1;
+        while (num_frames > 0) {
+            uint32_t v = frames[num_frames - 1];
+            const WasmNode* node = &graph->nodes[v];
+            if (positions[num_frames - 1] < node->num_edges) {
+                uint32_t w = graph->edges[node->first_edge + positions[num_frames - 1]++].target;
+                if (visited[w]) continue;
+                visited[w] = 1;
+                frames[num_frames] = w;
+                positions[num_frames++] = 0;
+                continue;
+            }
+            by_rpo[num_post++] = v;
+            num_frames--;
+        }
+        num_reached = num_post;
+        for (size_t i = 0; i < num_reached / 2; i++) {
+            uint32_t swap = by_rpo[i];
+            by_rpo[i] = by_rpo[num_reached - 1 - i];
+            by_rpo[num_reached - 1 - i] = swap;
+        }
+        for (size_t i = 0; i < num_reached; i++) graph->nodes[by_rpo[i]].rpo = (uint32_t)i;
+        memset(forward_in, 0, sizeof(uint32_t) * n);
+    }
+
+    // 2. Öncüller (sadece ulaşılan düğümlerden)
+    if (ok) {
+        for (size_t v = 0; v < n; v++) {
+            const WasmNode* node = &graph->nodes[v];
+            if (node->rpo == WASM_NO_NODE) continue;
+            for (uint32_t e = 0; e < node->num_edges; e++) pred_starts[graph->edges[node->first_edge + e].target + 1]++;
+        }
+        for (size_t v = 0; v < n; v++) pred_starts[v + 1] += pred_starts[v];
+        memcpy(positions, pred_starts, sizeof(uint32_t) * n);
+        for (size_t v = 0; v < n; v++) {
+            const WasmNode* node = &graph->nodes[v];
+            if (node->rpo == WASM_NO_NODE) continue;
+            for (uint32_t e = 0; e < node->num_edges; e++) {
+                preds[positions[graph->edges[node->first_edge + e].target]++] = (uint32_t)v;
+            }
+        }
+    }
+
+    // 3. Dominatörler
+    if (ok) {
+        uint32_t root = graph->root.target;
+        for (size_t v = 0; v < n; v++) graph->nodes[v].idom = WASM_NO_NODE;
+        graph->nodes[root].idom = root;
+        int changed = 1;
+        while (changed) {
+            changed = 0;
+            for (size_t i = 1; i < num_reached; i++) {
+                uint32_t v = by_rpo[i];
+                uint32_t new_idom = WASM_NO_NODE;
+                for (uint32_t p = pred_starts[v]; p < pred_starts[v + 1]; p++) {
+                    uint32_t pred = preds[p];
+                    if (graph->nodes[pred].idom == WASM_NO_NODE) continue;
+                    new_idom = new_idom == WASM_NO_NODE ? pred : wasm_intersect(graph, pred, new_idom);
+                }
+                if (graph->nodes[v].idom != new_idom) {
+                    graph->nodes[v].idom = new_idom;
+                    changed = 1;
+                }
+            }
+        }
+    }
+
+    // 4. Döngü başları ve birleşme düğümleri
+    for (size_t v = 0; v < n && ok; v++) {
+        const WasmNode* node = &graph->nodes[v];
+        if (node->rpo == WASM_NO_NODE) continue;
+        for (uint32_t e = 0; e < node->num_edges; e++) {
+            uint32_t target = graph->edges[node->first_edge + e].target;
+            if (graph->nodes[target].rpo > node->rpo) {
+                forward_in[target]++;
+                continue;
+            }
+            uint32_t dominator = (uint32_t)v;
+            while (dominator != target && graph->nodes[dominator].idom != dominator) {
+                dominator = graph->nodes[dominator].idom;
+            }
+            if (dominator != target) {
+                fprintf(stderr, "Hata: WASM üretimi: kontrol akışı yapısallaştırılamadı (indirgenemez döngü).\n");
+                ok = 0;
+                break;
+            }
+            if (!graph->nodes[target].is_loop) graph->num_loops++;
+            graph->nodes[target].is_loop = 1;
+        }
+    }
+    for (size_t v = 0; v < n && ok; v++) graph->nodes[v].is_merge = forward_in[v] >= 2;
+
+    // 5. Dominatör ağacı (çocuklar ters sonsıra sırasıyla)
+    if (ok) {
+        for (size_t i = 1; i < num_reached; i++) graph->nodes[graph->nodes[by_rpo[i]].idom].num_children++;
+        uint32_t offset = 0;
+        for (size_t i = 0; i < num_reached; i++) {
+            WasmNode* node = &graph->nodes[by_rpo[i]];
+            node->first_child = offset;
+            offset += node->num_children;
+            node->num_children = 0;
+        }
+        for (size_t i = 1; i < num_reached; i++) {
+            WasmNode* parent = &graph->nodes[graph->nodes[by_rpo[i]].idom];
+            graph->children[parent->first_child + parent->num_children++] = by_rpo[i];
+        }
+    }
+    free(by_rpo);
+    free(frames);
+    free(positions);
+    free(pred_starts);
+    free(preds);
+    free(forward_in);
+    return ok;
+}
+
+// --- Komut Üretimi ---
+
+/**
+ * @brief Sanal kaydedicinin kökeni olan mimari kaydediciyi (yerel değişken indeksi) döndürür.
+ * @return Kaydedici indeksi veya kökeni yoksa -1.
+ */
+static int wasm_register(const IrFunction* fn, uint16_t vreg) {
+    int origin = fn->vregs[vreg].origin;
+    if (origin < 0 || origin >= IR_NUM_REGISTERS) {
+        fprintf(stderr, "Hata: WASM üretimi: v%u bir mimari kaydediciye eşlenemiyor.\n", vreg);
+        return -1;
+    }
+    return origin;
+}
+
+static int wasm_put_get(WasmBuffer* out, const IrFunction* fn, uint16_t vreg) {
+    int reg = wasm_register(fn, vreg);
+    if (reg < 0) return 0;
+    wasm_put_op(out, WASM_OP_LOCAL_GET, (uint32_t)reg);
+    return 1;
+}
+
+static int wasm_put_set(WasmBuffer* out, const IrFunction* fn, uint16_t vreg, uint8_t opcode) {
+    int reg = wasm_register(fn, vreg);
+    if (reg < 0) return 0;
+    wasm_put_op(out, opcode, (uint32_t)reg);
+    return 1;
+}
+
+/**
+ * @brief Komutun ikinci kaynağını (b) yığına koyar.
+ */
+static int wasm_put_operand(WasmBuffer* out, const IrFunction* fn, const IrInstr* instr) {
+    if (instr->attrs & IR_ATTR_IMM) {
+        wasm_put_i64_const(out, ir_instr_immediate(fn, instr));
+        return 1;
+    }
+    return wasm_put_get(out, fn, instr->u.op.src2);
+}
+
+static IrCondition wasm_invert_condition(IrCondition cond) {
+    switch (cond) {
+        case IR_COND_EQ: return IR_COND_NE;
+        case IR_COND_NE: return IR_COND_EQ;
+        case IR_COND_LT: return IR_COND_GE;
+        case IR_COND_GT: return IR_COND_LE;
+        case IR_COND_LE: return IR_COND_GT;
+        default: return IR_COND_LT;
+    }
+}
+
+/**
+ * @brief Bayrak çiftinin koşulunu i32 olarak yığına koyar.
+ */
+static void wasm_put_condition(WasmBuffer* out, IrCondition cond) {
+    static const uint8_t compare[] = {
+        WASM_OP_I64_EQ, WASM_OP_I64_NE, WASM_OP_I64_LT_S, WASM_OP_I64_GT_S, WASM_OP_I64_LE_S, WASM_OP_I64_GE_S,
+    };
+    wasm_put_op(out, WASM_OP_LOCAL_GET, WASM_LOCAL_FLAG_A);
+    wasm_put_op(out, WASM_OP_LOCAL_GET, WASM_LOCAL_FLAG_B);
+    wasm_put_byte(out, compare[cond < IR_COND_NONE ? cond : IR_COND_EQ]);
+}
+
+static void wasm_put_registers(WasmBuffer* out) {
+    for (uint32_t r = 0; r < IR_NUM_REGISTERS; r++) wasm_put_op(out, WASM_OP_LOCAL_GET, r);
+}
+
+static void wasm_put_return(WasmBuffer* out) {
+    wasm_put_registers(out);
+    wasm_put_byte(out, WASM_OP_RETURN);
+}
+
+/**
+ * @brief Programı bitirir: kaydediciler belleğe yazılmış olmalıdır; çağıranlar HALTED'ı görüp döner.
+ */
+static void wasm_put_halt(WasmBuffer* out) {
+    wasm_put_i32_const(out, 1);
+    wasm_put_op(out, WASM_OP_GLOBAL_SET, WASM_GLOBAL_HALTED);
+    wasm_put_return(out);
+}
+
+static int wasm_emit_instruction(WasmEmitter* emitter, const IrInstr* instr) {
+    const IrFunction* fn = emitter->fn;
+    WasmBuffer* out = &emitter->body;
+    switch ((IrOpcode)instr->opcode) {
+        case IR_OP_MOV:
+            return wasm_put_operand(out, fn, instr) && wasm_put_set(out, fn, instr->dst, WASM_OP_LOCAL_SET);
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL: {
+            static const uint8_t arithmetic[] = {WASM_OP_I64_ADD, WASM_OP_I64_SUB, WASM_OP_I64_MUL};
+            if (!wasm_put_get(out, fn, instr->u.op.src1) || !wasm_put_operand(out, fn, instr)) return 0;
+            wasm_put_byte(out, arithmetic[instr->opcode - IR_OP_ADD]);
+            int sets_flags = instr->opcode != IR_OP_MUL && instr->flags != IR_NO_VREG &&
+                             !(instr->attrs & IR_ATTR_FLAGS_CLOBBER);
+            if (!sets_flags) return wasm_put_set(out, fn, instr->dst, WASM_OP_LOCAL_SET);
+            // Bayraklar (sonuç, 0) karşılaştırmasıdır
+            if (!wasm_put_set(out, fn, instr->dst, WASM_OP_LOCAL_TEE)) return 0;
+            wasm_put_op(out, WASM_OP_LOCAL_SET, WASM_LOCAL_FLAG_A);
+            wasm_put_i64_const(out, 0);
+            wasm_put_op(out, WASM_OP_LOCAL_SET, WASM_LOCAL_FLAG_B);
+            return 1;
+        }
+        case IR_OP_DIV: {
+            // Sıfıra bölme wasm'da tuzaktır (BVM'deki yürütme hatası); INT64_MIN / -1 ise sarmalı
+            // sonuç (INT64_MIN) vermelidir, div_s tuzağa düşeceği için -1 ayrıca işlenir
+            if (instr->attrs & IR_ATTR_IMM) {
+                int64_t divisor = ir_instr_immediate(fn, instr);
+                if (divisor == -1) {
+                    wasm_put_i64_const(out, 0);
+                    if (!wasm_put_get(out, fn, instr->u.op.src1)) return 0;
+                    wasm_put_byte(out, WASM_OP_I64_SUB);
+                } else {
+                    if (!wasm_put_get(out, fn, instr->u.op.src1)) return 0;
+                    wasm_put_i64_const(out, divisor);
+                    wasm_put_byte(out, WASM_OP_I64_DIV_S);
+                }
+                return wasm_put_set(out, fn, instr->dst, WASM_OP_LOCAL_SET);
+            }
+            if (!wasm_put_get(out, fn, instr->u.op.src2)) return 0;
+            wasm_put_i64_const(out, -1);
+            wasm_put_byte(out, WASM_OP_I64_EQ);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_TYPE_I64);
+            wasm_put_i64_const(out, 0);
+            if (!wasm_put_get(out, fn, instr->u.op.src1)) return 0;
+            wasm_put_byte(out, WASM_OP_I64_SUB);
+            wasm_put_byte(out, WASM_OP_ELSE);
+            if (!wasm_put_get(out, fn, instr->u.op.src1) || !wasm_put_get(out, fn, instr->u.op.src2)) return 0;
+            wasm_put_byte(out, WASM_OP_I64_DIV_S);
+            wasm_put_byte(out, WASM_OP_END);
+            return wasm_put_set(out, fn, instr->dst, WASM_OP_LOCAL_SET);
+        }
+        case IR_OP_CMP:
+            if (!wasm_put_get(out, fn, instr->u.op.src1)) return 0;
+            wasm_put_op(out, WASM_OP_LOCAL_SET, WASM_LOCAL_FLAG_A);
+            if (!wasm_put_operand(out, fn, instr)) return 0;
+            wasm_put_op(out, WASM_OP_LOCAL_SET, WASM_LOCAL_FLAG_B);
+            return 1;
+        case IR_OP_SEL:
+            if (!wasm_put_operand(out, fn, instr) || !wasm_put_get(out, fn, instr->u.op.src1)) return 0;
+            wasm_put_condition(out, (IrCondition)instr->cond);
+            wasm_put_byte(out, WASM_OP_SELECT);
+            return wasm_put_set(out, fn, instr->dst, WASM_OP_LOCAL_SET);
+        case IR_OP_CALL: {
+            // Derinlik sınırı BVM ile aynıdır; program çağrılan tarafta bittiyse hemen dönülür
+            wasm_put_op(out, WASM_OP_GLOBAL_GET, WASM_GLOBAL_DEPTH);
+            wasm_put_i32_const(out, WASM_MAX_CALL_DEPTH);
+            wasm_put_byte(out, WASM_OP_I32_GE_U);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_BLOCK_EMPTY);
+            wasm_put_byte(out, WASM_OP_UNREACHABLE);
+            wasm_put_byte(out, WASM_OP_END);
+            wasm_put_op(out, WASM_OP_GLOBAL_GET, WASM_GLOBAL_DEPTH);
+            wasm_put_i32_const(out, 1);
+            wasm_put_byte(out, WASM_OP_I32_ADD);
+            wasm_put_op(out, WASM_OP_GLOBAL_SET, WASM_GLOBAL_DEPTH);
+            wasm_put_registers(out);
+            wasm_put_op(out, WASM_OP_CALL,
+                        emitter->first_region_function + emitter->region_of_block[instr->u.br.taken]);
+            for (uint32_t r = IR_NUM_REGISTERS; r-- > 0;) wasm_put_op(out, WASM_OP_LOCAL_SET, r);
+            wasm_put_op(out, WASM_OP_GLOBAL_GET, WASM_GLOBAL_DEPTH);
+            wasm_put_i32_const(out, 1);
+            wasm_put_byte(out, WASM_OP_I32_SUB);
+            wasm_put_op(out, WASM_OP_GLOBAL_SET, WASM_GLOBAL_DEPTH);
+            wasm_put_op(out, WASM_OP_GLOBAL_GET, WASM_GLOBAL_HALTED);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_BLOCK_EMPTY);
+            wasm_put_return(out);
+            wasm_put_byte(out, WASM_OP_END);
+            return 1;
+        }
+        case IR_OP_SYSCALL: {
+            const IrSyscall* syscall = &fn->syscalls[instr->u.op.imm];
+            if (syscall->num_args > WASM_MAX_SYSCALL_ARGS) {
+                fprintf(stderr, "Hata: WASM üretimi: sistem çağrısı %lld en fazla %d argüman alabilir.\n",
+                        (long long)syscall->number, WASM_MAX_SYSCALL_ARGS);
+                return 0;
+            }
+            wasm_put_registers(out);
+            wasm_put_op(out, WASM_OP_CALL, emitter->store_function);
+            if (syscall->number == WASM_SYS_EXIT || syscall->number == WASM_SYS_EXIT_GROUP) {
+                // exit(kod): ilk argüman (yoksa R0) çıkış kodudur
+                wasm_put_i32_const(out, 0);
+                wasm_put_op(out, WASM_OP_LOCAL_GET, syscall->num_args > 0 ? fn->pool[syscall->first_arg] : 0);
+                wasm_put_memory_op(out, WASM_OP_I64_STORE, WASM_EXIT_CODE_OFFSET);
+                wasm_put_halt(out);
+                return 1;
+            }
+            for (uint32_t a = 0; a < syscall->num_args; a++) {
+                wasm_put_i32_const(out, 0);
+                wasm_put_op(out, WASM_OP_LOCAL_GET, fn->pool[syscall->first_arg + a]);
+                wasm_put_memory_op(out, WASM_OP_I64_STORE, WASM_SYSCALL_ARGS_OFFSET + 8 * a);
+            }
+            wasm_put_i64_const(out, syscall->number);
+            wasm_put_i32_const(out, (int32_t)syscall->num_args);
+            wasm_put_op(out, WASM_OP_CALL, emitter->syscall_function);
+            wasm_put_op(out, WASM_OP_LOCAL_TEE, WASM_LOCAL_STATUS);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_BLOCK_EMPTY);
+            wasm_put_op(out, WASM_OP_LOCAL_GET, WASM_LOCAL_STATUS);
+            wasm_put_i32_const(out, 1);
+            wasm_put_byte(out, WASM_OP_I32_NE);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_BLOCK_EMPTY);
+            wasm_put_byte(out, WASM_OP_UNREACHABLE);
+            wasm_put_byte(out, WASM_OP_END);
+            wasm_put_halt(out);
+            wasm_put_byte(out, WASM_OP_END);
+            // İşleyici kaydedicileri değiştirmiş olabilir
+            for (uint32_t r = 0; r < IR_NUM_REGISTERS; r++) {
+                wasm_put_i32_const(out, 0);
+                wasm_put_memory_op(out, WASM_OP_I64_LOAD, WASM_REGISTERS_OFFSET + 8 * r);
+                wasm_put_op(out, WASM_OP_LOCAL_SET, r);
+            }
+            return 1;
+        }
+        case IR_OP_PROFCNT: {
+            uint32_t offset = WASM_COUNTERS_OFFSET + 8 * (uint32_t)instr->u.op.imm;
+            wasm_put_i32_const(out, 0);
+            wasm_put_i32_const(out, 0);
+            wasm_put_memory_op(out, WASM_OP_I64_LOAD, offset);
+            wasm_put_i64_const(out, 1);
+            wasm_put_byte(out, WASM_OP_I64_ADD);
+            wasm_put_memory_op(out, WASM_OP_I64_STORE, offset);
+            return 1;
+        }
+        case IR_OP_PROFDUMP:
+            wasm_put_op(out, WASM_OP_CALL, emitter->profile_dump_function);
+            return 1;
+        default:
+            fprintf(stderr, "Hata: WASM üretimi: beklenmeyen IR komutu '%s'.\n",
+                    ir_opcode_to_string((IrOpcode)instr->opcode));
+            return 0;
+    }
+}
+
+// --- Yapısal Kontrol Akışı ---
+
+static int wasm_push_scope(WasmGraph* graph, WasmScopeKind kind, uint32_t node) {
+    if (!wasm_grow((void**)&graph->scopes, &graph->scope_capacity, graph->num_scopes + 1, sizeof(WasmScope))) return 0;
+    graph->scopes[graph->num_scopes].kind = (uint8_t)kind;
+    graph->scopes[graph->num_scopes].node = node;
+    graph->num_scopes++;
+    return 1;
+}
+
+/**
+ * @brief 'source' düğümünden 'target'a giden dalın "br" derinliğini bulur: geri kenarlar
+ * hedefin "loop"una, ileri kenarlar hedefin önünde biten "block"a gider.
+ * @return Derinlik veya hedef gömülecekse (dal etiketi yoksa) -1.
+ */
+static long wasm_branch_depth(const WasmGraph* graph, uint32_t source, uint32_t target) {
+    WasmScopeKind kind = graph->nodes[target].rpo <= graph->nodes[source].rpo ? WASM_SCOPE_LOOP : WASM_SCOPE_BLOCK;
+    for (size_t i = graph->num_scopes; i-- > 0;) {
+        if (graph->scopes[i].kind == kind && graph->scopes[i].node == target) return (long)(graph->num_scopes - 1 - i);
+    }
+    return -1;
+}
+
+static int wasm_emit_tree(WasmEmitter* emitter, WasmGraph* graph, uint32_t node);
+
+static int wasm_emit_branch(WasmEmitter* emitter, WasmGraph* graph, uint32_t source, const WasmEdge* edge) {
+    WasmBuffer* out = &emitter->body;
+    if (edge->dispatch >= 0) {
+        wasm_put_i32_const(out, edge->dispatch);
+        wasm_put_op(out, WASM_OP_LOCAL_SET, WASM_LOCAL_LABEL);
+    }
+    uint32_t target = edge->target;
+    long depth = wasm_branch_depth(graph, source, target);
+    if (depth >= 0) {
+        wasm_put_op(out, WASM_OP_BR, (uint64_t)depth);
+        return 1;
+    }
+    // Tek ileri kenarla girilen ve domine edilen hedef dalın yerine yazılır
+    if (graph->nodes[target].idom == source && !graph->nodes[target].is_merge &&
+        graph->nodes[target].rpo > graph->nodes[source].rpo) {
+        return wasm_emit_tree(emitter, graph, target);
+    }
+    fprintf(stderr, "Hata: WASM üretimi: dal hedefi yapısal kontrol akışında bulunamadı.\n");
+    return 0;
+}
+
+/**
+ * @brief Tüm hedefleri dal etiketi olan çok yönlü bir dal yazar (indeks yığındadır).
+ */
+static int wasm_emit_table(WasmEmitter* emitter, WasmGraph* graph, uint32_t source) {
+    WasmBuffer* out = &emitter->body;
+    const WasmNode* node = &graph->nodes[source];
+    wasm_put_op(out, WASM_OP_BR_TABLE, node->num_edges - 1);
+    for (uint32_t e = 0; e < node->num_edges; e++) {
+        const WasmEdge* edge = &graph->edges[node->first_edge + e];
+        long depth = edge->dispatch < 0 ? wasm_branch_depth(graph, source, edge->target) : -1;
+        if (depth < 0) {
+            fprintf(stderr, "Hata: WASM üretimi: atlama tablosu hedefi yapısal kontrol akışında bulunamadı.\n");
+            return 0;
+        }
+        wasm_put_uleb(out, (uint64_t)depth);
+    }
+    return 1;
+}
+
+static int wasm_emit_node(WasmEmitter* emitter, WasmGraph* graph, uint32_t index) {
+    const IrFunction* fn = emitter->fn;
+    WasmBuffer* out = &emitter->body;
+    const WasmNode* node = &graph->nodes[index];
+    const WasmEdge* edges = graph->edges + node->first_edge;
+    if (node->kind == WASM_NODE_DISPATCH) {
+        wasm_put_op(out, WASM_OP_LOCAL_GET, WASM_LOCAL_LABEL);
+        return wasm_emit_table(emitter, graph, index);
+    }
+    if (node->kind == WASM_NODE_TRAMPOLINE) return wasm_emit_branch(emitter, graph, index, &edges[0]);
+
+    const IrBlock* block = &fn->blocks[node->block];
+    for (uint32_t k = 0; k + 1 < block->num_instrs; k++) {
+        if (!wasm_emit_instruction(emitter, &fn->instrs[block->first + k])) return 0;
+    }
+    const IrInstr* terminator = &fn->instrs[block->first + block->num_instrs - 1];
+    switch ((IrOpcode)terminator->opcode) {
+        case IR_OP_JMP:
+            return wasm_emit_branch(emitter, graph, index, &edges[0]);
+        case IR_OP_BR: {
+            WasmEdge taken = edges[0], fallthrough = edges[1];
+            long taken_depth = taken.dispatch < 0 ? wasm_branch_depth(graph, index, taken.target) : -1;
+            long fallthrough_depth = fallthrough.dispatch < 0 ? wasm_branch_depth(graph, index, fallthrough.target) : -1;
+            if (taken_depth >= 0 || fallthrough_depth >= 0) {
+                int use_taken = taken_depth >= 0;
+                IrCondition cond = (IrCondition)terminator->cond;
+                wasm_put_condition(out, use_taken ? cond : wasm_invert_condition(cond));
+                wasm_put_op(out, WASM_OP_BR_IF, (uint64_t)(use_taken ? taken_depth : fallthrough_depth));
+                return wasm_emit_branch(emitter, graph, index, use_taken ? &fallthrough : &taken);
+            }
+            wasm_put_condition(out, (IrCondition)terminator->cond);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_BLOCK_EMPTY);
+            if (!wasm_push_scope(graph, WASM_SCOPE_IF, index) || !wasm_emit_branch(emitter, graph, index, &taken)) {
+                return 0;
+            }
+            wasm_put_byte(out, WASM_OP_ELSE);
+            if (!wasm_emit_branch(emitter, graph, index, &fallthrough)) return 0;
+            graph->num_scopes--;
+            wasm_put_byte(out, WASM_OP_END);
+            return 1;
+        }
+        case IR_OP_JTAB: {
+            // İndeks = değer - en küçük; aralık dışı (işaretsiz karşılaştırmayla) varsayılan hedeftir
+            const IrJumpTable* table = &fn->jump_tables[terminator->u.op.imm];
+            if (!wasm_put_get(out, fn, terminator->u.op.src1)) return 0;
+            wasm_put_i64_const(out, table->min);
+            wasm_put_byte(out, WASM_OP_I64_SUB);
+            wasm_put_op(out, WASM_OP_LOCAL_TEE, WASM_LOCAL_TEMP);
+            wasm_put_i64_const(out, (int64_t)table->num_targets);
+            wasm_put_byte(out, WASM_OP_I64_LT_U);
+            wasm_put_byte(out, WASM_OP_IF);
+            wasm_put_byte(out, WASM_TYPE_I32);
+            wasm_put_op(out, WASM_OP_LOCAL_GET, WASM_LOCAL_TEMP);
+            wasm_put_byte(out, WASM_OP_I32_WRAP_I64);
+            wasm_put_byte(out, WASM_OP_ELSE);
+            wasm_put_i32_const(out, (int32_t)table->num_targets);
+            wasm_put_byte(out, WASM_OP_END);
+            return wasm_emit_table(emitter, graph, index);
+        }
+        case IR_OP_RET:
+            wasm_put_return(out);
+            return 1;
+        case IR_OP_END:
+            // Programın sonu: çıkış kodu 0
+            wasm_put_registers(out);
+            wasm_put_op(out, WASM_OP_CALL, emitter->store_function);
+            wasm_put_i32_const(out, 0);
+            wasm_put_i64_const(out, 0);
+            wasm_put_memory_op(out, WASM_OP_I64_STORE, WASM_EXIT_CODE_OFFSET);
+            wasm_put_halt(out);
+            return 1;
+        default:
+            fprintf(stderr, "Hata: WASM üretimi: blok %u bir sonlandırıcıyla bitmiyor.\n", node->block);
+            return 0;
+    }
+}
+
+/**
+ * @brief Dominatör ağacında 'node'un etiketli çocuklarından i'ncisini döndürür. Birleşme
+ * düğümleri ve br_table ile dallanan düğümlerin tüm çocukları "block" sonuna yazılır.
+ */
+static uint32_t wasm_labeled_child(const WasmGraph* graph, uint32_t node, size_t i) {
+    const WasmNode* parent = &graph->nodes[node];
+    for (uint32_t c = 0; c < parent->num_children; c++) {
+        uint32_t child = graph->children[parent->first_child + c];
+        if (!parent->is_switch && !graph->nodes[child].is_merge) continue;
+        if (i-- == 0) return child;
+    }
+    return WASM_NO_NODE;
+}
+
+/**
+ * @brief Düğümü, etiketli çocuklarının ilk 'count' tanesini saran "block"ların içine yazar:
+ * en büyük ters sonsıralı çocuk en dıştadır ve kodu kendi bloğunun hemen arkasındadır.
+ */
+static int wasm_emit_within(WasmEmitter* emitter, WasmGraph* graph, uint32_t node, size_t count) {
+    if (count == 0) return wasm_emit_node(emitter, graph, node);
+    uint32_t child = wasm_labeled_child(graph, node, count - 1);
+    wasm_put_byte(&emitter->body, WASM_OP_BLOCK);
+    wasm_put_byte(&emitter->body, WASM_BLOCK_EMPTY);
+    if (!wasm_push_scope(graph, WASM_SCOPE_BLOCK, child) || !wasm_emit_within(emitter, graph, node, count - 1)) {
+        return 0;
+    }
+    graph->num_scopes--;
+    wasm_put_byte(&emitter->body, WASM_OP_END);
+    return wasm_emit_tree(emitter, graph, child);
+}
+
+static int wasm_emit_tree(WasmEmitter* emitter, WasmGraph* graph, uint32_t node) {
+    size_t count = 0;
+    while (wasm_labeled_child(graph, node, count) != WASM_NO_NODE) count++;
+    if (!graph->nodes[node].is_loop) return wasm_emit_within(emitter, graph, node, count);
+    wasm_put_byte(&emitter->body, WASM_OP_LOOP);
+    wasm_put_byte(&emitter->body, WASM_BLOCK_EMPTY);
+    if (!wasm_push_scope(graph, WASM_SCOPE_LOOP, node) || !wasm_emit_within(emitter, graph, node, count)) return 0;
+    graph->num_scopes--;
+    wasm_put_byte(&emitter->body, WASM_OP_END);
+    return 1;
+}
+
+static void wasm_graph_free(WasmGraph* graph) {
+    free(graph->nodes);
+    free(graph->edges);
+    free(graph->node_of_block);
+    free(graph->children);
+    free(graph->scopes);
+}
+
+/**
+ * @brief Bir alt programı wasm fonksiyonuna çevirip gövdesini kod bölümüne ekler.
+ */
+static int wasm_emit_region(WasmEmitter* emitter, uint32_t entry_block) {
+    const IrFunction* fn = emitter->fn;
+    WasmGraph graph;
+    memset(&graph, 0, sizeof(graph));
+    graph.entry_block = entry_block;
+    graph.node_of_block = (uint32_t*)malloc(sizeof(uint32_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    int ok = graph.node_of_block != NULL;
+    if (!ok) fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+    if (ok) ok = wasm_build_graph(emitter, &graph);
+    if (ok) {
+        size_t num_blocks = graph.num_nodes;
+        uint32_t* members = (uint32_t*)malloc(sizeof(uint32_t) * (num_blocks ? num_blocks : 1));
+        ok = members != NULL;
+        if (!ok) fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+        for (size_t n = 0; n < num_blocks && ok; n++) members[n] = (uint32_t)n;
+        if (ok) ok = wasm_fix_irreducible(&graph, members, num_blocks);
+        free(members);
+        emitter->stats.num_blocks += num_blocks;
+    }
+    if (ok) ok = wasm_analyze_graph(&graph);
+
+    // Gövde: yerel değişkenler (parametrelerden sonra) ve kod
+    WasmBuffer* out = &emitter->body;
+    out->size = 0;
+    wasm_put_uleb(out, 2);
+    wasm_put_uleb(out, 3);
+    wasm_put_byte(out, WASM_TYPE_I64); // FLAG_A, FLAG_B, TEMP
+    wasm_put_uleb(out, 2);
+    wasm_put_byte(out, WASM_TYPE_I32); // LABEL, STATUS
+    if (ok && graph.root.dispatch >= 0) {
+        wasm_put_i32_const(out, graph.root.dispatch);
+        wasm_put_op(out, WASM_OP_LOCAL_SET, WASM_LOCAL_LABEL);
+    }
+    if (ok) ok = wasm_emit_tree(emitter, &graph, graph.root.target);
+    // Döngü sonlarından sonrası doğrulayıcı için erişilebilirdir; yürütme oraya ulaşmaz
+    wasm_put_byte(out, WASM_OP_UNREACHABLE);
+    wasm_put_byte(out, WASM_OP_END);
+    if (ok) {
+        wasm_put_uleb(&emitter->code, out->size);
+        wasm_put(&emitter->code, out->data, out->size);
+        emitter->stats.num_loops += graph.num_loops;
+        emitter->stats.num_dispatchers += graph.num_dispatchers;
+    }
+    wasm_graph_free(&graph);
+    return ok;
+}
+
+/**
+ * @brief "main" ve kaydedicileri belleğe yazan yardımcı fonksiyonun gövdelerini ekler.
+ */
+static void wasm_emit_runtime(WasmEmitter* emitter) {
+    WasmBuffer* out = &emitter->body;
+    // main: () -> i64; yerel değişkenler 0-15 giriş alt programının döndürdüğü kaydediciler
+    out->size = 0;
+    wasm_put_uleb(out, 1);
+    wasm_put_uleb(out, IR_NUM_REGISTERS);
+    wasm_put_byte(out, WASM_TYPE_I64);
+    wasm_put_i32_const(out, 0);
+    wasm_put_op(out, WASM_OP_GLOBAL_SET, WASM_GLOBAL_HALTED);
+    wasm_put_i32_const(out, 0);
+    wasm_put_op(out, WASM_OP_GLOBAL_SET, WASM_GLOBAL_DEPTH);
+    for (uint32_t r = 0; r < IR_NUM_REGISTERS; r++) wasm_put_i64_const(out, 0);
+    wasm_put_op(out, WASM_OP_CALL, emitter->first_region_function);
+    for (uint32_t r = IR_NUM_REGISTERS; r-- > 0;) wasm_put_op(out, WASM_OP_LOCAL_SET, r);
+    // En dıştaki RET programı 0 çıkış koduyla bitirir
+    wasm_put_op(out, WASM_OP_GLOBAL_GET, WASM_GLOBAL_HALTED);
+    wasm_put_byte(out, WASM_OP_I32_EQZ);
+    wasm_put_byte(out, WASM_OP_IF);
+    wasm_put_byte(out, WASM_BLOCK_EMPTY);
+    wasm_put_registers(out);
+    wasm_put_op(out, WASM_OP_CALL, emitter->store_function);
+    wasm_put_i32_const(out, 0);
+    wasm_put_i64_const(out, 0);
+    wasm_put_memory_op(out, WASM_OP_I64_STORE, WASM_EXIT_CODE_OFFSET);
+    wasm_put_byte(out, WASM_OP_END);
+    wasm_put_i32_const(out, 0);
+    wasm_put_memory_op(out, WASM_OP_I64_LOAD, WASM_EXIT_CODE_OFFSET);
+    wasm_put_byte(out, WASM_OP_END);
+    wasm_put_uleb(&emitter->code, out->size);
+    wasm_put(&emitter->code, out->data, out->size);
+
+    // Kaydedicileri belleğe yaz: (i64 x 16) -> ()
+    out->size = 0;
+    wasm_put_uleb(out, 0);
+    for (uint32_t r = 0; r < IR_NUM_REGISTERS; r++) {
+        wasm_put_i32_const(out, 0);
+        wasm_put_op(out, WASM_OP_LOCAL_GET, r);
+        wasm_put_memory_op(out, WASM_OP_I64_STORE, WASM_REGISTERS_OFFSET + 8 * r);
+    }
+    wasm_put_byte(out, WASM_OP_END);
+    wasm_put_uleb(&emitter->code, out->size);
+    wasm_put(&emitter->code, out->data, out->size);
+}
+
+// --- Modül ---
+
+static void wasm_put_function_type(WasmBuffer* out, size_t num_params, uint8_t param, size_t num_results,
+                                   uint8_t result) {
+    wasm_put_byte(out, WASM_TYPE_FUNC);
+    wasm_put_uleb(out, num_params);
+    for (size_t i = 0; i < num_params; i++) wasm_put_byte(out, param);
+    wasm_put_uleb(out, num_results);
+    for (size_t i = 0; i < num_results; i++) wasm_put_byte(out, result);
+}
+
+/**
+ * @brief Bir bölümü (kimlik, LEB128 boyut, içerik) dosyaya yazar ve içerik arabelleğini boşaltır.
+ */
+static int wasm_write_section(FILE* file, uint8_t id, WasmBuffer* section, size_t* file_size) {
+    WasmBuffer header = {0};
+    wasm_put_byte(&header, id);
+    wasm_put_uleb(&header, section->size);
+    int ok = !header.failed && !section->failed && fwrite(header.data, 1, header.size, file) == header.size &&
+             fwrite(section->data, 1, section->size, file) == section->size;
+    *file_size += header.size + section->size;
+    free(header.data);
+    section->size = 0;
+    return ok;
+}
+
+int wasm_emit_file(const IrFunction* fn, const char* path, WasmEmitStats* stats) {
+    WasmEmitter emitter;
+    memset(&emitter, 0, sizeof(emitter));
+    emitter.fn = fn;
+    emitter.region_of_block = (uint32_t*)malloc(sizeof(uint32_t) * (fn->num_blocks ? fn->num_blocks : 1));
+    int ok = emitter.region_of_block != NULL && fn->num_blocks > 0 &&
+             wasm_grow((void**)&emitter.regions, &emitter.region_capacity, 1, sizeof(uint32_t));
+    if (!ok) fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+
+    // 1. İçe aktarmalar ve sayaçlar (fonksiyon indeksleri bunlara bağlıdır)
+    for (size_t i = 0; i < fn->num_instrs && ok; i++) {
+        const IrInstr* instr = &fn->instrs[i];
+        if (instr->opcode == IR_OP_SYSCALL) {
+            int64_t number = fn->syscalls[instr->u.op.imm].number;
+            if (number != WASM_SYS_EXIT && number != WASM_SYS_EXIT_GROUP) emitter.uses_syscall = 1;
+        } else if (instr->opcode == IR_OP_PROFDUMP) {
+            emitter.uses_profile_dump = 1;
+        } else if (instr->opcode == IR_OP_PROFCNT && (uint32_t)instr->u.op.imm >= emitter.num_counters) {
+            emitter.num_counters = (uint32_t)instr->u.op.imm + 1;
+        }
+    }
+    uint32_t num_imports = (uint32_t)(emitter.uses_syscall + emitter.uses_profile_dump);
+    emitter.syscall_function = 0;
+    emitter.profile_dump_function = (uint32_t)emitter.uses_syscall;
+    emitter.main_function = num_imports;
+    emitter.store_function = num_imports + 1;
+    emitter.first_region_function = num_imports + 2;
+
+    // 2. Kod bölümü: çalışma zamanı yardımcıları ve alt programlar (listeye CALL hedefleri eklenir)
+    if (ok) {
+        for (size_t b = 0; b < fn->num_blocks; b++) emitter.region_of_block[b] = WASM_NO_NODE;
+        emitter.region_of_block[0] = 0;
+        emitter.regions[emitter.num_regions++] = 0;
+        wasm_emit_runtime(&emitter);
+    }
+    for (size_t r = 0; r < emitter.num_regions && ok; r++) ok = wasm_emit_region(&emitter, emitter.regions[r]);
+    if (ok && (emitter.code.failed || emitter.body.failed)) {
+        fprintf(stderr, "Hata: WASM üretimi için bellek tahsis edilemedi.\n");
+        ok = 0;
+    }
+    emitter.stats.num_functions = emitter.num_regions;
+
+    // 3. Bölümler üretildikçe dosyaya yazılır
+    FILE* file = NULL;
+    if (ok) {
+        file = fopen(path, "wb");
+        if (!file) {
+            fprintf(stderr, "Hata: '%s' WASM dosyası yazmak için açılamadı.\n", path);
+            ok = 0;
+        }
+    }
+    WasmBuffer section = {0};
+    if (ok) {
+        uint8_t preamble[8] = {0, 'a', 's', 'm', WASM_VERSION, 0, 0, 0};
+        ok = fwrite(preamble, 1, sizeof(preamble), file) == sizeof(preamble);
+        emitter.stats.file_size = sizeof(preamble);
+    }
+    if (ok) {
+        wasm_put_uleb(&section, 5);
+        wasm_put_function_type(&section, 0, 0, 1, WASM_TYPE_I64);
+        wasm_put_function_type(&section, IR_NUM_REGISTERS, WASM_TYPE_I64, IR_NUM_REGISTERS, WASM_TYPE_I64);
+        wasm_put_byte(&section, WASM_TYPE_FUNC);
+        wasm_put_uleb(&section, 2);
+        wasm_put_byte(&section, WASM_TYPE_I64);
+        wasm_put_byte(&section, WASM_TYPE_I32);
+        wasm_put_uleb(&section, 1);
+        wasm_put_byte(&section, WASM_TYPE_I32);
+        wasm_put_function_type(&section, 0, 0, 0, 0);
+        wasm_put_function_type(&section, IR_NUM_REGISTERS, WASM_TYPE_I64, 0, 0);
+        ok = wasm_write_section(file, WASM_SECTION_TYPE, &section, &emitter.stats.file_size);
+    }
+    if (ok && num_imports > 0) {
+        wasm_put_uleb(&section, num_imports);
+        if (emitter.uses_syscall) {
+            wasm_put_name(&section, "bsm");
+            wasm_put_name(&section, "syscall");
+            wasm_put_byte(&section, WASM_EXTERNAL_FUNC);
+            wasm_put_uleb(&section, WASM_TYPE_SYSCALL);
+        }
+        if (emitter.uses_profile_dump) {
+            wasm_put_name(&section, "bsm");
+            wasm_put_name(&section, "profile_dump");
+            wasm_put_byte(&section, WASM_EXTERNAL_FUNC);
+            wasm_put_uleb(&section, WASM_TYPE_VOID);
+        }
+        ok = wasm_write_section(file, WASM_SECTION_IMPORT, &section, &emitter.stats.file_size);
+    }
+    if (ok) {
+        wasm_put_uleb(&section, 2 + emitter.num_regions);
+        wasm_put_uleb(&section, WASM_TYPE_MAIN);
+        wasm_put_uleb(&section, WASM_TYPE_STORE);
+        for (size_t r = 0; r < emitter.num_regions; r++) wasm_put_uleb(&section, WASM_TYPE_REGION);
+        ok = wasm_write_section(file, WASM_SECTION_FUNCTION, &section, &emitter.stats.file_size);
+    }
+    if (ok) {
+        uint64_t memory_size = WASM_COUNTERS_OFFSET + 8 * (uint64_t)emitter.num_counters;
+        wasm_put_uleb(&section, 1);
+        wasm_put_byte(&section, 0x00); // Sadece en küçük boyut
+        wasm_put_uleb(&section, (memory_size + WASM_PAGE_SIZE - 1) / WASM_PAGE_SIZE);
+        ok = wasm_write_section(file, WASM_SECTION_MEMORY, &section, &emitter.stats.file_size);
+    }
+    if (ok) {
+        wasm_put_uleb(&section, 2);
+        for (int g = 0; g < 2; g++) {
+            wasm_put_byte(&section, WASM_TYPE_I32);
+            wasm_put_byte(&section, 0x01); // Değiştirilebilir
+            wasm_put_i32_const(&section, 0);
+            wasm_put_byte(&section, WASM_OP_END);
+        }
+        ok = wasm_write_section(file, WASM_SECTION_GLOBAL, &section, &emitter.stats.file_size);
+    }
+    if (ok) {
+        wasm_put_uleb(&section, 2);
+        wasm_put_name(&section, "main");
+        wasm_put_byte(&section, WASM_EXTERNAL_FUNC);
+        wasm_put_uleb(&section, emitter.main_function);
+        wasm_put_name(&section, "memory");
+        wasm_put_byte(&section, WASM_EXTERNAL_MEMORY);
+        wasm_put_uleb(&section, 0);
+        ok = wasm_write_section(file, WASM_SECTION_EXPORT, &section, &emitter.stats.file_size);
+    }
+    if (ok) {
+        wasm_put_uleb(&section, 2 + emitter.num_regions);
+        wasm_put(&section, emitter.code.data, emitter.code.size);
+        ok = wasm_write_section(file, WASM_SECTION_CODE, &section, &emitter.stats.file_size);
+    }
+    if (file) {
+        if (fclose(file) != 0) ok = 0;
+        if (!ok) fprintf(stderr, "Hata: '%s' WASM dosyasına yazılamadı.\n", path);
+    }
+    if (ok && stats) *stats = emitter.stats;
+
+    free(section.data);
+    free(emitter.code.data);
+    free(emitter.body.data);
+    free(emitter.regions);
+    free(emitter.region_of_block);
+    return ok;
+}
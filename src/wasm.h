@@ -0,0 +1,75 @@
+#ifndef WASM_H
+#define WASM_H
+
+#include "ir_generator.h" // IrFunction (kod üretiminin girdisi)
+#include <stdint.h> // int64_t için
+#include <stddef.h> // size_t için
+
+// --- WebAssembly (.wasm) Çıktısı ---
+// IR, WebAssembly 2.0 (çoklu dönüş değeri) modülüne çevrilir. Bessambly'nin keyfi etiket
+// atlamaları yapısal kontrol akışına geri kazanılır (dominatör ağacı üzerinden "stackifier"
+// çevirisi): döngü başları "loop", birden fazla ileri kenarla girilen bloklar "block" sonu olur,
+// tek girişli bloklar dallandıkları yere gömülür; koşullu dallar "br_if" veya "if/else"dir.
+// Birden fazla girişi olan (indirgenemez) döngüler için girişlerin önüne bir dağıtıcı düğüm
+// eklenir ($label yerel değişkeni + "br_table"); dağıtım sadece bu bölgelerde kullanılır.
+//
+// Alt programlar: giriş bloğu ve her CALL hedefi ayrı bir wasm fonksiyonudur (gövdesi hedeften
+// kenarlar boyunca ulaşılabilen bloklardır; paylaşılan bloklar her fonksiyona kopyalanır).
+// R0-R15 fonksiyonun ilk 16 yerel değişkenidir (parametreler) ve CALL/RET'te 16 değer olarak
+// taşınır; bayraklar (a, b) karşılaştırma çifti olarak iki yerel değişkendedir.
+//
+// --- Konak Arayüzü ---
+// Dışa aktarılanlar:
+//   "main"   () -> i64          Programı çalıştırır, çıkış kodunu döndürür
+//   "memory" Doğrusal bellek (düzen aşağıda)
+// İçe aktarılanlar (sadece kullanılıyorsa):
+//   "bsm" "syscall" (i64 numara, i32 argüman sayısı) -> i32
+//       Kaydediciler ve argümanlar belleğe yazılmış olarak çağrılır; işleyici kaydedicileri
+//       değiştirebilir. Dönüş: 0 devam, 1 çıkış (çıkış kodu WASM_EXIT_CODE_OFFSET'e yazılır),
+//       diğer değerler yürütme hatasıdır.
+//   "bsm" "profile_dump" () -> ()   PROFDUMP: sayaçlar WASM_COUNTERS_OFFSET'tedir
+// exit (60) ve exit_group (231) modül içinde işlenir. Yürütme hataları (sıfıra bölme, çağrı
+// yığını taşması, sistem çağrısı hatası) "unreachable" tuzağıdır. Program bittiğinde son
+// kaydedici değerleri WASM_REGISTERS_OFFSET'te bulunur.
+
+#define WASM_REGISTERS_OFFSET 0         // i64 x 16: R0-R15
+#define WASM_EXIT_CODE_OFFSET 128       // i64: çıkış kodu
+#define WASM_SYSCALL_ARGS_OFFSET 136    // i64 x WASM_MAX_SYSCALL_ARGS: sistem çağrısı argümanları
+#define WASM_COUNTERS_OFFSET 264        // u64 x sayaç sayısı: PGO sayaçları
+
+#define WASM_MAX_SYSCALL_ARGS 16
+#define WASM_MAX_CALL_DEPTH 4096        // BVM ile aynı sınır
+
+// --- Yerleşik Sistem Çağrıları (BVM ile aynı numaralar) ---
+#define WASM_SYS_EXIT 60
+#define WASM_SYS_EXIT_GROUP 231
+
+// --- Üretim İstatistikleri ---
+typedef struct {
+    size_t num_functions;       // Alt program fonksiyonları (giriş dahil)
+    size_t num_blocks;          // Fonksiyonlara yerleştirilen bloklar (kopyalar dahil)
+    size_t num_loops;           // Üretilen "loop" yapıları
+    size_t num_dispatchers;     // İndirgenemez bölgeler için eklenen dağıtıcılar
+    size_t file_size;           // Yazılan modülün boyutu (bayt)
+} WasmEmitStats;
+
+// --- Fonksiyon Prototipleri ---
+
+/**
+ * @brief Doğrulanmış IR'dan bir .wasm modülü üretir ve dosyaya yazar. Bölümler üretildikçe
+ * (LEB128 boyut önekleriyle) dosyaya aktarılır.
+ * @param fn IR fonksiyonu (ir_verify ile doğrulanmış olmalı).
+ * @param path Dosya yolu.
+ * @param stats Boş değilse istatistikler yazılır.
+ * @return Başarılıysa 1, aksi takdirde 0 (stderr'e açıklama yazılır).
+ */
+int wasm_emit_file(const IrFunction* fn, const char* path, WasmEmitStats* stats);
+
+/**
+ * @brief Bir dosya yolunun .wasm dosyası olup olmadığını uzantısından belirler.
+ * @param path Dosya yolu.
+ * @return ".wasm" ile bitiyorsa 1, aksi takdirde 0.
+ */
+int wasm_has_extension(const char* path);
+
+#endif // WASM_H
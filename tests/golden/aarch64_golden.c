@@ -0,0 +1,287 @@
+// AArch64 altın testi: kodlayıcının komut sözcükleri ve kod üreticinin nesne dosyası
+// Beklenen sözcükler llvm-mc -triple=aarch64 -show-encoding ve llvm-objdump -d -r ile doğrulanmıştır.
+#include "golden.h"
+#include "arch/aarch64/aarch64_codegen.h"
+#include <elf.h>    // R_AARCH64_*
+#include <stdio.h>  // snprintf
+
+#define NOP 0xd503201fu
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+// Kodlayıcı çağrılarının (buffer üzerinde) ürettiği sözcükleri beklenenlerle karşılaştırır
+#define EXPECT(text, calls, ...)                                                    \
+    do {                                                                            \
+        Aarch64Buffer buffer = {0};                                                 \
+        calls;                                                                      \
+        static const uint32_t expected[] = {__VA_ARGS__};                           \
+        golden_check_words(text, buffer.data, buffer.size, expected, COUNT(expected)); \
+        aarch64_buffer_free(&buffer);                                               \
+    } while (0)
+
+static void test_immediates(void) {
+    EXPECT("movz x0, #0x1234", aarch64_movz(&buffer, AARCH64_X0, 0x1234, 0), 0xd2824680);
+    EXPECT("movz x5, #0xbeef, lsl #16", aarch64_movz(&buffer, AARCH64_X5, 0xbeef, 16), 0xd2b7dde5);
+    EXPECT("movk x7, #0xcafe, lsl #48", aarch64_movk(&buffer, AARCH64_X7, 0xcafe, 48), 0xf2f95fc7);
+    EXPECT("movn x2, #0", aarch64_movn(&buffer, AARCH64_X2, 0, 0), 0x92800002);
+
+    // mov_imm: movz veya movn ile başlayıp gereken parçalara movk
+    EXPECT("mov_imm x0, 0x1234", aarch64_mov_imm(&buffer, AARCH64_X0, 0x1234), 0xd2824680);
+    EXPECT("mov_imm x19, 0x12345678", aarch64_mov_imm(&buffer, AARCH64_X19, 0x12345678),
+           0xd28acf13,  // movz x19, #0x5678
+           0xf2a24693); // movk x19, #0x1234, lsl #16
+    EXPECT("mov_imm x2, 1 << 48", aarch64_mov_imm(&buffer, AARCH64_X2, INT64_C(1) << 48), 0xd2e00022);
+    EXPECT("mov_imm x4, 0x123456789abcdef0", aarch64_mov_imm(&buffer, AARCH64_X4, INT64_C(0x123456789abcdef0)),
+           0xd29bde04,  // movz x4, #0xdef0
+           0xf2b35784,  // movk x4, #0x9abc, lsl #16
+           0xf2cacf04,  // movk x4, #0x5678, lsl #32
+           0xf2e24684); // movk x4, #0x1234, lsl #48
+    EXPECT("mov_imm x1, -1", aarch64_mov_imm(&buffer, AARCH64_X1, -1), 0x92800001);
+    EXPECT("mov_imm x5, -0x10000", aarch64_mov_imm(&buffer, AARCH64_X5, -0x10000), 0x929fffe5);
+    EXPECT("mov_imm x6, ~(0x1234 << 32)", aarch64_mov_imm(&buffer, AARCH64_X6, ~(INT64_C(0x1234) << 32)),
+           0x92c24686); // movn x6, #0x1234, lsl #32
+    EXPECT("mov_imm x3, 0xffffffff00001234", aarch64_mov_imm(&buffer, AARCH64_X3, (int64_t)UINT64_C(0xffffffff00001234)),
+           0x929db963,  // movn x3, #0xedcb
+           0xf2a00003); // movk x3, #0, lsl #16
+}
+
+static void test_arithmetic(void) {
+    EXPECT("add x1, x2, #4095", aarch64_add_imm(&buffer, AARCH64_X1, AARCH64_X2, 4095, 0), 0x913ffc41);
+    EXPECT("add x1, x2, #1, lsl #12", aarch64_add_imm(&buffer, AARCH64_X1, AARCH64_X2, 1, 1), 0x91400441);
+    EXPECT("sub sp, sp, #16", aarch64_sub_imm(&buffer, AARCH64_SP, AARCH64_SP, 16, 0), 0xd10043ff);
+    EXPECT("sub x9, x10, #7, lsl #12", aarch64_sub_imm(&buffer, AARCH64_X9, AARCH64_X10, 7, 1), 0xd1401d49);
+    EXPECT("cmp x19, #100", aarch64_cmp_imm(&buffer, AARCH64_X19, 100), 0xf101927f);
+    EXPECT("cmn x20, #1", aarch64_cmn_imm(&buffer, AARCH64_X20, 1), 0xb100069f);
+    EXPECT("mov x1, sp", aarch64_mov_sp(&buffer, AARCH64_X1, AARCH64_SP), 0x910003e1);
+    EXPECT("mov x1, x2", aarch64_mov(&buffer, AARCH64_X1, AARCH64_X2), 0xaa0203e1);
+
+    EXPECT("add x1, x2, x3", aarch64_add(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3), 0x8b030041);
+    EXPECT("sub x4, x5, x6", aarch64_sub(&buffer, AARCH64_X4, AARCH64_X5, AARCH64_X6), 0xcb0600a4);
+    EXPECT("cmp x7, x8", aarch64_cmp(&buffer, AARCH64_X7, AARCH64_X8), 0xeb0800ff);
+    EXPECT("adds x1, x2, #4095", aarch64_adds_imm(&buffer, AARCH64_X1, AARCH64_X2, 4095, 0), 0xb13ffc41);
+    EXPECT("subs x9, x10, #7, lsl #12", aarch64_subs_imm(&buffer, AARCH64_X9, AARCH64_X10, 7, 1), 0xf1401d49);
+    EXPECT("adds x1, x2, x3", aarch64_adds(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3), 0xab030041);
+    EXPECT("subs x4, x5, x6", aarch64_subs(&buffer, AARCH64_X4, AARCH64_X5, AARCH64_X6), 0xeb0600a4);
+    EXPECT("adds x1, x2, x3, lsl #3", aarch64_adds_lsl(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3, 3), 0xab030c41);
+    EXPECT("subs x4, x5, x6, lsl #1", aarch64_subs_lsl(&buffer, AARCH64_X4, AARCH64_X5, AARCH64_X6, 1), 0xeb0604a4);
+    EXPECT("neg x9, x10", aarch64_neg(&buffer, AARCH64_X9, AARCH64_X10), 0xcb0a03e9);
+    EXPECT("add x1, x2, x3, lsl #3", aarch64_add_lsl(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3, 3), 0x8b030c41);
+    EXPECT("sub x4, x5, x6, lsl #12", aarch64_sub_lsl(&buffer, AARCH64_X4, AARCH64_X5, AARCH64_X6, 12), 0xcb0630a4);
+    EXPECT("lsl x1, x2, #3", aarch64_lsl_imm(&buffer, AARCH64_X1, AARCH64_X2, 3), 0xd37df041);
+
+    EXPECT("madd x1, x2, x3, x4", aarch64_madd(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3, AARCH64_X4), 0x9b031041);
+    EXPECT("msub x5, x6, x7, x8", aarch64_msub(&buffer, AARCH64_X5, AARCH64_X6, AARCH64_X7, AARCH64_X8), 0x9b07a0c5);
+    EXPECT("mul x19, x19, x20", aarch64_mul(&buffer, AARCH64_X19, AARCH64_X19, AARCH64_X20), 0x9b147e73);
+    EXPECT("sdiv x19, x19, x16", aarch64_sdiv(&buffer, AARCH64_X19, AARCH64_X19, AARCH64_X16), 0x9ad00e73);
+    EXPECT("udiv x1, x2, x3", aarch64_udiv(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3), 0x9ac30841);
+
+    // SELcc csel'dir (kod üretici cset/csinc kullanmaz)
+    EXPECT("csel x1, x2, x3, eq", aarch64_csel(&buffer, AARCH64_X1, AARCH64_X2, AARCH64_X3, AARCH64_CC_EQ),
+           0x9a830041);
+    EXPECT("csel x4, x5, xzr, lt", aarch64_csel(&buffer, AARCH64_X4, AARCH64_X5, AARCH64_XZR, AARCH64_CC_LT),
+           0x9a9fb0a4);
+}
+
+static void test_memory(void) {
+    EXPECT("ldr x1, [x28, #8]", aarch64_ldr(&buffer, AARCH64_X1, AARCH64_X28, 8), 0xf9400781);
+    EXPECT("str x2, [sp, #32760]", aarch64_str(&buffer, AARCH64_X2, AARCH64_SP, 32760), 0xf93fffe2);
+    EXPECT("ldr x3, [x4, x5, lsl #3]", aarch64_ldr_index(&buffer, AARCH64_X3, AARCH64_X4, AARCH64_X5), 0xf8657883);
+    EXPECT("ldrsw x6, [x7, x8, lsl #2]", aarch64_ldrsw_index(&buffer, AARCH64_X6, AARCH64_X7, AARCH64_X8),
+           0xb8a878e6);
+    EXPECT("str x30, [sp, #-16]!", aarch64_str_pre(&buffer, AARCH64_X30, AARCH64_SP, -16), 0xf81f0ffe);
+    EXPECT("ldr x30, [sp], #16", aarch64_ldr_post(&buffer, AARCH64_X30, AARCH64_SP, 16), 0xf84107fe);
+    EXPECT("strb w1, [x2, #4095]", aarch64_strb(&buffer, AARCH64_X1, AARCH64_X2, 4095), 0x393ffc41);
+    EXPECT("strb w3, [x4, #-1]!", aarch64_strb_pre(&buffer, AARCH64_X3, AARCH64_X4, -1), 0x381ffc83);
+}
+
+static void test_branches(void) {
+    // İleri ve geri dallar: hedef sonradan aarch64_patch_branch ile yazılır
+    EXPECT("b.eq #8", {
+        size_t at = aarch64_b_cond(&buffer, AARCH64_CC_EQ);
+        aarch64_emit(&buffer, NOP);
+        aarch64_patch_branch(&buffer, at, 8);
+    }, 0x54000040, NOP);
+    EXPECT("b.ne #-4", {
+        aarch64_emit(&buffer, NOP);
+        aarch64_patch_branch(&buffer, aarch64_b_cond(&buffer, AARCH64_CC_NE), 0);
+    }, NOP, 0x54ffffe1);
+    EXPECT("cbz x3, #-8", {
+        aarch64_emit(&buffer, NOP);
+        aarch64_emit(&buffer, NOP);
+        aarch64_patch_branch(&buffer, aarch64_cbz(&buffer, AARCH64_X3), 0);
+    }, NOP, NOP, 0xb4ffffc3);
+    EXPECT("cbnz x4, #12", {
+        size_t at = aarch64_cbnz(&buffer, AARCH64_X4);
+        aarch64_patch_branch(&buffer, at, 12);
+    }, 0xb5000064);
+    EXPECT("bl #16", aarch64_patch_branch(&buffer, aarch64_bl(&buffer), 16), 0x94000004);
+    EXPECT("br x16", aarch64_br(&buffer, AARCH64_X16), 0xd61f0200);
+    EXPECT("ret", aarch64_ret(&buffer), 0xd65f03c0);
+    EXPECT("svc #0", aarch64_svc(&buffer, 0), 0xd4000001);
+
+    // Menzil sınırları: b.cond ±1 MB, b ±128 MB
+    {
+        Aarch64Buffer buffer = {0};
+        size_t cond = aarch64_b_cond(&buffer, AARCH64_CC_LT);
+        size_t branch = aarch64_b(&buffer);
+        golden_check("b.cond menzili", aarch64_patch_branch(&buffer, cond, AARCH64_COND_BRANCH_RANGE - 4) &&
+                                           !aarch64_patch_branch(&buffer, cond, AARCH64_COND_BRANCH_RANGE));
+        golden_check("b menzili", !aarch64_patch_branch(&buffer, branch, branch + AARCH64_BRANCH_RANGE));
+        static const uint32_t expected[] = {0x547fffeb, 0x14000000}; // b.lt #1048572, b #0
+        golden_check_words("dal menzilleri", buffer.data, buffer.size, expected, COUNT(expected));
+        aarch64_buffer_free(&buffer);
+    }
+
+    // Sembol adresi: alanları sıfır adrp + add ve iki başvuru kaydı
+    {
+        Aarch64Buffer buffer = {0};
+        aarch64_adr_symbol(&buffer, AARCH64_X28, 1, 16);
+        static const uint32_t expected[] = {0x9000001c, 0x9100039c}; // adrp x28, 0; add x28, x28, #0
+        golden_check_words("adrp + add", buffer.data, buffer.size, expected, COUNT(expected));
+        golden_check("adrp + add başvuruları",
+                     buffer.num_symbol_refs == 2 && buffer.symbol_refs[0].kind == AARCH64_REF_PAGE21 &&
+                         buffer.symbol_refs[0].position == 0 && buffer.symbol_refs[0].symbol == 1 &&
+                         buffer.symbol_refs[0].addend == 16 && buffer.symbol_refs[1].kind == AARCH64_REF_ADD_LO12 &&
+                         buffer.symbol_refs[1].position == 4 && buffer.symbol_refs[1].addend == 16);
+        aarch64_buffer_free(&buffer);
+    }
+}
+
+// aarch64_object.bsm -O0: _start, çağrı derinliği denetimi, bl/ret, sdiv ve çıkış sistem çağrısı
+static const uint32_t object_text[] = {
+    0x9000001c, // 00 adrp x28, __bsm_state
+    0x9100039c, // 04 add  x28, x28, :lo12:__bsm_state
+    0xd14043fd, // 08 sub  x29, sp, #16, lsl #12
+    0xd2800015, // 0c mov  x21, #0
+    0xd2800013, 0xd2800014, 0xd2800016, 0xd2800017, 0xd2800018, 0xd2800019, 0xd280001a, 0xd280001b,
+    0xd2800009, 0xd280000a, 0xd280000b, 0xd280000c, 0xd280000d, 0xd280000e, 0xd280000f, // mov x19..x15, #0
+    0x94000004, // 4c bl   0x5c (program gövdesi)
+    0xd2800000, // 50 mov  x0, #0
+    0xd2800bc8, // 54 mov  x8, #94 (exit_group)
+    0xd4000001, // 58 svc  #0
+    0xd28acf13, // 5c mov  x19, #0x5678            MOV R1, 0x12345678
+    0xf2a24693, // 60 movk x19, #0x1234, lsl #16
+    0xd28000f4, // 64 mov  x20, #7                 MOV R2, 7
+    0x9b147e73, // 68 mul  x19, x19, x20           MUL R1, R2
+    0xd2800070, // 6c mov  x16, #3                 DIV R1, 3
+    0x9ad00e73, // 70 sdiv x19, x19, x16
+    0xeb14027f, // 74 cmp  x19, x20                CMP R1, R2
+    0x540000eb, // 78 b.lt 0x94                    JLT SMALL
+    0x910003f0, // 7c mov  x16, sp                 CALL DOUBLE (derinlik denetimi)
+    0xeb1d021f, // 80 cmp  x16, x29
+    0x540001e9, // 84 b.ls 0xc0
+    0xf81f0ffe, // 88 str  x30, [sp, #-16]!
+    0x94000005, // 8c bl   0xa0
+    0xf84107fe, // 90 ldr  x30, [sp], #16
+    0xaa1303e0, // 94 mov  x0, x19                 SMALL: SYSCALL 60, R1
+    0xd2800ba8, // 98 mov  x8, #93 (exit)
+    0xd4000001, // 9c svc  #0
+    0x8b130273, // a0 add  x19, x19, x19           DOUBLE: ADD R1, R1
+    0xd65f03c0, // a4 ret                          RET
+    0xd2800040, // a8 mov  x0, #2                  Hata yolu: write(2, mesaj, uzunluk)
+    0xd2800808, // ac mov  x8, #64 (write)
+    0xd4000001, // b0 svc  #0
+    0xd2800020, // b4 mov  x0, #1
+    0xd2800bc8, // b8 mov  x8, #94 (exit_group)
+    0xd4000001, // bc svc  #0
+    0x90000001, // c0 adrp x1, __bsm_rodata        Çağrı derinliği aşıldı
+    0x91000021, // c4 add  x1, x1, :lo12:__bsm_rodata
+    0xd28007a2, // c8 mov  x2, #61
+    0x17fffff7, // cc b    0xa8
+};
+
+static const GoldenRelocation object_relocations[] = {
+    {0x00, R_AARCH64_ADR_PREL_PG_HI21, "__bsm_state", 0},
+    {0x04, R_AARCH64_ADD_ABS_LO12_NC, "__bsm_state", 0},
+    {0xc0, R_AARCH64_ADR_PREL_PG_HI21, "__bsm_rodata", 0},
+    {0xc4, R_AARCH64_ADD_ABS_LO12_NC, "__bsm_rodata", 0},
+};
+
+// Aynı program PGO ile enstrümante edildiğinde çalışma zamanı çağrıları CALL26 kayıtlarıdır
+static const GoldenRelocation instrumented_relocations[] = {
+    {0x000, R_AARCH64_ADR_PREL_PG_HI21, "__bsm_state", 0},
+    {0x004, R_AARCH64_ADD_ABS_LO12_NC, "__bsm_state", 0},
+    {0x020, R_AARCH64_ADR_PREL_PG_HI21, "__bsm_rodata", 0},
+    {0x024, R_AARCH64_ADD_ABS_LO12_NC, "__bsm_rodata", 0},
+    {0x1c4, R_AARCH64_ADR_PREL_PG_HI21, "__bsm_rodata", 16},
+    {0x1c8, R_AARCH64_ADD_ABS_LO12_NC, "__bsm_rodata", 16},
+    {0x028, R_AARCH64_CALL26, "__bsm_prof_init", 0},
+    {0x02c, R_AARCH64_CALL26, "__bsm_prof_thread_init", 0},
+    {0x098, R_AARCH64_CALL26, "__bsm_prof_dump", 0},
+    {0x150, R_AARCH64_CALL26, "__bsm_prof_dump", 0},
+};
+
+static void test_object(const char* input_dir, const char* output_dir) {
+    char source[1024], output[1024];
+    snprintf(source, sizeof(source), "%s/aarch64_object.bsm", input_dir);
+
+    for (int instrumented = 0; instrumented <= 1; instrumented++) {
+        ObjectCodegenOptions options = {0, 0, NULL};
+        IrFunction* ir = golden_compile(source, ARCH_ARMV8, 0, instrumented ? &options : NULL);
+        ObjectFile* obj = ir ? object_file_create(ARCH_ARMV8) : NULL;
+        ObjectCodegenStats stats;
+        if (!obj || !aarch64_generate_object(ir, obj, &options, &stats)) {
+            golden_check("aarch64_object.bsm kod üretimi", 0);
+        } else if (instrumented) {
+            snprintf(output, sizeof(output), "%s/aarch64_object_pgo.o", output_dir);
+            golden_check_elf_relocations("aarch64_object.bsm (PGO) yeniden konumlandırmaları", obj, output,
+                                         instrumented_relocations, COUNT(instrumented_relocations));
+        } else {
+            int text = object_file_find_section(obj, ".text");
+            golden_check_words("aarch64_object.bsm .text", obj->sections[text].data, obj->sections[text].size,
+                               object_text, COUNT(object_text));
+            snprintf(output, sizeof(output), "%s/aarch64_object.o", output_dir);
+            golden_check_elf_relocations("aarch64_object.bsm yeniden konumlandırmaları", obj, output,
+                                         object_relocations, COUNT(object_relocations));
+        }
+        object_file_free(obj);
+        ir_function_free(ir);
+    }
+}
+
+// flags_object.bsm -O2, LOOP'tan NEG'e: JNE için subs (cmp #0 yok), JLT için sub + cmp #0
+static const uint32_t flags_text[] = {
+    0x8b140273, // add  x19, x19, x20          LOOP: ADD R2, R1
+    0xf1000694, // subs x20, x20, #1           SUB R1, 1 (CMP R1, 0 kaldırıldı)
+    0x54ffffc1, // b.ne LOOP                   JNE LOOP
+    0xd100f273, // sub  x19, x19, #60          SUB R2, 60
+    0xf100027f, // cmp  x19, #0
+    0x5400008b, // b.lt NEG                    JLT NEG
+    0xaa1303e0, // mov  x0, x19                SYSCALL 60, R2
+    0xd2800ba8, // mov  x8, #93 (exit)
+    0xd4000001, // svc  #0
+};
+
+static void test_flags(const char* input_dir) {
+    char source[1024];
+    snprintf(source, sizeof(source), "%s/flags_object.bsm", input_dir);
+    ObjectCodegenOptions options = {0, 0, NULL};
+    IrFunction* ir = golden_compile(source, ARCH_ARMV8, 2, NULL);
+    ObjectFile* obj = ir ? object_file_create(ARCH_ARMV8) : NULL;
+    ObjectCodegenStats stats;
+    if (!obj || !aarch64_generate_object(ir, obj, &options, &stats)) {
+        golden_check("flags_object.bsm kod üretimi", 0);
+    } else {
+        int text = object_file_find_section(obj, ".text");
+        int loop = object_file_find_symbol(obj, "LOOP");
+        int neg = object_file_find_symbol(obj, "NEG");
+        if (golden_check("flags_object.bsm etiketleri", loop >= 0 && neg >= 0)) {
+            uint64_t start = obj->symbols[loop].offset, end = obj->symbols[neg].offset;
+            golden_check_words("flags_object.bsm bayrak yeniden kullanımı", obj->sections[text].data + start,
+                               end > start ? end - start : 0, flags_text, COUNT(flags_text));
+        }
+    }
+    object_file_free(obj);
+    ir_function_free(ir);
+}
+
+int main(int argc, char** argv) {
+    const char* input_dir = argc > 1 ? argv[1] : "tests/golden";
+    const char* output_dir = argc > 2 ? argv[2] : ".";
+    test_immediates();
+    test_arithmetic();
+    test_memory();
+    test_branches();
+    test_object(input_dir, output_dir);
+    test_flags(input_dir);
+    return golden_finish("aarch64_golden");
+}
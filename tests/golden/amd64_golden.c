@@ -0,0 +1,68 @@
+// amd64 altın testi: kodlayıcının bayrak komutları ve kod üreticinin ADD/SUB bayrak yeniden kullanımı
+// Beklenen baytlar llvm-mc -triple=x86_64 -show-encoding ve llvm-objdump -d ile doğrulanmıştır.
+#include "golden.h"
+#include "arch/amd64/amd64_codegen.h"
+#include <stdio.h>  // snprintf
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+// Kodlayıcı çağrılarının (buffer üzerinde) ürettiği baytları beklenenlerle karşılaştırır
+#define EXPECT(text, calls, ...)                                                       \
+    do {                                                                               \
+        Amd64Buffer buffer = {0};                                                      \
+        calls;                                                                         \
+        static const uint8_t expected[] = {__VA_ARGS__};                               \
+        golden_check_bytes(text, buffer.data, buffer.size, expected, COUNT(expected)); \
+        amd64_buffer_free(&buffer);                                                    \
+    } while (0)
+
+static void test_flags_instructions(void) {
+    EXPECT("add rbx, r12", amd64_alu(&buffer, AMD64_ALU_ADD, amd64_reg(AMD64_RBX), amd64_reg(AMD64_R12)),
+           0x4c, 0x01, 0xe3);
+    EXPECT("sub r12, 1", amd64_alu_imm(&buffer, AMD64_ALU_SUB, amd64_reg(AMD64_R12), 1), 0x49, 0x83, 0xec, 0x01);
+    EXPECT("cmp rbx, 0", amd64_alu_imm(&buffer, AMD64_ALU_CMP, amd64_reg(AMD64_RBX), 0), 0x48, 0x83, 0xfb, 0x00);
+    EXPECT("test rbx, rbx", amd64_test(&buffer, amd64_reg(AMD64_RBX), AMD64_RBX), 0x48, 0x85, 0xdb);
+}
+
+// flags_object.bsm -O2, LOOP'tan NEG'e: JNE sub'ın bayraklarını okur (test yok), JLT için test kalır
+static const uint8_t flags_text[] = {
+    0x4c, 0x01, 0xe3,                   // add  rbx, r12            LOOP: ADD R2, R1
+    0x49, 0x83, 0xec, 0x01,             // sub  r12, 1              SUB R1, 1 (CMP R1, 0 kaldırıldı)
+    0x75, 0xf7,                         // jne  LOOP                JNE LOOP
+    0x48, 0x83, 0xeb, 0x3c,             // sub  rbx, 60             SUB R2, 60
+    0x48, 0x85, 0xdb,                   // test rbx, rbx
+    0x7c, 0x0a,                         // jl   NEG                 JLT NEG
+    0x48, 0x8b, 0xfb,                   // mov  rdi, rbx            SYSCALL 60, R2
+    0xb8, 0x3c, 0x00, 0x00, 0x00,       // mov  eax, 60 (exit)
+    0x0f, 0x05,                         // syscall
+};
+
+static void test_flags(const char* input_dir) {
+    char source[1024];
+    snprintf(source, sizeof(source), "%s/flags_object.bsm", input_dir);
+    ObjectCodegenOptions options = {0, 0, NULL};
+    IrFunction* ir = golden_compile(source, ARCH_AMD64, 2, NULL);
+    ObjectFile* obj = ir ? object_file_create(ARCH_AMD64) : NULL;
+    ObjectCodegenStats stats;
+    if (!obj || !amd64_generate_object(ir, obj, &options, &stats)) {
+        golden_check("flags_object.bsm kod üretimi", 0);
+    } else {
+        int text = object_file_find_section(obj, ".text");
+        int loop = object_file_find_symbol(obj, "LOOP");
+        int neg = object_file_find_symbol(obj, "NEG");
+        if (golden_check("flags_object.bsm etiketleri", loop >= 0 && neg >= 0)) {
+            uint64_t start = obj->symbols[loop].offset, end = obj->symbols[neg].offset;
+            golden_check_bytes("flags_object.bsm bayrak yeniden kullanımı", obj->sections[text].data + start,
+                               end > start ? end - start : 0, flags_text, COUNT(flags_text));
+        }
+    }
+    object_file_free(obj);
+    ir_function_free(ir);
+}
+
+int main(int argc, char** argv) {
+    const char* input_dir = argc > 1 ? argv[1] : "tests/golden";
+    test_flags_instructions();
+    test_flags(input_dir);
+    return golden_finish("amd64_golden");
+}
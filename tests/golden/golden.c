@@ -0,0 +1,210 @@
+#include "golden.h"
+#include "lexer.h"
+#include "parser.h"
+#include "semantic_analyzer.h"
+#include "optimizer.h"
+#include <elf.h>    // Elf64_Ehdr, Elf64_Shdr, Elf64_Sym, Elf64_Rela
+#include <stdio.h>  // fprintf, fopen, fread
+#include <stdlib.h> // malloc, free
+#include <string.h> // strcmp, memcmp
+
+static int checks = 0;
+static int failures = 0;
+
+int golden_check(const char* name, int ok) {
+    checks++;
+    if (!ok) {
+        failures++;
+        fprintf(stderr, "BAŞARISIZ: %s\n", name);
+    }
+    return ok;
+}
+
+static uint32_t read_le(const uint8_t* bytes, size_t size) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; i++) value |= (uint32_t)bytes[i] << (8 * i);
+    return value;
+}
+
+// Beklenenden farklı veya eksik/fazla komutları yazar
+static void print_parcels(const uint8_t* code, size_t size, const uint32_t* expected, size_t count, int fixed) {
+    size_t position = 0;
+    for (size_t i = 0; i < count || position < size; i++) {
+        size_t length = 4;
+        if (i < count && !fixed && (expected[i] & 3) != 3) length = 2;
+        if (position + length > size) length = size > position ? size - position : 0;
+        uint32_t actual = read_le(code + position, length);
+        if (i >= count) {
+            fprintf(stderr, "  %04zx: beklenmeyen %08x\n", position, actual);
+        } else if (!length) {
+            fprintf(stderr, "  %04zx: beklenen %08x, üretilmedi\n", position, expected[i]);
+        } else if (actual != expected[i]) {
+            fprintf(stderr, "  %04zx: beklenen %08x, üretilen %08x\n", position, expected[i], actual);
+        }
+        position += length ? length : 4;
+    }
+}
+
+static int check_parcels(const char* name, const uint8_t* code, size_t size, const uint32_t* expected,
+                         size_t count, int fixed) {
+    size_t position = 0;
+    int ok = 1;
+    for (size_t i = 0; i < count && ok; i++) {
+        size_t length = fixed || (expected[i] & 3) == 3 ? 4 : 2;
+        ok = position + length <= size && read_le(code + position, length) == expected[i];
+        position += length;
+    }
+    if (!golden_check(name, ok && position == size)) print_parcels(code, size, expected, count, fixed);
+    return ok && position == size;
+}
+
+int golden_check_words(const char* name, const uint8_t* code, size_t size, const uint32_t* expected,
+                       size_t count) {
+    return check_parcels(name, code, size, expected, count, 1);
+}
+
+int golden_check_parcels(const char* name, const uint8_t* code, size_t size, const uint32_t* expected,
+                         size_t count) {
+    return check_parcels(name, code, size, expected, count, 0);
+}
+
+int golden_check_bytes(const char* name, const uint8_t* code, size_t size, const uint8_t* expected, size_t count) {
+    int ok = size == count && memcmp(code, expected, count) == 0;
+    if (!golden_check(name, ok)) {
+        for (size_t i = 0; i < count || i < size; i++) {
+            if (i >= count) {
+                fprintf(stderr, "  %04zx: beklenmeyen %02x\n", i, code[i]);
+            } else if (i >= size) {
+                fprintf(stderr, "  %04zx: beklenen %02x, üretilmedi\n", i, expected[i]);
+            } else if (code[i] != expected[i]) {
+                fprintf(stderr, "  %04zx: beklenen %02x, üretilen %02x\n", i, expected[i], code[i]);
+            }
+        }
+    }
+    return ok;
+}
+
+IrFunction* golden_compile(const char* path, TargetArchitecture arch, int optimization_level,
+                           ObjectCodegenOptions* options) {
+    IrFunction* ir = NULL;
+    Lexer* lexer = lexer_init(path);
+    Parser* parser = lexer ? parser_init(lexer) : NULL;
+    AstNode* ast_root = parser ? parse_program(parser) : NULL;
+    SemanticAnalyzer* analyzer = ast_root ? semantic_analyzer_init() : NULL;
+    Optimizer* optimizer = analyzer && perform_semantic_analysis(analyzer, ast_root) ? optimizer_init() : NULL;
+    if (optimizer) {
+        optimizer->optimization_level = optimization_level;
+        optimizer->target_arch = arch;
+        optimizer->instrument_profile = options != NULL;
+        if (perform_optimizations(optimizer, ast_root, analyzer->symbol_table)) {
+            ir = ir_lower_program(ast_root);
+            if (ir && !ir_verify(ir)) {
+                ir_function_free(ir);
+                ir = NULL;
+            }
+        }
+        if (options) {
+            options->profile_checksum = optimizer->instrumentation.cfg_checksum;
+            options->profile_num_counters = optimizer->instrumentation.num_counters;
+            options->profile_path = NULL;
+        }
+    }
+    if (!ir) fprintf(stderr, "Hata: '%s' derlenemedi.\n", path);
+    optimizer_close(optimizer);
+    semantic_analyzer_close(analyzer);
+    ast_node_free(ast_root);
+    parser_close(parser);
+    lexer_close(lexer);
+    return ir;
+}
+
+// Dosyanın tamamını belleğe okur
+static uint8_t* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    uint8_t* data = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        if (length > 0 && fseek(file, 0, SEEK_SET) == 0 && (data = malloc((size_t)length)) != NULL &&
+            fread(data, 1, (size_t)length, file) != (size_t)length) {
+            free(data);
+            data = NULL;
+        }
+        *size = data ? (size_t)length : 0;
+    }
+    fclose(file);
+    return data;
+}
+
+// Bölüm başlığı dosyanın içindeyse döndürür
+static const Elf64_Shdr* elf_section(const uint8_t* data, size_t size, size_t index) {
+    const Elf64_Ehdr* header = (const Elf64_Ehdr*)data;
+    if (index >= header->e_shnum) return NULL;
+    uint64_t offset = header->e_shoff + index * sizeof(Elf64_Shdr);
+    return offset + sizeof(Elf64_Shdr) <= size ? (const Elf64_Shdr*)(data + offset) : NULL;
+}
+
+static const char* elf_string(const uint8_t* data, size_t size, const Elf64_Shdr* table, uint32_t offset) {
+    if (!table || table->sh_offset + offset >= size) return "?";
+    return (const char*)(data + table->sh_offset + offset);
+}
+
+static const char* relocation_symbol(const uint8_t* data, size_t size, const Elf64_Shdr* symtab,
+                                     const Elf64_Shdr* strtab, const Elf64_Rela* entry) {
+    if (!symtab) return "?";
+    uint64_t offset = symtab->sh_offset + ELF64_R_SYM(entry->r_info) * sizeof(Elf64_Sym);
+    if (offset + sizeof(Elf64_Sym) > size) return "?";
+    return elf_string(data, size, strtab, ((const Elf64_Sym*)(data + offset))->st_name);
+}
+
+int golden_check_elf_relocations(const char* name, const ObjectFile* obj, const char* elf_path,
+                                 const GoldenRelocation* expected, size_t count) {
+    size_t size = 0;
+    uint8_t* data = object_file_write_elf(obj, elf_path) ? read_file(elf_path, &size) : NULL;
+    if (!data || size < sizeof(Elf64_Ehdr) || memcmp(data, ELFMAG, SELFMAG) != 0) {
+        free(data);
+        fprintf(stderr, "Hata: '%s' ELF dosyası yazılamadı veya okunamadı.\n", elf_path);
+        return golden_check(name, 0);
+    }
+
+    // .text'e ait SHT_RELA bölümü ve onun sembol tablosu
+    const Elf64_Ehdr* header = (const Elf64_Ehdr*)data;
+    const Elf64_Shdr* names = elf_section(data, size, header->e_shstrndx);
+    const Elf64_Shdr* rela = NULL;
+    for (size_t i = 0; i < header->e_shnum && !rela; i++) {
+        const Elf64_Shdr* section = elf_section(data, size, i);
+        const Elf64_Shdr* target = section && section->sh_type == SHT_RELA
+                                       ? elf_section(data, size, section->sh_info) : NULL;
+        if (target && strcmp(elf_string(data, size, names, target->sh_name), ".text") == 0) rela = section;
+    }
+    const Elf64_Shdr* symtab = rela ? elf_section(data, size, rela->sh_link) : NULL;
+    const Elf64_Shdr* strtab = symtab ? elf_section(data, size, symtab->sh_link) : NULL;
+    size_t num_entries = rela && rela->sh_offset + rela->sh_size <= size ? rela->sh_size / sizeof(Elf64_Rela) : 0;
+
+    int ok = num_entries == count;
+    for (size_t i = 0; i < num_entries && i < count && ok; i++) {
+        const Elf64_Rela* entry = (const Elf64_Rela*)(data + rela->sh_offset) + i;
+        const char* symbol = relocation_symbol(data, size, symtab, strtab, entry);
+        ok = entry->r_offset == expected[i].offset && ELF64_R_TYPE(entry->r_info) == expected[i].type &&
+             strcmp(symbol, expected[i].symbol) == 0 && entry->r_addend == expected[i].addend;
+    }
+    if (!golden_check(name, ok)) {
+        for (size_t i = 0; i < count; i++) {
+            fprintf(stderr, "  beklenen %04llx tür %u %s%+lld\n", (unsigned long long)expected[i].offset,
+                    expected[i].type, expected[i].symbol, (long long)expected[i].addend);
+        }
+        for (size_t i = 0; i < num_entries; i++) {
+            const Elf64_Rela* entry = (const Elf64_Rela*)(data + rela->sh_offset) + i;
+            const char* symbol = relocation_symbol(data, size, symtab, strtab, entry);
+            fprintf(stderr, "  üretilen %04llx tür %u %s%+lld\n", (unsigned long long)entry->r_offset,
+                    (unsigned)ELF64_R_TYPE(entry->r_info), symbol, (long long)entry->r_addend);
+        }
+    }
+    free(data);
+    return ok;
+}
+
+int golden_finish(const char* test_name) {
+    fprintf(stdout, "%s: %d kontrol, %d hata\n", test_name, checks, failures);
+    return failures ? 1 : 0;
+}
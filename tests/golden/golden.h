@@ -0,0 +1,74 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include "ir_generator.h" // IrFunction
+#include "object_file_writer.h" // ObjectFile, ObjectCodegenOptions
+#include <stdint.h> // uint32_t, uint64_t, int64_t için
+#include <stddef.h> // size_t için
+
+// --- Altın Test Yardımcıları ---
+// Kodlayıcıların ve kod üreticilerin çıktısı önceden doğrulanmış (llvm-mc / llvm-objdump)
+// komut sözcükleriyle ve yeniden konumlandırmalarla karşılaştırılır. Her karşılaştırma hata
+// sayacını artırır ve farkı stderr'e yazar; test sonunda golden_finish çıkış kodunu verir.
+
+// Nesne dosyasında beklenen bir yeniden konumlandırma (ELF türü ve sembol adıyla)
+typedef struct {
+    uint64_t offset;        // .text içindeki konum
+    uint32_t type;          // ELF yeniden konumlandırma türü (örn: R_AARCH64_CALL26)
+    const char* symbol;     // Hedef sembolün adı
+    int64_t addend;         // Ek değer
+} GoldenRelocation;
+
+/**
+ * @brief Bir koşulu kontrol olarak sayar; yanlışsa adını stderr'e yazar ve hata sayar.
+ * @return ok değeri.
+ */
+int golden_check(const char* name, int ok);
+
+/**
+ * @brief Sabit uzunluklu (4 bayt, küçük-sonlu) komut sözcüklerini karşılaştırır.
+ * @return Eşitse 1, aksi takdirde 0 (hata sayılır).
+ */
+int golden_check_words(const char* name, const uint8_t* code, size_t size, const uint32_t* expected,
+                       size_t count);
+
+/**
+ * @brief RISC-V komutlarını karşılaştırır: en düşük iki biti 11 olmayan beklenen değerler
+ * 2 baytlık sıkıştırılmış (RVC) komutlardır, diğerleri 4 baytlıktır.
+ * @return Eşitse 1, aksi takdirde 0 (hata sayılır).
+ */
+int golden_check_parcels(const char* name, const uint8_t* code, size_t size, const uint32_t* expected,
+                         size_t count);
+
+/**
+ * @brief Değişken uzunluklu (örn: x86-64) makine kodunu bayt bayt karşılaştırır.
+ * @return Eşitse 1, aksi takdirde 0 (hata sayılır).
+ */
+int golden_check_bytes(const char* name, const uint8_t* code, size_t size, const uint8_t* expected, size_t count);
+
+/**
+ * @brief Bir .bsm dosyasını derleyicinin ön yüzü ve optimizer'ı ile IR'ye çevirir.
+ * @param path Kaynak dosya.
+ * @param arch Hedef mimari (hedefe bağlı geçişler için).
+ * @param optimization_level Optimizasyon seviyesi (0-3).
+ * @param options Boş değilse PGO enstrümantasyonu yapılır ve kod üretici seçenekleri yazılır.
+ * @return Doğrulanmış IR veya hata durumunda NULL.
+ */
+IrFunction* golden_compile(const char* path, TargetArchitecture arch, int optimization_level,
+                           ObjectCodegenOptions* options);
+
+/**
+ * @brief Nesne dosyasını ELF olarak yazar ve .rela.text kayıtlarını (ELF türü, konum, sembol adı,
+ * ek değer) sırasıyla beklenenlerle karşılaştırır.
+ * @return Eşitse 1, aksi takdirde 0 (hata sayılır).
+ */
+int golden_check_elf_relocations(const char* name, const ObjectFile* obj, const char* elf_path,
+                                 const GoldenRelocation* expected, size_t count);
+
+/**
+ * @brief Kontrol sayısını ve hataları yazar.
+ * @return Hata yoksa 0, aksi takdirde 1 (main'in çıkış kodu).
+ */
+int golden_finish(const char* test_name);
+
+#endif // GOLDEN_H
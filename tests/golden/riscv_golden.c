@@ -0,0 +1,297 @@
+// RISC-V altın testi: kodlayıcının komutları (C eklentili ve eklentisiz) ve kod üreticinin nesne dosyası
+// Beklenen kodlamalar llvm-mc -triple=riscv64 -mattr=+m[,+c] -show-encoding ve llvm-objdump -d -r ile
+// doğrulanmıştır. 16 bitlik değerler sıkıştırılmış (RVC) komutlardır.
+#include "golden.h"
+#include "arch/riscv/riscv_codegen.h"
+#include <elf.h>    // R_RISCV_*
+#include <stdio.h>  // snprintf
+
+#define C_NOP 0x0001u
+#define NOP 0x00000013u
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+// Kodlayıcı çağrılarının (buffer üzerinde, C eklentisi 'compressed') ürettiği komutları karşılaştırır
+#define EXPECT(text, compressed_forms, calls, ...)                                       \
+    do {                                                                                 \
+        RiscvBuffer buffer = {0};                                                        \
+        buffer.compressed = (compressed_forms);                                          \
+        calls;                                                                           \
+        static const uint32_t expected[] = {__VA_ARGS__};                                \
+        golden_check_parcels(text, buffer.data, buffer.size, expected, COUNT(expected)); \
+        riscv_buffer_free(&buffer);                                                      \
+    } while (0)
+
+// Aynı çağrı C eklentisiyle sıkıştırılmış, eklentisiz 32 bitlik biçimi üretmelidir
+#define EXPECT_RVC(text, calls, compressed_word, fallback_word)         \
+    do {                                                                \
+        EXPECT(text " (C)", 1, calls, compressed_word);                 \
+        EXPECT(text, 0, calls, fallback_word);                          \
+    } while (0)
+
+static void test_compressible(void) {
+    EXPECT_RVC("li a0, 5", riscv_li(&buffer, RISCV_A0, 5), 0x4515, 0x00500513);
+    EXPECT_RVC("li a0, -32", riscv_li(&buffer, RISCV_A0, -32), 0x5501, 0xfe000513);
+    EXPECT_RVC("addi a0, a0, 1", riscv_addi(&buffer, RISCV_A0, RISCV_A0, 1), 0x0505, 0x00150513);
+    EXPECT_RVC("addi a0, a0, -32", riscv_addi(&buffer, RISCV_A0, RISCV_A0, -32), 0x1501, 0xfe050513);
+    EXPECT_RVC("addi sp, sp, -16", riscv_addi(&buffer, RISCV_SP, RISCV_SP, -16), 0x1141, 0xff010113);
+    EXPECT_RVC("addiw a0, a0, -1", riscv_addiw(&buffer, RISCV_A0, RISCV_A0, -1), 0x357d, 0xfff5051b);
+    EXPECT_RVC("slli a0, a0, 12", riscv_slli(&buffer, RISCV_A0, RISCV_A0, 12), 0x0532, 0x00c51513);
+    EXPECT_RVC("lui s1, 0x12", riscv_lui(&buffer, RISCV_X9, 0x12), 0x64c9, 0x000124b7);
+    EXPECT_RVC("mv a0, a1", riscv_mv(&buffer, RISCV_A0, RISCV_A1), 0x852e, 0x00058513);
+    EXPECT_RVC("add a0, a0, a1", riscv_add(&buffer, RISCV_A0, RISCV_A0, RISCV_A1), 0x952e, 0x00b50533);
+    EXPECT_RVC("add a0, a1, a0", riscv_add(&buffer, RISCV_A0, RISCV_A1, RISCV_A0), 0x952e, 0x00a58533);
+    EXPECT_RVC("sub s0, s0, s1", riscv_sub(&buffer, RISCV_X8, RISCV_X8, RISCV_X9), 0x8c05, 0x40940433);
+    EXPECT_RVC("ld s0, 8(s1)", riscv_ld(&buffer, RISCV_X8, RISCV_X9, 8), 0x6480, 0x0084b403);
+    EXPECT_RVC("ld a0, 8(sp)", riscv_ld(&buffer, RISCV_A0, RISCV_SP, 8), 0x6522, 0x00813503);
+    EXPECT_RVC("sd ra, 0(sp)", riscv_sd(&buffer, RISCV_RA, RISCV_SP, 0), 0xe006, 0x00113023);
+    EXPECT_RVC("lw a0, 4(a1)", riscv_lw(&buffer, RISCV_A0, RISCV_A1, 4), 0x41c8, 0x0045a503);
+    EXPECT_RVC("ret", riscv_ret(&buffer), 0x8082, 0x00008067);
+    EXPECT_RVC("jalr ra, 0(t0)", riscv_jalr(&buffer, RISCV_RA, RISCV_T0, 0), 0x9282, 0x000280e7);
+}
+
+static void test_not_compressible(void) {
+    // Sabit, kaydedici veya konum kısıtı sıkıştırılmış biçime uymadığında C eklentisi açıkken de 32 bit
+    EXPECT("li a0, 100 (c.li: -32..31)", 1, riscv_li(&buffer, RISCV_A0, 100), 0x06400513);
+    EXPECT("addi a0, a0, 32 (c.addi: -32..31)", 1, riscv_addi(&buffer, RISCV_A0, RISCV_A0, 32), 0x02050513);
+    EXPECT("addi a0, a1, 1 (rd != rs1)", 1, riscv_addi(&buffer, RISCV_A0, RISCV_A1, 1), 0x00158513);
+    EXPECT("add a0, a1, a2 (rd != rs1, rs2)", 1, riscv_add(&buffer, RISCV_A0, RISCV_A1, RISCV_A2), 0x00c58533);
+    EXPECT("sub t0, t0, t1 (x8-x15 dışı)", 1, riscv_sub(&buffer, RISCV_T0, RISCV_T0, RISCV_T1), 0x406282b3);
+    EXPECT("ld t0, 4(s1) (8'in katı değil)", 1, riscv_ld(&buffer, RISCV_T0, RISCV_X9, 4), 0x0044b283);
+    EXPECT("sd a0, 0(s10) (x8-x15 dışı taban)", 1, riscv_sd(&buffer, RISCV_A0, RISCV_X26, 0), 0x00ad3023);
+    EXPECT("sb a0, -1(a1)", 1, riscv_sb(&buffer, RISCV_A0, RISCV_A1, -1), 0xfea58fa3);
+    EXPECT("mul a0, a1, a2", 1, riscv_mul(&buffer, RISCV_A0, RISCV_A1, RISCV_A2), 0x02c58533);
+    EXPECT("div s0, s0, t1", 1, riscv_div(&buffer, RISCV_X8, RISCV_X8, RISCV_T1), 0x02644433);
+    EXPECT("divu a0, a1, a2", 1, riscv_divu(&buffer, RISCV_A0, RISCV_A1, RISCV_A2), 0x02c5d533);
+    EXPECT("remu a0, a1, a2", 1, riscv_remu(&buffer, RISCV_A0, RISCV_A1, RISCV_A2), 0x02c5f533);
+    EXPECT("ecall", 1, riscv_ecall(&buffer), 0x00000073);
+}
+
+static void test_large_immediates(void) {
+    // 32 bitlik sabitler lui + addiw'ye bölünür; düşük 12 bit negatifse üst parça yukarı yuvarlanır
+    EXPECT("li a0, 0x12345678", 1, riscv_li(&buffer, RISCV_A0, 0x12345678),
+           0x12345537,  // lui   a0, 0x12345
+           0x6785051b); // addiw a0, a0, 0x678
+    EXPECT("li a0, 0x12345fff (C)", 1, riscv_li(&buffer, RISCV_A0, 0x12345fff),
+           0x12346537,  // lui   a0, 0x12346
+           0x357d);     // c.addiw a0, -1
+    EXPECT("li a0, 0x12345fff", 0, riscv_li(&buffer, RISCV_A0, 0x12345fff),
+           0x12346537,  // lui   a0, 0x12346
+           0xfff5051b); // addiw a0, a0, -1
+    EXPECT("li a0, 0x12345 (C)", 1, riscv_li(&buffer, RISCV_A0, 0x12345),
+           0x6549,      // c.lui a0, 0x12
+           0x3455051b); // addiw a0, a0, 0x345
+    EXPECT("li a0, 0x800", 0, riscv_li(&buffer, RISCV_A0, 0x800),
+           0x00001537,  // lui   a0, 1
+           0x8005051b); // addiw a0, a0, -2048
+    EXPECT("li a0, 0x7fffffff", 0, riscv_li(&buffer, RISCV_A0, 0x7fffffff),
+           0x80000537,  // lui   a0, 0x80000
+           0xfff5051b); // addiw a0, a0, -1
+    // 32 biti aşan sabitler: üst kısım, slli ve kalan 12 bit için addi
+    EXPECT("li a0, 0x123456789 (C)", 1, riscv_li(&buffer, RISCV_A0, INT64_C(0x123456789)),
+           0x00092537,  // lui   a0, 0x92
+           0xa2b5051b,  // addiw a0, a0, -1493
+           0x0536,      // c.slli a0, 13
+           0x78950513); // addi  a0, a0, 0x789
+    EXPECT("li a0, 0x123456789", 0, riscv_li(&buffer, RISCV_A0, INT64_C(0x123456789)),
+           0x00092537, 0xa2b5051b,
+           0x00d51513,  // slli  a0, a0, 13
+           0x78950513);
+    EXPECT("li a0, INT64_MIN (C)", 1, riscv_li(&buffer, RISCV_A0, INT64_MIN),
+           0x557d,      // c.li   a0, -1
+           0x157e);     // c.slli a0, 63
+    EXPECT("li a0, INT64_MAX", 0, riscv_li(&buffer, RISCV_A0, INT64_MAX),
+           0xfff00513,  // li    a0, -1
+           0x03f51513,  // slli  a0, a0, 63
+           0xfff50513); // addi  a0, a0, -1
+}
+
+static void test_branches(void) {
+    // Sıkıştırılmış dallar (kod üretici hedefi bilerek seçer) ve 32 bitlik karşılıkları
+    EXPECT("c.beqz s0, 8", 1, {
+        size_t at = riscv_c_beqz(&buffer, RISCV_X8);
+        riscv_emit16(&buffer, C_NOP);
+        riscv_emit16(&buffer, C_NOP);
+        riscv_emit16(&buffer, C_NOP);
+        riscv_patch_branch(&buffer, at, 8);
+    }, 0xc401, C_NOP, C_NOP, C_NOP);
+    EXPECT("c.bnez a5, -4", 1, {
+        riscv_emit16(&buffer, C_NOP);
+        riscv_emit16(&buffer, C_NOP);
+        riscv_patch_branch(&buffer, riscv_c_bnez(&buffer, RISCV_A5), 0);
+    }, C_NOP, C_NOP, 0xfff5);
+    EXPECT("c.j 8", 1, {
+        size_t at = riscv_c_j(&buffer);
+        riscv_emit32(&buffer, NOP);
+        riscv_emit16(&buffer, C_NOP);
+        riscv_patch_branch(&buffer, at, 8);
+    }, 0xa021, NOP, C_NOP);
+    EXPECT("beq a0, a1, 8", 1, {
+        size_t at = riscv_branch(&buffer, RISCV_BEQ, RISCV_A0, RISCV_A1);
+        riscv_emit32(&buffer, NOP);
+        riscv_patch_branch(&buffer, at, 8);
+    }, 0x00b50463, NOP);
+    EXPECT("bne s0, zero, -4", 1, {
+        riscv_emit32(&buffer, NOP);
+        riscv_patch_branch(&buffer, riscv_branch(&buffer, RISCV_BNE, RISCV_X8, RISCV_ZERO), 0);
+    }, NOP, 0xfe041ee3);
+    EXPECT("jal zero, 8", 1, {
+        size_t at = riscv_jal(&buffer, RISCV_ZERO);
+        riscv_emit32(&buffer, NOP);
+        riscv_patch_branch(&buffer, at, 8);
+    }, 0x0080006f, NOP);
+
+    // Erişim sınırları: son geçerli uzaklık yazılır, bir sonraki reddedilir
+    {
+        RiscvBuffer buffer = {0};
+        buffer.compressed = 1;
+        size_t c_beqz = riscv_c_beqz(&buffer, RISCV_A0);
+        size_t c_j = riscv_c_j(&buffer);
+        size_t bgeu = riscv_branch(&buffer, RISCV_BGEU, RISCV_A0, RISCV_A1);
+        size_t jal = riscv_jal(&buffer, RISCV_RA);
+        golden_check("c.beqz erişimi", riscv_patch_branch(&buffer, c_beqz, c_beqz + RISCV_C_BRANCH_RANGE - 2) &&
+                                           !riscv_patch_branch(&buffer, c_beqz, c_beqz + RISCV_C_BRANCH_RANGE));
+        golden_check("c.j erişimi", riscv_patch_branch(&buffer, c_j, 0) &&
+                                        !riscv_patch_branch(&buffer, c_j, c_j + RISCV_C_JUMP_RANGE));
+        golden_check("bgeu erişimi", riscv_patch_branch(&buffer, bgeu, bgeu + RISCV_BRANCH_RANGE - 2) &&
+                                         !riscv_patch_branch(&buffer, bgeu, bgeu + RISCV_BRANCH_RANGE));
+        golden_check("jal erişimi", riscv_patch_branch(&buffer, jal, jal + RISCV_JUMP_RANGE - 2) &&
+                                        !riscv_patch_branch(&buffer, jal, jal + RISCV_JUMP_RANGE));
+        static const uint32_t expected[] = {
+            0xcd7d,     // c.beqz a0, 254
+            0xbffd,     // c.j -2
+            0x7eb57fe3, // bgeu a0, a1, 4094
+            0x7ffff0ef, // jal ra, 1048574
+        };
+        golden_check_parcels("dal erişimleri", buffer.data, buffer.size, expected, COUNT(expected));
+        riscv_buffer_free(&buffer);
+    }
+
+    // Sembol adresi ve çağrı: alanları sıfır auipc çiftleri (auipc'ye bağlı addi sıkıştırılmaz)
+    {
+        RiscvBuffer buffer = {0};
+        buffer.compressed = 1;
+        riscv_la(&buffer, RISCV_A1, 1, 16);
+        riscv_call(&buffer);
+        static const uint32_t expected[] = {
+            0x00000597, // auipc a1, 0
+            0x00058593, // addi  a1, a1, 0
+            0x00000097, // auipc ra, 0
+            0x000080e7, // jalr  ra, 0(ra)
+        };
+        golden_check_parcels("auipc + addi, auipc + jalr", buffer.data, buffer.size, expected, COUNT(expected));
+        golden_check("auipc + addi başvuruları",
+                     buffer.num_symbol_refs == 2 && buffer.symbol_refs[0].kind == RISCV_REF_PCREL_HI20 &&
+                         buffer.symbol_refs[0].position == 0 && buffer.symbol_refs[0].symbol == 1 &&
+                         buffer.symbol_refs[0].addend == 16 && buffer.symbol_refs[1].kind == RISCV_REF_PCREL_LO12_I &&
+                         buffer.symbol_refs[1].position == 4 && buffer.symbol_refs[1].addend == 16);
+        riscv_buffer_free(&buffer);
+    }
+}
+
+// riscv_object.bsm -O0 (rv64i, C eklentisi): c.beqz, c.j, B türü dallar ve jal kod üreticide
+// çözülür; nesne dosyasında sadece auipc çiftlerinin yeniden konumlandırmaları kalır.
+static const uint32_t object_text[] = {
+    0x00000d17, // 00 auipc  s10, 0                __bsm_state
+    0x000d0d13, // 04 addi   s10, s10, 0
+    0x62c1,     // 08 c.lui  t0, 16
+    0x40510db3, // 0a sub    s11, sp, t0            Çağrı derinliği sınırı
+    0x4501, 0x4401, 0x4481, 0x4581, 0x4601, 0x4681, 0x4701, 0x4781, // 0e c.li a0..a5, s0, s1, 0
+    0x4901, 0x4981, 0x4a01, 0x4a81, 0x4b01, 0x4b81, 0x4c01, 0x4c81, // 1e c.li s2..s9, 0
+    0x4e01, 0x4e81,                                                 // 2e c.li t3, t4, 0
+    0x00e000ef, // 32 jal    ra, 0x40               Program gövdesi
+    0x4501,     // 36 c.li   a0, 0
+    0x05e00893, // 38 li     a7, 94 (exit_group)
+    0x00000073, // 3c ecall
+    0x12345437, // 40 lui    s0, 0x12345            MOV R1, 0x12345678
+    0x6784041b, // 44 addiw  s0, s0, 0x678
+    0x449d,     // 48 c.li   s1, 7                  MOV R2, 7
+    0x02940433, // 4a mul    s0, s0, s1             MUL R1, R2
+    0x430d,     // 4e c.li   t1, 3                  DIV R1, 3
+    0x02644433, // 50 div    s0, s0, t1
+    0xcc89,     // 54 c.beqz s1, 0x6e               CMP R2, 0 / JEQ SMALL
+    0x00944c63, // 56 blt    s0, s1, 0x6e           CMP R1, R2 / JLT SMALL
+    0x002de463, // 5a bltu   s11, sp, 0x62          CALL DOUBLE (derinlik denetimi)
+    0x0360006f, // 5e jal    zero, 0x94
+    0x1141,     // 62 c.addi sp, -16
+    0xe006,     // 64 c.sdsp ra, 0(sp)
+    0x016000ef, // 66 jal    ra, 0x7c
+    0x6082,     // 6a c.ldsp ra, 0(sp)
+    0x0141,     // 6c c.addi sp, 16
+    0x00ad3023, // 6e sd     a0, 0(s10)             SMALL: SYSCALL 60, R1
+    0x8522,     // 72 c.mv   a0, s0
+    0x05d00893, // 74 li     a7, 93 (exit)
+    0x00000073, // 78 ecall
+    0x9422,     // 7c c.add  s0, s0                 DOUBLE: ADD R1, R1
+    0x8082,     // 7e c.jr   ra                     RET
+    0x4509,     // 80 c.li   a0, 2                  Hata yolu: write(2, mesaj, uzunluk)
+    0x04000893, // 82 li     a7, 64 (write)
+    0x00000073, // 86 ecall
+    0x4505,     // 8a c.li   a0, 1
+    0x05e00893, // 8c li     a7, 94 (exit_group)
+    0x00000073, // 90 ecall
+    0x00000597, // 94 auipc  a1, 0                  Çağrı derinliği aşıldı (__bsm_rodata)
+    0x00058593, // 98 addi   a1, a1, 0
+    0x03e00613, // 9c li     a2, 62
+    0xb7c5,     // a0 c.j    0x80
+};
+
+// LO12 kayıtları eşlenen auipc'nin konumundaki yerel etikete başvurur
+static const GoldenRelocation object_relocations[] = {
+    {0x00, R_RISCV_PCREL_HI20, "__bsm_state", 0},
+    {0x04, R_RISCV_PCREL_LO12_I, "__bsm_pcrel0", 0},
+    {0x94, R_RISCV_PCREL_HI20, "__bsm_rodata", 0},
+    {0x98, R_RISCV_PCREL_LO12_I, "__bsm_pcrel94", 0},
+};
+
+// Aynı program PGO ile enstrümante edildiğinde çalışma zamanı çağrıları CALL_PLT kayıtlarıdır
+static const GoldenRelocation instrumented_relocations[] = {
+    {0x000, R_RISCV_PCREL_HI20, "__bsm_state", 0},
+    {0x004, R_RISCV_PCREL_LO12_I, "__bsm_pcrel0", 0},
+    {0x02a, R_RISCV_PCREL_HI20, "__bsm_rodata", 0},
+    {0x02e, R_RISCV_PCREL_LO12_I, "__bsm_pcrel2a", 0},
+    {0x1b2, R_RISCV_PCREL_HI20, "__bsm_rodata", 16},
+    {0x1b6, R_RISCV_PCREL_LO12_I, "__bsm_pcrel1b2", 0},
+    {0x032, R_RISCV_CALL_PLT, "__bsm_prof_init", 0},
+    {0x03a, R_RISCV_CALL_PLT, "__bsm_prof_thread_init", 0},
+    {0x08a, R_RISCV_CALL_PLT, "__bsm_prof_dump", 0},
+    {0x13a, R_RISCV_CALL_PLT, "__bsm_prof_dump", 0},
+};
+
+static void test_object(const char* input_dir, const char* output_dir) {
+    char source[1024], output[1024];
+    snprintf(source, sizeof(source), "%s/riscv_object.bsm", input_dir);
+
+    for (int instrumented = 0; instrumented <= 1; instrumented++) {
+        ObjectCodegenOptions options = {0, 0, NULL};
+        IrFunction* ir = golden_compile(source, ARCH_RV64I, 0, instrumented ? &options : NULL);
+        ObjectFile* obj = ir ? object_file_create(ARCH_RV64I) : NULL;
+        ObjectCodegenStats stats;
+        if (!obj || !riscv_generate_object(ir, obj, &options, &stats)) {
+            golden_check("riscv_object.bsm kod üretimi", 0);
+        } else if (instrumented) {
+            snprintf(output, sizeof(output), "%s/riscv_object_pgo.o", output_dir);
+            golden_check_elf_relocations("riscv_object.bsm (PGO) yeniden konumlandırmaları", obj, output,
+                                         instrumented_relocations, COUNT(instrumented_relocations));
+        } else {
+            int text = object_file_find_section(obj, ".text");
+            golden_check_parcels("riscv_object.bsm .text", obj->sections[text].data, obj->sections[text].size,
+                                 object_text, COUNT(object_text));
+            snprintf(output, sizeof(output), "%s/riscv_object.o", output_dir);
+            golden_check_elf_relocations("riscv_object.bsm yeniden konumlandırmaları", obj, output,
+                                         object_relocations, COUNT(object_relocations));
+        }
+        object_file_free(obj);
+        ir_function_free(ir);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* input_dir = argc > 1 ? argv[1] : "tests/golden";
+    const char* output_dir = argc > 2 ? argv[2] : ".";
+    test_compressible();
+    test_not_compressible();
+    test_large_immediates();
+    test_branches();
+    test_object(input_dir, output_dir);
+    return golden_finish("riscv_golden");
+}
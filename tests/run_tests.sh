@@ -0,0 +1,213 @@
+#!/bin/sh
+# Bessambly regresyon testleri
+#
+# Kullanım: sh tests/run_tests.sh
+#
+# Ortam değişkenleri:
+#   CC         Derleyici (varsayılan: cc)
+#   CFLAGS     Derleme bayrakları (varsayılan: -O2 -g -Wall)
+#   BSMC       Önceden derlenmiş bsmc; verilirse derleyici yeniden derlenmez
+#   BUILD_DIR  Ara dosyaların dizini (varsayılan: geçici dizin)
+#   NODE       .wasm modüllerini çalıştıran Node.js (varsayılan: node; yoksa modüller sadece derlenir)
+#
+# 1. tests/golden/*_golden.c: Kodlayıcı/kod üretici altın testleri. Her biri derleyicinin main.c
+#    dışındaki kaynaklarıyla bağlanır; tests/golden dizini (girdi programları) ve ara dosya dizini
+#    (yazılan nesne dosyaları) argüman olarak verilerek çalıştırılır.
+# 2. tests/programs/<ad>.bsm: Davranış testleri. <ad>.out programın beklenen çıktısını (sayı
+#    satırları) ve son satırda "exit N" biçiminde çıkış kodunu içerir. Her program -O0/-O1/-O2/-O3/-Os
+#    düzeylerinde BVM, JIT, katmanlı yürütme, .vbsm/.bsmir gidiş-dönüşü, (x86-64 Linux'ta) yerel
+#    amd64 nesne dosyası ve (Node.js varsa) tests/wasm_host.js ile .wasm modülü olarak çalıştırılır;
+#    hepsi aynı sonucu vermelidir. BVM ayrıca programın kendi gönderim profilinden seçilen
+#    üst-komutlarla da çalıştırılır.
+#    Programdaki "; optimizer -O2: <metin>" satırları o düzeyde derleyici çıktısında <metin>
+#    geçmesini şart koşar (testin gerçekten ilgili geçişi çalıştırdığını doğrulamak için). Düzeyden
+#    sonra başka seçenekler de verilebilir (örn: "--target-arch=armv7"); "--profile-use" programın
+#    kendi profilini kullanır. Bu denetimler ara dosya dizininde çalışır; seçeneklerdeki göreli
+#    yollar (örn: "-o isel.o") oraya yazılır.
+#    <ad>.bsmrules varsa programın tüm derlemelerine süperoptimizasyon kural veritabanı olarak
+#    verilir; ayrıca boş bir veritabanıyla --superoptimize araması yapılıp bulunan kurallar denenir.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:-"-O2 -g -Wall"}
+if [ -z "$BUILD_DIR" ]; then
+    BUILD_DIR=$(mktemp -d)
+    trap 'rm -rf "$BUILD_DIR"' EXIT
+fi
+mkdir -p "$BUILD_DIR"
+BUILD_DIR=$(cd "$BUILD_DIR" && pwd)
+
+LEVELS="-O0 -O1 -O2 -O3 -Os"
+NATIVE=0
+if [ "$(uname -s)" = Linux ] && [ "$(uname -m)" = x86_64 ]; then NATIVE=1; fi
+NODE=${NODE:-node}
+if ! command -v "$NODE" > /dev/null 2>&1; then NODE=; fi
+
+passed=0
+failed=0
+
+fail() {
+    echo "BAŞARISIZ: $*"
+    failed=$((failed + 1))
+}
+
+# Derleyicinin main.c dışındaki kaynakları (altın testler bunlarla bağlanır)
+LIBRARY_SOURCES=$(ls "$ROOT"/src/*.c "$ROOT"/src/os/*.c "$ROOT"/src/arch/*/*.c | grep -v '/main\.c$')
+
+case $BSMC in
+    */*) BSMC=$(cd "$(dirname "$BSMC")" && pwd)/$(basename "$BSMC") ;; # Mesaj denetimleri dizin değiştirir
+esac
+if [ -z "$BSMC" ]; then
+    BSMC="$BUILD_DIR/bsmc"
+    echo "bsmc derleniyor..."
+    # shellcheck disable=SC2086
+    if ! $CC $CFLAGS -pthread -I"$ROOT/src" -o "$BSMC" "$ROOT/src/main.c" $LIBRARY_SOURCES; then
+        echo "Hata: bsmc derlenemedi."
+        exit 1
+    fi
+fi
+
+# --- Altın testler ---
+for test_source in "$ROOT"/tests/golden/*_golden.c; do
+    [ -f "$test_source" ] || continue
+    name=$(basename "$test_source" .c)
+    # shellcheck disable=SC2086
+    if ! $CC $CFLAGS -pthread -I"$ROOT/src" -o "$BUILD_DIR/$name" "$test_source" \
+        "$ROOT/tests/golden/golden.c" $LIBRARY_SOURCES; then
+        fail "$name (derleme)"
+        continue
+    fi
+    # Derleyicinin ilerleme mesajları günlüğe, farklar stderr'e yazılır
+    if "$BUILD_DIR/$name" "$ROOT/tests/golden" "$BUILD_DIR" > "$BUILD_DIR/$name.log"; then
+        passed=$((passed + 1))
+    else
+        fail "$name"
+    fi
+done
+
+# --- Davranış testleri ---
+
+# Bir çalıştırmanın sayı satırlarını ve çıkış kodunu $BUILD_DIR/actual'a yazar.
+# $1: çıkış kodu, $2: standart çıktı dosyası
+record_result() {
+    grep -E '^-?[0-9]+( -?[0-9]+)*$' "$2" > "$BUILD_DIR/actual"
+    echo "exit $1" >> "$BUILD_DIR/actual"
+}
+
+# Komutu çalıştırıp sonucu beklenen çıktıyla karşılaştırır.
+# $1: test adı, $2: beklenen çıktı dosyası, geri kalanı: komut
+check_run() {
+    label=$1
+    expected=$2
+    shift 2
+    "$@" > "$BUILD_DIR/stdout" 2> "$BUILD_DIR/stderr"
+    status=$?
+    record_result "$status" "$BUILD_DIR/stdout"
+    if grep -q '^Hata' "$BUILD_DIR/stderr"; then
+        fail "$label: $(grep '^Hata' "$BUILD_DIR/stderr" | head -n 1)"
+    elif ! cmp -s "$expected" "$BUILD_DIR/actual"; then
+        fail "$label: beklenen çıktıdan farklı"
+        diff "$expected" "$BUILD_DIR/actual" | head -n 10
+    else
+        passed=$((passed + 1))
+    fi
+}
+
+# Derleme adımının hatasız bitmesini şart koşar.
+# $1: test adı, geri kalanı: komut
+check_compile() {
+    label=$1
+    shift
+    if "$@" > "$BUILD_DIR/compile.out" 2>&1; then
+        passed=$((passed + 1))
+        return 0
+    fi
+    fail "$label: $(grep '^Hata' "$BUILD_DIR/compile.out" | head -n 1)"
+    return 1
+}
+
+# Programı (varsa kendi .bsmrules kural veritabanıyla) derler; geri kalan argümanlar bsmc'ye gider.
+bsmc_program() {
+    "$BSMC" "$program" ${rules:+"--superopt-rules=$rules"} "$@"
+}
+
+for program in "$ROOT"/tests/programs/*.bsm; do
+    [ -f "$program" ] || continue
+    name=$(basename "$program" .bsm)
+    expected="${program%.bsm}.out"
+    if [ ! -f "$expected" ]; then
+        fail "$name: $expected bulunamadı"
+        continue
+    fi
+    work="$BUILD_DIR/$name"
+    rules="${program%.bsm}.bsmrules"
+    [ -f "$rules" ] || rules=
+
+    for level in $LEVELS; do
+        check_run "$name $level bvm" "$expected" bsmc_program "$level" --run=bvm
+        if check_compile "$name $level .vbsm" bsmc_program "$level" -o "$work.vbsm"; then
+            check_run "$name $level .vbsm" "$expected" "$BSMC" "$work.vbsm" --run=bvm
+        fi
+        if check_compile "$name $level .bsmir" bsmc_program "$level" --emit-ir="$work.bsmir"; then
+            check_run "$name $level .bsmir" "$expected" "$BSMC" "$work.bsmir" --run=bvm
+        fi
+        if [ $NATIVE = 1 ]; then
+            check_run "$name $level jit" "$expected" bsmc_program "$level" --run=jit
+            check_run "$name $level tiered" "$expected" bsmc_program "$level" --run=tiered --osr-threshold=2
+            if check_compile "$name $level amd64 .o" bsmc_program "$level" -o "$work.o" &&
+                check_compile "$name $level ld" ld -o "$work.exe" "$work.o"; then
+                check_run "$name $level amd64" "$expected" "$work.exe"
+            fi
+        fi
+        if check_compile "$name $level .wasm" bsmc_program "$level" -o "$work.wasm" && [ -n "$NODE" ]; then
+            check_run "$name $level wasm" "$expected" "$NODE" "$ROOT/tests/wasm_host.js" "$work.wasm"
+        fi
+        for arch in armv8 rv64i rv64e; do
+            check_compile "$name $level $arch .o" bsmc_program "$level" --target-arch=$arch -o "$work.$arch.o"
+        done
+    done
+
+    # Hedefe bağlı geçişler (bayrak yeniden kullanımı, if-conversion maliyeti, sıralı çizelgeleme)
+    for level in -O2 -O3; do
+        for arch in armv7 armv8 rv64e; do
+            check_run "$name $level bvm ($arch)" "$expected" bsmc_program "$level" --target-arch=$arch --run=bvm
+        done
+    done
+
+    # PGO: enstrümante edilmiş çalıştırma profili yazar, ardından profil kullanılarak yeniden derlenir
+    rm -f "$work.bsmprof"
+    check_run "$name -O2 profile-generate" "$expected" bsmc_program -O2 --profile-generate="$work.bsmprof" --run=bvm
+    check_run "$name -O2 profile-use" "$expected" bsmc_program -O2 --profile-use="$work.bsmprof" --run=bvm
+
+    # BVM üst-komutları: yürütmenin gönderim profili yazılır, üst-komutlar bu profilden seçilir
+    rm -f "$work.dispatch"
+    check_run "$name -O2 dispatch-profile" "$expected" bsmc_program -O2 --bvm-dispatch-profile="$work.dispatch" --run=bvm
+    check_run "$name -O2 superinstructions" "$expected" bsmc_program -O2 --bvm-superinstructions="$work.dispatch" --run=bvm
+
+    # Süperoptimizasyon: boş veritabanıyla aranan kurallar da aynı sonucu vermelidir
+    if [ -n "$rules" ]; then
+        rm -f "$work.bsmrules"
+        if check_compile "$name -O2 superoptimize" "$BSMC" "$program" -O2 --superoptimize \
+            --superopt-rules="$work.bsmrules" -o "$work.vbsm"; then
+            check_run "$name -O2 superopt-rules" "$expected" "$BSMC" "$program" -O2 \
+                --superopt-rules="$work.bsmrules" --run=bvm
+        fi
+    fi
+
+    # Programın gerektirdiği optimizasyon mesajları ("--profile-use" yukarıda üretilen profili kullanır)
+    grep -E '^; optimizer -O[0-3s][^:]*: ' "$program" > "$work.messages"
+    while IFS= read -r line; do
+        options=$(echo "$line" | sed -E 's/^; optimizer ([^:]*): .*/\1/')
+        message=$(echo "$line" | sed -E 's/^; optimizer [^:]*: //')
+        # shellcheck disable=SC2086
+        if (cd "$BUILD_DIR" && bsmc_program $(echo "$options" | sed "s|--profile-use|--profile-use=$work.bsmprof|") \
+            --dump-ir 2>&1) | grep -qF -- "$message"; then
+            passed=$((passed + 1))
+        else
+            fail "$name $options: '$message' mesajı görülmedi"
+        fi
+    done < "$work.messages"
+done
+
+echo "$passed başarılı, $failed başarısız"
+[ "$failed" -eq 0 ]
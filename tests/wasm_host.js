@@ -0,0 +1,47 @@
+// Bessambly .wasm modüllerini Node.js'de çalıştıran test konağı (bkz. src/wasm.h "Konak Arayüzü")
+//
+// Kullanım: node tests/wasm_host.js <modül.wasm>
+//
+// BVM ile aynı davranış: 0x1000 çağrısı argümanları ondalık olarak tek satıra yazar, modülün
+// döndürdüğü çıkış kodu sürecin çıkış kodu olur. Diğer sistem çağrıları ve tuzaklar hatadır.
+'use strict';
+const fs = require('fs');
+
+const WASM_SYSCALL_ARGS_OFFSET = 136;
+const HYPERCALL_PRINT = 0x1000n;
+
+if (process.argv.length !== 3) {
+    console.error('Hata: Kullanım: node wasm_host.js <modül.wasm>');
+    process.exit(2);
+}
+
+let memory = null;
+const imports = {
+    bsm: {
+        syscall(number, num_args) {
+            if (number !== HYPERCALL_PRINT) {
+                console.error(`Hata: wasm: desteklenmeyen sistem çağrısı ${number}.`);
+                return 2;
+            }
+            const args = new BigInt64Array(memory.buffer, WASM_SYSCALL_ARGS_OFFSET, num_args);
+            console.log(Array.from(args, (value) => value.toString()).join(' '));
+            return 0;
+        },
+        profile_dump() {},
+    },
+};
+
+WebAssembly.instantiate(fs.readFileSync(process.argv[2]), imports).then(({ instance }) => {
+    memory = instance.exports.memory;
+    let exit_code;
+    try {
+        exit_code = instance.exports.main();
+    } catch (error) {
+        console.error(`Hata: wasm: yürütme hatası (${error.message}).`);
+        process.exit(1);
+    }
+    process.exitCode = Number(BigInt.asUintN(8, exit_code));
+}).catch((error) => {
+    console.error(`Hata: wasm: modül yüklenemedi (${error.message}).`);
+    process.exit(1);
+});